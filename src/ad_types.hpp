@@ -0,0 +1,114 @@
+#ifndef __AD_TYPES_H__
+#define __AD_TYPES_H__
+
+#include <Sacado.hpp>
+#include <deal.II/base/template_constraints.h>
+#include <deal.II/differentiation/ad/sacado_product_types.h>
+
+namespace PHiLiP {
+
+/// Highest polynomial degree with a statically sized AD type, see DegreeFadType.
+constexpr unsigned int max_static_fad_degree = 4;
+
+/// Capacity of the statically allocated derivative array of DegreeFadType<poly_degree>.
+/** Sized for the strong form Jacobian of a face term between two cells of degree \p poly_degree
+ *  with PHILIP_DIM+2 states, which depends on the degrees of freedom of both cells.
+ *  This gives 12 to 30 derivatives in 1D, 32 to 200 in 2D, and 80 to 1250 in 3D for p=1 to 4.
+ */
+constexpr unsigned int static_fad_derivatives (const unsigned int poly_degree)
+{
+    unsigned int n_dofs_per_state = 1;
+    for (int d = 0; d < PHILIP_DIM; ++d) n_dofs_per_state *= poly_degree+1;
+    return 2*(PHILIP_DIM+2)*n_dofs_per_state;
+}
+
+/// Sacado AD type for first derivatives with a statically allocated derivative array sized for \p poly_degree.
+/** Unlike Sacado::Fad::DFad, creating and copying temporaries does not allocate memory.
+ *  The number of derivatives is set at runtime through diff() and must not exceed static_fad_derivatives(poly_degree).
+ *  Operations only loop over the runtime number of derivatives, but each scalar takes the full capacity
+ *  on the stack, i.e. about 10KB for p=4 in 3D.
+ */
+template <unsigned int poly_degree>
+using DegreeFadType = Sacado::Fad::SLFad<double, static_fad_derivatives(poly_degree)>;
+
+/// Smallest statically sized AD type, also used by the weak form flux Jacobians.
+/** The weak form flux Jacobians have 2*nstate*(dim+1) variables, which fit for nstate <= PHILIP_DIM+2. */
+using StaticFadType = DegreeFadType<1>;
+
+/// Sacado AD type carrying a single directional derivative.
+/** Used by DGBase::apply_dRdW() to evaluate the Jacobian-vector product dRdW*v in one pass through
+ *  the residual assembly, where the solution coefficients are seeded with the direction v.
+ */
+using DirectionalFadType = Sacado::Fad::SFad<double, 1>;
+
+} // PHiLiP namespace
+
+namespace dealii {
+
+/// deal.II only defines the products of Sacado::Fad::DFad and Sacado::Rad::ADvar.
+template <typename T, int N>
+struct ProductType<Sacado::Fad::SLFad<T,N>, Sacado::Fad::SLFad<T,N>>
+{
+    /// Product of two SLFad.
+    using type = Sacado::Fad::SLFad<typename ProductType<T,T>::type, N>;
+};
+
+/// Product of a SLFad and a scalar.
+template <typename T, int N, typename U>
+struct ProductType<Sacado::Fad::SLFad<T,N>, U>
+{
+    /// Product type.
+    using type = Sacado::Fad::SLFad<typename ProductType<T,U>::type, N>;
+};
+
+/// Product of a scalar and a SLFad.
+template <typename T, typename U, int N>
+struct ProductType<T, Sacado::Fad::SLFad<U,N>>
+{
+    /// Product type.
+    using type = Sacado::Fad::SLFad<typename ProductType<T,U>::type, N>;
+};
+
+/// Allows SLFad to be used as the scalar of dealii::Tensor.
+template <typename T, int N>
+struct EnableIfScalar<Sacado::Fad::SLFad<T,N>>
+{
+    /// SLFad is a scalar type.
+    using type = Sacado::Fad::SLFad<T,N>;
+};
+
+/// Product of two SFad.
+template <typename T, int N>
+struct ProductType<Sacado::Fad::SFad<T,N>, Sacado::Fad::SFad<T,N>>
+{
+    /// Product of two SFad.
+    using type = Sacado::Fad::SFad<typename ProductType<T,T>::type, N>;
+};
+
+/// Product of a SFad and a scalar.
+template <typename T, int N, typename U>
+struct ProductType<Sacado::Fad::SFad<T,N>, U>
+{
+    /// Product type.
+    using type = Sacado::Fad::SFad<typename ProductType<T,U>::type, N>;
+};
+
+/// Product of a scalar and a SFad.
+template <typename T, typename U, int N>
+struct ProductType<T, Sacado::Fad::SFad<U,N>>
+{
+    /// Product type.
+    using type = Sacado::Fad::SFad<typename ProductType<T,U>::type, N>;
+};
+
+/// Allows SFad to be used as the scalar of dealii::Tensor.
+template <typename T, int N>
+struct EnableIfScalar<Sacado::Fad::SFad<T,N>>
+{
+    /// SFad is a scalar type.
+    using type = Sacado::Fad::SFad<T,N>;
+};
+
+} // dealii namespace
+
+#endif
@@ -1,11 +1,17 @@
 #include<fstream>
+#include <algorithm>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/tensor.h>
 
 #include <deal.II/base/qprojector.h>
 
+#include <deal.II/base/work_stream.h>
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/vectorization.h>
+
 #include <deal.II/grid/grid_generator.h>
 #include <deal.II/grid/grid_refinement.h>
+#include <deal.II/grid/grid_tools.h>
 
 #include <deal.II/dofs/dof_handler.h>
 #include <deal.II/dofs/dof_tools.h>
@@ -43,6 +49,7 @@
 
 #include <deal.II/dofs/dof_renumbering.h>
 
+#include <Epetra_Vector.h>
 
 #include "dg.h"
 #include "post_processor/physics_post_processor.h"
@@ -159,6 +166,8 @@ DGBase<dim,real>::DGBase(
     , nstate(nstate_input)
     , max_degree(max_degree_input)
     , triangulation(triangulation_input)
+    , solution(solution_vector)
+    , dual(dual_vector)
     , fe_collection(std::get<0>(collection_tuple))
     , volume_quadrature_collection(std::get<1>(collection_tuple))
     , face_quadrature_collection(std::get<2>(collection_tuple))
@@ -176,6 +185,42 @@ DGBase<dim,real>::DGBase(
 
 }
 
+template <int dim, typename real>
+DGBase<dim,real>::AssemblyScratchData::AssemblyScratchData (
+    const dealii::hp::MappingCollection<dim> &mapping_collection,
+    const dealii::hp::FECollection<dim>      &fe_collection,
+    const dealii::hp::FECollection<dim>      &fe_collection_lagrange,
+    const dealii::hp::QCollection<dim>       &volume_quadrature_collection,
+    const dealii::hp::QCollection<dim-1>     &face_quadrature_collection,
+    const dealii::UpdateFlags volume_update_flags,
+    const dealii::UpdateFlags face_update_flags,
+    const dealii::UpdateFlags neighbor_face_update_flags)
+    : fe_values_collection_volume (mapping_collection, fe_collection, volume_quadrature_collection, volume_update_flags)
+    , fe_values_collection_face_int (mapping_collection, fe_collection, face_quadrature_collection, face_update_flags)
+    , fe_values_collection_face_ext (mapping_collection, fe_collection, face_quadrature_collection, neighbor_face_update_flags)
+    , fe_values_collection_subface (mapping_collection, fe_collection, face_quadrature_collection, face_update_flags)
+    , fe_values_collection_volume_lagrange (mapping_collection, fe_collection_lagrange, volume_quadrature_collection, volume_update_flags)
+{
+    // The hp::FEValues only build the FEValues of an active_fe_index when first reinitialized.
+    for (unsigned int lane = 0; lane < dealii::VectorizedArray<double>::size(); ++lane) {
+        fe_values_collection_volume_lanes.push_back(std::make_unique<dealii::hp::FEValues<dim,dim>> (
+            mapping_collection, fe_collection, volume_quadrature_collection, volume_update_flags));
+    }
+}
+
+template <int dim, typename real>
+DGBase<dim,real>::AssemblyScratchData::AssemblyScratchData (const AssemblyScratchData &scratch_data)
+    : AssemblyScratchData (
+        scratch_data.fe_values_collection_volume.get_mapping_collection(),
+        scratch_data.fe_values_collection_volume.get_fe_collection(),
+        scratch_data.fe_values_collection_volume_lagrange.get_fe_collection(),
+        scratch_data.fe_values_collection_volume.get_quadrature_collection(),
+        scratch_data.fe_values_collection_face_int.get_quadrature_collection(),
+        scratch_data.fe_values_collection_volume.get_update_flags(),
+        scratch_data.fe_values_collection_face_int.get_update_flags(),
+        scratch_data.fe_values_collection_face_ext.get_update_flags())
+{ }
+
 template <int dim, typename real> 
 std::tuple<
         //dealii::hp::MappingCollection<dim>, // Mapping
@@ -394,6 +439,7 @@ void DGBase<dim,real>::assemble_cell_residual (
     const DoFCellAccessorType1 &current_cell,
     const DoFCellAccessorType2 &current_metric_cell,
     const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R,
+    const bool assemble_volume_terms,
     dealii::hp::FEValues<dim,dim>        &fe_values_collection_volume,
     dealii::hp::FEFaceValues<dim,dim>    &fe_values_collection_face_int,
     dealii::hp::FEFaceValues<dim,dim>    &fe_values_collection_face_ext,
@@ -419,13 +465,7 @@ void DGBase<dim,real>::assemble_cell_residual (
     current_dofs_indices.resize(n_dofs_curr_cell);
     current_cell->get_dof_indices (current_dofs_indices);
 
-    fe_values_collection_volume.reinit (current_cell, i_quad, i_mapp, i_fele);
-    const dealii::FEValues<dim,dim> &fe_values_volume = fe_values_collection_volume.get_present_fe_values();
-
     dealii::TriaIterator<dealii::CellAccessor<dim,dim>> cell_iterator = static_cast<dealii::TriaIterator<dealii::CellAccessor<dim,dim>> > (current_cell);
-    //if (!(all_parameters->use_weak_form)) fe_values_collection_volume_lagrange.reinit (current_cell, i_quad, i_mapp, i_fele);
-    fe_values_collection_volume_lagrange.reinit (cell_iterator, i_quad, i_mapp, i_fele);
-    const dealii::FEValues<dim,dim> &fe_values_lagrange = fe_values_collection_volume_lagrange.get_present_fe_values();
 
     const unsigned int n_metric_dofs_cell = high_order_grid.fe_system.dofs_per_cell;
     std::vector<dealii::types::global_dof_index> current_metric_dofs_indices(n_metric_dofs_cell);
@@ -433,24 +473,38 @@ void DGBase<dim,real>::assemble_cell_residual (
     current_metric_cell->get_dof_indices (current_metric_dofs_indices);
 
     if (all_parameters->add_artificial_dissipation) {
-        const unsigned int n_soln_dofs = fe_values_volume.dofs_per_cell;
+        const unsigned int n_soln_dofs = n_dofs_curr_cell;
         const double cell_diameter = current_cell->diameter();
         std::vector< real > soln_coeff(n_soln_dofs);
         for (unsigned int idof = 0; idof < n_soln_dofs; ++idof) {
             soln_coeff[idof] = solution(current_dofs_indices[idof]);
         }
-        const double artificial_diss_coeff = discontinuity_sensor(cell_diameter, soln_coeff, fe_values_volume.get_fe());
+        const double artificial_diss_coeff = discontinuity_sensor(cell_diameter, soln_coeff, current_fe_ref);
         artificial_dissipation_coeffs[current_cell->active_cell_index()] = artificial_diss_coeff;
     }
 
-    if ( compute_dRdW || compute_dRdX || compute_d2R ) {
-        assemble_volume_terms_derivatives (
-            fe_values_volume, current_fe_ref, volume_quadrature_collection[i_quad],
-            current_metric_dofs_indices, current_dofs_indices,
-            current_cell_rhs, fe_values_lagrange,
-            compute_dRdW, compute_dRdX, compute_d2R);
-    } else {
-        assemble_volume_terms_explicit (fe_values_volume, current_dofs_indices, current_cell_rhs, fe_values_lagrange);
+    // Either already assembled with the other cells of the batch, or from the stored metric terms
+    // without reinitializing the volume FEValues.
+    const bool volume_terms_assembled = !assemble_volume_terms
+        || assemble_volume_terms_geometry_store (cell_iterator, i_fele, current_dofs_indices, current_cell_rhs,
+                                                 compute_dRdW, compute_dRdX, compute_d2R);
+    if (!volume_terms_assembled) {
+        fe_values_collection_volume.reinit (current_cell, i_quad, i_mapp, i_fele);
+        const dealii::FEValues<dim,dim> &fe_values_volume = fe_values_collection_volume.get_present_fe_values();
+
+        //if (!(all_parameters->use_weak_form)) fe_values_collection_volume_lagrange.reinit (current_cell, i_quad, i_mapp, i_fele);
+        fe_values_collection_volume_lagrange.reinit (cell_iterator, i_quad, i_mapp, i_fele);
+        const dealii::FEValues<dim,dim> &fe_values_lagrange = fe_values_collection_volume_lagrange.get_present_fe_values();
+
+        if ( compute_dRdW || compute_dRdX || compute_d2R ) {
+            assemble_volume_terms_derivatives (
+                fe_values_volume, current_fe_ref, volume_quadrature_collection[i_quad],
+                current_metric_dofs_indices, current_dofs_indices,
+                current_cell_rhs, fe_values_lagrange,
+                compute_dRdW, compute_dRdX, compute_d2R);
+        } else {
+            assemble_volume_terms_explicit (fe_values_volume, current_dofs_indices, current_cell_rhs, fe_values_lagrange);
+        }
     }
 
     for (unsigned int iface=0; iface < dealii::GeometryInfo<dim>::faces_per_cell; ++iface) {
@@ -615,9 +669,7 @@ void DGBase<dim,real>::assemble_cell_residual (
                 }
 
                 // Add local contribution from neighbor cell to global vector
-                for (unsigned int i=0; i<n_dofs_neigh_cell; ++i) {
-                    rhs[neighbor_dofs_indices[i]] += neighbor_cell_rhs[i];
-                }
+                add_to_global_vector (rhs, neighbor_dofs_indices, neighbor_cell_rhs);
             } else {
                 //do nothing
             }
@@ -780,9 +832,7 @@ void DGBase<dim,real>::assemble_cell_residual (
                     current_cell_rhs, neighbor_cell_rhs);
             }
             // Add local contribution from neighbor cell to global vector
-            for (unsigned int i=0; i<n_dofs_neigh_cell; ++i) {
-                rhs[neighbor_dofs_indices[i]] += neighbor_cell_rhs[i];
-            }
+            add_to_global_vector (rhs, neighbor_dofs_indices, neighbor_cell_rhs);
         // Case 3:
         // Neighbor cell is NOT coarser
         // Therefore, they have the same coarseness, and we need to choose one of them to do the work
@@ -806,18 +856,27 @@ void DGBase<dim,real>::assemble_cell_residual (
             neighbor_dofs_indices.resize(n_dofs_neigh_cell);
             neighbor_cell->get_dof_indices (neighbor_dofs_indices);
 
-            fe_values_collection_face_int.reinit (current_cell, iface, i_quad, i_mapp, i_fele);
-            const dealii::FEFaceValues<dim,dim> &fe_values_face_int = fe_values_collection_face_int.get_present_fe_values();
-
             const int i_fele_n = neighbor_cell->active_fe_index(), i_quad_n = i_fele_n, i_mapp_n = 0;
-            fe_values_collection_face_ext.reinit (neighbor_cell, neighbor_iface, i_quad_n, i_mapp_n, i_fele_n);
-            const dealii::FEFaceValues<dim,dim> &fe_values_face_ext = fe_values_collection_face_ext.get_present_fe_values();
 
             const real penalty1 = evaluate_penalty_scaling (current_cell, iface, fe_collection);
             const real penalty2 = evaluate_penalty_scaling (neighbor_cell, neighbor_iface, fe_collection);
             const real penalty = 0.5 * (penalty1 + penalty2);
 
-            if ( compute_dRdW || compute_dRdX || compute_d2R ) {
+            // From the stored metric terms without reinitializing the face FEValues.
+            const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> neighbor_cell_iterator = static_cast<dealii::TriaIterator<dealii::CellAccessor<dim,dim>> > (neighbor_cell);
+            const bool face_terms_assembled
+                = assemble_face_term_geometry_store (cell_iterator, iface, i_fele, neighbor_cell_iterator, neighbor_iface, i_fele_n,
+                                                     penalty, current_dofs_indices, neighbor_dofs_indices,
+                                                     current_cell_rhs, neighbor_cell_rhs,
+                                                     compute_dRdW, compute_dRdX, compute_d2R);
+            if (face_terms_assembled) {
+                // Nothing else to do for this face.
+            } else if ( compute_dRdW || compute_dRdX || compute_d2R ) {
+                fe_values_collection_face_int.reinit (current_cell, iface, i_quad, i_mapp, i_fele);
+                const dealii::FEFaceValues<dim,dim> &fe_values_face_int = fe_values_collection_face_int.get_present_fe_values();
+                fe_values_collection_face_ext.reinit (neighbor_cell, neighbor_iface, i_quad_n, i_mapp_n, i_fele_n);
+                const dealii::FEFaceValues<dim,dim> &fe_values_face_ext = fe_values_collection_face_ext.get_present_fe_values();
+
                 const auto metric_neighbor_cell = current_metric_cell->neighbor_or_periodic_neighbor(iface);
                 metric_neighbor_cell->get_dof_indices(neighbor_metric_dofs_indices);
                 const dealii::Quadrature<dim-1> &used_face_quadrature = face_quadrature_collection[i_quad_n]; // or i_quad
@@ -839,6 +898,11 @@ void DGBase<dim,real>::assemble_cell_residual (
                                             current_cell_rhs, neighbor_cell_rhs,
                                             compute_dRdW, compute_dRdX, compute_d2R);
             } else {
+                fe_values_collection_face_int.reinit (current_cell, iface, i_quad, i_mapp, i_fele);
+                const dealii::FEFaceValues<dim,dim> &fe_values_face_int = fe_values_collection_face_int.get_present_fe_values();
+                fe_values_collection_face_ext.reinit (neighbor_cell, neighbor_iface, i_quad_n, i_mapp_n, i_fele_n);
+                const dealii::FEFaceValues<dim,dim> &fe_values_face_ext = fe_values_collection_face_ext.get_present_fe_values();
+
                 assemble_face_term_explicit (
                         fe_values_face_int, fe_values_face_ext,
                         penalty,
@@ -847,9 +911,7 @@ void DGBase<dim,real>::assemble_cell_residual (
             }
 
             // Add local contribution from neighbor cell to global vector
-            for (unsigned int i=0; i<n_dofs_neigh_cell; ++i) {
-                rhs[neighbor_dofs_indices[i]] += neighbor_cell_rhs[i];
-            }
+            add_to_global_vector (rhs, neighbor_dofs_indices, neighbor_cell_rhs);
         } else {
             // Should be faces where the neighbor cell has the same coarseness
             // but will be evaluated when we visit the other cell.
@@ -859,15 +921,51 @@ void DGBase<dim,real>::assemble_cell_residual (
     } // end of face loop
 
     // Add local contribution from current cell to global vector
-    for (unsigned int i=0; i<n_dofs_curr_cell; ++i) {
-        rhs[current_dofs_indices[i]] += current_cell_rhs[i];
-    }
+    add_to_global_vector (rhs, current_dofs_indices, current_cell_rhs);
 }
 
 template <int dim, typename real>
 void DGBase<dim,real>::set_dual(const dealii::LinearAlgebra::distributed::Vector<real> &dual_input)
 {
-    dual = dual_input;
+    modify_dual() = dual_input;
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::set_solution (const dealii::LinearAlgebra::distributed::Vector<double> &solution_input)
+{
+    modify_solution() = solution_input;
+    solution.update_ghost_values();
+}
+
+template <int dim, typename real>
+dealii::LinearAlgebra::distributed::Vector<double> &DGBase<dim,real>::modify_solution ()
+{
+    ++solution_version;
+    return solution_vector;
+}
+
+template <int dim, typename real>
+dealii::LinearAlgebra::distributed::Vector<real> &DGBase<dim,real>::modify_dual ()
+{
+    ++dual_version;
+    return dual_vector;
+}
+
+template <int dim, typename real>
+typename DGBase<dim,real>::StateVersions DGBase<dim,real>::current_state_versions () const
+{
+    StateVersions state;
+    state.solution = solution_version;
+    state.volume_nodes = high_order_grid.get_volume_nodes_version();
+    state.dual = dual_version;
+    return state;
+}
+
+template <int dim, typename real>
+bool DGBase<dim,real>::right_hand_side_is_current () const
+{
+    const bool compare_dual = false;
+    return right_hand_side_state.matches(current_state_versions(), compare_dual);
 }
 
 
@@ -881,23 +979,15 @@ void DGBase<dim,real>::assemble_residual (const bool compute_dRdW, const bool co
             , dealii::ExcMessage("Can only do one at a time compute_dRdW or compute_dRdX or compute_d2R"));
 
     pcout << "Assembling DG residual...";
+    // Only the Hessians depend on the dual.
+    const StateVersions current_state = current_state_versions();
+    const bool compare_dual = compute_d2R;
     if (compute_dRdW) {
         pcout << " with dRdW...";
 
-        auto diff_sol = solution;
-        diff_sol -= solution_dRdW;
-        const double l2_norm_sol = diff_sol.l2_norm();
-
-        if (l2_norm_sol == 0.0) {
-
-            auto diff_node = high_order_grid.volume_nodes;
-            diff_node -= volume_nodes_dRdW;
-            const double l2_norm_node = diff_node.l2_norm();
-
-            if (l2_norm_node == 0.0) {
-                pcout << " which is already assembled..." << std::endl;
-                return;
-            }
+        if (dRdW_state.matches(current_state, compare_dual) && dRdW_CFL_mass == CFL_mass) {
+            pcout << " which is already assembled..." << std::endl;
+            return;
         }
         {
             int n_stencil = 1 + std::pow(2,dim);
@@ -905,102 +995,47 @@ void DGBase<dim,real>::assemble_residual (const bool compute_dRdW, const bool co
             n_vmult += n_stencil*n_dofs_cell;
             dRdW_form += 1;
         }
-        solution_dRdW = solution;
-        volume_nodes_dRdW = high_order_grid.volume_nodes;
 
         system_matrix = 0;
     }
     if (compute_dRdX) {
         pcout << " with dRdX...";
 
-        auto diff_sol = solution;
-        diff_sol -= solution_dRdX;
-        const double l2_norm_sol = diff_sol.l2_norm();
-
-        if (l2_norm_sol == 0.0) {
-
-            auto diff_node = high_order_grid.volume_nodes;
-            diff_node -= volume_nodes_dRdX;
-            const double l2_norm_node = diff_node.l2_norm();
-
-            if (l2_norm_node == 0.0) {
-                pcout << " which is already assembled..." << std::endl;
-                return;
-            }
+        if (dRdX_state.matches(current_state, compare_dual)) {
+            pcout << " which is already assembled..." << std::endl;
+            return;
         }
-        solution_dRdX = solution;
-        volume_nodes_dRdX = high_order_grid.volume_nodes;
         dRdXv = 0;
     }
     if (compute_d2R) {
         pcout << " with d2RdWdW, d2RdWdX, d2RdXdX...";
-        auto diff_sol = solution;
-        diff_sol -= solution_d2R;
-        const double l2_norm_sol = diff_sol.l2_norm();
 
-        if (l2_norm_sol == 0.0) {
-
-            auto diff_node = high_order_grid.volume_nodes;
-            diff_node -= volume_nodes_d2R;
-            const double l2_norm_node = diff_node.l2_norm();
-
-            if (l2_norm_node == 0.0) {
-
-                auto diff_dual = dual;
-                diff_dual -= dual_d2R;
-                const double l2_norm_dual = diff_dual.l2_norm();
-                if (l2_norm_dual == 0.0) {
-                    pcout << " which is already assembled..." << std::endl;
-                    return;
-                }
-            }
+        if (d2R_state.matches(current_state, compare_dual)) {
+            pcout << " which is already assembled..." << std::endl;
+            return;
         }
-        solution_d2R = solution;
-        volume_nodes_d2R = high_order_grid.volume_nodes;
-        dual_d2R = dual;
         d2RdWdW = 0;
         d2RdWdX = 0;
         d2RdXdX = 0;
     }
+    if (!compute_dRdW && !compute_dRdX && !compute_d2R && right_hand_side_state.matches(current_state, compare_dual)) {
+        pcout << " which is already assembled..." << std::endl;
+        return;
+    }
     right_hand_side = 0;
+    ++n_residual_assemblies;
 
     pcout << std::endl;
 
-    //const dealii::MappingManifold<dim,dim> mapping;
-    //const dealii::MappingQ<dim,dim> mapping(10);//;max_degree+1);
-    //const dealii::MappingQ<dim,dim> mapping(high_order_grid.max_degree);
-    //const dealii::MappingQGeneric<dim,dim> mapping(high_order_grid.max_degree);
-    const auto mapping = (*(high_order_grid.mapping_fe_field));
-
-    dealii::hp::MappingCollection<dim> mapping_collection(mapping);
-
-    dealii::hp::FEValues<dim,dim>        fe_values_collection_volume (mapping_collection, fe_collection, volume_quadrature_collection, this->volume_update_flags); ///< FEValues of volume.
-    dealii::hp::FEFaceValues<dim,dim>    fe_values_collection_face_int (mapping_collection, fe_collection, face_quadrature_collection, this->face_update_flags); ///< FEValues of interior face.
-    dealii::hp::FEFaceValues<dim,dim>    fe_values_collection_face_ext (mapping_collection, fe_collection, face_quadrature_collection, this->neighbor_face_update_flags); ///< FEValues of exterior face.
-    dealii::hp::FESubfaceValues<dim,dim> fe_values_collection_subface (mapping_collection, fe_collection, face_quadrature_collection, this->face_update_flags); ///< FEValues of subface.
-
-    dealii::hp::FEValues<dim,dim>        fe_values_collection_volume_lagrange (mapping_collection, fe_collection_lagrange, volume_quadrature_collection, this->volume_update_flags);
+    // FEValues are only rebuilt when the grid or the collections have changed.
+    update_assembly_scratch_data ();
+    update_geometry_store ();
 
     solution.update_ghost_values();
 
     int assembly_error = 0;
     try {
-        auto current_metric_cell = high_order_grid.dof_handler_grid.begin_active();
-        for (auto current_cell = dof_handler.begin_active(); current_cell != dof_handler.end(); ++current_cell, ++current_metric_cell) {
-            if (!current_cell->is_locally_owned()) continue;
-
-            // Add right-hand side contributions this cell can compute
-            assemble_cell_residual (
-                current_cell, 
-                current_metric_cell, 
-                compute_dRdW, compute_dRdX, compute_d2R,
-                fe_values_collection_volume,
-                fe_values_collection_face_int,
-                fe_values_collection_face_ext,
-                fe_values_collection_subface,
-                fe_values_collection_volume_lagrange,
-                right_hand_side);
-        } // end of cell loop
+        assemble_cells (compute_dRdW, compute_dRdX, compute_d2R);
     } catch(...) {
         assembly_error = 1;
     }
@@ -1027,23 +1062,27 @@ void DGBase<dim,real>::assemble_residual (const bool compute_dRdW, const bool co
         //}
     }
 
+    // An invalid assembly is also kept since it would fail again at the same state.
+    right_hand_side_state = current_state;
+    if (compute_dRdW) {
+        dRdW_state = current_state;
+        dRdW_CFL_mass = CFL_mass;
+    }
+    if (compute_dRdX) dRdX_state = current_state;
+    if (compute_d2R) d2R_state = current_state;
+
     right_hand_side.compress(dealii::VectorOperation::add);
     if ( compute_dRdW ) {
         system_matrix.compress(dealii::VectorOperation::add);
 
         if (CFL_mass != 0.0) {
             time_scaled_mass_matrices(CFL_mass);
-            add_time_scaled_mass_matrices();
+            // Part of the assembly at dRdW_CFL_mass, unlike add_time_scaled_mass_matrices().
+            system_matrix.add(1.0, time_scaled_global_mass_matrix);
         }
 
-        Epetra_CrsMatrix *input_matrix  = const_cast<Epetra_CrsMatrix *>(&(system_matrix.trilinos_matrix()));
-        Epetra_CrsMatrix *output_matrix;
-        epetra_rowmatrixtransposer_dRdW = std::make_unique<Epetra_RowMatrixTransposer> ( input_matrix );
-        const bool make_data_contiguous = true;
-        epetra_rowmatrixtransposer_dRdW->CreateTranspose( make_data_contiguous, output_matrix);
-        system_matrix_transpose.reinit(*output_matrix);
-        delete(output_matrix);
-
+        // The transpose is only formed when requested through get_system_matrix_transpose().
+        system_matrix_transpose_is_current = false;
 
         //double condition_estimate;
         //dRdW_preconditioner_builder.ConstructPreconditioner(condition_estimate);
@@ -1059,6 +1098,317 @@ void DGBase<dim,real>::assemble_residual (const bool compute_dRdW, const bool co
 
 } // end of assemble_system_explicit ()
 
+template <int dim, typename real>
+void DGBase<dim,real>::apply_dRdW (
+    const dealii::LinearAlgebra::distributed::Vector<double> &direction,
+    dealii::LinearAlgebra::distributed::Vector<double> &dRdW_direction)
+{
+    Assert(direction.has_ghost_elements(), dealii::ExcMessage("The ghost values of the direction must be updated."));
+
+    update_assembly_scratch_data ();
+    update_geometry_store ();
+    solution.update_ghost_values();
+
+    dRdW_direction = 0.0;
+    dRdW_product_direction = &direction;
+    dRdW_product = &dRdW_direction;
+    try {
+        // Residual-only assembly, where the explicit terms return the directional derivatives.
+        const bool compute_dRdW = false, compute_dRdX = false, compute_d2R = false;
+        assemble_cells (compute_dRdW, compute_dRdX, compute_d2R);
+    } catch(...) {
+        dRdW_product_direction = nullptr;
+        dRdW_product = nullptr;
+        throw;
+    }
+    dRdW_product_direction = nullptr;
+    dRdW_product = nullptr;
+
+    dRdW_direction.compress(dealii::VectorOperation::add);
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::assemble_residual_of_cells (const std::vector<bool> &assembled_cells)
+{
+    AssertDimension(assembled_cells.size(), triangulation->n_active_cells());
+
+    // Only part of the cells are assembled, such that it is never current.
+    right_hand_side = 0;
+    right_hand_side_state = StateVersions();
+    ++n_residual_assemblies;
+
+    update_assembly_scratch_data ();
+    update_geometry_store ();
+    solution.update_ghost_values();
+
+    assembled_cells_filter = &assembled_cells;
+    try {
+        const bool compute_dRdW = false, compute_dRdX = false, compute_d2R = false;
+        assemble_cells (compute_dRdW, compute_dRdX, compute_d2R);
+    } catch(...) {
+        assembled_cells_filter = nullptr;
+        throw;
+    }
+    assembled_cells_filter = nullptr;
+
+    right_hand_side.compress(dealii::VectorOperation::add);
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::assemble_cells (
+    const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R)
+{
+    if (all_parameters->assembly_threads > 1) {
+        assemble_cells_threaded (compute_dRdW, compute_dRdX, compute_d2R);
+        return;
+    }
+
+    AssemblyScratchData &scratch_data = *assembly_scratch_data;
+    for (const CellBatch &cells : make_cell_batches()) {
+        assemble_cell_batch (cells, compute_dRdW, compute_dRdX, compute_d2R, scratch_data);
+    }
+}
+
+template <int dim, typename real>
+std::vector<typename DGBase<dim,real>::CellBatch> DGBase<dim,real>::make_cell_batches () const
+{
+    const unsigned int n_lanes = dealii::VectorizedArray<double>::size();
+    std::vector<CellBatch> cell_batches;
+    for (auto current_cell = dof_handler.begin_active(); current_cell != dof_handler.end(); ++current_cell) {
+        if (!current_cell->is_locally_owned()) continue;
+        if (assembled_cells_filter && !(*assembled_cells_filter)[current_cell->active_cell_index()]) continue;
+
+        const bool start_new_batch = cell_batches.empty()
+                                     || cell_batches.back().size() == n_lanes
+                                     || cell_batches.back().back()->active_fe_index() != current_cell->active_fe_index();
+        if (start_new_batch) {
+            cell_batches.emplace_back();
+            cell_batches.back().reserve(n_lanes);
+        }
+        cell_batches.back().push_back(current_cell);
+    }
+    return cell_batches;
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::assemble_cell_batch (
+    const CellBatch &cells,
+    const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R,
+    AssemblyScratchData &scratch_data)
+{
+    using ActiveCellIterator = typename dealii::DoFHandler<dim>::active_cell_iterator;
+
+    // Within apply_dRdW(), the local residuals are replaced by their directional derivatives.
+    dealii::LinearAlgebra::distributed::Vector<double> &rhs = dRdW_product ? *dRdW_product : right_hand_side;
+
+    const bool compute_derivatives = compute_dRdW || compute_dRdX || compute_d2R;
+    const bool volume_terms_assembled = !compute_derivatives && !dRdW_product_direction
+        && assemble_volume_terms_explicit_cell_batch (cells, scratch_data.fe_values_collection_volume_lanes, rhs);
+
+    for (const ActiveCellIterator &current_cell : cells) {
+        // Same cell seen from the grid's DoFHandler.
+        const ActiveCellIterator current_metric_cell (&(*triangulation), current_cell->level(), current_cell->index(), &(high_order_grid.dof_handler_grid));
+
+        // Add right-hand side contributions this cell can compute
+        assemble_cell_residual (
+            current_cell, 
+            current_metric_cell, 
+            compute_dRdW, compute_dRdX, compute_d2R,
+            !volume_terms_assembled,
+            scratch_data.fe_values_collection_volume,
+            scratch_data.fe_values_collection_face_int,
+            scratch_data.fe_values_collection_face_ext,
+            scratch_data.fe_values_collection_subface,
+            scratch_data.fe_values_collection_volume_lagrange,
+            rhs);
+    }
+}
+
+template <int dim, typename real>
+bool DGBase<dim,real>::assemble_volume_terms_explicit_cell_batch (
+    const CellBatch &/*cells*/,
+    std::vector<std::unique_ptr<dealii::hp::FEValues<dim,dim>>> &/*fe_values_collection_volume_lanes*/,
+    dealii::LinearAlgebra::distributed::Vector<double> &/*rhs*/)
+{
+    return false;
+}
+
+template <int dim, typename real>
+bool DGBase<dim,real>::assemble_volume_terms_geometry_store (
+    const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &/*cell*/,
+    const unsigned int /*i_fele*/,
+    const std::vector<dealii::types::global_dof_index> &/*current_dofs_indices*/,
+    dealii::Vector<real> &/*current_cell_rhs*/,
+    const bool /*compute_dRdW*/, const bool /*compute_dRdX*/, const bool /*compute_d2R*/)
+{
+    return false;
+}
+
+template <int dim, typename real>
+bool DGBase<dim,real>::assemble_face_term_geometry_store (
+    const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &/*cell_int*/,
+    const unsigned int /*iface_int*/,
+    const unsigned int /*i_fele_int*/,
+    const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &/*cell_ext*/,
+    const unsigned int /*iface_ext*/,
+    const unsigned int /*i_fele_ext*/,
+    const real /*penalty*/,
+    const std::vector<dealii::types::global_dof_index> &/*dof_indices_int*/,
+    const std::vector<dealii::types::global_dof_index> &/*dof_indices_ext*/,
+    dealii::Vector<real> &/*local_rhs_int_cell*/,
+    dealii::Vector<real> &/*local_rhs_ext_cell*/,
+    const bool /*compute_dRdW*/, const bool /*compute_dRdX*/, const bool /*compute_d2R*/)
+{
+    return false;
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::update_geometry_store ()
+{
+    if (!geometry_store_is_used || geometry_store.is_current(high_order_grid.get_volume_nodes_version())) return;
+
+    geometry_store.reinit (*assembly_mapping_collection, dof_handler, fe_collection, volume_quadrature_collection, face_quadrature_collection,
+                           high_order_grid.get_volume_nodes_version());
+    ++n_geometry_store_rebuilds;
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::update_assembly_scratch_data ()
+{
+    // The mapping only holds pointers to the grid DoFHandler and volume_nodes.
+    // Therefore, moving the nodes does not require a new mapping, but a new
+    // mapping_fe_field is created whenever the high-order grid is refined or rebuilt.
+    const bool grid_has_changed = (assembly_mapping_source != high_order_grid.mapping_fe_field);
+    if (assembly_scratch_data && !grid_has_changed) return;
+
+    assembly_scratch_data.reset();
+    assembly_mapping_source = high_order_grid.mapping_fe_field;
+    assembly_mapping_collection = std::make_unique<dealii::hp::MappingCollection<dim>> (*(high_order_grid.mapping_fe_field));
+    assembly_scratch_data = std::make_unique<AssemblyScratchData> (
+        *assembly_mapping_collection, fe_collection, fe_collection_lagrange,
+        volume_quadrature_collection, face_quadrature_collection,
+        this->volume_update_flags, this->face_update_flags, this->neighbor_face_update_flags);
+    ++n_assembly_scratch_rebuilds;
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::assemble_cells_threaded (
+    const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R)
+{
+    using CellBatchIterator = typename std::vector<CellBatch>::const_iterator;
+
+    // WorkStream copies the sample scratch data for each thread.
+    const AssemblyScratchData &sample_scratch_data = *assembly_scratch_data;
+    const AssemblyCopyData sample_copy_data;
+
+    auto worker = [&] (const CellBatchIterator &cells, AssemblyScratchData &scratch_data, AssemblyCopyData &copy_data)
+    {
+        copy_data.n_rows = 0;
+
+        // The global writes of the batch and its face neighbours are recorded in the copy_data.
+        thread_copy_data.get() = &copy_data;
+        assemble_cell_batch (*cells, compute_dRdW, compute_dRdX, compute_d2R, scratch_data);
+        thread_copy_data.get() = nullptr;
+    };
+    // WorkStream never runs the copier concurrently.
+    auto copier = [] (const AssemblyCopyData &copy_data)
+    {
+        for (unsigned int irow = 0; irow < copy_data.n_rows; ++irow) {
+            const typename AssemblyCopyData::Row &row = copy_data.rows[irow];
+            if (row.matrix) {
+                row.matrix->add(row.row, row.indices, row.values);
+            } else {
+                for (unsigned int i = 0; i < row.indices.size(); ++i) {
+                    (*row.vector)[row.indices[i]] += row.values[i];
+                }
+            }
+        }
+    };
+
+    const std::vector<CellBatch> cell_batches = make_cell_batches();
+    dealii::WorkStream::run (cell_batches.cbegin(), cell_batches.cend(), worker, copier, sample_scratch_data, sample_copy_data);
+}
+
+template <int dim, typename real>
+typename DGBase<dim,real>::AssemblyCopyData::Row &DGBase<dim,real>::AssemblyCopyData::new_row ()
+{
+    if (n_rows == rows.size()) rows.emplace_back();
+    Row &row = rows[n_rows++];
+    row.matrix = nullptr;
+    row.vector = nullptr;
+    row.indices.clear();
+    row.values.clear();
+    return row;
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::add_to_global_matrix (
+    dealii::TrilinosWrappers::SparseMatrix &global_matrix,
+    const dealii::types::global_dof_index row,
+    const std::vector<dealii::types::global_dof_index> &col_indices,
+    const std::vector<real> &row_values)
+{
+    AssemblyCopyData *copy_data = thread_copy_data.get();
+    if (!copy_data) {
+        global_matrix.add(row, col_indices, row_values);
+        return;
+    }
+    typename AssemblyCopyData::Row &copy_row = copy_data->new_row();
+    copy_row.matrix = &global_matrix;
+    copy_row.row = row;
+    copy_row.indices = col_indices;
+    copy_row.values = row_values;
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::add_to_global_matrix (
+    dealii::TrilinosWrappers::SparseMatrix &global_matrix,
+    const std::vector<dealii::types::global_dof_index> &row_indices,
+    const std::vector<dealii::types::global_dof_index> &col_indices,
+    const dealii::FullMatrix<real> &local_matrix)
+{
+    AssemblyCopyData *copy_data = thread_copy_data.get();
+    if (!copy_data) {
+        global_matrix.add(row_indices, col_indices, local_matrix);
+        return;
+    }
+    for (unsigned int irow = 0; irow < row_indices.size(); ++irow) {
+        typename AssemblyCopyData::Row &copy_row = copy_data->new_row();
+        copy_row.matrix = &global_matrix;
+        copy_row.row = row_indices[irow];
+        copy_row.indices = col_indices;
+        copy_row.values.resize(col_indices.size());
+        for (unsigned int icol = 0; icol < col_indices.size(); ++icol) {
+            copy_row.values[icol] = local_matrix(irow,icol);
+        }
+    }
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::add_to_global_vector (
+    dealii::LinearAlgebra::distributed::Vector<double> &global_vector,
+    const std::vector<dealii::types::global_dof_index> &indices,
+    const dealii::Vector<real> &local_vector)
+{
+    AssemblyCopyData *copy_data = thread_copy_data.get();
+    if (!copy_data) {
+        for (unsigned int i = 0; i < indices.size(); ++i) {
+            global_vector[indices[i]] += local_vector[i];
+        }
+        return;
+    }
+    typename AssemblyCopyData::Row &copy_row = copy_data->new_row();
+    copy_row.vector = &global_vector;
+    copy_row.indices = indices;
+    copy_row.values.assign(local_vector.begin(), local_vector.end());
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::set_max_dt_cell (const dealii::FEValues<dim,dim> &fe_values_vol, const real max_convective_eigenvalue)
+{
+    const auto cell = fe_values_vol.get_cell();
+    max_dt_cell[cell->active_cell_index()] = cell->diameter() / max_convective_eigenvalue;
+}
 
 template <int dim, typename real>
 double DGBase<dim,real>::get_residual_l2norm () const
@@ -1071,6 +1421,15 @@ unsigned int DGBase<dim,real>::n_dofs () const
     return dof_handler.n_dofs();
 }
 
+template <int dim, typename real>
+std::vector<std::vector<bool>> DGBase<dim,real>::get_constant_modes () const
+{
+    std::vector<std::vector<bool>> constant_modes;
+    const dealii::ComponentMask all_states(nstate, true);
+    dealii::DoFTools::extract_constant_modes(dof_handler, all_states, constant_modes);
+    return constant_modes;
+}
+
 template <int dim, typename real>
 void DGBase<dim,real>::output_results_vtk (const unsigned int cycle)// const
 {
@@ -1208,10 +1567,10 @@ void DGBase<dim,real>::allocate_system ()
     artificial_dissipation_coeffs.reinit(triangulation->n_active_cells());
     max_dt_cell.reinit(triangulation->n_active_cells());
 
-    solution.reinit(locally_owned_dofs, ghost_dofs, mpi_communicator);
+    modify_solution().reinit(locally_owned_dofs, ghost_dofs, mpi_communicator);
     //right_hand_side.reinit(locally_owned_dofs, mpi_communicator);
     right_hand_side.reinit(locally_owned_dofs, ghost_dofs, mpi_communicator);
-    dual.reinit(locally_owned_dofs, ghost_dofs, mpi_communicator);
+    modify_dual().reinit(locally_owned_dofs, ghost_dofs, mpi_communicator);
 
     // System matrix allocation
     dealii::DynamicSparsityPattern dsp(locally_relevant_dofs);
@@ -1222,14 +1581,13 @@ void DGBase<dim,real>::allocate_system ()
 
     system_matrix.reinit(locally_owned_dofs, sparsity_pattern, mpi_communicator);
 
-    system_matrix_transpose.reinit(system_matrix);
-    Epetra_CrsMatrix *input_matrix  = const_cast<Epetra_CrsMatrix *>(&(system_matrix.trilinos_matrix()));
-    Epetra_CrsMatrix *output_matrix;
-    epetra_rowmatrixtransposer_dRdW = std::make_unique<Epetra_RowMatrixTransposer> ( input_matrix );
-    const bool make_data_contiguous = true;
-    epetra_rowmatrixtransposer_dRdW->CreateTranspose( make_data_contiguous, output_matrix);
-    system_matrix_transpose.reinit(*output_matrix);
-    delete(output_matrix);
+    // The transpose and its permutation are rebuilt with the new sparsity pattern on demand.
+    system_matrix_transpose.clear();
+    local_transpose.reset();
+    transpose_exporter.reset();
+    transpose_permutation.clear();
+    transposed_matrix_source = nullptr;
+    system_matrix_transpose_is_current = false;
 
     // {
     //     dRdW_preconditioner_builder.SetUserMatrix(const_cast<Epetra_CrsMatrix *>(&system_matrix.trilinos_matrix()));
@@ -1280,57 +1638,187 @@ void DGBase<dim,real>::allocate_system ()
     }
 
 
-    solution_dRdW.reinit(solution);
-    solution_dRdW *= 0.0;
-    volume_nodes_dRdW.reinit(high_order_grid.volume_nodes);
-    volume_nodes_dRdW *= 0.0;
+    // The vectors have been re-allocated. Assemble everything at the next call.
+    right_hand_side_state = StateVersions();
+    dRdW_state = StateVersions();
+    dRdX_state = StateVersions();
+    d2R_state = StateVersions();
 
-    solution_dRdX.reinit(solution);
-    solution_dRdX *= 0.0;
-    volume_nodes_dRdX.reinit(high_order_grid.volume_nodes);
-    volume_nodes_dRdX *= 0.0;
 
-    solution_d2R.reinit(solution);
-    solution_d2R *= 0.0;
-    volume_nodes_d2R.reinit(high_order_grid.volume_nodes);
-    volume_nodes_d2R *= 0.0;
-    dual_d2R.reinit(dual);
-    dual_d2R *= 0.0;
+    // The quadratures or the grid might have changed, rebuild the FEValues at the next assembly.
+    assembly_scratch_data.reset();
+    geometry_store.clear();
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::mark_system_matrix_modified ()
+{
+    dRdW_state = StateVersions();
+    system_matrix_transpose_is_current = false;
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::build_system_matrix_transpose ()
+{
+    const Epetra_CrsMatrix &matrix = system_matrix.trilinos_matrix();
+    const Epetra_Map &row_map = matrix.RowMap();
+    const Epetra_Map &col_map = matrix.ColMap();
+
+    // Number of entries in each row of the transpose, i.e. in each column of the matrix.
+    std::vector<int> n_entries_per_row(col_map.NumMyElements(), 0);
+    for (int row = 0; row < matrix.NumMyRows(); ++row) {
+        int n_entries;
+        double *values;
+        int *indices;
+        matrix.ExtractMyRowView(row, n_entries, values, indices);
+        for (int i = 0; i < n_entries; ++i) ++n_entries_per_row[indices[i]];
+    }
+
+    const bool static_profile = true;
+    local_transpose = std::make_unique<Epetra_CrsMatrix>(Copy, col_map, n_entries_per_row.data(), static_profile);
+    for (int row = 0; row < matrix.NumMyRows(); ++row) {
+        int n_entries;
+        double *values;
+        int *indices;
+        matrix.ExtractMyRowView(row, n_entries, values, indices);
+        int global_row = row_map.GID(row);
+        for (int i = 0; i < n_entries; ++i) {
+            local_transpose->InsertGlobalValues(col_map.GID(indices[i]), 1, &values[i], &global_row);
+        }
+    }
+    local_transpose->FillComplete(matrix.RangeMap(), matrix.DomainMap());
+    local_transpose->OptimizeStorage();
+
+    // Position of each matrix entry in the contiguous values of the local_transpose.
+    int *row_offsets;
+    int *col_indices;
+    double *transpose_values;
+    local_transpose->ExtractCrsDataPointers(row_offsets, col_indices, transpose_values);
+    transpose_permutation.resize(matrix.NumMyNonzeros());
+    unsigned int ientry = 0;
+    for (int row = 0; row < matrix.NumMyRows(); ++row) {
+        int n_entries;
+        double *values;
+        int *indices;
+        matrix.ExtractMyRowView(row, n_entries, values, indices);
+        const int transpose_col = local_transpose->LCID(row_map.GID(row));
+        for (int i = 0; i < n_entries; ++i) {
+            const int transpose_row = indices[i];
+            const int *row_begin = col_indices + row_offsets[transpose_row];
+            const int *row_end   = col_indices + row_offsets[transpose_row+1];
+            // FillComplete() sorts the column indices of each row.
+            const int *position = std::lower_bound(row_begin, row_end, transpose_col);
+            Assert(position != row_end && *position == transpose_col, dealii::ExcInternalError());
+            transpose_permutation[ientry++] = position - col_indices;
+        }
+    }
+
+    // Sum the rows of the ghosted columns into the processors owning them.
+    transpose_exporter = std::make_unique<Epetra_Export>(col_map, matrix.DomainMap());
+    Epetra_CrsMatrix transpose(Copy, matrix.DomainMap(), 0);
+    transpose.Export(*local_transpose, *transpose_exporter, Add);
+    transpose.FillComplete(matrix.RangeMap(), matrix.DomainMap());
+    system_matrix_transpose.reinit(transpose);
+
+    transposed_matrix_source = &matrix;
+    n_transpose_rebuilds++;
+}
+
+template <int dim, typename real>
+const dealii::TrilinosWrappers::SparseMatrix & DGBase<dim,real>::get_system_matrix_transpose ()
+{
+    if (system_matrix_transpose_is_current) return system_matrix_transpose;
+
+    const Epetra_CrsMatrix &matrix = system_matrix.trilinos_matrix();
+    const bool same_pattern = local_transpose
+                              && transposed_matrix_source == &matrix
+                              && transpose_permutation.size() == static_cast<unsigned int>(matrix.NumMyNonzeros());
+    if (!same_pattern) {
+        build_system_matrix_transpose ();
+    } else {
+        // Scatter the values into the local transpose, then sum them into the owning processors.
+        int *row_offsets;
+        int *col_indices;
+        double *transpose_values;
+        local_transpose->ExtractCrsDataPointers(row_offsets, col_indices, transpose_values);
+        unsigned int ientry = 0;
+        for (int row = 0; row < matrix.NumMyRows(); ++row) {
+            int n_entries;
+            double *values;
+            int *indices;
+            matrix.ExtractMyRowView(row, n_entries, values, indices);
+            for (int i = 0; i < n_entries; ++i) {
+                transpose_values[transpose_permutation[ientry++]] = values[i];
+            }
+        }
+        Epetra_CrsMatrix &transpose = const_cast<Epetra_CrsMatrix &>(system_matrix_transpose.trilinos_matrix());
+        transpose.PutScalar(0.0);
+        transpose.Export(*local_transpose, *transpose_exporter, Add);
+        n_transpose_updates++;
+    }
+    system_matrix_transpose_is_current = true;
+    return system_matrix_transpose;
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::system_matrix_transpose_vmult (
+    dealii::LinearAlgebra::distributed::Vector<double> &dst,
+    const dealii::LinearAlgebra::distributed::Vector<double> &src) const
+{
+    const Epetra_CrsMatrix &matrix = system_matrix.trilinos_matrix();
+    const Epetra_Vector src_epetra(View, matrix.RangeMap(), const_cast<double *>(src.begin()));
+    Epetra_Vector dst_epetra(View, matrix.DomainMap(), dst.begin());
+    const bool transpose = true;
+    const int ierr = matrix.Multiply(transpose, src_epetra, dst_epetra);
+    AssertThrow(ierr == 0, dealii::ExcInternalError());
 }
 
 template <int dim, typename real>
 void DGBase<dim,real>::evaluate_mass_matrices (bool do_inverse_mass_matrix)
 {
+    const bool use_cell_inverse_mass_matrix = do_inverse_mass_matrix && all_parameters->use_cell_inverse_mass_matrix;
+    if (use_cell_inverse_mass_matrix) {
+        // Only the blocks are stored, such that no sparsity pattern is needed.
+        global_inverse_mass_matrix.clear();
+        inverse_mass_blocks.clear();
+        inverse_mass_local_dofs.clear();
+        curved_inverse_mass_matrices.clear();
+        reference_inverse_mass_matrices.assign(fe_collection.size(), dealii::FullMatrix<real>());
+        reference_inverse_mass_is_diagonal.assign(fe_collection.size(), false);
+    }
+
     // Mass matrix sparsity pattern
     //dealii::SparsityPattern dsp(dof_handler.n_dofs(), dof_handler.n_dofs(), dof_handler.get_fe_collection().max_dofs_per_cell());
     //dealii::SparsityPattern dsp(dof_handler.n_dofs(), dof_handler.n_dofs(), dof_handler.get_fe_collection().max_dofs_per_cell());
     //dealii::DynamicSparsityPattern dsp(dof_handler.n_locally_owned_dofs(), dof_handler.n_locally_owned_dofs(), dof_handler.get_fe_collection().max_dofs_per_cell());
-    dealii::DynamicSparsityPattern dsp(dof_handler.n_dofs());
     std::vector<dealii::types::global_dof_index> dofs_indices;
-    for (auto cell = dof_handler.begin_active(); cell!=dof_handler.end(); ++cell) {
+    if (!use_cell_inverse_mass_matrix) {
+        dealii::DynamicSparsityPattern dsp(dof_handler.n_dofs());
+        for (auto cell = dof_handler.begin_active(); cell!=dof_handler.end(); ++cell) {
 
-        if (!cell->is_locally_owned()) continue;
+            if (!cell->is_locally_owned()) continue;
 
-        const unsigned int fe_index_curr_cell = cell->active_fe_index();
+            const unsigned int fe_index_curr_cell = cell->active_fe_index();
 
-        // Current reference element related to this physical cell
-        const dealii::FESystem<dim,dim> &current_fe_ref = fe_collection[fe_index_curr_cell];
-        const unsigned int n_dofs_cell = current_fe_ref.n_dofs_per_cell();
+            // Current reference element related to this physical cell
+            const dealii::FESystem<dim,dim> &current_fe_ref = fe_collection[fe_index_curr_cell];
+            const unsigned int n_dofs_cell = current_fe_ref.n_dofs_per_cell();
 
-        dofs_indices.resize(n_dofs_cell);
-        cell->get_dof_indices (dofs_indices);
-        for (unsigned int itest=0; itest<n_dofs_cell; ++itest) {
-            for (unsigned int itrial=0; itrial<n_dofs_cell; ++itrial) {
-                dsp.add(dofs_indices[itest], dofs_indices[itrial]);
+            dofs_indices.resize(n_dofs_cell);
+            cell->get_dof_indices (dofs_indices);
+            for (unsigned int itest=0; itest<n_dofs_cell; ++itest) {
+                for (unsigned int itrial=0; itrial<n_dofs_cell; ++itrial) {
+                    dsp.add(dofs_indices[itest], dofs_indices[itrial]);
+                }
             }
         }
-    }
-    dealii::SparsityTools::distribute_sparsity_pattern(dsp, dof_handler.locally_owned_dofs(), mpi_communicator, locally_owned_dofs);
-    mass_sparsity_pattern.copy_from(dsp);
-    if (do_inverse_mass_matrix == true) {
-        global_inverse_mass_matrix.reinit(locally_owned_dofs, mass_sparsity_pattern);
-    } else {
-        global_mass_matrix.reinit(locally_owned_dofs, mass_sparsity_pattern);
+        dealii::SparsityTools::distribute_sparsity_pattern(dsp, dof_handler.locally_owned_dofs(), mpi_communicator, locally_owned_dofs);
+        mass_sparsity_pattern.copy_from(dsp);
+        if (do_inverse_mass_matrix == true) {
+            global_inverse_mass_matrix.reinit(locally_owned_dofs, mass_sparsity_pattern);
+        } else {
+            global_mass_matrix.reinit(locally_owned_dofs, mass_sparsity_pattern);
+        }
     }
 
     //dealii::TrilinosWrappers::SparseMatrix 
@@ -1396,7 +1884,14 @@ void DGBase<dim,real>::evaluate_mass_matrices (bool do_inverse_mass_matrix)
 
         dofs_indices.resize(n_dofs_cell);
         cell->get_dof_indices (dofs_indices);
-        if (do_inverse_mass_matrix == true) {
+        if (use_cell_inverse_mass_matrix) {
+            const dealii::Quadrature<dim> &quadrature = volume_quadrature_collection[quad_index];
+            std::vector<double> jacobian_determinants(n_quad_pts);
+            for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+                jacobian_determinants[iquad] = fe_values_volume.JxW(iquad) / quadrature.weight(iquad);
+            }
+            add_inverse_mass_block (fe_index_curr_cell, dofs_indices, local_mass_matrix, jacobian_determinants);
+        } else if (do_inverse_mass_matrix == true) {
             dealii::FullMatrix<real> local_inverse_mass_matrix(n_dofs_cell);
             local_inverse_mass_matrix.invert(local_mass_matrix);
             global_inverse_mass_matrix.set (dofs_indices, local_inverse_mass_matrix);
@@ -1405,7 +1900,9 @@ void DGBase<dim,real>::evaluate_mass_matrices (bool do_inverse_mass_matrix)
         }
     }
 
-    if (do_inverse_mass_matrix == true) {
+    if (use_cell_inverse_mass_matrix) {
+        return;
+    } else if (do_inverse_mass_matrix == true) {
         global_inverse_mass_matrix.compress(dealii::VectorOperation::insert);
     } else {
         global_mass_matrix.compress(dealii::VectorOperation::insert);
@@ -1413,15 +1910,193 @@ void DGBase<dim,real>::evaluate_mass_matrices (bool do_inverse_mass_matrix)
 
     return;
 }
+
+template <int dim, typename real>
+void DGBase<dim,real>::add_inverse_mass_block (
+    const unsigned int fe_index,
+    const std::vector<dealii::types::global_dof_index> &dofs_indices,
+    const dealii::FullMatrix<real> &local_mass_matrix,
+    const std::vector<double> &jacobian_determinants)
+{
+    const unsigned int n_dofs_cell = dofs_indices.size();
+
+    InverseMassBlock block;
+    block.first_local_dof = locally_owned_dofs.index_within_set(dofs_indices[0]);
+    block.scattered_dofs = dealii::numbers::invalid_unsigned_int;
+    block.n_dofs = n_dofs_cell;
+    block.fe_index = fe_index;
+    block.curved_index = dealii::numbers::invalid_unsigned_int;
+    block.inverse_jacobian_determinant = 1.0;
+
+    // The DG degrees of freedom of a cell are numbered one after the other, unless a renumbering mixed them.
+    bool is_contiguous = true;
+    for (unsigned int i=0; i<n_dofs_cell; ++i) {
+        is_contiguous = is_contiguous && (locally_owned_dofs.index_within_set(dofs_indices[i]) == block.first_local_dof + i);
+    }
+    if (!is_contiguous) {
+        block.scattered_dofs = inverse_mass_local_dofs.size();
+        for (const auto &dof_index : dofs_indices) {
+            inverse_mass_local_dofs.push_back(locally_owned_dofs.index_within_set(dof_index));
+        }
+    }
+
+    // The shape functions are not transformed, such that the mass matrix of an affine cell is
+    // the reference one multiplied by the constant Jacobian determinant.
+    const auto minmax = std::minmax_element(jacobian_determinants.begin(), jacobian_determinants.end());
+    const bool is_affine = (*minmax.second - *minmax.first) <= 1e-12 * std::abs(*minmax.second);
+
+    if (is_affine) {
+        const double jacobian_determinant = jacobian_determinants[0];
+        block.inverse_jacobian_determinant = 1.0 / jacobian_determinant;
+        dealii::FullMatrix<real> &reference_inverse = reference_inverse_mass_matrices[fe_index];
+        if (reference_inverse.m() == 0) {
+            reference_inverse.reinit(n_dofs_cell, n_dofs_cell);
+            reference_inverse.invert(local_mass_matrix);
+            reference_inverse *= jacobian_determinant;
+
+            double max_diagonal = 0.0, max_off_diagonal = 0.0;
+            for (unsigned int i=0; i<n_dofs_cell; ++i) {
+                for (unsigned int j=0; j<n_dofs_cell; ++j) {
+                    if (i==j) max_diagonal = std::max(max_diagonal, std::abs(reference_inverse(i,j)));
+                    else max_off_diagonal = std::max(max_off_diagonal, std::abs(reference_inverse(i,j)));
+                }
+            }
+            reference_inverse_mass_is_diagonal[fe_index] = (max_off_diagonal <= 1e-14 * max_diagonal);
+        }
+    } else {
+        block.curved_index = curved_inverse_mass_matrices.size();
+        curved_inverse_mass_matrices.emplace_back(n_dofs_cell, n_dofs_cell);
+        curved_inverse_mass_matrices.back().invert(local_mass_matrix);
+    }
+    inverse_mass_blocks.push_back(block);
+}
+
+template <int dim, typename real>
+void DGBase<dim,real>::apply_inverse_mass_matrix (
+    const dealii::LinearAlgebra::distributed::Vector<double> &src,
+    dealii::LinearAlgebra::distributed::Vector<double> &dst,
+    const bool add_to_dst) const
+{
+    if (!all_parameters->use_cell_inverse_mass_matrix) {
+        if (add_to_dst) global_inverse_mass_matrix.vmult_add(dst, src);
+        else global_inverse_mass_matrix.vmult(dst, src);
+        return;
+    }
+    Assert(&src != &dst, dealii::ExcMessage("The inverse mass matrix cannot be applied in place."));
+
+    using VectorizedDouble = dealii::VectorizedArray<double>;
+    constexpr unsigned int n_lanes = VectorizedDouble::size();
+    constexpr unsigned int invalid = dealii::numbers::invalid_unsigned_int;
+
+    // The locally owned entries are contiguous, starting at begin().
+    const double *const src_values = src.begin();
+    double *const dst_values = dst.begin();
+
+    // Sets or adds the product of a block with the cell values \p src_cell into \p dst_cell.
+    const auto apply_block = [&] (const InverseMassBlock &block, const double *const src_cell, double *const dst_cell)
+    {
+        const unsigned int n_dofs_cell = block.n_dofs;
+        const bool is_affine = (block.curved_index == invalid);
+        const dealii::FullMatrix<real> &inverse_mass = is_affine ? reference_inverse_mass_matrices[block.fe_index]
+                                                                 : curved_inverse_mass_matrices[block.curved_index];
+        const double scaling = block.inverse_jacobian_determinant;
+        if (is_affine && reference_inverse_mass_is_diagonal[block.fe_index]) {
+            for (unsigned int i=0; i<n_dofs_cell; ++i) {
+                const double value = scaling * inverse_mass(i,i) * src_cell[i];
+                dst_cell[i] = add_to_dst ? dst_cell[i] + value : value;
+            }
+        } else {
+            for (unsigned int i=0; i<n_dofs_cell; ++i) {
+                const real *const row = &inverse_mass(i,0);
+                double value = 0.0;
+                for (unsigned int j=0; j<n_dofs_cell; ++j) {
+                    value += row[j] * src_cell[j];
+                }
+                dst_cell[i] = add_to_dst ? dst_cell[i] + scaling * value : scaling * value;
+            }
+        }
+    };
+    // Contiguous affine cells with a dense reference inverse mass matrix, which are applied one cell per lane.
+    const auto is_batched = [&] (const InverseMassBlock &block)
+    {
+        return block.curved_index == invalid && block.scattered_dofs == invalid
+               && !reference_inverse_mass_is_diagonal[block.fe_index];
+    };
+
+    const unsigned int max_dofs_per_cell = fe_collection.max_dofs_per_cell();
+    dealii::AlignedVector<VectorizedDouble> src_batch(max_dofs_per_cell), dst_batch(max_dofs_per_cell);
+    std::vector<double> src_scattered(max_dofs_per_cell), dst_scattered(max_dofs_per_cell);
+    const unsigned int n_blocks = inverse_mass_blocks.size();
+    unsigned int iblock = 0;
+    while (iblock < n_blocks) {
+        const InverseMassBlock &block = inverse_mass_blocks[iblock];
+        const unsigned int n_dofs_cell = block.n_dofs;
+
+        if (is_batched(block)) {
+            // Consecutive cells of the same fe_index share the reference inverse mass matrix.
+            unsigned int n_cells = 1;
+            while (n_cells < n_lanes && iblock+n_cells < n_blocks
+                   && is_batched(inverse_mass_blocks[iblock+n_cells])
+                   && inverse_mass_blocks[iblock+n_cells].fe_index == block.fe_index) {
+                ++n_cells;
+            }
+
+            // The lanes past the last cell repeat it and are discarded.
+            VectorizedDouble scaling;
+            for (unsigned int lane=0; lane<n_lanes; ++lane) {
+                const InverseMassBlock &lane_block = inverse_mass_blocks[iblock + std::min(lane, n_cells-1)];
+                scaling[lane] = lane_block.inverse_jacobian_determinant;
+                const double *const src_cell = src_values + lane_block.first_local_dof;
+                for (unsigned int j=0; j<n_dofs_cell; ++j) src_batch[j][lane] = src_cell[j];
+            }
+
+            const dealii::FullMatrix<real> &inverse_mass = reference_inverse_mass_matrices[block.fe_index];
+            for (unsigned int i=0; i<n_dofs_cell; ++i) {
+                const real *const row = &inverse_mass(i,0);
+                VectorizedDouble value = dealii::make_vectorized_array(0.0);
+                for (unsigned int j=0; j<n_dofs_cell; ++j) {
+                    value += row[j] * src_batch[j];
+                }
+                dst_batch[i] = scaling * value;
+            }
+
+            for (unsigned int lane=0; lane<n_cells; ++lane) {
+                double *const dst_cell = dst_values + inverse_mass_blocks[iblock+lane].first_local_dof;
+                if (add_to_dst) {
+                    for (unsigned int i=0; i<n_dofs_cell; ++i) dst_cell[i] += dst_batch[i][lane];
+                } else {
+                    for (unsigned int i=0; i<n_dofs_cell; ++i) dst_cell[i] = dst_batch[i][lane];
+                }
+            }
+            iblock += n_cells;
+            continue;
+        }
+
+        if (block.scattered_dofs == invalid) {
+            apply_block (block, src_values + block.first_local_dof, dst_values + block.first_local_dof);
+        } else {
+            const unsigned int *const local_dofs = &inverse_mass_local_dofs[block.scattered_dofs];
+            for (unsigned int i=0; i<n_dofs_cell; ++i) {
+                src_scattered[i] = src_values[local_dofs[i]];
+                dst_scattered[i] = dst_values[local_dofs[i]];
+            }
+            apply_block (block, src_scattered.data(), dst_scattered.data());
+            for (unsigned int i=0; i<n_dofs_cell; ++i) dst_values[local_dofs[i]] = dst_scattered[i];
+        }
+        ++iblock;
+    }
+}
 template<int dim, typename real>
 void DGBase<dim,real>::add_mass_matrices(const real scale)
 {
     system_matrix.add(scale, global_mass_matrix);
+    mark_system_matrix_modified();
 }
 template<int dim, typename real>
 void DGBase<dim,real>::add_time_scaled_mass_matrices()
 {
     system_matrix.add(1.0, time_scaled_global_mass_matrix);
+    mark_system_matrix_modified();
 }
 template<int dim, typename real>
 void DGBase<dim,real>::time_scaled_mass_matrices(const real dt_scale)
@@ -1643,6 +2318,8 @@ template double
 DGBase<PHILIP_DIM,double>::discontinuity_sensor(const double diameter, const std::vector< double > &soln_coeff_high, const dealii::FiniteElement<PHILIP_DIM,PHILIP_DIM> &fe_high);
 template Sacado::Fad::DFad<double>
 DGBase<PHILIP_DIM,double>::discontinuity_sensor(const double diameter, const std::vector< Sacado::Fad::DFad<double> > &soln_coeff_high, const dealii::FiniteElement<PHILIP_DIM,PHILIP_DIM> &fe_high);
+template DirectionalFadType
+DGBase<PHILIP_DIM,double>::discontinuity_sensor(const double diameter, const std::vector< DirectionalFadType > &soln_coeff_high, const dealii::FiniteElement<PHILIP_DIM,PHILIP_DIM> &fe_high);
 template Sacado::Fad::DFad<Sacado::Fad::DFad<double>>
 DGBase<PHILIP_DIM,double>::discontinuity_sensor(const double diameter, const std::vector< Sacado::Fad::DFad<Sacado::Fad::DFad<double>> > &soln_coeff_high, const dealii::FiniteElement<PHILIP_DIM,PHILIP_DIM> &fe_high);
 template Sacado::Rad::ADvar<Sacado::Fad::DFad<double>>
@@ -3,6 +3,7 @@
 
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/base/parameter_handler.h>
+#include <deal.II/base/thread_local_storage.h>
 
 #include <deal.II/grid/tria.h>
 
@@ -19,19 +20,26 @@
 #include <deal.II/hp/fe_values.h>
 
 #include <deal.II/lac/vector.h>
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/sparsity_pattern.h>
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 #include <deal.II/lac/trilinos_vector.h>
 
 #include <Epetra_RowMatrixTransposer.h>
+#include <Epetra_CrsMatrix.h>
+#include <Epetra_Export.h>
 #include <AztecOO.h>
 
 #include <Sacado.hpp>
 
+#include "ad_types.hpp"
+
 #include "mesh/high_order_grid.h"
 #include "physics/physics.h"
 #include "numerical_flux/numerical_flux.h"
 #include "parameters/all_parameters.h"
+#include "sum_factorization.h"
+#include "geometry_store.h"
 
 // Template specialization of MappingFEField
 //extern template class dealii::MappingFEField<PHILIP_DIM,PHILIP_DIM,dealii::LinearAlgebra::distributed::Vector<double>, dealii::DoFHandler<PHILIP_DIM> >;
@@ -148,6 +156,13 @@ public:
     /** Must be done after setting the mesh and before assembling the system. */
     virtual void allocate_system ();
 
+    /// Creates a DG of the same type and physics on the same triangulation.
+    /** The cells are set to the max_degree, and the system is not allocated.
+     *  The physics changed through set_physics() are shared with the new DG.
+     *  The numerical fluxes follow \p parameters_input, which must outlive the copy, or the all_parameters if nullptr.
+     */
+    virtual std::shared_ptr<DGBase<dim,real>> create_discretization_copy (const Parameters::AllParameters *const parameters_input = nullptr) const = 0;
+
     /// Evaluate the time_scaled_global_mass_matrix such that the maximum time step
     /// cell-wise is taken into account.
     void time_scaled_mass_matrices(const real scale);
@@ -155,9 +170,25 @@ public:
     /// Allocates and evaluates the mass matrices for the entire grid
     /** Although straightforward, this has not been tested yet.
      *  Will be required for accurate time-stepping or nonlinear problems
+     *
+     *  If use_cell_inverse_mass_matrix, the inverse mass matrix is stored in cell blocks
+     *  instead of the global_inverse_mass_matrix, which is then left empty.
      */
     void evaluate_mass_matrices (bool do_inverse_mass_matrix = false);
 
+    /// Applies the inverse mass matrix: \p dst = \f$ \mathbf{M}^{-1} \f$ \p src, or adds it to \p dst if \p add_to_dst.
+    /** Requires evaluate_mass_matrices(true). Only the locally owned entries of \p dst are set,
+     *  and \p dst must not be \p src.
+     *
+     *  With use_cell_inverse_mass_matrix, the cell blocks read and write the contiguous entries of
+     *  their cell in place. Consecutive affine cells of the same fe_index are applied together,
+     *  one cell per lane of a dealii::VectorizedArray, with their shared reference inverse mass matrix.
+     */
+    void apply_inverse_mass_matrix (
+        const dealii::LinearAlgebra::distributed::Vector<double> &src,
+        dealii::LinearAlgebra::distributed::Vector<double> &dst,
+        const bool add_to_dst = false) const;
+
     /// Evaluates the maximum stable time step
     /** If exact_time_stepping = true, use the same time step for the entire solution
      *  NOT YET IMPLEMENTED
@@ -179,6 +210,10 @@ public:
 
     unsigned int n_dofs() const; ///< Number of degrees of freedom
 
+    /// Constant modes of each state, which are the near-nullspace of the algebraic multigrid.
+    /** See build_amg_preconditioner(). */
+    std::vector<std::vector<bool>> get_constant_modes () const;
+
 
     /// Sparsity pattern used on the system_matrix
     /** Not sure we need to store it.  */
@@ -196,7 +231,9 @@ public:
     /** Should be block diagonal where each block contains the mass matrix of each cell.  */
     dealii::TrilinosWrappers::SparseMatrix global_mass_matrix;
     /// Global inverser mass matrix
-    /** Should be block diagonal where each block contains the inverse mass matrix of each cell.  */
+    /** Should be block diagonal where each block contains the inverse mass matrix of each cell.
+     *  Empty if use_cell_inverse_mass_matrix. Use apply_inverse_mass_matrix() instead.
+     */
     dealii::TrilinosWrappers::SparseMatrix global_inverse_mass_matrix;
     /// System matrix corresponding to the derivative of the right_hand_side with
     /// respect to the solution
@@ -204,10 +241,33 @@ public:
 
     /// System matrix corresponding to the derivative of the right_hand_side with
     /// respect to the solution TRANSPOSED.
+    /** Only built on demand. Use get_system_matrix_transpose() such that it is up to date with system_matrix. */
     dealii::TrilinosWrappers::SparseMatrix system_matrix_transpose;
 
-    /// Epetra_RowMatrixTransposer used to transpose the system_matrix.
-    std::unique_ptr<Epetra_RowMatrixTransposer> epetra_rowmatrixtransposer_dRdW;
+    /// Returns the transpose of the system_matrix.
+    /** The transpose is only updated if the system_matrix has been assembled or modified since the last call.
+     *  The first call after allocate_system() builds its sparsity pattern and the permutation of the entries.
+     *  The following calls only permute the values in place.
+     */
+    const dealii::TrilinosWrappers::SparseMatrix & get_system_matrix_transpose ();
+
+    /// Must be called after modifying the system_matrix outside of assemble_residual().
+    /** The next assemble_residual() with dRdW then re-assembles the system_matrix instead of
+     *  returning the modified one, and the next get_system_matrix_transpose() updates the transpose.
+     *  Called by add_mass_matrices() and add_time_scaled_mass_matrices().
+     */
+    void mark_system_matrix_modified ();
+
+    /// Applies the transposed system_matrix to \p src.
+    /** Uses the transposed Epetra_CrsMatrix::Multiply() on the system_matrix without forming its transpose. */
+    void system_matrix_transpose_vmult (
+        dealii::LinearAlgebra::distributed::Vector<double> &dst,
+        const dealii::LinearAlgebra::distributed::Vector<double> &src) const;
+
+    /// Number of times the system_matrix_transpose has been built with a new sparsity pattern.
+    unsigned int n_transpose_rebuilds = 0;
+    /// Number of times the system_matrix_transpose values have been updated in place.
+    unsigned int n_transpose_updates = 0;
 
     //AztecOO dRdW_preconditioner_builder;
 
@@ -265,32 +325,93 @@ public:
     /// Current modal coefficients of the solution
     /** Note that the current processor has read-access to all locally_relevant_dofs
      *  and has write-access to all locally_owned_dofs
+     *
+     *  Read-only, such that every modification goes through set_solution() or modify_solution(),
+     *  which increment the solution version.
      */
-    dealii::LinearAlgebra::distributed::Vector<double> solution;
+    const dealii::LinearAlgebra::distributed::Vector<double> &solution;
+
+    /// Sets the solution, updates its ghost values, and signals that it has been modified.
+    void set_solution (const dealii::LinearAlgebra::distributed::Vector<double> &solution_input);
+    /// Write access to the solution, which signals that it has been modified.
+    /** The right_hand_side and the derivatives assembled by assemble_residual() are only
+     *  re-assembled once the solution, the high_order_grid's volume_nodes, or the dual have changed.
+     *  The version is incremented when the reference is returned. Each modification should therefore
+     *  call it again rather than keep the reference across an assembly, as for modify_dual() and
+     *  HighOrderGrid::modify_volume_nodes().
+     */
+    dealii::LinearAlgebra::distributed::Vector<double> &modify_solution ();
+    /// Version of the solution, incremented by set_solution() and modify_solution().
+    unsigned int get_solution_version () const { return solution_version; }
+    /// Whether the right_hand_side has been assembled at the current solution and volume_nodes.
+    bool right_hand_side_is_current () const;
 private:
-    /// Modal coefficients of the solution used to compute dRdW last
-    /// Will be used to avoid recomputing dRdW.
-    dealii::LinearAlgebra::distributed::Vector<double> solution_dRdW;
-    /// Modal coefficients of the grid nodes used to compute dRdW last
-    /// Will be used to avoid recomputing dRdW.
-    dealii::LinearAlgebra::distributed::Vector<double> volume_nodes_dRdW;
-
-    /// Modal coefficients of the solution used to compute dRdX last
-    /// Will be used to avoid recomputing dRdX.
-    dealii::LinearAlgebra::distributed::Vector<double> solution_dRdX;
-    /// Modal coefficients of the grid nodes used to compute dRdX last
-    /// Will be used to avoid recomputing dRdX.
-    dealii::LinearAlgebra::distributed::Vector<double> volume_nodes_dRdX;
-
-    /// Modal coefficients of the solution used to compute d2R last
-    /// Will be used to avoid recomputing d2R.
-    dealii::LinearAlgebra::distributed::Vector<double> solution_d2R;
-    /// Modal coefficients of the grid nodes used to compute d2R last
-    /// Will be used to avoid recomputing d2R.
-    dealii::LinearAlgebra::distributed::Vector<double> volume_nodes_d2R;
-    /// Dual variables to compute d2R last
-    /// Will be used to avoid recomputing d2R.
-    dealii::LinearAlgebra::distributed::Vector<double> dual_d2R;
+    /// Storage of the solution.
+    dealii::LinearAlgebra::distributed::Vector<double> solution_vector;
+    /// Storage of the dual.
+    dealii::LinearAlgebra::distributed::Vector<real> dual_vector;
+
+    /// Versions of the solution, volume_nodes, and dual at which a quantity has been assembled.
+    /** The versions start at 1 such that a default-constructed state never matches the current one.
+     */
+    struct StateVersions
+    {
+        unsigned int solution = 0;     ///< Version of the solution.
+        unsigned int volume_nodes = 0; ///< Version of the high_order_grid's volume_nodes.
+        unsigned int dual = 0;         ///< Version of the dual.
+
+        /// Whether both states have the same solution and volume_nodes, and the same dual if \p compare_dual.
+        bool matches (const StateVersions &other, const bool compare_dual) const
+        {
+            return solution == other.solution && volume_nodes == other.volume_nodes
+                   && (!compare_dual || dual == other.dual);
+        }
+    };
+    /// Versions of the current solution, volume_nodes, and dual.
+    StateVersions current_state_versions () const;
+
+    unsigned int solution_version = 1; ///< Incremented by set_solution() and modify_solution().
+    unsigned int dual_version = 1; ///< Incremented by set_dual() and modify_dual().
+
+    StateVersions right_hand_side_state; ///< State at which the right_hand_side was last assembled.
+    StateVersions dRdW_state; ///< State at which the system_matrix was last assembled.
+    double dRdW_CFL_mass = 0.0; ///< CFL_mass of the time-scaled mass matrices added to the last system_matrix.
+    StateVersions dRdX_state; ///< State at which dRdXv was last assembled.
+    StateVersions d2R_state; ///< State at which d2RdWdW, d2RdWdX, and d2RdXdX were last assembled.
+
+    /// Inverse mass matrix of a locally owned cell.
+    struct InverseMassBlock
+    {
+        unsigned int first_local_dof; ///< Local index of the first degree of freedom of the cell.
+        /// Position of the cell in the inverse_mass_local_dofs, or dealii::numbers::invalid_unsigned_int if
+        /// the local indices of the cell are first_local_dof, first_local_dof+1, and so on.
+        unsigned int scattered_dofs;
+        unsigned int n_dofs;      ///< Number of degrees of freedom of the cell.
+        unsigned int fe_index;    ///< Reference inverse mass matrix of an affine cell.
+        /// Index in the curved_inverse_mass_matrices, or dealii::numbers::invalid_unsigned_int if the cell is affine.
+        unsigned int curved_index;
+        double inverse_jacobian_determinant; ///< Scales the reference inverse mass matrix of an affine cell.
+    };
+    /// Stores the inverse of \p local_mass_matrix as a block of the inverse mass matrix.
+    /** \p jacobian_determinants are the ratios of the JxW to the quadrature weights, which are
+     *  constant on affine cells.
+     */
+    void add_inverse_mass_block (
+        const unsigned int fe_index,
+        const std::vector<dealii::types::global_dof_index> &dofs_indices,
+        const dealii::FullMatrix<real> &local_mass_matrix,
+        const std::vector<double> &jacobian_determinants);
+
+    std::vector<InverseMassBlock> inverse_mass_blocks; ///< Blocks of the locally owned cells.
+    /// Local indices of the degrees of freedom of the inverse_mass_blocks that are not contiguous, one after the other.
+    /** Empty with the DG numbering of the DoFHandler, where the degrees of freedom of a cell follow each other. */
+    std::vector<unsigned int> inverse_mass_local_dofs;
+    /// Inverse mass matrices of the reference cells of each fe_index, evaluated from the first affine cell.
+    std::vector<dealii::FullMatrix<real>> reference_inverse_mass_matrices;
+    /// Whether the reference inverse mass matrices are diagonal, as with collocated nodes.
+    std::vector<bool> reference_inverse_mass_is_diagonal;
+    /// Inverse mass matrices of the cells whose Jacobian determinant is not constant.
+    std::vector<dealii::FullMatrix<real>> curved_inverse_mass_matrices;
 public:
 
     /// Time it takes for the maximum wavespeed to cross the cell domain.
@@ -300,6 +421,10 @@ public:
      */
     dealii::Vector<double> max_dt_cell;
 
+    /// Sets the max_dt_cell of the cell of \p fe_values_vol from its maximum convective eigenvalue.
+    /** Same as evaluate_CFL(), for the kernels that already have the maximum over the quadrature points. */
+    void set_max_dt_cell (const dealii::FEValues<dim,dim> &fe_values_vol, const real max_convective_eigenvalue);
+
     /// Artificial dissipation in each cell
     dealii::Vector<double> artificial_dissipation_coeffs;
     /// Discontinuity sensor based on projecting to p-1
@@ -312,11 +437,15 @@ public:
     /// Current optimization dual variables corresponding to the residual constraints also known as the adjoint
 	/** This is used to evaluate the dot-product between the dual and the 2nd derivatives of the residual
 	 *  since storing the 2nd order partials of the residual is a very large 3rd order tensor.
+	 *
+	 *  Read-only, such that every modification goes through set_dual() or modify_dual().
 	 */
-    dealii::LinearAlgebra::distributed::Vector<real> dual;
+    const dealii::LinearAlgebra::distributed::Vector<real> &dual;
 
     /// Sets the stored dual variables used to compute the dual dotted with the residual Hessians
     void set_dual(const dealii::LinearAlgebra::distributed::Vector<real> &dual_input);
+    /// Write access to the dual, which signals that it has been modified, see modify_solution().
+    dealii::LinearAlgebra::distributed::Vector<real> &modify_dual ();
 
     /// Evaluate SparsityPattern of dRdX
     /*  Where R represents the residual and X represents the grid degrees of freedom stored as high_order_grid.volume_nodes.
@@ -383,6 +512,10 @@ public:
      *  \mathbf{\text{system_matrix}} = \frac{\partial \mathbf{R}}{\partial \mathbf{u}}
      *  \f]
      *
+     * Nothing is assembled if the requested quantities have already been assembled at the
+     * current solution, volume_nodes, and dual, see modify_solution(). The right-hand side
+     * is always assembled together with the requested derivatives.
+     *
      * It loops over all the cells, evaluates the volume contributions,
      * then loops over the faces of the current cell. Four scenarios may happen
      *
@@ -401,16 +534,56 @@ public:
     //void assemble_residual_dRdW ();
     void assemble_residual (const bool compute_dRdW=false, const bool compute_dRdX=false, const bool compute_d2R=false, const double CFL_mass = 0.0);
 
+    /// Applies dRdW at the current solution to \p direction, without forming the global system_matrix.
+    /** A single forward-mode pass through the residual-only assembly, where the solution coefficients
+     *  are DirectionalFadType seeded with \p direction. The directional derivative of each local residual
+     *  is added into \p dRdW_direction, such that the product is exact at about the cost of one residual.
+     *  The solution, right_hand_side, system_matrix, and their state versions are left untouched.
+     *
+     *  \p direction must have its ghost values updated, and \p dRdW_direction must have the
+     *  layout of the right_hand_side.
+     */
+    void apply_dRdW (
+        const dealii::LinearAlgebra::distributed::Vector<double> &direction,
+        dealii::LinearAlgebra::distributed::Vector<double> &dRdW_direction);
+
+    /// Assembles the right_hand_side of the locally owned cells flagged in \p assembled_cells.
+    /** \p assembled_cells is indexed by the active_cell_index. A face is only assembled by the cell that
+     *  does its work if that cell is flagged, such that the right-hand side of a cell is complete when the
+     *  cell and all its face neighbours are flagged on every processor. The other entries are partial.
+     *  The right_hand_side is therefore not recorded as assembled at the current state, and the next
+     *  assemble_residual() assembles all the cells again.
+     *
+     *  Used by the multirate time steps to only evaluate the fast cells and their face neighbours.
+     */
+    void assemble_residual_of_cells (const std::vector<bool> &assembled_cells);
+
+    /// Number of times assemble_residual() has assembled, excluding the calls skipped at an unchanged state.
+    unsigned int n_residual_assemblies = 0;
+
+    /// Number of times the mapping collection and FEValues used by assemble_residual() have been built.
+    /** They are kept between calls and only rebuilt after allocate_system() or when the
+     *  high-order grid's mapping has been re-created. Moving the volume_nodes does not trigger a rebuild.
+     */
+    unsigned int n_assembly_scratch_rebuilds = 0;
+
+    /// Number of times the geometry_store has been evaluated.
+    /** Only re-evaluated after allocate_system() or when the HighOrderGrid::get_volume_nodes_version() has changed. */
+    unsigned int n_geometry_store_rebuilds = 0;
+
     /// Used in assemble_residual(). 
     /** IMPORTANT: This does not fully compute the cell residual since it might not
      *  perform the work on all the faces.
      *  All the active cells must be traversed to ensure that the right hand side is correct.
+     *  The volume terms are skipped if \p assemble_volume_terms is false, when they have been
+     *  assembled for the whole cell batch, see assemble_cell_batch().
      */
     template<typename DoFCellAccessorType1, typename DoFCellAccessorType2>
     void assemble_cell_residual (
         const DoFCellAccessorType1 &current_cell,
         const DoFCellAccessorType2 &current_metric_cell,
         const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R,
+        const bool assemble_volume_terms,
         dealii::hp::FEValues<dim,dim>        &fe_values_collection_volume,
         dealii::hp::FEFaceValues<dim,dim>    &fe_values_collection_face_int,
         dealii::hp::FEFaceValues<dim,dim>    &fe_values_collection_face_ext,
@@ -509,6 +682,56 @@ protected:
         const std::vector<dealii::types::global_dof_index> &current_dofs_indices,
         dealii::Vector<real> &current_cell_rhs,
         const dealii::FEValues<dim,dim> &fe_values_lagrange) = 0;
+
+    /// Evaluate the integral over the cell volume, and its dRdW if requested, from the geometry_store.
+    /** The volume FEValues of the cell are then not reinitialized. Returns false if the volume terms are
+     *  instead left to assemble_volume_terms_explicit() or assemble_volume_terms_derivatives(), which is the default.
+     *  Within apply_dRdW(), the directional derivative of the volume terms is evaluated instead.
+     */
+    virtual bool assemble_volume_terms_geometry_store(
+        const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell,
+        const unsigned int i_fele,
+        const std::vector<dealii::types::global_dof_index> &current_dofs_indices,
+        dealii::Vector<real> &current_cell_rhs,
+        const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R);
+
+    /// Evaluate the integral over an interior face between two cells of the same refinement level from the geometry_store.
+    /** The face FEValues of both cells are then not reinitialized. Returns false if the face terms are
+     *  instead left to assemble_face_term_explicit() or assemble_face_term_derivatives(), which is the default.
+     */
+    virtual bool assemble_face_term_geometry_store(
+        const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell_int,
+        const unsigned int iface_int,
+        const unsigned int i_fele_int,
+        const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell_ext,
+        const unsigned int iface_ext,
+        const unsigned int i_fele_ext,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &dof_indices_int,
+        const std::vector<dealii::types::global_dof_index> &dof_indices_ext,
+        dealii::Vector<real> &local_rhs_int_cell,
+        dealii::Vector<real> &local_rhs_ext_cell,
+        const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R);
+
+    /// Metric terms of the locally owned cells, evaluated once per HighOrderGrid::get_volume_nodes_version().
+    /** Only evaluated if geometry_store_is_used, see assemble_volume_terms_geometry_store(). */
+    GeometryStore<dim> geometry_store;
+    /// Whether the assemblies read the geometry_store, set by the derived classes reading it.
+    bool geometry_store_is_used = false;
+
+    /// Locally owned cells of the same active_fe_index, assembled together by assemble_cell_batch().
+    /** Holds at most dealii::VectorizedArray<double>::size() cells, see make_cell_batches(). */
+    using CellBatch = std::vector<typename dealii::DoFHandler<dim>::active_cell_iterator>;
+
+    /// Evaluate the integral over the volume of all the cells of a batch.
+    /** Each cell of the batch is reinitialized in its own FEValues of \p fe_values_collection_volume_lanes,
+     *  and its contribution is added to \p rhs. Returns false if the volume terms are instead left to
+     *  assemble_volume_terms_explicit() one cell at a time, which is the default.
+     */
+    virtual bool assemble_volume_terms_explicit_cell_batch(
+        const CellBatch &cells,
+        std::vector<std::unique_ptr<dealii::hp::FEValues<dim,dim>>> &fe_values_collection_volume_lanes,
+        dealii::LinearAlgebra::distributed::Vector<double> &rhs);
     /// Evaluate the integral over the cell edges that are on domain boundaries
     virtual void assemble_boundary_term_explicit(
         const unsigned int boundary_id,
@@ -570,7 +793,184 @@ protected:
 protected:
     MPI_Comm mpi_communicator; ///< MPI communicator
     dealii::ConditionalOStream pcout; ///< Parallel std::cout that only outputs on mpi_rank==0
+
+    /// Adds the \p row_values of the local \p row into the \p col_indices of \p global_matrix.
+    /** Used by the derived classes for every addition into system_matrix, dRdXv, d2RdWdW, d2RdWdX, and d2RdXdX.
+     *  Within assemble_cells_threaded(), the row is recorded in the AssemblyCopyData of the thread
+     *  and added by the copier instead, since Trilinos matrices cannot be written to concurrently.
+     */
+    void add_to_global_matrix (
+        dealii::TrilinosWrappers::SparseMatrix &global_matrix,
+        const dealii::types::global_dof_index row,
+        const std::vector<dealii::types::global_dof_index> &col_indices,
+        const std::vector<real> &row_values);
+
+    /// Adds the \p local_matrix into the \p row_indices and \p col_indices of \p global_matrix.
+    /** Same as the single row version, row by row. */
+    void add_to_global_matrix (
+        dealii::TrilinosWrappers::SparseMatrix &global_matrix,
+        const std::vector<dealii::types::global_dof_index> &row_indices,
+        const std::vector<dealii::types::global_dof_index> &col_indices,
+        const dealii::FullMatrix<real> &local_matrix);
+
+    /// Adds the \p local_vector into the \p indices of \p global_vector.
+    /** Within assemble_cells_threaded(), the entries are recorded and added by the copier. */
+    void add_to_global_vector (
+        dealii::LinearAlgebra::distributed::Vector<double> &global_vector,
+        const std::vector<dealii::types::global_dof_index> &indices,
+        const dealii::Vector<real> &local_vector);
+
+    /// Direction of the Jacobian-vector product within apply_dRdW(), nullptr otherwise.
+    /** While set, the explicit terms evaluate the local residuals with DirectionalFadType and
+     *  return their directional derivative instead of their value.
+     */
+    const dealii::LinearAlgebra::distributed::Vector<double> *dRdW_product_direction = nullptr;
+
+    /// Solution coefficients at \p dof_indices.
+    /** With DirectionalFadType, the derivative of each coefficient is seeded with the dRdW_product_direction. */
+    template <typename adtype>
+    std::vector<adtype> local_solution_coefficients (const std::vector<dealii::types::global_dof_index> &dof_indices) const
+    {
+        std::vector<adtype> soln_coeff(dof_indices.size());
+        for (unsigned int idof = 0; idof < dof_indices.size(); ++idof) {
+            soln_coeff[idof] = solution(dof_indices[idof]);
+            if constexpr (std::is_same<adtype,DirectionalFadType>::value) {
+                soln_coeff[idof].diff(0, 1);
+                soln_coeff[idof].fastAccessDx(0) = (*dRdW_product_direction)(dof_indices[idof]);
+            }
+        }
+        return soln_coeff;
+    }
+
+    /// Local residual value added to the assembled vector.
+    static real local_residual_contribution (const real value) { return value; }
+    /// Directional derivative of the local residual added to the dRdW_product within apply_dRdW().
+    static real local_residual_contribution (const DirectionalFadType &value) { return value.fastAccessDx(0); }
 private:
+    /// Whether the system_matrix_transpose holds the transpose of the current system_matrix.
+    bool system_matrix_transpose_is_current = false;
+    /// Transpose of the locally stored system_matrix entries.
+    /** Its rows are the columns of the system_matrix, including the ones of ghosted degrees of freedom.
+     *  Exported and summed into the system_matrix_transpose by transpose_exporter.
+     */
+    std::unique_ptr<Epetra_CrsMatrix> local_transpose;
+    /// Exports the rows of local_transpose to the processors owning them in system_matrix_transpose.
+    std::unique_ptr<Epetra_Export> transpose_exporter;
+    /// Position in the local_transpose values of each locally stored system_matrix entry, row by row.
+    std::vector<int> transpose_permutation;
+    /// Epetra matrix of the system_matrix from which the transpose_permutation was built.
+    /** Used with the number of entries to detect a new sparsity pattern. */
+    const Epetra_CrsMatrix *transposed_matrix_source = nullptr;
+
+    /// Builds the local_transpose, transpose_exporter, transpose_permutation, and the system_matrix_transpose pattern.
+    void build_system_matrix_transpose ();
+
+
+    /// FEValues used by a single thread of the threaded cell loop.
+    /** WorkStream copy-constructs one of these for each thread.
+     *  Holds the same objects as the serial loop of assemble_residual().
+     */
+    struct AssemblyScratchData
+    {
+        /// Constructor.
+        AssemblyScratchData (
+            const dealii::hp::MappingCollection<dim> &mapping_collection,
+            const dealii::hp::FECollection<dim>      &fe_collection,
+            const dealii::hp::FECollection<dim>      &fe_collection_lagrange,
+            const dealii::hp::QCollection<dim>       &volume_quadrature_collection,
+            const dealii::hp::QCollection<dim-1>     &face_quadrature_collection,
+            const dealii::UpdateFlags volume_update_flags,
+            const dealii::UpdateFlags face_update_flags,
+            const dealii::UpdateFlags neighbor_face_update_flags);
+
+        /// Copy constructor re-creating the FEValues from the same collections.
+        AssemblyScratchData (const AssemblyScratchData &scratch_data);
+
+        dealii::hp::FEValues<dim,dim>        fe_values_collection_volume; ///< FEValues of volume.
+        dealii::hp::FEFaceValues<dim,dim>    fe_values_collection_face_int; ///< FEValues of interior face.
+        dealii::hp::FEFaceValues<dim,dim>    fe_values_collection_face_ext; ///< FEValues of exterior face.
+        dealii::hp::FESubfaceValues<dim,dim> fe_values_collection_subface; ///< FEValues of subface.
+        dealii::hp::FEValues<dim,dim>        fe_values_collection_volume_lagrange; ///< FEValues of the Lagrange basis.
+        /// FEValues of volume of each cell of a CellBatch, see assemble_volume_terms_explicit_cell_batch().
+        std::vector<std::unique_ptr<dealii::hp::FEValues<dim,dim>>> fe_values_collection_volume_lanes;
+    };
+    /// Global writes of a single cell batch, recorded by the workers of the threaded cell loop.
+    /** The copier of assemble_cells_threaded() adds them into the global matrices and residual.
+     *  WorkStream re-uses the copy data between batches, such that the rows keep their allocation.
+     */
+    struct AssemblyCopyData
+    {
+        /// Entries of a row of a global matrix, or of a global vector if matrix is nullptr.
+        struct Row
+        {
+            dealii::TrilinosWrappers::SparseMatrix *matrix; ///< Global matrix.
+            dealii::LinearAlgebra::distributed::Vector<double> *vector; ///< Global vector.
+            dealii::types::global_dof_index row; ///< Row of the global matrix.
+            std::vector<dealii::types::global_dof_index> indices; ///< Columns, or vector indices.
+            std::vector<real> values; ///< Values added at the indices.
+        };
+        /// Recorded rows. Only the first n_rows are used.
+        std::vector<Row> rows;
+        /// Number of rows recorded for the current cell batch.
+        unsigned int n_rows = 0;
+
+        /// Returns a cleared row at the end of the recorded rows.
+        Row &new_row ();
+    };
+
+    /// Copy data of the cell batch currently assembled by each thread.
+    /** nullptr outside of the workers of assemble_cells_threaded(), in which case the global writes are direct. */
+    dealii::Threads::ThreadLocalStorage<AssemblyCopyData *> thread_copy_data;
+
+    /// Product accumulated within apply_dRdW(), nullptr otherwise.
+    /** While set, the cell loop adds the local residuals into it instead of the right_hand_side. */
+    dealii::LinearAlgebra::distributed::Vector<double> *dRdW_product = nullptr;
+
+    /// Cells assembled within assemble_residual_of_cells(), indexed by active_cell_index, nullptr otherwise.
+    /** While set, make_cell_batches() skips the cells that are not flagged. */
+    const std::vector<bool> *assembled_cells_filter = nullptr;
+
+    /// Mapping from which assembly_mapping_collection was built.
+    /** Held to detect when the high-order grid creates a new mapping_fe_field. */
+    std::shared_ptr<const dealii::Mapping<dim>> assembly_mapping_source;
+    /// Mapping collection used by the assembly_scratch_data.
+    std::unique_ptr<dealii::hp::MappingCollection<dim>> assembly_mapping_collection;
+    /// FEValues used by assemble_residual(), kept between calls.
+    /** The threaded assembly uses it as the sample copied to each thread. */
+    std::unique_ptr<AssemblyScratchData> assembly_scratch_data;
+
+    /// Builds the assembly_scratch_data if it has been invalidated or if the grid's mapping has changed.
+    void update_assembly_scratch_data ();
+
+    /// Evaluates the geometry_store if it is used and has been invalidated or if the volume_nodes have moved.
+    /** Must be called after update_assembly_scratch_data() since it uses its mapping collection. */
+    void update_geometry_store ();
+
+    /// Threaded version of the cell loop in assemble_residual().
+    /** The cell batches are distributed to the threads through dealii::WorkStream. The workers record
+     *  their global writes in an AssemblyCopyData, which the copier adds one batch at a time,
+     *  in the same order as the serial loop.
+     */
+    void assemble_cells_threaded (
+        const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R);
+
+    /// Groups the consecutive locally owned cells of the same active_fe_index into CellBatch.
+    /** Only the cells flagged in the assembled_cells_filter are grouped when it is set. */
+    std::vector<CellBatch> make_cell_batches () const;
+
+    /// Assembles the residual, or its derivatives, of the cells of a batch.
+    /** The explicit volume terms of the whole batch are first given to
+     *  assemble_volume_terms_explicit_cell_batch(), then assemble_cell_residual() is called on each cell.
+     */
+    void assemble_cell_batch (
+        const CellBatch &cells,
+        const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R,
+        AssemblyScratchData &scratch_data);
+
+    /// Cell loop of assemble_residual() and apply_dRdW().
+    /** Uses assemble_cells_threaded() when more than one assembly thread is requested. */
+    void assemble_cells (
+        const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R);
 
     /** Evaluate the average penalty term at the face.
      *  For a cell with solution of degree p, and Hausdorff measure h,
@@ -633,6 +1033,9 @@ public:
 
     ~DGWeak(); ///< Destructor.
 
+    /// Creates a DGWeak of the same physics on the same triangulation.
+    std::shared_ptr<DGBase<dim,real>> create_discretization_copy (const Parameters::AllParameters *const parameters_input = nullptr) const override;
+
     using FadType = Sacado::Fad::DFad<real>; ///< Sacado AD type for first derivatives.
     using FadFadType = Sacado::Fad::DFad<FadType>; ///< Sacado AD type that allows 2nd derivatives.
     using RadFadType = Sacado::Rad::ADvar<FadType>; ///< Sacado AD type that allows 2nd derivatives.
@@ -651,6 +1054,22 @@ public:
     /// Dissipative numerical flux with FadType
     NumericalFlux::NumericalFluxDissipative<dim, nstate, FadType > *diss_num_flux;
 
+    /// Contains the physics of the PDE with StaticFadType
+    /** Set to nullptr when the physics is changed through set_physics(), in which case dRdW uses FadType. */
+    std::shared_ptr < Physics::PhysicsBase<dim, nstate, StaticFadType > > pde_physics_static_fad;
+    /// Convective numerical flux with StaticFadType
+    NumericalFlux::NumericalFluxConvective<dim, nstate, StaticFadType > *conv_num_flux_static_fad;
+    /// Dissipative numerical flux with StaticFadType
+    NumericalFlux::NumericalFluxDissipative<dim, nstate, StaticFadType > *diss_num_flux_static_fad;
+
+    /// Contains the physics of the PDE with DirectionalFadType, used by DGBase::apply_dRdW()
+    /** Set to nullptr when the real physics is changed through set_physics(). */
+    std::shared_ptr < Physics::PhysicsBase<dim, nstate, DirectionalFadType > > pde_physics_directional;
+    /// Convective numerical flux with DirectionalFadType
+    NumericalFlux::NumericalFluxConvective<dim, nstate, DirectionalFadType > *conv_num_flux_directional;
+    /// Dissipative numerical flux with DirectionalFadType
+    NumericalFlux::NumericalFluxDissipative<dim, nstate, DirectionalFadType > *diss_num_flux_directional;
+
     /// Contains the physics of the PDE with FadFadType
     std::shared_ptr < Physics::PhysicsBase<dim, nstate, FadFadType > > pde_physics_fad_fad;
     /// Convective numerical flux with FadFadType
@@ -722,13 +1141,85 @@ private:
         dealii::Vector<real>          &local_rhs_ext_cell,
         const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R);
 
+    /// Whether dRdW alone is requested and can be assembled from the pointwise flux Jacobians.
+    /** The metric terms then come from the FEValues and only the physics is differentiated.
+     *  Otherwise, the derivatives are assembled with FadFadType.
+     */
+    bool use_first_order_fad (const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R) const;
+    /// Whether the flux Jacobians with \p n_total_indep independent variables can use StaticFadType.
+    bool can_use_static_fad (const unsigned int n_total_indep) const;
+
+    /// Evaluate the integral over the cell volume and its dRdW from the pointwise flux Jacobians.
+    /** Only the physics at each quadrature point is differentiated, with respect to the
+     *  nstate*(dim+1) values of the solution and its gradient. dRdW is then obtained by
+     *  chain rule through the basis functions, such that the number of AD variables
+     *  does not grow with the polynomial degree.
+     */
+    template <typename adtype>
+    void assemble_volume_terms_flux_jacobians(
+        const dealii::FEValues<dim,dim> &fe_values_vol,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices,
+        dealii::Vector<real> &local_rhs_cell,
+        const Physics::PhysicsBase<dim, nstate, adtype> &physics);
+    /// Evaluate the integral over the boundary face and its dRdW from the pointwise flux Jacobians.
+    template <typename adtype>
+    void assemble_boundary_term_flux_jacobians(
+        const unsigned int boundary_id,
+        const dealii::FEFaceValuesBase<dim,dim> &fe_values_boundary,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices,
+        dealii::Vector<real> &local_rhs_cell,
+        const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+        const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad);
+    /// Evaluate the integral over the internal face and the four dRdW blocks from the pointwise numerical flux Jacobians.
+    /** The numerical fluxes are differentiated with respect to the solution and gradient of both sides. */
+    template <typename adtype>
+    void assemble_face_term_flux_jacobians(
+        const dealii::FEFaceValuesBase<dim,dim>     &fe_values_int,
+        const dealii::FEFaceValuesBase<dim,dim>     &fe_values_ext,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices_int,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices_ext,
+        dealii::Vector<real>          &local_rhs_int_cell,
+        dealii::Vector<real>          &local_rhs_ext_cell,
+        const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+        const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad);
 
     /// Evaluate the integral over the cell volume
+    /** Within DGBase::apply_dRdW(), its directional derivative is evaluated instead. */
     void assemble_volume_terms_explicit(
         const dealii::FEValues<dim,dim> &fe_values_volume,
         const std::vector<dealii::types::global_dof_index> &current_dofs_indices,
         dealii::Vector<real> &current_cell_rhs, 
         const dealii::FEValues<dim,dim> &fe_values_lagrange);
+    /// Evaluate the integral over the cell volume with the scalar type \p adtype.
+    /** With real, the residual is added to \p local_rhs_cell. With DirectionalFadType,
+     *  its derivative along DGBase::dRdW_product_direction is added instead.
+     */
+    template <typename adtype>
+    void assemble_volume_terms_explicit_ad(
+        const dealii::FEValues<dim,dim> &fe_values_vol,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices,
+        dealii::Vector<real> &local_rhs_cell,
+        Physics::PhysicsBase<dim, nstate, adtype> &physics);
+    /// Evaluate the integral over the volume of a batch of cells with assemble_volume_terms_explicit_fixed_degree().
+    /** Returns false for the degrees without a fixed-degree kernel, or with artificial dissipation. */
+    bool assemble_volume_terms_explicit_cell_batch(
+        const typename DGBase<dim,real>::CellBatch &cells,
+        std::vector<std::unique_ptr<dealii::hp::FEValues<dim,dim>>> &fe_values_collection_volume_lanes,
+        dealii::LinearAlgebra::distributed::Vector<double> &rhs) override;
+    /// Evaluate the integral over the volume of a batch of cells for a fixed polynomial degree and number of quadrature points.
+    /** Same discretization as assemble_volume_terms_explicit(). The number of degrees of freedom and quadrature points
+     *  are compile-time constants such that the loops can be unrolled. The convective flux and eigenvalue of a
+     *  quadrature point are evaluated for all the cells at once, one cell per dealii::VectorizedArray<double> lane.
+     */
+    template <int poly_degree, int n_quad_pts_1d>
+    void assemble_volume_terms_explicit_fixed_degree(
+        const typename DGBase<dim,real>::CellBatch &cells,
+        std::vector<std::unique_ptr<dealii::hp::FEValues<dim,dim>>> &fe_values_collection_volume_lanes,
+        dealii::LinearAlgebra::distributed::Vector<double> &rhs);
     /// Evaluate the integral over the cell edges that are on domain boundaries
     void assemble_boundary_term_explicit(
         const unsigned int boundary_id,
@@ -736,6 +1227,18 @@ private:
         const real penalty,
         const std::vector<dealii::types::global_dof_index> &current_dofs_indices,
         dealii::Vector<real> &current_cell_rhs);
+    /// Evaluate the integral over the cell edges that are on domain boundaries with the scalar type \p adtype.
+    /** See assemble_volume_terms_explicit_ad(). */
+    template <typename adtype>
+    void assemble_boundary_term_explicit_ad(
+        const unsigned int boundary_id,
+        const dealii::FEFaceValuesBase<dim,dim> &fe_values_boundary,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices,
+        dealii::Vector<real> &local_rhs_cell,
+        Physics::PhysicsBase<dim, nstate, adtype> &physics,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+        const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad);
     /// Evaluate the integral over the internal cell edges
     void assemble_face_term_explicit(
         const dealii::FEFaceValuesBase<dim,dim>     &fe_values_face_int,
@@ -745,6 +1248,52 @@ private:
         const std::vector<dealii::types::global_dof_index> &neighbor_dofs_indices,
         dealii::Vector<real>          &current_cell_rhs,
         dealii::Vector<real>          &neighbor_cell_rhs);
+    /// Evaluate the integral over the internal cell edges with the scalar type \p adtype.
+    /** See assemble_volume_terms_explicit_ad(). */
+    template <typename adtype>
+    void assemble_face_term_explicit_ad(
+        const dealii::FEFaceValuesBase<dim,dim>     &fe_values_int,
+        const dealii::FEFaceValuesBase<dim,dim>     &fe_values_ext,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices_int,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices_ext,
+        dealii::Vector<real>          &local_rhs_int_cell,
+        dealii::Vector<real>          &local_rhs_ext_cell,
+        Physics::PhysicsBase<dim, nstate, adtype> &physics,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+        const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad);
+    /// Evaluate the convective numerical flux at all the face quadrature points.
+    /** With real, the points are processed dealii::VectorizedArray<double>::size() at a time through
+     *  evaluate_convective_numerical_flux_batch(). The lanes of the last batch that do not have
+     *  a quadrature point repeat the last point and are discarded.
+     *  Other scalar types are evaluated one point at a time.
+     */
+    template <typename adtype>
+    void evaluate_convective_numerical_flux_batched(
+        const std::vector< std::array<adtype,nstate> > &soln_int,
+        const std::vector< std::array<adtype,nstate> > &soln_ext,
+        const std::vector< dealii::Tensor<1,dim> > &normals_int,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+        std::vector< std::array<adtype,nstate> > &conv_num_flux_dot_n) const;
+    /// Convective flux and maximum convective eigenvalue of dealii::VectorizedArray<double>::size() solutions, one per lane.
+    /** Physics::Euler evaluates them with SIMD instructions through its kernels templated on the scalar type.
+     *  The other physics loop over the lanes.
+     */
+    void evaluate_convective_flux_batch (
+        const std::array<dealii::VectorizedArray<double>,nstate> &soln_batch,
+        std::array<dealii::Tensor<1,dim,dealii::VectorizedArray<double>>,nstate> &conv_flux_batch,
+        dealii::VectorizedArray<double> &max_eig_batch) const;
+    /// Convective numerical flux of dealii::VectorizedArray<double>::size() interface points, one per lane.
+    /** The Roe and Lax-Friedrichs fluxes of Physics::Euler are evaluated with SIMD instructions through their
+     *  kernels templated on the scalar type. The other numerical fluxes loop over the lanes.
+     */
+    std::array<dealii::VectorizedArray<double>,nstate> evaluate_convective_numerical_flux_batch (
+        const std::array<dealii::VectorizedArray<double>,nstate> &soln_int_batch,
+        const std::array<dealii::VectorizedArray<double>,nstate> &soln_ext_batch,
+        const dealii::Tensor<1,dim,dealii::VectorizedArray<double>> &normal_int_batch,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, real> &conv_num_flux) const;
+    /// Throws if apply_dRdW() is used after the real physics was changed without a DirectionalFadType one.
+    void assert_directional_physics () const;
 
     using DGBase<dim,real>::mpi_communicator; ///< MPI communicator
     using DGBase<dim,real>::pcout; ///< Parallel std::cout that only outputs on mpi_rank==0
@@ -759,9 +1308,31 @@ public:
     /// Change the physics object
     void set_physics(std::shared_ptr< Physics::PhysicsBase<dim, nstate, Sacado::Rad::ADvar<Sacado::Fad::DFad<real>> > >pde_physics_input);
     /// Change the physics object
+    /** Also removes the default DirectionalFadType physics, which must then be given separately for apply_dRdW(). */
     void set_physics(std::shared_ptr< Physics::PhysicsBase<dim, nstate, real > >pde_physics_double_input);
+    /// Change the physics object used by DGBase::apply_dRdW()
+    void set_physics(std::shared_ptr< Physics::PhysicsBase<dim, nstate, DirectionalFadType > >pde_physics_input);
 }; // end of DGWeak class
 
+/// Physics and numerical fluxes evaluated with the AD type \p adtype.
+/** Used by DGStrong to hold one set of objects per DegreeFadType. */
+template <int dim, int nstate, typename adtype>
+struct PhysicsAndNumericalFluxes
+{
+    /// AD type of the physics and numerical fluxes.
+    using ADType = adtype;
+
+    /// Creates the physics and numerical fluxes chosen by the parameters.
+    explicit PhysicsAndNumericalFluxes (const Parameters::AllParameters *const parameters_input);
+
+    /// Physics of the PDE.
+    std::shared_ptr < Physics::PhysicsBase<dim, nstate, adtype > > pde_physics;
+    /// Convective numerical flux.
+    std::unique_ptr < NumericalFlux::NumericalFluxConvective<dim, nstate, adtype > > conv_num_flux;
+    /// Dissipative numerical flux.
+    std::unique_ptr < NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype > > diss_num_flux;
+};
+
 /// DGStrong class templated on the number of state variables
 /*  Contains the functions that need to be templated on the number of state variables.
  */
@@ -793,6 +1364,9 @@ public:
     /// Destructor
     ~DGStrong();
 
+    /// Creates a DGStrong of the same physics on the same triangulation.
+    std::shared_ptr<DGBase<dim,real>> create_discretization_copy (const Parameters::AllParameters *const parameters_input = nullptr) const override;
+
 private:
     using FadType = Sacado::Fad::DFad<real>; ///< Sacado AD type for first derivatives.
     using FadFadType = Sacado::Fad::DFad<FadType>; ///< Sacado AD type that allows 2nd derivatives.
@@ -822,6 +1396,31 @@ private:
     /// Dissipative numerical flux with FadType
     NumericalFlux::NumericalFluxDissipative<dim, nstate, FadType > *diss_num_flux;
 
+    /// Physics and numerical fluxes with DegreeFadType<1> to DegreeFadType<max_static_fad_degree>.
+    /** Reset when the physics is changed through set_physics(), in which case dRdW uses FadType. */
+    std::unique_ptr < PhysicsAndNumericalFluxes<dim, nstate, DegreeFadType<1> > > static_fad_p1;
+    /// See static_fad_p1.
+    std::unique_ptr < PhysicsAndNumericalFluxes<dim, nstate, DegreeFadType<2> > > static_fad_p2;
+    /// See static_fad_p1.
+    std::unique_ptr < PhysicsAndNumericalFluxes<dim, nstate, DegreeFadType<3> > > static_fad_p3;
+    /// See static_fad_p1.
+    std::unique_ptr < PhysicsAndNumericalFluxes<dim, nstate, DegreeFadType<4> > > static_fad_p4;
+
+    /// Contains the physics of the PDE with DirectionalFadType, used by DGBase::apply_dRdW()
+    /** Set to nullptr when the real physics is changed through set_physics(). */
+    std::shared_ptr < Physics::PhysicsBase<dim, nstate, DirectionalFadType > > pde_physics_directional;
+    /// Convective numerical flux with DirectionalFadType
+    NumericalFlux::NumericalFluxConvective<dim, nstate, DirectionalFadType > *conv_num_flux_directional;
+    /// Dissipative numerical flux with DirectionalFadType
+    NumericalFlux::NumericalFluxDissipative<dim, nstate, DirectionalFadType > *diss_num_flux_directional;
+
+    /// Calls \p assemble with the static_fad_p1 to static_fad_p4 objects of the smallest DegreeFadType holding \p n_total_indep derivatives.
+    /** Returns false without calling \p assemble if use_static_fad is off, the physics was changed through set_physics(),
+     *  or \p n_total_indep exceeds static_fad_derivatives(max_static_fad_degree), in which case dRdW uses FadType.
+     */
+    template <typename Assembler>
+    bool assemble_with_static_fad (const unsigned int n_total_indep, const Assembler &assemble) const;
+
     /// Contains the physics of the PDE with FadFadType
     std::shared_ptr < Physics::PhysicsBase<dim, nstate, FadFadType > > pde_physics_fad_fad;
     /// Convective numerical flux with FadFadType
@@ -880,12 +1479,148 @@ private:
         dealii::Vector<real>          &local_rhs_ext_cell,
         const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R);
 
+    /// Evaluate the integral over the cell volume and its dRdW with the AD type \p adtype.
+    template <typename adtype>
+    void assemble_volume_terms_derivatives_ad(
+        const dealii::FEValues<dim,dim> &fe_values_vol,
+        const std::vector<dealii::types::global_dof_index> &cell_dofs_indices,
+        dealii::Vector<real> &local_rhs_int_cell,
+        const dealii::FEValues<dim,dim> &fe_values_lagrange,
+        const Physics::PhysicsBase<dim, nstate, adtype> &physics);
+    /// Evaluate the integral over the boundary face and its dRdW with the AD type \p adtype.
+    template <typename adtype>
+    void assemble_boundary_term_derivatives_ad(
+        const unsigned int boundary_id,
+        const dealii::FEFaceValuesBase<dim,dim> &fe_values_boundary,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices,
+        dealii::Vector<real> &local_rhs_int_cell,
+        const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+        const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad);
+    /// Evaluate the integral over the internal face and the four dRdW blocks with the AD type \p adtype.
+    template <typename adtype>
+    void assemble_face_term_derivatives_ad(
+        const dealii::FEFaceValuesBase<dim,dim>     &fe_values_int,
+        const dealii::FEFaceValuesBase<dim,dim>     &fe_values_ext,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices_int,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices_ext,
+        dealii::Vector<real>          &local_rhs_int_cell,
+        dealii::Vector<real>          &local_rhs_ext_cell,
+        const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+        const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad);
+
     /// Evaluate the integral over the cell volume
+    /** Within DGBase::apply_dRdW(), its directional derivative is evaluated instead. */
     void assemble_volume_terms_explicit(
         const dealii::FEValues<dim,dim> &fe_values_volume,
         const std::vector<dealii::types::global_dof_index> &current_dofs_indices,
         dealii::Vector<real> &current_cell_rhs,
         const dealii::FEValues<dim,dim> &fe_values_lagrange);
+    /// Evaluate the integral over the cell volume with the scalar type \p adtype.
+    /** With real, the residual is added to \p local_rhs_cell. With DirectionalFadType,
+     *  its derivative along DGBase::dRdW_product_direction is added instead.
+     */
+    template <typename adtype>
+    void assemble_volume_terms_explicit_ad(
+        const dealii::FEValues<dim,dim> &fe_values_vol,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices,
+        dealii::Vector<real> &local_rhs_cell,
+        const dealii::FEValues<dim,dim> &fe_values_lagrange,
+        Physics::PhysicsBase<dim, nstate, adtype> &physics);
+    /// Evaluate the integral over the cell volume, and its dRdW if requested, using sum-factorization.
+    /** Used for the cells whose basis and quadrature are tensor products, with the metric terms of the geometry_store.
+     *  Returns false otherwise, or if the derivatives with respect to the grid are requested.
+     */
+    bool assemble_volume_terms_geometry_store(
+        const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell,
+        const unsigned int i_fele,
+        const std::vector<dealii::types::global_dof_index> &current_dofs_indices,
+        dealii::Vector<real> &current_cell_rhs,
+        const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R) override;
+    /// Evaluate the integral over the cell volume using sum-factorization with the scalar type \p adtype.
+    /** Selects the kernel unrolled for the number of 1D basis functions when \p adtype is real or DirectionalFadType.
+     *  With FadType and DegreeFadType, the dRdW block of the cell is also added to the system_matrix.
+     */
+    template <typename adtype>
+    void assemble_volume_terms_sum_factorization(
+        const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell,
+        const SumFactorization::TensorProductBasis<dim> &basis,
+        const std::vector<dealii::types::global_dof_index> &current_dofs_indices,
+        dealii::Vector<real> &current_cell_rhs,
+        const Physics::PhysicsBase<dim, nstate, adtype> &physics);
+    /// Sum-factorized volume terms of assemble_volume_terms_sum_factorization().
+    /** Same discretization as assemble_volume_terms_explicit(), but the interpolation to the quadrature points,
+     *  the flux divergence, and the integration are applied one direction at a time through the
+     *  one-dimensional operators of the \p basis.
+     *  The number of 1D basis functions and quadrature points are compile-time constants when positive.
+     */
+    template <int n_dofs_1d, int n_quad_1d, typename adtype>
+    void assemble_volume_terms_sum_factorization_kernel(
+        const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell,
+        const SumFactorization::TensorProductBasis<dim> &basis,
+        const std::vector<dealii::types::global_dof_index> &current_dofs_indices,
+        dealii::Vector<real> &current_cell_rhs,
+        const Physics::PhysicsBase<dim, nstate, adtype> &physics);
+    /// Evaluate the integral over an interior face, or its directional derivative within apply_dRdW(), using sum-factorization.
+    /** Used when both cells are locally owned, share the same tensor-product basis, and see the face in its
+     *  standard orientation, such that their face quadrature points coincide.
+     *  Returns false otherwise, or if any derivative matrix is requested.
+     */
+    bool assemble_face_term_geometry_store(
+        const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell_int,
+        const unsigned int iface_int,
+        const unsigned int i_fele_int,
+        const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell_ext,
+        const unsigned int iface_ext,
+        const unsigned int i_fele_ext,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &dof_indices_int,
+        const std::vector<dealii::types::global_dof_index> &dof_indices_ext,
+        dealii::Vector<real> &local_rhs_int_cell,
+        dealii::Vector<real> &local_rhs_ext_cell,
+        const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R) override;
+    /// Sum-factorized interior face terms with the scalar type \p adtype.
+    /** Selects the kernel unrolled for the number of 1D basis functions. */
+    template <typename adtype>
+    void assemble_face_term_sum_factorization(
+        const unsigned int cell_index_int,
+        const unsigned int iface_int,
+        const unsigned int cell_index_ext,
+        const unsigned int iface_ext,
+        const SumFactorization::TensorProductBasis<dim> &basis,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &dof_indices_int,
+        const std::vector<dealii::types::global_dof_index> &dof_indices_ext,
+        dealii::Vector<real> &local_rhs_int_cell,
+        dealii::Vector<real> &local_rhs_ext_cell,
+        const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+        const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad);
+    /// Sum-factorized face terms of assemble_face_term_sum_factorization().
+    /** Same discretization as assemble_face_term_explicit(). The solution of each cell is restricted to the face
+     *  along its normal direction, then interpolated in the tangential directions through the one-dimensional
+     *  operators of the \p basis. The face points of each cell are matched through TensorProductBasis::face_lexicographic_index.
+     */
+    template <int n_dofs_1d, int n_quad_1d, typename adtype>
+    void assemble_face_term_sum_factorization_kernel(
+        const unsigned int cell_index_int,
+        const unsigned int iface_int,
+        const unsigned int cell_index_ext,
+        const unsigned int iface_ext,
+        const SumFactorization::TensorProductBasis<dim> &basis,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &dof_indices_int,
+        const std::vector<dealii::types::global_dof_index> &dof_indices_ext,
+        dealii::Vector<real> &local_rhs_int_cell,
+        dealii::Vector<real> &local_rhs_ext_cell,
+        const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+        const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad);
+    /// Tensor-product operators of each fe_collection entry. Only built if use_sum_factorization is set.
+    std::vector< SumFactorization::TensorProductBasis<dim> > tensor_product_bases;
     /// Evaluate the integral over the cell edges that are on domain boundaries
     void assemble_boundary_term_explicit(
         const unsigned int boundary_id,
@@ -893,6 +1628,18 @@ private:
         const real penalty,
         const std::vector<dealii::types::global_dof_index> &current_dofs_indices,
         dealii::Vector<real> &current_cell_rhs);
+    /// Evaluate the integral over the cell edges that are on domain boundaries with the scalar type \p adtype.
+    /** See assemble_volume_terms_explicit_ad(). */
+    template <typename adtype>
+    void assemble_boundary_term_explicit_ad(
+        const unsigned int boundary_id,
+        const dealii::FEFaceValuesBase<dim,dim> &fe_values_boundary,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices,
+        dealii::Vector<real> &local_rhs_cell,
+        Physics::PhysicsBase<dim, nstate, adtype> &physics,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+        const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad);
     /// Evaluate the integral over the internal cell edges
     void assemble_face_term_explicit(
         const dealii::FEFaceValuesBase<dim,dim>     &fe_values_face_int,
@@ -902,6 +1649,22 @@ private:
         const std::vector<dealii::types::global_dof_index> &neighbor_dofs_indices,
         dealii::Vector<real>          &current_cell_rhs,
         dealii::Vector<real>          &neighbor_cell_rhs);
+    /// Evaluate the integral over the internal cell edges with the scalar type \p adtype.
+    /** See assemble_volume_terms_explicit_ad(). */
+    template <typename adtype>
+    void assemble_face_term_explicit_ad(
+        const dealii::FEFaceValuesBase<dim,dim>     &fe_values_int,
+        const dealii::FEFaceValuesBase<dim,dim>     &fe_values_ext,
+        const real penalty,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices_int,
+        const std::vector<dealii::types::global_dof_index> &soln_dof_indices_ext,
+        dealii::Vector<real>          &local_rhs_int_cell,
+        dealii::Vector<real>          &local_rhs_ext_cell,
+        Physics::PhysicsBase<dim, nstate, adtype> &physics,
+        const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+        const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad);
+    /// Throws if apply_dRdW() is used after the real physics was changed without a DirectionalFadType one.
+    void assert_directional_physics () const;
 
     using DGBase<dim,real>::all_parameters; ///< Pointer to all parameters
     using DGBase<dim,real>::mpi_communicator; ///< MPI communicator
@@ -917,7 +1680,10 @@ public:
     /// Change the physics object
     void set_physics(std::shared_ptr< Physics::PhysicsBase<dim, nstate, Sacado::Rad::ADvar<Sacado::Fad::DFad<real>> > >pde_physics_input);
     /// Change the physics object
+    /** Also removes the default DirectionalFadType physics, which must then be given separately for apply_dRdW(). */
     void set_physics(std::shared_ptr< Physics::PhysicsBase<dim, nstate, real > >pde_physics_double_input);
+    /// Change the physics object used by DGBase::apply_dRdW()
+    void set_physics(std::shared_ptr< Physics::PhysicsBase<dim, nstate, DirectionalFadType > >pde_physics_input);
 }; // end of DGStrong class
 
 /// This class creates a new DGBase object
@@ -0,0 +1,131 @@
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/hp/fe_values.h>
+#include <deal.II/hp/fe_face_values.h>
+
+#include "geometry_store.h"
+
+namespace PHiLiP {
+
+template <int dim>
+void GeometryStore<dim>::reinit (
+    const dealii::hp::MappingCollection<dim> &mapping_collection,
+    const dealii::DoFHandler<dim>            &dof_handler,
+    const dealii::hp::FECollection<dim>      &fe_collection,
+    const dealii::hp::QCollection<dim>       &volume_quadrature_collection,
+    const dealii::hp::QCollection<dim-1>     &face_quadrature_collection,
+    const unsigned int volume_nodes_version_input)
+{
+    const unsigned int n_active_cells = dof_handler.get_triangulation().n_active_cells();
+
+    // First pass to size the contiguous arrays.
+    volume_offset.assign(n_active_cells+1, 0);
+    for (auto cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell) {
+        if (!cell->is_locally_owned()) continue;
+        volume_offset[cell->active_cell_index()+1] = volume_quadrature_collection[cell->active_fe_index()].size();
+    }
+    for (unsigned int i = 1; i < volume_offset.size(); ++i) volume_offset[i] += volume_offset[i-1];
+
+    face_offset.assign(n_active_cells*faces_per_cell+1, 0);
+    for (auto cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell) {
+        if (!cell->is_locally_owned()) continue;
+        for (unsigned int iface = 0; iface < faces_per_cell; ++iface) {
+            face_offset[cell->active_cell_index()*faces_per_cell + iface + 1] = face_quadrature_collection[cell->active_fe_index()].size();
+        }
+    }
+    for (unsigned int i = 1; i < face_offset.size(); ++i) face_offset[i] += face_offset[i-1];
+
+    const unsigned int n_volume_points = volume_offset.back();
+    volume_JxW.resize(n_volume_points);
+    for (auto &entry : volume_inverse_jacobian) entry.resize(n_volume_points);
+    for (auto &coordinate : volume_quadrature_points) coordinate.resize(n_volume_points);
+
+    const unsigned int n_face_points = face_offset.back();
+    face_JxW_values.resize(n_face_points);
+    for (auto &component : face_normals) component.resize(n_face_points);
+    for (auto &entry : face_inverse_jacobians) entry.resize(n_face_points);
+
+    // Only the mapping is evaluated, not the shape functions.
+    const dealii::UpdateFlags update_flags = dealii::update_JxW_values | dealii::update_inverse_jacobians | dealii::update_quadrature_points;
+    dealii::hp::FEValues<dim,dim> fe_values_collection_volume (mapping_collection, fe_collection, volume_quadrature_collection, update_flags);
+    const dealii::UpdateFlags face_update_flags = dealii::update_JxW_values | dealii::update_inverse_jacobians | dealii::update_normal_vectors;
+    dealii::hp::FEFaceValues<dim,dim> fe_values_collection_face (mapping_collection, fe_collection, face_quadrature_collection, face_update_flags);
+
+    for (auto cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell) {
+        if (!cell->is_locally_owned()) continue;
+
+        const int i_fele = cell->active_fe_index();
+        const int i_quad = i_fele;
+        const int i_mapp = 0;
+        fe_values_collection_volume.reinit (cell, i_quad, i_mapp, i_fele);
+        const dealii::FEValues<dim,dim> &fe_values_volume = fe_values_collection_volume.get_present_fe_values();
+
+        const unsigned int first_point = volume_offset[cell->active_cell_index()];
+        for (unsigned int iquad = 0; iquad < fe_values_volume.n_quadrature_points; ++iquad) {
+            const unsigned int ipoint = first_point + iquad;
+            volume_JxW[ipoint] = fe_values_volume.JxW(iquad);
+            const dealii::DerivativeForm<1,dim,dim> &inverse_jacobian = fe_values_volume.inverse_jacobian(iquad);
+            for (int e=0; e<dim; ++e) {
+                for (int d=0; d<dim; ++d) {
+                    volume_inverse_jacobian[e*dim+d][ipoint] = inverse_jacobian[e][d];
+                }
+            }
+            const dealii::Point<dim> &point = fe_values_volume.quadrature_point(iquad);
+            for (int d=0; d<dim; ++d) {
+                volume_quadrature_points[d][ipoint] = point[d];
+            }
+        }
+
+        for (unsigned int iface = 0; iface < faces_per_cell; ++iface) {
+            fe_values_collection_face.reinit (cell, iface, i_quad, i_mapp, i_fele);
+            const dealii::FEFaceValues<dim,dim> &fe_values_face = fe_values_collection_face.get_present_fe_values();
+
+            const unsigned int first_face_point = face_offset[cell->active_cell_index()*faces_per_cell + iface];
+            for (unsigned int iquad = 0; iquad < fe_values_face.n_quadrature_points; ++iquad) {
+                const unsigned int ipoint = first_face_point + iquad;
+                face_JxW_values[ipoint] = fe_values_face.JxW(iquad);
+                const dealii::Tensor<1,dim> &normal = fe_values_face.normal_vector(iquad);
+                const dealii::DerivativeForm<1,dim,dim> &inverse_jacobian = fe_values_face.inverse_jacobian(iquad);
+                for (int e=0; e<dim; ++e) {
+                    face_normals[e][ipoint] = normal[e];
+                    for (int d=0; d<dim; ++d) {
+                        face_inverse_jacobians[e*dim+d][ipoint] = inverse_jacobian[e][d];
+                    }
+                }
+            }
+        }
+    }
+    volume_nodes_version = volume_nodes_version_input;
+}
+
+template <int dim>
+void GeometryStore<dim>::clear ()
+{
+    volume_nodes_version = 0;
+    volume_offset.clear();
+    volume_JxW.clear();
+    for (auto &entry : volume_inverse_jacobian) entry.clear();
+    for (auto &coordinate : volume_quadrature_points) coordinate.clear();
+    face_offset.clear();
+    face_JxW_values.clear();
+    for (auto &component : face_normals) component.clear();
+    for (auto &entry : face_inverse_jacobians) entry.clear();
+}
+
+template <int dim>
+std::size_t GeometryStore<dim>::memory_consumption () const
+{
+    std::size_t memory = dealii::MemoryConsumption::memory_consumption(volume_offset)
+                       + dealii::MemoryConsumption::memory_consumption(volume_JxW);
+    for (const auto &entry : volume_inverse_jacobian) memory += dealii::MemoryConsumption::memory_consumption(entry);
+    for (const auto &coordinate : volume_quadrature_points) memory += dealii::MemoryConsumption::memory_consumption(coordinate);
+    memory += dealii::MemoryConsumption::memory_consumption(face_offset)
+            + dealii::MemoryConsumption::memory_consumption(face_JxW_values);
+    for (const auto &component : face_normals) memory += dealii::MemoryConsumption::memory_consumption(component);
+    for (const auto &entry : face_inverse_jacobians) memory += dealii::MemoryConsumption::memory_consumption(entry);
+    return memory;
+}
+
+template class GeometryStore <PHILIP_DIM>;
+
+} // PHiLiP namespace
@@ -0,0 +1,131 @@
+#ifndef __GEOMETRY_STORE_H__
+#define __GEOMETRY_STORE_H__
+
+#include <array>
+#include <vector>
+
+#include <deal.II/base/geometry_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/hp/fe_collection.h>
+#include <deal.II/hp/mapping_collection.h>
+#include <deal.II/hp/q_collection.h>
+
+namespace PHiLiP {
+
+/// Metric terms at the volume and face quadrature points of the locally owned cells.
+/** The values only depend on the high-order grid nodes. They are evaluated once through the mapping
+ *  for a given HighOrderGrid::get_volume_nodes_version(), and read by the assemblies that do not differentiate
+ *  with respect to the grid, which then skip the FEValues reinitialization of the cell.
+ *
+ *  The data is stored as a structure-of-arrays. Each component is a single contiguous vector over
+ *  all the quadrature points, and the points of a cell start at an offset indexed by its active_cell_index.
+ *  The points of a cell follow the volume quadrature of its active_fe_index, as in DGBase::assemble_cell_residual().
+ *  The face data is stored for each face of each cell, seen from that cell, with the face quadrature
+ *  of its active_fe_index and the outward normal of the cell.
+ */
+template <int dim>
+class GeometryStore
+{
+public:
+    /// Evaluates the metric terms of the locally owned cells of \p dof_handler.
+    void reinit (
+        const dealii::hp::MappingCollection<dim> &mapping_collection,
+        const dealii::DoFHandler<dim>            &dof_handler,
+        const dealii::hp::FECollection<dim>      &fe_collection,
+        const dealii::hp::QCollection<dim>       &volume_quadrature_collection,
+        const dealii::hp::QCollection<dim-1>     &face_quadrature_collection,
+        const unsigned int volume_nodes_version_input);
+
+    /// Releases the stored data, such that the next is_current() returns false.
+    void clear ();
+
+    /// Whether the metric terms were evaluated with the volume nodes of \p volume_nodes_version_input.
+    bool is_current (const unsigned int volume_nodes_version_input) const
+    {
+        return !volume_offset.empty() && volume_nodes_version == volume_nodes_version_input;
+    }
+
+    /// Whether the metric terms of this cell are stored, i.e. the cell is locally owned.
+    bool has_cell (const unsigned int cell_index) const
+    {
+        return cell_index+1 < volume_offset.size() && volume_offset[cell_index+1] != volume_offset[cell_index];
+    }
+
+    /// Number of volume quadrature points stored for a cell.
+    unsigned int n_volume_quad_pts (const unsigned int cell_index) const
+    {
+        return volume_offset[cell_index+1] - volume_offset[cell_index];
+    }
+
+    /// JxW at the volume quadrature points of a cell.
+    const double *JxW (const unsigned int cell_index) const
+    {
+        return &volume_JxW[volume_offset[cell_index]];
+    }
+    /// Entry dXi_e/dx_d of the inverse metric Jacobian at the volume quadrature points of a cell.
+    const double *inverse_jacobian (const unsigned int cell_index, const int e, const int d) const
+    {
+        return &volume_inverse_jacobian[e*dim+d][volume_offset[cell_index]];
+    }
+    /// Physical coordinate \p d of the volume quadrature points of a cell.
+    const double *quadrature_point (const unsigned int cell_index, const int d) const
+    {
+        return &volume_quadrature_points[d][volume_offset[cell_index]];
+    }
+
+    /// Number of quadrature points stored for face \p iface of a cell.
+    unsigned int n_face_quad_pts (const unsigned int cell_index, const unsigned int iface) const
+    {
+        const unsigned int face_index = cell_index*faces_per_cell + iface;
+        return face_offset[face_index+1] - face_offset[face_index];
+    }
+
+    /// JxW at the quadrature points of face \p iface of a cell.
+    const double *face_JxW (const unsigned int cell_index, const unsigned int iface) const
+    {
+        return &face_JxW_values[face_offset[cell_index*faces_per_cell + iface]];
+    }
+    /// Component \p d of the outward unit normal at the quadrature points of face \p iface of a cell.
+    const double *face_normal (const unsigned int cell_index, const unsigned int iface, const int d) const
+    {
+        return &face_normals[d][face_offset[cell_index*faces_per_cell + iface]];
+    }
+    /// Entry dXi_e/dx_d of the inverse metric Jacobian at the quadrature points of face \p iface of a cell.
+    const double *face_inverse_jacobian (const unsigned int cell_index, const unsigned int iface, const int e, const int d) const
+    {
+        return &face_inverse_jacobians[e*dim+d][face_offset[cell_index*faces_per_cell + iface]];
+    }
+
+    /// Memory used by the stored metric terms in bytes.
+    std::size_t memory_consumption () const;
+
+private:
+    /// HighOrderGrid::get_volume_nodes_version() of the volume nodes used by reinit().
+    unsigned int volume_nodes_version = 0;
+
+    /// First volume quadrature point of each active cell. Size n_active_cells+1.
+    std::vector<unsigned int> volume_offset;
+    /// JxW at the volume quadrature points.
+    std::vector<double> volume_JxW;
+    /// Inverse metric Jacobian at the volume quadrature points, one vector per entry [e*dim+d].
+    std::array<std::vector<double>, dim*dim> volume_inverse_jacobian;
+    /// Physical volume quadrature points, one vector per coordinate.
+    std::array<std::vector<double>, dim> volume_quadrature_points;
+
+    /// Number of faces of a cell.
+    static constexpr unsigned int faces_per_cell = dealii::GeometryInfo<dim>::faces_per_cell;
+    /// First face quadrature point of each face of each active cell. Size n_active_cells*faces_per_cell+1.
+    std::vector<unsigned int> face_offset;
+    /// JxW at the face quadrature points.
+    std::vector<double> face_JxW_values;
+    /// Outward unit normal at the face quadrature points, one vector per component.
+    std::array<std::vector<double>, dim> face_normals;
+    /// Inverse metric Jacobian of the cell at its face quadrature points, one vector per entry [e*dim+d].
+    std::array<std::vector<double>, dim*dim> face_inverse_jacobians;
+};
+
+} // PHiLiP namespace
+
+#endif
@@ -0,0 +1,133 @@
+#include <Epetra_MultiVector.h>
+
+#include "matrix_free_jacobian.h"
+
+#include "global_counter.hpp"
+
+namespace PHiLiP {
+
+template <int dim, typename real>
+MatrixFreeJacobian<dim,real>::MatrixFreeJacobian (std::shared_ptr< DGBase<dim,real> > dg_input)
+    : dg(dg_input)
+    , jacobian_scaling(1.0)
+    , added_matrix(nullptr)
+    , dof_map(dg_input->locally_owned_dofs.make_trilinos_map(dg_input->solution.get_mpi_communicator(), false))
+{
+    reinit();
+}
+
+template <int dim, typename real>
+void MatrixFreeJacobian<dim,real>::reinit ()
+{
+    src_vector.reinit(dg->solution);
+    dst_vector.reinit(dg->right_hand_side);
+    apply_result.reinit(dg->right_hand_side);
+    if (static_cast<unsigned int>(dof_map.NumMyElements()) != dg->locally_owned_dofs.n_elements()) {
+        dof_map = dg->locally_owned_dofs.make_trilinos_map(dg->solution.get_mpi_communicator(), false);
+    }
+}
+
+template <int dim, typename real>
+void MatrixFreeJacobian<dim,real>::set_operator_scaling (
+    const double jacobian_scaling_input,
+    const dealii::TrilinosWrappers::SparseMatrix *added_matrix_input)
+{
+    jacobian_scaling = jacobian_scaling_input;
+    added_matrix = added_matrix_input;
+}
+
+template <int dim, typename real>
+void MatrixFreeJacobian<dim,real>::vmult (
+    dealii::LinearAlgebra::distributed::Vector<double> &dst,
+    const dealii::LinearAlgebra::distributed::Vector<double> &src) const
+{
+    ++n_applications;
+    n_vmult += 1;
+    dRdW_mult += 1;
+
+    dg->apply_dRdW(src, dst);
+    if (jacobian_scaling != 1.0) dst *= jacobian_scaling;
+
+    if (added_matrix != nullptr) {
+        added_matrix->vmult(dst_vector, src);
+        dst += dst_vector;
+    }
+}
+
+template <int dim, typename real>
+int MatrixFreeJacobian<dim,real>::Apply (const Epetra_MultiVector &X, Epetra_MultiVector &Y) const
+{
+    const unsigned int n_local = dg->locally_owned_dofs.n_elements();
+    AssertDimension(static_cast<unsigned int>(X.MyLength()), n_local);
+    AssertDimension(static_cast<unsigned int>(Y.MyLength()), n_local);
+
+    for (int ivec = 0; ivec < X.NumVectors(); ++ivec) {
+        for (unsigned int i = 0; i < n_local; ++i) {
+            src_vector.local_element(i) = X[ivec][i];
+        }
+        src_vector.update_ghost_values();
+        vmult(apply_result, src_vector);
+        for (unsigned int i = 0; i < n_local; ++i) {
+            Y[ivec][i] = apply_result.local_element(i);
+        }
+    }
+    return 0;
+}
+
+template <int dim, typename real>
+int MatrixFreeJacobian<dim,real>::ApplyInverse (const Epetra_MultiVector &/*X*/, Epetra_MultiVector &/*Y*/) const
+{
+    return -1;
+}
+
+template <int dim, typename real>
+int MatrixFreeJacobian<dim,real>::SetUseTranspose (bool use_transpose)
+{
+    return use_transpose ? -1 : 0;
+}
+
+template <int dim, typename real>
+double MatrixFreeJacobian<dim,real>::NormInf () const
+{
+    return 0.0;
+}
+
+template <int dim, typename real>
+const char * MatrixFreeJacobian<dim,real>::Label () const
+{
+    return "MatrixFreeJacobian";
+}
+
+template <int dim, typename real>
+bool MatrixFreeJacobian<dim,real>::UseTranspose () const
+{
+    return false;
+}
+
+template <int dim, typename real>
+bool MatrixFreeJacobian<dim,real>::HasNormInf () const
+{
+    return false;
+}
+
+template <int dim, typename real>
+const Epetra_Comm & MatrixFreeJacobian<dim,real>::Comm () const
+{
+    return dof_map.Comm();
+}
+
+template <int dim, typename real>
+const Epetra_Map & MatrixFreeJacobian<dim,real>::OperatorDomainMap () const
+{
+    return dof_map;
+}
+
+template <int dim, typename real>
+const Epetra_Map & MatrixFreeJacobian<dim,real>::OperatorRangeMap () const
+{
+    return dof_map;
+}
+
+template class MatrixFreeJacobian <PHILIP_DIM, double>;
+
+} // PHiLiP namespace
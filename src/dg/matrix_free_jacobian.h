@@ -0,0 +1,104 @@
+#ifndef __MATRIX_FREE_JACOBIAN_H__
+#define __MATRIX_FREE_JACOBIAN_H__
+
+#include <memory>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+
+#include <Epetra_Operator.h>
+#include <Epetra_Map.h>
+
+#include "dg.h"
+
+namespace PHiLiP {
+
+/// Matrix-free action of the residual Jacobian.
+/** Applies
+ *  \f[
+ *      \mathbf{y} = \alpha \frac{\partial \mathbf{R}}{\partial \mathbf{w}} \mathbf{v} + \mathbf{A} \mathbf{v}
+ *  \f]
+ *  without forming dRdW, where \f$\mathbf{A}\f$ is an optional matrix such as the time-scaled mass matrix.
+ *  With \f$\alpha=-1\f$ and the time-scaled mass matrix, this is the operator of the backward-Euler step
+ *  solved by the Implicit_ODESolver.
+ *
+ *  The Jacobian-vector product is evaluated exactly by DGBase::apply_dRdW(), which runs the
+ *  residual assembly once with the solution seeded along the direction (DirectionalFadType).
+ *  No local dRdW block is formed, and the storage is limited to a few vectors.
+ *
+ *  Derives from Epetra_Operator such that it can be given to LinearSolver::solve() and AztecOO.
+ *  The DGBase state is never modified by the products.
+ */
+template <int dim, typename real>
+class MatrixFreeJacobian : public Epetra_Operator
+{
+public:
+    /// Constructor.
+    MatrixFreeJacobian (std::shared_ptr< DGBase<dim,real> > dg_input);
+
+    /// Destructor.
+    ~MatrixFreeJacobian() {};
+
+    /// Resizes the work vectors to the current DGBase degrees of freedom.
+    /** The operator is always linearized about the current DGBase solution.
+     *  Must be called after the degrees of freedom have been re-distributed.
+     */
+    void reinit ();
+
+    /// Sets the scaling of the Jacobian and the matrix added to the operator.
+    /** The matrix is not copied and must outlive the operator. A nullptr removes it. */
+    void set_operator_scaling (
+        const double jacobian_scaling,
+        const dealii::TrilinosWrappers::SparseMatrix *added_matrix = nullptr);
+
+    /// Applies the operator to \p src.
+    void vmult (
+        dealii::LinearAlgebra::distributed::Vector<double> &dst,
+        const dealii::LinearAlgebra::distributed::Vector<double> &src) const;
+
+    /// Number of operator applications since construction.
+    mutable unsigned int n_applications = 0;
+
+    /// Epetra_Operator interface.
+    /** Applies vmult() on each vector of \p X. */
+    int Apply (const Epetra_MultiVector &X, Epetra_MultiVector &Y) const override;
+    /// Not available for this operator. Returns -1.
+    int ApplyInverse (const Epetra_MultiVector &X, Epetra_MultiVector &Y) const override;
+    /// Only the non-transposed operator is available. Returns -1 if \p use_transpose is true.
+    int SetUseTranspose (bool use_transpose) override;
+    /// Not available. Returns 0.
+    double NormInf () const override;
+    /// Name of the operator.
+    const char * Label () const override;
+    /// Always false.
+    bool UseTranspose () const override;
+    /// Always false.
+    bool HasNormInf () const override;
+    /// Communicator of the DGBase degrees of freedom.
+    const Epetra_Comm & Comm () const override;
+    /// Map of the locally owned DGBase degrees of freedom.
+    const Epetra_Map & OperatorDomainMap () const override;
+    /// Map of the locally owned DGBase degrees of freedom.
+    const Epetra_Map & OperatorRangeMap () const override;
+
+protected:
+    /// DG discretization providing the residual.
+    std::shared_ptr< DGBase<dim,real> > dg;
+
+    /// Scaling of the Jacobian-vector product.
+    double jacobian_scaling;
+    /// Matrix added to the operator.
+    const dealii::TrilinosWrappers::SparseMatrix *added_matrix;
+
+    /// Map of the locally owned degrees of freedom.
+    Epetra_Map dof_map;
+
+    /// Work vectors.
+    mutable dealii::LinearAlgebra::distributed::Vector<double> src_vector, dst_vector;
+    /// Product of a single vector of the Epetra_MultiVector given to Apply().
+    mutable dealii::LinearAlgebra::distributed::Vector<double> apply_result;
+};
+
+} // PHiLiP namespace
+
+#endif
@@ -0,0 +1,352 @@
+#include <algorithm>
+#include <map>
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+#include <Amesos.h>
+#include <Epetra_MultiVector.h>
+#include <Epetra_Vector.h>
+
+#include "p_multigrid_preconditioner.h"
+#include "linear_solver/linear_solver.h"
+
+namespace PHiLiP {
+
+template <int dim, typename real>
+PMultigridPreconditioner<dim,real>::PMultigridPreconditioner (
+    std::shared_ptr< DGBase<dim,real> > dg_input,
+    const Parameters::LinearSolverParam &param_input)
+    : dg(dg_input)
+    , param(param_input)
+    , fine_matrix(nullptr)
+{
+    Assert(param.p_multigrid_smoother == Parameters::LinearSolverParam::PreconditionerEnum::block_jacobi
+           || param.p_multigrid_smoother == Parameters::LinearSolverParam::PreconditionerEnum::block_gauss_seidel,
+           dealii::ExcMessage("The p_multigrid smoother must be block_jacobi or block_gauss_seidel."));
+
+    const dealii::hp::FECollection<dim> &fe_collection = dg->fe_collection;
+    unsigned int max_cell_degree = 0;
+    for (const auto &cell : dg->dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned()) continue;
+        max_cell_degree = std::max(max_cell_degree, cell->get_fe().tensor_degree());
+    }
+    const unsigned int fine_degree = dealii::Utilities::MPI::max(max_cell_degree, MPI_COMM_WORLD);
+    // Collocated nodes do not have a degree 0 entry.
+    const unsigned int coarse_degree = std::min(fine_degree,
+        std::max(param.p_multigrid_coarse_degree, fe_collection[0].tensor_degree()));
+
+    const unsigned int n_levels = fine_degree - coarse_degree + 1;
+    levels.resize(n_levels);
+    for (unsigned int ilevel = 0; ilevel < n_levels; ++ilevel) {
+        Level &level = levels[ilevel];
+        level.degree = fine_degree - ilevel;
+
+        if (ilevel == 0) {
+            level.locally_owned_dofs = dg->locally_owned_dofs;
+        } else {
+            // Same cells as the fine level, with their degree limited to the level degree.
+            level.dof_handler = std::make_unique<dealii::DoFHandler<dim>>(*(dg->triangulation), true);
+            level.dof_handler->initialize(*(dg->triangulation), fe_collection);
+
+            auto coarse_cell = level.dof_handler->begin_active();
+            for (auto fine_cell = dg->dof_handler.begin_active(); fine_cell != dg->dof_handler.end(); ++fine_cell, ++coarse_cell) {
+                if (!fine_cell->is_locally_owned()) continue;
+                const unsigned int cell_degree = std::min(fine_cell->get_fe().tensor_degree(), level.degree);
+                unsigned int fe_index = 0;
+                while (fe_collection[fe_index].tensor_degree() != cell_degree) ++fe_index;
+                coarse_cell->set_active_fe_index(fe_index);
+            }
+            level.dof_handler->distribute_dofs(fe_collection);
+            level.locally_owned_dofs = level.dof_handler->locally_owned_dofs();
+
+            level.solution.reinit(level.locally_owned_dofs, MPI_COMM_WORLD);
+            level.right_hand_side.reinit(level.locally_owned_dofs, MPI_COMM_WORLD);
+        }
+        level.cell_blocks = partition_into_cell_blocks((ilevel == 0) ? dg->dof_handler : *(level.dof_handler));
+        level.residual.reinit(level.locally_owned_dofs, MPI_COMM_WORLD);
+        level.correction.reinit(level.locally_owned_dofs, MPI_COMM_WORLD);
+    }
+
+    build_prolongations ();
+}
+
+template <int dim, typename real>
+dealii::FullMatrix<double> PMultigridPreconditioner<dim,real>::reference_prolongation (
+    const dealii::FiniteElement<dim> &fe_coarse,
+    const dealii::FiniteElement<dim> &fe_fine)
+{
+    const unsigned int n_dofs_coarse = fe_coarse.dofs_per_cell;
+    const unsigned int n_dofs_fine = fe_fine.dofs_per_cell;
+    const unsigned int n_components = fe_fine.n_components();
+    Assert(n_components == fe_coarse.n_components(), dealii::ExcDimensionMismatch(n_components, fe_coarse.n_components()));
+
+    // Exact for the products of the fine basis functions.
+    const dealii::QGauss<dim> projection_quadrature(fe_fine.tensor_degree()+1);
+    const std::vector<dealii::Point<dim,double>> &unit_quad_pts = projection_quadrature.get_points();
+
+    dealii::FullMatrix<double> mass(n_dofs_fine, n_dofs_fine);
+    dealii::FullMatrix<double> mixed_mass(n_dofs_fine, n_dofs_coarse);
+    for (unsigned int iquad=0; iquad<projection_quadrature.size(); ++iquad) {
+        const double weight = projection_quadrature.weight(iquad);
+        for (unsigned int row=0; row<n_dofs_fine; ++row) {
+            const unsigned int istate = fe_fine.system_to_component_index(row).first;
+            const double row_value = fe_fine.shape_value_component(row, unit_quad_pts[iquad], istate);
+            for (unsigned int col=0; col<n_dofs_fine; ++col) {
+                if (fe_fine.system_to_component_index(col).first != istate) continue;
+                mass[row][col] += row_value * fe_fine.shape_value_component(col, unit_quad_pts[iquad], istate) * weight;
+            }
+            for (unsigned int col=0; col<n_dofs_coarse; ++col) {
+                if (fe_coarse.system_to_component_index(col).first != istate) continue;
+                mixed_mass[row][col] += row_value * fe_coarse.shape_value_component(col, unit_quad_pts[iquad], istate) * weight;
+            }
+        }
+    }
+    mass.gauss_jordan();
+
+    dealii::FullMatrix<double> prolongation(n_dofs_fine, n_dofs_coarse);
+    mass.mmult(prolongation, mixed_mass);
+    return prolongation;
+}
+
+template <int dim, typename real>
+void PMultigridPreconditioner<dim,real>::build_prolongations ()
+{
+    const dealii::hp::FECollection<dim> &fe_collection = dg->fe_collection;
+    for (unsigned int ilevel = 0; ilevel+1 < levels.size(); ++ilevel) {
+        Level &fine = levels[ilevel];
+        const Level &coarse = levels[ilevel+1];
+        const dealii::DoFHandler<dim> &fine_dof_handler = (ilevel == 0) ? dg->dof_handler : *(fine.dof_handler);
+        const dealii::DoFHandler<dim> &coarse_dof_handler = *(coarse.dof_handler);
+
+        // Only couples the degrees of freedom of the same cell.
+        dealii::DynamicSparsityPattern dsp(fine_dof_handler.n_dofs(), coarse_dof_handler.n_dofs(), fine.locally_owned_dofs);
+        std::vector<dealii::types::global_dof_index> fine_dofs_indices, coarse_dofs_indices;
+        auto coarse_cell = coarse_dof_handler.begin_active();
+        for (auto fine_cell = fine_dof_handler.begin_active(); fine_cell != fine_dof_handler.end(); ++fine_cell, ++coarse_cell) {
+            if (!fine_cell->is_locally_owned()) continue;
+            fine_dofs_indices.resize(fine_cell->get_fe().dofs_per_cell);
+            coarse_dofs_indices.resize(coarse_cell->get_fe().dofs_per_cell);
+            fine_cell->get_dof_indices(fine_dofs_indices);
+            coarse_cell->get_dof_indices(coarse_dofs_indices);
+            for (const auto row : fine_dofs_indices) {
+                dsp.add_entries(row, coarse_dofs_indices.begin(), coarse_dofs_indices.end());
+            }
+        }
+        fine.prolongation.reinit(fine.locally_owned_dofs, coarse.locally_owned_dofs, dsp, MPI_COMM_WORLD);
+
+        // The reference prolongation only depends on the pair of degrees.
+        std::map<std::pair<unsigned int, unsigned int>, dealii::FullMatrix<double>> reference_prolongations;
+        coarse_cell = coarse_dof_handler.begin_active();
+        for (auto fine_cell = fine_dof_handler.begin_active(); fine_cell != fine_dof_handler.end(); ++fine_cell, ++coarse_cell) {
+            if (!fine_cell->is_locally_owned()) continue;
+            const std::pair<unsigned int, unsigned int> fe_indices(fine_cell->active_fe_index(), coarse_cell->active_fe_index());
+            auto reference = reference_prolongations.find(fe_indices);
+            if (reference == reference_prolongations.end()) {
+                reference = reference_prolongations.emplace(fe_indices,
+                    reference_prolongation (fe_collection[fe_indices.second], fe_collection[fe_indices.first])).first;
+            }
+            fine_dofs_indices.resize(fine_cell->get_fe().dofs_per_cell);
+            coarse_dofs_indices.resize(coarse_cell->get_fe().dofs_per_cell);
+            fine_cell->get_dof_indices(fine_dofs_indices);
+            coarse_cell->get_dof_indices(coarse_dofs_indices);
+            fine.prolongation.set(fine_dofs_indices, coarse_dofs_indices, reference->second);
+        }
+        fine.prolongation.compress(dealii::VectorOperation::insert);
+    }
+}
+
+template <int dim, typename real>
+void PMultigridPreconditioner<dim,real>::initialize (const dealii::TrilinosWrappers::SparseMatrix &fine_matrix_input)
+{
+    fine_matrix = &fine_matrix_input;
+
+    // Galerkin coarse operators.
+    for (unsigned int ilevel = 1; ilevel < levels.size(); ++ilevel) {
+        dealii::TrilinosWrappers::SparseMatrix matrix_times_prolongation;
+        level_matrix(ilevel-1).mmult(matrix_times_prolongation, levels[ilevel-1].prolongation);
+        levels[ilevel-1].prolongation.Tmmult(levels[ilevel].coarse_matrix, matrix_times_prolongation);
+    }
+
+    for (unsigned int ilevel = 0; ilevel+1 < levels.size(); ++ilevel) {
+        levels[ilevel].smoother = build_block_preconditioner (level_matrix(ilevel), param.p_multigrid_smoother, levels[ilevel].cell_blocks);
+    }
+
+    const dealii::TrilinosWrappers::SparseMatrix &coarsest_matrix = level_matrix(levels.size()-1);
+    coarse_problem = std::make_unique<Epetra_LinearProblem>();
+    coarse_problem->SetOperator(const_cast<Epetra_CrsMatrix *>(&coarsest_matrix.trilinos_matrix()));
+    Amesos Factory;
+    coarse_solver.reset(Factory.Create("Amesos_Klu", *coarse_problem));
+    Assert(coarse_solver != nullptr, dealii::ExcMessage("Amesos could not create the coarse solver."));
+    int ierr = coarse_solver->SymbolicFactorization();
+    ierr += coarse_solver->NumericFactorization();
+    Assert(ierr == 0, dealii::ExcMessage("The factorization of the coarsest level failed."));
+    (void) ierr;
+}
+
+template <int dim, typename real>
+const dealii::TrilinosWrappers::SparseMatrix & PMultigridPreconditioner<dim,real>::level_matrix (const unsigned int ilevel) const
+{
+    if (ilevel == 0) return *fine_matrix;
+    return levels[ilevel].coarse_matrix;
+}
+
+template <int dim, typename real>
+unsigned int PMultigridPreconditioner<dim,real>::n_levels () const
+{
+    return levels.size();
+}
+
+template <int dim, typename real>
+void PMultigridPreconditioner<dim,real>::smooth (
+    const unsigned int ilevel,
+    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+    const dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side) const
+{
+    const Level &level = levels[ilevel];
+    const Epetra_CrsMatrix &matrix = level_matrix(ilevel).trilinos_matrix();
+    Epetra_Vector residual(View, matrix.RangeMap(), level.residual.begin());
+    Epetra_Vector correction(View, matrix.DomainMap(), level.correction.begin());
+    for (unsigned int step = 0; step < param.p_multigrid_smoothing_steps; ++step) {
+        level_matrix(ilevel).vmult(level.residual, solution);
+        level.residual.sadd(-1.0, 1.0, right_hand_side);
+        level.smoother->ApplyInverse(residual, correction);
+        solution.add(param.p_multigrid_smoother_damping, level.correction);
+    }
+}
+
+template <int dim, typename real>
+void PMultigridPreconditioner<dim,real>::coarse_solve (
+    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+    const dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side) const
+{
+    const Epetra_CrsMatrix &matrix = level_matrix(levels.size()-1).trilinos_matrix();
+    Epetra_Vector x(View, matrix.DomainMap(), solution.begin());
+    Epetra_Vector b(View, matrix.RangeMap(), const_cast<double *>(right_hand_side.begin()));
+    coarse_problem->SetLHS(&x);
+    coarse_problem->SetRHS(&b);
+    const int ierr = coarse_solver->Solve();
+    Assert(ierr == 0, dealii::ExcMessage("The solve of the coarsest level failed."));
+    (void) ierr;
+}
+
+template <int dim, typename real>
+void PMultigridPreconditioner<dim,real>::cycle (
+    const unsigned int ilevel,
+    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+    const dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side) const
+{
+    if (ilevel+1 == levels.size()) {
+        coarse_solve (solution, right_hand_side);
+        return;
+    }
+
+    const Level &level = levels[ilevel];
+    const Level &coarse = levels[ilevel+1];
+
+    smooth (ilevel, solution, right_hand_side);
+
+    // Restricts the residual.
+    level_matrix(ilevel).vmult(level.residual, solution);
+    level.residual.sadd(-1.0, 1.0, right_hand_side);
+    level.prolongation.Tvmult(coarse.right_hand_side, level.residual);
+
+    // The coarsest level is exact and is only solved once.
+    const bool w_cycle = param.p_multigrid_cycle == Parameters::LinearSolverParam::MultigridCycleEnum::w_cycle;
+    const unsigned int n_coarse_cycles = (w_cycle && ilevel+2 < levels.size()) ? 2 : 1;
+    coarse.solution = 0.0;
+    for (unsigned int icycle = 0; icycle < n_coarse_cycles; ++icycle) {
+        cycle (ilevel+1, coarse.solution, coarse.right_hand_side);
+    }
+
+    // Prolongates the coarse correction.
+    level.prolongation.vmult(level.correction, coarse.solution);
+    solution += level.correction;
+
+    smooth (ilevel, solution, right_hand_side);
+}
+
+template <int dim, typename real>
+void PMultigridPreconditioner<dim,real>::vmult (
+    dealii::LinearAlgebra::distributed::Vector<double> &dst,
+    const dealii::LinearAlgebra::distributed::Vector<double> &src) const
+{
+    Assert(fine_matrix != nullptr,
+           dealii::ExcMessage("PMultigridPreconditioner::initialize() must be called before applying the preconditioner."));
+    dst = 0.0;
+    cycle (0, dst, src);
+}
+
+template <int dim, typename real>
+int PMultigridPreconditioner<dim,real>::Apply (const Epetra_MultiVector &/*X*/, Epetra_MultiVector &/*Y*/) const
+{
+    return -1;
+}
+
+template <int dim, typename real>
+int PMultigridPreconditioner<dim,real>::ApplyInverse (const Epetra_MultiVector &X, Epetra_MultiVector &Y) const
+{
+    // X and Y may be the same vectors.
+    dealii::LinearAlgebra::distributed::Vector<double> src, dst;
+    src.reinit(levels[0].locally_owned_dofs, MPI_COMM_WORLD);
+    dst.reinit(src);
+    for (int ivector = 0; ivector < X.NumVectors(); ++ivector) {
+        std::copy(X[ivector], X[ivector] + X.MyLength(), src.begin());
+        vmult(dst, src);
+        std::copy(dst.begin(), dst.end(), Y[ivector]);
+    }
+    return 0;
+}
+
+template <int dim, typename real>
+int PMultigridPreconditioner<dim,real>::SetUseTranspose (bool use_transpose)
+{
+    return use_transpose ? -1 : 0;
+}
+
+template <int dim, typename real>
+double PMultigridPreconditioner<dim,real>::NormInf () const
+{
+    return 0.0;
+}
+
+template <int dim, typename real>
+const char * PMultigridPreconditioner<dim,real>::Label () const
+{
+    return "PMultigridPreconditioner";
+}
+
+template <int dim, typename real>
+bool PMultigridPreconditioner<dim,real>::UseTranspose () const
+{
+    return false;
+}
+
+template <int dim, typename real>
+bool PMultigridPreconditioner<dim,real>::HasNormInf () const
+{
+    return false;
+}
+
+template <int dim, typename real>
+const Epetra_Comm & PMultigridPreconditioner<dim,real>::Comm () const
+{
+    return fine_matrix->trilinos_matrix().Comm();
+}
+
+template <int dim, typename real>
+const Epetra_Map & PMultigridPreconditioner<dim,real>::OperatorDomainMap () const
+{
+    return fine_matrix->trilinos_matrix().DomainMap();
+}
+
+template <int dim, typename real>
+const Epetra_Map & PMultigridPreconditioner<dim,real>::OperatorRangeMap () const
+{
+    return fine_matrix->trilinos_matrix().RangeMap();
+}
+
+template class PMultigridPreconditioner <PHILIP_DIM, double>;
+
+} // PHiLiP namespace
@@ -0,0 +1,160 @@
+#ifndef __P_MULTIGRID_PRECONDITIONER_H__
+#define __P_MULTIGRID_PRECONDITIONER_H__
+
+#include <memory>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
+
+#include <Amesos_BaseSolver.h>
+#include <Epetra_LinearProblem.h>
+#include <Epetra_Operator.h>
+#include <Ifpack_Preconditioner.h>
+
+#include "dg.h"
+#include "linear_solver/linear_solver.h"
+
+namespace PHiLiP {
+
+/// Multigrid preconditioner over the polynomial degrees of a DG discretization.
+/** The levels are the degrees \f$p, p-1, \dots, p_{coarse}\f$ of the DGBase fe_collection, on the same grid.
+ *  The prolongation \f$\mathbf{P}\f$ from a degree to the next one is the cell-wise \f$L_2\f$ projection
+ *  on the reference cell, as in project_function(), which is exact since the coarse space is included in
+ *  the fine one. The restriction is its transpose and the coarse operators are the Galerkin products
+ *  \f[
+ *      \mathbf{A}_{coarse} = \mathbf{P}^T \mathbf{A}_{fine} \mathbf{P},
+ *  \f]
+ *  such that they are formed from the fine matrix alone, without re-assembling the residual at each degree.
+ *
+ *  Each level is smoothed by damped block-Jacobi or block Gauss-Seidel iterations on the cell blocks,
+ *  see build_block_preconditioner(), and the coarsest level is solved with a direct solver.
+ *
+ *  Derives from ExternalPreconditioner such that the LinearSolver forms it with initialize() and
+ *  applies it to AztecOO through ApplyInverse().
+ */
+template <int dim, typename real>
+class PMultigridPreconditioner : public ExternalPreconditioner
+{
+public:
+    /// Constructor. Distributes the degrees of freedom of each coarse level.
+    /** Must be re-constructed if the DGBase degrees of freedom change. */
+    PMultigridPreconditioner (
+        std::shared_ptr< DGBase<dim,real> > dg_input,
+        const Parameters::LinearSolverParam &param);
+
+    /// Destructor.
+    ~PMultigridPreconditioner() {};
+
+    /// Forms the coarse operators and the smoothers from \p fine_matrix.
+    /** The matrix is not copied and must outlive the preconditioner, or until initialize() is called again.
+     */
+    void initialize (const dealii::TrilinosWrappers::SparseMatrix &fine_matrix) override;
+
+    /// Applies one cycle to \p src with a zero initial guess.
+    void vmult (
+        dealii::LinearAlgebra::distributed::Vector<double> &dst,
+        const dealii::LinearAlgebra::distributed::Vector<double> &src) const;
+
+    /// Number of levels, including the fine one.
+    unsigned int n_levels () const;
+
+    /// Reference prolongation matrix from \p fe_coarse to \p fe_fine.
+    /** Cell-wise \f$L_2\f$ projection with the quadrature of the fine degree, as in project_function().
+     *  Also used by the Adjoint to transfer between the coarse and the p-enriched degrees.
+     */
+    static dealii::FullMatrix<double> reference_prolongation (
+        const dealii::FiniteElement<dim> &fe_coarse,
+        const dealii::FiniteElement<dim> &fe_fine);
+
+    /// Epetra_Operator interface.
+    /** Not available since this is a preconditioner. Returns -1. */
+    int Apply (const Epetra_MultiVector &X, Epetra_MultiVector &Y) const override;
+    /// Applies vmult() on each vector of \p X.
+    int ApplyInverse (const Epetra_MultiVector &X, Epetra_MultiVector &Y) const override;
+    /// Only the non-transposed operator is available. Returns -1 if \p use_transpose is true.
+    int SetUseTranspose (bool use_transpose) override;
+    /// Not available. Returns 0.
+    double NormInf () const override;
+    /// Name of the operator.
+    const char * Label () const override;
+    /// Always false.
+    bool UseTranspose () const override;
+    /// Always false.
+    bool HasNormInf () const override;
+    /// Communicator of the fine matrix.
+    const Epetra_Comm & Comm () const override;
+    /// Domain map of the fine matrix.
+    const Epetra_Map & OperatorDomainMap () const override;
+    /// Range map of the fine matrix.
+    const Epetra_Map & OperatorRangeMap () const override;
+
+protected:
+    /// Polynomial level.
+    struct Level
+    {
+        unsigned int degree; ///< Largest polynomial degree of the level.
+        /// Degrees of freedom of a coarse level. The fine level uses the DGBase dof_handler.
+        std::unique_ptr<dealii::DoFHandler<dim>> dof_handler;
+        dealii::IndexSet locally_owned_dofs; ///< Locally owned degrees of freedom.
+
+        /// Prolongation from the next coarser level. Empty on the coarsest level.
+        dealii::TrilinosWrappers::SparseMatrix prolongation;
+        /// Galerkin operator of a coarse level. The fine level uses the fine_matrix.
+        dealii::TrilinosWrappers::SparseMatrix coarse_matrix;
+        /// Block of each locally owned degree of freedom for the smoother, see partition_into_cell_blocks().
+        std::vector<int> cell_blocks;
+        /// Block smoother. Not used on the coarsest level.
+        std::unique_ptr<Ifpack_Preconditioner> smoother;
+
+        /// Solution and right-hand side of a coarse level.
+        mutable dealii::LinearAlgebra::distributed::Vector<double> solution, right_hand_side;
+        /// Work vectors.
+        mutable dealii::LinearAlgebra::distributed::Vector<double> residual, correction;
+    };
+
+    /// Matrix of level \p ilevel.
+    const dealii::TrilinosWrappers::SparseMatrix & level_matrix (const unsigned int ilevel) const;
+
+    /// Improves the \p solution of \p ilevel by one multigrid cycle.
+    void cycle (
+        const unsigned int ilevel,
+        dealii::LinearAlgebra::distributed::Vector<double> &solution,
+        const dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side) const;
+
+    /// Applies the smoothing steps of \p ilevel to \p solution.
+    void smooth (
+        const unsigned int ilevel,
+        dealii::LinearAlgebra::distributed::Vector<double> &solution,
+        const dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side) const;
+
+    /// Solves the coarsest level exactly.
+    void coarse_solve (
+        dealii::LinearAlgebra::distributed::Vector<double> &solution,
+        const dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side) const;
+
+    /// Assembles the prolongation of each level from the next coarser one.
+    void build_prolongations ();
+
+    /// DG discretization providing the fine level.
+    std::shared_ptr< DGBase<dim,real> > dg;
+    /// Linear solver parameters, including the p_multigrid options.
+    const Parameters::LinearSolverParam param;
+
+    /// Levels from the finest to the coarsest.
+    std::vector<Level> levels;
+
+    /// Fine matrix given to initialize().
+    const dealii::TrilinosWrappers::SparseMatrix *fine_matrix;
+
+    /// Linear problem of the coarsest level.
+    std::unique_ptr<Epetra_LinearProblem> coarse_problem;
+    /// Direct solver of the coarsest level, factorized in initialize().
+    std::unique_ptr<Amesos_BaseSolver> coarse_solver;
+};
+
+} // PHiLiP namespace
+
+#endif
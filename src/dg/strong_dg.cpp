@@ -40,9 +40,28 @@ DGStrong<dim,nstate,real>::DGStrong(
     conv_num_flux = NumericalFlux::NumericalFluxFactory<dim, nstate, FadType> ::create_convective_numerical_flux (parameters_input->conv_num_flux_type, pde_physics);
     diss_num_flux = NumericalFlux::NumericalFluxFactory<dim, nstate, FadType> ::create_dissipative_numerical_flux (parameters_input->diss_num_flux_type, pde_physics);
 
+    static_fad_p1 = std::make_unique<PhysicsAndNumericalFluxes<dim,nstate,DegreeFadType<1>>>(parameters_input);
+    static_fad_p2 = std::make_unique<PhysicsAndNumericalFluxes<dim,nstate,DegreeFadType<2>>>(parameters_input);
+    static_fad_p3 = std::make_unique<PhysicsAndNumericalFluxes<dim,nstate,DegreeFadType<3>>>(parameters_input);
+    static_fad_p4 = std::make_unique<PhysicsAndNumericalFluxes<dim,nstate,DegreeFadType<4>>>(parameters_input);
+
+    pde_physics_directional = Physics::PhysicsFactory<dim,nstate,DirectionalFadType> ::create_Physics(parameters_input);
+    conv_num_flux_directional = NumericalFlux::NumericalFluxFactory<dim, nstate, DirectionalFadType> ::create_convective_numerical_flux (parameters_input->conv_num_flux_type, pde_physics_directional);
+    diss_num_flux_directional = NumericalFlux::NumericalFluxFactory<dim, nstate, DirectionalFadType> ::create_dissipative_numerical_flux (parameters_input->diss_num_flux_type, pde_physics_directional);
+
     pde_physics_double = Physics::PhysicsFactory<dim,nstate,real> ::create_Physics(parameters_input);
     conv_num_flux_double = NumericalFlux::NumericalFluxFactory<dim, nstate, real> ::create_convective_numerical_flux (parameters_input->conv_num_flux_type, pde_physics_double);
     diss_num_flux_double = NumericalFlux::NumericalFluxFactory<dim, nstate, real> ::create_dissipative_numerical_flux (parameters_input->diss_num_flux_type, pde_physics_double);
+
+    if (parameters_input->use_sum_factorization) {
+        tensor_product_bases.resize(this->fe_collection.size());
+        for (unsigned int i_fele = 0; i_fele < this->fe_collection.size(); ++i_fele) {
+            tensor_product_bases[i_fele].reinit(this->fe_collection[i_fele], this->oned_quadrature_collection[i_fele], this->volume_quadrature_collection[i_fele]);
+            tensor_product_bases[i_fele].reinit_faces(this->oned_quadrature_collection[i_fele], this->face_quadrature_collection[i_fele]);
+        }
+        // The sum-factorized volume and face terms read their metric terms from the geometry store.
+        this->geometry_store_is_used = true;
+    }
 }
 
 template <int dim, int nstate, typename real>
@@ -51,10 +70,63 @@ DGStrong<dim,nstate,real>::~DGStrong ()
     pcout << "Destructing DGStrong..." << std::endl;
     delete conv_num_flux;
     delete diss_num_flux;
+    delete conv_num_flux_directional;
+    delete diss_num_flux_directional;
     delete conv_num_flux_double;
     delete diss_num_flux_double;
 }
 
+template <int dim, int nstate, typename real>
+std::shared_ptr<DGBase<dim,real>> DGStrong<dim,nstate,real>::create_discretization_copy (const Parameters::AllParameters *const parameters_input) const
+{
+    const Parameters::AllParameters *const copy_parameters = parameters_input ? parameters_input : this->all_parameters;
+    std::shared_ptr<DGStrong<dim,nstate,real>> dg_copy = std::make_shared<DGStrong<dim,nstate,real>>(
+        copy_parameters, this->max_degree, this->max_degree, this->high_order_grid.max_degree, this->triangulation);
+
+    dg_copy->set_physics(pde_physics_double);
+    dg_copy->set_physics(pde_physics_fad_fad);
+    // the default DegreeFadType physics are kept unless the FadType one was changed
+    if (!static_fad_p1) dg_copy->set_physics(pde_physics);
+    // set_physics() with the real physics has removed the default DirectionalFadType physics
+    if (pde_physics_directional) dg_copy->set_physics(pde_physics_directional);
+
+    return dg_copy;
+}
+
+template <int dim, int nstate, typename real>
+void DGStrong<dim,nstate,real>::assert_directional_physics () const
+{
+    AssertThrow(pde_physics_directional,
+                dealii::ExcMessage("apply_dRdW() requires the DirectionalFadType physics matching the real physics given to set_physics()."));
+}
+
+
+template <int dim, int nstate, typename adtype>
+PhysicsAndNumericalFluxes<dim,nstate,adtype>::PhysicsAndNumericalFluxes (const Parameters::AllParameters *const parameters_input)
+    : pde_physics(Physics::PhysicsFactory<dim,nstate,adtype> ::create_Physics(parameters_input))
+    , conv_num_flux(NumericalFlux::NumericalFluxFactory<dim, nstate, adtype> ::create_convective_numerical_flux (parameters_input->conv_num_flux_type, pde_physics))
+    , diss_num_flux(NumericalFlux::NumericalFluxFactory<dim, nstate, adtype> ::create_dissipative_numerical_flux (parameters_input->diss_num_flux_type, pde_physics))
+{}
+
+template <int dim, int nstate, typename real>
+template <typename Assembler>
+bool DGStrong<dim,nstate,real>::assemble_with_static_fad (const unsigned int n_total_indep, const Assembler &assemble) const
+{
+    if (!all_parameters->use_static_fad || !static_fad_p1) return false;
+    static_assert(max_static_fad_degree == 4, "Dispatch to each DegreeFadType below.");
+    if (n_total_indep <= static_fad_derivatives(1)) {
+        assemble(*static_fad_p1);
+    } else if (n_total_indep <= static_fad_derivatives(2)) {
+        assemble(*static_fad_p2);
+    } else if (n_total_indep <= static_fad_derivatives(3)) {
+        assemble(*static_fad_p3);
+    } else if (n_total_indep <= static_fad_derivatives(4)) {
+        assemble(*static_fad_p4);
+    } else {
+        return false;
+    }
+    return true;
+}
 
 template <int dim, int nstate, typename real>
 real DGStrong<dim,nstate,real>::evaluate_CFL (
@@ -75,25 +147,19 @@ real DGStrong<dim,nstate,real>::evaluate_CFL (
 
 
 template <int dim, int nstate, typename real>
-void DGStrong<dim,nstate,real>::assemble_boundary_term_derivatives(
-    const unsigned int ,//face_number,
+template <typename adtype>
+void DGStrong<dim,nstate,real>::assemble_boundary_term_derivatives_ad(
     const unsigned int boundary_id,
     const dealii::FEFaceValuesBase<dim,dim> &fe_values_boundary,
     const real penalty,
-    const dealii::FESystem<dim,dim> &,//fe,
-    const dealii::Quadrature<dim-1> &,//quadrature,
-    const std::vector<dealii::types::global_dof_index> &,//metric_dof_indices,
     const std::vector<dealii::types::global_dof_index> &soln_dof_indices,
     dealii::Vector<real> &local_rhs_int_cell,
-    const bool compute_dRdW,
-    const bool compute_dRdX,
-    const bool compute_d2R)
+    const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+    const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad)
 { 
-    assert(compute_dRdW); assert(!compute_dRdX); assert(!compute_d2R);
-    (void) compute_dRdW; (void) compute_dRdX; (void) compute_d2R;
-    using FadType = Sacado::Fad::DFad<real>;
-    using ADArray = std::array<FadType,nstate>;
-    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,FadType>, nstate >;
+    using ADArray = std::array<adtype,nstate>;
+    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,adtype>, nstate >;
  
     const unsigned int n_dofs_cell = fe_values_boundary.dofs_per_cell;
     const unsigned int n_face_quad_pts = fe_values_boundary.n_quadrature_points;
@@ -119,7 +185,7 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_derivatives(
     std::vector<ADArrayTensor1> conv_phys_flux(n_face_quad_pts);
  
     // AD variable
-    std::vector< FadType > soln_coeff_int(n_dofs_cell);
+    std::vector< adtype > soln_coeff_int(n_dofs_cell);
     const unsigned int n_total_indep = n_dofs_cell;
     for (unsigned int idof = 0; idof < n_dofs_cell; ++idof) {
         soln_coeff_int[idof] = DGBase<dim,real>::solution(soln_dof_indices[idof]);
@@ -137,8 +203,8 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_derivatives(
     const std::vector< dealii::Point<dim,real> > quad_pts = fe_values_boundary.get_quadrature_points();
     for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
  
-        const dealii::Tensor<1,dim,FadType> normal_int = normals[iquad];
-        const dealii::Tensor<1,dim,FadType> normal_ext = -normal_int;
+        const dealii::Tensor<1,dim,adtype> normal_int = normals[iquad];
+        const dealii::Tensor<1,dim,adtype> normal_ext = -normal_int;
  
         for (unsigned int idof=0; idof<n_dofs_cell; ++idof) {
             const int istate = fe_values_boundary.get_fe().system_to_component_index(idof).first;
@@ -147,9 +213,9 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_derivatives(
         }
  
         const dealii::Point<dim, real> real_quad_point = quad_pts[iquad];
-        dealii::Point<dim,FadType> ad_point;
+        dealii::Point<dim,adtype> ad_point;
         for (int d=0;d<dim;++d) { ad_point[d] = real_quad_point[d]; }
-        pde_physics->boundary_face_values (boundary_id, ad_point, normal_int, soln_int[iquad], soln_grad_int[iquad], soln_ext[iquad], soln_grad_ext[iquad]);
+        physics.boundary_face_values (boundary_id, ad_point, normal_int, soln_int[iquad], soln_grad_int[iquad], soln_ext[iquad], soln_grad_ext[iquad]);
  
         //
         // Evaluate physical convective flux, physical dissipative flux
@@ -157,20 +223,20 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_derivatives(
         //      Hartmann, R., Numerical Analysis of Higher Order Discontinuous Galerkin Finite Element Methods,
         //      Institute of Aerodynamics and Flow Technology, DLR (German Aerospace Center), 2008.
         //      Details given on page 93
-        //conv_num_flux_dot_n[iquad] = conv_num_flux->evaluate_flux(soln_ext[iquad], soln_ext[iquad], normal_int);
+        //conv_num_flux_dot_n[iquad] = conv_num_flux_ad.evaluate_flux(soln_ext[iquad], soln_ext[iquad], normal_int);
  
         // So, I wasn't able to get Euler manufactured solutions to converge when F* = F*(Ubc, Ubc)
         // Changing it back to the standdard F* = F*(Uin, Ubc)
         // This is known not be adjoint consistent as per the paper above. Page 85, second to last paragraph.
         // Losing 2p+1 OOA on functionals for all PDEs.
-        conv_num_flux_dot_n[iquad] = conv_num_flux->evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
+        conv_num_flux_dot_n[iquad] = conv_num_flux_ad.evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
  
         // Used for strong form
         // Which physical convective flux to use?
-        conv_phys_flux[iquad] = pde_physics->convective_flux (soln_int[iquad]);
+        conv_phys_flux[iquad] = physics.convective_flux (soln_int[iquad]);
  
         // Notice that the flux uses the solution given by the Dirichlet or Neumann boundary condition
-        diss_soln_num_flux[iquad] = diss_num_flux->evaluate_solution_flux(soln_ext[iquad], soln_ext[iquad], normal_int);
+        diss_soln_num_flux[iquad] = diss_num_flux_ad.evaluate_solution_flux(soln_ext[iquad], soln_ext[iquad], normal_int);
  
         ADArrayTensor1 diss_soln_jump_int;
         for (int s=0; s<nstate; s++) {
@@ -178,9 +244,9 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_derivatives(
 				diss_soln_jump_int[s][d] = (diss_soln_num_flux[iquad][s] - soln_int[iquad][s]) * normal_int[d];
 			}
         }
-        diss_flux_jump_int[iquad] = pde_physics->dissipative_flux (soln_int[iquad], diss_soln_jump_int);
+        diss_flux_jump_int[iquad] = physics.dissipative_flux (soln_int[iquad], diss_soln_jump_int);
  
-        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux->evaluate_auxiliary_flux(
+        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux_ad.evaluate_auxiliary_flux(
             0.0, 0.0,
             soln_int[iquad], soln_ext[iquad],
             soln_grad_int[iquad], soln_grad_ext[iquad],
@@ -190,14 +256,14 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_derivatives(
     // Boundary integral
     for (unsigned int itest=0; itest<n_dofs_cell; ++itest) {
  
-        FadType rhs = 0.0;
+        adtype rhs = 0.0;
  
         const unsigned int istate = fe_values_boundary.get_fe().system_to_component_index(itest).first;
  
         for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
  
             // Convection
-            const FadType flux_diff = conv_num_flux_dot_n[iquad][istate] - conv_phys_flux[iquad][istate]*normals[iquad];
+            const adtype flux_diff = conv_num_flux_dot_n[iquad][istate] - conv_phys_flux[iquad][istate]*normals[iquad];
             rhs = rhs - fe_values_boundary.shape_value_component(itest,iquad,istate) * flux_diff * JxW[iquad];
             // Diffusive
             rhs = rhs - fe_values_boundary.shape_value_component(itest,iquad,istate) * diss_auxi_num_flux_dot_n[iquad][istate] * JxW[iquad];
@@ -212,28 +278,52 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_derivatives(
                 //residual_derivatives[idof] = rhs.fastAccessDx(idof);
                 residual_derivatives[idof] = rhs.fastAccessDx(idof);
             }
-            this->system_matrix.add(soln_dof_indices[itest], soln_dof_indices, residual_derivatives);
+            this->add_to_global_matrix(this->system_matrix, soln_dof_indices[itest], soln_dof_indices, residual_derivatives);
         }
     }
 }
 template <int dim, int nstate, typename real>
-void DGStrong<dim,nstate,real>::assemble_volume_terms_derivatives(
-    const dealii::FEValues<dim,dim> &fe_values_vol,
+void DGStrong<dim,nstate,real>::assemble_boundary_term_derivatives(
+    const unsigned int ,//face_number,
+    const unsigned int boundary_id,
+    const dealii::FEFaceValuesBase<dim,dim> &fe_values_boundary,
+    const real penalty,
     const dealii::FESystem<dim,dim> &,//fe,
-    const dealii::Quadrature<dim> &,//quadrature,
+    const dealii::Quadrature<dim-1> &,//quadrature,
     const std::vector<dealii::types::global_dof_index> &,//metric_dof_indices,
-    const std::vector<dealii::types::global_dof_index> &cell_dofs_indices,
+    const std::vector<dealii::types::global_dof_index> &soln_dof_indices,
     dealii::Vector<real> &local_rhs_int_cell,
-    const dealii::FEValues<dim,dim> &fe_values_lagrange,
     const bool compute_dRdW,
     const bool compute_dRdX,
     const bool compute_d2R)
 {
     assert(compute_dRdW); assert(!compute_dRdX); assert(!compute_d2R);
     (void) compute_dRdW; (void) compute_dRdX; (void) compute_d2R;
-    using FadType = Sacado::Fad::DFad<real>;
-    using ADArray = std::array<FadType,nstate>;
-    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,FadType>, nstate >;
+    const bool used_static_fad = assemble_with_static_fad (fe_values_boundary.dofs_per_cell,
+        [&] (const auto &static_fad) {
+            using adtype = typename std::decay_t<decltype(static_fad)>::ADType;
+            assemble_boundary_term_derivatives_ad<adtype> (
+                boundary_id, fe_values_boundary, penalty, soln_dof_indices, local_rhs_int_cell,
+                *static_fad.pde_physics, *static_fad.conv_num_flux, *static_fad.diss_num_flux);
+        });
+    if (!used_static_fad) {
+        assemble_boundary_term_derivatives_ad<FadType> (
+            boundary_id, fe_values_boundary, penalty, soln_dof_indices, local_rhs_int_cell,
+            *pde_physics, *conv_num_flux, *diss_num_flux);
+    }
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGStrong<dim,nstate,real>::assemble_volume_terms_derivatives_ad(
+    const dealii::FEValues<dim,dim> &fe_values_vol,
+    const std::vector<dealii::types::global_dof_index> &cell_dofs_indices,
+    dealii::Vector<real> &local_rhs_int_cell,
+    const dealii::FEValues<dim,dim> &fe_values_lagrange,
+    const Physics::PhysicsBase<dim, nstate, adtype> &physics)
+{
+    using ADArray = std::array<adtype,nstate>;
+    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,adtype>, nstate >;
 
     const unsigned int n_quad_pts      = fe_values_vol.n_quadrature_points;
     const unsigned int n_dofs_cell     = fe_values_vol.dofs_per_cell;
@@ -254,7 +344,7 @@ void DGStrong<dim,nstate,real>::assemble_volume_terms_derivatives(
 
 
     // AD variable
-    std::vector< FadType > soln_coeff(n_dofs_cell);
+    std::vector< adtype > soln_coeff(n_dofs_cell);
     for (unsigned int idof = 0; idof < n_dofs_cell; ++idof) {
         soln_coeff[idof] = DGBase<dim,real>::solution(cell_dofs_indices[idof]);
         soln_coeff[idof].diff(idof, n_dofs_cell);
@@ -277,14 +367,14 @@ void DGStrong<dim,nstate,real>::assemble_volume_terms_derivatives(
         //if(nstate>1) std::cout << "Momentum " << soln_at_q[iquad][1] << std::endl;
         //std::cout << "Energy " << soln_at_q[iquad][nstate-1] << std::endl;
         // Evaluate physical convective flux and source term
-        conv_phys_flux_at_q[iquad] = pde_physics->convective_flux (soln_at_q[iquad]);
-        diss_phys_flux_at_q[iquad] = pde_physics->dissipative_flux (soln_at_q[iquad], soln_grad_at_q[iquad]);
+        conv_phys_flux_at_q[iquad] = physics.convective_flux (soln_at_q[iquad]);
+        diss_phys_flux_at_q[iquad] = physics.dissipative_flux (soln_at_q[iquad], soln_grad_at_q[iquad]);
 
         if(this->all_parameters->manufactured_convergence_study_param.use_manufactured_source_term) {
             const dealii::Point<dim,real> real_quad_point = fe_values_vol.quadrature_point(iquad);
-            dealii::Point<dim,FadType> ad_point;
+            dealii::Point<dim,adtype> ad_point;
             for (int d=0;d<dim;++d) { ad_point[d] = real_quad_point[d]; }
-            source_at_q[iquad] = pde_physics->source_term (ad_point, soln_at_q[iquad]);
+            source_at_q[iquad] = physics.source_term (ad_point, soln_at_q[iquad]);
         }
     }
 
@@ -294,8 +384,8 @@ void DGStrong<dim,nstate,real>::assemble_volume_terms_derivatives(
     //const dealii::FEValues<dim,dim> &fe_values_lagrange = this->fe_values_collection_volume_lagrange.get_present_fe_values();
     std::vector<ADArray> flux_divergence(n_quad_pts);
 
-    std::array<std::array<std::vector<FadType>,nstate>,dim> f;
-    std::array<std::array<std::vector<FadType>,nstate>,dim> g;
+    std::array<std::array<std::vector<adtype>,nstate>,dim> f;
+    std::array<std::array<std::vector<adtype>,nstate>,dim> g;
 
     for (int istate = 0; istate<nstate; ++istate) {
         for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
@@ -317,7 +407,7 @@ void DGStrong<dim,nstate,real>::assemble_volume_terms_derivatives(
     // is negative. Therefore, negative of negative means we add that volume term to the right-hand-side
     for (unsigned int itest=0; itest<n_dofs_cell; ++itest) {
 
-        FadType rhs = 0;
+        adtype rhs = 0;
 
 
         const unsigned int istate = fe_values_vol.get_fe().system_to_component_index(itest).first;
@@ -347,36 +437,53 @@ void DGStrong<dim,nstate,real>::assemble_volume_terms_derivatives(
                 //residual_derivatives[idof] = rhs.fastAccessDx(idof);
                 residual_derivatives[idof] = rhs.fastAccessDx(idof);
             }
-            this->system_matrix.add(cell_dofs_indices[itest], cell_dofs_indices, residual_derivatives);
+            this->add_to_global_matrix(this->system_matrix, cell_dofs_indices[itest], cell_dofs_indices, residual_derivatives);
         }
     }
 }
 template <int dim, int nstate, typename real>
-void DGStrong<dim,nstate,real>::assemble_face_term_derivatives(
-    const unsigned int ,//interior_face_number,
-    const unsigned int ,//exterior_face_number,
+void DGStrong<dim,nstate,real>::assemble_volume_terms_derivatives(
+    const dealii::FEValues<dim,dim> &fe_values_vol,
+    const dealii::FESystem<dim,dim> &,//fe,
+    const dealii::Quadrature<dim> &,//quadrature,
+    const std::vector<dealii::types::global_dof_index> &,//metric_dof_indices,
+    const std::vector<dealii::types::global_dof_index> &cell_dofs_indices,
+    dealii::Vector<real> &local_rhs_int_cell,
+    const dealii::FEValues<dim,dim> &fe_values_lagrange,
+    const bool compute_dRdW,
+    const bool compute_dRdX,
+    const bool compute_d2R)
+{
+    assert(compute_dRdW); assert(!compute_dRdX); assert(!compute_d2R);
+    (void) compute_dRdW; (void) compute_dRdX; (void) compute_d2R;
+    const bool used_static_fad = assemble_with_static_fad (fe_values_vol.dofs_per_cell,
+        [&] (const auto &static_fad) {
+            using adtype = typename std::decay_t<decltype(static_fad)>::ADType;
+            assemble_volume_terms_derivatives_ad<adtype> (
+                fe_values_vol, cell_dofs_indices, local_rhs_int_cell, fe_values_lagrange, *static_fad.pde_physics);
+        });
+    if (!used_static_fad) {
+        assemble_volume_terms_derivatives_ad<FadType> (
+            fe_values_vol, cell_dofs_indices, local_rhs_int_cell, fe_values_lagrange, *pde_physics);
+    }
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGStrong<dim,nstate,real>::assemble_face_term_derivatives_ad(
     const dealii::FEFaceValuesBase<dim,dim>     &fe_values_int,
     const dealii::FEFaceValuesBase<dim,dim>     &fe_values_ext,
     const real penalty,
-    const dealii::FESystem<dim,dim> &,//fe_int,
-    const dealii::FESystem<dim,dim> &,//fe_ext,
-    const dealii::Quadrature<dim> &,//face_quadrature_int,
-    const dealii::Quadrature<dim> &,//face_quadrature_ext,
-    const std::vector<dealii::types::global_dof_index> &,//metric_dof_indices_int,
-    const std::vector<dealii::types::global_dof_index> &,//metric_dof_indices_ext,
     const std::vector<dealii::types::global_dof_index> &soln_dof_indices_int,
     const std::vector<dealii::types::global_dof_index> &soln_dof_indices_ext,
     dealii::Vector<real>          &local_rhs_int_cell,
     dealii::Vector<real>          &local_rhs_ext_cell,
-    const bool compute_dRdW,
-    const bool compute_dRdX,
-    const bool compute_d2R)
+    const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+    const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad)
 {
-    assert(compute_dRdW); assert(!compute_dRdX); assert(!compute_d2R);
-    (void) compute_dRdW; (void) compute_dRdX; (void) compute_d2R;
-    using FadType = Sacado::Fad::DFad<real>;
-    using ADArray = std::array<FadType,nstate>;
-    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,FadType>, nstate >;
+    using ADArray = std::array<adtype,nstate>;
+    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,adtype>, nstate >;
 
     // Use quadrature points of neighbor cell
     // Might want to use the maximum n_quad_pts1 and n_quad_pts2
@@ -394,8 +501,8 @@ void DGStrong<dim,nstate,real>::assemble_face_term_derivatives(
     const std::vector<dealii::Tensor<1,dim> > &normals_int = fe_values_int.get_normal_vectors ();
 
     // AD variable
-    std::vector<FadType> soln_coeff_int_ad(n_dofs_int);
-    std::vector<FadType> soln_coeff_ext_ad(n_dofs_ext);
+    std::vector<adtype> soln_coeff_int_ad(n_dofs_int);
+    std::vector<adtype> soln_coeff_ext_ad(n_dofs_ext);
 
 
     // Jacobian blocks
@@ -440,8 +547,8 @@ void DGStrong<dim,nstate,real>::assemble_face_term_derivatives(
     }
     for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
 
-        const dealii::Tensor<1,dim,FadType> normal_int = normals_int[iquad];
-        const dealii::Tensor<1,dim,FadType> normal_ext = -normal_int;
+        const dealii::Tensor<1,dim,adtype> normal_int = normals_int[iquad];
+        const dealii::Tensor<1,dim,adtype> normal_ext = -normal_int;
 
         // Interpolate solution to face
         for (unsigned int idof=0; idof<n_dofs_int; ++idof) {
@@ -462,12 +569,12 @@ void DGStrong<dim,nstate,real>::assemble_face_term_derivatives(
         //std::cout << "Energy ext" << soln_ext[iquad][nstate-1] << std::endl;
 
         // Evaluate physical convective flux, physical dissipative flux, and source term
-        conv_num_flux_dot_n[iquad] = conv_num_flux->evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
+        conv_num_flux_dot_n[iquad] = conv_num_flux_ad.evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
 
-        conv_phys_flux_int[iquad] = pde_physics->convective_flux (soln_int[iquad]);
-        conv_phys_flux_ext[iquad] = pde_physics->convective_flux (soln_ext[iquad]);
+        conv_phys_flux_int[iquad] = physics.convective_flux (soln_int[iquad]);
+        conv_phys_flux_ext[iquad] = physics.convective_flux (soln_ext[iquad]);
 
-        diss_soln_num_flux[iquad] = diss_num_flux->evaluate_solution_flux(soln_int[iquad], soln_ext[iquad], normal_int);
+        diss_soln_num_flux[iquad] = diss_num_flux_ad.evaluate_solution_flux(soln_int[iquad], soln_ext[iquad], normal_int);
 
         ADArrayTensor1 diss_soln_jump_int, diss_soln_jump_ext;
         for (int s=0; s<nstate; s++) {
@@ -476,10 +583,10 @@ void DGStrong<dim,nstate,real>::assemble_face_term_derivatives(
 				diss_soln_jump_ext[s][d] = (diss_soln_num_flux[iquad][s] - soln_ext[iquad][s]) * normal_ext[d];
 			}
         }
-        diss_flux_jump_int[iquad] = pde_physics->dissipative_flux (soln_int[iquad], diss_soln_jump_int);
-        diss_flux_jump_ext[iquad] = pde_physics->dissipative_flux (soln_ext[iquad], diss_soln_jump_ext);
+        diss_flux_jump_int[iquad] = physics.dissipative_flux (soln_int[iquad], diss_soln_jump_int);
+        diss_flux_jump_ext[iquad] = physics.dissipative_flux (soln_ext[iquad], diss_soln_jump_ext);
 
-        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux->evaluate_auxiliary_flux(
+        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux_ad.evaluate_auxiliary_flux(
             0.0, 0.0,
             soln_int[iquad], soln_ext[iquad],
             soln_grad_int[iquad], soln_grad_ext[iquad],
@@ -488,12 +595,12 @@ void DGStrong<dim,nstate,real>::assemble_face_term_derivatives(
 
     // From test functions associated with interior cell point of view
     for (unsigned int itest_int=0; itest_int<n_dofs_int; ++itest_int) {
-        FadType rhs = 0.0;
+        adtype rhs = 0.0;
         const unsigned int istate = fe_values_int.get_fe().system_to_component_index(itest_int).first;
 
         for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
             // Convection
-            const FadType flux_diff = conv_num_flux_dot_n[iquad][istate] - conv_phys_flux_int[iquad][istate]*normals_int[iquad];
+            const adtype flux_diff = conv_num_flux_dot_n[iquad][istate] - conv_phys_flux_int[iquad][istate]*normals_int[iquad];
             rhs = rhs - fe_values_int.shape_value_component(itest_int,iquad,istate) * flux_diff * JxW_int[iquad];
             // Diffusive
             rhs = rhs - fe_values_int.shape_value_component(itest_int,iquad,istate) * diss_auxi_num_flux_dot_n[iquad][istate] * JxW_int[iquad];
@@ -508,19 +615,19 @@ void DGStrong<dim,nstate,real>::assemble_face_term_derivatives(
             for (unsigned int idof = 0; idof < n_dofs_ext; ++idof) {
                 dR1_dW2[idof] = rhs.fastAccessDx(n_dofs_int+idof);
             }
-            this->system_matrix.add(soln_dof_indices_int[itest_int], soln_dof_indices_int, dR1_dW1);
-            this->system_matrix.add(soln_dof_indices_int[itest_int], soln_dof_indices_ext, dR1_dW2);
+            this->add_to_global_matrix(this->system_matrix, soln_dof_indices_int[itest_int], soln_dof_indices_int, dR1_dW1);
+            this->add_to_global_matrix(this->system_matrix, soln_dof_indices_int[itest_int], soln_dof_indices_ext, dR1_dW2);
         }
     }
 
     // From test functions associated with neighbour cell point of view
     for (unsigned int itest_ext=0; itest_ext<n_dofs_ext; ++itest_ext) {
-        FadType rhs = 0.0;
+        adtype rhs = 0.0;
         const unsigned int istate = fe_values_int.get_fe().system_to_component_index(itest_ext).first;
 
         for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
             // Convection
-            const FadType flux_diff = (-conv_num_flux_dot_n[iquad][istate]) - conv_phys_flux_ext[iquad][istate]*(-normals_int[iquad]);
+            const adtype flux_diff = (-conv_num_flux_dot_n[iquad][istate]) - conv_phys_flux_ext[iquad][istate]*(-normals_int[iquad]);
             rhs = rhs - fe_values_ext.shape_value_component(itest_ext,iquad,istate) * flux_diff * JxW_int[iquad];
             // Diffusive
             rhs = rhs - fe_values_ext.shape_value_component(itest_ext,iquad,istate) * (-diss_auxi_num_flux_dot_n[iquad][istate]) * JxW_int[iquad];
@@ -535,22 +642,78 @@ void DGStrong<dim,nstate,real>::assemble_face_term_derivatives(
             for (unsigned int idof = 0; idof < n_dofs_ext; ++idof) {
                 dR2_dW2[idof] = rhs.fastAccessDx(n_dofs_int+idof);
             }
-            this->system_matrix.add(soln_dof_indices_ext[itest_ext], soln_dof_indices_int, dR2_dW1);
-            this->system_matrix.add(soln_dof_indices_ext[itest_ext], soln_dof_indices_ext, dR2_dW2);
+            this->add_to_global_matrix(this->system_matrix, soln_dof_indices_ext[itest_ext], soln_dof_indices_int, dR2_dW1);
+            this->add_to_global_matrix(this->system_matrix, soln_dof_indices_ext[itest_ext], soln_dof_indices_ext, dR2_dW2);
         }
     }
 }
 
 
+template <int dim, int nstate, typename real>
+void DGStrong<dim,nstate,real>::assemble_face_term_derivatives(
+    const unsigned int ,//interior_face_number,
+    const unsigned int ,//exterior_face_number,
+    const dealii::FEFaceValuesBase<dim,dim>     &fe_values_int,
+    const dealii::FEFaceValuesBase<dim,dim>     &fe_values_ext,
+    const real penalty,
+    const dealii::FESystem<dim,dim> &,//fe_int,
+    const dealii::FESystem<dim,dim> &,//fe_ext,
+    const dealii::Quadrature<dim> &,//face_quadrature_int,
+    const dealii::Quadrature<dim> &,//face_quadrature_ext,
+    const std::vector<dealii::types::global_dof_index> &,//metric_dof_indices_int,
+    const std::vector<dealii::types::global_dof_index> &,//metric_dof_indices_ext,
+    const std::vector<dealii::types::global_dof_index> &soln_dof_indices_int,
+    const std::vector<dealii::types::global_dof_index> &soln_dof_indices_ext,
+    dealii::Vector<real>          &local_rhs_int_cell,
+    dealii::Vector<real>          &local_rhs_ext_cell,
+    const bool compute_dRdW,
+    const bool compute_dRdX,
+    const bool compute_d2R)
+{
+    assert(compute_dRdW); assert(!compute_dRdX); assert(!compute_d2R);
+    (void) compute_dRdW; (void) compute_dRdX; (void) compute_d2R;
+    const bool used_static_fad = assemble_with_static_fad (fe_values_int.dofs_per_cell + fe_values_ext.dofs_per_cell,
+        [&] (const auto &static_fad) {
+            using adtype = typename std::decay_t<decltype(static_fad)>::ADType;
+            assemble_face_term_derivatives_ad<adtype> (
+                fe_values_int, fe_values_ext, penalty, soln_dof_indices_int, soln_dof_indices_ext,
+                local_rhs_int_cell, local_rhs_ext_cell,
+                *static_fad.pde_physics, *static_fad.conv_num_flux, *static_fad.diss_num_flux);
+        });
+    if (!used_static_fad) {
+        assemble_face_term_derivatives_ad<FadType> (
+            fe_values_int, fe_values_ext, penalty, soln_dof_indices_int, soln_dof_indices_ext,
+            local_rhs_int_cell, local_rhs_ext_cell,
+            *pde_physics, *conv_num_flux, *diss_num_flux);
+    }
+}
+
 template <int dim, int nstate, typename real>
 void DGStrong<dim,nstate,real>::assemble_volume_terms_explicit(
     const dealii::FEValues<dim,dim> &fe_values_vol,
     const std::vector<dealii::types::global_dof_index> &cell_dofs_indices,
     dealii::Vector<real> &local_rhs_int_cell,
     const dealii::FEValues<dim,dim> &fe_values_lagrange)
+{
+    if (this->dRdW_product_direction) {
+        assert_directional_physics ();
+        assemble_volume_terms_explicit_ad<DirectionalFadType> (fe_values_vol, cell_dofs_indices, local_rhs_int_cell, fe_values_lagrange, *pde_physics_directional);
+    } else {
+        assemble_volume_terms_explicit_ad<real> (fe_values_vol, cell_dofs_indices, local_rhs_int_cell, fe_values_lagrange, *pde_physics_double);
+    }
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGStrong<dim,nstate,real>::assemble_volume_terms_explicit_ad(
+    const dealii::FEValues<dim,dim> &fe_values_vol,
+    const std::vector<dealii::types::global_dof_index> &cell_dofs_indices,
+    dealii::Vector<real> &local_rhs_int_cell,
+    const dealii::FEValues<dim,dim> &fe_values_lagrange,
+    Physics::PhysicsBase<dim, nstate, adtype> &physics)
 {
     //std::cout << "assembling cell terms" << std::endl;
-    using realtype = real;
+    using realtype = adtype;
     using realArray = std::array<realtype,nstate>;
     using realArrayTensor1 = std::array< dealii::Tensor<1,dim,realtype>, nstate >;
 
@@ -561,9 +724,6 @@ void DGStrong<dim,nstate,real>::assemble_volume_terms_explicit(
 
     const std::vector<real> &JxW = fe_values_vol.get_JxW_values ();
 
-
-    std::vector<real> residual_derivatives(n_dofs_cell);
-
     std::vector< realArray > soln_at_q(n_quad_pts);
     std::vector< realArrayTensor1 > soln_grad_at_q(n_quad_pts); // Tensor initialize with zeros
 
@@ -573,10 +733,7 @@ void DGStrong<dim,nstate,real>::assemble_volume_terms_explicit(
 
 
     // AD variable
-    std::vector< realtype > soln_coeff(n_dofs_cell);
-    for (unsigned int idof = 0; idof < n_dofs_cell; ++idof) {
-        soln_coeff[idof] = DGBase<dim,real>::solution(cell_dofs_indices[idof]);
-    }
+    const std::vector< realtype > soln_coeff = this->template local_solution_coefficients<realtype>(cell_dofs_indices);
     for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
         for (int istate=0; istate<nstate; istate++) { 
             // Interpolate solution to the volume quadrature points
@@ -595,16 +752,22 @@ void DGStrong<dim,nstate,real>::assemble_volume_terms_explicit(
         //if(nstate>1) std::cout << "Momentum " << soln_at_q[iquad][1] << std::endl;
         //std::cout << "Energy " << soln_at_q[iquad][nstate-1] << std::endl;
         // Evaluate physical convective flux and source term
-        conv_phys_flux_at_q[iquad] = pde_physics_double->convective_flux (soln_at_q[iquad]);
-        diss_phys_flux_at_q[iquad] = pde_physics_double->dissipative_flux (soln_at_q[iquad], soln_grad_at_q[iquad]);
+        conv_phys_flux_at_q[iquad] = physics.convective_flux (soln_at_q[iquad]);
+        diss_phys_flux_at_q[iquad] = physics.dissipative_flux (soln_at_q[iquad], soln_grad_at_q[iquad]);
         if(this->all_parameters->manufactured_convergence_study_param.use_manufactured_source_term) {
-            source_at_q[iquad] = pde_physics_double->source_term (fe_values_vol.quadrature_point(iquad), soln_at_q[iquad]);
+            const dealii::Point<dim,real> point = fe_values_vol.quadrature_point(iquad);
+            dealii::Point<dim,realtype> ad_point;
+            for (int d=0;d<dim;++d) { ad_point[d] = point[d]; }
+            source_at_q[iquad] = physics.source_term (ad_point, soln_at_q[iquad]);
         }
     }
 
-    const double cell_diameter = fe_values_vol.get_cell()->diameter();
-    const unsigned int cell_index = fe_values_vol.get_cell()->active_cell_index();
-    this->max_dt_cell[cell_index] = evaluate_CFL ( soln_at_q, cell_diameter );
+    // The time step only depends on the solution, not on the direction of apply_dRdW().
+    if constexpr (std::is_same<adtype,real>::value) {
+        const double cell_diameter = fe_values_vol.get_cell()->diameter();
+        const unsigned int cell_index = fe_values_vol.get_cell()->active_cell_index();
+        this->max_dt_cell[cell_index] = evaluate_CFL ( soln_at_q, cell_diameter );
+    }
 
 
     // Evaluate flux divergence by interpolating the flux
@@ -617,7 +780,7 @@ void DGStrong<dim,nstate,real>::assemble_volume_terms_explicit(
             for ( unsigned int flux_basis = 0; flux_basis < n_quad_pts; ++flux_basis ) {
                 if (this->all_parameters->use_split_form == true)
                 {
-                    flux_divergence[iquad][istate] += 2* pde_physics_double->convective_numerical_split_flux(soln_at_q[iquad],soln_at_q[flux_basis])[istate] *  fe_values_lagrange.shape_grad(flux_basis,iquad);
+                    flux_divergence[iquad][istate] += 2* physics.convective_numerical_split_flux(soln_at_q[iquad],soln_at_q[flux_basis])[istate] *  fe_values_lagrange.shape_grad(flux_basis,iquad);
                 }
                 else
                 {
@@ -657,11 +820,529 @@ void DGStrong<dim,nstate,real>::assemble_volume_terms_explicit(
             }
         }
 
-        local_rhs_int_cell(itest) += rhs;
+        local_rhs_int_cell(itest) += this->local_residual_contribution(rhs);
+    }
+}
+
+
+template <int dim, int nstate, typename real>
+bool DGStrong<dim,nstate,real>::assemble_volume_terms_geometry_store(
+    const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell,
+    const unsigned int i_fele,
+    const std::vector<dealii::types::global_dof_index> &cell_dofs_indices,
+    dealii::Vector<real> &local_rhs_int_cell,
+    const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R)
+{
+    // The derivatives with respect to the grid go through the metric terms.
+    if (compute_dRdX || compute_d2R) return false;
+
+    const unsigned int cell_index = cell->active_cell_index();
+    if (!this->geometry_store.has_cell(cell_index)) return false;
+    if (i_fele >= tensor_product_bases.size() || !tensor_product_bases[i_fele].is_tensor_product) return false;
+    const SumFactorization::TensorProductBasis<dim> &basis = tensor_product_bases[i_fele];
+    if (this->geometry_store.n_volume_quad_pts(cell_index) != (unsigned int) SumFactorization::pow(basis.n_quad_1d, dim)
+        || cell_dofs_indices.size() != nstate * (unsigned int) SumFactorization::pow(basis.n_dofs_1d, dim)) {
+        return false;
+    }
+
+    if (this->dRdW_product_direction) {
+        assert_directional_physics ();
+        assemble_volume_terms_sum_factorization<DirectionalFadType> (cell, basis, cell_dofs_indices, local_rhs_int_cell, *pde_physics_directional);
+    } else if (compute_dRdW) {
+        const bool used_static_fad = assemble_with_static_fad (cell_dofs_indices.size(),
+            [&] (const auto &static_fad) {
+                using adtype = typename std::decay_t<decltype(static_fad)>::ADType;
+                assemble_volume_terms_sum_factorization<adtype> (cell, basis, cell_dofs_indices, local_rhs_int_cell, *static_fad.pde_physics);
+            });
+        if (!used_static_fad) {
+            assemble_volume_terms_sum_factorization<FadType> (cell, basis, cell_dofs_indices, local_rhs_int_cell, *pde_physics);
+        }
+    } else {
+        assemble_volume_terms_sum_factorization<real> (cell, basis, cell_dofs_indices, local_rhs_int_cell, *pde_physics_double);
+    }
+    return true;
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGStrong<dim,nstate,real>::assemble_volume_terms_sum_factorization(
+    const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell,
+    const SumFactorization::TensorProductBasis<dim> &basis,
+    const std::vector<dealii::types::global_dof_index> &cell_dofs_indices,
+    dealii::Vector<real> &local_rhs_int_cell,
+    const Physics::PhysicsBase<dim, nstate, adtype> &physics)
+{
+    // Only the kernels of the cheap scalar types are unrolled. The ones with a derivative per
+    // degree of freedom are dominated by their derivative arithmetic.
+    constexpr bool unroll = std::is_same<adtype,real>::value || std::is_same<adtype,DirectionalFadType>::value;
+    if constexpr (unroll) {
+        // Unrolled kernels for p=1..8 with as many quadrature points as basis functions.
+        const unsigned int n_1d = (basis.n_dofs_1d == basis.n_quad_1d) ? basis.n_dofs_1d : 0;
+        switch (n_1d) {
+            case 2: assemble_volume_terms_sum_factorization_kernel<2,2,adtype> (cell, basis, cell_dofs_indices, local_rhs_int_cell, physics); return;
+            case 3: assemble_volume_terms_sum_factorization_kernel<3,3,adtype> (cell, basis, cell_dofs_indices, local_rhs_int_cell, physics); return;
+            case 4: assemble_volume_terms_sum_factorization_kernel<4,4,adtype> (cell, basis, cell_dofs_indices, local_rhs_int_cell, physics); return;
+            case 5: assemble_volume_terms_sum_factorization_kernel<5,5,adtype> (cell, basis, cell_dofs_indices, local_rhs_int_cell, physics); return;
+            case 6: assemble_volume_terms_sum_factorization_kernel<6,6,adtype> (cell, basis, cell_dofs_indices, local_rhs_int_cell, physics); return;
+            case 7: assemble_volume_terms_sum_factorization_kernel<7,7,adtype> (cell, basis, cell_dofs_indices, local_rhs_int_cell, physics); return;
+            case 8: assemble_volume_terms_sum_factorization_kernel<8,8,adtype> (cell, basis, cell_dofs_indices, local_rhs_int_cell, physics); return;
+            case 9: assemble_volume_terms_sum_factorization_kernel<9,9,adtype> (cell, basis, cell_dofs_indices, local_rhs_int_cell, physics); return;
+            default: break;
+        }
+    }
+    assemble_volume_terms_sum_factorization_kernel<0,0,adtype> (cell, basis, cell_dofs_indices, local_rhs_int_cell, physics);
+}
+
+template <int dim, int nstate, typename real>
+template <int n_dofs_1d, int n_quad_1d, typename adtype>
+void DGStrong<dim,nstate,real>::assemble_volume_terms_sum_factorization_kernel(
+    const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell,
+    const SumFactorization::TensorProductBasis<dim> &basis,
+    const std::vector<dealii::types::global_dof_index> &cell_dofs_indices,
+    dealii::Vector<real> &local_rhs_int_cell,
+    const Physics::PhysicsBase<dim, nstate, adtype> &physics)
+{
+    using realArray = std::array<adtype,nstate>;
+    using realArrayTensor1 = std::array< dealii::Tensor<1,dim,adtype>, nstate >;
+
+    SumFactorization::TensorProductEvaluator<dim, n_dofs_1d, n_quad_1d, adtype> evaluator(basis);
+
+    const unsigned int n_quad_pts  = evaluator.n_quad;
+    const unsigned int n_dofs_cell = cell_dofs_indices.size();
+    const unsigned int n_dofs_state = evaluator.n_dofs;
+    const int n_quad_1d_runtime = evaluator.n_quad_1d;
+
+    // Stack-allocated for the small fixed sizes, heap-allocated otherwise.
+    constexpr int n_quad_stack = SumFactorization::stack_size(n_quad_1d, dim);
+    constexpr int n_dofs_stack = SumFactorization::stack_size(n_dofs_1d, dim);
+
+    // Metric terms of the cell, see GeometryStore.
+    const unsigned int cell_index = cell->active_cell_index();
+    AssertDimension (n_quad_pts, this->geometry_store.n_volume_quad_pts(cell_index));
+    const double *JxW = this->geometry_store.JxW(cell_index);
+    // inverse_jacobian[e][d][iquad] is dXi_e/dx_d
+    std::array<std::array<const double *,dim>,dim> inverse_jacobian;
+    for (int e=0; e<dim; ++e) {
+        for (int d=0; d<dim; ++d) {
+            inverse_jacobian[e][d] = this->geometry_store.inverse_jacobian(cell_index, e, d);
+        }
+    }
+
+    const bool use_source = this->all_parameters->manufactured_convergence_study_param.use_manufactured_source_term;
+
+    // Lexicographic coefficients of each state.
+    // With FadType and DegreeFadType, the derivatives are taken with respect to the FESystem degrees of freedom.
+    const std::vector<adtype> soln_coeff_fe = this->template local_solution_coefficients<adtype>(cell_dofs_indices);
+    SumFactorization::LocalArray< adtype, nstate*n_dofs_stack > soln_coeff(nstate*n_dofs_state);
+    for (unsigned int idof = 0; idof < n_dofs_cell; ++idof) {
+        adtype &coeff = soln_coeff[basis.dof_component[idof]*n_dofs_state + basis.dof_lexicographic_index[idof]];
+        coeff = soln_coeff_fe[idof];
+        if constexpr (!std::is_same<adtype,real>::value && !std::is_same<adtype,DirectionalFadType>::value) {
+            coeff.diff(idof, n_dofs_cell);
+        }
+    }
+
+    // Interpolate the solution and its reference gradient to the quadrature points
+    SumFactorization::LocalArray< adtype, n_quad_stack > soln_values(n_quad_pts);
+    SumFactorization::LocalArray< adtype, dim*n_quad_stack > soln_ref_grad(dim*n_quad_pts);
+    SumFactorization::LocalArray< realArray, n_quad_stack > soln_at_q(n_quad_pts);
+    SumFactorization::LocalArray< realArrayTensor1, n_quad_stack > soln_grad_at_q(n_quad_pts);
+    for (int istate=0; istate<nstate; ++istate) {
+        const adtype *coeff = &soln_coeff[istate*n_dofs_state];
+        evaluator.values(coeff, soln_values.data());
+        for (int e=0; e<dim; ++e) {
+            evaluator.gradient(e, coeff, &soln_ref_grad[e*n_quad_pts]);
+        }
+        for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+            soln_at_q[iquad][istate] = soln_values[iquad];
+            for (int d=0; d<dim; ++d) {
+                adtype grad = 0.0;
+                for (int e=0; e<dim; ++e) {
+                    grad += soln_ref_grad[e*n_quad_pts + iquad] * inverse_jacobian[e][d][iquad];
+                }
+                soln_grad_at_q[iquad][istate][d] = grad;
+            }
+        }
+    }
+
+    SumFactorization::LocalArray< realArrayTensor1, n_quad_stack > conv_phys_flux_at_q(n_quad_pts);
+    SumFactorization::LocalArray< realArrayTensor1, n_quad_stack > diss_phys_flux_at_q(n_quad_pts);
+    SumFactorization::LocalArray< realArray, n_quad_stack > source_at_q(n_quad_pts);
+    for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+        conv_phys_flux_at_q[iquad] = physics.convective_flux (soln_at_q[iquad]);
+        diss_phys_flux_at_q[iquad] = physics.dissipative_flux (soln_at_q[iquad], soln_grad_at_q[iquad]);
+        if(use_source) {
+            dealii::Point<dim,adtype> ad_point;
+            for (int d=0;d<dim;++d) { ad_point[d] = this->geometry_store.quadrature_point(cell_index, d)[iquad]; }
+            source_at_q[iquad] = physics.source_term (ad_point, soln_at_q[iquad]);
+        }
+    }
+
+    // The time step only depends on the solution, not on the direction of apply_dRdW().
+    if constexpr (std::is_same<adtype,real>::value) {
+        real max_convective_eigenvalue = 0.0;
+        for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+            max_convective_eigenvalue = std::max(max_convective_eigenvalue, physics.max_convective_eigenvalue (soln_at_q[iquad]));
+        }
+        this->max_dt_cell[cell_index] = cell->diameter() / max_convective_eigenvalue;
+    }
+
+    // Flux divergence through the derivatives of the Lagrange polynomials collocated on the quadrature points.
+    // Their reference derivatives along a direction only couple the points on the same line.
+    SumFactorization::LocalArray< realArray, n_quad_stack > flux_divergence(n_quad_pts);
+    for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+        for (int istate=0; istate<nstate; ++istate) {
+            flux_divergence[iquad][istate] = 0.0;
+        }
+    }
+    if (this->all_parameters->use_split_form == true) {
+        for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+            int stride = 1;
+            for (int e=0; e<dim; ++e) {
+                const int i_line = (iquad / stride) % n_quad_1d_runtime;
+                for (int j_line = 0; j_line < n_quad_1d_runtime; ++j_line) {
+                    const double derivative = basis.collocation_gradients[i_line*n_quad_1d_runtime + j_line];
+                    const unsigned int flux_basis = iquad + (j_line - i_line) * stride;
+                    const realArrayTensor1 split_flux = physics.convective_numerical_split_flux(soln_at_q[iquad],soln_at_q[flux_basis]);
+                    for (int istate=0; istate<nstate; ++istate) {
+                        adtype contravariant_flux = 0.0;
+                        for (int d=0; d<dim; ++d) {
+                            contravariant_flux += split_flux[istate][d] * inverse_jacobian[e][d][iquad];
+                        }
+                        flux_divergence[iquad][istate] += 2.0 * contravariant_flux * derivative;
+                    }
+                }
+                stride *= n_quad_1d_runtime;
+            }
+        }
+    } else {
+        SumFactorization::LocalArray< adtype, n_quad_stack > flux_values(n_quad_pts);
+        SumFactorization::LocalArray< adtype, n_quad_stack > flux_ref_derivative(n_quad_pts);
+        for (int istate=0; istate<nstate; ++istate) {
+            for (int d=0; d<dim; ++d) {
+                for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+                    flux_values[iquad] = conv_phys_flux_at_q[iquad][istate][d];
+                }
+                for (int e=0; e<dim; ++e) {
+                    evaluator.collocation_gradient(e, flux_values.data(), flux_ref_derivative.data());
+                    for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+                        flux_divergence[iquad][istate] += flux_ref_derivative[iquad] * inverse_jacobian[e][d][iquad];
+                    }
+                }
+            }
+        }
+    }
+
+    // Strong form, see assemble_volume_terms_explicit()
+    SumFactorization::LocalArray< adtype, nstate*n_dofs_stack > rhs_coeff(nstate*n_dofs_state);
+    std::fill(rhs_coeff.begin(), rhs_coeff.end(), 0.0);
+    SumFactorization::LocalArray< adtype, n_quad_stack > integrand(n_quad_pts);
+    for (int istate=0; istate<nstate; ++istate) {
+        adtype *rhs = &rhs_coeff[istate*n_dofs_state];
+
+        // Convective and source terms, tested with the basis functions
+        for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+            integrand[iquad] = -flux_divergence[iquad][istate];
+            if(use_source) integrand[iquad] += source_at_q[iquad][istate];
+            integrand[iquad] *= JxW[iquad];
+        }
+        evaluator.integrate_values(integrand.data(), rhs);
+
+        // Diffusive term, tested with the reference gradients of the basis functions
+        for (int e=0; e<dim; ++e) {
+            for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+                adtype contravariant_flux = 0.0;
+                for (int d=0; d<dim; ++d) {
+                    contravariant_flux += diss_phys_flux_at_q[iquad][istate][d] * inverse_jacobian[e][d][iquad];
+                }
+                integrand[iquad] = contravariant_flux * JxW[iquad];
+            }
+            evaluator.integrate_gradient(e, integrand.data(), rhs);
+        }
+    }
+
+    if constexpr (std::is_same<adtype,real>::value || std::is_same<adtype,DirectionalFadType>::value) {
+        for (unsigned int itest=0; itest<n_dofs_cell; ++itest) {
+            const adtype &rhs = rhs_coeff[basis.dof_component[itest]*n_dofs_state + basis.dof_lexicographic_index[itest]];
+            local_rhs_int_cell(itest) += this->local_residual_contribution(rhs);
+        }
+    } else {
+        const bool add_dRdW = this->all_parameters->ode_solver_param.ode_solver_type == Parameters::ODESolverParam::ODESolverEnum::implicit_solver;
+        std::vector<real> residual_derivatives(n_dofs_cell);
+        for (unsigned int itest=0; itest<n_dofs_cell; ++itest) {
+            const adtype &rhs = rhs_coeff[basis.dof_component[itest]*n_dofs_state + basis.dof_lexicographic_index[itest]];
+            local_rhs_int_cell(itest) += rhs.val();
+            if (!add_dRdW) continue;
+            for (unsigned int idof = 0; idof < n_dofs_cell; ++idof) {
+                residual_derivatives[idof] = rhs.fastAccessDx(idof);
+            }
+            this->add_to_global_matrix(this->system_matrix, cell_dofs_indices[itest], cell_dofs_indices, residual_derivatives);
+        }
     }
 }
 
 
+template <int dim, int nstate, typename real>
+bool DGStrong<dim,nstate,real>::assemble_face_term_geometry_store(
+    const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell_int,
+    const unsigned int iface_int,
+    const unsigned int i_fele_int,
+    const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell_ext,
+    const unsigned int iface_ext,
+    const unsigned int i_fele_ext,
+    const real penalty,
+    const std::vector<dealii::types::global_dof_index> &dof_indices_int,
+    const std::vector<dealii::types::global_dof_index> &dof_indices_ext,
+    dealii::Vector<real> &local_rhs_int_cell,
+    dealii::Vector<real> &local_rhs_ext_cell,
+    const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R)
+{
+    // The face terms couple the two cells, whose dRdW blocks are left to assemble_face_term_derivatives().
+    if (compute_dRdW || compute_dRdX || compute_d2R) return false;
+    if (i_fele_int != i_fele_ext) return false;
+    if (i_fele_int >= tensor_product_bases.size() || !tensor_product_bases[i_fele_int].has_face_operators) return false;
+    const SumFactorization::TensorProductBasis<dim> &basis = tensor_product_bases[i_fele_int];
+
+    const unsigned int cell_index_int = cell_int->active_cell_index();
+    const unsigned int cell_index_ext = cell_ext->active_cell_index();
+    if (!this->geometry_store.has_cell(cell_index_int) || !this->geometry_store.has_cell(cell_index_ext)) return false;
+
+    // The face quadrature points of both cells only coincide when both see the face in its standard orientation.
+    const auto has_standard_orientation = [](const dealii::TriaIterator<dealii::CellAccessor<dim,dim>> &cell, const unsigned int iface) {
+        return cell->face_orientation(iface) && !cell->face_flip(iface) && !cell->face_rotation(iface);
+    };
+    if (!has_standard_orientation(cell_int, iface_int) || !has_standard_orientation(cell_ext, iface_ext)) return false;
+
+    const unsigned int n_face_quad_pts = SumFactorization::pow(basis.n_quad_1d, dim-1);
+    const unsigned int n_dofs_cell = nstate * SumFactorization::pow(basis.n_dofs_1d, dim);
+    if (this->geometry_store.n_face_quad_pts(cell_index_int, iface_int) != n_face_quad_pts
+        || this->geometry_store.n_face_quad_pts(cell_index_ext, iface_ext) != n_face_quad_pts
+        || dof_indices_int.size() != n_dofs_cell || dof_indices_ext.size() != n_dofs_cell) {
+        return false;
+    }
+
+    if (this->dRdW_product_direction) {
+        assert_directional_physics ();
+        assemble_face_term_sum_factorization<DirectionalFadType> (
+            cell_index_int, iface_int, cell_index_ext, iface_ext, basis, penalty,
+            dof_indices_int, dof_indices_ext, local_rhs_int_cell, local_rhs_ext_cell,
+            *pde_physics_directional, *conv_num_flux_directional, *diss_num_flux_directional);
+    } else {
+        assemble_face_term_sum_factorization<real> (
+            cell_index_int, iface_int, cell_index_ext, iface_ext, basis, penalty,
+            dof_indices_int, dof_indices_ext, local_rhs_int_cell, local_rhs_ext_cell,
+            *pde_physics_double, *conv_num_flux_double, *diss_num_flux_double);
+    }
+    return true;
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGStrong<dim,nstate,real>::assemble_face_term_sum_factorization(
+    const unsigned int cell_index_int,
+    const unsigned int iface_int,
+    const unsigned int cell_index_ext,
+    const unsigned int iface_ext,
+    const SumFactorization::TensorProductBasis<dim> &basis,
+    const real penalty,
+    const std::vector<dealii::types::global_dof_index> &dof_indices_int,
+    const std::vector<dealii::types::global_dof_index> &dof_indices_ext,
+    dealii::Vector<real> &local_rhs_int_cell,
+    dealii::Vector<real> &local_rhs_ext_cell,
+    const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+    const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad)
+{
+    // Unrolled kernels for p=1..8 with as many quadrature points as basis functions.
+    const unsigned int n_1d = (basis.n_dofs_1d == basis.n_quad_1d) ? basis.n_dofs_1d : 0;
+    switch (n_1d) {
+        case 2: assemble_face_term_sum_factorization_kernel<2,2,adtype> (cell_index_int, iface_int, cell_index_ext, iface_ext, basis, penalty, dof_indices_int, dof_indices_ext, local_rhs_int_cell, local_rhs_ext_cell, physics, conv_num_flux_ad, diss_num_flux_ad); return;
+        case 3: assemble_face_term_sum_factorization_kernel<3,3,adtype> (cell_index_int, iface_int, cell_index_ext, iface_ext, basis, penalty, dof_indices_int, dof_indices_ext, local_rhs_int_cell, local_rhs_ext_cell, physics, conv_num_flux_ad, diss_num_flux_ad); return;
+        case 4: assemble_face_term_sum_factorization_kernel<4,4,adtype> (cell_index_int, iface_int, cell_index_ext, iface_ext, basis, penalty, dof_indices_int, dof_indices_ext, local_rhs_int_cell, local_rhs_ext_cell, physics, conv_num_flux_ad, diss_num_flux_ad); return;
+        case 5: assemble_face_term_sum_factorization_kernel<5,5,adtype> (cell_index_int, iface_int, cell_index_ext, iface_ext, basis, penalty, dof_indices_int, dof_indices_ext, local_rhs_int_cell, local_rhs_ext_cell, physics, conv_num_flux_ad, diss_num_flux_ad); return;
+        case 6: assemble_face_term_sum_factorization_kernel<6,6,adtype> (cell_index_int, iface_int, cell_index_ext, iface_ext, basis, penalty, dof_indices_int, dof_indices_ext, local_rhs_int_cell, local_rhs_ext_cell, physics, conv_num_flux_ad, diss_num_flux_ad); return;
+        case 7: assemble_face_term_sum_factorization_kernel<7,7,adtype> (cell_index_int, iface_int, cell_index_ext, iface_ext, basis, penalty, dof_indices_int, dof_indices_ext, local_rhs_int_cell, local_rhs_ext_cell, physics, conv_num_flux_ad, diss_num_flux_ad); return;
+        case 8: assemble_face_term_sum_factorization_kernel<8,8,adtype> (cell_index_int, iface_int, cell_index_ext, iface_ext, basis, penalty, dof_indices_int, dof_indices_ext, local_rhs_int_cell, local_rhs_ext_cell, physics, conv_num_flux_ad, diss_num_flux_ad); return;
+        case 9: assemble_face_term_sum_factorization_kernel<9,9,adtype> (cell_index_int, iface_int, cell_index_ext, iface_ext, basis, penalty, dof_indices_int, dof_indices_ext, local_rhs_int_cell, local_rhs_ext_cell, physics, conv_num_flux_ad, diss_num_flux_ad); return;
+        default: break;
+    }
+    assemble_face_term_sum_factorization_kernel<0,0,adtype> (cell_index_int, iface_int, cell_index_ext, iface_ext, basis, penalty, dof_indices_int, dof_indices_ext, local_rhs_int_cell, local_rhs_ext_cell, physics, conv_num_flux_ad, diss_num_flux_ad);
+}
+
+template <int dim, int nstate, typename real>
+template <int n_dofs_1d, int n_quad_1d, typename adtype>
+void DGStrong<dim,nstate,real>::assemble_face_term_sum_factorization_kernel(
+    const unsigned int cell_index_int,
+    const unsigned int iface_int,
+    const unsigned int cell_index_ext,
+    const unsigned int iface_ext,
+    const SumFactorization::TensorProductBasis<dim> &basis,
+    const real penalty,
+    const std::vector<dealii::types::global_dof_index> &dof_indices_int,
+    const std::vector<dealii::types::global_dof_index> &dof_indices_ext,
+    dealii::Vector<real> &local_rhs_int_cell,
+    dealii::Vector<real> &local_rhs_ext_cell,
+    const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+    const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad)
+{
+    using ADArray = std::array<adtype,nstate>;
+    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,adtype>, nstate >;
+    using InverseJacobian = std::array<std::array<const double *,dim>,dim>;
+
+    SumFactorization::TensorProductEvaluator<dim, n_dofs_1d, n_quad_1d, adtype> evaluator(basis);
+
+    const unsigned int n_face_quad_pts = SumFactorization::pow(evaluator.n_quad_1d, dim-1);
+    const unsigned int n_dofs_cell = dof_indices_int.size();
+    const unsigned int n_dofs_state = evaluator.n_dofs;
+
+    // Stack-allocated for the small fixed sizes, heap-allocated otherwise.
+    constexpr int n_face_stack = SumFactorization::stack_size(n_quad_1d, dim-1);
+    constexpr int n_dofs_stack = SumFactorization::stack_size(n_dofs_1d, dim);
+
+    // Metric terms of both cells, see GeometryStore. The JxW and normal are the ones of the interior cell.
+    AssertDimension (n_face_quad_pts, this->geometry_store.n_face_quad_pts(cell_index_int, iface_int));
+    AssertDimension (n_face_quad_pts, this->geometry_store.n_face_quad_pts(cell_index_ext, iface_ext));
+    const double *JxW = this->geometry_store.face_JxW(cell_index_int, iface_int);
+    std::array<const double *,dim> normal;
+    InverseJacobian inverse_jacobian_int, inverse_jacobian_ext;
+    for (int e=0; e<dim; ++e) {
+        normal[e] = this->geometry_store.face_normal(cell_index_int, iface_int, e);
+        for (int d=0; d<dim; ++d) {
+            inverse_jacobian_int[e][d] = this->geometry_store.face_inverse_jacobian(cell_index_int, iface_int, e, d);
+            inverse_jacobian_ext[e][d] = this->geometry_store.face_inverse_jacobian(cell_index_ext, iface_ext, e, d);
+        }
+    }
+    const std::vector<unsigned int> &face_index_int = basis.face_lexicographic_index[iface_int];
+    const std::vector<unsigned int> &face_index_ext = basis.face_lexicographic_index[iface_ext];
+
+    // Lexicographic coefficients of each state.
+    const auto lexicographic_coefficients = [&](const std::vector<dealii::types::global_dof_index> &dof_indices) {
+        const std::vector<adtype> soln_coeff_fe = this->template local_solution_coefficients<adtype>(dof_indices);
+        SumFactorization::LocalArray< adtype, nstate*n_dofs_stack > soln_coeff(nstate*n_dofs_state);
+        for (unsigned int idof = 0; idof < n_dofs_cell; ++idof) {
+            soln_coeff[basis.dof_component[idof]*n_dofs_state + basis.dof_lexicographic_index[idof]] = soln_coeff_fe[idof];
+        }
+        return soln_coeff;
+    };
+    const SumFactorization::LocalArray< adtype, nstate*n_dofs_stack > soln_coeff_int = lexicographic_coefficients(dof_indices_int);
+    const SumFactorization::LocalArray< adtype, nstate*n_dofs_stack > soln_coeff_ext = lexicographic_coefficients(dof_indices_ext);
+
+    // Interpolate the solution and its gradient to the face quadrature points, seen from one cell.
+    SumFactorization::LocalArray< adtype, n_face_stack > face_values(n_face_quad_pts);
+    SumFactorization::LocalArray< adtype, dim*n_face_stack > face_ref_grad(dim*n_face_quad_pts);
+    const auto interpolate_to_face = [&](
+        const SumFactorization::LocalArray< adtype, nstate*n_dofs_stack > &soln_coeff,
+        const unsigned int iface,
+        const std::vector<unsigned int> &face_index,
+        const InverseJacobian &inverse_jacobian,
+        SumFactorization::LocalArray< ADArray, n_face_stack > &soln,
+        SumFactorization::LocalArray< ADArrayTensor1, n_face_stack > &soln_grad)
+    {
+        for (int istate=0; istate<nstate; ++istate) {
+            const adtype *coeff = &soln_coeff[istate*n_dofs_state];
+            evaluator.face_values(iface, coeff, face_values.data());
+            for (int e=0; e<dim; ++e) {
+                evaluator.face_gradient(iface, e, coeff, &face_ref_grad[e*n_face_quad_pts]);
+            }
+            for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
+                const unsigned int iface_quad = face_index[iquad];
+                soln[iquad][istate] = face_values[iface_quad];
+                for (int d=0; d<dim; ++d) {
+                    adtype grad = 0.0;
+                    for (int e=0; e<dim; ++e) {
+                        grad += face_ref_grad[e*n_face_quad_pts + iface_quad] * inverse_jacobian[e][d][iquad];
+                    }
+                    soln_grad[iquad][istate][d] = grad;
+                }
+            }
+        }
+    };
+    SumFactorization::LocalArray< ADArray, n_face_stack > soln_int(n_face_quad_pts), soln_ext(n_face_quad_pts);
+    SumFactorization::LocalArray< ADArrayTensor1, n_face_stack > soln_grad_int(n_face_quad_pts), soln_grad_ext(n_face_quad_pts);
+    interpolate_to_face (soln_coeff_int, iface_int, face_index_int, inverse_jacobian_int, soln_int, soln_grad_int);
+    interpolate_to_face (soln_coeff_ext, iface_ext, face_index_ext, inverse_jacobian_ext, soln_ext, soln_grad_ext);
+
+    // Fluxes at the face quadrature points, see assemble_face_term_explicit()
+    SumFactorization::LocalArray< ADArray, n_face_stack > flux_diff_int(n_face_quad_pts), flux_diff_ext(n_face_quad_pts);
+    SumFactorization::LocalArray< ADArray, n_face_stack > diss_auxi_num_flux_dot_n(n_face_quad_pts); // sigma*
+    SumFactorization::LocalArray< ADArrayTensor1, n_face_stack > diss_flux_jump_int(n_face_quad_pts); // u*-u_int
+    SumFactorization::LocalArray< ADArrayTensor1, n_face_stack > diss_flux_jump_ext(n_face_quad_pts); // u*-u_ext
+    for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
+        dealii::Tensor<1,dim,adtype> normal_int;
+        for (int d=0; d<dim; ++d) normal_int[d] = normal[d][iquad];
+        const dealii::Tensor<1,dim,adtype> normal_ext = -normal_int;
+
+        const ADArray conv_num_flux_dot_n = conv_num_flux_ad.evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
+        const ADArrayTensor1 conv_phys_flux_int = physics.convective_flux (soln_int[iquad]);
+        const ADArrayTensor1 conv_phys_flux_ext = physics.convective_flux (soln_ext[iquad]);
+        for (int istate=0; istate<nstate; ++istate) {
+            flux_diff_int[iquad][istate] = conv_num_flux_dot_n[istate] - conv_phys_flux_int[istate]*normal_int;
+            flux_diff_ext[iquad][istate] = (-conv_num_flux_dot_n[istate]) - conv_phys_flux_ext[istate]*normal_ext;
+        }
+
+        const ADArray diss_soln_num_flux = diss_num_flux_ad.evaluate_solution_flux(soln_int[iquad], soln_ext[iquad], normal_int); // u*
+        ADArrayTensor1 diss_soln_jump_int, diss_soln_jump_ext;
+        for (int s=0; s<nstate; s++) {
+            for (int d=0; d<dim; d++) {
+                diss_soln_jump_int[s][d] = (diss_soln_num_flux[s] - soln_int[iquad][s]) * normal_int[d];
+                diss_soln_jump_ext[s][d] = (diss_soln_num_flux[s] - soln_ext[iquad][s]) * normal_ext[d];
+            }
+        }
+        diss_flux_jump_int[iquad] = physics.dissipative_flux (soln_int[iquad], diss_soln_jump_int);
+        diss_flux_jump_ext[iquad] = physics.dissipative_flux (soln_ext[iquad], diss_soln_jump_ext);
+
+        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux_ad.evaluate_auxiliary_flux(
+            0.0, 0.0,
+            soln_int[iquad], soln_ext[iquad],
+            soln_grad_int[iquad], soln_grad_ext[iquad],
+            normal_int, penalty);
+    }
+
+    // Integrate against the test functions of one cell, whose face points are ordered by face_index.
+    SumFactorization::LocalArray< adtype, n_face_stack > integrand(n_face_quad_pts);
+    const auto integrate_face = [&](
+        const unsigned int iface,
+        const std::vector<unsigned int> &face_index,
+        const InverseJacobian &inverse_jacobian,
+        const SumFactorization::LocalArray< ADArray, n_face_stack > &flux_diff,
+        const double auxiliary_flux_sign,
+        const SumFactorization::LocalArray< ADArrayTensor1, n_face_stack > &diss_flux_jump,
+        dealii::Vector<real> &local_rhs_cell)
+    {
+        SumFactorization::LocalArray< adtype, nstate*n_dofs_stack > rhs_coeff(nstate*n_dofs_state);
+        std::fill(rhs_coeff.begin(), rhs_coeff.end(), 0.0);
+        for (int istate=0; istate<nstate; ++istate) {
+            adtype *rhs = &rhs_coeff[istate*n_dofs_state];
+
+            // Convection and diffusive auxiliary flux, tested with the basis functions
+            for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
+                integrand[face_index[iquad]] = -(flux_diff[iquad][istate] + auxiliary_flux_sign * diss_auxi_num_flux_dot_n[iquad][istate]) * JxW[iquad];
+            }
+            evaluator.integrate_face_values(iface, integrand.data(), rhs);
+
+            // Diffusive solution flux jump, tested with the gradients of the basis functions
+            for (int e=0; e<dim; ++e) {
+                for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
+                    adtype contravariant_flux = 0.0;
+                    for (int d=0; d<dim; ++d) {
+                        contravariant_flux += diss_flux_jump[iquad][istate][d] * inverse_jacobian[e][d][iquad];
+                    }
+                    integrand[face_index[iquad]] = contravariant_flux * JxW[iquad];
+                }
+                evaluator.integrate_face_gradient(iface, e, integrand.data(), rhs);
+            }
+        }
+        for (unsigned int itest=0; itest<n_dofs_cell; ++itest) {
+            const adtype &rhs = rhs_coeff[basis.dof_component[itest]*n_dofs_state + basis.dof_lexicographic_index[itest]];
+            local_rhs_cell(itest) += this->local_residual_contribution(rhs);
+        }
+    };
+    integrate_face (iface_int, face_index_int, inverse_jacobian_int, flux_diff_int,  1.0, diss_flux_jump_int, local_rhs_int_cell);
+    integrate_face (iface_ext, face_index_ext, inverse_jacobian_ext, flux_diff_ext, -1.0, diss_flux_jump_ext, local_rhs_ext_cell);
+}
+
+
 template <int dim, int nstate, typename real>
 void DGStrong<dim,nstate,real>::assemble_boundary_term_explicit(
     const unsigned int boundary_id,
@@ -670,7 +1351,31 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_explicit(
     const std::vector<dealii::types::global_dof_index> &dof_indices_int,
     dealii::Vector<real> &local_rhs_int_cell)
 {
-    using FadType = Sacado::Fad::DFad<real>;
+    if (this->dRdW_product_direction) {
+        assert_directional_physics ();
+        assemble_boundary_term_explicit_ad<DirectionalFadType> (
+            boundary_id, fe_values_boundary, penalty, dof_indices_int, local_rhs_int_cell,
+            *pde_physics_directional, *conv_num_flux_directional, *diss_num_flux_directional);
+    } else {
+        assemble_boundary_term_explicit_ad<real> (
+            boundary_id, fe_values_boundary, penalty, dof_indices_int, local_rhs_int_cell,
+            *pde_physics_double, *conv_num_flux_double, *diss_num_flux_double);
+    }
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGStrong<dim,nstate,real>::assemble_boundary_term_explicit_ad(
+    const unsigned int boundary_id,
+    const dealii::FEFaceValuesBase<dim,dim> &fe_values_boundary,
+    const real penalty,
+    const std::vector<dealii::types::global_dof_index> &dof_indices_int,
+    dealii::Vector<real> &local_rhs_int_cell,
+    Physics::PhysicsBase<dim, nstate, adtype> &physics,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+    const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad)
+{
+    using FadType = adtype;
     using ADArray = std::array<FadType,nstate>;
     using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,FadType>, nstate >;
 
@@ -682,8 +1387,6 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_explicit(
     const std::vector<real> &JxW = fe_values_boundary.get_JxW_values ();
     const std::vector<dealii::Tensor<1,dim>> &normals = fe_values_boundary.get_normal_vectors ();
 
-    std::vector<real> residual_derivatives(n_dofs_cell);
-
     std::vector<ADArray> soln_int(n_face_quad_pts);
     std::vector<ADArray> soln_ext(n_face_quad_pts);
 
@@ -698,12 +1401,7 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_explicit(
     std::vector<ADArrayTensor1> conv_phys_flux(n_face_quad_pts);
 
     // AD variable
-    std::vector< FadType > soln_coeff_int(n_dofs_cell);
-    const unsigned int n_total_indep = n_dofs_cell;
-    for (unsigned int idof = 0; idof < n_dofs_cell; ++idof) {
-        soln_coeff_int[idof] = DGBase<dim,real>::solution(dof_indices_int[idof]);
-        soln_coeff_int[idof].diff(idof, n_total_indep);
-    }
+    const std::vector< FadType > soln_coeff_int = this->template local_solution_coefficients<FadType>(dof_indices_int);
 
     for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
         for (int istate=0; istate<nstate; istate++) { 
@@ -717,7 +1415,6 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_explicit(
     for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
 
         const dealii::Tensor<1,dim,FadType> normal_int = normals[iquad];
-        const dealii::Tensor<1,dim,FadType> normal_ext = -normal_int;
 
         for (unsigned int idof=0; idof<n_dofs_cell; ++idof) {
             const int istate = fe_values_boundary.get_fe().system_to_component_index(idof).first;
@@ -728,7 +1425,7 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_explicit(
         const dealii::Point<dim, real> real_quad_point = quad_pts[iquad];
         dealii::Point<dim,FadType> ad_point;
         for (int d=0;d<dim;++d) { ad_point[d] = real_quad_point[d]; }
-        pde_physics->boundary_face_values (boundary_id, ad_point, normal_int, soln_int[iquad], soln_grad_int[iquad], soln_ext[iquad], soln_grad_ext[iquad]);
+        physics.boundary_face_values (boundary_id, ad_point, normal_int, soln_int[iquad], soln_grad_int[iquad], soln_ext[iquad], soln_grad_ext[iquad]);
 
         //
         // Evaluate physical convective flux, physical dissipative flux
@@ -742,14 +1439,14 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_explicit(
         // Changing it back to the standdard F* = F*(Uin, Ubc)
         // This is known not be adjoint consistent as per the paper above. Page 85, second to last paragraph.
         // Losing 2p+1 OOA on functionals for all PDEs.
-        conv_num_flux_dot_n[iquad] = conv_num_flux->evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
+        conv_num_flux_dot_n[iquad] = conv_num_flux_ad.evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
 
         // Used for strong form
         // Which physical convective flux to use?
-        conv_phys_flux[iquad] = pde_physics->convective_flux (soln_int[iquad]);
+        conv_phys_flux[iquad] = physics.convective_flux (soln_int[iquad]);
 
         // Notice that the flux uses the solution given by the Dirichlet or Neumann boundary condition
-        diss_soln_num_flux[iquad] = diss_num_flux->evaluate_solution_flux(soln_ext[iquad], soln_ext[iquad], normal_int);
+        diss_soln_num_flux[iquad] = diss_num_flux_ad.evaluate_solution_flux(soln_ext[iquad], soln_ext[iquad], normal_int);
 
         ADArrayTensor1 diss_soln_jump_int;
         for (int s=0; s<nstate; s++) {
@@ -757,9 +1454,9 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_explicit(
 				diss_soln_jump_int[s][d] = (diss_soln_num_flux[iquad][s] - soln_int[iquad][s]) * normal_int[d];
 			}
         }
-        diss_flux_jump_int[iquad] = pde_physics->dissipative_flux (soln_int[iquad], diss_soln_jump_int);
+        diss_flux_jump_int[iquad] = physics.dissipative_flux (soln_int[iquad], diss_soln_jump_int);
 
-        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux->evaluate_auxiliary_flux(
+        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux_ad.evaluate_auxiliary_flux(
             0.0, 0.0,
             soln_int[iquad], soln_ext[iquad],
             soln_grad_int[iquad], soln_grad_ext[iquad],
@@ -784,15 +1481,7 @@ void DGStrong<dim,nstate,real>::assemble_boundary_term_explicit(
         }
         // *******************
 
-        local_rhs_int_cell(itest) += rhs.val();
-
-        if (this->all_parameters->ode_solver_param.ode_solver_type == Parameters::ODESolverParam::ODESolverEnum::implicit_solver) {
-            for (unsigned int idof = 0; idof < n_dofs_cell; ++idof) {
-                //residual_derivatives[idof] = rhs.fastAccessDx(idof);
-                residual_derivatives[idof] = rhs.fastAccessDx(idof);
-            }
-            this->system_matrix.add(dof_indices_int[itest], dof_indices_int, residual_derivatives);
-        }
+        local_rhs_int_cell(itest) += this->local_residual_contribution(rhs);
     }
 }
 
@@ -805,9 +1494,39 @@ void DGStrong<dim,nstate,real>::assemble_face_term_explicit(
     const std::vector<dealii::types::global_dof_index> &dof_indices_ext,
     dealii::Vector<real>          &local_rhs_int_cell,
     dealii::Vector<real>          &local_rhs_ext_cell)
+{
+    if (this->dRdW_product_direction) {
+        assert_directional_physics ();
+        assemble_face_term_explicit_ad<DirectionalFadType> (
+            fe_values_int, fe_values_ext, penalty,
+            dof_indices_int, dof_indices_ext,
+            local_rhs_int_cell, local_rhs_ext_cell,
+            *pde_physics_directional, *conv_num_flux_directional, *diss_num_flux_directional);
+    } else {
+        assemble_face_term_explicit_ad<real> (
+            fe_values_int, fe_values_ext, penalty,
+            dof_indices_int, dof_indices_ext,
+            local_rhs_int_cell, local_rhs_ext_cell,
+            *pde_physics_double, *conv_num_flux_double, *diss_num_flux_double);
+    }
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGStrong<dim,nstate,real>::assemble_face_term_explicit_ad(
+    const dealii::FEFaceValuesBase<dim,dim>     &fe_values_int,
+    const dealii::FEFaceValuesBase<dim,dim>     &fe_values_ext,
+    const real penalty,
+    const std::vector<dealii::types::global_dof_index> &dof_indices_int,
+    const std::vector<dealii::types::global_dof_index> &dof_indices_ext,
+    dealii::Vector<real>          &local_rhs_int_cell,
+    dealii::Vector<real>          &local_rhs_ext_cell,
+    Physics::PhysicsBase<dim, nstate, adtype> &physics,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+    const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad)
 {
     //std::cout << "assembling face terms" << std::endl;
-    using FadType = Sacado::Fad::DFad<real>;
+    using FadType = adtype;
     using ADArray = std::array<FadType,nstate>;
     using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,FadType>, nstate >;
 
@@ -827,15 +1546,8 @@ void DGStrong<dim,nstate,real>::assemble_face_term_explicit(
     const std::vector<dealii::Tensor<1,dim> > &normals_int = fe_values_int.get_normal_vectors ();
 
     // AD variable
-    std::vector<FadType> soln_coeff_int_ad(n_dofs_int);
-    std::vector<FadType> soln_coeff_ext_ad(n_dofs_ext);
-
-
-    // Jacobian blocks
-    std::vector<real> dR1_dW1(n_dofs_int);
-    std::vector<real> dR1_dW2(n_dofs_ext);
-    std::vector<real> dR2_dW1(n_dofs_int);
-    std::vector<real> dR2_dW2(n_dofs_ext);
+    const std::vector<FadType> soln_coeff_int_ad = this->template local_solution_coefficients<FadType>(dof_indices_int);
+    const std::vector<FadType> soln_coeff_ext_ad = this->template local_solution_coefficients<FadType>(dof_indices_ext);
 
     std::vector<ADArray> conv_num_flux_dot_n(n_face_quad_pts);
     std::vector<ADArrayTensor1> conv_phys_flux_int(n_face_quad_pts);
@@ -853,16 +1565,6 @@ void DGStrong<dim,nstate,real>::assemble_face_term_explicit(
 
     std::vector<ADArrayTensor1> diss_flux_jump_int(n_face_quad_pts); // u*-u_int
     std::vector<ADArrayTensor1> diss_flux_jump_ext(n_face_quad_pts); // u*-u_ext
-    // AD variable
-    const unsigned int n_total_indep = n_dofs_int + n_dofs_ext;
-    for (unsigned int idof = 0; idof < n_dofs_int; ++idof) {
-        soln_coeff_int_ad[idof] = DGBase<dim,real>::solution(dof_indices_int[idof]);
-        soln_coeff_int_ad[idof].diff(idof, n_total_indep);
-    }
-    for (unsigned int idof = 0; idof < n_dofs_ext; ++idof) {
-        soln_coeff_ext_ad[idof] = DGBase<dim,real>::solution(dof_indices_ext[idof]);
-        soln_coeff_ext_ad[idof].diff(idof+n_dofs_int, n_total_indep);
-    }
     for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
         for (int istate=0; istate<nstate; istate++) { 
             soln_int[iquad][istate]      = 0;
@@ -897,15 +1599,15 @@ void DGStrong<dim,nstate,real>::assemble_face_term_explicit(
         // Evaluate physical convective flux, physical dissipative flux, and source term
 
         //std::cout <<"evaluating numerical fluxes" <<std::endl;
-        conv_num_flux_dot_n[iquad] = conv_num_flux->evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
+        conv_num_flux_dot_n[iquad] = conv_num_flux_ad.evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
 
-        conv_phys_flux_int[iquad] = pde_physics->convective_flux (soln_int[iquad]);
-        conv_phys_flux_ext[iquad] = pde_physics->convective_flux (soln_ext[iquad]);
+        conv_phys_flux_int[iquad] = physics.convective_flux (soln_int[iquad]);
+        conv_phys_flux_ext[iquad] = physics.convective_flux (soln_ext[iquad]);
 
        // std::cout <<"done evaluating numerical fluxes" <<std::endl;
 
 
-        diss_soln_num_flux[iquad] = diss_num_flux->evaluate_solution_flux(soln_int[iquad], soln_ext[iquad], normal_int);
+        diss_soln_num_flux[iquad] = diss_num_flux_ad.evaluate_solution_flux(soln_int[iquad], soln_ext[iquad], normal_int);
 
         ADArrayTensor1 diss_soln_jump_int, diss_soln_jump_ext;
         for (int s=0; s<nstate; s++) {
@@ -914,10 +1616,10 @@ void DGStrong<dim,nstate,real>::assemble_face_term_explicit(
 				diss_soln_jump_ext[s][d] = (diss_soln_num_flux[iquad][s] - soln_ext[iquad][s]) * normal_ext[d];
 			}
         }
-        diss_flux_jump_int[iquad] = pde_physics->dissipative_flux (soln_int[iquad], diss_soln_jump_int);
-        diss_flux_jump_ext[iquad] = pde_physics->dissipative_flux (soln_ext[iquad], diss_soln_jump_ext);
+        diss_flux_jump_int[iquad] = physics.dissipative_flux (soln_int[iquad], diss_soln_jump_int);
+        diss_flux_jump_ext[iquad] = physics.dissipative_flux (soln_ext[iquad], diss_soln_jump_ext);
 
-        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux->evaluate_auxiliary_flux(
+        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux_ad.evaluate_auxiliary_flux(
             0.0, 0.0,
             soln_int[iquad], soln_ext[iquad],
             soln_grad_int[iquad], soln_grad_ext[iquad],
@@ -938,17 +1640,7 @@ void DGStrong<dim,nstate,real>::assemble_face_term_explicit(
             rhs = rhs + fe_values_int.shape_grad_component(itest_int,iquad,istate) * diss_flux_jump_int[iquad][istate] * JxW_int[iquad];
         }
 
-        local_rhs_int_cell(itest_int) += rhs.val();
-        if (this->all_parameters->ode_solver_param.ode_solver_type == Parameters::ODESolverParam::ODESolverEnum::implicit_solver) {
-            for (unsigned int idof = 0; idof < n_dofs_int; ++idof) {
-                dR1_dW1[idof] = rhs.fastAccessDx(idof);
-            }
-            for (unsigned int idof = 0; idof < n_dofs_ext; ++idof) {
-                dR1_dW2[idof] = rhs.fastAccessDx(n_dofs_int+idof);
-            }
-            this->system_matrix.add(dof_indices_int[itest_int], dof_indices_int, dR1_dW1);
-            this->system_matrix.add(dof_indices_int[itest_int], dof_indices_ext, dR1_dW2);
-        }
+        local_rhs_int_cell(itest_int) += this->local_residual_contribution(rhs);
     }
 
     // From test functions associated with neighbour cell point of view
@@ -965,17 +1657,7 @@ void DGStrong<dim,nstate,real>::assemble_face_term_explicit(
             rhs = rhs + fe_values_ext.shape_grad_component(itest_ext,iquad,istate) * diss_flux_jump_ext[iquad][istate] * JxW_int[iquad];
         }
 
-        local_rhs_ext_cell(itest_ext) += rhs.val();
-        if (this->all_parameters->ode_solver_param.ode_solver_type == Parameters::ODESolverParam::ODESolverEnum::implicit_solver) {
-            for (unsigned int idof = 0; idof < n_dofs_int; ++idof) {
-                dR2_dW1[idof] = rhs.fastAccessDx(idof);
-            }
-            for (unsigned int idof = 0; idof < n_dofs_ext; ++idof) {
-                dR2_dW2[idof] = rhs.fastAccessDx(n_dofs_int+idof);
-            }
-            this->system_matrix.add(dof_indices_ext[itest_ext], dof_indices_int, dR2_dW1);
-            this->system_matrix.add(dof_indices_ext[itest_ext], dof_indices_ext, dR2_dW2);
-        }
+        local_rhs_ext_cell(itest_ext) += this->local_residual_contribution(rhs);
     }
 }
 
@@ -987,6 +1669,17 @@ void DGStrong<dim,nstate,real>::set_physics(
     conv_num_flux_double = NumericalFlux::NumericalFluxFactory<dim, nstate, real> ::create_convective_numerical_flux (DGBase<dim,real>::all_parameters->conv_num_flux_type, pde_physics_double);
     diss_num_flux_double = NumericalFlux::NumericalFluxFactory<dim, nstate, real> ::create_dissipative_numerical_flux (DGBase<dim,real>::all_parameters->diss_num_flux_type, pde_physics_double);
 
+    // The default DirectionalFadType physics does not match the new one.
+    pde_physics_directional = nullptr;
+}
+
+template <int dim, int nstate, typename real>
+void DGStrong<dim,nstate,real>::set_physics(
+    std::shared_ptr< Physics::PhysicsBase<dim, nstate, DirectionalFadType > >pde_physics_input)
+{
+    pde_physics_directional = pde_physics_input;
+    conv_num_flux_directional = NumericalFlux::NumericalFluxFactory<dim, nstate, DirectionalFadType> ::create_convective_numerical_flux (DGBase<dim,real>::all_parameters->conv_num_flux_type, pde_physics_directional);
+    diss_num_flux_directional = NumericalFlux::NumericalFluxFactory<dim, nstate, DirectionalFadType> ::create_dissipative_numerical_flux (DGBase<dim,real>::all_parameters->diss_num_flux_type, pde_physics_directional);
 }
 
 template <int dim, int nstate, typename real>
@@ -996,6 +1689,12 @@ void DGStrong<dim,nstate,real>::set_physics(
     pde_physics = pde_physics_input;
     conv_num_flux = NumericalFlux::NumericalFluxFactory<dim, nstate, Sacado::Fad::DFad<real>> ::create_convective_numerical_flux (DGBase<dim,real>::all_parameters->conv_num_flux_type, pde_physics);
     diss_num_flux = NumericalFlux::NumericalFluxFactory<dim, nstate, Sacado::Fad::DFad<real>> ::create_dissipative_numerical_flux (DGBase<dim,real>::all_parameters->diss_num_flux_type, pde_physics);
+
+    // The default DegreeFadType physics do not match the new one. Assemble dRdW with FadType.
+    static_fad_p1.reset();
+    static_fad_p2.reset();
+    static_fad_p3.reset();
+    static_fad_p4.reset();
 }
 
 template <int dim, int nstate, typename real>
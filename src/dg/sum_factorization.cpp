@@ -0,0 +1,146 @@
+#include <cmath>
+
+#include <deal.II/base/qprojector.h>
+
+#include <deal.II/fe/fe_dgq.h>
+
+#include "sum_factorization.h"
+
+namespace PHiLiP {
+namespace SumFactorization {
+
+template <int dim>
+bool TensorProductBasis<dim>::reinit (
+    const dealii::FiniteElement<dim,dim> &fe,
+    const dealii::Quadrature<1>      &oned_quadrature,
+    const dealii::Quadrature<dim>    &volume_quadrature)
+{
+    is_tensor_product = false;
+
+    if (fe.n_base_elements() != 1) return false;
+    const dealii::FE_DGQ<dim> *fe_dgq = dynamic_cast<const dealii::FE_DGQ<dim>*>(&fe.base_element(0));
+    if (fe_dgq == nullptr) return false;
+
+    n_dofs_1d = fe_dgq->degree + 1;
+    n_quad_1d = oned_quadrature.size();
+    if (fe_dgq->n_dofs_per_cell() != static_cast<unsigned int>(pow(n_dofs_1d, dim))) return false;
+    if (volume_quadrature.size() != static_cast<unsigned int>(pow(n_quad_1d, dim))) return false;
+
+    // The volume quadrature must be the lexicographic tensor product of the 1D quadrature.
+    const double tolerance = 1e-13;
+    for (unsigned int iquad = 0; iquad < volume_quadrature.size(); ++iquad) {
+        double weight = 1.0;
+        unsigned int index = iquad;
+        for (int d = 0; d < dim; ++d) {
+            const unsigned int i1d = index % n_quad_1d;
+            index /= n_quad_1d;
+            weight *= oned_quadrature.weight(i1d);
+            if (std::abs(volume_quadrature.point(iquad)[d] - oned_quadrature.point(i1d)[0]) > tolerance) return false;
+        }
+        if (std::abs(volume_quadrature.weight(iquad) - weight) > tolerance) return false;
+    }
+
+    // FE_DGQ numbers its lexicographic basis functions with x running fastest.
+    // The first n_dofs_1d support points therefore give the 1D nodes.
+    const std::vector<dealii::Point<dim>> &support_points = fe_dgq->get_unit_support_points();
+    std::vector<dealii::Point<1>> support_points_1d(n_dofs_1d);
+    for (unsigned int i = 0; i < n_dofs_1d; ++i) {
+        support_points_1d[i][0] = support_points[i][0];
+    }
+    const dealii::FE_DGQArbitraryNodes<1> fe_1d(dealii::Quadrature<1>(support_points_1d));
+
+    shape_values.resize(n_quad_1d*n_dofs_1d);
+    shape_values_transpose.resize(n_dofs_1d*n_quad_1d);
+    shape_gradients.resize(n_quad_1d*n_dofs_1d);
+    shape_gradients_transpose.resize(n_dofs_1d*n_quad_1d);
+    for (unsigned int iquad = 0; iquad < n_quad_1d; ++iquad) {
+        for (unsigned int idof = 0; idof < n_dofs_1d; ++idof) {
+            const double value = fe_1d.shape_value(idof, oned_quadrature.point(iquad));
+            const double gradient = fe_1d.shape_grad(idof, oned_quadrature.point(iquad))[0];
+            shape_values[iquad*n_dofs_1d + idof] = value;
+            shape_values_transpose[idof*n_quad_1d + iquad] = value;
+            shape_gradients[iquad*n_dofs_1d + idof] = gradient;
+            shape_gradients_transpose[idof*n_quad_1d + iquad] = gradient;
+        }
+    }
+
+    // Values and derivatives at the faces of the reference interval, used by the face kernels.
+    face_shape_values.resize(2*n_dofs_1d);
+    face_shape_gradients.resize(2*n_dofs_1d);
+    for (unsigned int side = 0; side < 2; ++side) {
+        const dealii::Point<1> end_point(static_cast<double>(side));
+        for (unsigned int idof = 0; idof < n_dofs_1d; ++idof) {
+            face_shape_values[side*n_dofs_1d + idof] = fe_1d.shape_value(idof, end_point);
+            face_shape_gradients[side*n_dofs_1d + idof] = fe_1d.shape_grad(idof, end_point)[0];
+        }
+    }
+    has_face_operators = false;
+
+    // Same Lagrange polynomials as the fe_collection_lagrange used for the flux interpolation.
+    const dealii::FE_DGQArbitraryNodes<1> lagrange_1d(oned_quadrature);
+    collocation_gradients.resize(n_quad_1d*n_quad_1d);
+    for (unsigned int iquad = 0; iquad < n_quad_1d; ++iquad) {
+        for (unsigned int jquad = 0; jquad < n_quad_1d; ++jquad) {
+            collocation_gradients[iquad*n_quad_1d + jquad] = lagrange_1d.shape_grad(jquad, oned_quadrature.point(iquad))[0];
+        }
+    }
+
+    dof_component.resize(fe.dofs_per_cell);
+    dof_lexicographic_index.resize(fe.dofs_per_cell);
+    for (unsigned int idof = 0; idof < fe.dofs_per_cell; ++idof) {
+        const std::pair<unsigned int, unsigned int> component_index = fe.system_to_component_index(idof);
+        dof_component[idof] = component_index.first;
+        dof_lexicographic_index[idof] = component_index.second;
+    }
+
+    is_tensor_product = true;
+    return true;
+}
+
+template <int dim>
+bool TensorProductBasis<dim>::reinit_faces (
+    const dealii::Quadrature<1>      &oned_quadrature,
+    const dealii::Quadrature<dim-1>  &face_quadrature)
+{
+    has_face_operators = false;
+    if (!is_tensor_product) return false;
+
+    const unsigned int n_face_quad_pts = pow(n_quad_1d, dim-1);
+    if (face_quadrature.size() != n_face_quad_pts) return false;
+
+    // Each face point must lie on the tensor product of the 1D points, once.
+    const double tolerance = 1e-13;
+    for (unsigned int iface = 0; iface < dealii::GeometryInfo<dim>::faces_per_cell; ++iface) {
+        const dealii::Quadrature<dim> face_quadrature_on_cell
+            = dealii::QProjector<dim>::project_to_face(dealii::ReferenceCell::get_hypercube(dim), face_quadrature, iface);
+        const int normal_direction = iface / 2;
+
+        std::vector<unsigned int> &lexicographic_index = face_lexicographic_index[iface];
+        lexicographic_index.resize(n_face_quad_pts);
+        std::vector<bool> is_used(n_face_quad_pts, false);
+        for (unsigned int iquad = 0; iquad < n_face_quad_pts; ++iquad) {
+            const dealii::Point<dim> &point = face_quadrature_on_cell.point(iquad);
+            unsigned int index = 0;
+            unsigned int stride = 1;
+            for (int d = 0; d < dim; ++d) {
+                if (d == normal_direction) continue;
+                unsigned int i1d = 0;
+                while (i1d < n_quad_1d && std::abs(point[d] - oned_quadrature.point(i1d)[0]) > tolerance) ++i1d;
+                if (i1d == n_quad_1d) return false;
+                index += i1d * stride;
+                stride *= n_quad_1d;
+            }
+            if (is_used[index]) return false;
+            is_used[index] = true;
+            lexicographic_index[iquad] = index;
+        }
+    }
+
+    has_face_operators = true;
+    return true;
+}
+
+template class TensorProductBasis <PHILIP_DIM>;
+
+} // SumFactorization namespace
+} // PHiLiP namespace
@@ -0,0 +1,389 @@
+#ifndef __SUM_FACTORIZATION_H__
+#define __SUM_FACTORIZATION_H__
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <deal.II/base/quadrature.h>
+#include <deal.II/fe/fe.h>
+
+namespace PHiLiP {
+namespace SumFactorization {
+
+/// Compile-time integer power. Returns 0 if \p base is 0, i.e. a runtime size.
+constexpr int pow (const int base, const int exponent)
+{
+    return (exponent == 0) ? 1 : base * pow(base, exponent-1);
+}
+
+/// Largest number of points per direction for which cell-local arrays are stack-allocated.
+/** Larger cells would use too much of the threads' stack in 3D. */
+constexpr int max_stack_points_1d = 5;
+
+/// Compile-time size of a cell-local array with \p n_1d points per direction.
+/** Returns 0, i.e. a heap-allocated array, if \p n_1d is a runtime size or is larger than max_stack_points_1d. */
+constexpr int stack_size (const int n_1d, const int dim)
+{
+    return (n_1d > 0 && n_1d <= max_stack_points_1d) ? pow(n_1d, dim) : 0;
+}
+
+/// Cell-local array of compile-time \p size stored on the stack.
+/** The constructor argument is only used by the heap-allocated specialization. The entries are not initialized. */
+template <typename T, int size>
+class LocalArray : public std::array<T,size>
+{
+public:
+    /// Constructor.
+    explicit LocalArray (const unsigned int /*runtime_size*/) {}
+};
+
+/// Cell-local array of runtime size stored on the heap.
+template <typename T>
+class LocalArray<T,0> : public std::vector<T>
+{
+public:
+    /// Constructor.
+    explicit LocalArray (const unsigned int runtime_size) : std::vector<T>(runtime_size) {}
+};
+
+/// One-dimensional operators of a tensor-product Lagrange basis.
+/** The basis and the quadrature are tensor products of one-dimensional ones such that
+ *  interpolation, differentiation, and integration can be applied one direction at a time.
+ *  This brings their cost from \f$ O(p^{2d}) \f$ to \f$ O(p^{d+1}) \f$.
+ *
+ *  All matrices are stored row-major with the output index as the row.
+ *  Arrays on the cell are ordered lexicographically, with the x-direction running fastest.
+ */
+template <int dim>
+class TensorProductBasis
+{
+public:
+    /// Builds the one-dimensional operators of the \p fe and \p oned_quadrature.
+    /** Returns false, and leaves is_tensor_product as false, if the element is not a system
+     *  of a single FE_DGQ base or if \p volume_quadrature is not the tensor product of \p oned_quadrature.
+     */
+    bool reinit (
+        const dealii::FiniteElement<dim,dim> &fe,
+        const dealii::Quadrature<1>      &oned_quadrature,
+        const dealii::Quadrature<dim>    &volume_quadrature);
+
+    /// Builds the ordering of the \p face_quadrature points on each face of the reference cell.
+    /** Returns false, and leaves has_face_operators as false, if the basis is not a tensor product or
+     *  if the points of \p face_quadrature are not the tensor product of the \p oned_quadrature points.
+     *  Only the points are checked, since the face kernels integrate with the weights of the face JxW.
+     */
+    bool reinit_faces (
+        const dealii::Quadrature<1>      &oned_quadrature,
+        const dealii::Quadrature<dim-1>  &face_quadrature);
+
+    /// Whether the sum-factorized kernels can be used with this basis.
+    bool is_tensor_product = false;
+    /// Whether the sum-factorized face kernels can be used with this basis.
+    bool has_face_operators = false;
+
+    unsigned int n_dofs_1d = 0; ///< Number of basis functions in one direction.
+    unsigned int n_quad_1d = 0; ///< Number of quadrature points in one direction.
+
+    /// Basis values at the quadrature points. n_quad_1d x n_dofs_1d.
+    std::vector<double> shape_values;
+    /// Transpose of shape_values used for integration. n_dofs_1d x n_quad_1d.
+    std::vector<double> shape_values_transpose;
+    /// Basis derivatives at the quadrature points. n_quad_1d x n_dofs_1d.
+    std::vector<double> shape_gradients;
+    /// Transpose of shape_gradients used for integration. n_dofs_1d x n_quad_1d.
+    std::vector<double> shape_gradients_transpose;
+    /// Derivatives of the Lagrange polynomials collocated on the quadrature points. n_quad_1d x n_quad_1d.
+    std::vector<double> collocation_gradients;
+    /// Basis values at the ends 0 and 1 of the reference interval. 2 x n_dofs_1d.
+    std::vector<double> face_shape_values;
+    /// Basis derivatives at the ends 0 and 1 of the reference interval. 2 x n_dofs_1d.
+    std::vector<double> face_shape_gradients;
+    /// Lexicographic index over the tangential directions of each face quadrature point, for each face.
+    /** The tangential directions are ordered as in the cell, such that the face kernels can
+     *  apply the same 1D operators as the volume kernels.
+     */
+    std::array<std::vector<unsigned int>, 2*dim> face_lexicographic_index;
+
+    /// Component of each FESystem degree of freedom.
+    std::vector<unsigned int> dof_component;
+    /// Lexicographic index within its component of each FESystem degree of freedom.
+    std::vector<unsigned int> dof_lexicographic_index;
+};
+
+/// Applies a 1D operator along \p direction of a lexicographic tensor-product array.
+/** The directions preceding \p direction already have \p n_to points, and the following ones
+ *  still have \p n_from points. The sizes are compile-time constants when the template
+ *  arguments are positive, which lets the compiler unroll and vectorize the loops.
+ *  Otherwise, the runtime sizes are used.
+ */
+template <int dim, int n_from_t, int n_to_t, int direction, bool add, typename Number>
+inline void apply_1d (
+    const double *matrix,
+    const Number *in,
+    Number *out,
+    const int n_from_runtime,
+    const int n_to_runtime)
+{
+    static_assert(direction < dim, "Direction must be smaller than dim.");
+    const int n_from = (n_from_t > 0) ? n_from_t : n_from_runtime;
+    const int n_to   = (n_to_t > 0)   ? n_to_t   : n_to_runtime;
+
+    int n_pre = 1;
+    for (int d = 0; d < direction; ++d) n_pre *= n_to;
+    int n_post = 1;
+    for (int d = direction+1; d < dim; ++d) n_post *= n_from;
+
+    for (int post = 0; post < n_post; ++post) {
+        for (int pre = 0; pre < n_pre; ++pre) {
+            const Number *in_line = in + post*n_from*n_pre + pre;
+            Number *out_line = out + post*n_to*n_pre + pre;
+            for (int i = 0; i < n_to; ++i) {
+                const double *row = matrix + i*n_from;
+                Number sum = row[0] * in_line[0];
+                for (int j = 1; j < n_from; ++j) {
+                    sum += row[j] * in_line[j*n_pre];
+                }
+                if (add) out_line[i*n_pre] += sum;
+                else     out_line[i*n_pre]  = sum;
+            }
+        }
+    }
+}
+
+/// Contracts a lexicographic array of \p n_1d points per direction with \p vector along \p normal_direction.
+/** The result holds the points of the remaining directions in lexicographic order, such as the
+ *  values on a face of the cell when \p vector holds the basis values at that face.
+ */
+template <int dim, int n_1d_t, typename Number>
+inline void contract_direction (
+    const double *vector,
+    const int normal_direction,
+    const Number *in,
+    Number *out,
+    const int n_1d_runtime)
+{
+    const int n_1d = (n_1d_t > 0) ? n_1d_t : n_1d_runtime;
+    int n_pre = 1;
+    for (int d = 0; d < normal_direction; ++d) n_pre *= n_1d;
+    int n_post = 1;
+    for (int d = normal_direction+1; d < dim; ++d) n_post *= n_1d;
+
+    for (int post = 0; post < n_post; ++post) {
+        for (int pre = 0; pre < n_pre; ++pre) {
+            const Number *in_line = in + post*n_1d*n_pre + pre;
+            Number sum = vector[0] * in_line[0];
+            for (int k = 1; k < n_1d; ++k) {
+                sum += vector[k] * in_line[k*n_pre];
+            }
+            out[post*n_pre + pre] = sum;
+        }
+    }
+}
+
+/// Transpose of contract_direction(), which adds the outer product of \p in with \p vector into \p out.
+template <int dim, int n_1d_t, typename Number>
+inline void expand_direction (
+    const double *vector,
+    const int normal_direction,
+    const Number *in,
+    Number *out,
+    const int n_1d_runtime)
+{
+    const int n_1d = (n_1d_t > 0) ? n_1d_t : n_1d_runtime;
+    int n_pre = 1;
+    for (int d = 0; d < normal_direction; ++d) n_pre *= n_1d;
+    int n_post = 1;
+    for (int d = normal_direction+1; d < dim; ++d) n_post *= n_1d;
+
+    for (int post = 0; post < n_post; ++post) {
+        for (int pre = 0; pre < n_pre; ++pre) {
+            const Number &in_value = in[post*n_pre + pre];
+            Number *out_line = out + post*n_1d*n_pre + pre;
+            for (int k = 0; k < n_1d; ++k) {
+                out_line[k*n_pre] += vector[k] * in_value;
+            }
+        }
+    }
+}
+
+/// Applies the tensor product of one 1D operator per direction.
+/** \p scratch must hold 2*max(n_from,n_to)^dim entries. */
+template <int dim, int n_from_t, int n_to_t, bool add, typename Number>
+inline void apply_tensor_product (
+    const std::array<const double *, dim> &matrices,
+    const Number *in,
+    Number *out,
+    Number *scratch,
+    const int n_from_runtime,
+    const int n_to_runtime)
+{
+    if constexpr (dim == 1) {
+        (void) scratch;
+        apply_1d<1, n_from_t, n_to_t, 0, add> (matrices[0], in, out, n_from_runtime, n_to_runtime);
+    } else if constexpr (dim == 2) {
+        apply_1d<2, n_from_t, n_to_t, 0, false> (matrices[0], in, scratch, n_from_runtime, n_to_runtime);
+        apply_1d<2, n_from_t, n_to_t, 1, add>   (matrices[1], scratch, out, n_from_runtime, n_to_runtime);
+    } else if constexpr (dim == 3) {
+        const int n_from = (n_from_t > 0) ? n_from_t : n_from_runtime;
+        const int n_to   = (n_to_t > 0)   ? n_to_t   : n_to_runtime;
+        const int n_max = std::max(n_from, n_to);
+        Number *scratch_2 = scratch + n_max*n_max*n_max;
+        apply_1d<3, n_from_t, n_to_t, 0, false> (matrices[0], in, scratch, n_from_runtime, n_to_runtime);
+        apply_1d<3, n_from_t, n_to_t, 1, false> (matrices[1], scratch, scratch_2, n_from_runtime, n_to_runtime);
+        apply_1d<3, n_from_t, n_to_t, 2, add>   (matrices[2], scratch_2, out, n_from_runtime, n_to_runtime);
+    }
+}
+
+/// Sum-factorized interpolation, differentiation, and integration on a tensor-product cell.
+/** Templated on the number of 1D basis functions and quadrature points such that the loops
+ *  can be unrolled. Using 0 for both selects the runtime sizes of the TensorProductBasis.
+ */
+template <int dim, int n_dofs_1d_t, int n_quad_1d_t, typename Number = double>
+class TensorProductEvaluator
+{
+public:
+    /// Constructor.
+    TensorProductEvaluator (const TensorProductBasis<dim> &basis_input)
+        : basis(basis_input)
+        , n_dofs_1d((n_dofs_1d_t > 0) ? n_dofs_1d_t : basis_input.n_dofs_1d)
+        , n_quad_1d((n_quad_1d_t > 0) ? n_quad_1d_t : basis_input.n_quad_1d)
+        , n_dofs(pow(n_dofs_1d, dim))
+        , n_quad(pow(n_quad_1d, dim))
+        , scratch(2*pow(std::max(n_dofs_1d, n_quad_1d), dim))
+        , face_scratch(pow(std::max(n_dofs_1d, n_quad_1d), dim-1))
+    {}
+
+    const TensorProductBasis<dim> &basis; ///< One-dimensional operators.
+    const int n_dofs_1d; ///< Number of basis functions in one direction.
+    const int n_quad_1d; ///< Number of quadrature points in one direction.
+    const int n_dofs; ///< Number of basis functions in the cell.
+    const int n_quad; ///< Number of quadrature points in the cell.
+
+    /// Interpolates the coefficients \p dofs to the quadrature points.
+    void values (const Number *dofs, Number *values_at_q)
+    {
+        std::array<const double *, dim> matrices;
+        for (int d = 0; d < dim; ++d) matrices[d] = basis.shape_values.data();
+        apply_tensor_product<dim, n_dofs_1d_t, n_quad_1d_t, false> (matrices, dofs, values_at_q, scratch.data(), n_dofs_1d, n_quad_1d);
+    }
+
+    /// Reference derivative along \p direction of the interpolated coefficients at the quadrature points.
+    void gradient (const int direction, const Number *dofs, Number *gradient_at_q)
+    {
+        std::array<const double *, dim> matrices;
+        for (int d = 0; d < dim; ++d) {
+            matrices[d] = (d == direction) ? basis.shape_gradients.data() : basis.shape_values.data();
+        }
+        apply_tensor_product<dim, n_dofs_1d_t, n_quad_1d_t, false> (matrices, dofs, gradient_at_q, scratch.data(), n_dofs_1d, n_quad_1d);
+    }
+
+    /// Adds the integral of \p values_at_q times each basis function into \p dofs.
+    /** The quadrature weights must already be included in \p values_at_q. */
+    void integrate_values (const Number *values_at_q, Number *dofs)
+    {
+        std::array<const double *, dim> matrices;
+        for (int d = 0; d < dim; ++d) matrices[d] = basis.shape_values_transpose.data();
+        apply_tensor_product<dim, n_quad_1d_t, n_dofs_1d_t, true> (matrices, values_at_q, dofs, scratch.data(), n_quad_1d, n_dofs_1d);
+    }
+
+    /// Adds the integral of \p values_at_q times the reference derivative along \p direction of each basis function into \p dofs.
+    /** The quadrature weights must already be included in \p values_at_q. */
+    void integrate_gradient (const int direction, const Number *values_at_q, Number *dofs)
+    {
+        std::array<const double *, dim> matrices;
+        for (int d = 0; d < dim; ++d) {
+            matrices[d] = (d == direction) ? basis.shape_gradients_transpose.data() : basis.shape_values_transpose.data();
+        }
+        apply_tensor_product<dim, n_quad_1d_t, n_dofs_1d_t, true> (matrices, values_at_q, dofs, scratch.data(), n_quad_1d, n_dofs_1d);
+    }
+
+    /// Reference derivative along \p direction of nodal values collocated on the quadrature points.
+    void collocation_gradient (const int direction, const Number *values_at_q, Number *gradient_at_q)
+    {
+        const double *matrix = basis.collocation_gradients.data();
+        if (direction == 0) {
+            apply_1d<dim, n_quad_1d_t, n_quad_1d_t, 0, false> (matrix, values_at_q, gradient_at_q, n_quad_1d, n_quad_1d);
+        } else if constexpr (dim >= 2) {
+            if (direction == 1) {
+                apply_1d<dim, n_quad_1d_t, n_quad_1d_t, 1, false> (matrix, values_at_q, gradient_at_q, n_quad_1d, n_quad_1d);
+            } else if constexpr (dim == 3) {
+                apply_1d<dim, n_quad_1d_t, n_quad_1d_t, 2, false> (matrix, values_at_q, gradient_at_q, n_quad_1d, n_quad_1d);
+            }
+        }
+    }
+
+    /// Interpolates the coefficients \p dofs to the quadrature points of face \p face_no.
+    /** The points are ordered as in TensorProductBasis::face_lexicographic_index. */
+    void face_values (const unsigned int face_no, const Number *dofs, Number *values_at_q)
+    {
+        const int normal_direction = face_no / 2;
+        contract_direction<dim, n_dofs_1d_t> (&basis.face_shape_values[(face_no % 2)*n_dofs_1d], normal_direction, dofs, face_scratch.data(), n_dofs_1d);
+        apply_face_tensor_product<false> (-1, face_scratch.data(), values_at_q);
+    }
+
+    /// Reference derivative along \p direction of the interpolated coefficients at the quadrature points of face \p face_no.
+    void face_gradient (const unsigned int face_no, const int direction, const Number *dofs, Number *gradient_at_q)
+    {
+        const int normal_direction = face_no / 2;
+        const std::vector<double> &normal_operator = (direction == normal_direction) ? basis.face_shape_gradients : basis.face_shape_values;
+        contract_direction<dim, n_dofs_1d_t> (&normal_operator[(face_no % 2)*n_dofs_1d], normal_direction, dofs, face_scratch.data(), n_dofs_1d);
+        apply_face_tensor_product<false> (tangential_direction(direction, normal_direction), face_scratch.data(), gradient_at_q);
+    }
+
+    /// Adds the integral over face \p face_no of \p values_at_q times each basis function into \p dofs.
+    /** The quadrature weights must already be included in \p values_at_q. */
+    void integrate_face_values (const unsigned int face_no, const Number *values_at_q, Number *dofs)
+    {
+        const int normal_direction = face_no / 2;
+        apply_face_tensor_product<true> (-1, values_at_q, face_scratch.data());
+        expand_direction<dim, n_dofs_1d_t> (&basis.face_shape_values[(face_no % 2)*n_dofs_1d], normal_direction, face_scratch.data(), dofs, n_dofs_1d);
+    }
+
+    /// Adds the integral over face \p face_no of \p values_at_q times the reference derivative along \p direction of each basis function into \p dofs.
+    /** The quadrature weights must already be included in \p values_at_q. */
+    void integrate_face_gradient (const unsigned int face_no, const int direction, const Number *values_at_q, Number *dofs)
+    {
+        const int normal_direction = face_no / 2;
+        const std::vector<double> &normal_operator = (direction == normal_direction) ? basis.face_shape_gradients : basis.face_shape_values;
+        apply_face_tensor_product<true> (tangential_direction(direction, normal_direction), values_at_q, face_scratch.data());
+        expand_direction<dim, n_dofs_1d_t> (&normal_operator[(face_no % 2)*n_dofs_1d], normal_direction, face_scratch.data(), dofs, n_dofs_1d);
+    }
+
+private:
+    /// Position of \p direction among the tangential directions of a face, or -1 for the \p normal_direction.
+    static int tangential_direction (const int direction, const int normal_direction)
+    {
+        if (direction == normal_direction) return -1;
+        return (direction < normal_direction) ? direction : direction-1;
+    }
+
+    /// Applies the 1D basis values, or their derivatives along \p gradient_direction, in the dim-1 tangential directions.
+    /** From the basis coefficients on the face to its quadrature points, or the transpose if \p transpose. */
+    template <bool transpose>
+    void apply_face_tensor_product (const int gradient_direction, const Number *in, Number *out)
+    {
+        if constexpr (dim == 1) {
+            (void) gradient_direction;
+            out[0] = in[0];
+        } else {
+            std::array<const double *, dim-1> matrices;
+            for (int d = 0; d < dim-1; ++d) {
+                if (transpose) matrices[d] = (d == gradient_direction) ? basis.shape_gradients_transpose.data() : basis.shape_values_transpose.data();
+                else           matrices[d] = (d == gradient_direction) ? basis.shape_gradients.data() : basis.shape_values.data();
+            }
+            if (transpose) apply_tensor_product<dim-1, n_quad_1d_t, n_dofs_1d_t, false> (matrices, in, out, scratch.data(), n_quad_1d, n_dofs_1d);
+            else           apply_tensor_product<dim-1, n_dofs_1d_t, n_quad_1d_t, false> (matrices, in, out, scratch.data(), n_dofs_1d, n_quad_1d);
+        }
+    }
+
+    /// Intermediate results of the one-dimensional sweeps.
+    LocalArray<Number, (n_dofs_1d_t > 0 && n_quad_1d_t > 0) ? 2*stack_size(std::max(n_dofs_1d_t, n_quad_1d_t), dim) : 0> scratch;
+    /// Basis coefficients restricted to a face, see contract_direction().
+    LocalArray<Number, (n_dofs_1d_t > 0 && n_quad_1d_t > 0) ? stack_size(std::max(n_dofs_1d_t, n_quad_1d_t), dim-1) : 0> face_scratch;
+};
+
+} // SumFactorization namespace
+} // PHiLiP namespace
+
+#endif
@@ -50,6 +50,14 @@ DGWeak<dim,nstate,real>::DGWeak(
     conv_num_flux = NumericalFlux::NumericalFluxFactory<dim, nstate, FadType> ::create_convective_numerical_flux (parameters_input->conv_num_flux_type, pde_physics);
     diss_num_flux = NumericalFlux::NumericalFluxFactory<dim, nstate, FadType> ::create_dissipative_numerical_flux (parameters_input->diss_num_flux_type, pde_physics);
 
+    pde_physics_static_fad = Physics::PhysicsFactory<dim,nstate,StaticFadType> ::create_Physics(parameters_input);
+    conv_num_flux_static_fad = NumericalFlux::NumericalFluxFactory<dim, nstate, StaticFadType> ::create_convective_numerical_flux (parameters_input->conv_num_flux_type, pde_physics_static_fad);
+    diss_num_flux_static_fad = NumericalFlux::NumericalFluxFactory<dim, nstate, StaticFadType> ::create_dissipative_numerical_flux (parameters_input->diss_num_flux_type, pde_physics_static_fad);
+
+    pde_physics_directional = Physics::PhysicsFactory<dim,nstate,DirectionalFadType> ::create_Physics(parameters_input);
+    conv_num_flux_directional = NumericalFlux::NumericalFluxFactory<dim, nstate, DirectionalFadType> ::create_convective_numerical_flux (parameters_input->conv_num_flux_type, pde_physics_directional);
+    diss_num_flux_directional = NumericalFlux::NumericalFluxFactory<dim, nstate, DirectionalFadType> ::create_dissipative_numerical_flux (parameters_input->diss_num_flux_type, pde_physics_directional);
+
     using FadFadType = Sacado::Fad::DFad<FadType>;
     pde_physics_fad_fad = Physics::PhysicsFactory<dim,nstate,FadFadType> ::create_Physics(parameters_input);
     conv_num_flux_fad_fad = NumericalFlux::NumericalFluxFactory<dim, nstate, FadFadType> ::create_convective_numerical_flux (parameters_input->conv_num_flux_type, pde_physics_fad_fad);
@@ -68,6 +76,12 @@ DGWeak<dim,nstate,real>::~DGWeak ()
     delete conv_num_flux;
     delete diss_num_flux;
 
+    delete conv_num_flux_static_fad;
+    delete diss_num_flux_static_fad;
+
+    delete conv_num_flux_directional;
+    delete diss_num_flux_directional;
+
     delete conv_num_flux_double;
     delete diss_num_flux_double;
 
@@ -78,6 +92,31 @@ DGWeak<dim,nstate,real>::~DGWeak ()
     delete diss_num_flux_rad_fad;
 }
 
+template <int dim, int nstate, typename real>
+std::shared_ptr<DGBase<dim,real>> DGWeak<dim,nstate,real>::create_discretization_copy (const Parameters::AllParameters *const parameters_input) const
+{
+    const Parameters::AllParameters *const copy_parameters = parameters_input ? parameters_input : this->all_parameters;
+    std::shared_ptr<DGWeak<dim,nstate,real>> dg_copy = std::make_shared<DGWeak<dim,nstate,real>>(
+        copy_parameters, this->max_degree, this->max_degree, this->high_order_grid.max_degree, this->triangulation);
+
+    dg_copy->set_physics(pde_physics_double);
+    dg_copy->set_physics(pde_physics_fad_fad);
+    dg_copy->set_physics(pde_physics_rad_fad);
+    // the default StaticFadType physics is kept unless the FadType one was changed
+    if (!pde_physics_static_fad) dg_copy->set_physics(pde_physics);
+    // set_physics() with the real physics has removed the default DirectionalFadType physics
+    if (pde_physics_directional) dg_copy->set_physics(pde_physics_directional);
+
+    return dg_copy;
+}
+
+template <int dim, int nstate, typename real>
+void DGWeak<dim,nstate,real>::assert_directional_physics () const
+{
+    AssertThrow(pde_physics_directional,
+                dealii::ExcMessage("apply_dRdW() requires the DirectionalFadType physics matching the real physics given to set_physics()."));
+}
+
 template <int dim, typename real>
 std::vector<dealii::Tensor<2,dim,real>> evaluate_metric_jacobian (
     const std::vector<dealii::Point<dim>> &points,
@@ -132,12 +171,29 @@ void DGWeak<dim,nstate,real>::assemble_volume_terms_explicit(
     dealii::Vector<real> &local_rhs_int_cell,
     const dealii::FEValues<dim,dim> &/*fe_values_lagrange*/)
 {
-    using doubleArray = std::array<real,nstate>;
-    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,real>, nstate >;
+    if (this->dRdW_product_direction) {
+        assert_directional_physics ();
+        assemble_volume_terms_explicit_ad<DirectionalFadType> (fe_values_vol, soln_dof_indices_int, local_rhs_int_cell, *pde_physics_directional);
+    } else {
+        assemble_volume_terms_explicit_ad<real> (fe_values_vol, soln_dof_indices_int, local_rhs_int_cell, *pde_physics_double);
+    }
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGWeak<dim,nstate,real>::assemble_volume_terms_explicit_ad(
+    const dealii::FEValues<dim,dim> &fe_values_vol,
+    const std::vector<dealii::types::global_dof_index> &soln_dof_indices_int,
+    dealii::Vector<real> &local_rhs_int_cell,
+    Physics::PhysicsBase<dim, nstate, adtype> &physics)
+{
+    using doubleArray = std::array<adtype,nstate>;
+    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,adtype>, nstate >;
 
     const unsigned int n_quad_pts      = fe_values_vol.n_quadrature_points;
     const unsigned int n_soln_dofs_int     = fe_values_vol.dofs_per_cell;
 
+    // The fixed-degree kernels are used on the whole cell batch, see assemble_volume_terms_explicit_cell_batch().
     AssertDimension (n_soln_dofs_int, soln_dof_indices_int.size());
 
     const std::vector<real> &JxW = fe_values_vol.get_JxW_values ();
@@ -151,15 +207,12 @@ void DGWeak<dim,nstate,real>::assemble_volume_terms_explicit(
 
 
     // AD variable
-    std::vector< real > soln_coeff(n_soln_dofs_int);
-    for (unsigned int idof = 0; idof < n_soln_dofs_int; ++idof) {
-        soln_coeff[idof] = DGBase<dim,real>::solution(soln_dof_indices_int[idof]);
-    }
+    const std::vector< adtype > soln_coeff = this->template local_solution_coefficients<adtype>(soln_dof_indices_int);
 
     const double cell_diameter = fe_values_vol.get_cell()->diameter();
-    const real artificial_diss_coeff = this->all_parameters->add_artificial_dissipation ?
-                                       this->discontinuity_sensor(cell_diameter, soln_coeff, fe_values_vol.get_fe())
-                                       : 0.0;
+    const adtype artificial_diss_coeff = this->all_parameters->add_artificial_dissipation ?
+                                         this->discontinuity_sensor(cell_diameter, soln_coeff, fe_values_vol.get_fe())
+                                         : adtype(0.0);
 
     for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
         for (int istate=0; istate<nstate; istate++) { 
@@ -176,24 +229,29 @@ void DGWeak<dim,nstate,real>::assemble_volume_terms_explicit(
               soln_grad_at_q[iquad][istate] += soln_coeff[idof] * fe_values_vol.shape_grad_component(idof, iquad, istate);
         }
         // Evaluate physical convective flux and source term
-        conv_phys_flux_at_q[iquad] = pde_physics_double->convective_flux (soln_at_q[iquad]);
-        diss_phys_flux_at_q[iquad] = pde_physics_double->dissipative_flux (soln_at_q[iquad], soln_grad_at_q[iquad]);
+        conv_phys_flux_at_q[iquad] = physics.convective_flux (soln_at_q[iquad]);
+        diss_phys_flux_at_q[iquad] = physics.dissipative_flux (soln_at_q[iquad], soln_grad_at_q[iquad]);
         if(this->all_parameters->add_artificial_dissipation) {
-            const ADArrayTensor1 artificial_diss_phys_flux_at_q = pde_physics_double->artificial_dissipative_flux (artificial_diss_coeff, soln_at_q[iquad], soln_grad_at_q[iquad]);
+            const ADArrayTensor1 artificial_diss_phys_flux_at_q = physics.artificial_dissipative_flux (artificial_diss_coeff, soln_at_q[iquad], soln_grad_at_q[iquad]);
             for (int istate=0; istate<nstate; istate++) { 
                 diss_phys_flux_at_q[iquad][istate] += artificial_diss_phys_flux_at_q[istate];
             }
         }
         if(this->all_parameters->manufactured_convergence_study_param.use_manufactured_source_term) {
             const dealii::Point<dim,real> point = fe_values_vol.quadrature_point(iquad);
-            source_at_q[iquad] = pde_physics_double->source_term (point, soln_at_q[iquad]);
-            //std::array<real,nstate> artificial_source_at_q = pde_physics_double->artificial_source_term (artificial_diss_coeff, point, soln_at_q[iquad]);
+            dealii::Point<dim,adtype> ad_point;
+            for (int d=0;d<dim;++d) { ad_point[d] = point[d]; }
+            source_at_q[iquad] = physics.source_term (ad_point, soln_at_q[iquad]);
+            //std::array<real,nstate> artificial_source_at_q = physics.artificial_source_term (artificial_diss_coeff, point, soln_at_q[iquad]);
             //for (int s=0;s<nstate;++s) source_at_q[iquad][s] += artificial_source_at_q[s];
         }
     }
 
-    const unsigned int cell_index = fe_values_vol.get_cell()->active_cell_index();
-    this->max_dt_cell[cell_index] = evaluate_CFL ( soln_at_q, cell_diameter );
+    // The time step only depends on the solution, not on the direction of apply_dRdW().
+    if constexpr (std::is_same<adtype,real>::value) {
+        const unsigned int cell_index = fe_values_vol.get_cell()->active_cell_index();
+        this->max_dt_cell[cell_index] = evaluate_CFL ( soln_at_q, cell_diameter );
+    }
 
     // Weak form
     // The right-hand side sends all the term to the side of the source term
@@ -205,7 +263,7 @@ void DGWeak<dim,nstate,real>::assemble_volume_terms_explicit(
     // is negative. Therefore, negative of negative means we add that volume term to the right-hand-side
     for (unsigned int itest=0; itest<n_soln_dofs_int; ++itest) {
 
-        real rhs = 0;
+        adtype rhs = 0;
 
         const unsigned int istate = fe_values_vol.get_fe().system_to_component_index(itest).first;
 
@@ -222,12 +280,151 @@ void DGWeak<dim,nstate,real>::assemble_volume_terms_explicit(
             }
         }
 
-        local_rhs_int_cell(itest) += rhs;
+        local_rhs_int_cell(itest) += this->local_residual_contribution(rhs);
 
     }
 }
 
 
+template <int dim, int nstate, typename real>
+bool DGWeak<dim,nstate,real>::assemble_volume_terms_explicit_cell_batch(
+    const typename DGBase<dim,real>::CellBatch &cells,
+    std::vector<std::unique_ptr<dealii::hp::FEValues<dim,dim>>> &fe_values_collection_volume_lanes,
+    dealii::LinearAlgebra::distributed::Vector<double> &rhs)
+{
+    // The artificial dissipation sensor needs the generic storage.
+    if (!this->all_parameters->use_fixed_degree_kernels || this->all_parameters->add_artificial_dissipation) return false;
+
+    // The fe_collection index is the polynomial degree, see create_collection_tuple().
+    const unsigned int i_fele = cells[0]->active_fe_index();
+    const unsigned int poly_degree = this->fe_collection[i_fele].degree;
+    const unsigned int n_quad_pts_1d = poly_degree+1;
+    if (this->volume_quadrature_collection[i_fele].size() != (unsigned int) SumFactorization::pow(n_quad_pts_1d, dim)) return false;
+
+    switch (poly_degree) {
+        case 1: assemble_volume_terms_explicit_fixed_degree<1,2> (cells, fe_values_collection_volume_lanes, rhs); return true;
+        case 2: assemble_volume_terms_explicit_fixed_degree<2,3> (cells, fe_values_collection_volume_lanes, rhs); return true;
+        case 3: assemble_volume_terms_explicit_fixed_degree<3,4> (cells, fe_values_collection_volume_lanes, rhs); return true;
+        case 4: assemble_volume_terms_explicit_fixed_degree<4,5> (cells, fe_values_collection_volume_lanes, rhs); return true;
+        default: return false;
+    }
+}
+
+template <int dim, int nstate, typename real>
+template <int poly_degree, int n_quad_pts_1d>
+void DGWeak<dim,nstate,real>::assemble_volume_terms_explicit_fixed_degree(
+    const typename DGBase<dim,real>::CellBatch &cells,
+    std::vector<std::unique_ptr<dealii::hp::FEValues<dim,dim>>> &fe_values_collection_volume_lanes,
+    dealii::LinearAlgebra::distributed::Vector<double> &rhs)
+{
+    using doubleArray = std::array<real,nstate>;
+    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,real>, nstate >;
+    using VectorizedDouble = dealii::VectorizedArray<double>;
+
+    constexpr unsigned int n_lanes = VectorizedDouble::size();
+    constexpr unsigned int n_quad_pts = SumFactorization::pow(n_quad_pts_1d, dim);
+    constexpr unsigned int n_soln_dofs_int = nstate * SumFactorization::pow(poly_degree+1, dim);
+
+    const unsigned int n_cells = cells.size();
+    Assert (n_cells > 0 && n_cells <= n_lanes, dealii::ExcMessage("A cell batch holds between 1 and VectorizedArray<double>::size() cells."));
+    AssertDimension (n_lanes, fe_values_collection_volume_lanes.size());
+
+    const bool use_source = this->all_parameters->manufactured_convergence_study_param.use_manufactured_source_term;
+    const unsigned int i_fele = cells[0]->active_fe_index();
+    const unsigned int i_quad = i_fele;
+    const unsigned int i_mapp = 0;
+
+    // The FE_DGQ system is primitive, each shape function only has a single non-zero component.
+    std::array< unsigned int, n_soln_dofs_int > soln_state;
+    const dealii::FiniteElement<dim,dim> &fe = this->fe_collection[i_fele];
+    AssertDimension (n_soln_dofs_int, fe.dofs_per_cell);
+    for (unsigned int idof = 0; idof < n_soln_dofs_int; ++idof) {
+        soln_state[idof] = fe.system_to_component_index(idof).first;
+    }
+
+    // Storage of each cell of the batch. Too large for the stack with several lanes of high degree.
+    std::vector< std::array< doubleArray, n_quad_pts > > soln_at_q(n_cells);
+    std::vector< std::array< ADArrayTensor1, n_quad_pts > > phys_flux_at_q(n_cells); // Convective and dissipative
+    std::vector< std::array< doubleArray, n_quad_pts > > source_at_q(use_source ? n_cells : 0);
+    std::vector< std::vector<dealii::types::global_dof_index> > soln_dof_indices_int(n_cells, std::vector<dealii::types::global_dof_index>(n_soln_dofs_int));
+
+    // Solution, dissipative flux and source of each cell.
+    for (unsigned int icell = 0; icell < n_cells; ++icell) {
+        fe_values_collection_volume_lanes[icell]->reinit (cells[icell], i_quad, i_mapp, i_fele);
+        const dealii::FEValues<dim,dim> &fe_values_vol = fe_values_collection_volume_lanes[icell]->get_present_fe_values();
+        AssertDimension (n_quad_pts, fe_values_vol.n_quadrature_points);
+
+        cells[icell]->get_dof_indices (soln_dof_indices_int[icell]);
+        std::array< real, n_soln_dofs_int > soln_coeff;
+        for (unsigned int idof = 0; idof < n_soln_dofs_int; ++idof) {
+            soln_coeff[idof] = DGBase<dim,real>::solution(soln_dof_indices_int[icell][idof]);
+        }
+
+        for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+            doubleArray &soln = soln_at_q[icell][iquad];
+            ADArrayTensor1 soln_grad;
+            for (int istate=0; istate<nstate; istate++) {
+                soln[istate]      = 0;
+                soln_grad[istate] = 0;
+            }
+            for (unsigned int idof=0; idof<n_soln_dofs_int; ++idof) {
+                const unsigned int istate = soln_state[idof];
+                soln[istate]      += soln_coeff[idof] * fe_values_vol.shape_value(idof, iquad);
+                soln_grad[istate] += soln_coeff[idof] * fe_values_vol.shape_grad(idof, iquad);
+            }
+            phys_flux_at_q[icell][iquad] = pde_physics_double->dissipative_flux (soln, soln_grad);
+            if(use_source) {
+                source_at_q[icell][iquad] = pde_physics_double->source_term (fe_values_vol.quadrature_point(iquad), soln);
+            }
+        }
+    }
+
+    // Convective flux and eigenvalue of the same quadrature point of every cell, one cell per lane.
+    // The lanes past the last cell repeat it and are discarded.
+    VectorizedDouble max_eig_batch = dealii::make_vectorized_array(0.0);
+    for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+        std::array<VectorizedDouble,nstate> soln_batch;
+        for (unsigned int lane=0; lane<n_lanes; ++lane) {
+            const unsigned int icell = std::min(lane, n_cells-1);
+            for (int istate=0; istate<nstate; istate++) soln_batch[istate][lane] = soln_at_q[icell][iquad][istate];
+        }
+        std::array<dealii::Tensor<1,dim,VectorizedDouble>,nstate> conv_flux_batch;
+        VectorizedDouble max_eig_quad;
+        evaluate_convective_flux_batch (soln_batch, conv_flux_batch, max_eig_quad);
+        max_eig_batch = std::max(max_eig_batch, max_eig_quad);
+
+        for (unsigned int icell=0; icell<n_cells; ++icell) {
+            for (int istate=0; istate<nstate; istate++) {
+                for (int d=0; d<dim; d++) {
+                    phys_flux_at_q[icell][iquad][istate][d] += conv_flux_batch[istate][d][icell];
+                }
+            }
+        }
+    }
+
+    // Weak form, see assemble_volume_terms_explicit()
+    dealii::Vector<real> local_rhs_int_cell(n_soln_dofs_int);
+    for (unsigned int icell = 0; icell < n_cells; ++icell) {
+        const dealii::FEValues<dim,dim> &fe_values_vol = fe_values_collection_volume_lanes[icell]->get_present_fe_values();
+        const std::vector<real> &JxW = fe_values_vol.get_JxW_values ();
+
+        this->set_max_dt_cell(fe_values_vol, max_eig_batch[icell]);
+
+        for (unsigned int itest=0; itest<n_soln_dofs_int; ++itest) {
+            const unsigned int istate = soln_state[itest];
+            real rhs_itest = 0;
+            for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+                real integrand = fe_values_vol.shape_grad(itest,iquad) * phys_flux_at_q[icell][iquad][istate];
+                if(use_source) integrand += fe_values_vol.shape_value(itest,iquad) * source_at_q[icell][iquad][istate];
+                rhs_itest += integrand * JxW[iquad];
+            }
+            local_rhs_int_cell(itest) = rhs_itest;
+        }
+        this->add_to_global_vector (rhs, soln_dof_indices_int[icell], local_rhs_int_cell);
+    }
+}
+
+
 template <int dim, int nstate, typename real>
 void DGWeak<dim,nstate,real>::assemble_boundary_term_explicit(
     const unsigned int boundary_id,
@@ -236,8 +433,32 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_explicit(
     const std::vector<dealii::types::global_dof_index> &soln_dof_indices_int,
     dealii::Vector<real> &local_rhs_int_cell)
 {
-    using doubleArray = std::array<real,nstate>;
-    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,real>, nstate >;
+    if (this->dRdW_product_direction) {
+        assert_directional_physics ();
+        assemble_boundary_term_explicit_ad<DirectionalFadType> (
+            boundary_id, fe_values_boundary, penalty, soln_dof_indices_int, local_rhs_int_cell,
+            *pde_physics_directional, *conv_num_flux_directional, *diss_num_flux_directional);
+    } else {
+        assemble_boundary_term_explicit_ad<real> (
+            boundary_id, fe_values_boundary, penalty, soln_dof_indices_int, local_rhs_int_cell,
+            *pde_physics_double, *conv_num_flux_double, *diss_num_flux_double);
+    }
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGWeak<dim,nstate,real>::assemble_boundary_term_explicit_ad(
+    const unsigned int boundary_id,
+    const dealii::FEFaceValuesBase<dim,dim> &fe_values_boundary,
+    const real penalty,
+    const std::vector<dealii::types::global_dof_index> &soln_dof_indices_int,
+    dealii::Vector<real> &local_rhs_int_cell,
+    Physics::PhysicsBase<dim, nstate, adtype> &physics,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+    const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad)
+{
+    using doubleArray = std::array<adtype,nstate>;
+    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,adtype>, nstate >;
 
     const unsigned int n_soln_dofs_int = fe_values_boundary.dofs_per_cell;
     const unsigned int n_face_quad_pts = fe_values_boundary.n_quadrature_points;
@@ -260,10 +481,7 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_explicit(
     std::vector<doubleArray> diss_auxi_num_flux_dot_n(n_face_quad_pts); // sigma*
 
     // AD variable
-    std::vector< real > soln_coeff_int(n_soln_dofs_int);
-    for (unsigned int idof = 0; idof < n_soln_dofs_int; ++idof) {
-        soln_coeff_int[idof] = DGBase<dim,real>::solution(soln_dof_indices_int[idof]);
-    }
+    const std::vector< adtype > soln_coeff_int = this->template local_solution_coefficients<adtype>(soln_dof_indices_int);
 
     for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
         for (int istate=0; istate<nstate; istate++) { 
@@ -273,15 +491,15 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_explicit(
     }
 
     const double cell_diameter = fe_values_boundary.get_cell()->diameter();
-    const real artificial_diss_coeff = this->all_parameters->add_artificial_dissipation ?
-                                       this->discontinuity_sensor(cell_diameter, soln_coeff_int, fe_values_boundary.get_fe())
-                                       : 0.0;
+    const adtype artificial_diss_coeff = this->all_parameters->add_artificial_dissipation ?
+                                         this->discontinuity_sensor(cell_diameter, soln_coeff_int, fe_values_boundary.get_fe())
+                                         : adtype(0.0);
 
     // Interpolate solution to face
     const std::vector< dealii::Point<dim,real> > quad_pts = fe_values_boundary.get_quadrature_points();
     for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
 
-        const dealii::Tensor<1,dim,real> normal_int = normals[iquad];
+        const dealii::Tensor<1,dim,adtype> normal_int = normals[iquad];
 
         for (unsigned int idof=0; idof<n_soln_dofs_int; ++idof) {
             const int istate = fe_values_boundary.get_fe().system_to_component_index(idof).first;
@@ -290,22 +508,12 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_explicit(
         }
 
         const dealii::Point<dim, real> real_quad_point = quad_pts[iquad];
-        pde_physics_double->boundary_face_values (boundary_id, real_quad_point, normal_int, soln_int[iquad], soln_grad_int[iquad], soln_ext[iquad], soln_grad_ext[iquad]);
-
-        // Evaluate physical convective flux, physical dissipative flux
-        // Following the the boundary treatment given by 
-        //      Hartmann, R., Numerical Analysis of Higher Order Discontinuous Galerkin Finite Element Methods,
-        //      Institute of Aerodynamics and Flow Technology, DLR (German Aerospace Center), 2008.
-        //      Details given on page 93
-        //conv_num_flux_dot_n[iquad] = conv_num_flux_double->evaluate_flux(soln_ext[iquad], soln_ext[iquad], normal_int);
+        dealii::Point<dim,adtype> ad_point;
+        for (int d=0;d<dim;++d) { ad_point[d] = real_quad_point[d]; }
+        physics.boundary_face_values (boundary_id, ad_point, normal_int, soln_int[iquad], soln_grad_int[iquad], soln_ext[iquad], soln_grad_ext[iquad]);
 
-        // So, I wasn't able to get Euler manufactured solutions to converge when F* = F*(Ubc, Ubc)
-        // Changing it back to the standdard F* = F*(Uin, Ubc)
-        // This is known not be adjoint consistent as per the paper above. Page 85, second to last paragraph.
-        // Losing 2p+1 OOA on functionals for all PDEs.
-        conv_num_flux_dot_n[iquad] = conv_num_flux_double->evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
         // Notice that the flux uses the solution given by the Dirichlet or Neumann boundary condition
-        diss_soln_num_flux[iquad] = diss_num_flux_double->evaluate_solution_flux(soln_ext[iquad], soln_ext[iquad], normal_int);
+        diss_soln_num_flux[iquad] = diss_num_flux_ad.evaluate_solution_flux(soln_ext[iquad], soln_ext[iquad], normal_int);
 
         ADArrayTensor1 diss_soln_jump_int;
         for (int s=0; s<nstate; s++) {
@@ -313,15 +521,15 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_explicit(
 				diss_soln_jump_int[s][d] = (diss_soln_num_flux[iquad][s] - soln_int[iquad][s]) * normal_int[d];
 			}
         }
-        diss_flux_jump_int[iquad] = pde_physics_double->dissipative_flux (soln_int[iquad], diss_soln_jump_int);
+        diss_flux_jump_int[iquad] = physics.dissipative_flux (soln_int[iquad], diss_soln_jump_int);
         if (this->all_parameters->add_artificial_dissipation) {
-            const ADArrayTensor1 artificial_diss_flux_jump_int = pde_physics_double->artificial_dissipative_flux (artificial_diss_coeff, soln_int[iquad], diss_soln_jump_int);
+            const ADArrayTensor1 artificial_diss_flux_jump_int = physics.artificial_dissipative_flux (artificial_diss_coeff, soln_int[iquad], diss_soln_jump_int);
             for (int s=0; s<nstate; s++) {
                 diss_flux_jump_int[iquad][s] += artificial_diss_flux_jump_int[s];
             }
         }
 
-        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux_double->evaluate_auxiliary_flux(
+        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux_ad.evaluate_auxiliary_flux(
             artificial_diss_coeff,
             artificial_diss_coeff,
             soln_int[iquad], soln_ext[iquad],
@@ -329,9 +537,22 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_explicit(
             normal_int, penalty, true);
     }
 
+    // Evaluate physical convective flux, physical dissipative flux
+    // Following the the boundary treatment given by 
+    //      Hartmann, R., Numerical Analysis of Higher Order Discontinuous Galerkin Finite Element Methods,
+    //      Institute of Aerodynamics and Flow Technology, DLR (German Aerospace Center), 2008.
+    //      Details given on page 93
+    //conv_num_flux_dot_n[iquad] = conv_num_flux_double->evaluate_flux(soln_ext[iquad], soln_ext[iquad], normal_int);
+
+    // So, I wasn't able to get Euler manufactured solutions to converge when F* = F*(Ubc, Ubc)
+    // Changing it back to the standdard F* = F*(Uin, Ubc)
+    // This is known not be adjoint consistent as per the paper above. Page 85, second to last paragraph.
+    // Losing 2p+1 OOA on functionals for all PDEs.
+    evaluate_convective_numerical_flux_batched (soln_int, soln_ext, normals, conv_num_flux_ad, conv_num_flux_dot_n);
+
     for (unsigned int itest=0; itest<n_soln_dofs_int; ++itest) {
 
-        real rhs = 0.0;
+        adtype rhs = 0.0;
 
         const unsigned int istate = fe_values_boundary.get_fe().system_to_component_index(itest).first;
 
@@ -345,7 +566,7 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_explicit(
         }
         // *******************
 
-        local_rhs_int_cell(itest) += rhs;
+        local_rhs_int_cell(itest) += this->local_residual_contribution(rhs);
     }
 }
 
@@ -359,8 +580,38 @@ void DGWeak<dim,nstate,real>::assemble_face_term_explicit(
     dealii::Vector<real>          &local_rhs_int_cell,
     dealii::Vector<real>          &local_rhs_ext_cell)
 {
-    using doubleArray = std::array<real,nstate>;
-    using doubleArrayTensor1 = std::array< dealii::Tensor<1,dim,real>, nstate >;
+    if (this->dRdW_product_direction) {
+        assert_directional_physics ();
+        assemble_face_term_explicit_ad<DirectionalFadType> (
+            fe_values_int, fe_values_ext, penalty,
+            soln_dof_indices_int, soln_dof_indices_ext,
+            local_rhs_int_cell, local_rhs_ext_cell,
+            *pde_physics_directional, *conv_num_flux_directional, *diss_num_flux_directional);
+    } else {
+        assemble_face_term_explicit_ad<real> (
+            fe_values_int, fe_values_ext, penalty,
+            soln_dof_indices_int, soln_dof_indices_ext,
+            local_rhs_int_cell, local_rhs_ext_cell,
+            *pde_physics_double, *conv_num_flux_double, *diss_num_flux_double);
+    }
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGWeak<dim,nstate,real>::assemble_face_term_explicit_ad(
+    const dealii::FEFaceValuesBase<dim,dim>     &fe_values_int,
+    const dealii::FEFaceValuesBase<dim,dim>     &fe_values_ext,
+    const real penalty,
+    const std::vector<dealii::types::global_dof_index> &soln_dof_indices_int,
+    const std::vector<dealii::types::global_dof_index> &soln_dof_indices_ext,
+    dealii::Vector<real>          &local_rhs_int_cell,
+    dealii::Vector<real>          &local_rhs_ext_cell,
+    Physics::PhysicsBase<dim, nstate, adtype> &physics,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+    const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad)
+{
+    using doubleArray = std::array<adtype,nstate>;
+    using doubleArrayTensor1 = std::array< dealii::Tensor<1,dim,adtype>, nstate >;
 
     // Use quadrature points of neighbor cell
     // Might want to use the maximum n_quad_pts1 and n_quad_pts2
@@ -381,10 +632,6 @@ void DGWeak<dim,nstate,real>::assemble_face_term_explicit(
     const std::vector<real> &JxW_int = fe_values_int.get_JxW_values ();
     const std::vector<dealii::Tensor<1,dim> > &normals_int = fe_values_int.get_normal_vectors ();
 
-    // AD variable
-    std::vector<real> soln_coeff_int(n_soln_dofs_int);
-    std::vector<real> soln_coeff_ext(n_soln_dofs_ext);
-
     std::vector<doubleArray> conv_num_flux_dot_n(n_face_quad_pts);
 
     // Interpolate solution to the face quadrature points
@@ -400,12 +647,8 @@ void DGWeak<dim,nstate,real>::assemble_face_term_explicit(
     std::vector<doubleArrayTensor1> diss_flux_jump_int(n_face_quad_pts); // u*-u_int
     std::vector<doubleArrayTensor1> diss_flux_jump_ext(n_face_quad_pts); // u*-u_ext
     // AD variable
-    for (unsigned int idof = 0; idof < n_soln_dofs_int; ++idof) {
-        soln_coeff_int[idof] = DGBase<dim,real>::solution(soln_dof_indices_int[idof]);
-    }
-    for (unsigned int idof = 0; idof < n_soln_dofs_ext; ++idof) {
-        soln_coeff_ext[idof] = DGBase<dim,real>::solution(soln_dof_indices_ext[idof]);
-    }
+    const std::vector<adtype> soln_coeff_int = this->template local_solution_coefficients<adtype>(soln_dof_indices_int);
+    const std::vector<adtype> soln_coeff_ext = this->template local_solution_coefficients<adtype>(soln_dof_indices_ext);
     for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
         for (int istate=0; istate<nstate; istate++) { 
             soln_int[iquad][istate]      = 0;
@@ -417,17 +660,17 @@ void DGWeak<dim,nstate,real>::assemble_face_term_explicit(
 
     const double cell_diameter_int = fe_values_int.get_cell()->diameter();
     const double cell_diameter_ext = fe_values_ext.get_cell()->diameter();
-    const real artificial_diss_coeff_int = this->all_parameters->add_artificial_dissipation ?
-                                           this->discontinuity_sensor(cell_diameter_int, soln_coeff_int, fe_values_int.get_fe())
-                                           : 0.0;
-    const real artificial_diss_coeff_ext = this->all_parameters->add_artificial_dissipation ?
-                                           this->discontinuity_sensor(cell_diameter_ext, soln_coeff_ext, fe_values_ext.get_fe())
-                                           : 0.0;
+    const adtype artificial_diss_coeff_int = this->all_parameters->add_artificial_dissipation ?
+                                             this->discontinuity_sensor(cell_diameter_int, soln_coeff_int, fe_values_int.get_fe())
+                                             : adtype(0.0);
+    const adtype artificial_diss_coeff_ext = this->all_parameters->add_artificial_dissipation ?
+                                             this->discontinuity_sensor(cell_diameter_ext, soln_coeff_ext, fe_values_ext.get_fe())
+                                             : adtype(0.0);
 
     for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
 
-        const dealii::Tensor<1,dim,real> normal_int = normals_int[iquad];
-        const dealii::Tensor<1,dim,real> normal_ext = -normal_int;
+        const dealii::Tensor<1,dim,adtype> normal_int = normals_int[iquad];
+        const dealii::Tensor<1,dim,adtype> normal_ext = -normal_int;
 
         // Interpolate solution to face
         for (unsigned int idof=0; idof<n_soln_dofs_int; ++idof) {
@@ -441,9 +684,8 @@ void DGWeak<dim,nstate,real>::assemble_face_term_explicit(
             soln_grad_ext[iquad][istate] += soln_coeff_ext[idof] * fe_values_ext.shape_grad_component(idof, iquad, istate);
         }
 
-        // Evaluate physical convective flux, physical dissipative flux, and source term
-        conv_num_flux_dot_n[iquad] = conv_num_flux_double->evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
-        diss_soln_num_flux[iquad] = diss_num_flux_double->evaluate_solution_flux(soln_int[iquad], soln_ext[iquad], normal_int);
+        // Evaluate physical dissipative flux. The convective numerical flux is evaluated in batches below.
+        diss_soln_num_flux[iquad] = diss_num_flux_ad.evaluate_solution_flux(soln_int[iquad], soln_ext[iquad], normal_int);
 
         doubleArrayTensor1 diss_soln_jump_int, diss_soln_jump_ext;
         for (int s=0; s<nstate; s++) {
@@ -452,29 +694,30 @@ void DGWeak<dim,nstate,real>::assemble_face_term_explicit(
 				diss_soln_jump_ext[s][d] = (diss_soln_num_flux[iquad][s] - soln_ext[iquad][s]) * normal_ext[d];
 			}
         }
-        diss_flux_jump_int[iquad] = pde_physics_double->dissipative_flux (soln_int[iquad], diss_soln_jump_int);
-        diss_flux_jump_ext[iquad] = pde_physics_double->dissipative_flux (soln_ext[iquad], diss_soln_jump_ext);
+        diss_flux_jump_int[iquad] = physics.dissipative_flux (soln_int[iquad], diss_soln_jump_int);
+        diss_flux_jump_ext[iquad] = physics.dissipative_flux (soln_ext[iquad], diss_soln_jump_ext);
 
         if (this->all_parameters->add_artificial_dissipation) {
-            const doubleArrayTensor1 artificial_diss_flux_jump_int = pde_physics_double->artificial_dissipative_flux (artificial_diss_coeff_int, soln_int[iquad], diss_soln_jump_int);
-            const doubleArrayTensor1 artificial_diss_flux_jump_ext = pde_physics_double->artificial_dissipative_flux (artificial_diss_coeff_ext, soln_ext[iquad], diss_soln_jump_ext);
+            const doubleArrayTensor1 artificial_diss_flux_jump_int = physics.artificial_dissipative_flux (artificial_diss_coeff_int, soln_int[iquad], diss_soln_jump_int);
+            const doubleArrayTensor1 artificial_diss_flux_jump_ext = physics.artificial_dissipative_flux (artificial_diss_coeff_ext, soln_ext[iquad], diss_soln_jump_ext);
             for (int s=0; s<nstate; s++) {
                 diss_flux_jump_int[iquad][s] += artificial_diss_flux_jump_int[s];
                 diss_flux_jump_ext[iquad][s] += artificial_diss_flux_jump_ext[s];
             }
         }
 
-        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux_double->evaluate_auxiliary_flux(
+        diss_auxi_num_flux_dot_n[iquad] = diss_num_flux_ad.evaluate_auxiliary_flux(
             artificial_diss_coeff_int,
             artificial_diss_coeff_ext,
             soln_int[iquad], soln_ext[iquad],
             soln_grad_int[iquad], soln_grad_ext[iquad],
             normal_int, penalty);
     }
+    evaluate_convective_numerical_flux_batched (soln_int, soln_ext, normals_int, conv_num_flux_ad, conv_num_flux_dot_n);
 
     // From test functions associated with interior cell point of view
     for (unsigned int itest_int=0; itest_int<n_soln_dofs_int; ++itest_int) {
-        real rhs = 0.0;
+        adtype rhs = 0.0;
         const unsigned int istate = fe_values_int.get_fe().system_to_component_index(itest_int).first;
 
         for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
@@ -485,12 +728,12 @@ void DGWeak<dim,nstate,real>::assemble_face_term_explicit(
             rhs = rhs + fe_values_int.shape_grad_component(itest_int,iquad,istate) * diss_flux_jump_int[iquad][istate] * JxW_int[iquad];
         }
 
-        local_rhs_int_cell(itest_int) += rhs;
+        local_rhs_int_cell(itest_int) += this->local_residual_contribution(rhs);
     }
 
     // From test functions associated with neighbour cell point of view
     for (unsigned int itest_ext=0; itest_ext<n_soln_dofs_ext; ++itest_ext) {
-        real rhs = 0.0;
+        adtype rhs = 0.0;
         const unsigned int istate = fe_values_int.get_fe().system_to_component_index(itest_ext).first;
 
         for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
@@ -501,7 +744,547 @@ void DGWeak<dim,nstate,real>::assemble_face_term_explicit(
             rhs = rhs + fe_values_ext.shape_grad_component(itest_ext,iquad,istate) * diss_flux_jump_ext[iquad][istate] * JxW_int[iquad];
         }
 
-        local_rhs_ext_cell(itest_ext) += rhs;
+        local_rhs_ext_cell(itest_ext) += this->local_residual_contribution(rhs);
+    }
+}
+
+template <int dim, int nstate, typename real>
+void DGWeak<dim,nstate,real>::evaluate_convective_flux_batch (
+    const std::array<dealii::VectorizedArray<double>,nstate> &soln_batch,
+    std::array<dealii::Tensor<1,dim,dealii::VectorizedArray<double>>,nstate> &conv_flux_batch,
+    dealii::VectorizedArray<double> &max_eig_batch) const
+{
+    if constexpr (nstate == dim+2) {
+        const auto *euler_physics = dynamic_cast<const Physics::Euler<dim,nstate,real>*>(pde_physics_double.get());
+        if (euler_physics) {
+            conv_flux_batch = euler_physics->convective_flux_templated (soln_batch);
+            max_eig_batch = euler_physics->max_convective_eigenvalue_templated (soln_batch);
+            return;
+        }
+    }
+    for (unsigned int lane = 0; lane < dealii::VectorizedArray<double>::size(); ++lane) {
+        std::array<real,nstate> soln_lane;
+        for (int s=0; s<nstate; ++s) soln_lane[s] = soln_batch[s][lane];
+        const std::array<dealii::Tensor<1,dim,real>,nstate> conv_flux_lane = pde_physics_double->convective_flux (soln_lane);
+        for (int s=0; s<nstate; ++s) {
+            for (int d=0; d<dim; ++d) conv_flux_batch[s][d][lane] = conv_flux_lane[s][d];
+        }
+        max_eig_batch[lane] = pde_physics_double->max_convective_eigenvalue (soln_lane);
+    }
+}
+
+template <int dim, int nstate, typename real>
+std::array<dealii::VectorizedArray<double>,nstate> DGWeak<dim,nstate,real>::evaluate_convective_numerical_flux_batch (
+    const std::array<dealii::VectorizedArray<double>,nstate> &soln_int_batch,
+    const std::array<dealii::VectorizedArray<double>,nstate> &soln_ext_batch,
+    const dealii::Tensor<1,dim,dealii::VectorizedArray<double>> &normal_int_batch,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, real> &conv_num_flux) const
+{
+    using VectorizedDouble = dealii::VectorizedArray<double>;
+    if constexpr (nstate == dim+2) {
+        const auto *roe = dynamic_cast<const NumericalFlux::Roe<dim,nstate,real>*>(&conv_num_flux);
+        if (roe) return roe->evaluate_flux_templated (soln_int_batch, soln_ext_batch, normal_int_batch);
+
+        // conv_num_flux_double evaluates the physics it was created with, which is pde_physics_double.
+        const auto *euler_physics = dynamic_cast<const Physics::Euler<dim,nstate,real>*>(pde_physics_double.get());
+        const bool is_lax_friedrichs = dynamic_cast<const NumericalFlux::LaxFriedrichs<dim,nstate,real>*>(&conv_num_flux) != nullptr;
+        if (euler_physics && is_lax_friedrichs && &conv_num_flux == conv_num_flux_double) {
+            return NumericalFlux::LaxFriedrichs<dim,nstate,real>::evaluate_flux_from_physical_fluxes (
+                soln_int_batch, soln_ext_batch,
+                euler_physics->convective_flux_templated (soln_int_batch),
+                euler_physics->convective_flux_templated (soln_ext_batch),
+                euler_physics->max_convective_eigenvalue_templated (soln_int_batch),
+                euler_physics->max_convective_eigenvalue_templated (soln_ext_batch),
+                normal_int_batch);
+        }
+    }
+    std::array<VectorizedDouble,nstate> conv_num_flux_batch;
+    for (unsigned int lane = 0; lane < VectorizedDouble::size(); ++lane) {
+        std::array<real,nstate> soln_int_lane, soln_ext_lane;
+        for (int s=0; s<nstate; s++) {
+            soln_int_lane[s] = soln_int_batch[s][lane];
+            soln_ext_lane[s] = soln_ext_batch[s][lane];
+        }
+        dealii::Tensor<1,dim,real> normal_lane;
+        for (int d=0; d<dim; d++) normal_lane[d] = normal_int_batch[d][lane];
+        const std::array<real,nstate> conv_num_flux_lane = conv_num_flux.evaluate_flux(soln_int_lane, soln_ext_lane, normal_lane);
+        for (int s=0; s<nstate; s++) conv_num_flux_batch[s][lane] = conv_num_flux_lane[s];
+    }
+    return conv_num_flux_batch;
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGWeak<dim,nstate,real>::evaluate_convective_numerical_flux_batched(
+    const std::vector< std::array<adtype,nstate> > &soln_int,
+    const std::vector< std::array<adtype,nstate> > &soln_ext,
+    const std::vector< dealii::Tensor<1,dim> > &normals_int,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+    std::vector< std::array<adtype,nstate> > &conv_num_flux_dot_n) const
+{
+    if constexpr (!std::is_same<adtype,real>::value) {
+        // Only the real numerical fluxes have a vectorized version.
+        for (unsigned int iquad=0; iquad<soln_int.size(); ++iquad) {
+            const dealii::Tensor<1,dim,adtype> normal_int = normals_int[iquad];
+            conv_num_flux_dot_n[iquad] = conv_num_flux_ad.evaluate_flux(soln_int[iquad], soln_ext[iquad], normal_int);
+        }
+    } else {
+        using VectorizedDouble = dealii::VectorizedArray<double>;
+        constexpr unsigned int n_lanes = VectorizedDouble::size();
+        const unsigned int n_face_quad_pts = soln_int.size();
+        AssertDimension (n_face_quad_pts, soln_ext.size());
+        AssertDimension (n_face_quad_pts, conv_num_flux_dot_n.size());
+
+        for (unsigned int iquad_batch=0; iquad_batch<n_face_quad_pts; iquad_batch+=n_lanes) {
+            std::array<VectorizedDouble,nstate> soln_int_batch, soln_ext_batch;
+            dealii::Tensor<1,dim,VectorizedDouble> normal_int_batch;
+            for (unsigned int lane=0; lane<n_lanes; ++lane) {
+                const unsigned int iquad = std::min(iquad_batch+lane, n_face_quad_pts-1);
+                for (int s=0; s<nstate; s++) {
+                    soln_int_batch[s][lane] = soln_int[iquad][s];
+                    soln_ext_batch[s][lane] = soln_ext[iquad][s];
+                }
+                for (int d=0; d<dim; d++) normal_int_batch[d][lane] = normals_int[iquad][d];
+            }
+            const std::array<VectorizedDouble,nstate> conv_num_flux_batch
+                = evaluate_convective_numerical_flux_batch(soln_int_batch, soln_ext_batch, normal_int_batch, conv_num_flux_ad);
+
+            const unsigned int n_filled_lanes = std::min(n_lanes, n_face_quad_pts-iquad_batch);
+            for (unsigned int lane=0; lane<n_filled_lanes; ++lane) {
+                for (int s=0; s<nstate; s++) conv_num_flux_dot_n[iquad_batch+lane][s] = conv_num_flux_batch[s][lane];
+            }
+        }
+    }
+}
+
+template <int dim, int nstate, typename real>
+bool DGWeak<dim,nstate,real>::use_first_order_fad (
+    const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R) const
+{
+    // The discontinuity sensor is only differentiated with FadFadType.
+    return this->all_parameters->use_flux_jacobians
+           && compute_dRdW && !compute_dRdX && !compute_d2R
+           && !this->all_parameters->add_artificial_dissipation;
+}
+
+template <int dim, int nstate, typename real>
+bool DGWeak<dim,nstate,real>::can_use_static_fad (const unsigned int n_total_indep) const
+{
+    return this->all_parameters->use_static_fad && pde_physics_static_fad && n_total_indep <= static_fad_derivatives(1);
+}
+
+/// Derivative of \p quantity along a trial function of state \p istate.
+/** The first-derivative AD variables are ordered per side as the nstate solution values followed by
+ *  the nstate*dim gradient components, and this side starts at \p offset.
+ */
+template <int dim, int nstate, typename adtype>
+inline double trial_derivative (
+    const adtype &quantity,
+    const unsigned int offset,
+    const unsigned int istate,
+    const double shape_value,
+    const dealii::Tensor<1,dim,double> &shape_grad)
+{
+    double derivative = quantity.dx(offset + istate) * shape_value;
+    for (int d=0; d<dim; ++d) {
+        derivative += quantity.dx(offset + nstate + istate*dim + d) * shape_grad[d];
+    }
+    return derivative;
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGWeak<dim,nstate,real>::assemble_volume_terms_flux_jacobians(
+    const dealii::FEValues<dim,dim> &fe_values_vol,
+    const std::vector<dealii::types::global_dof_index> &soln_dof_indices,
+    dealii::Vector<real> &local_rhs_cell,
+    const Physics::PhysicsBase<dim, nstate, adtype> &physics)
+{
+    const unsigned int n_quad_pts  = fe_values_vol.n_quadrature_points;
+    const unsigned int n_soln_dofs = fe_values_vol.dofs_per_cell;
+    const unsigned int n_flux_indep = nstate*(dim+1);
+
+    AssertDimension (n_soln_dofs, soln_dof_indices.size());
+
+    const std::vector<real> &JxW = fe_values_vol.get_JxW_values ();
+    const bool use_source = this->all_parameters->manufactured_convergence_study_param.use_manufactured_source_term;
+
+    std::vector<real> soln_coeff(n_soln_dofs);
+    std::vector<unsigned int> dof_state(n_soln_dofs);
+    for (unsigned int idof = 0; idof < n_soln_dofs; ++idof) {
+        soln_coeff[idof] = DGBase<dim,real>::solution(soln_dof_indices[idof]);
+        dof_state[idof] = fe_values_vol.get_fe().system_to_component_index(idof).first;
+    }
+
+    std::vector<real> shape_value(n_soln_dofs);
+    std::vector<dealii::Tensor<1,dim,real>> shape_grad(n_soln_dofs);
+    // Derivative of the flux of each state along each trial function.
+    std::vector<std::array<dealii::Tensor<1,dim,real>,nstate>> flux_trial(n_soln_dofs);
+
+    dealii::FullMatrix<real> local_dRdW(n_soln_dofs, n_soln_dofs);
+
+    for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
+
+        std::array<adtype,nstate> soln_at_q;
+        std::array<dealii::Tensor<1,dim,adtype>,nstate> soln_grad_at_q;
+        std::array<real,nstate> soln_val;
+        std::array<dealii::Tensor<1,dim,real>,nstate> soln_grad_val;
+        for (int s=0; s<nstate; ++s) {
+            soln_val[s] = 0;
+            soln_grad_val[s] = 0;
+        }
+        for (unsigned int idof=0; idof<n_soln_dofs; ++idof) {
+            const unsigned int istate = dof_state[idof];
+            shape_value[idof] = fe_values_vol.shape_value_component(idof, iquad, istate);
+            shape_grad[idof] = fe_values_vol.shape_grad_component(idof, iquad, istate);
+            soln_val[istate] += soln_coeff[idof] * shape_value[idof];
+            soln_grad_val[istate] += soln_coeff[idof] * shape_grad[idof];
+        }
+
+        // Only the pointwise physics is differentiated, with respect to the solution and its gradient.
+        for (int s=0; s<nstate; ++s) {
+            soln_at_q[s] = soln_val[s];
+            soln_at_q[s].diff(s, n_flux_indep);
+            for (int d=0; d<dim; ++d) {
+                soln_grad_at_q[s][d] = soln_grad_val[s][d];
+                soln_grad_at_q[s][d].diff(nstate + s*dim + d, n_flux_indep);
+            }
+        }
+        const std::array<dealii::Tensor<1,dim,adtype>,nstate> conv_phys_flux = physics.convective_flux (soln_at_q);
+        const std::array<dealii::Tensor<1,dim,adtype>,nstate> diss_phys_flux = physics.dissipative_flux (soln_at_q, soln_grad_at_q);
+        std::array<adtype,nstate> source;
+        if (use_source) {
+            const dealii::Point<dim,real> real_quad_point = fe_values_vol.quadrature_point(iquad);
+            dealii::Point<dim,adtype> ad_point;
+            for (int d=0;d<dim;++d) { ad_point[d] = real_quad_point[d]; }
+            source = physics.source_term (ad_point, soln_at_q);
+        }
+
+        std::array<dealii::Tensor<1,dim,adtype>,nstate> flux;
+        for (int s=0; s<nstate; ++s) {
+            for (int d=0; d<dim; ++d) {
+                flux[s][d] = conv_phys_flux[s][d] + diss_phys_flux[s][d];
+            }
+        }
+
+        for (unsigned int jdof=0; jdof<n_soln_dofs; ++jdof) {
+            for (int s=0; s<nstate; ++s) {
+                for (int d=0; d<dim; ++d) {
+                    flux_trial[jdof][s][d] = trial_derivative<dim,nstate> (flux[s][d], 0, dof_state[jdof], shape_value[jdof], shape_grad[jdof]);
+                }
+            }
+        }
+
+        // Weak form, see assemble_volume_terms_explicit()
+        for (unsigned int itest=0; itest<n_soln_dofs; ++itest) {
+            const unsigned int istate = dof_state[itest];
+            const dealii::Tensor<1,dim,real> grad_test_JxW = shape_grad[itest] * JxW[iquad];
+            const real test_JxW = shape_value[itest] * JxW[iquad];
+
+            real rhs = 0.0;
+            for (int d=0; d<dim; ++d) rhs += grad_test_JxW[d] * flux[istate][d].val();
+            if (use_source) rhs += test_JxW * source[istate].val();
+            local_rhs_cell(itest) += rhs;
+
+            for (unsigned int jdof=0; jdof<n_soln_dofs; ++jdof) {
+                real derivative = grad_test_JxW * flux_trial[jdof][istate];
+                if (use_source) derivative += test_JxW * source[istate].dx(dof_state[jdof]) * shape_value[jdof];
+                local_dRdW(itest,jdof) += derivative;
+            }
+        }
+    }
+
+    this->add_to_global_matrix(this->system_matrix, soln_dof_indices, soln_dof_indices, local_dRdW);
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGWeak<dim,nstate,real>::assemble_boundary_term_flux_jacobians(
+    const unsigned int boundary_id,
+    const dealii::FEFaceValuesBase<dim,dim> &fe_values_boundary,
+    const real penalty,
+    const std::vector<dealii::types::global_dof_index> &soln_dof_indices,
+    dealii::Vector<real> &local_rhs_cell,
+    const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+    const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad)
+{
+    using ADArray = std::array<adtype,nstate>;
+    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,adtype>, nstate >;
+
+    const unsigned int n_soln_dofs = fe_values_boundary.dofs_per_cell;
+    const unsigned int n_face_quad_pts = fe_values_boundary.n_quadrature_points;
+    const unsigned int n_flux_indep = nstate*(dim+1);
+
+    AssertDimension (n_soln_dofs, soln_dof_indices.size());
+
+    const std::vector<real> &JxW = fe_values_boundary.get_JxW_values ();
+    const std::vector<dealii::Tensor<1,dim>> &normals = fe_values_boundary.get_normal_vectors ();
+    const std::vector< dealii::Point<dim,real> > &quad_pts = fe_values_boundary.get_quadrature_points();
+
+    std::vector<real> soln_coeff(n_soln_dofs);
+    std::vector<unsigned int> dof_state(n_soln_dofs);
+    for (unsigned int idof = 0; idof < n_soln_dofs; ++idof) {
+        soln_coeff[idof] = DGBase<dim,real>::solution(soln_dof_indices[idof]);
+        dof_state[idof] = fe_values_boundary.get_fe().system_to_component_index(idof).first;
+    }
+
+    std::vector<real> shape_value(n_soln_dofs);
+    std::vector<dealii::Tensor<1,dim,real>> shape_grad(n_soln_dofs);
+    // Derivatives of the normal fluxes and of the dissipative flux of the jump along each trial function.
+    std::vector<std::array<real,nstate>> face_flux_trial(n_soln_dofs);
+    std::vector<std::array<dealii::Tensor<1,dim,real>,nstate>> jump_flux_trial(n_soln_dofs);
+
+    dealii::FullMatrix<real> local_dRdW(n_soln_dofs, n_soln_dofs);
+
+    for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
+
+        const dealii::Tensor<1,dim,adtype> normal_int = normals[iquad];
+
+        std::array<real,nstate> soln_val;
+        std::array<dealii::Tensor<1,dim,real>,nstate> soln_grad_val;
+        for (int s=0; s<nstate; ++s) {
+            soln_val[s] = 0;
+            soln_grad_val[s] = 0;
+        }
+        for (unsigned int idof=0; idof<n_soln_dofs; ++idof) {
+            const unsigned int istate = dof_state[idof];
+            shape_value[idof] = fe_values_boundary.shape_value_component(idof, iquad, istate);
+            shape_grad[idof] = fe_values_boundary.shape_grad_component(idof, iquad, istate);
+            soln_val[istate] += soln_coeff[idof] * shape_value[idof];
+            soln_grad_val[istate] += soln_coeff[idof] * shape_grad[idof];
+        }
+
+        ADArray soln_int, soln_ext;
+        ADArrayTensor1 soln_grad_int, soln_grad_ext;
+        for (int s=0; s<nstate; ++s) {
+            soln_int[s] = soln_val[s];
+            soln_int[s].diff(s, n_flux_indep);
+            for (int d=0; d<dim; ++d) {
+                soln_grad_int[s][d] = soln_grad_val[s][d];
+                soln_grad_int[s][d].diff(nstate + s*dim + d, n_flux_indep);
+            }
+        }
+
+        dealii::Point<dim,adtype> ad_point;
+        for (int d=0;d<dim;++d) { ad_point[d] = quad_pts[iquad][d]; }
+        physics.boundary_face_values (boundary_id, ad_point, normal_int, soln_int, soln_grad_int, soln_ext, soln_grad_ext);
+
+        // Standard F* = F*(Uin, Ubc), see assemble_boundary_term_explicit()
+        const ADArray conv_num_flux_dot_n = conv_num_flux_ad.evaluate_flux(soln_int, soln_ext, normal_int);
+        const ADArray diss_soln_num_flux = diss_num_flux_ad.evaluate_solution_flux(soln_ext, soln_ext, normal_int);
+        ADArrayTensor1 diss_soln_jump_int;
+        for (int s=0; s<nstate; s++) {
+            for (int d=0; d<dim; d++) {
+                diss_soln_jump_int[s][d] = (diss_soln_num_flux[s] - soln_int[s]) * normal_int[d];
+            }
+        }
+        const ADArrayTensor1 diss_flux_jump_int = physics.dissipative_flux (soln_int, diss_soln_jump_int);
+        const ADArray diss_auxi_num_flux_dot_n = diss_num_flux_ad.evaluate_auxiliary_flux(
+            0.0, 0.0,
+            soln_int, soln_ext,
+            soln_grad_int, soln_grad_ext,
+            normal_int, penalty, true);
+
+        ADArray face_flux;
+        for (int s=0; s<nstate; ++s) face_flux[s] = conv_num_flux_dot_n[s] + diss_auxi_num_flux_dot_n[s];
+
+        for (unsigned int jdof=0; jdof<n_soln_dofs; ++jdof) {
+            for (int s=0; s<nstate; ++s) {
+                face_flux_trial[jdof][s] = trial_derivative<dim,nstate> (face_flux[s], 0, dof_state[jdof], shape_value[jdof], shape_grad[jdof]);
+                for (int d=0; d<dim; ++d) {
+                    jump_flux_trial[jdof][s][d] = trial_derivative<dim,nstate> (diss_flux_jump_int[s][d], 0, dof_state[jdof], shape_value[jdof], shape_grad[jdof]);
+                }
+            }
+        }
+
+        for (unsigned int itest=0; itest<n_soln_dofs; ++itest) {
+            const unsigned int istate = dof_state[itest];
+            const dealii::Tensor<1,dim,real> grad_test_JxW = shape_grad[itest] * JxW[iquad];
+            const real test_JxW = shape_value[itest] * JxW[iquad];
+
+            real rhs = - test_JxW * face_flux[istate].val();
+            for (int d=0; d<dim; ++d) rhs += grad_test_JxW[d] * diss_flux_jump_int[istate][d].val();
+            local_rhs_cell(itest) += rhs;
+
+            for (unsigned int jdof=0; jdof<n_soln_dofs; ++jdof) {
+                local_dRdW(itest,jdof) += - test_JxW * face_flux_trial[jdof][istate]
+                                          + grad_test_JxW * jump_flux_trial[jdof][istate];
+            }
+        }
+    }
+
+    this->add_to_global_matrix(this->system_matrix, soln_dof_indices, soln_dof_indices, local_dRdW);
+}
+
+template <int dim, int nstate, typename real>
+template <typename adtype>
+void DGWeak<dim,nstate,real>::assemble_face_term_flux_jacobians(
+    const dealii::FEFaceValuesBase<dim,dim>     &fe_values_int,
+    const dealii::FEFaceValuesBase<dim,dim>     &fe_values_ext,
+    const real penalty,
+    const std::vector<dealii::types::global_dof_index> &soln_dof_indices_int,
+    const std::vector<dealii::types::global_dof_index> &soln_dof_indices_ext,
+    dealii::Vector<real>          &local_rhs_int_cell,
+    dealii::Vector<real>          &local_rhs_ext_cell,
+    const Physics::PhysicsBase<dim, nstate, adtype> &physics,
+    const NumericalFlux::NumericalFluxConvective<dim, nstate, adtype> &conv_num_flux_ad,
+    const NumericalFlux::NumericalFluxDissipative<dim, nstate, adtype> &diss_num_flux_ad)
+{
+    using ADArray = std::array<adtype,nstate>;
+    using ADArrayTensor1 = std::array< dealii::Tensor<1,dim,adtype>, nstate >;
+
+    const unsigned int n_face_quad_pts = fe_values_ext.n_quadrature_points;
+
+    const unsigned int n_soln_dofs_int = fe_values_int.dofs_per_cell;
+    const unsigned int n_soln_dofs_ext = fe_values_ext.dofs_per_cell;
+
+    AssertDimension (n_soln_dofs_int, soln_dof_indices_int.size());
+    AssertDimension (n_soln_dofs_ext, soln_dof_indices_ext.size());
+
+    // The exterior AD variables follow the interior ones.
+    const unsigned int n_side_indep = nstate*(dim+1);
+    const unsigned int n_flux_indep = 2*n_side_indep;
+
+    // Both sides use the interior surface Jacobian and normal, see assemble_face_term_explicit()
+    const std::vector<real> &JxW_int = fe_values_int.get_JxW_values ();
+    const std::vector<dealii::Tensor<1,dim> > &normals_int = fe_values_int.get_normal_vectors ();
+
+    std::array<const dealii::FEFaceValuesBase<dim,dim> *, 2> fe_values {{ &fe_values_int, &fe_values_ext }};
+    std::array<unsigned int, 2> n_soln_dofs {{ n_soln_dofs_int, n_soln_dofs_ext }};
+    std::array<const std::vector<dealii::types::global_dof_index> *, 2> soln_dof_indices {{ &soln_dof_indices_int, &soln_dof_indices_ext }};
+    std::array<dealii::Vector<real> *, 2> local_rhs {{ &local_rhs_int_cell, &local_rhs_ext_cell }};
+
+    std::array<std::vector<real>, 2> soln_coeff;
+    std::array<std::vector<unsigned int>, 2> dof_state;
+    std::array<std::vector<real>, 2> shape_value;
+    std::array<std::vector<dealii::Tensor<1,dim,real>>, 2> shape_grad;
+    // Derivatives along each trial function of the normal fluxes and of the dissipative fluxes of both jumps.
+    std::array<std::vector<std::array<real,nstate>>, 2> face_flux_trial;
+    std::array<std::array<std::vector<std::array<dealii::Tensor<1,dim,real>,nstate>>, 2>, 2> jump_flux_trial;
+    for (int side=0; side<2; ++side) {
+        soln_coeff[side].resize(n_soln_dofs[side]);
+        dof_state[side].resize(n_soln_dofs[side]);
+        for (unsigned int idof = 0; idof < n_soln_dofs[side]; ++idof) {
+            soln_coeff[side][idof] = DGBase<dim,real>::solution((*soln_dof_indices[side])[idof]);
+            dof_state[side][idof] = fe_values[side]->get_fe().system_to_component_index(idof).first;
+        }
+        shape_value[side].resize(n_soln_dofs[side]);
+        shape_grad[side].resize(n_soln_dofs[side]);
+        face_flux_trial[side].resize(n_soln_dofs[side]);
+        jump_flux_trial[side][0].resize(n_soln_dofs[side]);
+        jump_flux_trial[side][1].resize(n_soln_dofs[side]);
+    }
+
+    // Jacobian blocks. local_dRdW[test_side][trial_side]
+    std::array<std::array<dealii::FullMatrix<real>, 2>, 2> local_dRdW;
+    for (int test_side=0; test_side<2; ++test_side) {
+        for (int trial_side=0; trial_side<2; ++trial_side) {
+            local_dRdW[test_side][trial_side].reinit(n_soln_dofs[test_side], n_soln_dofs[trial_side]);
+        }
+    }
+
+    for (unsigned int iquad=0; iquad<n_face_quad_pts; ++iquad) {
+
+        const dealii::Tensor<1,dim,adtype> normal_int = normals_int[iquad];
+        const dealii::Tensor<1,dim,adtype> normal_ext = -normal_int;
+
+        std::array<ADArray, 2> soln;
+        std::array<ADArrayTensor1, 2> soln_grad;
+        for (int side=0; side<2; ++side) {
+            std::array<real,nstate> soln_val;
+            std::array<dealii::Tensor<1,dim,real>,nstate> soln_grad_val;
+            for (int s=0; s<nstate; ++s) {
+                soln_val[s] = 0;
+                soln_grad_val[s] = 0;
+            }
+            for (unsigned int idof=0; idof<n_soln_dofs[side]; ++idof) {
+                const unsigned int istate = dof_state[side][idof];
+                shape_value[side][idof] = fe_values[side]->shape_value_component(idof, iquad, istate);
+                shape_grad[side][idof] = fe_values[side]->shape_grad_component(idof, iquad, istate);
+                soln_val[istate] += soln_coeff[side][idof] * shape_value[side][idof];
+                soln_grad_val[istate] += soln_coeff[side][idof] * shape_grad[side][idof];
+            }
+            const unsigned int offset = side*n_side_indep;
+            for (int s=0; s<nstate; ++s) {
+                soln[side][s] = soln_val[s];
+                soln[side][s].diff(offset + s, n_flux_indep);
+                for (int d=0; d<dim; ++d) {
+                    soln_grad[side][s][d] = soln_grad_val[s][d];
+                    soln_grad[side][s][d].diff(offset + nstate + s*dim + d, n_flux_indep);
+                }
+            }
+        }
+        const ADArray &soln_int = soln[0];
+        const ADArray &soln_ext = soln[1];
+
+        const ADArray conv_num_flux_dot_n = conv_num_flux_ad.evaluate_flux(soln_int, soln_ext, normal_int);
+        const ADArray diss_soln_num_flux = diss_num_flux_ad.evaluate_solution_flux(soln_int, soln_ext, normal_int);
+
+        ADArrayTensor1 diss_soln_jump_int, diss_soln_jump_ext;
+        for (int s=0; s<nstate; s++) {
+            for (int d=0; d<dim; d++) {
+                diss_soln_jump_int[s][d] = (diss_soln_num_flux[s] - soln_int[s]) * normal_int[d];
+                diss_soln_jump_ext[s][d] = (diss_soln_num_flux[s] - soln_ext[s]) * normal_ext[d];
+            }
+        }
+        std::array<ADArrayTensor1, 2> diss_flux_jump;
+        diss_flux_jump[0] = physics.dissipative_flux (soln_int, diss_soln_jump_int);
+        diss_flux_jump[1] = physics.dissipative_flux (soln_ext, diss_soln_jump_ext);
+
+        const ADArray diss_auxi_num_flux_dot_n = diss_num_flux_ad.evaluate_auxiliary_flux(
+            0.0, 0.0,
+            soln_int, soln_ext,
+            soln_grad[0], soln_grad[1],
+            normal_int, penalty);
+
+        // Normal flux leaving the interior cell. The exterior cell sees its negative.
+        ADArray face_flux;
+        for (int s=0; s<nstate; ++s) face_flux[s] = conv_num_flux_dot_n[s] + diss_auxi_num_flux_dot_n[s];
+
+        for (int trial_side=0; trial_side<2; ++trial_side) {
+            const unsigned int offset = trial_side*n_side_indep;
+            for (unsigned int jdof=0; jdof<n_soln_dofs[trial_side]; ++jdof) {
+                const unsigned int jstate = dof_state[trial_side][jdof];
+                const real phi = shape_value[trial_side][jdof];
+                const dealii::Tensor<1,dim,real> &grad_phi = shape_grad[trial_side][jdof];
+                for (int s=0; s<nstate; ++s) {
+                    face_flux_trial[trial_side][jdof][s] = trial_derivative<dim,nstate> (face_flux[s], offset, jstate, phi, grad_phi);
+                    for (int test_side=0; test_side<2; ++test_side) {
+                        for (int d=0; d<dim; ++d) {
+                            jump_flux_trial[trial_side][test_side][jdof][s][d] = trial_derivative<dim,nstate> (diss_flux_jump[test_side][s][d], offset, jstate, phi, grad_phi);
+                        }
+                    }
+                }
+            }
+        }
+
+        for (int test_side=0; test_side<2; ++test_side) {
+            const real normal_sign = (test_side == 0) ? 1.0 : -1.0;
+            for (unsigned int itest=0; itest<n_soln_dofs[test_side]; ++itest) {
+                const unsigned int istate = dof_state[test_side][itest];
+                const dealii::Tensor<1,dim,real> grad_test_JxW = shape_grad[test_side][itest] * JxW_int[iquad];
+                const real test_JxW = normal_sign * shape_value[test_side][itest] * JxW_int[iquad];
+
+                real rhs = - test_JxW * face_flux[istate].val();
+                for (int d=0; d<dim; ++d) rhs += grad_test_JxW[d] * diss_flux_jump[test_side][istate][d].val();
+                (*local_rhs[test_side])(itest) += rhs;
+
+                for (int trial_side=0; trial_side<2; ++trial_side) {
+                    dealii::FullMatrix<real> &block = local_dRdW[test_side][trial_side];
+                    for (unsigned int jdof=0; jdof<n_soln_dofs[trial_side]; ++jdof) {
+                        block(itest,jdof) += - test_JxW * face_flux_trial[trial_side][jdof][istate]
+                                             + grad_test_JxW * jump_flux_trial[trial_side][test_side][jdof][istate];
+                    }
+                }
+            }
+        }
+    }
+
+    for (int test_side=0; test_side<2; ++test_side) {
+        for (int trial_side=0; trial_side<2; ++trial_side) {
+            this->add_to_global_matrix(this->system_matrix, *soln_dof_indices[test_side], *soln_dof_indices[trial_side], local_dRdW[test_side][trial_side]);
+        }
     }
 }
 
@@ -518,6 +1301,21 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_derivatives(
     dealii::Vector<real> &local_rhs_cell,
     const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R)
 {
+    if (use_first_order_fad(compute_dRdW, compute_dRdX, compute_d2R)) {
+        if (this->all_parameters->use_flux_jacobians) {
+            if (can_use_static_fad(nstate*(dim+1))) {
+                assemble_boundary_term_flux_jacobians<StaticFadType> (
+                    boundary_id, fe_values_boundary, penalty, soln_dof_indices, local_rhs_cell,
+                    *pde_physics_static_fad, *conv_num_flux_static_fad, *diss_num_flux_static_fad);
+            } else {
+                assemble_boundary_term_flux_jacobians<FadType> (
+                    boundary_id, fe_values_boundary, penalty, soln_dof_indices, local_rhs_cell,
+                    *pde_physics, *conv_num_flux, *diss_num_flux);
+            }
+        }
+        return;
+    }
+
     using FadType = Sacado::Fad::DFad<real>;
     using FadFadType = Sacado::Fad::DFad<FadType>;
     using ADArray = std::array<FadFadType,nstate>;
@@ -599,7 +1397,9 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_derivatives(
 
     AssertDimension(i_derivative, n_total_indep);
 
-    std::vector<dealii::Tensor<2,dim,FadFadType>> metric_jacobian = evaluate_metric_jacobian (unit_quad_pts, coords_coeff, fe_metric);
+    // Without grid derivatives, the surface metric terms come from the FEValues.
+    std::vector<dealii::Tensor<2,dim,FadFadType>> metric_jacobian;
+    if (compute_metric_derivatives) metric_jacobian = evaluate_metric_jacobian (unit_quad_pts, coords_coeff, fe_metric);
     std::vector<FadFadType> jac_det(n_quad_pts);
     std::vector<FadFadType> surface_jac_det(n_quad_pts);
     std::vector<dealii::Tensor<2,dim,FadFadType>> jac_inv_tran(n_quad_pts);
@@ -776,7 +1576,7 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_derivatives(
                 const unsigned int i_dx = idof+w_start;
                 residual_derivatives[idof] = rhs.dx(i_dx).val();
             }
-            this->system_matrix.add(soln_dof_indices[itest], soln_dof_indices, residual_derivatives);
+            this->add_to_global_matrix(this->system_matrix, soln_dof_indices[itest], soln_dof_indices, residual_derivatives);
         }
         if (compute_dRdX) {
             std::vector<real> residual_derivatives(n_metric_dofs);
@@ -784,7 +1584,7 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_derivatives(
                 const unsigned int i_dx = idof+x_start;
                 residual_derivatives[idof] = rhs.dx(i_dx).val();
             }
-            this->dRdXv.add(soln_dof_indices[itest], metric_dof_indices, residual_derivatives);
+            this->add_to_global_matrix(this->dRdXv, soln_dof_indices[itest], metric_dof_indices, residual_derivatives);
         }
         if (compute_d2R) {
             const unsigned int global_residual_row = soln_dof_indices[itest];
@@ -806,13 +1606,13 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_derivatives(
                 const unsigned int j_dx = jdof+w_start;
                 dWidW[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdW.add(soln_dof_indices[idof], soln_dof_indices, dWidW);
+            this->add_to_global_matrix(this->d2RdWdW, soln_dof_indices[idof], soln_dof_indices, dWidW);
 
             for (unsigned int jdof=0; jdof<n_metric_dofs; ++jdof) {
                 const unsigned int j_dx = jdof+x_start;
                 dWidX[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdX.add(soln_dof_indices[idof], metric_dof_indices, dWidX);
+            this->add_to_global_matrix(this->d2RdWdX, soln_dof_indices[idof], metric_dof_indices, dWidX);
         }
         for (unsigned int idof=0; idof<n_metric_dofs; ++idof) {
 
@@ -823,7 +1623,7 @@ void DGWeak<dim,nstate,real>::assemble_boundary_term_derivatives(
                 const unsigned int j_dx = jdof+x_start;
                 dXidX[jdof] = dXi.dx(j_dx);
             }
-            this->d2RdXdX.add(metric_dof_indices[idof], metric_dof_indices, dXidX);
+            this->add_to_global_matrix(this->d2RdXdX, metric_dof_indices[idof], metric_dof_indices, dXidX);
         }
     }
 }
@@ -847,6 +1647,23 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
     dealii::Vector<real>          &local_rhs_ext_cell,
     const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R)
 {
+    if (use_first_order_fad(compute_dRdW, compute_dRdX, compute_d2R)) {
+        if (this->all_parameters->use_flux_jacobians) {
+            if (can_use_static_fad(2*nstate*(dim+1))) {
+                assemble_face_term_flux_jacobians<StaticFadType> (
+                    fe_values_int, fe_values_ext, penalty, soln_dof_indices_int, soln_dof_indices_ext,
+                    local_rhs_int_cell, local_rhs_ext_cell,
+                    *pde_physics_static_fad, *conv_num_flux_static_fad, *diss_num_flux_static_fad);
+            } else {
+                assemble_face_term_flux_jacobians<FadType> (
+                    fe_values_int, fe_values_ext, penalty, soln_dof_indices_int, soln_dof_indices_ext,
+                    local_rhs_int_cell, local_rhs_ext_cell,
+                    *pde_physics, *conv_num_flux, *diss_num_flux);
+            }
+        }
+        return;
+    }
+
     using FadType = Sacado::Fad::DFad<real>;
     using FadFadType = Sacado::Fad::DFad<FadType>;
     using ADArray = std::array<FadFadType,nstate>;
@@ -948,8 +1765,12 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
     AssertDimension(i_derivative, n_total_indep);
 
     // Use the metric Jacobian from the interior cell
-    std::vector<dealii::Tensor<2,dim,FadFadType>> metric_jac_int = evaluate_metric_jacobian (unit_quad_pts_int, coords_coeff_int, fe_metric);
-    std::vector<dealii::Tensor<2,dim,FadFadType>> metric_jac_ext = evaluate_metric_jacobian (unit_quad_pts_ext, coords_coeff_ext, fe_metric);
+    std::vector<dealii::Tensor<2,dim,FadFadType>> metric_jac_int, metric_jac_ext;
+    if (compute_metric_derivatives) {
+        metric_jac_int = evaluate_metric_jacobian (unit_quad_pts_int, coords_coeff_int, fe_metric);
+        metric_jac_ext = evaluate_metric_jacobian (unit_quad_pts_ext, coords_coeff_ext, fe_metric);
+    }
+
     std::vector<dealii::Tensor<2,dim,FadFadType>> jac_inv_tran_int(n_face_quad_pts);
     std::vector<dealii::Tensor<2,dim,FadFadType>> jac_inv_tran_ext(n_face_quad_pts);
 
@@ -1178,7 +1999,7 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                     const unsigned int i_dx = idof+w_int_start;
                     residual_derivatives[idof] = rhs.dx(i_dx).val();
                 }
-                this->system_matrix.add(soln_dof_indices_int[itest_int], soln_dof_indices_int, residual_derivatives);
+                this->add_to_global_matrix(this->system_matrix, soln_dof_indices_int[itest_int], soln_dof_indices_int, residual_derivatives);
 
                 // dR_int_dW_ext
                 residual_derivatives.resize(n_soln_dofs_ext);
@@ -1186,7 +2007,7 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                     const unsigned int i_dx = idof+w_ext_start;
                     residual_derivatives[idof] = rhs.dx(i_dx).val();
                 }
-                this->system_matrix.add(soln_dof_indices_int[itest_int], soln_dof_indices_ext, residual_derivatives);
+                this->add_to_global_matrix(this->system_matrix, soln_dof_indices_int[itest_int], soln_dof_indices_ext, residual_derivatives);
             }
             if (compute_dRdX) {
                 // dR_int_dX_int
@@ -1195,7 +2016,7 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                     const unsigned int i_dx = idof+x_int_start;
                     residual_derivatives[idof] = rhs.dx(i_dx).val();
                 }
-                this->dRdXv.add(soln_dof_indices_int[itest_int], metric_dof_indices_int, residual_derivatives);
+                this->add_to_global_matrix(this->dRdXv, soln_dof_indices_int[itest_int], metric_dof_indices_int, residual_derivatives);
 
                 // dR_int_dX_ext
                 // residual_derivatives.resize(n_metric_dofs);
@@ -1203,7 +2024,7 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                     const unsigned int i_dx = idof+x_ext_start;
                     residual_derivatives[idof] = rhs.dx(i_dx).val();
                 }
-                this->dRdXv.add(soln_dof_indices_int[itest_int], metric_dof_indices_ext, residual_derivatives);
+                this->add_to_global_matrix(this->dRdXv, soln_dof_indices_int[itest_int], metric_dof_indices_ext, residual_derivatives);
             }
             if (compute_d2R) {
                 const unsigned int global_residual_row = soln_dof_indices_int[itest_int];
@@ -1234,7 +2055,7 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                     const unsigned int i_dx = idof+w_int_start;
                     residual_derivatives[idof] = rhs.dx(i_dx).val();
                 }
-                this->system_matrix.add(soln_dof_indices_ext[itest_ext], soln_dof_indices_int, residual_derivatives);
+                this->add_to_global_matrix(this->system_matrix, soln_dof_indices_ext[itest_ext], soln_dof_indices_int, residual_derivatives);
 
                 // dR_ext_dW_ext
                 residual_derivatives.resize(n_soln_dofs_ext);
@@ -1242,7 +2063,7 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                     const unsigned int i_dx = idof+w_ext_start;
                     residual_derivatives[idof] = rhs.dx(i_dx).val();
                 }
-                this->system_matrix.add(soln_dof_indices_ext[itest_ext], soln_dof_indices_ext, residual_derivatives);
+                this->add_to_global_matrix(this->system_matrix, soln_dof_indices_ext[itest_ext], soln_dof_indices_ext, residual_derivatives);
             }
             if (compute_dRdX) {
                 // dR_ext_dX_int
@@ -1251,7 +2072,7 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                     const unsigned int i_dx = idof+x_int_start;
                     residual_derivatives[idof] = rhs.dx(i_dx).val();
                 }
-                this->dRdXv.add(soln_dof_indices_ext[itest_ext], metric_dof_indices_int, residual_derivatives);
+                this->add_to_global_matrix(this->dRdXv, soln_dof_indices_ext[itest_ext], metric_dof_indices_int, residual_derivatives);
 
                 // dR_ext_dX_ext
                 // residual_derivatives.resize(n_metric_dofs);
@@ -1259,7 +2080,7 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                     const unsigned int i_dx = idof+x_ext_start;
                     residual_derivatives[idof] = rhs.dx(i_dx).val();
                 }
-                this->dRdXv.add(soln_dof_indices_ext[itest_ext], metric_dof_indices_ext, residual_derivatives);
+                this->add_to_global_matrix(this->dRdXv, soln_dof_indices_ext[itest_ext], metric_dof_indices_ext, residual_derivatives);
             }
             if (compute_d2R) {
                 const unsigned int global_residual_row = soln_dof_indices_ext[itest_ext];
@@ -1285,28 +2106,28 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                 const unsigned int j_dx = jdof+w_int_start;
                 dWidWint[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdW.add(soln_dof_indices_int[idof], soln_dof_indices_int, dWidWint);
+            this->add_to_global_matrix(this->d2RdWdW, soln_dof_indices_int[idof], soln_dof_indices_int, dWidWint);
 
             // dWint_dWext
             for (unsigned int jdof=0; jdof<n_soln_dofs_ext; ++jdof) {
                 const unsigned int j_dx = jdof+w_ext_start;
                 dWidWext[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdW.add(soln_dof_indices_int[idof], soln_dof_indices_ext, dWidWext);
+            this->add_to_global_matrix(this->d2RdWdW, soln_dof_indices_int[idof], soln_dof_indices_ext, dWidWext);
 
             // dWint_dXint
             for (unsigned int jdof=0; jdof<n_metric_dofs; ++jdof) {
                 const unsigned int j_dx = jdof+x_int_start;
                 dWidX[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdX.add(soln_dof_indices_int[idof], metric_dof_indices_int, dWidX);
+            this->add_to_global_matrix(this->d2RdWdX, soln_dof_indices_int[idof], metric_dof_indices_int, dWidX);
 
             // dWint_dXext
             for (unsigned int jdof=0; jdof<n_metric_dofs; ++jdof) {
                 const unsigned int j_dx = jdof+x_ext_start;
                 dWidX[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdX.add(soln_dof_indices_int[idof], metric_dof_indices_ext, dWidX);
+            this->add_to_global_matrix(this->d2RdWdX, soln_dof_indices_int[idof], metric_dof_indices_ext, dWidX);
         }
         // dWext
         for (unsigned int idof=0; idof<n_soln_dofs_ext; ++idof) {
@@ -1319,28 +2140,28 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                 const unsigned int j_dx = jdof+w_int_start;
                 dWidWint[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdW.add(soln_dof_indices_ext[idof], soln_dof_indices_int, dWidWint);
+            this->add_to_global_matrix(this->d2RdWdW, soln_dof_indices_ext[idof], soln_dof_indices_int, dWidWint);
 
             // dWext_dWext
             for (unsigned int jdof=0; jdof<n_soln_dofs_ext; ++jdof) {
                 const unsigned int j_dx = jdof+w_ext_start;
                 dWidWext[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdW.add(soln_dof_indices_ext[idof], soln_dof_indices_ext, dWidWext);
+            this->add_to_global_matrix(this->d2RdWdW, soln_dof_indices_ext[idof], soln_dof_indices_ext, dWidWext);
 
             // dWext_dXint
             for (unsigned int jdof=0; jdof<n_metric_dofs; ++jdof) {
                 const unsigned int j_dx = jdof+x_int_start;
                 dWidX[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdX.add(soln_dof_indices_ext[idof], metric_dof_indices_int, dWidX);
+            this->add_to_global_matrix(this->d2RdWdX, soln_dof_indices_ext[idof], metric_dof_indices_int, dWidX);
 
             // dWext_dXext
             for (unsigned int jdof=0; jdof<n_metric_dofs; ++jdof) {
                 const unsigned int j_dx = jdof+x_ext_start;
                 dWidX[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdX.add(soln_dof_indices_ext[idof], metric_dof_indices_ext, dWidX);
+            this->add_to_global_matrix(this->d2RdWdX, soln_dof_indices_ext[idof], metric_dof_indices_ext, dWidX);
         }
 
         // dXint
@@ -1354,14 +2175,14 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                 const unsigned int j_dx = jdof+x_int_start;
                 dWidX[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdXdX.add(metric_dof_indices_int[idof], metric_dof_indices_int, dWidX);
+            this->add_to_global_matrix(this->d2RdXdX, metric_dof_indices_int[idof], metric_dof_indices_int, dWidX);
 
             // dXint_dXext
             for (unsigned int jdof=0; jdof<n_metric_dofs; ++jdof) {
                 const unsigned int j_dx = jdof+x_ext_start;
                 dWidX[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdXdX.add(metric_dof_indices_int[idof], metric_dof_indices_ext, dWidX);
+            this->add_to_global_matrix(this->d2RdXdX, metric_dof_indices_int[idof], metric_dof_indices_ext, dWidX);
         }
         // dXext
         for (unsigned int idof=0; idof<n_metric_dofs; ++idof) {
@@ -1374,14 +2195,14 @@ void DGWeak<dim,nstate,real>::assemble_face_term_derivatives(
                 const unsigned int j_dx = jdof+x_int_start;
                 dWidX[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdXdX.add(metric_dof_indices_ext[idof], metric_dof_indices_int, dWidX);
+            this->add_to_global_matrix(this->d2RdXdX, metric_dof_indices_ext[idof], metric_dof_indices_int, dWidX);
 
             // dXext_dXext
             for (unsigned int jdof=0; jdof<n_metric_dofs; ++jdof) {
                 const unsigned int j_dx = jdof+x_ext_start;
                 dWidX[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdXdX.add(metric_dof_indices_ext[idof], metric_dof_indices_ext, dWidX);
+            this->add_to_global_matrix(this->d2RdXdX, metric_dof_indices_ext[idof], metric_dof_indices_ext, dWidX);
         }
     }
 }
@@ -1397,6 +2218,17 @@ void DGWeak<dim,nstate,real>::assemble_volume_terms_derivatives(
     const dealii::FEValues<dim,dim> &/*fe_values_lagrange*/,
     const bool compute_dRdW, const bool compute_dRdX, const bool compute_d2R)
 {
+    if (use_first_order_fad(compute_dRdW, compute_dRdX, compute_d2R)) {
+        if (this->all_parameters->use_flux_jacobians) {
+            if (can_use_static_fad(nstate*(dim+1))) {
+                assemble_volume_terms_flux_jacobians<StaticFadType> (fe_values_vol, soln_dof_indices, local_rhs_cell, *pde_physics_static_fad);
+            } else {
+                assemble_volume_terms_flux_jacobians<FadType> (fe_values_vol, soln_dof_indices, local_rhs_cell, *pde_physics);
+            }
+        }
+        return;
+    }
+
     using FadType = Sacado::Fad::DFad<real>;
     using FadFadType = Sacado::Fad::DFad<FadType>;
     using ADArray = std::array<FadFadType,nstate>;
@@ -1466,7 +2298,9 @@ void DGWeak<dim,nstate,real>::assemble_volume_terms_derivatives(
 
     AssertDimension(i_derivative, n_total_indep);
 
-    std::vector<dealii::Tensor<2,dim,FadFadType>> metric_jacobian = evaluate_metric_jacobian ( points, coords_coeff, fe_metric);
+    // Without grid derivatives, the metric terms come from the FEValues.
+    std::vector<dealii::Tensor<2,dim,FadFadType>> metric_jacobian;
+    if (compute_metric_derivatives) metric_jacobian = evaluate_metric_jacobian ( points, coords_coeff, fe_metric);
     std::vector<FadFadType> jac_det(n_quad_pts);
     std::vector<dealii::Tensor<2,dim,FadFadType>> jac_inv_tran(n_quad_pts);
     for (unsigned int iquad=0; iquad<n_quad_pts; ++iquad) {
@@ -1610,7 +2444,7 @@ void DGWeak<dim,nstate,real>::assemble_volume_terms_derivatives(
                 const unsigned int i_dx = idof+w_start;
                 residual_derivatives[idof] = rhs.dx(i_dx).val();
             }
-            this->system_matrix.add(soln_dof_indices[itest], soln_dof_indices, residual_derivatives);
+            this->add_to_global_matrix(this->system_matrix, soln_dof_indices[itest], soln_dof_indices, residual_derivatives);
         }
         if (compute_dRdX) {
             std::vector<real> residual_derivatives(n_metric_dofs);
@@ -1618,7 +2452,7 @@ void DGWeak<dim,nstate,real>::assemble_volume_terms_derivatives(
                 const unsigned int i_dx = idof+x_start;
                 residual_derivatives[idof] = rhs.dx(i_dx).val();
             }
-            this->dRdXv.add(soln_dof_indices[itest], metric_dof_indices, residual_derivatives);
+            this->add_to_global_matrix(this->dRdXv, soln_dof_indices[itest], metric_dof_indices, residual_derivatives);
         }
         if (compute_d2R) {
             const unsigned int global_residual_row = soln_dof_indices[itest];
@@ -1645,13 +2479,13 @@ void DGWeak<dim,nstate,real>::assemble_volume_terms_derivatives(
                 const unsigned int j_dx = jdof+w_start;
                 dWidW[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdW.add(soln_dof_indices[idof], soln_dof_indices, dWidW);
+            this->add_to_global_matrix(this->d2RdWdW, soln_dof_indices[idof], soln_dof_indices, dWidW);
 
             for (unsigned int jdof=0; jdof<n_metric_dofs; ++jdof) {
                 const unsigned int j_dx = jdof+x_start;
                 dWidX[jdof] = dWi.dx(j_dx);
             }
-            this->d2RdWdX.add(soln_dof_indices[idof], metric_dof_indices, dWidX);
+            this->add_to_global_matrix(this->d2RdWdX, soln_dof_indices[idof], metric_dof_indices, dWidX);
         }
 
         for (unsigned int idof=0; idof<n_metric_dofs; ++idof) {
@@ -1663,7 +2497,7 @@ void DGWeak<dim,nstate,real>::assemble_volume_terms_derivatives(
                 const unsigned int j_dx = jdof+x_start;
                 dXidX[jdof] = dXi.dx(j_dx);
             }
-            this->d2RdXdX.add(metric_dof_indices[idof], metric_dof_indices, dXidX);
+            this->add_to_global_matrix(this->d2RdXdX, metric_dof_indices[idof], metric_dof_indices, dXidX);
         }
     }
 
@@ -1677,6 +2511,17 @@ void DGWeak<dim,nstate,real>::set_physics(
     conv_num_flux_double = NumericalFlux::NumericalFluxFactory<dim, nstate, real> ::create_convective_numerical_flux (DGBase<dim,real>::all_parameters->conv_num_flux_type, pde_physics_double);
     diss_num_flux_double = NumericalFlux::NumericalFluxFactory<dim, nstate, real> ::create_dissipative_numerical_flux (DGBase<dim,real>::all_parameters->diss_num_flux_type, pde_physics_double);
 
+    // The default DirectionalFadType physics does not match the new one.
+    pde_physics_directional = nullptr;
+}
+
+template <int dim, int nstate, typename real>
+void DGWeak<dim,nstate,real>::set_physics(
+    std::shared_ptr< Physics::PhysicsBase<dim, nstate, DirectionalFadType > >pde_physics_input)
+{
+    pde_physics_directional = pde_physics_input;
+    conv_num_flux_directional = NumericalFlux::NumericalFluxFactory<dim, nstate, DirectionalFadType> ::create_convective_numerical_flux (DGBase<dim,real>::all_parameters->conv_num_flux_type, pde_physics_directional);
+    diss_num_flux_directional = NumericalFlux::NumericalFluxFactory<dim, nstate, DirectionalFadType> ::create_dissipative_numerical_flux (DGBase<dim,real>::all_parameters->diss_num_flux_type, pde_physics_directional);
 }
 
 template <int dim, int nstate, typename real>
@@ -1686,6 +2531,9 @@ void DGWeak<dim,nstate,real>::set_physics(
     pde_physics = pde_physics_input;
     conv_num_flux = NumericalFlux::NumericalFluxFactory<dim, nstate, Sacado::Fad::DFad<real>> ::create_convective_numerical_flux (DGBase<dim,real>::all_parameters->conv_num_flux_type, pde_physics);
     diss_num_flux = NumericalFlux::NumericalFluxFactory<dim, nstate, Sacado::Fad::DFad<real>> ::create_dissipative_numerical_flux (DGBase<dim,real>::all_parameters->diss_num_flux_type, pde_physics);
+
+    // The default StaticFadType physics does not match the new one. Assemble dRdW with FadType.
+    pde_physics_static_fad = nullptr;
 }
 
 template <int dim, int nstate, typename real>
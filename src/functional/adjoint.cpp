@@ -1,13 +1,14 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <map>
 
-#include <Epetra_RowMatrixTransposer.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/dofs/dof_tools.h>
 
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
 #include <deal.II/lac/la_parallel_vector.h>
-#include <deal.II/distributed/solution_transfer.h>
 
 #include <deal.II/fe/fe_q.h>
 #include <deal.II/fe/fe_values.h>
@@ -18,6 +19,7 @@
 #include "parameters/all_parameters.h"
 
 #include "dg/dg.h"
+#include "dg/p_multigrid_preconditioner.h"
 #include "adjoint.h"
 #include "functional.h"
 #include "physics/physics.h"
@@ -36,19 +38,14 @@ Adjoint<dim, nstate, real>::Adjoint(
     functional(_functional),
     physics(_physics),
     triangulation(dg.triangulation),
-    solution_coarse(dg.solution),
     adjoint_state(AdjointEnum::coarse),
     mpi_communicator(MPI_COMM_WORLD),
-    pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(mpi_communicator)==0)
-{
-    // storing the original FE degree distribution
-    coarse_fe_index.reinit(dg.triangulation->n_active_cells());
-
-    // looping over the cells
-    for(auto cell = dg.dof_handler.begin_active(); cell != dg.dof_handler.end(); ++cell)
-        if(cell->is_locally_owned())
-            coarse_fe_index[cell->active_cell_index()] = cell->active_fe_index();
-}
+    pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(mpi_communicator)==0),
+    prolongated_solution_version(0),
+    copied_volume_nodes_version(0),
+    dual_weighted_residual_solution_version(0),
+    dual_weighted_residual_volume_nodes_version(0)
+{}
 
 // destructor
 template <int dim, int nstate, typename real>
@@ -59,37 +56,39 @@ void Adjoint<dim, nstate, real>::reinit()
 {
     // assuming that all pointers are still valid
     // reinitilizing all variables after triangulation in the constructor
-    solution_coarse = dg.solution;
+    if (adjoint_state == AdjointEnum::fine)
+        functional.dg = coarse_functional_dg;
     adjoint_state = AdjointEnum::coarse;
 
-    // storing the original FE degree distribution
-    coarse_fe_index.reinit(dg.triangulation->n_active_cells());
-
-    // looping over the cells
-    for(auto cell = dg.dof_handler.begin_active(); cell != dg.dof_handler.end(); ++cell)
-        if(cell->is_locally_owned())
-            coarse_fe_index[cell->active_cell_index()] = cell->active_fe_index();
-
     // for remaining, clearing the values
     dIdw_fine      = dealii::LinearAlgebra::distributed::Vector<real>();
     dIdw_coarse    = dealii::LinearAlgebra::distributed::Vector<real>();
     adjoint_fine   = dealii::LinearAlgebra::distributed::Vector<real>();
     adjoint_coarse = dealii::LinearAlgebra::distributed::Vector<real>();
 
-    dual_weighted_residual_fine = dealii::Vector<real>();
+    dual_weighted_residual_fine = dealii::LinearAlgebra::distributed::Vector<real>();
+    dual_weighted_residual_cells.clear();
+    dual_weighted_residual_solution_version = 0;
+
+    // the degrees of freedom changed with the grid
+    fine_dg.reset();
+    coarse_to_fine_prolongation.clear();
+    prolongated_solution_version = 0;
+    copied_volume_nodes_version = 0;
 }
 
 template <int dim, int nstate, typename real>
 void Adjoint<dim, nstate, real>::convert_to_state(AdjointEnum state)
 {   
+    // the fine_dg follows the DG, also if already in the fine state
+    if(state == AdjointEnum::fine)
+        coarse_to_fine();
+
     // checks if conversion is needed
     if(adjoint_state == state) 
         return;
 
     // then calls corresponding function for state conversions
-    if(adjoint_state == AdjointEnum::coarse && state == AdjointEnum::fine) 
-        coarse_to_fine();
-    
     if(adjoint_state == AdjointEnum::fine && state == AdjointEnum::coarse)
         fine_to_coarse();
 }
@@ -97,56 +96,97 @@ void Adjoint<dim, nstate, real>::convert_to_state(AdjointEnum state)
 template <int dim, int nstate, typename real>
 void Adjoint<dim, nstate, real>::coarse_to_fine()
 {
-    dealii::IndexSet locally_owned_dofs, locally_relevant_dofs;
-    locally_owned_dofs =  dg.dof_handler.locally_owned_dofs();
-    dealii::DoFTools::extract_locally_relevant_dofs(dg.dof_handler, locally_relevant_dofs);
-
-    // dealii::LinearAlgebra::distributed::Vector<double> solution_coarse(dg.solution);
-    solution_coarse.update_ghost_values();
-    
-    // Solution Transfer to fine grid
-    dealii::parallel::distributed::SolutionTransfer< 
-        dim, dealii::LinearAlgebra::distributed::Vector<double>, dealii::DoFHandler<dim> 
-        > solution_transfer(dg.dof_handler);
-    solution_transfer.prepare_for_coarsening_and_refinement(solution_coarse);
-
-    dg.high_order_grid.prepare_for_coarsening_and_refinement();
-    dg.triangulation->prepare_coarsening_and_refinement();
-
-    for (auto cell = dg.dof_handler.begin_active(); cell != dg.dof_handler.end(); ++cell)
-        if (cell->is_locally_owned()) 
-            cell->set_future_fe_index(cell->active_fe_index()+1);
+    if (!fine_dg) {
+        create_fine_dg();
+        build_coarse_to_fine_prolongation();
+    }
 
-    dg.triangulation->execute_coarsening_and_refinement();
-    dg.high_order_grid.execute_coarsening_and_refinement();
+    // same triangulation and grid degree, such that the volume_nodes have the same distribution
+    if (copied_volume_nodes_version != dg.high_order_grid.get_volume_nodes_version()) {
+        fine_dg->high_order_grid.set_volume_nodes(dg.high_order_grid.volume_nodes);
+        copied_volume_nodes_version = dg.high_order_grid.get_volume_nodes_version();
+    }
 
-    dg.allocate_system();
-    dg.solution.zero_out_ghosts();
-    solution_transfer.interpolate(dg.solution);
-    dg.solution.update_ghost_values();
+    // the coarse space is included in the fine one, such that the prolongation is exact
+    if (prolongated_solution_version != dg.get_solution_version()) {
+        coarse_to_fine_prolongation.vmult(fine_dg->modify_solution(), dg.solution);
+        fine_dg->solution.update_ghost_values();
+        prolongated_solution_version = dg.get_solution_version();
+    }
 
+    if (adjoint_state == AdjointEnum::coarse) {
+        coarse_functional_dg = functional.dg;
+        functional.dg = fine_dg;
+    }
     adjoint_state = AdjointEnum::fine;
 }
 
 template <int dim, int nstate, typename real>
 void Adjoint<dim, nstate, real>::fine_to_coarse()
 {
-    dg.high_order_grid.prepare_for_coarsening_and_refinement();
-    dg.triangulation->prepare_coarsening_and_refinement();
+    functional.dg = coarse_functional_dg;
+    coarse_functional_dg.reset();
 
-    for (auto cell = dg.dof_handler.begin_active(); cell != dg.dof_handler.end(); ++cell)
-        if (cell->is_locally_owned()) 
-            cell->set_future_fe_index(coarse_fe_index[cell->active_cell_index()]);
+    adjoint_state = AdjointEnum::coarse;
+}
 
-    dg.triangulation->execute_coarsening_and_refinement();
-    dg.high_order_grid.execute_coarsening_and_refinement();
+template <int dim, int nstate, typename real>
+void Adjoint<dim, nstate, real>::create_fine_dg()
+{
+    fine_dg = dg.create_discretization_copy();
 
-    dg.allocate_system();
-    dg.solution.zero_out_ghosts();
+    // same cells, such that neither the triangulation nor the high-order grid needs to be refined
+    auto coarse_cell = dg.dof_handler.begin_active();
+    for (auto cell = fine_dg->dof_handler.begin_active(); cell != fine_dg->dof_handler.end(); ++cell, ++coarse_cell) {
+        if (!cell->is_locally_owned()) continue;
+        cell->set_active_fe_index(coarse_cell->active_fe_index()+1);
+    }
 
-    dg.solution = solution_coarse;
+    fine_dg->allocate_system();
+    prolongated_solution_version = 0;
+    copied_volume_nodes_version = 0;
+    dual_weighted_residual_solution_version = 0;
+}
 
-    adjoint_state = AdjointEnum::coarse;
+template <int dim, int nstate, typename real>
+void Adjoint<dim, nstate, real>::build_coarse_to_fine_prolongation()
+{
+    // only couples the degrees of freedom of the same cell
+    dealii::DynamicSparsityPattern dsp(fine_dg->dof_handler.n_dofs(), dg.dof_handler.n_dofs(), fine_dg->locally_owned_dofs);
+    std::vector<dealii::types::global_dof_index> fine_dofs_indices;
+    std::vector<dealii::types::global_dof_index> coarse_dofs_indices;
+    auto coarse_cell = dg.dof_handler.begin_active();
+    for (auto cell = fine_dg->dof_handler.begin_active(); cell != fine_dg->dof_handler.end(); ++cell, ++coarse_cell) {
+        if (!cell->is_locally_owned()) continue;
+        fine_dofs_indices.resize(cell->get_fe().dofs_per_cell);
+        cell->get_dof_indices(fine_dofs_indices);
+        coarse_dofs_indices.resize(coarse_cell->get_fe().dofs_per_cell);
+        coarse_cell->get_dof_indices(coarse_dofs_indices);
+        for (const auto row : fine_dofs_indices) {
+            dsp.add_entries(row, coarse_dofs_indices.begin(), coarse_dofs_indices.end());
+        }
+    }
+    coarse_to_fine_prolongation.reinit(fine_dg->locally_owned_dofs, dg.locally_owned_dofs, dsp, mpi_communicator);
+
+    // the reference prolongation only depends on the pair of degrees
+    std::map<std::pair<unsigned int, unsigned int>, dealii::FullMatrix<double>> reference_prolongations;
+    coarse_cell = dg.dof_handler.begin_active();
+    for (auto cell = fine_dg->dof_handler.begin_active(); cell != fine_dg->dof_handler.end(); ++cell, ++coarse_cell) {
+        if (!cell->is_locally_owned()) continue;
+        const std::pair<unsigned int, unsigned int> fe_indices(cell->active_fe_index(), coarse_cell->active_fe_index());
+        auto reference = reference_prolongations.find(fe_indices);
+        if (reference == reference_prolongations.end()) {
+            reference = reference_prolongations.emplace(fe_indices,
+                PMultigridPreconditioner<dim,real>::reference_prolongation(
+                    dg.fe_collection[fe_indices.second], fine_dg->fe_collection[fe_indices.first])).first;
+        }
+        fine_dofs_indices.resize(cell->get_fe().dofs_per_cell);
+        cell->get_dof_indices(fine_dofs_indices);
+        coarse_dofs_indices.resize(coarse_cell->get_fe().dofs_per_cell);
+        coarse_cell->get_dof_indices(coarse_dofs_indices);
+        coarse_to_fine_prolongation.set(fine_dofs_indices, coarse_dofs_indices, reference->second);
+    }
+    coarse_to_fine_prolongation.compress(dealii::VectorOperation::insert);
 }
 
 template <int dim, int nstate, typename real>
@@ -161,20 +201,23 @@ dealii::LinearAlgebra::distributed::Vector<real> Adjoint<dim, nstate, real>::fin
     (void) functional_value;
     dIdw_fine = functional.dIdw;
 
-    adjoint_fine.reinit(dg.solution);
+    // warm start from the previous fine adjoint, or else from the prolongated coarse adjoint
+    if (adjoint_fine.locally_owned_elements() != fine_dg->locally_owned_dofs) {
+        adjoint_fine.reinit(fine_dg->solution);
+        if (adjoint_coarse.locally_owned_elements() == dg.locally_owned_dofs) {
+            coarse_to_fine_prolongation.vmult(adjoint_fine, adjoint_coarse);
+        }
+    }
     
-    dg.assemble_residual(true);
-    dg.system_matrix *= -1.0;
+    fine_dg->assemble_residual(true);
+    fine_dg->system_matrix *= -1.0;
+    fine_dg->mark_system_matrix_modified();
 
-    dealii::TrilinosWrappers::SparseMatrix system_matrix_transpose;
-    Epetra_CrsMatrix *system_matrix_transpose_tril;
+    solve_linear(fine_dg->get_system_matrix_transpose(), dIdw_fine, adjoint_fine, fine_dg->all_parameters->linear_solver_param);
+    // solve_linear(fine_dg->system_matrix, dIdw_fine, adjoint_fine, fine_dg->all_parameters->linear_solver_param);
 
-    Epetra_RowMatrixTransposer epmt(const_cast<Epetra_CrsMatrix *>(&dg.system_matrix.trilinos_matrix()));
-    epmt.CreateTranspose(false, system_matrix_transpose_tril);
-    system_matrix_transpose.reinit(*system_matrix_transpose_tril,true);
-    delete system_matrix_transpose_tril;
-    solve_linear(system_matrix_transpose, dIdw_fine, adjoint_fine, dg.all_parameters->linear_solver_param);
-    // solve_linear(dg.system_matrix, dIdw_fine, adjoint_fine, dg.all_parameters->linear_solver_param);
+    // the residual was assembled with the Jacobian, such that it is not re-evaluated for the error indicator
+    compute_dual_weighted_residual();
 
     return adjoint_fine;
 }
@@ -191,74 +234,120 @@ dealii::LinearAlgebra::distributed::Vector<real> Adjoint<dim, nstate, real>::coa
     (void) functional_value;
     dIdw_coarse = functional.dIdw;
 
-    adjoint_coarse.reinit(dg.solution);
+    // warm start from the previous coarse adjoint
+    if (adjoint_coarse.locally_owned_elements() != dg.locally_owned_dofs) {
+        adjoint_coarse.reinit(dg.solution);
+    }
 
     dg.assemble_residual(true);
     dg.system_matrix *= -1.0;
+    dg.mark_system_matrix_modified();
 
-    dealii::TrilinosWrappers::SparseMatrix system_matrix_transpose;
-    Epetra_CrsMatrix *system_matrix_transpose_tril;
-
-    Epetra_RowMatrixTransposer epmt(const_cast<Epetra_CrsMatrix *>(&dg.system_matrix.trilinos_matrix()));
-    epmt.CreateTranspose(false, system_matrix_transpose_tril);
-    system_matrix_transpose.reinit(*system_matrix_transpose_tril);
-    solve_linear(system_matrix_transpose, dIdw_coarse, adjoint_coarse, dg.all_parameters->linear_solver_param);
+    solve_linear(dg.get_system_matrix_transpose(), dIdw_coarse, adjoint_coarse, dg.all_parameters->linear_solver_param);
     // solve_linear(dg.system_matrix, dIdw_coarse, adjoint_coarse, dg.all_parameters->linear_solver_param);
 
     return adjoint_coarse;
 }
 
 template <int dim, int nstate, typename real>
-dealii::Vector<real> Adjoint<dim, nstate, real>::dual_weighted_residual()
+dealii::LinearAlgebra::distributed::Vector<real> Adjoint<dim, nstate, real>::dual_weighted_residual()
 {
     convert_to_state(AdjointEnum::fine);
 
-    // allocating 
-    dual_weighted_residual_fine.reinit(dg.triangulation->n_active_cells());
+    if (!dual_weighted_residual_is_current())
+        fine_grid_adjoint();
 
-    const unsigned int max_dofs_per_cell = dg.dof_handler.get_fe_collection().max_dofs_per_cell();
-    std::vector<dealii::types::global_dof_index> current_dofs_indices(max_dofs_per_cell);
+    return dual_weighted_residual_fine;
+}
 
-    // computing the error indicator cell-wise by taking the dot product over the DOFs with the residual vector
-    for(auto cell = dg.dof_handler.begin_active(); cell != dg.dof_handler.end(); ++cell){
-        if(!cell->is_locally_owned()) continue;
-        
-        const unsigned int fe_index_curr_cell = cell->active_fe_index();
-        const dealii::FESystem<dim,dim> &current_fe_ref = dg.fe_collection[fe_index_curr_cell];
-        const unsigned int n_dofs_curr_cell = current_fe_ref.n_dofs_per_cell();
+template <int dim, int nstate, typename real>
+void Adjoint<dim, nstate, real>::compute_dual_weighted_residual()
+{
+    using ActiveCellIterator = typename dealii::DoFHandler<dim>::active_cell_iterator;
+
+    // the locally owned cells are numbered contiguously after the ones of the lower ranks
+    std::vector<ActiveCellIterator> locally_owned_cells;
+    dual_weighted_residual_cells.clear();
+    for (auto cell = fine_dg->dof_handler.begin_active(); cell != fine_dg->dof_handler.end(); ++cell) {
+        if (!cell->is_locally_owned()) continue;
+        locally_owned_cells.push_back(cell);
+        dual_weighted_residual_cells.push_back(cell->active_cell_index());
+    }
+    const unsigned long long int n_locally_owned_cells = locally_owned_cells.size();
+    unsigned long long int first_cell = 0;
+    MPI_Exscan(&n_locally_owned_cells, &first_cell, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, mpi_communicator);
+    if (dealii::Utilities::MPI::this_mpi_process(mpi_communicator) == 0) first_cell = 0;
+    const unsigned long long int n_global_cells = dealii::Utilities::MPI::sum(n_locally_owned_cells, mpi_communicator);
+
+    dealii::IndexSet locally_owned_cell_entries(n_global_cells);
+    locally_owned_cell_entries.add_range(first_cell, first_cell + n_locally_owned_cells);
+    dual_weighted_residual_fine.reinit(locally_owned_cell_entries, mpi_communicator);
+
+    // the degrees of freedom of a locally owned cell are locally owned, and each cell writes its own entry
+    const unsigned int max_dofs_per_cell = fine_dg->dof_handler.get_fe_collection().max_dofs_per_cell();
+    const auto compute_cells = [&] (const unsigned int begin, const unsigned int end)
+    {
+        std::vector<dealii::types::global_dof_index> current_dofs_indices(max_dofs_per_cell);
+        for (unsigned int icell = begin; icell < end; ++icell) {
+            const ActiveCellIterator &cell = locally_owned_cells[icell];
+            const unsigned int n_dofs_curr_cell = cell->get_fe().n_dofs_per_cell();
+
+            current_dofs_indices.resize(n_dofs_curr_cell);
+            cell->get_dof_indices(current_dofs_indices);
+
+            real dwr_cell = 0;
+            for (unsigned int idof = 0; idof < n_dofs_curr_cell; ++idof) {
+                dwr_cell += std::abs(fine_dg->right_hand_side[current_dofs_indices[idof]]*adjoint_fine[current_dofs_indices[idof]]);
+            }
+            dual_weighted_residual_fine.local_element(icell) = dwr_cell;
+        }
+    };
+    const unsigned int grainsize = 64;
+    dealii::parallel::apply_to_subranges(0u, static_cast<unsigned int>(locally_owned_cells.size()), compute_cells, grainsize);
 
-        current_dofs_indices.resize(n_dofs_curr_cell);
-        cell->get_dof_indices(current_dofs_indices);
+    dual_weighted_residual_solution_version = fine_dg->get_solution_version();
+    dual_weighted_residual_volume_nodes_version = fine_dg->high_order_grid.get_volume_nodes_version();
+}
 
-        real dwr_cell = 0;
-        for(unsigned int idof = 0; idof < n_dofs_curr_cell; ++idof){
-            dwr_cell += std::abs(dg.right_hand_side[current_dofs_indices[idof]]*adjoint_fine[current_dofs_indices[idof]]);
-        }
+template <int dim, int nstate, typename real>
+bool Adjoint<dim, nstate, real>::dual_weighted_residual_is_current() const
+{
+    return fine_dg
+           && dual_weighted_residual_solution_version == fine_dg->get_solution_version()
+           && dual_weighted_residual_volume_nodes_version == fine_dg->high_order_grid.get_volume_nodes_version();
+}
 
-        dual_weighted_residual_fine[cell->active_cell_index()] = dwr_cell;
+template <int dim, int nstate, typename real>
+dealii::Vector<real> Adjoint<dim, nstate, real>::dual_weighted_residual_cell_data() const
+{
+    dealii::Vector<real> cell_data(dg.triangulation->n_active_cells());
+    for (unsigned int icell = 0; icell < dual_weighted_residual_cells.size(); ++icell) {
+        cell_data[dual_weighted_residual_cells[icell]] = dual_weighted_residual_fine.local_element(icell);
     }
-
-    return dual_weighted_residual_fine;
+    return cell_data;
 }
 
 template <int dim, int nstate, typename real>
 void Adjoint<dim,nstate,real>::output_results_vtk(const unsigned int cycle)
 {
+    // the degrees of freedom of the current state
+    const DGBase<dim,real> &state_dg = (adjoint_state == AdjointEnum::fine) ? *fine_dg : dg;
+
     dealii::DataOut<dim, dealii::DoFHandler<dim>> data_out;
-    data_out.attach_dof_handler(dg.dof_handler);
+    data_out.attach_dof_handler(state_dg.dof_handler);
 
-    const std::unique_ptr< dealii::DataPostprocessor<dim> > post_processor = Postprocess::PostprocessorFactory<dim>::create_Postprocessor(dg.all_parameters);
-    data_out.add_data_vector(dg.solution, *post_processor);
+    const std::unique_ptr< dealii::DataPostprocessor<dim> > post_processor = Postprocess::PostprocessorFactory<dim>::create_Postprocessor(state_dg.all_parameters);
+    data_out.add_data_vector(state_dg.solution, *post_processor);
 
-    dealii::Vector<float> subdomain(dg.triangulation->n_active_cells());
+    dealii::Vector<float> subdomain(state_dg.triangulation->n_active_cells());
     for (unsigned int i = 0; i < subdomain.size(); ++i) {
-        subdomain(i) = dg.triangulation->locally_owned_subdomain();
+        subdomain(i) = state_dg.triangulation->locally_owned_subdomain();
     }
     data_out.add_data_vector(subdomain, "subdomain", dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_cell_data);
 
     // Output the polynomial degree in each cell
     std::vector<unsigned int> active_fe_indices;
-    dg.dof_handler.get_active_fe_indices(active_fe_indices);
+    state_dg.dof_handler.get_active_fe_indices(active_fe_indices);
     dealii::Vector<double> active_fe_indices_dealiivector(active_fe_indices.begin(), active_fe_indices.end());
     dealii::Vector<double> cell_poly_degree = active_fe_indices_dealiivector;
 
@@ -270,7 +359,7 @@ void Adjoint<dim,nstate,real>::output_results_vtk(const unsigned int cycle)
         residual_names.push_back(varname);
     }
 
-    data_out.add_data_vector(dg.right_hand_side, residual_names, dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_dof_data);
+    data_out.add_data_vector(state_dg.right_hand_side, residual_names, dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_dof_data);
 
     // setting up the naming
     std::vector<std::string> dIdw_names;
@@ -286,11 +375,12 @@ void Adjoint<dim,nstate,real>::output_results_vtk(const unsigned int cycle)
     }
 
     // adding the data structures specific to this particular class, checking if currently fine or coarse
+    const dealii::Vector<real> dual_weighted_residual_cells_data = dual_weighted_residual_cell_data();
     if(adjoint_state == AdjointEnum::fine){
         data_out.add_data_vector(dIdw_fine, dIdw_names, dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_dof_data);
         data_out.add_data_vector(adjoint_fine, adjoint_names, dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_dof_data);
 
-        data_out.add_data_vector(dual_weighted_residual_fine, "DWR", dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_cell_data);
+        data_out.add_data_vector(dual_weighted_residual_cells_data, "DWR", dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_cell_data);
     }else if(adjoint_state == AdjointEnum::coarse){
         data_out.add_data_vector(dIdw_coarse, dIdw_names, dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_dof_data);
         data_out.add_data_vector(adjoint_coarse, adjoint_names, dealii::DataOut_DoFData<dealii::DoFHandler<dim>,dim>::DataVectorType::type_dof_data);
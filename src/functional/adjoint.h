@@ -6,6 +6,7 @@
 #include <iostream>
 
 #include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/trilinos_sparse_matrix.h>
 #include <deal.II/distributed/solution_transfer.h>
 
 #include <deal.II/fe/fe_q.h>
@@ -55,24 +56,43 @@ public:
     void convert_to_state(AdjointEnum state);
 
     /// project to a p-enriched solution
+    /** The solution of the DG is prolongated into the fine_dg by the cached coarse_to_fine_prolongation,
+     *  and the Functional evaluates the fine_dg. The fine_dg only follows the solution and volume_nodes
+     *  of the DG once they are modified.
+     */
     void coarse_to_fine();
     /// return to teh original solution and DOF distribution
+    /** The Functional evaluates the DG again, which kept its solution and degrees of freedom. */
     void fine_to_coarse();
 
     /// compute the fine grid adjoint
+    /** Starts from the previous fine adjoint, or else from the prolongated coarse adjoint.
+     *  Also computes the dual_weighted_residual_fine from the fine residual assembled with the Jacobian.
+     */
     dealii::LinearAlgebra::distributed::Vector<real> fine_grid_adjoint();
 
     /// compute the coarse grid adjoint
+    /** Starts from the previous coarse adjoint. */
     dealii::LinearAlgebra::distributed::Vector<real> coarse_grid_adjoint();
 
     /// compute the dual weighted residual
-    dealii::Vector<real> dual_weighted_residual();
+    /** Returns the indicator computed by the last fine_grid_adjoint(), which is only called
+     *  if the solution or the volume_nodes of the fine_dg changed since.
+     */
+    dealii::LinearAlgebra::distributed::Vector<real> dual_weighted_residual();
+
+    /// Dual weighted residual indexed by active_cell_index(), for GridRefinement and DataOut.
+    /** Only the entries of the locally owned cells are non-zero. */
+    dealii::Vector<real> dual_weighted_residual_cell_data() const;
 
     /// for outputs (copy mostly of the one in DGbase) - Leaving this out for now
     void output_results_vtk(const unsigned int cycle);
 
     /// DG class 
     DGBase<dim,real> &dg;
+    /// DG of the same type and physics with the fine degrees
+    /** Created and allocated on the first coarse_to_fine(), and kept until reinit(). */
+    std::shared_ptr<DGBase<dim,real>> fine_dg;
     /// Functional class
     Functional<dim, nstate, real> &functional;
     /// physics for calling the functional class 
@@ -80,8 +100,6 @@ public:
     
     /// fine grid triangulation
     const std::shared_ptr<Triangulation> triangulation;
-    /// original solution
-    dealii::LinearAlgebra::distributed::Vector<real> solution_coarse;
     /// functional derivative (fine grid)
     dealii::LinearAlgebra::distributed::Vector<real> dIdw_fine;
     /// functional derivative (coarse grid)
@@ -91,18 +109,48 @@ public:
     /// coarse grid adjoint
     dealii::LinearAlgebra::distributed::Vector<real> adjoint_coarse;
     /// dual weighted residual (always fine due to galerkin orthogonality)
-    dealii::Vector<real> dual_weighted_residual_fine;
-    
-    /// stores the original FE_index distribution
-    dealii::Vector<real> coarse_fe_index;
+    /** One entry per locally owned cell, numbered contiguously over the processors. */
+    dealii::LinearAlgebra::distributed::Vector<real> dual_weighted_residual_fine;
+
+    /// Cell-wise prolongation from the coarse to the fine degrees of freedom.
+    /** Built on the first coarse_to_fine() and kept until reinit(). */
+    dealii::TrilinosWrappers::SparseMatrix coarse_to_fine_prolongation;
 
     /// adjoint state for conversion tracking
     AdjointEnum adjoint_state;
 
 protected:
+    /// Creates the fine_dg with one degree more than the DG on every cell, and allocates its system.
+    void create_fine_dg();
+
+    /// Assembles the coarse_to_fine_prolongation from the degrees of freedom of the DG to the ones of the fine_dg.
+    void build_coarse_to_fine_prolongation();
+
+    /// Computes the dual_weighted_residual_fine from the current residual and fine adjoint.
+    /** The cells are distributed to the threads. */
+    void compute_dual_weighted_residual();
+
     MPI_Comm mpi_communicator; ///< MPI communicator
     dealii::ConditionalOStream pcout; ///< Parallel std::cout that only outputs on mpi_rank==0
 
+    /// DG evaluated by the Functional in the coarse state, restored by fine_to_coarse().
+    std::shared_ptr<DGBase<dim,real>> coarse_functional_dg;
+    /// DGBase::get_solution_version() of the DG when its solution was last prolongated into the fine_dg.
+    /** Zero, which is never a current version, until the fine_dg is created. */
+    unsigned int prolongated_solution_version;
+    /// HighOrderGrid::get_volume_nodes_version() of the DG when its volume_nodes were last copied to the fine_dg.
+    unsigned int copied_volume_nodes_version;
+
+    /// active_cell_index() of the cell of each local entry of the dual_weighted_residual_fine.
+    std::vector<unsigned int> dual_weighted_residual_cells;
+    /// Whether the dual_weighted_residual_fine was computed at the current fine_dg solution and volume_nodes.
+    bool dual_weighted_residual_is_current() const;
+    /// DGBase::get_solution_version() of the fine_dg at which the dual_weighted_residual_fine was computed.
+    /** Zero, which is never a current version, until it is computed for the current fine_dg. */
+    unsigned int dual_weighted_residual_solution_version;
+    /// HighOrderGrid::get_volume_nodes_version() at which the dual_weighted_residual_fine was computed.
+    unsigned int dual_weighted_residual_volume_nodes_version;
+
 }; // Adjoint class
 
 
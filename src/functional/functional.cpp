@@ -74,13 +74,13 @@ Functional<dim,nstate,real>::Functional(
 template <int dim, int nstate, typename real>
 void Functional<dim,nstate,real>::set_state(const dealii::LinearAlgebra::distributed::Vector<real> &solution_set)
 {
-    dg->solution = solution_set;
+    dg->set_solution(solution_set);
 }
 
 template <int dim, int nstate, typename real>
 void Functional<dim,nstate,real>::set_geom(const dealii::LinearAlgebra::distributed::Vector<real> &volume_nodes_set)
 {
-    dg->high_order_grid.volume_nodes = volume_nodes_set;
+    dg->high_order_grid.modify_volume_nodes() = volume_nodes_set;
 }
 
 template <int dim, int nstate, typename real>
@@ -287,86 +287,55 @@ Sacado::Fad::DFad<Sacado::Fad::DFad<real>> Functional<dim, nstate, real>::evalua
 template <int dim, int nstate, typename real>
 void Functional<dim, nstate, real>::need_compute(bool &compute_value, bool &compute_dIdW, bool &compute_dIdX, bool &compute_d2I)
 {
-    if (compute_value) {
-        pcout << " with value...";
+    // the cached vectors have another size if the Functional evaluated another DG since
+    const auto is_cached_state = [this] (
+        const dealii::LinearAlgebra::distributed::Vector<double> &solution_cached,
+        const dealii::LinearAlgebra::distributed::Vector<double> &volume_nodes_cached)
+    {
+        if (dg->solution.size() != solution_cached.size()) return false;
+        if (dg->high_order_grid.volume_nodes.size() != volume_nodes_cached.size()) return false;
 
         auto diff_sol = dg->solution;
-        diff_sol -= solution_value;
-        const double l2_norm_sol = diff_sol.l2_norm();
-
-        if (l2_norm_sol == 0.0) {
+        diff_sol -= solution_cached;
+        if (diff_sol.l2_norm() != 0.0) return false;
 
-            auto diff_node = dg->high_order_grid.volume_nodes;
-            diff_node -= volume_nodes_value;
-            const double l2_norm_node = diff_node.l2_norm();
+        auto diff_node = dg->high_order_grid.volume_nodes;
+        diff_node -= volume_nodes_cached;
+        return diff_node.l2_norm() == 0.0;
+    };
 
-            if (l2_norm_node == 0.0) {
-                pcout << " which is already assembled...";
-                compute_value = false;
-            }
+    if (compute_value) {
+        pcout << " with value...";
+        if (is_cached_state(solution_value, volume_nodes_value)) {
+            pcout << " which is already assembled...";
+            compute_value = false;
         }
         solution_value = dg->solution;
         volume_nodes_value = dg->high_order_grid.volume_nodes;
     }
     if (compute_dIdW) {
         pcout << " with dIdW...";
-
-        auto diff_sol = dg->solution;
-        diff_sol -= solution_dIdW;
-        const double l2_norm_sol = diff_sol.l2_norm();
-
-        if (l2_norm_sol == 0.0) {
-
-            auto diff_node = dg->high_order_grid.volume_nodes;
-            diff_node -= volume_nodes_dIdW;
-            const double l2_norm_node = diff_node.l2_norm();
-
-            if (l2_norm_node == 0.0) {
-                pcout << " which is already assembled...";
-                compute_dIdW = false;
-            }
+        if (is_cached_state(solution_dIdW, volume_nodes_dIdW)) {
+            pcout << " which is already assembled...";
+            compute_dIdW = false;
         }
         solution_dIdW = dg->solution;
         volume_nodes_dIdW = dg->high_order_grid.volume_nodes;
     }
     if (compute_dIdX) {
         pcout << " with dIdX...";
-
-        auto diff_sol = dg->solution;
-        diff_sol -= solution_dIdX;
-        const double l2_norm_sol = diff_sol.l2_norm();
-
-        if (l2_norm_sol == 0.0) {
-
-            auto diff_node = dg->high_order_grid.volume_nodes;
-            diff_node -= volume_nodes_dIdX;
-            const double l2_norm_node = diff_node.l2_norm();
-
-            if (l2_norm_node == 0.0) {
-                pcout << " which is already assembled...";
-                compute_dIdX = false;
-            }
+        if (is_cached_state(solution_dIdX, volume_nodes_dIdX)) {
+            pcout << " which is already assembled...";
+            compute_dIdX = false;
         }
         solution_dIdX = dg->solution;
         volume_nodes_dIdX = dg->high_order_grid.volume_nodes;
     }
     if (compute_d2I) {
         pcout << " with d2IdWdW, d2IdWdX, d2IdXdX...";
-        auto diff_sol = dg->solution;
-        diff_sol -= solution_d2I;
-        const double l2_norm_sol = diff_sol.l2_norm();
-
-        if (l2_norm_sol == 0.0) {
-
-            auto diff_node = dg->high_order_grid.volume_nodes;
-            diff_node -= volume_nodes_d2I;
-            const double l2_norm_node = diff_node.l2_norm();
-
-            if (l2_norm_node == 0.0) {
-
-                pcout << " which is already assembled...";
-                compute_d2I = false;
-            }
+        if (is_cached_state(solution_d2I, volume_nodes_d2I)) {
+            pcout << " which is already assembled...";
+            compute_d2I = false;
         }
         solution_d2I = dg->solution;
         volume_nodes_d2I = dg->high_order_grid.volume_nodes;
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <chrono>
+#include <map>
+
 #include <deal.II/base/conditional_ostream.h>
 
 #include <deal.II/lac/solver_control.h>
@@ -6,18 +10,31 @@
 
 #include <deal.II/lac/solver_gmres.h>
 
+#include <Amesos.h>
+#include <Ifpack.h>
+
 #include "linear_solver.h"
 
 #include "global_counter.hpp"
+#include "wall_clock.hpp"
 
 namespace PHiLiP {
 
+bool is_block_preconditioner (const Parameters::LinearSolverParam::PreconditionerEnum preconditioner_type)
+{
+    using PreconditionerEnum = Parameters::LinearSolverParam::PreconditionerEnum;
+    return preconditioner_type == PreconditionerEnum::block_jacobi
+           || preconditioner_type == PreconditionerEnum::ilu0
+           || preconditioner_type == PreconditionerEnum::block_gauss_seidel;
+}
+
 std::pair<unsigned int, double>
 solve_linear (
     const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
     dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
     dealii::LinearAlgebra::distributed::Vector<double> &solution,
-    const Parameters::LinearSolverParam &param)
+    const Parameters::LinearSolverParam &param,
+    const std::vector<std::vector<bool>> &constant_modes)
 {
 
     // if (pcout.is_active()) system_matrix.print(pcout.get_stream(), true);
@@ -57,10 +74,25 @@ solve_linear (
         solver.SetAztecOption(AZ_kspace, param.restart_number);
         solver.SetRHS(&b);
         solver.SetLHS(&x);
-        solver.SetAztecOption(AZ_precond, AZ_dom_decomp);
-        solver.SetAztecOption(AZ_subdomain_solve, AZ_ilut);
-        solver.SetAztecOption(AZ_overlap, 0);
-        solver.SetAztecOption(AZ_reorder, 1); // RCM re-ordering
+        // Must outlive the solve.
+        std::unique_ptr<Ifpack_Preconditioner> block_preconditioner;
+        std::unique_ptr<dealii::TrilinosWrappers::PreconditionAMG> amg_preconditioner;
+        if (is_block_preconditioner(param.preconditioner_type)) {
+            block_preconditioner = build_block_preconditioner (system_matrix, param.preconditioner_type);
+            solver.SetPrecOperator(block_preconditioner.get());
+        } else if (param.preconditioner_type == Parameters::LinearSolverParam::PreconditionerEnum::amg) {
+            amg_preconditioner = build_amg_preconditioner (system_matrix, param, constant_modes);
+            solver.SetPrecOperator(&(amg_preconditioner->trilinos_operator()));
+        } else {
+            if (param.preconditioner_type == Parameters::LinearSolverParam::PreconditionerEnum::p_multigrid) {
+                dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
+                pcout << " Warning: the p_multigrid preconditioner needs the DGBase. Using ILUT instead." << std::endl;
+            }
+            solver.SetAztecOption(AZ_precond, AZ_dom_decomp);
+            solver.SetAztecOption(AZ_subdomain_solve, AZ_ilut);
+            solver.SetAztecOption(AZ_overlap, 0);
+            solver.SetAztecOption(AZ_reorder, 1); // RCM re-ordering
+        }
   
         const double rhs_norm = right_hand_side.l2_norm();
         const double 
@@ -96,6 +128,440 @@ solve_linear (
     return {-1.0, -1.0};
 }
 
+std::unique_ptr<dealii::TrilinosWrappers::PreconditionAMG>
+build_amg_preconditioner (
+    const dealii::TrilinosWrappers::SparseMatrix &matrix,
+    const Parameters::LinearSolverParam &param,
+    const std::vector<std::vector<bool>> &constant_modes)
+{
+    dealii::TrilinosWrappers::PreconditionAMG::AdditionalData amg_data;
+    amg_data.elliptic = param.amg_elliptic;
+    amg_data.higher_order_elements = param.amg_higher_order_elements;
+    amg_data.n_cycles = param.amg_n_cycles;
+    amg_data.w_cycle = param.amg_w_cycle;
+    amg_data.aggregation_threshold = param.amg_aggregation_threshold;
+    // Sets the ML number of PDE equations.
+    amg_data.constant_modes = constant_modes;
+    amg_data.smoother_sweeps = param.amg_smoother_sweeps;
+    amg_data.smoother_overlap = 0;
+    // Only read by initialize().
+    amg_data.smoother_type = param.amg_smoother_type.c_str();
+    amg_data.output_details = (param.linear_solver_output == Parameters::OutputEnum::verbose);
+
+    std::unique_ptr<dealii::TrilinosWrappers::PreconditionAMG> preconditioner = std::make_unique<dealii::TrilinosWrappers::PreconditionAMG>();
+    preconditioner->initialize(matrix, amg_data);
+    return preconditioner;
+}
+
+template <int dim>
+std::vector<int>
+partition_into_cell_blocks (const dealii::DoFHandler<dim> &dof_handler)
+{
+    const dealii::IndexSet &locally_owned_dofs = dof_handler.locally_owned_dofs();
+    std::vector<int> row_blocks(locally_owned_dofs.n_elements());
+
+    int n_blocks = 0;
+    std::vector<dealii::types::global_dof_index> dofs_indices;
+    for (const auto &cell : dof_handler.active_cell_iterators()) {
+        if (!cell->is_locally_owned()) continue;
+        dofs_indices.resize(cell->get_fe().dofs_per_cell);
+        cell->get_dof_indices(dofs_indices);
+        for (const auto &dof_index : dofs_indices) {
+            row_blocks[locally_owned_dofs.index_within_set(dof_index)] = n_blocks;
+        }
+        ++n_blocks;
+    }
+    return row_blocks;
+}
+
+std::vector<int>
+partition_into_cell_blocks (const dealii::TrilinosWrappers::SparseMatrix &matrix)
+{
+    const Epetra_CrsGraph &graph = matrix.trilinos_matrix().Graph();
+    const int n_local_rows = graph.NumMyRows();
+
+    std::vector<int> row_blocks(n_local_rows);
+    std::map<std::vector<int>, int> pattern_blocks;
+    std::vector<int> pattern;
+    for (int row = 0; row < n_local_rows; ++row) {
+        int n_entries;
+        int *column_indices;
+        graph.ExtractMyRowView(row, n_entries, column_indices);
+        pattern.assign(column_indices, column_indices + n_entries);
+        std::sort(pattern.begin(), pattern.end());
+
+        const int new_block = pattern_blocks.size();
+        const auto inserted = pattern_blocks.emplace(pattern, new_block);
+        row_blocks[row] = inserted.first->second;
+    }
+    return row_blocks;
+}
+
+std::unique_ptr<Ifpack_Preconditioner>
+build_block_preconditioner (
+    const dealii::TrilinosWrappers::SparseMatrix &matrix,
+    const Parameters::LinearSolverParam::PreconditionerEnum preconditioner_type,
+    const std::vector<int> &cell_blocks,
+    const bool compute_factorization)
+{
+    using PreconditionerEnum = Parameters::LinearSolverParam::PreconditionerEnum;
+    Assert(is_block_preconditioner(preconditioner_type), dealii::ExcMessage("Not a block preconditioner."));
+
+    Ifpack Factory;
+    Teuchos::ParameterList List;
+    std::unique_ptr<Ifpack_Preconditioner> preconditioner;
+    // Only read by Initialize().
+    std::vector<int> row_blocks;
+    if (preconditioner_type == PreconditionerEnum::ilu0) {
+        // The dense cell blocks are already in the sparsity pattern, such that the ILU(0) of the
+        // scalar entries has the same fill as the ILU(0) of the blocks, but without pivoting within
+        // the blocks. No reordering, which would scatter the degrees of freedom of the cells.
+        const int OverlapLevel = 0;
+        preconditioner.reset(Factory.Create("ILU", const_cast<Epetra_CrsMatrix *>(&matrix.trilinos_matrix()), OverlapLevel));
+        List.set("fact: level-of-fill", 0);
+        List.set("schwarz: reordering type", "none");
+    } else {
+        // Each processor relaxes its own blocks.
+        preconditioner.reset(Factory.Create("block relaxation stand-alone", const_cast<Epetra_CrsMatrix *>(&matrix.trilinos_matrix())));
+        Assert(cell_blocks.empty() || static_cast<int>(cell_blocks.size()) == matrix.trilinos_matrix().NumMyRows(),
+               dealii::ExcMessage("The cell blocks do not match the locally owned rows of the matrix."));
+        row_blocks = cell_blocks.empty() ? partition_into_cell_blocks (matrix) : cell_blocks;
+        const int n_blocks = row_blocks.empty() ? 0 : *std::max_element(row_blocks.begin(), row_blocks.end()) + 1;
+        List.set("partitioner: type", "user");
+        List.set("partitioner: map", row_blocks.data());
+        List.set("partitioner: local parts", n_blocks);
+        List.set("partitioner: overlap", 0);
+        List.set("relaxation: type", (preconditioner_type == PreconditionerEnum::block_jacobi) ? "Jacobi" : "Gauss-Seidel");
+        List.set("relaxation: sweeps", 1);
+        List.set("relaxation: damping factor", 1.0);
+        List.set("relaxation: zero starting solution", true);
+    }
+    Assert(preconditioner != nullptr, dealii::ExcMessage("Ifpack could not create the block preconditioner."));
+
+    int ierr = preconditioner->SetParameters(List);
+    ierr += preconditioner->Initialize();
+    if (compute_factorization) ierr += preconditioner->Compute();
+    Assert(ierr == 0, dealii::ExcMessage("The block factorization failed."));
+    (void) ierr;
+
+    return preconditioner;
+}
+
+namespace {
+
+/// Computes the ILUT factorization of \p matrix with the "gmres options" of \p param.
+/** Same domain decomposition as the AztecOO ILUT of solve_linear(). The returned preconditioner
+ *  only refers to the maps of \p matrix, whose values may therefore change afterwards.
+ *  If \p compute_factorization is false, only the reordering and the symbolic factorization are done.
+ */
+std::unique_ptr<Ifpack_Preconditioner>
+build_ilut_preconditioner (
+    const dealii::TrilinosWrappers::SparseMatrix &matrix,
+    const Parameters::LinearSolverParam &param,
+    const bool compute_factorization)
+{
+    Ifpack Factory;
+    const std::string PrecType = "ILUT";
+    const int OverlapLevel = 0; // Same as AZ_overlap in solve_linear
+    std::unique_ptr<Ifpack_Preconditioner> preconditioner(
+        Factory.Create(PrecType, const_cast<Epetra_CrsMatrix *>(&matrix.trilinos_matrix()), OverlapLevel));
+    Assert(preconditioner != nullptr, dealii::ExcMessage("Ifpack could not create the ILUT preconditioner."));
+
+    // Ifpack's level of fill is a ratio of the number of nonzeros, as AZ_ilut_fill.
+    Teuchos::ParameterList List;
+    List.set("fact: ilut level-of-fill", std::max(1.0, static_cast<double>(param.ilut_fill)));
+    List.set("fact: drop tolerance", param.ilut_drop);
+    List.set("fact: absolute threshold", param.ilut_atol);
+    List.set("fact: relative threshold", param.ilut_rtol);
+    List.set("schwarz: reordering type", "rcm");
+
+    int ierr = preconditioner->SetParameters(List);
+    ierr += preconditioner->Initialize();
+    if (compute_factorization) ierr += preconditioner->Compute();
+    Assert(ierr == 0, dealii::ExcMessage("The ILUT factorization failed."));
+    (void) ierr;
+
+    return preconditioner;
+}
+
+/// Whether \p a and \p b lead to the same setup of the LinearSolver.
+bool same_setup_parameters (const Parameters::LinearSolverParam &a, const Parameters::LinearSolverParam &b)
+{
+    if (a.linear_solver_type != b.linear_solver_type) return false;
+    if (a.linear_solver_type == Parameters::LinearSolverParam::LinearSolverEnum::direct) return true;
+    return a.preconditioner_type == b.preconditioner_type
+           && a.ilut_fill == b.ilut_fill
+           && a.ilut_drop == b.ilut_drop
+           && a.ilut_rtol == b.ilut_rtol
+           && a.ilut_atol == b.ilut_atol
+           && a.amg_elliptic == b.amg_elliptic
+           && a.amg_higher_order_elements == b.amg_higher_order_elements
+           && a.amg_w_cycle == b.amg_w_cycle
+           && a.amg_n_cycles == b.amg_n_cycles
+           && a.amg_aggregation_threshold == b.amg_aggregation_threshold
+           && a.amg_smoother_sweeps == b.amg_smoother_sweeps
+           && a.amg_smoother_type == b.amg_smoother_type;
+}
+
+} // anonymous namespace
+
+LinearSolver::LinearSolver ()
+    : setup_matrix(nullptr)
+    , setup_n_nonzeros(0)
+    , setup_n_constant_modes(0)
+    , factorization_is_new(false)
+    , use_external_preconditioner(false)
+{}
+
+void LinearSolver::set_cell_blocks (const std::vector<int> &cell_blocks_input)
+{
+    clear();
+    cell_blocks = cell_blocks_input;
+}
+
+void LinearSolver::set_external_preconditioner (std::shared_ptr<ExternalPreconditioner> preconditioner)
+{
+    clear();
+    external_preconditioner = preconditioner;
+}
+
+void LinearSolver::clear ()
+{
+    // The solver refers to the problem.
+    direct_solver.reset();
+    direct_problem.reset();
+    ifpack_preconditioner.reset();
+    amg_preconditioner.reset();
+    use_external_preconditioner = false;
+    setup_matrix = nullptr;
+    setup_n_nonzeros = 0;
+    setup_n_constant_modes = 0;
+    factorization_is_new = false;
+}
+
+bool LinearSolver::setup_is_valid (
+    const dealii::TrilinosWrappers::SparseMatrix &matrix,
+    const Parameters::LinearSolverParam &param,
+    const std::vector<std::vector<bool>> &constant_modes) const
+{
+    return setup_matrix == &(matrix.trilinos_matrix())
+           && setup_n_nonzeros == matrix.trilinos_matrix().NumGlobalNonzeros()
+           && setup_n_constant_modes == constant_modes.size()
+           && same_setup_parameters(setup_param, param);
+}
+
+void LinearSolver::setup (
+    const dealii::TrilinosWrappers::SparseMatrix &matrix,
+    const Parameters::LinearSolverParam &param,
+    const std::vector<std::vector<bool>> &constant_modes)
+{
+    using PreconditionerEnum = Parameters::LinearSolverParam::PreconditionerEnum;
+    clear();
+    if (param.linear_solver_type == Parameters::LinearSolverParam::LinearSolverEnum::direct) {
+        direct_problem = std::make_unique<Epetra_LinearProblem>();
+        direct_problem->SetOperator(const_cast<Epetra_CrsMatrix *>(&matrix.trilinos_matrix()));
+        Amesos Factory;
+        direct_solver.reset(Factory.Create("Amesos_Klu", *direct_problem));
+        Assert(direct_solver != nullptr, dealii::ExcMessage("Amesos could not create the direct solver."));
+        const int ierr = direct_solver->SymbolicFactorization();
+        Assert(ierr == 0, dealii::ExcMessage("The symbolic factorization failed."));
+        (void) ierr;
+    } else if (is_block_preconditioner(param.preconditioner_type)) {
+        const bool compute_factorization = false;
+        ifpack_preconditioner = build_block_preconditioner (matrix, param.preconditioner_type, cell_blocks, compute_factorization);
+    } else if (param.preconditioner_type == PreconditionerEnum::amg) {
+        // The aggregates cannot be built without the values.
+        amg_preconditioner = build_amg_preconditioner (matrix, param, constant_modes);
+    } else if (param.preconditioner_type == PreconditionerEnum::p_multigrid && external_preconditioner) {
+        // Formed by factorize().
+        use_external_preconditioner = true;
+    } else {
+        if (param.preconditioner_type == PreconditionerEnum::p_multigrid) {
+            dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
+            pcout << " Warning: the p_multigrid preconditioner was not given to the LinearSolver. Using ILUT instead." << std::endl;
+        }
+        const bool compute_factorization = false;
+        ifpack_preconditioner = build_ilut_preconditioner (matrix, param, compute_factorization);
+    }
+    setup_matrix = &(matrix.trilinos_matrix());
+    setup_n_nonzeros = matrix.trilinos_matrix().NumGlobalNonzeros();
+    setup_param = param;
+    setup_n_constant_modes = constant_modes.size();
+    factorization_is_new = true;
+}
+
+void LinearSolver::factorize (const dealii::TrilinosWrappers::SparseMatrix &matrix)
+{
+    int ierr = 0;
+    if (direct_solver) {
+        ierr = direct_solver->NumericFactorization();
+    } else if (amg_preconditioner) {
+        // Keeps the aggregates and recomputes the multilevel hierarchy.
+        if (!factorization_is_new) amg_preconditioner->reinit();
+    } else if (use_external_preconditioner) {
+        external_preconditioner->initialize(matrix);
+    } else {
+        ierr = ifpack_preconditioner->Compute();
+    }
+    Assert(ierr == 0, dealii::ExcMessage("The numerical factorization failed."));
+    (void) ierr;
+    factorization_is_new = false;
+}
+
+void LinearSolver::prepare (
+    const dealii::TrilinosWrappers::SparseMatrix &matrix,
+    const Parameters::LinearSolverParam &param,
+    const std::vector<std::vector<bool>> &constant_modes,
+    const bool factorize_matrix)
+{
+    last = Statistics();
+    last.n_solves = 1;
+
+    auto start = std::chrono::steady_clock::now();
+    if (!setup_is_valid(matrix, param, constant_modes)) {
+        setup(matrix, param, constant_modes);
+        last.n_setups = 1;
+    }
+    last.setup_time = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    if (factorize_matrix || factorization_is_new) {
+        factorize(matrix);
+        last.n_factorizations = 1;
+    }
+    last.factorization_time = seconds_since(start);
+}
+
+void LinearSolver::iterate (
+    Epetra_Operator &system_operator,
+    dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+    const Parameters::LinearSolverParam &param)
+{
+    dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
+
+    Epetra_Vector x(View, system_operator.OperatorDomainMap(), solution.begin());
+    Epetra_Vector b(View, system_operator.OperatorRangeMap(), right_hand_side.begin());
+    AztecOO solver;
+    solver.SetAztecOption( AZ_output, (param.linear_solver_output ? AZ_all : AZ_none));
+    solver.SetAztecOption(AZ_solver, AZ_gmres);
+    solver.SetAztecOption(AZ_kspace, param.restart_number);
+    solver.SetRHS(&b);
+    solver.SetLHS(&x);
+    solver.SetUserOperator(&system_operator);
+    if (amg_preconditioner) {
+        solver.SetPrecOperator(&(amg_preconditioner->trilinos_operator()));
+    } else if (use_external_preconditioner) {
+        solver.SetPrecOperator(external_preconditioner.get());
+    } else {
+        solver.SetPrecOperator(ifpack_preconditioner.get());
+    }
+
+    const double linear_residual = param.linear_residual * right_hand_side.l2_norm();
+    pcout << " Solving linear system with max_iterations = " << param.max_iterations
+          << " and linear residual tolerance: " << linear_residual << std::endl;
+    solver.Iterate(param.max_iterations, linear_residual);
+
+    pcout << " Linear solver took " << solver.NumIters()
+          << " iterations resulting in a linear residual of " << solver.ScaledResidual() << std::endl
+          << " Current RHS norm: " << right_hand_side.l2_norm()
+          << " Linear solution norm: " << solution.l2_norm() << std::endl;
+
+    last.iterations = solver.NumIters();
+    last.residual = solver.TrueResidual();
+}
+
+void LinearSolver::record_statistics ()
+{
+    total.setup_time += last.setup_time;
+    total.factorization_time += last.factorization_time;
+    total.iteration_time += last.iteration_time;
+    total.iterations += last.iterations;
+    total.residual = last.residual;
+    total.n_solves += last.n_solves;
+    total.n_setups += last.n_setups;
+    total.n_factorizations += last.n_factorizations;
+}
+
+std::pair<unsigned int, double>
+LinearSolver::solve (
+    const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
+    dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+    const Parameters::LinearSolverParam &param,
+    const std::vector<std::vector<bool>> &constant_modes,
+    const bool factorize_matrix)
+{
+    prepare (system_matrix, param, constant_modes, factorize_matrix);
+
+    const auto start = std::chrono::steady_clock::now();
+    if (direct_solver) {
+        Epetra_Vector x(View, system_matrix.trilinos_matrix().DomainMap(), solution.begin());
+        Epetra_Vector b(View, system_matrix.trilinos_matrix().RangeMap(), right_hand_side.begin());
+        direct_problem->SetLHS(&x);
+        direct_problem->SetRHS(&b);
+        const int ierr = direct_solver->Solve();
+        Assert(ierr == 0, dealii::ExcMessage("The direct solve failed."));
+        (void) ierr;
+
+        dealii::LinearAlgebra::distributed::Vector<double> residual(right_hand_side);
+        system_matrix.vmult(residual, solution);
+        residual -= right_hand_side;
+        last.residual = residual.l2_norm();
+    } else {
+        iterate (const_cast<Epetra_CrsMatrix &>(system_matrix.trilinos_matrix()), right_hand_side, solution, param);
+
+        n_vmult += 3*last.iterations;
+        dRdW_mult += 3*last.iterations;
+    }
+    last.iteration_time = seconds_since(start);
+    record_statistics ();
+
+    return {last.iterations, last.residual};
+}
+
+std::pair<unsigned int, double>
+LinearSolver::solve (
+    Epetra_Operator &system_operator,
+    const dealii::TrilinosWrappers::SparseMatrix &preconditioner_matrix,
+    dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+    const Parameters::LinearSolverParam &param,
+    const std::vector<std::vector<bool>> &constant_modes,
+    const bool factorize_matrix)
+{
+    Parameters::LinearSolverParam gmres_param = param;
+    if (param.linear_solver_type == Parameters::LinearSolverParam::LinearSolverEnum::direct) {
+        dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
+        pcout << " Warning: the direct solver requires an assembled matrix. Using GMRES on the operator instead." << std::endl;
+        gmres_param.linear_solver_type = Parameters::LinearSolverParam::LinearSolverEnum::gmres;
+    }
+    prepare (preconditioner_matrix, gmres_param, constant_modes, factorize_matrix);
+
+    const auto start = std::chrono::steady_clock::now();
+    // The operator applications are counted by the operator itself.
+    iterate (system_operator, right_hand_side, solution, gmres_param);
+    last.iteration_time = seconds_since(start);
+    record_statistics ();
+
+    return {last.iterations, last.residual};
+}
+
+const LinearSolver::Statistics & LinearSolver::last_statistics () const
+{
+    return last;
+}
+
+const LinearSolver::Statistics & LinearSolver::total_statistics () const
+{
+    return total;
+}
+
+void LinearSolver::reset_statistics ()
+{
+    total = Statistics();
+}
+
 // std::pair<unsigned int, double>
 // solve_linear (
 //     const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
@@ -183,4 +649,6 @@ solve_linear_2(
     return {solver_control.last_step(), solver_control.last_value()};
 }
 
+template std::vector<int> partition_into_cell_blocks<PHILIP_DIM> (const dealii::DoFHandler<PHILIP_DIM> &dof_handler);
+
 } // PHiLiP namespace
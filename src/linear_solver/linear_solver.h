@@ -1,8 +1,19 @@
 #ifndef __LINEAR_SOLVER_H__
 #define __LINEAR_SOLVER_H__
 
+#include <memory>
+
+#include <deal.II/dofs/dof_handler.h>
+
 #include <deal.II/lac/trilinos_sparse_matrix.h>
+#include <deal.II/lac/trilinos_precondition.h>
 #include <deal.II/lac/la_parallel_vector.h>
+
+#include <Amesos_BaseSolver.h>
+#include <Epetra_LinearProblem.h>
+#include <Epetra_Operator.h>
+#include <Ifpack_Preconditioner.h>
+
 #include "parameters/all_parameters.h"
 
 namespace PHiLiP {
@@ -12,11 +23,221 @@ namespace PHiLiP {
     /// however, the Trilinos wrapper gives and error when trying to
     /// map it. This is probably because the Trilinos function 
     /// does not take right_hand_side as a const
+    /** The \p constant_modes are only used by the amg preconditioner, see build_amg_preconditioner().
+     */
     std::pair<unsigned int, double>
         solve_linear ( const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
                        dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
                        dealii::LinearAlgebra::distributed::Vector<double> &solution,
-                       const Parameters::LinearSolverParam &param);
+                       const Parameters::LinearSolverParam &param,
+                       const std::vector<std::vector<bool>> &constant_modes = std::vector<std::vector<bool>>());
+
+    /// Whether \p preconditioner_type is block_jacobi, ilu0, or block_gauss_seidel, which are built by build_block_preconditioner().
+    bool is_block_preconditioner (const Parameters::LinearSolverParam::PreconditionerEnum preconditioner_type);
+
+    /// Computes the block_jacobi, ilu0, or block_gauss_seidel preconditioner of \p matrix.
+    /** The block_jacobi and block_gauss_seidel blocks are factorized with dense LU. They are the
+     *  \p cell_blocks of the locally owned rows, see partition_into_cell_blocks(), or are found from
+     *  the sparsity pattern of \p matrix if \p cell_blocks is empty.
+     *
+     *  The ilu0 is the Ifpack ILU(0) of the scalar entries. Its fill is the sparsity of the cell blocks,
+     *  but the diagonal blocks are eliminated without pivoting, which differs from a block ILU(0)
+     *  that would invert them with dense LU.
+     *
+     *  The processors are coupled as in a block-Jacobi iteration, such that the Gauss-Seidel
+     *  and ILU(0) sweeps are local to each processor.
+     *
+     *  The preconditioner only refers to the maps of \p matrix, whose values may therefore change afterwards.
+     *  If \p compute_factorization is false, only the partition is done, and Compute() must be called
+     *  before applying the preconditioner.
+     */
+    std::unique_ptr<Ifpack_Preconditioner>
+        build_block_preconditioner ( const dealii::TrilinosWrappers::SparseMatrix &matrix,
+                                     const Parameters::LinearSolverParam::PreconditionerEnum preconditioner_type,
+                                     const std::vector<int> &cell_blocks = std::vector<int>(),
+                                     const bool compute_factorization = true);
+
+    /// Computes the ML algebraic multigrid of \p matrix with the amg_* options of \p param.
+    /** The \p constant_modes are the near-nullspace of the operator, one mode per component, as given by
+     *  dealii::DoFTools::extract_constant_modes(). ML then coarsens the components together, with a block
+     *  size equal to the number of modes. Empty for a scalar problem.
+     */
+    std::unique_ptr<dealii::TrilinosWrappers::PreconditionAMG>
+        build_amg_preconditioner ( const dealii::TrilinosWrappers::SparseMatrix &matrix,
+                                   const Parameters::LinearSolverParam &param,
+                                   const std::vector<std::vector<bool>> &constant_modes = std::vector<std::vector<bool>>());
+
+    /// Partitions the locally owned degrees of freedom of \p dof_handler into the dense blocks of their DG cells.
+    /** Returns the block of each locally owned degree of freedom, in the order of the locally owned rows of
+     *  the matrices distributed with dof_handler.locally_owned_dofs(). The blocks are numbered from 0 in
+     *  the order of the locally owned cells.
+     */
+    template <int dim>
+    std::vector<int> partition_into_cell_blocks ( const dealii::DoFHandler<dim> &dof_handler);
+
+    /// Partitions the locally owned rows of \p matrix into the dense blocks of the DG cells.
+    /** Fallback for the callers without the DoFHandler. The degrees of freedom of a cell couple with
+     *  the same cells, such that the rows of a cell have the same sparsity pattern, and rows are grouped
+     *  by sparsity pattern. Cells with the same neighbours on a processor are merged into one block,
+     *  such as the two cells of a periodic direction, or a 1D processor with two cells.
+     *  Returns the block of each locally owned row, numbered from 0.
+     */
+    std::vector<int> partition_into_cell_blocks ( const dealii::TrilinosWrappers::SparseMatrix &matrix);
+
+    /// Preconditioner formed outside of the LinearSolver from the matrix of the linear system.
+    /** Used for the preconditioner_type that the LinearSolver cannot build from the matrix alone,
+     *  such as the PMultigridPreconditioner which needs the DGBase.
+     */
+    class ExternalPreconditioner : public Epetra_Operator
+    {
+    public:
+        /// Forms the preconditioner from \p matrix, which must outlive it or the next initialize().
+        virtual void initialize (const dealii::TrilinosWrappers::SparseMatrix &matrix) = 0;
+    };
+
+    /// Linear solver that keeps its setup and its factorization between the solves.
+    /** solve_linear() reorders and factorizes the matrix at every call. Here, the reordering, the symbolic
+     *  factorization, the block partition, or the AMG aggregates are kept as long as the same matrix with
+     *  the same number of nonzeros is solved with the same parameters. The numerical factorization is
+     *  recomputed at every solve, unless the caller states that it can be kept, either because the matrix
+     *  values did not change, or to lag the preconditioner of GMRES behind the matrix.
+     *
+     *  The system is either given as a matrix, or as an operator with a matrix to build the preconditioner
+     *  from, such as the MatrixFreeJacobian and its lagged Jacobian. Both follow the same reuse.
+     *
+     *  Also records the cost of each solve, such that the ODE solvers and the optimization drivers can
+     *  read them instead of the global counters.
+     *
+     *  GMRES uses the preconditioner_type of the "gmres options", built with Ifpack instead of AztecOO.
+     *  The p_multigrid is given through set_external_preconditioner(). Without it, ILUT is used with a warning.
+     *  The direct solver is Amesos KLU.
+     */
+    class LinearSolver
+    {
+    public:
+        /// Constructor.
+        LinearSolver ();
+
+        /// Solves \p system_matrix \p solution = \p right_hand_side.
+        /** Same arguments as solve_linear(). The matrix must not be destroyed before the next solve
+         *  or clear(), since the setup refers to it.
+         *
+         *  If \p factorize_matrix is false, the factorization of the previous solve is kept. The direct
+         *  solver then solves with the previous matrix values, while GMRES iterates with the current ones.
+         *  A new setup is always factorized.
+         */
+        std::pair<unsigned int, double>
+            solve ( const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
+                    dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+                    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+                    const Parameters::LinearSolverParam &param,
+                    const std::vector<std::vector<bool>> &constant_modes = std::vector<std::vector<bool>>(),
+                    const bool factorize_matrix = true);
+
+        /// Solves \p system_operator \p solution = \p right_hand_side with GMRES.
+        /** Used with operators that are not stored as a matrix, such as the MatrixFreeJacobian.
+         *  The preconditioner_type is built from \p preconditioner_matrix, with the same setup and
+         *  \p factorize_matrix as the other solve(). The direct solver needs the operator entries
+         *  and is replaced by GMRES with a warning.
+         */
+        std::pair<unsigned int, double>
+            solve ( Epetra_Operator &system_operator,
+                    const dealii::TrilinosWrappers::SparseMatrix &preconditioner_matrix,
+                    dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+                    dealii::LinearAlgebra::distributed::Vector<double> &solution,
+                    const Parameters::LinearSolverParam &param,
+                    const std::vector<std::vector<bool>> &constant_modes = std::vector<std::vector<bool>>(),
+                    const bool factorize_matrix = true);
+
+        /// Uses the \p cell_blocks_input of partition_into_cell_blocks() for the block preconditioners.
+        /** Without them, the blocks are found from the sparsity pattern of the matrix. An empty vector
+         *  removes them. Discards the setup.
+         */
+        void set_cell_blocks (const std::vector<int> &cell_blocks_input);
+
+        /// Uses \p preconditioner for the p_multigrid preconditioner_type. A nullptr removes it.
+        /** Its initialize() takes the place of the numerical factorization. Discards the setup. */
+        void set_external_preconditioner (std::shared_ptr<ExternalPreconditioner> preconditioner);
+
+        /// Discards the setup, such that the next solve reorders and factorizes from scratch.
+        void clear ();
+
+        /// Cost of the linear solves.
+        struct Statistics
+        {
+            double setup_time = 0.0;         ///< Reordering, partition, or symbolic factorization.
+            double factorization_time = 0.0; ///< Numerical factorization.
+            double iteration_time = 0.0;     ///< Krylov iterations, or triangular solves of the direct solver.
+            unsigned int iterations = 0;     ///< Number of linear iterations.
+            double residual = 0.0;           ///< Achieved linear residual. The last one in the total_statistics.
+            unsigned int n_solves = 0;       ///< Number of solves.
+            unsigned int n_setups = 0;       ///< Number of solves that did not reuse the setup.
+            unsigned int n_factorizations = 0; ///< Number of solves that did not reuse the factorization.
+        };
+        /// Statistics of the last solve.
+        const Statistics & last_statistics () const;
+        /// Sum of the statistics since the construction or reset_statistics().
+        const Statistics & total_statistics () const;
+        /// Zeroes the total_statistics.
+        void reset_statistics ();
+
+    protected:
+        /// Whether the setup was done for \p matrix and \p param.
+        bool setup_is_valid (
+            const dealii::TrilinosWrappers::SparseMatrix &matrix,
+            const Parameters::LinearSolverParam &param,
+            const std::vector<std::vector<bool>> &constant_modes) const;
+        /// Reorders and partitions \p matrix, or computes its symbolic factorization or its AMG aggregates.
+        void setup (
+            const dealii::TrilinosWrappers::SparseMatrix &matrix,
+            const Parameters::LinearSolverParam &param,
+            const std::vector<std::vector<bool>> &constant_modes);
+        /// Computes the numerical factorization of the current values of \p matrix.
+        void factorize (const dealii::TrilinosWrappers::SparseMatrix &matrix);
+        /// Sets up and factorizes \p matrix as requested, and records their times in the last statistics.
+        void prepare (
+            const dealii::TrilinosWrappers::SparseMatrix &matrix,
+            const Parameters::LinearSolverParam &param,
+            const std::vector<std::vector<bool>> &constant_modes,
+            const bool factorize_matrix);
+        /// Iterates GMRES on \p system_operator with the current preconditioner.
+        void iterate (
+            Epetra_Operator &system_operator,
+            dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+            dealii::LinearAlgebra::distributed::Vector<double> &solution,
+            const Parameters::LinearSolverParam &param);
+        /// Adds the last statistics to the total ones.
+        void record_statistics ();
+
+        /// Matrix of the setup. Only compared to, never dereferenced.
+        const Epetra_CrsMatrix *setup_matrix;
+        /// Number of nonzeros of the setup_matrix, which detects a new matrix at the same address.
+        int setup_n_nonzeros;
+        /// Parameters of the setup.
+        Parameters::LinearSolverParam setup_param;
+        /// Number of constant modes of the setup.
+        unsigned int setup_n_constant_modes;
+        /// Whether the next factorize() is the first one since the setup.
+        bool factorization_is_new;
+
+        /// Block of each locally owned row, see set_cell_blocks().
+        std::vector<int> cell_blocks;
+        /// ILUT or block preconditioner of GMRES.
+        std::unique_ptr<Ifpack_Preconditioner> ifpack_preconditioner;
+        /// AMG preconditioner of GMRES.
+        std::unique_ptr<dealii::TrilinosWrappers::PreconditionAMG> amg_preconditioner;
+        /// Preconditioner of the p_multigrid preconditioner_type, see set_external_preconditioner().
+        std::shared_ptr<ExternalPreconditioner> external_preconditioner;
+        /// Whether the setup applies the external_preconditioner.
+        bool use_external_preconditioner;
+        /// Linear problem of the direct solver.
+        std::unique_ptr<Epetra_LinearProblem> direct_problem;
+        /// Direct solver.
+        std::unique_ptr<Amesos_BaseSolver> direct_solver;
+
+        Statistics last; ///< Statistics of the last solve.
+        Statistics total; ///< Sum of the statistics.
+    };
 
     std::pair<unsigned int, double>
     solve_linear_2 ( const dealii::TrilinosWrappers::SparseMatrix &system_matrix,
@@ -1,4 +1,5 @@
 #include <deal.II/base/utilities.h>
+#include <deal.II/base/multithread_info.h>
 
 #include <deal.II/base/logstream.h>
 #include <deal.II/base/parameter_handler.h>
@@ -59,6 +60,11 @@ int main (int argc, char *argv[])
 
         AssertDimension(all_parameters.dimension, PHILIP_DIM);
 
+        // MPI_InitFinalize above limits each process to a single thread.
+        if (all_parameters.assembly_threads > 1) {
+            dealii::MultithreadInfo::set_thread_limit(all_parameters.assembly_threads);
+        }
+
         const int max_dim = PHILIP_DIM;
         const int max_nstate = 5;
         std::unique_ptr<PHiLiP::Tests::TestsBase> test = PHiLiP::Tests::TestsFactory<max_dim,max_nstate>::create_test(&all_parameters);
@@ -339,18 +339,32 @@ template<int dim>
 void FreeFormDeformation<dim>
 ::deform_mesh (HighOrderGrid<dim,double,dealii::LinearAlgebra::distributed::Vector<double>,dealii::DoFHandler<dim>> &high_order_grid) const
 {
-    dealii::LinearAlgebra::distributed::Vector<double>  surface_node_displacements = get_surface_displacement (high_order_grid);
+    dealii::LinearAlgebra::distributed::Vector<double> surface_node_displacements(high_order_grid.surface_nodes);
 
-    MeshMover::LinearElasticity<dim, double, dealii::LinearAlgebra::distributed::Vector<double>, dealii::DoFHandler<dim>> 
+    MeshMoverType
         meshmover( 
           *(high_order_grid.triangulation),
           high_order_grid.initial_mapping_fe_field,
           high_order_grid.dof_handler_grid,
           high_order_grid.surface_to_volume_indices,
           surface_node_displacements);
+    deform_mesh (high_order_grid, meshmover, surface_node_displacements);
+}
+
+template<int dim>
+void FreeFormDeformation<dim>
+::deform_mesh (
+    HighOrderGrid<dim,double,dealii::LinearAlgebra::distributed::Vector<double>,dealii::DoFHandler<dim>> &high_order_grid,
+    MeshMoverType &meshmover,
+    dealii::LinearAlgebra::distributed::Vector<double> &surface_node_displacements) const
+{
+    // the meshmover refers to the surface_node_displacements
+    surface_node_displacements = get_surface_displacement (high_order_grid);
+    surface_node_displacements.update_ghost_values();
+
     dealii::LinearAlgebra::distributed::Vector<double> volume_displacements = meshmover.get_volume_displacements();
-    high_order_grid.volume_nodes = high_order_grid.initial_volume_nodes;
-    high_order_grid.volume_nodes += volume_displacements;
+    high_order_grid.modify_volume_nodes() = high_order_grid.initial_volume_nodes;
+    high_order_grid.modify_volume_nodes() += volume_displacements;
     high_order_grid.volume_nodes.update_ghost_values();
 }
 
@@ -504,23 +518,27 @@ FreeFormDeformation<dim>
     const dealii::IndexSet &row_part = high_order_grid.dof_handler_grid.locally_owned_dofs();
     const dealii::IndexSet col_part = dealii::Utilities::MPI::create_evenly_distributed_partitioning(MPI_COMM_WORLD,n_cols);
 
-    dealii::DynamicSparsityPattern full_dsp(n_rows, n_cols, row_part);
-    for (const auto &i_row: row_part) {
-        for (unsigned int i_col = 0; i_col < n_cols; ++i_col) {
-            full_dsp.add(i_row, i_col);
+    // Only the surface nodes along the axis of each design variable can move.
+    const dealii::IndexSet &nodes_locally_owned = high_order_grid.volume_nodes.get_partitioner()->locally_owned_range();
+    dealii::DynamicSparsityPattern surface_dsp(n_rows, n_cols, row_part);
+    for (unsigned int i_col = 0; i_col < n_cols; ++i_col) {
+        const unsigned int ctl_axis = ffd_design_variables_indices_dim[i_col].second;
+        for (unsigned int ipoint = 0; ipoint < high_order_grid.initial_locally_relevant_surface_points.size(); ++ipoint) {
+            const dealii::types::global_dof_index vol_index = high_order_grid.point_and_axis_to_global_index.at(std::make_pair(ipoint,ctl_axis));
+            if (nodes_locally_owned.is_element(vol_index)) {
+                surface_dsp.add(vol_index, i_col);
+            }
         }
     }
     dealii::IndexSet locally_relevant_dofs;
     dealii::DoFTools::extract_locally_relevant_dofs(high_order_grid.dof_handler_grid, locally_relevant_dofs);
-    dealii::SparsityTools::distribute_sparsity_pattern(full_dsp, row_part, MPI_COMM_WORLD, locally_relevant_dofs);
+    dealii::SparsityTools::distribute_sparsity_pattern(surface_dsp, row_part, MPI_COMM_WORLD, locally_relevant_dofs);
 
-    dealii::SparsityPattern full_sp;
-    full_sp.copy_from(full_dsp);
-
-    dXvsdXp.reinit(row_part, col_part, full_sp, MPI_COMM_WORLD);
+    dealii::SparsityPattern surface_sp;
+    surface_sp.copy_from(surface_dsp);
 
+    dXvsdXp.reinit(row_part, col_part, surface_sp, MPI_COMM_WORLD);
 
-    const dealii::IndexSet &nodes_locally_owned = high_order_grid.volume_nodes.get_partitioner()->locally_owned_range();
     for (unsigned int i_col = 0; i_col < ffd_design_variables_indices_dim.size(); ++i_col) {
 
         const auto ffd_pair = ffd_design_variables_indices_dim[i_col];
@@ -534,7 +552,7 @@ FreeFormDeformation<dim>
 
             for (int d=0; d<dim; ++d) { 
                 const dealii::types::global_dof_index vol_index = high_order_grid.point_and_axis_to_global_index.at(std::make_pair(ipoint,(unsigned int)d));
-                if (nodes_locally_owned.is_element(vol_index)) {
+                if ((unsigned int)d==ctl_axis && nodes_locally_owned.is_element(vol_index)) {
                     dXvsdXp.set(vol_index,i_col, dxsdxp[d]);
                 }
                 if ((unsigned int)d!=ctl_axis) {
@@ -573,6 +591,95 @@ FreeFormDeformation<dim>
     meshmover.apply_dXvdXvs(dXvsdXp_vector, dXvdXp);
 }
 
+template<int dim>
+dealii::LinearOperator<dealii::LinearAlgebra::distributed::Vector<double>>
+FreeFormDeformation<dim>
+::get_dXvdXp_operator (
+    const HighOrderGrid<dim,double,dealii::LinearAlgebra::distributed::Vector<double>,dealii::DoFHandler<dim>> &high_order_grid,
+    const std::vector< std::pair< unsigned int, unsigned int > > &ffd_design_variables_indices_dim
+    ) const
+{
+    using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+
+    // The mesh mover refers to the surface displacements, which are only used for the sizes.
+    struct OwnedMeshMover {
+        VectorType surface_node_displacements;
+        std::unique_ptr<MeshMoverType> meshmover;
+    };
+    const auto owned = std::make_shared<OwnedMeshMover>();
+    owned->surface_node_displacements.reinit(high_order_grid.surface_nodes);
+    owned->meshmover = std::make_unique<MeshMoverType>(
+          *(high_order_grid.triangulation),
+          high_order_grid.initial_mapping_fe_field,
+          high_order_grid.dof_handler_grid,
+          high_order_grid.surface_to_volume_indices,
+          owned->surface_node_displacements);
+
+    dealii::LinearOperator<VectorType> dXvdXp = get_dXvdXp_operator (high_order_grid, ffd_design_variables_indices_dim, *(owned->meshmover));
+
+    // The lambdas share the mesh mover, such that it lives as long as the operator does.
+    const auto vmult = dXvdXp.vmult;
+    const auto Tvmult = dXvdXp.Tvmult;
+    dXvdXp.vmult = [owned, vmult](VectorType &dst, const VectorType &src) { vmult(dst, src); };
+    dXvdXp.Tvmult = [owned, Tvmult](VectorType &dst, const VectorType &src) { Tvmult(dst, src); };
+
+    return dXvdXp;
+}
+
+template<int dim>
+dealii::LinearOperator<dealii::LinearAlgebra::distributed::Vector<double>>
+FreeFormDeformation<dim>
+::get_dXvdXp_operator (
+    const HighOrderGrid<dim,double,dealii::LinearAlgebra::distributed::Vector<double>,dealii::DoFHandler<dim>> &high_order_grid,
+    const std::vector< std::pair< unsigned int, unsigned int > > &ffd_design_variables_indices_dim,
+    MeshMoverType &meshmover
+    ) const
+{
+    using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+
+    // Objects referred to by the operator, shared by its lambdas such that they live as long as it does.
+    struct SensitivityChain {
+        dealii::TrilinosWrappers::SparseMatrix dXvsdXp;
+        dealii::LinearOperator<VectorType> dXvdXvs;
+    };
+    const auto chain = std::make_shared<SensitivityChain>();
+    get_dXvsdXp (high_order_grid, ffd_design_variables_indices_dim, chain->dXvsdXp);
+    chain->dXvdXvs = meshmover.get_dXvdXvs_operator();
+
+    const auto vmult = [chain](VectorType &dst, const VectorType &src) {
+        VectorType surface_displacements(dst);
+        chain->dXvsdXp.vmult(surface_displacements, src);
+        chain->dXvdXvs.vmult(dst, surface_displacements);
+    };
+    const auto Tvmult = [chain](VectorType &dst, const VectorType &src) {
+        VectorType volume_adjoint(src);
+        chain->dXvdXvs.Tvmult(volume_adjoint, src);
+        chain->dXvsdXp.Tvmult(dst, volume_adjoint);
+    };
+
+    dealii::LinearOperator<VectorType> dXvdXp;
+    dXvdXp.vmult = vmult;
+    dXvdXp.vmult_add = [vmult](VectorType &dst, const VectorType &src) {
+        VectorType product(dst);
+        vmult(product, src);
+        dst += product;
+    };
+    dXvdXp.Tvmult = Tvmult;
+    dXvdXp.Tvmult_add = [Tvmult](VectorType &dst, const VectorType &src) {
+        VectorType product(dst);
+        Tvmult(product, src);
+        dst += product;
+    };
+    const auto volume_partitioner = high_order_grid.volume_nodes.get_partitioner();
+    dXvdXp.reinit_range_vector = [volume_partitioner](VectorType &vector, const bool /*omit_zeroing_entries*/) {
+        vector.reinit(volume_partitioner);
+    };
+    dXvdXp.reinit_domain_vector = [chain](VectorType &vector, const bool /*omit_zeroing_entries*/) {
+        vector.reinit(chain->dXvsdXp.locally_owned_domain_indices(), chain->dXvsdXp.get_mpi_communicator());
+    };
+    return dXvdXp;
+}
+
 template<int dim>
 void
 FreeFormDeformation<dim>
@@ -631,7 +738,7 @@ FreeFormDeformation<dim>
 
         // Reset FFD
         control_pts[ictl] = old_ffd_point;
-        high_order_grid.volume_nodes = old_volume_nodes;
+        high_order_grid.modify_volume_nodes() = old_volume_nodes;
 
         // Perturb
         {
@@ -645,7 +752,7 @@ FreeFormDeformation<dim>
 
         // Reset FFD
         control_pts[ictl] = old_ffd_point;
-        high_order_grid.volume_nodes = old_volume_nodes;
+        high_order_grid.modify_volume_nodes() = old_volume_nodes;
 
         auto dXvdXp_i = nodes_p;
         dXvdXp_i -= nodes_m;
@@ -1,7 +1,10 @@
 #ifndef __FREE_FORM_DEFORMATION__
 #define __FREE_FORM_DEFORMATION__
 
+#include <deal.II/lac/linear_operator.h>
+
 #include "high_order_grid.h"
+#include "meshmover_linear_elasticity.hpp"
 
 namespace PHiLiP {
 
@@ -10,6 +13,9 @@ template<int dim>
 class FreeFormDeformation
 {
 public:
+    /// Linear elasticity used to deform the volume nodes from the surface displacements.
+    using MeshMoverType = MeshMover::LinearElasticity<dim, double, dealii::LinearAlgebra::distributed::Vector<double>, dealii::DoFHandler<dim>>;
+
     /// Constructor for an oblique parallepiped.
     FreeFormDeformation (
         const dealii::Point<dim> &_origin,
@@ -39,8 +45,18 @@ public:
     get_surface_displacement (const HighOrderGrid<dim,double,dealii::LinearAlgebra::distributed::Vector<double>,dealii::DoFHandler<dim>> &high_order_grid) const;
 
     /// Deform HighOrderGrid using its initial volume_nodes to retrieve the deformed set of volume_nodes.
+    /** Builds a new mesh mover on every call. */
     void deform_mesh (HighOrderGrid<dim,double,dealii::LinearAlgebra::distributed::Vector<double>,dealii::DoFHandler<dim>> &high_order_grid) const;
 
+    /// Deform HighOrderGrid with a \p meshmover kept by the caller between the deformations.
+    /** The \p meshmover is built on the initial grid of the \p high_order_grid and refers to the
+     *  \p surface_node_displacements, which are set to the current surface displacements before its
+     *  incremental solve.
+     */
+    void deform_mesh (HighOrderGrid<dim,double,dealii::LinearAlgebra::distributed::Vector<double>,dealii::DoFHandler<dim>> &high_order_grid,
+                      MeshMoverType &meshmover,
+                      dealii::LinearAlgebra::distributed::Vector<double> &surface_node_displacements) const;
+
     /// Given an initial point in the undeformed initial parallepiped and the index a control point,
     /// return the derivative dXdXp of the new point location point_i with respect to that control_point_j.
     dealii::Point<dim,double> dXdXp (const dealii::Point<dim,double> &initial_point, const unsigned int ctl_index, const unsigned int ctl_axis) const;
@@ -82,6 +98,23 @@ public:
                 const std::vector< std::pair< unsigned int, unsigned int > > ffd_design_variables_indices_dim,
                 dealii::TrilinosWrappers::SparseMatrix &dXvdXp
                 ) const;
+    /** Same derivatives as get_dXvdXp(), returned as the composition of the linear elasticity
+     *  dXvdXs with the sparse dXvsdXp instead of a matrix with dense columns.
+     *  Each vmult() is one elasticity solve and each Tvmult() one transposed elasticity solve.
+     *  The operator owns its mesh mover and dXvsdXp, but refers to the \p high_order_grid, which must outlive it.
+     */
+    dealii::LinearOperator<dealii::LinearAlgebra::distributed::Vector<double>>
+    get_dXvdXp_operator (const HighOrderGrid<dim,double,dealii::LinearAlgebra::distributed::Vector<double>,dealii::DoFHandler<dim>> &high_order_grid,
+                const std::vector< std::pair< unsigned int, unsigned int > > &ffd_design_variables_indices_dim
+                ) const;
+    /** Same as above, but the elasticity solves use the given \p meshmover, such that its matrix and
+     *  preconditioner are shared with the deform_mesh() calls. The \p meshmover must outlive the operator.
+     */
+    dealii::LinearOperator<dealii::LinearAlgebra::distributed::Vector<double>>
+    get_dXvdXp_operator (const HighOrderGrid<dim,double,dealii::LinearAlgebra::distributed::Vector<double>,dealii::DoFHandler<dim>> &high_order_grid,
+                const std::vector< std::pair< unsigned int, unsigned int > > &ffd_design_variables_indices_dim,
+                MeshMoverType &meshmover
+                ) const;
     /** For the given list of FFD indices and direction, return the analytical
      *  derivatives of the HighOrderGrid's initial volume points with respect to the FFD.
      */
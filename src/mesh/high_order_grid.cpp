@@ -50,6 +50,7 @@ HighOrderGrid<dim,real,VectorType,DoFHandlerType>::HighOrderGrid(
     : max_degree(max_degree)
     , triangulation(triangulation_input)
     , dof_handler_grid(*triangulation)
+    , volume_nodes(volume_nodes_vector)
     , fe_q(max_degree) // The grid must be at least p1. A p0 solution required a p1 grid.
     , fe_system(dealii::FESystem<dim>(fe_q,dim)) // The grid must be at least p1. A p0 solution required a p1 grid.
     , solution_transfer(dof_handler_grid)
@@ -62,7 +63,7 @@ HighOrderGrid<dim,real,VectorType,DoFHandlerType>::HighOrderGrid(
     Assert(max_degree > 0, dealii::ExcMessage("Grid must be at least order 1."));
     allocate();
     const dealii::ComponentMask mask(dim, true);
-    get_position_vector(dof_handler_grid, volume_nodes, mask);
+    get_position_vector(dof_handler_grid, modify_volume_nodes(), mask);
     volume_nodes.update_ghost_values();
     update_surface_nodes();
     update_mapping_fe_field();
@@ -92,6 +93,21 @@ HighOrderGrid<dim,real,VectorType,DoFHandlerType>::HighOrderGrid(
     }
 }
 
+template <int dim, typename real, typename VectorType , typename DoFHandlerType>
+void HighOrderGrid<dim,real,VectorType,DoFHandlerType>::set_volume_nodes (const Vector &volume_nodes_input)
+{
+    modify_volume_nodes() = volume_nodes_input;
+    volume_nodes.update_ghost_values();
+}
+
+template <int dim, typename real, typename VectorType , typename DoFHandlerType>
+typename HighOrderGrid<dim,real,VectorType,DoFHandlerType>::Vector &
+HighOrderGrid<dim,real,VectorType,DoFHandlerType>::modify_volume_nodes ()
+{
+    ++volume_nodes_version;
+    return volume_nodes_vector;
+}
+
 template <int dim, typename real, typename VectorType , typename DoFHandlerType>
 void HighOrderGrid<dim,real,VectorType,DoFHandlerType>::update_mapping_fe_field() {
     const dealii::ComponentMask mask(dim, true);
@@ -112,7 +128,7 @@ HighOrderGrid<dim,real,VectorType,DoFHandlerType>::allocate()
     dealii::DoFTools::extract_locally_relevant_dofs(dof_handler_grid, locally_relevant_dofs_grid);
     ghost_dofs_grid = locally_relevant_dofs_grid;
     ghost_dofs_grid.subtract_set(locally_owned_dofs_grid);
-    volume_nodes.reinit(locally_owned_dofs_grid, ghost_dofs_grid, mpi_communicator);
+    modify_volume_nodes().reinit(locally_owned_dofs_grid, ghost_dofs_grid, mpi_communicator);
 }
 
 //template <int dim, typename real, typename VectorType , typename DoFHandlerType>
@@ -759,9 +775,9 @@ template <int dim, typename real, typename VectorType , typename DoFHandlerType>
 void HighOrderGrid<dim,real,VectorType,DoFHandlerType>::execute_coarsening_and_refinement(const bool output_mesh) {
     allocate();
     if constexpr(PHILIP_DIM==1) {
-        solution_transfer.interpolate(old_volume_nodes, volume_nodes);
+        solution_transfer.interpolate(old_volume_nodes, modify_volume_nodes());
     } else {
-        solution_transfer.interpolate(volume_nodes);
+        solution_transfer.interpolate(modify_volume_nodes());
     }
     volume_nodes.update_ghost_values();
 
@@ -769,7 +785,7 @@ void HighOrderGrid<dim,real,VectorType,DoFHandlerType>::execute_coarsening_and_r
     hanging_node_constraints.clear();
     dealii::DoFTools::make_hanging_node_constraints(dof_handler_grid, hanging_node_constraints);
     hanging_node_constraints.close();
-    hanging_node_constraints.distribute(volume_nodes);
+    hanging_node_constraints.distribute(modify_volume_nodes());
 
     volume_nodes.update_ghost_values();
 
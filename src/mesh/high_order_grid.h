@@ -96,8 +96,29 @@ public:
      *  the y-direction, which follows the one representing the x-direction such that
      *  the integer division "idof_index / dim" gives the coordinates related to the same
      *  point.
+     *
+     *  Read-only, such that every modification goes through set_volume_nodes() or modify_volume_nodes(),
+     *  which increment the volume_nodes_version.
      */
-    Vector volume_nodes;
+    const Vector &volume_nodes;
+
+    /// Assigns the volume_nodes, updates their ghost values, and increments the volume_nodes_version.
+    void set_volume_nodes (const Vector &volume_nodes_input);
+    /// Write access to the volume_nodes, which increments the volume_nodes_version.
+    /** The version is incremented when the reference is returned. Each modification should therefore
+     *  call it again rather than keep the reference across an assembly that reads the volume_nodes.
+     */
+    Vector &modify_volume_nodes ();
+    /// Version of the volume_nodes, incremented whenever they are modified.
+    /** DGBase compares it to the version at which it assembled the residual, its derivatives, and its geometry.
+     */
+    unsigned int get_volume_nodes_version () const { return volume_nodes_version; }
+private:
+    /// Storage of the volume_nodes.
+    Vector volume_nodes_vector;
+    /// Incremented by set_volume_nodes() and modify_volume_nodes().
+    unsigned int volume_nodes_version = 1;
+public:
 
 
     /** Distributed ghosted vector of surface nodes.
@@ -15,6 +15,14 @@
 
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 
+#include <deal.II/fe/fe_values.h>
+
+#include <Amesos.h>
+#include <Epetra_LinearProblem.h>
+#include <Epetra_MultiVector.h>
+#include <ml_MultiLevelPreconditioner.h>
+#include <Teuchos_ParameterList.hpp>
+
 #include "meshmover_linear_elasticity.hpp"
 
 namespace PHiLiP {
@@ -57,7 +65,9 @@ namespace MeshMover {
         const DoFHandlerType &_dof_handler,
         const dealii::LinearAlgebra::distributed::Vector<int> &_boundary_ids_vector,
         const dealii::LinearAlgebra::distributed::Vector<double> &_boundary_displacements_vector)
-      : triangulation(_triangulation)
+      : factorize_for_multiple_rhs(true)
+      , rhs_block_size(32)
+      , triangulation(_triangulation)
       , mapping_fe_field(mapping_fe_field)
       , dof_handler(_dof_handler)
       , quadrature_formula(dof_handler.get_fe().degree + 1)
@@ -67,9 +77,20 @@ namespace MeshMover {
       , pcout(std::cout, this_mpi_process == 0)
       , boundary_ids_vector(_boundary_ids_vector)
       , boundary_displacements_vector(_boundary_displacements_vector)
+      , system_is_assembled(false)
     { 
         AssertDimension(boundary_displacements_vector.size(), boundary_ids_vector.size());
 
+        dealii::ParameterHandler parameter_handler;
+        Parameters::LinearSolverParam::declare_parameters (parameter_handler);
+        linear_solver_param.parse_parameters (parameter_handler);
+        // The elasticity operator is symmetric positive definite.
+        linear_solver_param.preconditioner_type = Parameters::LinearSolverParam::PreconditionerEnum::amg;
+        linear_solver_param.amg_elliptic = true;
+        built_preconditioner_type = linear_solver_param.preconditioner_type;
+        // Amesos KLU is serial. The distributed solves use GMRES with the algebraic multigrid instead.
+        factorize_for_multiple_rhs = (n_mpi_processes == 1);
+
         boundary_displacements_vector.update_ghost_values();
         setup_system();
     }
@@ -182,6 +203,10 @@ namespace MeshMover {
     template <int dim, typename real, typename VectorType , typename DoFHandlerType>
     void LinearElasticity<dim,real,VectorType,DoFHandlerType>::assemble_system()
     {
+        if (system_is_assembled) {
+            assemble_rhs();
+            return;
+        }
         pcout << "    Assembling MeshMover::LinearElasticity system..." << std::endl;
 
         setup_system();
@@ -331,12 +356,174 @@ namespace MeshMover {
         system_rhs.compress(dealii::VectorOperation::insert);
         system_matrix_unconstrained.compress(dealii::VectorOperation::insert);
         system_rhs_unconstrained.compress(dealii::VectorOperation::insert);
+
+        system_is_assembled = true;
+        preconditioner.reset();
+        // The solver refers to the problem.
+        direct_solver.reset();
+        direct_problem.reset();
     }
+
+    template <int dim, typename real, typename VectorType , typename DoFHandlerType>
+    void LinearElasticity<dim,real,VectorType,DoFHandlerType>::assemble_rhs()
+    {
+        // Without body forces, only the Dirichlet rows are non-zero.
+        system_rhs = 0;
+        const auto &partitionner = boundary_ids_vector.get_partitioner();
+        for (unsigned int isurf = 0; isurf < boundary_ids_vector.size(); ++isurf) {
+            const bool is_accessible = partitionner->in_local_range(isurf) || partitionner->is_ghost_entry(isurf);
+            if (is_accessible) {
+                const unsigned int iglobal_row = boundary_ids_vector[isurf];
+                system_rhs[iglobal_row] = boundary_displacements_vector[isurf];
+            }
+        }
+        system_rhs.compress(dealii::VectorOperation::insert);
+    }
+    template <int dim, typename real, typename VectorType , typename DoFHandlerType>
+    void LinearElasticity<dim,real,VectorType,DoFHandlerType>::compute_rigid_body_modes()
+    {
+        // dim translations, and the rotations in the planes (0,1), (1,2), (2,0).
+        const unsigned int n_rotations = (dim == 1) ? 0 : ((dim == 2) ? 1 : 3);
+        const unsigned int n_modes = dim + n_rotations;
+        const Epetra_Map &row_map = system_matrix.trilinos_matrix().RowMap();
+        const unsigned int n_local_rows = row_map.NumMyElements();
+        rigid_body_modes.assign(n_modes * n_local_rows, 0.0);
+
+        const dealii::FiniteElement<dim> &fe = dof_handler.get_fe();
+        const dealii::Quadrature<dim> support_quadrature(fe.get_unit_support_points());
+        dealii::FEValues<dim> fe_values(*mapping_fe_field, fe, support_quadrature, dealii::update_quadrature_points);
+        std::vector<dealii::types::global_dof_index> dof_indices(fe.dofs_per_cell);
+        for (const auto &cell : dof_handler.active_cell_iterators()) {
+            if (!cell->is_locally_owned()) continue;
+            fe_values.reinit(cell);
+            cell->get_dof_indices(dof_indices);
+            for (unsigned int idof = 0; idof < fe.dofs_per_cell; ++idof) {
+                const int local_row = row_map.LID(static_cast<dealii::TrilinosWrappers::types::int_type>(dof_indices[idof]));
+                if (local_row < 0) continue;
+                const unsigned int component = fe.system_to_component_index(idof).first;
+                const dealii::Point<dim> &point = fe_values.quadrature_point(idof);
+
+                rigid_body_modes[component * n_local_rows + local_row] = 1.0;
+                for (unsigned int irot = 0; irot < n_rotations; ++irot) {
+                    const unsigned int a = irot, b = (irot + 1) % dim;
+                    double rotation = 0.0;
+                    if (component == a) rotation = -point[b];
+                    if (component == b) rotation = point[a];
+                    rigid_body_modes[(dim + irot) * n_local_rows + local_row] = rotation;
+                }
+            }
+        }
+    }
+
+    template <int dim, typename real, typename VectorType , typename DoFHandlerType>
+    std::unique_ptr<dealii::TrilinosWrappers::PreconditionBase>
+    LinearElasticity<dim,real,VectorType,DoFHandlerType>::build_preconditioner()
+    {
+        const Parameters::LinearSolverParam &param = linear_solver_param;
+        if (param.preconditioner_type != Parameters::LinearSolverParam::PreconditionerEnum::amg) {
+            std::unique_ptr<dealii::TrilinosWrappers::PreconditionJacobi> jacobi = std::make_unique<dealii::TrilinosWrappers::PreconditionJacobi>();
+            jacobi->initialize(system_matrix);
+            return jacobi;
+        }
+        // Same ML parameters as the PreconditionAMG::AdditionalData of the amg_* options,
+        // which cannot hold the rotations of the near-nullspace.
+        Teuchos::ParameterList ml_parameters;
+        if (param.amg_elliptic) {
+            ML_Epetra::SetDefaults("SA", ml_parameters);
+            if (param.amg_higher_order_elements) ml_parameters.set("aggregation: type", "Uncoupled");
+        } else {
+            ML_Epetra::SetDefaults("NSSA", ml_parameters);
+            ml_parameters.set("aggregation: type", "Uncoupled");
+            ml_parameters.set("aggregation: block scaling", true);
+        }
+        ml_parameters.set("smoother: type", param.amg_smoother_type.c_str());
+        ml_parameters.set("coarse: type", "Amesos-KLU");
+        ml_parameters.set("initialize random seed", true);
+        ml_parameters.set("smoother: sweeps", static_cast<int>(param.amg_smoother_sweeps));
+        ml_parameters.set("cycle applications", static_cast<int>(param.amg_n_cycles));
+        ml_parameters.set("prec type", param.amg_w_cycle ? "MGW" : "MGV");
+        ml_parameters.set("smoother: Chebyshev alpha", 10.);
+        ml_parameters.set("smoother: ifpack overlap", 0);
+        ml_parameters.set("aggregation: threshold", param.amg_aggregation_threshold);
+        ml_parameters.set("coarse: max size", 2000);
+        ml_parameters.set("ML output", (param.linear_solver_output == Parameters::OutputEnum::verbose) ? 10 : 0);
+
+        // Rigid translations and rotations are the near-nullspace of the elasticity operator.
+        compute_rigid_body_modes();
+        const int n_modes = (dim == 1) ? 1 : ((dim == 2) ? 3 : 6);
+        ml_parameters.set("PDE equations", dim);
+        ml_parameters.set("null space: type", "pre-computed");
+        ml_parameters.set("null space: dimension", n_modes);
+        ml_parameters.set("null space: vectors", rigid_body_modes.data());
+
+        std::unique_ptr<dealii::TrilinosWrappers::PreconditionAMG> amg = std::make_unique<dealii::TrilinosWrappers::PreconditionAMG>();
+        amg->initialize(system_matrix, ml_parameters);
+        return amg;
+    }
+
+    template <int dim, typename real, typename VectorType , typename DoFHandlerType>
+    const dealii::TrilinosWrappers::PreconditionBase &
+    LinearElasticity<dim,real,VectorType,DoFHandlerType>::get_preconditioner()
+    {
+        if (!preconditioner || built_preconditioner_type != linear_solver_param.preconditioner_type) {
+            preconditioner = build_preconditioner();
+            built_preconditioner_type = linear_solver_param.preconditioner_type;
+        }
+        return *preconditioner;
+    }
+
+    template <int dim, typename real, typename VectorType , typename DoFHandlerType>
+    unsigned int LinearElasticity<dim,real,VectorType,DoFHandlerType>::solve_linear_problem(
+        const dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+        dealii::LinearAlgebra::distributed::Vector<double> &solution,
+        const double tolerance,
+        const bool transpose)
+    {
+        dealii::SolverControl solver_control(5000, tolerance);
+        dealii::SolverGMRES<dealii::LinearAlgebra::distributed::Vector<double>> solver(solver_control);
+
+        using trilinos_vector_type = dealii::LinearAlgebra::distributed::Vector<double>;
+        using payload_type = dealii::TrilinosWrappers::internal::LinearOperatorImplementation::TrilinosPayload;
+        const auto op_a = dealii::linear_operator<trilinos_vector_type,trilinos_vector_type,payload_type>(system_matrix);
+
+        if (transpose) {
+            solver.solve(dealii::transpose_operator(op_a), solution, right_hand_side, get_preconditioner());
+        } else {
+            solver.solve(op_a, solution, right_hand_side, get_preconditioner());
+        }
+
+        if (solver_control.last_check() != dealii::SolverControl::State::success) {
+            pcout << "Failed to converge." << std::endl;
+            std::abort();
+        }
+        return solver_control.last_step();
+    }
+
     template <int dim, typename real, typename VectorType , typename DoFHandlerType>
     void LinearElasticity<dim,real,VectorType,DoFHandlerType>::solve_timestep()
     {
         assemble_system();
-        apply_dXvdXvs(system_rhs, displacement_solution);
+
+        const double rhs_norm = system_rhs.l2_norm();
+        if (solved_rhs.size() == system_rhs.size()) {
+            dealii::LinearAlgebra::distributed::Vector<double> rhs_change(system_rhs);
+            rhs_change -= solved_rhs;
+            if (rhs_change.linfty_norm() == 0.0) {
+                pcout << "    Unchanged boundary displacements. Keeping the volume displacements." << std::endl;
+                return;
+            }
+        } else {
+            // The boundary values are exact on the first solve.
+            displacement_solution = system_rhs;
+        }
+        if (rhs_norm == 0.0) {
+            displacement_solution = 0.0;
+        } else {
+            // Starting from the previous displacements, GMRES only has to resolve the increment.
+            const unsigned int n_iterations = solve_linear_problem(system_rhs, displacement_solution, 1e-14 * rhs_norm);
+            pcout << "    Solver converged in " << n_iterations << " iterations." << std::endl;
+        }
+        solved_rhs = system_rhs;
         //const unsigned int n_iterations = solve_linear_problem();
         //pcout << "    Solver converged in " << n_iterations << " iterations." << std::endl;
     }
@@ -360,29 +547,13 @@ namespace MeshMover {
 
         assemble_system();
 
-        dealii::SolverControl solver_control(5000, 1e-14 * input_vector_norm);
-        dealii::SolverGMRES<dealii::LinearAlgebra::distributed::Vector<double>> solver(solver_control);
-        dealii::TrilinosWrappers::PreconditionJacobi      precondition;
-        precondition.initialize(system_matrix);
-
-        using trilinos_vector_type = dealii::LinearAlgebra::distributed::Vector<double>;
-        using payload_type = dealii::TrilinosWrappers::internal::LinearOperatorImplementation::TrilinosPayload;
-        const auto op_a = dealii::linear_operator<trilinos_vector_type,trilinos_vector_type,payload_type>(system_matrix);
-
-        const auto &rhs_vector = input_vector;
         output_vector = input_vector;
 
         // Solve modified system.
         dealii::deallog.depth_console(1);
-        solver.solve(op_a, output_vector, rhs_vector, precondition);
+        const unsigned int n_iterations = solve_linear_problem(input_vector, output_vector, 1e-14 * input_vector_norm);
 
-        pcout << "dXvdXvs Solver took " << solver_control.last_step() << " steps. "
-              << "Residual: " << solver_control.last_value() << ". "
-              << std::endl;
-        if (solver_control.last_check() != dealii::SolverControl::State::success) {
-            pcout << "Failed to converge." << std::endl;
-            std::abort();
-        }
+        pcout << "dXvdXvs Solver took " << n_iterations << " steps. " << std::endl;
     }
 
     template <int dim, typename real, typename VectorType , typename DoFHandlerType>
@@ -416,44 +587,136 @@ namespace MeshMover {
 
         output_matrix.reinit(row_part, col_part, full_sp, mpi_communicator);
 
-        dealii::TrilinosWrappers::PreconditionJacobi      precondition;
-        precondition.initialize(system_matrix);
-
-        using trilinos_vector_type = dealii::LinearAlgebra::distributed::Vector<double>;
-        using payload_type = dealii::TrilinosWrappers::internal::LinearOperatorImplementation::TrilinosPayload;
-        const auto op_a = dealii::linear_operator<trilinos_vector_type,trilinos_vector_type,payload_type>(system_matrix);
-
         dXvdXs.clear();
         pcout << "Applying for [dXvdXs] onto " << list_of_vectors.size() << " vectors..." << std::endl;
 
-        unsigned int col = 0;
-        for (auto &input_vector: list_of_vectors) {
-
-            dealii::deallog.depth_console(0);
-
-            dealii::LinearAlgebra::distributed::Vector<double> output_vector;
-            output_vector.reinit(input_vector);
-            double input_vector_norm = input_vector.l2_norm();
-            if (input_vector_norm == 0.0) {
-                pcout << "Zero input vector. Zero output vector." << std::endl;
-                output_vector = 0.0;
-            } else {
-                dealii::SolverControl solver_control(5000, 1e-14 * input_vector_norm);
-                dealii::SolverGMRES<dealii::LinearAlgebra::distributed::Vector<double>> solver(solver_control);
-                solver.solve(op_a, output_vector, input_vector, precondition);
-            }
-
-            dXvdXs.push_back(output_vector);
+        dealii::deallog.depth_console(0);
+        const unsigned int n_iterations = solve_multiple_rhs(list_of_vectors, dXvdXs);
+        pcout << "dXvdXvs took " << n_iterations << " GMRES iterations over " << n_cols << " vectors." << std::endl;
 
+        for (unsigned int col = 0; col < n_cols; ++col) {
             for (const auto &row: dof_handler.locally_owned_dofs()) {
                 output_matrix.set(row, col, dXvdXs[col][row]);
             }
-            col++;
         }
         output_matrix.compress(dealii::VectorOperation::insert);
 
     }
 
+    template <int dim, typename real, typename VectorType , typename DoFHandlerType>
+    Amesos_BaseSolver &
+    LinearElasticity<dim,real,VectorType,DoFHandlerType>::get_direct_solver()
+    {
+        if (!direct_solver) {
+            direct_problem = std::make_unique<Epetra_LinearProblem>();
+            direct_problem->SetOperator(const_cast<Epetra_CrsMatrix *>(&system_matrix.trilinos_matrix()));
+            Amesos Factory;
+            direct_solver.reset(Factory.Create("Amesos_Klu", *direct_problem));
+            Assert(direct_solver != nullptr, dealii::ExcMessage("Amesos could not create the direct solver."));
+            int ierr = direct_solver->SymbolicFactorization();
+            ierr += direct_solver->NumericFactorization();
+            Assert(ierr == 0, dealii::ExcMessage("The factorization of the elasticity matrix failed."));
+            (void) ierr;
+        }
+        return *direct_solver;
+    }
+
+    template <int dim, typename real, typename VectorType , typename DoFHandlerType>
+    unsigned int
+    LinearElasticity<dim,real,VectorType,DoFHandlerType>
+    ::solve_multiple_rhs(
+        const std::vector<dealii::LinearAlgebra::distributed::Vector<double>> &right_hand_sides,
+        std::vector<dealii::LinearAlgebra::distributed::Vector<double>> &solutions)
+    {
+        const unsigned int n_rhs = right_hand_sides.size();
+        solutions.resize(n_rhs);
+        std::vector<double> tolerances(n_rhs);
+        for (unsigned int i_rhs = 0; i_rhs < n_rhs; ++i_rhs) {
+            solutions[i_rhs].reinit(right_hand_sides[i_rhs]);
+            tolerances[i_rhs] = 1e-14 * right_hand_sides[i_rhs].l2_norm();
+        }
+
+        if (factorize_for_multiple_rhs && n_rhs > 0) {
+            const Epetra_CrsMatrix &matrix = system_matrix.trilinos_matrix();
+            Amesos_BaseSolver &solver = get_direct_solver();
+
+            // Each block of right-hand sides goes through the factors together.
+            const int n_local = matrix.DomainMap().NumMyElements();
+            for (unsigned int first_rhs = 0; first_rhs < n_rhs; first_rhs += rhs_block_size) {
+                const unsigned int n_block = std::min(rhs_block_size, n_rhs - first_rhs);
+                Epetra_MultiVector x(matrix.DomainMap(), n_block);
+                Epetra_MultiVector b(matrix.RangeMap(), n_block);
+                for (unsigned int i_block = 0; i_block < n_block; ++i_block) {
+                    for (int i = 0; i < n_local; ++i) {
+                        b[i_block][i] = right_hand_sides[first_rhs+i_block].local_element(i);
+                    }
+                }
+                direct_problem->SetLHS(&x);
+                direct_problem->SetRHS(&b);
+                const int ierr = solver.Solve();
+                Assert(ierr == 0, dealii::ExcMessage("The direct solve of the elasticity matrix failed."));
+                (void) ierr;
+                for (unsigned int i_block = 0; i_block < n_block; ++i_block) {
+                    for (int i = 0; i < n_local; ++i) {
+                        solutions[first_rhs+i_block].local_element(i) = x[i_block][i];
+                    }
+                }
+            }
+            // The right-hand sides only live in this call.
+            direct_problem->SetLHS(nullptr);
+            direct_problem->SetRHS(nullptr);
+        }
+
+        // GMRES on the columns that were not solved accurately enough by the factorization.
+        // The preconditioner is only built if needed.
+        dealii::LinearAlgebra::distributed::Vector<double> residual;
+        unsigned int n_iterations = 0;
+        for (unsigned int i_rhs = 0; i_rhs < n_rhs; ++i_rhs) {
+            if (tolerances[i_rhs] == 0.0) continue;
+            if (factorize_for_multiple_rhs) {
+                residual.reinit(right_hand_sides[i_rhs], true);
+                system_matrix.vmult(residual, solutions[i_rhs]);
+                residual -= right_hand_sides[i_rhs];
+                if (residual.l2_norm() <= tolerances[i_rhs]) continue;
+            }
+            n_iterations += solve_linear_problem(right_hand_sides[i_rhs], solutions[i_rhs], tolerances[i_rhs]);
+        }
+        return n_iterations;
+    }
+
+    template <int dim, typename real, typename VectorType , typename DoFHandlerType>
+    dealii::LinearOperator<dealii::LinearAlgebra::distributed::Vector<double>>
+    LinearElasticity<dim,real,VectorType,DoFHandlerType>
+    ::get_dXvdXvs_operator()
+    {
+        using vector_type = dealii::LinearAlgebra::distributed::Vector<double>;
+        dealii::LinearOperator<vector_type> dXvdXvs_operator;
+
+        dXvdXvs_operator.vmult = [this](vector_type &dst, const vector_type &src) {
+            apply_dXvdXvs(src, dst);
+        };
+        dXvdXvs_operator.vmult_add = [this](vector_type &dst, const vector_type &src) {
+            vector_type product(dst);
+            apply_dXvdXvs(src, product);
+            dst += product;
+        };
+        dXvdXvs_operator.Tvmult = [this](vector_type &dst, const vector_type &src) {
+            apply_dXvdXvs_transpose(src, dst);
+        };
+        dXvdXvs_operator.Tvmult_add = [this](vector_type &dst, const vector_type &src) {
+            vector_type product(dst);
+            apply_dXvdXvs_transpose(src, product);
+            dst += product;
+        };
+        // Square operator on the volume nodes.
+        dXvdXvs_operator.reinit_range_vector = [this](vector_type &vector, const bool omit_zeroing_entries) {
+            vector.reinit(system_rhs, omit_zeroing_entries);
+        };
+        dXvdXvs_operator.reinit_domain_vector = dXvdXvs_operator.reinit_range_vector;
+
+        return dXvdXvs_operator;
+    }
+
     template <int dim, typename real, typename VectorType , typename DoFHandlerType>
     void
     LinearElasticity<dim,real,VectorType,DoFHandlerType>
@@ -472,28 +735,12 @@ namespace MeshMover {
 
         assemble_system();
 
-        dealii::SolverControl solver_control(5000, 1e-14 * input_vector_norm);
-        dealii::SolverGMRES<dealii::LinearAlgebra::distributed::Vector<double>> solver(solver_control);
-        dealii::TrilinosWrappers::PreconditionJacobi      precondition;
-        precondition.initialize(system_matrix);
-
-        using trilinos_vector_type = VectorType;
-        using payload_type = dealii::TrilinosWrappers::internal::LinearOperatorImplementation::TrilinosPayload;
-        const auto op_a = dealii::linear_operator<trilinos_vector_type,trilinos_vector_type,payload_type>(system_matrix);
-        const auto op_at = dealii::transpose_operator(op_a);
-
         // Solve system.
         dealii::deallog.depth_console(0);
-        solver.solve(op_at, output_vector, input_vector, precondition);
-
-        pcout << "dXvdXvs_Transpose Solver took " << solver_control.last_step() << " steps. "
-              << "Residual: " << solver_control.last_value() << ". "
-              << std::endl;
-        if (solver_control.last_check() != dealii::SolverControl::State::success) {
-            pcout << "Failed to converge." << std::endl;
-            std::abort();
-        }
+        const bool transpose = true;
+        const unsigned int n_iterations = solve_linear_problem(input_vector, output_vector, 1e-14 * input_vector_norm, transpose);
 
+        pcout << "dXvdXvs_Transpose Solver took " << n_iterations << " steps. " << std::endl;
 
     }
 
@@ -1,8 +1,13 @@
 #ifndef __MESHMOVER_LINEAR_ELASTICITY_H__
 #define __MESHMOVER_LINEAR_ELASTICITY_H__
 
+#include <deal.II/lac/linear_operator.h>
+#include <deal.II/lac/trilinos_precondition.h>
 #include <deal.II/lac/trilinos_sparse_matrix.h>
 
+#include <Amesos_BaseSolver.h>
+#include <Epetra_LinearProblem.h>
+
 #include "parameters/all_parameters.h"
 
 #include "high_order_grid.h"
@@ -44,6 +49,9 @@ namespace MeshMover
 			const dealii::LinearAlgebra::distributed::Vector<double> &boundary_displacements_vector);
 
         /** Evaluate and return volume displacements given boundary displacements.
+         *  The system is only assembled on the first call. Later calls start GMRES from the previous
+         *  displacements, such that only the increment due to the new boundary displacements is solved for,
+         *  and return the previous displacements without solving if the boundary displacements did not change.
          */
         VectorType get_volume_displacements();
 
@@ -62,6 +70,13 @@ namespace MeshMover
         void
         apply_dXvdXvs(std::vector<dealii::LinearAlgebra::distributed::Vector<double>> &list_of_vectors, dealii::TrilinosWrappers::SparseMatrix &output_matrix);
 
+        /** Returns dXvdXvs as an implicit operator instead of a dense matrix.
+         *  Each vmult() is one elasticity solve through apply_dXvdXvs(), and each Tvmult() one
+         *  transposed solve through apply_dXvdXvs_transpose().
+         *  The operator refers to this mesh mover, which must outlive it.
+         */
+        dealii::LinearOperator<dealii::LinearAlgebra::distributed::Vector<double>> get_dXvdXvs_operator();
+
         /** Apply the analytical derivatives of volume displacements with respect
          *  to surface displacements onto a set of various right-hand sides.
          *  Note that the right-hand-side is of size n_volume_nodes.
@@ -84,6 +99,23 @@ namespace MeshMover
             const dealii::LinearAlgebra::distributed::Vector<double> &input_vector,
             dealii::LinearAlgebra::distributed::Vector<double> &output_vector);
 
+        /** Preconditioner of the elasticity solves. If the preconditioner_type is amg, the ML algebraic
+         *  multigrid, whose iterations do not grow with the number of volume nodes, is built from the amg_*
+         *  options. Otherwise, uses Jacobi. Defaults to the input file defaults, except for an elliptic amg.
+         */
+        Parameters::LinearSolverParam linear_solver_param;
+
+        /** When applying dXvdXvs onto a list of vectors, factorizes the elasticity matrix with a
+         *  sparse direct solver and solves rhs_block_size right-hand sides at a time. The factorization
+         *  is kept until the system_matrix is re-assembled. Columns that do not reach the tolerance are
+         *  then improved with GMRES. Otherwise, every column is solved with GMRES and the same
+         *  build_preconditioner(). True by default on a single process only, since Amesos KLU gathers
+         *  the matrix on one process.
+         */
+        bool factorize_for_multiple_rhs;
+        /// Number of right-hand sides given together to the direct solver. 32 by default.
+        unsigned int rhs_block_size;
+
         /** Current displacement solution
          */
         VectorType displacement_solution;
@@ -107,7 +139,11 @@ namespace MeshMover
         /// Allocation and boundary condition setup.
         void setup_system();
         /// Assemble the system and its right-hand side.
+        /** The matrix only depends on the initial grid. Once assembled, only the right-hand side is updated.
+         */
         void assemble_system();
+        /// Sets the right-hand side to the current boundary displacements on the Dirichlet rows.
+        void assemble_rhs();
 
 
         /** Solve the current time step.
@@ -118,9 +154,37 @@ namespace MeshMover
         void solve_timestep();
 
         /** Linear solver for the mesh mover.
-         *  Currently uses CG with a Jacobi preconditioner.
+         *  Uses GMRES with get_preconditioner(), starting from the given \p solution.
+         *  Solves the transposed system if \p transpose is true. Returns the number of iterations.
+         */
+        unsigned int solve_linear_problem(
+            const dealii::LinearAlgebra::distributed::Vector<double> &right_hand_side,
+            dealii::LinearAlgebra::distributed::Vector<double> &solution,
+            const double tolerance,
+            const bool transpose = false);
+
+        /** Preconditioner of the system_matrix, see linear_solver_param.
+         *  The algebraic multigrid coarsens the displacement components together
+         *  and preserves the rigid_body_modes.
          */
-        unsigned int solve_linear_problem();
+        std::unique_ptr<dealii::TrilinosWrappers::PreconditionBase> build_preconditioner();
+
+        /// Evaluates the rigid translations and rotations of the volume nodes, see rigid_body_modes.
+        void compute_rigid_body_modes();
+
+        /// Preconditioner of the assembled system_matrix, built on the first call and then reused.
+        const dealii::TrilinosWrappers::PreconditionBase & get_preconditioner();
+
+        /// Direct solver of the assembled system_matrix, factorized on the first call and then reused.
+        Amesos_BaseSolver & get_direct_solver();
+
+        /** Solves the system_matrix for each of the \p right_hand_sides, see factorize_for_multiple_rhs.
+         *  The factorization or the preconditioner is built once and shared by all the columns.
+         *  Returns the total number of GMRES iterations.
+         */
+        unsigned int solve_multiple_rhs(
+            const std::vector<dealii::LinearAlgebra::distributed::Vector<double>> &right_hand_sides,
+            std::vector<dealii::LinearAlgebra::distributed::Vector<double>> &solutions);
 
         const Triangulation &triangulation; ///< Triangulation on which this acts.
         /// MappingFEField corresponding to curved mesh.
@@ -174,6 +238,25 @@ namespace MeshMover
          */
         dealii::LinearAlgebra::distributed::Vector<double> tensor_to_vector(const std::vector<dealii::Tensor<1,dim,real>> &boundary_displacements_tensors) const;
 
+        /// Whether the system_matrix has been assembled, see assemble_system().
+        bool system_is_assembled;
+        /// Cached preconditioner, see get_preconditioner().
+        std::unique_ptr<dealii::TrilinosWrappers::PreconditionBase> preconditioner;
+        /// Preconditioner type of the linear_solver_param when the cached preconditioner was built.
+        Parameters::LinearSolverParam::PreconditionerEnum built_preconditioner_type;
+        /// Linear problem of the cached direct_solver, whose operator is the system_matrix.
+        std::unique_ptr<Epetra_LinearProblem> direct_problem;
+        /// Cached factorization of the system_matrix, see get_direct_solver().
+        std::unique_ptr<Amesos_BaseSolver> direct_solver;
+        /** Near-nullspace of the elasticity operator given to ML, stored one mode after the other
+         *  over the locally owned rows. Must outlive the preconditioner, which only points to it.
+         */
+        std::vector<double> rigid_body_modes;
+        /** Right-hand side of the current displacement_solution.
+         *  Empty until get_volume_displacements() is first called.
+         */
+        dealii::LinearAlgebra::distributed::Vector<double> solved_rhs;
+
     };
 } // namespace MeshMover
 
@@ -1,5 +1,6 @@
 #include <Sacado.hpp>
 #include <deal.II/differentiation/ad/sacado_product_types.h>
+#include "ad_types.hpp"
 #include "numerical_flux.h"
 #include "viscous_numerical_flux.h"
 #include "split_form_numerical_flux.h"
@@ -67,27 +68,35 @@ std::array<real, nstate> LaxFriedrichs<dim,nstate,real>
     const dealii::Tensor<1,dim,real> &normal_int) const
 {
     using RealArrayVector = std::array<dealii::Tensor<1,dim,real>,nstate>;
-    RealArrayVector conv_phys_flux_int;
-    RealArrayVector conv_phys_flux_ext;
-
-    conv_phys_flux_int = pde_physics->convective_flux (soln_int);
-    conv_phys_flux_ext = pde_physics->convective_flux (soln_ext);
-    
-    RealArrayVector flux_avg = array_average<nstate, dealii::Tensor<1,dim,real>> (conv_phys_flux_int, conv_phys_flux_ext);
+    const RealArrayVector conv_phys_flux_int = pde_physics->convective_flux (soln_int);
+    const RealArrayVector conv_phys_flux_ext = pde_physics->convective_flux (soln_ext);
 
     const real conv_max_eig_int = pde_physics->max_convective_eigenvalue(soln_int);
     const real conv_max_eig_ext = pde_physics->max_convective_eigenvalue(soln_ext);
+
+    return evaluate_flux_from_physical_fluxes<real> (soln_int, soln_ext, conv_phys_flux_int, conv_phys_flux_ext, conv_max_eig_int, conv_max_eig_ext, normal_int);
+}
+
+template<int dim, int nstate, typename real>
+template<typename real2>
+std::array<real2, nstate> LaxFriedrichs<dim,nstate,real>
+::evaluate_flux_from_physical_fluxes (
+    const std::array<real2, nstate> &soln_int,
+    const std::array<real2, nstate> &soln_ext,
+    const std::array<dealii::Tensor<1,dim,real2>, nstate> &conv_phys_flux_int,
+    const std::array<dealii::Tensor<1,dim,real2>, nstate> &conv_phys_flux_ext,
+    const real2 &conv_max_eig_int,
+    const real2 &conv_max_eig_ext,
+    const dealii::Tensor<1,dim,real2> &normal_int)
+{
+    using RealArrayVector = std::array<dealii::Tensor<1,dim,real2>,nstate>;
+    const RealArrayVector flux_avg = array_average<nstate, dealii::Tensor<1,dim,real2>> (conv_phys_flux_int, conv_phys_flux_ext);
+
     // Replaced the std::max with an if-statement for the AD to work properly.
-    //const real conv_max_eig = std::max(conv_max_eig_int, conv_max_eig_ext);
-    real conv_max_eig;
-    if (conv_max_eig_int > conv_max_eig_ext) {
-        conv_max_eig = conv_max_eig_int;
-    } else {
-        conv_max_eig = conv_max_eig_ext;
-    }
-    //conv_max_eig = std::max(conv_max_eig_int, conv_max_eig_ext);
+    const real2 conv_max_eig = Physics::compare_and_select<dealii::SIMDComparison::greater_than> (
+        conv_max_eig_int, conv_max_eig_ext, conv_max_eig_int, conv_max_eig_ext);
     // Scalar dissipation
-    std::array<real, nstate> numerical_flux_dot_n;
+    std::array<real2, nstate> numerical_flux_dot_n;
     for (int s=0; s<nstate; s++) {
         numerical_flux_dot_n[s] = flux_avg[s]*normal_int - 0.5 * conv_max_eig * (soln_ext[s]-soln_int[s]);
     }
@@ -101,117 +110,148 @@ std::array<real, nstate> Roe<dim,nstate,real>
     const std::array<real, nstate> &soln_int,
     const std::array<real, nstate> &soln_ext,
     const dealii::Tensor<1,dim,real> &normal_int) const
+{
+    return evaluate_flux_templated<real> (soln_int, soln_ext, normal_int);
+}
+
+template<int dim, int nstate, typename real>
+template<typename real2>
+std::array<real2, nstate> Roe<dim,nstate,real>
+::evaluate_flux_templated (
+    const std::array<real2, nstate> &soln_int,
+    const std::array<real2, nstate> &soln_ext,
+    const dealii::Tensor<1,dim,real2> &normal_int) const
 {
     // Blazek 2015
     // p. 103-105
-    const std::array<real,nstate> prim_soln_int = euler_physics->convert_conservative_to_primitive(soln_int);
-    const std::array<real,nstate> prim_soln_ext = euler_physics->convert_conservative_to_primitive(soln_ext);
-    // Left cell
-    const real density_L = prim_soln_int[0];
-    const dealii::Tensor< 1,dim,real > velocities_L = euler_physics->extract_velocities_from_primitive(prim_soln_int);
-    const real pressure_L = prim_soln_int[nstate-1];
-
-    const real normal_vel_L = velocities_L*normal_int;
-    const real specific_enthalpy_L = euler_physics->compute_specific_enthalpy(soln_int, pressure_L);
+    using Tensor = dealii::Tensor<1,dim,real2>;
+    using dealii::SIMDComparison;
+    using Physics::compare_and_select;
+    const real2 zero = Physics::make_constant<real2>(0.0);
+    const real2 one = Physics::make_constant<real2>(1.0);
+    const real2 large = Physics::make_constant<real2>(1e10);
+    const double gam = euler_physics->gam;
+    const double gamm1 = euler_physics->gamm1;
+
+    // Left cell, where the density and pressure are clipped as in Physics::Euler::convert_conservative_to_primitive()
+    const real2 density_L = compare_and_select<SIMDComparison::less_than>(soln_int[0], zero, large, soln_int[0]);
+    Tensor velocities_L;
+    for (int d=0;d<dim;d++) velocities_L[d] = soln_int[1+d]/soln_int[0];
+    const real2 pressure_L = euler_physics->compute_pressure_templated(soln_int);
+
+    const real2 normal_vel_L = velocities_L*normal_int;
+    const real2 specific_enthalpy_L = (soln_int[nstate-1]+pressure_L)/soln_int[0];
 
     // Right cell
-    const real density_R = prim_soln_ext[0];
-    const dealii::Tensor< 1,dim,real > velocities_R = euler_physics->extract_velocities_from_primitive(prim_soln_ext);
-    const real pressure_R = prim_soln_ext[nstate-1];
+    const real2 density_R = compare_and_select<SIMDComparison::less_than>(soln_ext[0], zero, large, soln_ext[0]);
+    Tensor velocities_R;
+    for (int d=0;d<dim;d++) velocities_R[d] = soln_ext[1+d]/soln_ext[0];
+    const real2 pressure_R = euler_physics->compute_pressure_templated(soln_ext);
 
-    const real normal_vel_R = velocities_R*normal_int;
-    const real specific_enthalpy_R = euler_physics->compute_specific_enthalpy(soln_ext, pressure_R);
+    const real2 normal_vel_R = velocities_R*normal_int;
+    const real2 specific_enthalpy_R = (soln_ext[nstate-1]+pressure_R)/soln_ext[0];
 
     // Roe-averaged states
-    const real r = std::sqrt(density_R/density_L);
-    const real rp1 = r+1.0;
+    const real2 r = std::sqrt(density_R/density_L);
+    const real2 rp1 = r+1.0;
 
-    const real density_ravg = r*density_L;
-    const dealii::Tensor< 1,dim,real > velocities_ravg = (r*velocities_R + velocities_L) / rp1;
-    const real specific_total_enthalpy_ravg = (r*specific_enthalpy_R + specific_enthalpy_L) / rp1;
+    const real2 density_ravg = r*density_L;
+    const Tensor velocities_ravg = (r*velocities_R + velocities_L) / rp1;
+    const real2 specific_total_enthalpy_ravg = (r*specific_enthalpy_R + specific_enthalpy_L) / rp1;
 
-    const real vel2_ravg = euler_physics->compute_velocity_squared (velocities_ravg);
-    const real normal_vel_ravg = velocities_ravg*normal_int;
+    const real2 vel2_ravg = velocities_ravg*velocities_ravg;
+    const real2 normal_vel_ravg = velocities_ravg*normal_int;
 
-    const real sound2_ravg = euler_physics->gamm1*(specific_total_enthalpy_ravg-0.5*vel2_ravg);
-    real sound_ravg = 1e10;
-    if (sound2_ravg > 0.0) {
-        sound_ravg = std::sqrt(sound2_ravg);
-    }
+    const real2 sound2_ravg = gamm1*(specific_total_enthalpy_ravg-0.5*vel2_ravg);
+    // The square root is taken of a positive value in every lane, such that the discarded one has finite derivatives.
+    const real2 positive_sound2_ravg = compare_and_select<SIMDComparison::greater_than>(sound2_ravg, zero, sound2_ravg, one);
+    const real2 sqrt_sound2_ravg = std::sqrt(positive_sound2_ravg);
+    const real2 sound_ravg = compare_and_select<SIMDComparison::greater_than>(sound2_ravg, zero, sqrt_sound2_ravg, large);
 
     // Compute eigenvalues
-    std::array<real, 3> eig_ravg;
+    std::array<real2, 3> eig_ravg;
     eig_ravg[0] = std::abs(normal_vel_ravg-sound_ravg);
     eig_ravg[1] = std::abs(normal_vel_ravg);
     eig_ravg[2] = std::abs(normal_vel_ravg+sound_ravg);
 
-    const real sound_L = euler_physics->compute_sound(density_L, pressure_L);
-    std::array<real, 3> eig_L;
+    const real2 sound_L = std::sqrt(pressure_L*gam/density_L);
+    std::array<real2, 3> eig_L;
     eig_L[0] = std::abs(normal_vel_L-sound_L);
     eig_L[1] = std::abs(normal_vel_L);
     eig_L[2] = std::abs(normal_vel_L+sound_L);
 
-    const real sound_R = euler_physics->compute_sound(density_R, pressure_R);
-    std::array<real, 3> eig_R;
+    const real2 sound_R = std::sqrt(pressure_R*gam/density_R);
+    std::array<real2, 3> eig_R;
     eig_R[0] = std::abs(normal_vel_R-sound_R);
     eig_R[1] = std::abs(normal_vel_R);
     eig_R[2] = std::abs(normal_vel_R+sound_R);
 
     // Harten's entropy fix
     for(int e=0;e<3;e++) {
-        const real eps = std::max(std::abs(eig_ravg[e]-eig_L[e]), std::abs(eig_R[e]-eig_ravg[e]));
-        if(std::abs(eig_ravg[e]) < eps) {
-            eig_ravg[e] = 0.5*(eig_ravg[e]*eig_ravg[e]/eps + eps);
-        }
+        const real2 eps = std::max(std::abs(eig_ravg[e]-eig_L[e]), std::abs(eig_R[e]-eig_ravg[e]));
+        // Avoids dividing by zero where the eigenvalue is kept.
+        const real2 safe_eps = compare_and_select<SIMDComparison::greater_than>(eps, zero, eps, one);
+        const real2 fixed_eig = 0.5*(eig_ravg[e]*eig_ravg[e]/safe_eps + eps);
+        eig_ravg[e] = compare_and_select<SIMDComparison::less_than>(eig_ravg[e], eps, fixed_eig, eig_ravg[e]);
     }
 
-    // Physical fluxes
-    const std::array<real,nstate> normal_flux_int = euler_physics->convective_normal_flux (soln_int, normal_int);
-    const std::array<real,nstate> normal_flux_ext = euler_physics->convective_normal_flux (soln_ext, normal_int);
+    // Physical fluxes, see Physics::Euler::convective_normal_flux()
+    std::array<real2,nstate> normal_flux_int, normal_flux_ext;
+    {
+        const real2 rhoV_L = soln_int[0]*normal_vel_L;
+        const real2 rhoV_R = soln_ext[0]*normal_vel_R;
+        normal_flux_int[0] = rhoV_L;
+        normal_flux_ext[0] = rhoV_R;
+        for (int d=0;d<dim;d++) {
+            normal_flux_int[1+d] = rhoV_L*velocities_L[d] + normal_int[d]*pressure_L;
+            normal_flux_ext[1+d] = rhoV_R*velocities_R[d] + normal_int[d]*pressure_R;
+        }
+        normal_flux_int[nstate-1] = rhoV_L*specific_enthalpy_L;
+        normal_flux_ext[nstate-1] = rhoV_R*specific_enthalpy_R;
+    }
 
-    const real dVn = normal_vel_R-normal_vel_L;
-    const real dp = pressure_R - pressure_L;
-    const real drho = density_R - density_L;
+    const real2 dVn = normal_vel_R-normal_vel_L;
+    const real2 dp = pressure_R - pressure_L;
+    const real2 drho = density_R - density_L;
 
     // Product of eigenvalues and wave strengths
-    real coeff[4];
+    real2 coeff[4];
     coeff[0] = eig_ravg[0]*(dp-density_ravg*sound_ravg*dVn)/(2.0*sound2_ravg);
     coeff[1] = eig_ravg[1]*(drho - dp/sound2_ravg);
     coeff[2] = eig_ravg[1]*density_ravg;
     coeff[3] = eig_ravg[2]*(dp+density_ravg*sound_ravg*dVn)/(2.0*sound2_ravg);
 
     // Evaluate |A_Roe| * (W_R - W_L)
-    std::array<real,nstate> AdW;
+    std::array<real2,nstate> AdW;
 
     // Vn-c
-    AdW[0] = coeff[0] * 1.0;
+    AdW[0] = coeff[0];
     for (int d=0;d<dim;d++) {
         AdW[1+d] = coeff[0] * (velocities_ravg[d] - sound_ravg * normal_int[d]);
     }
     AdW[nstate-1] = coeff[0] * (specific_total_enthalpy_ravg - sound_ravg*normal_vel_ravg);
 
     // Vn
-    AdW[0] += coeff[1] * 1.0;
+    AdW[0] += coeff[1];
     for (int d=0;d<dim;d++) {
         AdW[1+d] += coeff[1] * velocities_ravg[d];
     }
     AdW[nstate-1] += coeff[1] * vel2_ravg * 0.5;
 
-    AdW[0] += coeff[2] * 0.0;
-    const dealii::Tensor<1,dim,real> dvel = velocities_R - velocities_L;
+    const Tensor dvel = velocities_R - velocities_L;
     for (int d=0;d<dim;d++) {
         AdW[1+d] += coeff[2] * (dvel[d] - dVn*normal_int[d]);
     }
     AdW[nstate-1] += coeff[2] * (velocities_ravg*dvel - normal_vel_ravg*dVn);
 
     // Vn+c
-    AdW[0] += coeff[3] * 1.0;
+    AdW[0] += coeff[3];
     for (int d=0;d<dim;d++) {
         AdW[1+d] += coeff[3] * (velocities_ravg[d] + sound_ravg * normal_int[d]);
     }
     AdW[nstate-1] += coeff[3] * (specific_total_enthalpy_ravg + sound_ravg*normal_vel_ravg);
 
-    std::array<real, nstate> numerical_flux_dot_n;
+    std::array<real2, nstate> numerical_flux_dot_n;
     for (int s=0; s<nstate; s++) {
         numerical_flux_dot_n[s] = 0.5*(normal_flux_int[s]+normal_flux_ext[s] - AdW[s]);
     }
@@ -219,7 +259,6 @@ std::array<real, nstate> Roe<dim,nstate,real>
     return numerical_flux_dot_n;
 }
 
-
 // Instantiation
 template class NumericalFluxConvective<PHILIP_DIM, 1, double>;
 template class NumericalFluxConvective<PHILIP_DIM, 2, double>;
@@ -231,6 +270,31 @@ template class NumericalFluxConvective<PHILIP_DIM, 2, Sacado::Fad::DFad<double>
 template class NumericalFluxConvective<PHILIP_DIM, 3, Sacado::Fad::DFad<double> >;
 template class NumericalFluxConvective<PHILIP_DIM, 4, Sacado::Fad::DFad<double> >;
 template class NumericalFluxConvective<PHILIP_DIM, 5, Sacado::Fad::DFad<double> >;
+template class NumericalFluxConvective<PHILIP_DIM, 1, StaticFadType >;
+template class NumericalFluxConvective<PHILIP_DIM, 2, StaticFadType >;
+template class NumericalFluxConvective<PHILIP_DIM, 3, StaticFadType >;
+template class NumericalFluxConvective<PHILIP_DIM, 4, StaticFadType >;
+template class NumericalFluxConvective<PHILIP_DIM, 5, StaticFadType >;
+template class NumericalFluxConvective<PHILIP_DIM, 1, DegreeFadType<2> >;
+template class NumericalFluxConvective<PHILIP_DIM, 2, DegreeFadType<2> >;
+template class NumericalFluxConvective<PHILIP_DIM, 3, DegreeFadType<2> >;
+template class NumericalFluxConvective<PHILIP_DIM, 4, DegreeFadType<2> >;
+template class NumericalFluxConvective<PHILIP_DIM, 5, DegreeFadType<2> >;
+template class NumericalFluxConvective<PHILIP_DIM, 1, DegreeFadType<3> >;
+template class NumericalFluxConvective<PHILIP_DIM, 2, DegreeFadType<3> >;
+template class NumericalFluxConvective<PHILIP_DIM, 3, DegreeFadType<3> >;
+template class NumericalFluxConvective<PHILIP_DIM, 4, DegreeFadType<3> >;
+template class NumericalFluxConvective<PHILIP_DIM, 5, DegreeFadType<3> >;
+template class NumericalFluxConvective<PHILIP_DIM, 1, DegreeFadType<4> >;
+template class NumericalFluxConvective<PHILIP_DIM, 2, DegreeFadType<4> >;
+template class NumericalFluxConvective<PHILIP_DIM, 3, DegreeFadType<4> >;
+template class NumericalFluxConvective<PHILIP_DIM, 4, DegreeFadType<4> >;
+template class NumericalFluxConvective<PHILIP_DIM, 5, DegreeFadType<4> >;
+template class NumericalFluxConvective<PHILIP_DIM, 1, DirectionalFadType >;
+template class NumericalFluxConvective<PHILIP_DIM, 2, DirectionalFadType >;
+template class NumericalFluxConvective<PHILIP_DIM, 3, DirectionalFadType >;
+template class NumericalFluxConvective<PHILIP_DIM, 4, DirectionalFadType >;
+template class NumericalFluxConvective<PHILIP_DIM, 5, DirectionalFadType >;
 template class NumericalFluxConvective<PHILIP_DIM, 1, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class NumericalFluxConvective<PHILIP_DIM, 2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class NumericalFluxConvective<PHILIP_DIM, 3, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
@@ -252,6 +316,31 @@ template class LaxFriedrichs<PHILIP_DIM, 2, Sacado::Fad::DFad<double> >;
 template class LaxFriedrichs<PHILIP_DIM, 3, Sacado::Fad::DFad<double> >;
 template class LaxFriedrichs<PHILIP_DIM, 4, Sacado::Fad::DFad<double> >;
 template class LaxFriedrichs<PHILIP_DIM, 5, Sacado::Fad::DFad<double> >;
+template class LaxFriedrichs<PHILIP_DIM, 1, StaticFadType >;
+template class LaxFriedrichs<PHILIP_DIM, 2, StaticFadType >;
+template class LaxFriedrichs<PHILIP_DIM, 3, StaticFadType >;
+template class LaxFriedrichs<PHILIP_DIM, 4, StaticFadType >;
+template class LaxFriedrichs<PHILIP_DIM, 5, StaticFadType >;
+template class LaxFriedrichs<PHILIP_DIM, 1, DegreeFadType<2> >;
+template class LaxFriedrichs<PHILIP_DIM, 2, DegreeFadType<2> >;
+template class LaxFriedrichs<PHILIP_DIM, 3, DegreeFadType<2> >;
+template class LaxFriedrichs<PHILIP_DIM, 4, DegreeFadType<2> >;
+template class LaxFriedrichs<PHILIP_DIM, 5, DegreeFadType<2> >;
+template class LaxFriedrichs<PHILIP_DIM, 1, DegreeFadType<3> >;
+template class LaxFriedrichs<PHILIP_DIM, 2, DegreeFadType<3> >;
+template class LaxFriedrichs<PHILIP_DIM, 3, DegreeFadType<3> >;
+template class LaxFriedrichs<PHILIP_DIM, 4, DegreeFadType<3> >;
+template class LaxFriedrichs<PHILIP_DIM, 5, DegreeFadType<3> >;
+template class LaxFriedrichs<PHILIP_DIM, 1, DegreeFadType<4> >;
+template class LaxFriedrichs<PHILIP_DIM, 2, DegreeFadType<4> >;
+template class LaxFriedrichs<PHILIP_DIM, 3, DegreeFadType<4> >;
+template class LaxFriedrichs<PHILIP_DIM, 4, DegreeFadType<4> >;
+template class LaxFriedrichs<PHILIP_DIM, 5, DegreeFadType<4> >;
+template class LaxFriedrichs<PHILIP_DIM, 1, DirectionalFadType >;
+template class LaxFriedrichs<PHILIP_DIM, 2, DirectionalFadType >;
+template class LaxFriedrichs<PHILIP_DIM, 3, DirectionalFadType >;
+template class LaxFriedrichs<PHILIP_DIM, 4, DirectionalFadType >;
+template class LaxFriedrichs<PHILIP_DIM, 5, DirectionalFadType >;
 template class LaxFriedrichs<PHILIP_DIM, 1, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class LaxFriedrichs<PHILIP_DIM, 2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class LaxFriedrichs<PHILIP_DIM, 3, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
@@ -265,9 +354,30 @@ template class LaxFriedrichs<PHILIP_DIM, 5, Sacado::Rad::ADvar<Sacado::Fad::DFad
 
 template class Roe<PHILIP_DIM, PHILIP_DIM+2, double>;
 template class Roe<PHILIP_DIM, PHILIP_DIM+2, Sacado::Fad::DFad<double> >;
+template class Roe<PHILIP_DIM, PHILIP_DIM+2, StaticFadType >;
+template class Roe<PHILIP_DIM, PHILIP_DIM+2, DegreeFadType<2> >;
+template class Roe<PHILIP_DIM, PHILIP_DIM+2, DegreeFadType<3> >;
+template class Roe<PHILIP_DIM, PHILIP_DIM+2, DegreeFadType<4> >;
+template class Roe<PHILIP_DIM, PHILIP_DIM+2, DirectionalFadType >;
 template class Roe<PHILIP_DIM, PHILIP_DIM+2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class Roe<PHILIP_DIM, PHILIP_DIM+2, Sacado::Rad::ADvar<Sacado::Fad::DFad<double>> >;
 
+// SIMD evaluation of the fluxes by DGWeak::evaluate_convective_numerical_flux_batched()
+template std::array<dealii::VectorizedArray<double>, PHILIP_DIM+2> LaxFriedrichs<PHILIP_DIM, PHILIP_DIM+2, double>
+::evaluate_flux_from_physical_fluxes (
+    const std::array<dealii::VectorizedArray<double>, PHILIP_DIM+2> &,
+    const std::array<dealii::VectorizedArray<double>, PHILIP_DIM+2> &,
+    const std::array<dealii::Tensor<1,PHILIP_DIM,dealii::VectorizedArray<double>>, PHILIP_DIM+2> &,
+    const std::array<dealii::Tensor<1,PHILIP_DIM,dealii::VectorizedArray<double>>, PHILIP_DIM+2> &,
+    const dealii::VectorizedArray<double> &,
+    const dealii::VectorizedArray<double> &,
+    const dealii::Tensor<1,PHILIP_DIM,dealii::VectorizedArray<double>> &);
+template std::array<dealii::VectorizedArray<double>, PHILIP_DIM+2> Roe<PHILIP_DIM, PHILIP_DIM+2, double>
+::evaluate_flux_templated (
+    const std::array<dealii::VectorizedArray<double>, PHILIP_DIM+2> &,
+    const std::array<dealii::VectorizedArray<double>, PHILIP_DIM+2> &,
+    const dealii::Tensor<1,PHILIP_DIM,dealii::VectorizedArray<double>> &) const;
+
 
 template class NumericalFluxFactory<PHILIP_DIM, 1, double>;
 template class NumericalFluxFactory<PHILIP_DIM, 2, double>;
@@ -279,6 +389,31 @@ template class NumericalFluxFactory<PHILIP_DIM, 2, Sacado::Fad::DFad<double> >;
 template class NumericalFluxFactory<PHILIP_DIM, 3, Sacado::Fad::DFad<double> >;
 template class NumericalFluxFactory<PHILIP_DIM, 4, Sacado::Fad::DFad<double> >;
 template class NumericalFluxFactory<PHILIP_DIM, 5, Sacado::Fad::DFad<double> >;
+template class NumericalFluxFactory<PHILIP_DIM, 1, StaticFadType >;
+template class NumericalFluxFactory<PHILIP_DIM, 2, StaticFadType >;
+template class NumericalFluxFactory<PHILIP_DIM, 3, StaticFadType >;
+template class NumericalFluxFactory<PHILIP_DIM, 4, StaticFadType >;
+template class NumericalFluxFactory<PHILIP_DIM, 5, StaticFadType >;
+template class NumericalFluxFactory<PHILIP_DIM, 1, DegreeFadType<2> >;
+template class NumericalFluxFactory<PHILIP_DIM, 2, DegreeFadType<2> >;
+template class NumericalFluxFactory<PHILIP_DIM, 3, DegreeFadType<2> >;
+template class NumericalFluxFactory<PHILIP_DIM, 4, DegreeFadType<2> >;
+template class NumericalFluxFactory<PHILIP_DIM, 5, DegreeFadType<2> >;
+template class NumericalFluxFactory<PHILIP_DIM, 1, DegreeFadType<3> >;
+template class NumericalFluxFactory<PHILIP_DIM, 2, DegreeFadType<3> >;
+template class NumericalFluxFactory<PHILIP_DIM, 3, DegreeFadType<3> >;
+template class NumericalFluxFactory<PHILIP_DIM, 4, DegreeFadType<3> >;
+template class NumericalFluxFactory<PHILIP_DIM, 5, DegreeFadType<3> >;
+template class NumericalFluxFactory<PHILIP_DIM, 1, DegreeFadType<4> >;
+template class NumericalFluxFactory<PHILIP_DIM, 2, DegreeFadType<4> >;
+template class NumericalFluxFactory<PHILIP_DIM, 3, DegreeFadType<4> >;
+template class NumericalFluxFactory<PHILIP_DIM, 4, DegreeFadType<4> >;
+template class NumericalFluxFactory<PHILIP_DIM, 5, DegreeFadType<4> >;
+template class NumericalFluxFactory<PHILIP_DIM, 1, DirectionalFadType >;
+template class NumericalFluxFactory<PHILIP_DIM, 2, DirectionalFadType >;
+template class NumericalFluxFactory<PHILIP_DIM, 3, DirectionalFadType >;
+template class NumericalFluxFactory<PHILIP_DIM, 4, DirectionalFadType >;
+template class NumericalFluxFactory<PHILIP_DIM, 5, DirectionalFadType >;
 template class NumericalFluxFactory<PHILIP_DIM, 1, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class NumericalFluxFactory<PHILIP_DIM, 2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class NumericalFluxFactory<PHILIP_DIM, 3, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
@@ -2,6 +2,7 @@
 #define __NUMERICAL_FLUX__
 
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 #include "numerical_flux/viscous_numerical_flux.h"
 #include "physics/physics.h"
 #include "physics/euler.h"
@@ -47,6 +48,20 @@ std::array<real, nstate> evaluate_flux (
     const std::array<real, nstate> &soln_ext,
     const dealii::Tensor<1,dim,real> &normal1) const;
 
+/// Returns the Lax-Friedrichs convective numerical flux from the physical fluxes and maximum eigenvalues on both sides.
+/** Templated on the scalar type such that the physics that have kernels templated on the scalar type,
+ *  such as Physics::Euler::convective_flux_templated(), can evaluate it with dealii::VectorizedArray<double>.
+ */
+template <typename real2>
+static std::array<real2, nstate> evaluate_flux_from_physical_fluxes (
+    const std::array<real2, nstate> &soln_int,
+    const std::array<real2, nstate> &soln_ext,
+    const std::array<dealii::Tensor<1,dim,real2>, nstate> &conv_phys_flux_int,
+    const std::array<dealii::Tensor<1,dim,real2>, nstate> &conv_phys_flux_ext,
+    const real2 &conv_max_eig_int,
+    const real2 &conv_max_eig_ext,
+    const dealii::Tensor<1,dim,real2> &normal1);
+
 protected:
 /// Numerical flux requires physics to evaluate convective eigenvalues.
 const std::shared_ptr < Physics::PhysicsBase<dim, nstate, real> > pde_physics;
@@ -73,6 +88,17 @@ std::array<real, nstate> evaluate_flux (
     const std::array<real, nstate> &soln_ext,
     const dealii::Tensor<1,dim,real> &normal1) const;
 
+/// Returns the Roe convective numerical flux templated on the scalar type, see evaluate_flux().
+/** Also instantiated with dealii::VectorizedArray<double> for real=double, where each lane holds a different
+ *  interface point. The branches of the entropy fix and of the clipping of negative states go through
+ *  Physics::compare_and_select().
+ */
+template <typename real2>
+std::array<real2, nstate> evaluate_flux_templated (
+    const std::array<real2, nstate> &soln_int,
+    const std::array<real2, nstate> &soln_ext,
+    const dealii::Tensor<1,dim,real2> &normal1) const;
+
 protected:
 /// Numerical flux requires physics to evaluate convective eigenvalues.
 const std::shared_ptr < Physics::Euler<dim, nstate, real> > euler_physics;
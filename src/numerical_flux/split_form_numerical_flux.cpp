@@ -1,6 +1,7 @@
 #include "split_form_numerical_flux.h"
 #include <Sacado.hpp>
 #include <deal.II/differentiation/ad/sacado_product_types.h>
+#include "ad_types.hpp"
 
 namespace PHiLiP {
 namespace NumericalFlux {
@@ -44,6 +45,31 @@ template class SplitFormNumFlux<PHILIP_DIM, 2, Sacado::Fad::DFad<double> >;
 template class SplitFormNumFlux<PHILIP_DIM, 3, Sacado::Fad::DFad<double> >;
 template class SplitFormNumFlux<PHILIP_DIM, 4, Sacado::Fad::DFad<double> >;
 template class SplitFormNumFlux<PHILIP_DIM, 5, Sacado::Fad::DFad<double> >;
+template class SplitFormNumFlux<PHILIP_DIM, 1, StaticFadType >;
+template class SplitFormNumFlux<PHILIP_DIM, 2, StaticFadType >;
+template class SplitFormNumFlux<PHILIP_DIM, 3, StaticFadType >;
+template class SplitFormNumFlux<PHILIP_DIM, 4, StaticFadType >;
+template class SplitFormNumFlux<PHILIP_DIM, 5, StaticFadType >;
+template class SplitFormNumFlux<PHILIP_DIM, 1, DegreeFadType<2> >;
+template class SplitFormNumFlux<PHILIP_DIM, 2, DegreeFadType<2> >;
+template class SplitFormNumFlux<PHILIP_DIM, 3, DegreeFadType<2> >;
+template class SplitFormNumFlux<PHILIP_DIM, 4, DegreeFadType<2> >;
+template class SplitFormNumFlux<PHILIP_DIM, 5, DegreeFadType<2> >;
+template class SplitFormNumFlux<PHILIP_DIM, 1, DegreeFadType<3> >;
+template class SplitFormNumFlux<PHILIP_DIM, 2, DegreeFadType<3> >;
+template class SplitFormNumFlux<PHILIP_DIM, 3, DegreeFadType<3> >;
+template class SplitFormNumFlux<PHILIP_DIM, 4, DegreeFadType<3> >;
+template class SplitFormNumFlux<PHILIP_DIM, 5, DegreeFadType<3> >;
+template class SplitFormNumFlux<PHILIP_DIM, 1, DegreeFadType<4> >;
+template class SplitFormNumFlux<PHILIP_DIM, 2, DegreeFadType<4> >;
+template class SplitFormNumFlux<PHILIP_DIM, 3, DegreeFadType<4> >;
+template class SplitFormNumFlux<PHILIP_DIM, 4, DegreeFadType<4> >;
+template class SplitFormNumFlux<PHILIP_DIM, 5, DegreeFadType<4> >;
+template class SplitFormNumFlux<PHILIP_DIM, 1, DirectionalFadType >;
+template class SplitFormNumFlux<PHILIP_DIM, 2, DirectionalFadType >;
+template class SplitFormNumFlux<PHILIP_DIM, 3, DirectionalFadType >;
+template class SplitFormNumFlux<PHILIP_DIM, 4, DirectionalFadType >;
+template class SplitFormNumFlux<PHILIP_DIM, 5, DirectionalFadType >;
 template class SplitFormNumFlux<PHILIP_DIM, 1, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class SplitFormNumFlux<PHILIP_DIM, 2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class SplitFormNumFlux<PHILIP_DIM, 3, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
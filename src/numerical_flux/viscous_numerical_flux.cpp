@@ -1,5 +1,6 @@
 #include <Sacado.hpp>
 #include <deal.II/differentiation/ad/sacado_product_types.h>
+#include "ad_types.hpp"
 #include "viscous_numerical_flux.h"
 
 namespace PHiLiP {
@@ -238,6 +239,31 @@ template class NumericalFluxDissipative<PHILIP_DIM, 2, Sacado::Fad::DFad<double>
 template class NumericalFluxDissipative<PHILIP_DIM, 3, Sacado::Fad::DFad<double> >;
 template class NumericalFluxDissipative<PHILIP_DIM, 4, Sacado::Fad::DFad<double> >;
 template class NumericalFluxDissipative<PHILIP_DIM, 5, Sacado::Fad::DFad<double> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 1, StaticFadType >;
+template class NumericalFluxDissipative<PHILIP_DIM, 2, StaticFadType >;
+template class NumericalFluxDissipative<PHILIP_DIM, 3, StaticFadType >;
+template class NumericalFluxDissipative<PHILIP_DIM, 4, StaticFadType >;
+template class NumericalFluxDissipative<PHILIP_DIM, 5, StaticFadType >;
+template class NumericalFluxDissipative<PHILIP_DIM, 1, DegreeFadType<2> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 2, DegreeFadType<2> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 3, DegreeFadType<2> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 4, DegreeFadType<2> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 5, DegreeFadType<2> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 1, DegreeFadType<3> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 2, DegreeFadType<3> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 3, DegreeFadType<3> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 4, DegreeFadType<3> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 5, DegreeFadType<3> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 1, DegreeFadType<4> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 2, DegreeFadType<4> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 3, DegreeFadType<4> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 4, DegreeFadType<4> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 5, DegreeFadType<4> >;
+template class NumericalFluxDissipative<PHILIP_DIM, 1, DirectionalFadType >;
+template class NumericalFluxDissipative<PHILIP_DIM, 2, DirectionalFadType >;
+template class NumericalFluxDissipative<PHILIP_DIM, 3, DirectionalFadType >;
+template class NumericalFluxDissipative<PHILIP_DIM, 4, DirectionalFadType >;
+template class NumericalFluxDissipative<PHILIP_DIM, 5, DirectionalFadType >;
 template class NumericalFluxDissipative<PHILIP_DIM, 1, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class NumericalFluxDissipative<PHILIP_DIM, 2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class NumericalFluxDissipative<PHILIP_DIM, 3, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
@@ -260,6 +286,31 @@ template class SymmetricInternalPenalty<PHILIP_DIM, 2, Sacado::Fad::DFad<double>
 template class SymmetricInternalPenalty<PHILIP_DIM, 3, Sacado::Fad::DFad<double> >;
 template class SymmetricInternalPenalty<PHILIP_DIM, 4, Sacado::Fad::DFad<double> >;
 template class SymmetricInternalPenalty<PHILIP_DIM, 5, Sacado::Fad::DFad<double> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 1, StaticFadType >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 2, StaticFadType >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 3, StaticFadType >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 4, StaticFadType >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 5, StaticFadType >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 1, DegreeFadType<2> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 2, DegreeFadType<2> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 3, DegreeFadType<2> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 4, DegreeFadType<2> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 5, DegreeFadType<2> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 1, DegreeFadType<3> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 2, DegreeFadType<3> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 3, DegreeFadType<3> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 4, DegreeFadType<3> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 5, DegreeFadType<3> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 1, DegreeFadType<4> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 2, DegreeFadType<4> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 3, DegreeFadType<4> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 4, DegreeFadType<4> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 5, DegreeFadType<4> >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 1, DirectionalFadType >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 2, DirectionalFadType >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 3, DirectionalFadType >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 4, DirectionalFadType >;
+template class SymmetricInternalPenalty<PHILIP_DIM, 5, DirectionalFadType >;
 template class SymmetricInternalPenalty<PHILIP_DIM, 1, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class SymmetricInternalPenalty<PHILIP_DIM, 2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class SymmetricInternalPenalty<PHILIP_DIM, 3, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
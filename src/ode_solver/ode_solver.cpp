@@ -1,8 +1,11 @@
+#include <chrono>
+
 #include <deal.II/distributed/solution_transfer.h>
 
 #include "ode_solver.h"
 
 #include "linear_solver/linear_solver.h"
+#include "wall_clock.hpp"
 
 namespace PHiLiP {
 namespace ODE {
@@ -10,12 +13,33 @@ namespace ODE {
 template <int dim, typename real>
 ODESolver<dim,real>::ODESolver(std::shared_ptr< DGBase<dim, real> > dg_input)
     : current_time(0.0)
+    , local_time_stepping_active(false)
+    , multirate_active(false)
     , dg(dg_input)
     , all_parameters(dg->all_parameters)
     , mpi_communicator(MPI_COMM_WORLD)
     , pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(mpi_communicator)==0)
 {}
 
+template <int dim, typename real>
+double ODESolver<dim,real>::cell_stable_time_step (const typename dealii::DoFHandler<dim>::active_cell_iterator &cell) const
+{
+    const unsigned int poly_degree = cell->get_fe().tensor_degree();
+    return dg->max_dt_cell[cell->active_cell_index()] / (2.0*poly_degree + 1.0);
+}
+
+template <int dim, typename real>
+double ODESolver<dim,real>::evaluate_stable_time_step (const double courant_number) const
+{
+    double min_dt = std::numeric_limits<double>::max();
+    for (auto cell = dg->dof_handler.begin_active(); cell!=dg->dof_handler.end(); ++cell) {
+        if (!cell->is_locally_owned()) continue;
+        min_dt = std::min(min_dt, cell_stable_time_step(cell));
+    }
+    // Every processor must take the same time step.
+    return courant_number * dealii::Utilities::MPI::min(min_dt, mpi_communicator);
+}
+
 template <int dim, typename real>
 void ODESolver<dim,real>::initialize_steady_polynomial_ramping (const unsigned int global_final_poly_degree)
 {
@@ -42,8 +66,8 @@ void ODESolver<dim,real>::initialize_steady_polynomial_ramping (const unsigned i
         dg->allocate_system ();
 
         //old_solution.print(pcout.get_stream());
-        dg->solution.zero_out_ghosts();
-        solution_transfer.interpolate(dg->solution);
+        dg->modify_solution().zero_out_ghosts();
+        solution_transfer.interpolate(dg->modify_solution());
         dg->solution.update_ghost_values();
         //dg->solution.print(pcout.get_stream());
 
@@ -62,6 +86,9 @@ int ODESolver<dim,real>::steady_state ()
 {
     Parameters::ODESolverParam ode_param = ODESolver<dim,real>::all_parameters->ode_solver_param;
     pcout << " Performing steady state analysis... " << std::endl;
+    local_time_stepping_active = ode_param.local_time_stepping
+                                 && ode_param.ode_solver_type == Parameters::ODESolverParam::ODESolverEnum::explicit_solver;
+    multirate_active = false;
     allocate_ode_system ();
 
     this->residual_norm_decrease = 1; // Always do at least 1 iteration
@@ -105,9 +132,15 @@ int ODESolver<dim,real>::steady_state ()
             pcout << " Evaluating right-hand side and setting system_matrix to Jacobian... " << std::endl;
         }
 
-        double dt = std::max(CFL,all_parameters->ode_solver_param.initial_time_step);
-        dt *= pow((1.0-std::log10(this->residual_norm_decrease)*ode_param.time_step_factor_residual), ode_param.time_step_factor_residual_exp);
-        dt = std::max(dt,CFL);
+        double dt;
+        if (local_time_stepping_active) {
+            // Each cell is advanced at the courant_number, see Explicit_ODESolver::evaluate_local_time_step_ratio().
+            dt = evaluate_stable_time_step(ode_param.courant_number);
+        } else {
+            dt = std::max(CFL,all_parameters->ode_solver_param.initial_time_step);
+            dt *= pow((1.0-std::log10(this->residual_norm_decrease)*ode_param.time_step_factor_residual), ode_param.time_step_factor_residual_exp);
+            dt = std::max(dt,CFL);
+        }
         pcout << "CFL = " << CFL << " Time step = " << dt << std::endl;
 
         step_in_time(dt);
@@ -127,6 +160,8 @@ int ODESolver<dim,real>::steady_state ()
         }
     }
 
+    print_solver_statistics();
+
     pcout << " ********************************************************** "
           << std::endl
           << " ODESolver steady_state stopped at"
@@ -145,12 +180,24 @@ int ODESolver<dim,real>::advance_solution_time (double time_advance)
 {
     Parameters::ODESolverParam ode_param = ODESolver<dim,real>::all_parameters->ode_solver_param;
 
+    // Local time steps are not time-accurate, unlike the substeps of the multirate steps.
+    local_time_stepping_active = false;
+    multirate_active = ode_param.multirate_time_step_ratio > 1
+                       && ode_param.ode_solver_type == Parameters::ODESolverParam::ODESolverEnum::explicit_solver;
+
+    const bool adaptive_time_step = ode_param.adaptive_time_step;
     const unsigned int number_of_time_steps = static_cast<int>(ceil(time_advance/ode_param.initial_time_step));
     const double constant_time_step = time_advance/number_of_time_steps;
 
-    pcout
-        << " Advancing solution by " << time_advance << " time units, using "
-        << number_of_time_steps << " iterations of size dt=" << constant_time_step << " ... " << std::endl;
+    if (adaptive_time_step) {
+        pcout
+            << " Advancing solution by " << time_advance << " time units, using adaptive time steps"
+            << " at a Courant number of " << ode_param.courant_number << " ... " << std::endl;
+    } else {
+        pcout
+            << " Advancing solution by " << time_advance << " time units, using "
+            << number_of_time_steps << " iterations of size dt=" << constant_time_step << " ... " << std::endl;
+    }
     allocate_ode_system ();
 
     this->current_iteration = 0;
@@ -158,15 +205,20 @@ int ODESolver<dim,real>::advance_solution_time (double time_advance)
     // Output initial solution
     this->dg->output_results_vtk(this->current_iteration);
 
-    while (this->current_iteration < number_of_time_steps)
+    double time_advanced = 0.0;
+    bool final_time_reached = (time_advance <= 0.0);
+    while (adaptive_time_step ? !final_time_reached : this->current_iteration < number_of_time_steps)
     {
         if ((ode_param.ode_output) == Parameters::OutputEnum::verbose &&
             (this->current_iteration%ode_param.print_iteration_modulo) == 0 ) {
         pcout << " ********************************************************** "
               << std::endl
-              << " Iteration: " << this->current_iteration + 1
-              << " out of: " << number_of_time_steps
-              << std::endl;
+              << " Iteration: " << this->current_iteration + 1;
+        if (adaptive_time_step) {
+            pcout << " at time: " << time_advanced << " out of: " << time_advance << std::endl;
+        } else {
+            pcout << " out of: " << number_of_time_steps << std::endl;
+        }
     }
         dg->assemble_residual(false);
 
@@ -175,7 +227,26 @@ int ODESolver<dim,real>::advance_solution_time (double time_advance)
         pcout << " Evaluating right-hand side and setting system_matrix to Jacobian... " << std::endl;
     }
 
-        step_in_time(constant_time_step);
+        double dt = constant_time_step;
+        if (adaptive_time_step) {
+            // The wave speeds of the assembly above give the stable time step of the current solution.
+            dt = evaluate_stable_time_step(ode_param.courant_number);
+            // The cells that are not stable at this step are advanced with substeps.
+            if (multirate_active) dt *= ode_param.multirate_time_step_ratio;
+            const double remaining_time = time_advance - time_advanced;
+            // Ends exactly at the final time instead of taking a last step of the size of the round-off.
+            if (dt >= remaining_time - 1e-12*time_advance) {
+                dt = remaining_time;
+                final_time_reached = true;
+            }
+            if ((ode_param.ode_output) == Parameters::OutputEnum::verbose &&
+                (this->current_iteration%ode_param.print_iteration_modulo) == 0 ) {
+                pcout << " Time step = " << dt << std::endl;
+            }
+        }
+
+        step_in_time(dt);
+        time_advanced += dt;
 
 
     if (this->current_iteration%ode_param.print_iteration_modulo == 0) {
@@ -192,35 +263,283 @@ int ODESolver<dim,real>::advance_solution_time (double time_advance)
 template <int dim, typename real>
 void Implicit_ODESolver<dim,real>::step_in_time (real dt)
 {
-    const bool compute_dRdW = true;
-    this->dg->assemble_residual(compute_dRdW);
-    this->current_time += dt;
-    // Solve (M/dt - dRdW) dw = R
-    // w = w + dw
-    Parameters::ODESolverParam ode_param = ODESolver<dim,real>::all_parameters->ode_solver_param;
-
-    this->dg->system_matrix *= -1.0;
+    if (this->all_parameters->ode_solver_param.jacobian_free_newton_krylov) {
+        step_in_time_jacobian_free(dt);
+        return;
+    }
 
-    //this->dg->add_mass_matrices(1.0/dt);
-    const double dt_scale = dt;
-    this->dg->time_scaled_mass_matrices(dt_scale);
-    this->dg->add_time_scaled_mass_matrices();
+    const Parameters::ODESolverParam &ode_param = this->all_parameters->ode_solver_param;
+    const Parameters::LinearSolverParam &linear_param = this->all_parameters->linear_solver_param;
+    last_step_timings = StepTimings();
+
+    const bool update_linearization = linearization_update_is_requested();
+
+    // The right-hand side is already evaluated at the current solution.
+    // Otherwise, the last system_matrix is reused for a chord step.
+    const bool update_jacobian = steps_since_jacobian_update == 0
+                                 || steps_since_jacobian_update >= ode_param.jacobian_update_frequency
+                                 || update_linearization;
+    if (update_jacobian) {
+        auto start = std::chrono::steady_clock::now();
+        const bool compute_dRdW = true;
+        this->dg->assemble_residual(compute_dRdW);
+        // Solve (M/dt - dRdW) dw = R
+        // w = w + dw
+        this->dg->system_matrix *= -1.0;
+        this->dg->mark_system_matrix_modified();
+        last_step_timings.assembly = seconds_since(start);
+
+        //this->dg->add_mass_matrices(1.0/dt);
+        start = std::chrono::steady_clock::now();
+        const double dt_scale = dt;
+        this->dg->time_scaled_mass_matrices(dt_scale);
+        this->dg->add_time_scaled_mass_matrices();
+        last_step_timings.mass_matrix = seconds_since(start);
+
+        steps_since_jacobian_update = 0;
+        ++n_jacobian_updates;
+    } else if (ode_param.ode_output == Parameters::OutputEnum::verbose) {
+        pcout << " Reusing the system_matrix assembled " << steps_since_jacobian_update << " steps ago... " << std::endl;
+    }
+    ++steps_since_jacobian_update;
+    this->current_time += dt;
 
     if ((ode_param.ode_output) == Parameters::OutputEnum::verbose &&
         (this->current_iteration%ode_param.print_iteration_modulo) == 0 ) {
         pcout << " Evaluating system update... " << std::endl;
     }
 
-    solve_linear (
+    // The factorization is kept for the chord steps reusing the system_matrix. GMRES may also keep
+    // its preconditioner for preconditioner_update_frequency steps while the system_matrix changes.
+    const bool reuse_preconditioner = ode_param.preconditioner_update_frequency > 1
+                                      && linear_param.linear_solver_type == Parameters::LinearSolverParam::LinearSolverEnum::gmres;
+    const bool factorize_matrix = reuse_preconditioner
+                                  ? (steps_since_preconditioner_update >= ode_param.preconditioner_update_frequency || update_linearization)
+                                  : update_jacobian;
+    // The states are coarsened together by the algebraic multigrid.
+    const bool use_amg = linear_param.preconditioner_type == Parameters::LinearSolverParam::PreconditionerEnum::amg;
+    last_step_timings.linear_iterations = linear_solver.solve (
         this->dg->system_matrix,
         this->dg->right_hand_side, 
         this->solution_update,
-        this->ODESolver<dim,real>::all_parameters->linear_solver_param);
+        linear_param,
+        use_amg ? this->dg->get_constant_modes() : std::vector<std::vector<bool>>(),
+        factorize_matrix).first;
+    record_linear_solve ();
 
     //this->dg->solution += this->solution_update;
+    const auto start = std::chrono::steady_clock::now();
+    linesearch();
+    last_step_timings.linesearch = seconds_since(start);
+
+    this->update_norm = this->solution_update.l2_norm();
+
+    record_step_timings();
+}
+
+template <int dim, typename real>
+void Implicit_ODESolver<dim,real>::step_in_time_jacobian_free (real dt)
+{
+    const Parameters::ODESolverParam &ode_param = this->all_parameters->ode_solver_param;
+    const Parameters::LinearSolverParam &linear_param = this->all_parameters->linear_solver_param;
+    last_step_timings = StepTimings();
+
+    const bool update_linearization = linearization_update_is_requested();
+
+    const bool update_jacobian = lagged_jacobian.m() != this->dg->system_matrix.m()
+                                 || steps_since_jacobian_update >= ode_param.jfnk_preconditioner_update_frequency
+                                 || update_linearization;
+    auto start = std::chrono::steady_clock::now();
+    if (update_jacobian && preconditioner_dg) {
+        if ((ode_param.ode_output) == Parameters::OutputEnum::verbose) {
+            pcout << " Assembling the dRdW of the preconditioner with the Lax-Friedrichs flux... " << std::endl;
+        }
+        this->dg->assemble_residual();
+        update_preconditioner_dg_state();
+        const bool compute_dRdW = true;
+        preconditioner_dg->assemble_residual(compute_dRdW);
+        lagged_jacobian.copy_from(preconditioner_dg->system_matrix);
+        lagged_jacobian *= -1.0;
+        steps_since_jacobian_update = 0;
+        ++n_jacobian_updates;
+    } else if (update_jacobian) {
+        if ((ode_param.ode_output) == Parameters::OutputEnum::verbose) {
+            pcout << " Assembling the dRdW of the preconditioner... " << std::endl;
+        }
+        const bool compute_dRdW = true;
+        this->dg->assemble_residual(compute_dRdW);
+        lagged_jacobian.copy_from(this->dg->system_matrix);
+        lagged_jacobian *= -1.0;
+        steps_since_jacobian_update = 0;
+        ++n_jacobian_updates;
+    } else {
+        // Evaluates the residual and the cell time steps at the current solution.
+        // The dRdW assembly above already evaluated them.
+        this->dg->assemble_residual();
+    }
+    ++steps_since_jacobian_update;
+    last_step_timings.assembly = seconds_since(start);
+    this->current_time += dt;
+
+    // Solve (M/dt - dRdW) dw = R
+    start = std::chrono::steady_clock::now();
+    const double dt_scale = dt;
+    this->dg->time_scaled_mass_matrices(dt_scale);
+    // The matrix-free operator is always linearized about the current solution.
+    matrix_free_jacobian->set_operator_scaling(-1.0, &(this->dg->time_scaled_global_mass_matrix));
+    last_step_timings.mass_matrix = seconds_since(start);
+
+    // A new lagged_jacobian is always factorized.
+    const bool reuse_preconditioner = ode_param.preconditioner_update_frequency > 1;
+    const bool factorize_matrix = !reuse_preconditioner
+                                  || steps_since_preconditioner_update >= ode_param.preconditioner_update_frequency
+                                  || update_jacobian;
+    if (factorize_matrix) {
+        start = std::chrono::steady_clock::now();
+        // Same sparsity, such that the LinearSolver keeps its setup.
+        preconditioner_matrix.copy_from(lagged_jacobian);
+        preconditioner_matrix.add(1.0, this->dg->time_scaled_global_mass_matrix);
+        last_step_timings.mass_matrix += seconds_since(start);
+    }
+
+    if ((ode_param.ode_output) == Parameters::OutputEnum::verbose &&
+        (this->current_iteration%ode_param.print_iteration_modulo) == 0 ) {
+        pcout << " Evaluating system update with the Jacobian-free operator... " << std::endl;
+    }
+
+    // The states are coarsened together by the algebraic multigrid.
+    const bool use_amg = linear_param.preconditioner_type == Parameters::LinearSolverParam::PreconditionerEnum::amg;
+    last_step_timings.linear_iterations = linear_solver.solve (
+        *matrix_free_jacobian,
+        preconditioner_matrix,
+        this->dg->right_hand_side,
+        this->solution_update,
+        linear_param,
+        use_amg ? this->dg->get_constant_modes() : std::vector<std::vector<bool>>(),
+        factorize_matrix).first;
+    record_linear_solve ();
+
+    start = std::chrono::steady_clock::now();
     linesearch();
+    last_step_timings.linesearch = seconds_since(start);
 
     this->update_norm = this->solution_update.l2_norm();
+
+    record_step_timings();
+}
+
+template <int dim, typename real>
+bool Implicit_ODESolver<dim,real>::linearization_is_reused () const
+{
+    const Parameters::ODESolverParam &ode_param = this->all_parameters->ode_solver_param;
+    const bool reuse_jacobian = ode_param.jacobian_free_newton_krylov
+                                ? ode_param.jfnk_preconditioner_update_frequency > 1
+                                : ode_param.jacobian_update_frequency > 1;
+    return reuse_jacobian || ode_param.preconditioner_update_frequency > 1;
+}
+
+template <int dim, typename real>
+bool Implicit_ODESolver<dim,real>::linearization_update_is_requested ()
+{
+    if (!linearization_is_reused()) return false;
+
+    const Parameters::ODESolverParam &ode_param = this->all_parameters->ode_solver_param;
+
+    // The right-hand side holds the residual of the current solution.
+    const double residual_norm = this->dg->get_residual_l2norm();
+    const bool residual_stagnated = residual_norm > ode_param.linearization_update_residual_ratio * previous_step_residual_norm;
+    previous_step_residual_norm = residual_norm;
+
+    const bool update_requested = residual_stagnated || linearization_update_requested;
+    if (update_requested && ode_param.ode_output == Parameters::OutputEnum::verbose) {
+        pcout << " Updating the reused linearization since "
+              << (residual_stagnated ? "the residual stagnated." : "the linear iterations increased.") << std::endl;
+    }
+    linearization_update_requested = false;
+    return update_requested;
+}
+
+template <int dim, typename real>
+void Implicit_ODESolver<dim,real>::update_preconditioner_dg_state ()
+{
+    AssertDimension(preconditioner_dg->solution.size(), this->dg->solution.size());
+    if (preconditioner_dg_volume_nodes_version != this->dg->high_order_grid.get_volume_nodes_version()) {
+        preconditioner_dg->high_order_grid.set_volume_nodes(this->dg->high_order_grid.volume_nodes);
+        preconditioner_dg_volume_nodes_version = this->dg->high_order_grid.get_volume_nodes_version();
+    }
+    // Same cells and degrees, such that the degrees of freedom are numbered alike.
+    preconditioner_dg->set_solution(this->dg->solution);
+}
+
+template <int dim, typename real>
+void Implicit_ODESolver<dim,real>::record_linear_solve ()
+{
+    const LinearSolver::Statistics &statistics = linear_solver.last_statistics();
+    last_step_timings.preconditioner = statistics.setup_time + statistics.factorization_time;
+    last_step_timings.linear_solve = statistics.iteration_time;
+
+    const bool factorized = statistics.n_factorizations > 0;
+    if (factorized) {
+        steps_since_preconditioner_update = 0;
+        ++n_preconditioner_updates;
+    }
+    ++steps_since_preconditioner_update;
+    monitor_linear_iterations (last_step_timings.linear_iterations, factorized);
+}
+
+template <int dim, typename real>
+void Implicit_ODESolver<dim,real>::monitor_linear_iterations (const unsigned int n_linear_iterations, const bool preconditioner_was_updated)
+{
+    if (preconditioner_was_updated) {
+        reference_linear_iterations = std::max(n_linear_iterations, 1u);
+        return;
+    }
+    const double ratio = this->all_parameters->ode_solver_param.linearization_update_linear_iterations_ratio;
+    if (n_linear_iterations > ratio * reference_linear_iterations) linearization_update_requested = true;
+}
+
+template <int dim, typename real>
+void Implicit_ODESolver<dim,real>::record_step_timings ()
+{
+    total_step_timings.assembly += last_step_timings.assembly;
+    total_step_timings.mass_matrix += last_step_timings.mass_matrix;
+    total_step_timings.preconditioner += last_step_timings.preconditioner;
+    total_step_timings.linear_solve += last_step_timings.linear_solve;
+    total_step_timings.linesearch += last_step_timings.linesearch;
+    total_step_timings.linear_iterations += last_step_timings.linear_iterations;
+
+    const Parameters::ODESolverParam &ode_param = this->all_parameters->ode_solver_param;
+    if ((ode_param.ode_output) == Parameters::OutputEnum::verbose &&
+        (this->current_iteration%ode_param.print_iteration_modulo) == 0 ) {
+        pcout << " Step wall times (s):"
+              << " assembly " << last_step_timings.assembly
+              << " mass matrix " << last_step_timings.mass_matrix
+              << " preconditioner " << last_step_timings.preconditioner
+              << " linear solve " << last_step_timings.linear_solve
+              << " (" << last_step_timings.linear_iterations << " iterations)"
+              << " linesearch " << last_step_timings.linesearch
+              << std::endl;
+    }
+}
+
+template <int dim, typename real>
+void Implicit_ODESolver<dim,real>::print_solver_statistics () const
+{
+    pcout << " Implicit steps took " << n_jacobian_updates << " dRdW assemblies, "
+          << n_preconditioner_updates << " factorizations and "
+          << total_step_timings.linear_iterations << " linear iterations." << std::endl
+          << " Total wall times (s):"
+          << " assembly " << total_step_timings.assembly
+          << " mass matrix " << total_step_timings.mass_matrix
+          << " preconditioner " << total_step_timings.preconditioner
+          << " linear solve " << total_step_timings.linear_solve
+          << " linesearch " << total_step_timings.linesearch
+          << std::endl;
+    const LinearSolver::Statistics &linear_statistics = linear_solver.total_statistics();
+    if (linear_statistics.n_solves > 0) {
+        pcout << " The linear solver set up " << linear_statistics.n_setups << " times for "
+              << linear_statistics.n_solves << " solves." << std::endl;
+    }
 }
 
 template <int dim, typename real>
@@ -235,7 +554,7 @@ double Implicit_ODESolver<dim,real>::linesearch ()
 
     const double initial_residual = this->dg->get_residual_l2norm();
 
-    this->dg->solution.add(step_length, this->solution_update);
+    this->dg->modify_solution().add(step_length, this->solution_update);
     this->dg->assemble_residual ();
     double new_residual = this->dg->get_residual_l2norm();
 
@@ -243,8 +562,8 @@ double Implicit_ODESolver<dim,real>::linesearch ()
     for (iline = 0; iline < maxline && new_residual > initial_residual; ++iline) {
         pcout << " Step length " << step_length << " did not reduce residual. Old residual: " << initial_residual << " New residual: " << new_residual << std::endl;
         step_length = step_length * step_reduction;
-        this->dg->solution = old_solution;
-        this->dg->solution.add(step_length, this->solution_update);
+        this->dg->modify_solution() = old_solution;
+        this->dg->modify_solution().add(step_length, this->solution_update);
         this->dg->assemble_residual ();
         new_residual = this->dg->get_residual_l2norm();
     }
@@ -256,14 +575,14 @@ double Implicit_ODESolver<dim,real>::linesearch ()
     if (iline == maxline) {
         step_length = 1.0;
         pcout << " Step length " << step_length << " accepting any give valid residual. Old residual: " << initial_residual << std::endl;
-        this->dg->solution.add(step_length, this->solution_update);
+        this->dg->modify_solution().add(step_length, this->solution_update);
         this->dg->assemble_residual ();
         new_residual = this->dg->get_residual_l2norm();
         for (iline = 0; iline < maxline && new_residual > initial_residual * reduction_tolerance ; ++iline) {
             pcout << " Step length " << step_length << " did not give valid residual. Old residual: " << initial_residual << " New residual: " << new_residual << std::endl;
             step_length = step_length * step_reduction;
-            this->dg->solution = old_solution;
-            this->dg->solution.add(step_length, this->solution_update);
+            this->dg->modify_solution() = old_solution;
+            this->dg->modify_solution().add(step_length, this->solution_update);
             this->dg->assemble_residual ();
             new_residual = this->dg->get_residual_l2norm();
         }
@@ -277,21 +596,21 @@ double Implicit_ODESolver<dim,real>::linesearch ()
         for (iline = 0; iline < maxline && new_residual > initial_residual; ++iline) {
             pcout << " Step length " << step_length << " did not reduce residual. Old residual: " << initial_residual << " New residual: " << new_residual << std::endl;
             step_length = step_length * step_reduction;
-            this->dg->solution = old_solution;
-            this->dg->solution.add(step_length, this->solution_update);
+            this->dg->modify_solution() = old_solution;
+            this->dg->modify_solution().add(step_length, this->solution_update);
             this->dg->assemble_residual ();
             new_residual = this->dg->get_residual_l2norm();
         }
         if (iline == maxline) {
             step_length = 1.0;
-            this->dg->solution.add(step_length, this->solution_update);
+            this->dg->modify_solution().add(step_length, this->solution_update);
             this->dg->assemble_residual ();
             new_residual = this->dg->get_residual_l2norm();
             for (iline = 0; iline < maxline && new_residual > initial_residual * reduction_tolerance ; ++iline) {
                 pcout << " Step length " << step_length << " did not give valid residual. Old residual: " << initial_residual << " New residual: " << new_residual << std::endl;
                 step_length = step_length * step_reduction;
-                this->dg->solution = old_solution;
-                this->dg->solution.add(step_length, this->solution_update);
+                this->dg->modify_solution() = old_solution;
+                this->dg->modify_solution().add(step_length, this->solution_update);
                 this->dg->assemble_residual ();
                 new_residual = this->dg->get_residual_l2norm();
             }
@@ -303,55 +622,237 @@ double Implicit_ODESolver<dim,real>::linesearch ()
     return step_length;
 }
 
+template <int dim, typename real>
+void Explicit_ODESolver<dim,real>::evaluate_local_time_step_ratio (const double dt)
+{
+    const double courant_number = this->all_parameters->ode_solver_param.courant_number;
+    std::vector<dealii::types::global_dof_index> dofs_indices;
+    for (auto cell = this->dg->dof_handler.begin_active(); cell!=this->dg->dof_handler.end(); ++cell) {
+        if (!cell->is_locally_owned()) continue;
+        dofs_indices.resize(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices (dofs_indices);
+        const double ratio = courant_number * this->cell_stable_time_step(cell) / dt;
+        for (const auto &idof : dofs_indices) {
+            local_time_step_ratio[idof] = ratio;
+        }
+    }
+}
+
+template <int dim, typename real>
+void Explicit_ODESolver<dim,real>::add_inverse_mass_residual (
+    dealii::LinearAlgebra::distributed::Vector<double> &register_vector,
+    const double register_scaling,
+    const double residual_scaling)
+{
+    const dealii::LinearAlgebra::distributed::Vector<double> *residual = &(this->dg->right_hand_side);
+    if (this->local_time_stepping_active && residual_scaling != 0.0) {
+        local_time_step_residual = this->dg->right_hand_side;
+        local_time_step_residual.scale(local_time_step_ratio);
+        residual = &local_time_step_residual;
+    }
+    if (residual_scaling == 0.0) {
+        register_vector *= register_scaling;
+    } else if (register_scaling == 0.0) {
+        this->dg->apply_inverse_mass_matrix(*residual, register_vector);
+        register_vector *= residual_scaling;
+    } else {
+        register_vector *= register_scaling / residual_scaling;
+        const bool add_to_register = true;
+        this->dg->apply_inverse_mass_matrix(*residual, register_vector, add_to_register);
+        register_vector *= residual_scaling;
+    }
+}
+
 template <int dim, typename real>
 void Explicit_ODESolver<dim,real>::step_in_time (real dt)
 {
     // this->dg->assemble_residual (); // Not needed since it is called in the base class for time step
     this->current_time += dt;
-    const int rk_order = 1;
-    if (rk_order == 1) {
-        this->dg->global_inverse_mass_matrix.vmult(this->solution_update, this->dg->right_hand_side);
-        this->update_norm = this->solution_update.l2_norm();
-        this->dg->solution.add(dt,this->solution_update);
-    } else if (rk_order == 3) {
-        // Stage 0
-        this->rk_stage[0] = this->dg->solution;
-
-        // Stage 1
-        pcout<< "Stage 1... " << std::flush;
-        this->dg->global_inverse_mass_matrix.vmult(this->solution_update, this->dg->right_hand_side);
-
-        this->rk_stage[1] = this->rk_stage[0];
-        this->rk_stage[1].add(dt,this->solution_update);
-
-        this->dg->solution = this->rk_stage[1];
-
-        // Stage 2
-        pcout<< "2... " << std::flush;
-        this->dg->assemble_residual ();
-        this->dg->global_inverse_mass_matrix.vmult(this->solution_update, this->dg->right_hand_side);
+    if (this->multirate_active) {
+        step_in_time_multirate (dt);
+        return;
+    }
+    // The local time steps are frozen over the step, from the wave speeds of its initial solution.
+    if (this->local_time_stepping_active) evaluate_local_time_step_ratio (dt);
+
+    const RungeKuttaTableau &rk = runge_kutta_tableau;
+    const unsigned int n_stages = rk.n_stages();
+    if (rk.is_low_storage()) {
+        // The solution_update holds the 2N-storage update.
+        for (unsigned int istage = 0; istage < n_stages; ++istage) {
+            if (istage > 0) this->dg->assemble_residual ();
+            add_inverse_mass_residual (this->solution_update, rk.low_storage_A[istage], dt);
+            // Time derivative at the beginning of the step, which is all there is to forward Euler.
+            if (istage == 0) this->update_norm = this->solution_update.l2_norm() / dt;
+            this->dg->modify_solution().add(rk.low_storage_B[istage], this->solution_update);
+        }
+    } else {
+        // The solution_update accumulates the next solution, while the solution holds the stages.
+        rk_initial_solution = this->dg->solution;
+        this->solution_update = this->dg->solution;
+        for (unsigned int istage = 0; istage < n_stages; ++istage) {
+            if (istage > 0) this->dg->assemble_residual ();
+            add_inverse_mass_residual (this->solution_update, 1.0, dt*rk.b[istage]);
+            if (istage+1 == n_stages) break;
+
+            const double initial_weight = rk.initial_solution_weight[istage];
+            if (initial_weight != 0.0) this->dg->modify_solution().sadd(1.0-initial_weight, initial_weight, rk_initial_solution);
+            add_inverse_mass_residual (this->dg->modify_solution(), 1.0, dt*rk.a[istage+1][istage]);
+            this->dg->solution.update_ghost_values();
+        }
+        // Average time derivative over the step.
+        rk_initial_solution.sadd(-1.0, 1.0, this->solution_update);
+        this->update_norm = rk_initial_solution.l2_norm() / dt;
+
+        this->dg->set_solution(this->solution_update);
+    }
+    this->dg->solution.update_ghost_values();
+}
+
+template <int dim, typename real>
+void Explicit_ODESolver<dim,real>::evaluate_multirate_cells (const double dt)
+{
+    const double courant_number = this->all_parameters->ode_solver_param.courant_number;
+    const dealii::DoFHandler<dim> &dof_handler = this->dg->dof_handler;
+    std::vector<dealii::types::global_dof_index> dofs_indices;
+
+    multirate_fast_dofs = 0.0;
+    for (auto cell = dof_handler.begin_active(); cell!=dof_handler.end(); ++cell) {
+        if (!cell->is_locally_owned()) continue;
+        if (courant_number * this->cell_stable_time_step(cell) >= dt) continue;
+        dofs_indices.resize(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices (dofs_indices);
+        for (const auto &idof : dofs_indices) {
+            multirate_fast_dofs[idof] = 1.0;
+        }
+    }
+    // The ghost values flag the fast cells of the other processors.
+    multirate_fast_dofs.update_ghost_values();
 
-        this->rk_stage[2] = this->rk_stage[0];
-        this->rk_stage[2] *= 0.75;
-        this->rk_stage[2].add(0.25, this->rk_stage[1]);
-        this->rk_stage[2].add(0.25*dt, this->solution_update);
+    const auto cell_is_fast = [&] (const typename dealii::DoFHandler<dim>::cell_iterator &cell)
+    {
+        dofs_indices.resize(cell->get_fe().n_dofs_per_cell());
+        cell->get_dof_indices (dofs_indices);
+        return multirate_fast_dofs[dofs_indices[0]] != 0.0;
+    };
+
+    // The faces of a fast cell might be assembled by its neighbours, which are therefore also assembled.
+    const bool periodic_1D = (dim == 1) && this->all_parameters->use_periodic_bc;
+    multirate_assembled_cells.assign(this->dg->triangulation->n_active_cells(), false);
+    for (auto cell = dof_handler.begin_active(); cell!=dof_handler.end(); ++cell) {
+        if (!cell->is_locally_owned()) continue;
+        bool assembled = cell_is_fast(cell);
+        for (unsigned int iface = 0; iface < dealii::GeometryInfo<dim>::faces_per_cell && !assembled; ++iface) {
+            const bool periodic = cell->has_periodic_neighbor(iface);
+            if (cell->face(iface)->at_boundary() && !periodic) {
+                // The 1D periodic faces couple the first and last cells, see DGBase::assemble_cell_residual().
+                assembled = periodic_1D;
+                continue;
+            }
+            auto neighbor = periodic ? cell->periodic_neighbor(iface) : cell->neighbor(iface);
+            if (!neighbor->has_children()) {
+                assembled = cell_is_fast(neighbor);
+            } else if (dim == 1) {
+                // The 1D faces have no children. The active neighbour is the child next to the face.
+                while (neighbor->has_children()) neighbor = neighbor->child(1-iface);
+                assembled = cell_is_fast(neighbor);
+            } else {
+                for (unsigned int isubface = 0; isubface < cell->face(iface)->n_children() && !assembled; ++isubface) {
+                    assembled = cell_is_fast(periodic ? cell->periodic_neighbor_child_on_subface(iface, isubface)
+                                                      : cell->neighbor_child_on_subface(iface, isubface));
+                }
+            }
+        }
+        multirate_assembled_cells[cell->active_cell_index()] = assembled;
+    }
+}
 
-        this->dg->solution = this->rk_stage[2];
+template <int dim, typename real>
+void Explicit_ODESolver<dim,real>::set_fast_dofs (
+    const dealii::LinearAlgebra::distributed::Vector<double> &fast_values,
+    dealii::LinearAlgebra::distributed::Vector<double> &values)
+{
+    multirate_work = fast_values;
+    multirate_work -= values;
+    multirate_work.scale(multirate_fast_dofs);
+    values += multirate_work;
+}
 
-        // Stage 3
-        pcout<< "3... " << std::flush;
-        this->dg->assemble_residual ();
-        this->dg->global_inverse_mass_matrix.vmult(this->solution_update, this->dg->right_hand_side);
+template <int dim, typename real>
+void Explicit_ODESolver<dim,real>::step_in_time_multirate (const double dt)
+{
+    using VectorType = dealii::LinearAlgebra::distributed::Vector<double>;
+    const RungeKuttaTableau &rk = runge_kutta_tableau;
+    const unsigned int n_stages = rk.n_stages();
+    const unsigned int n_substeps = this->all_parameters->ode_solver_param.multirate_time_step_ratio;
+    const double substep_dt = dt / n_substeps;
+    std::vector<VectorType> &stage_derivatives = multirate_stage_derivatives;
+
+    // The fast cells are frozen over the step, from the wave speeds of its initial solution.
+    evaluate_multirate_cells (dt);
+    multirate_initial_solution = this->dg->solution;
+
+    // Slow step, whose stages are assembled over all the cells.
+    for (unsigned int istage = 0; istage < n_stages; ++istage) {
+        if (istage > 0) {
+            VectorType &stage_solution = this->dg->modify_solution();
+            stage_solution = multirate_initial_solution;
+            double stage_time_fraction = 0.0;
+            for (unsigned int jstage = 0; jstage < istage; ++jstage) {
+                stage_solution.add(dt*rk.a[istage][jstage], stage_derivatives[jstage]);
+                stage_time_fraction += rk.a[istage][jstage];
+            }
+            // The stages of the fast cells would grow at this step, unlike their initial time derivative.
+            multirate_fast_stage = multirate_initial_solution;
+            multirate_fast_stage.add(stage_time_fraction*dt, stage_derivatives[0]);
+            set_fast_dofs (multirate_fast_stage, stage_solution);
+            stage_solution.update_ghost_values();
+            this->dg->assemble_residual ();
+        }
+        this->dg->apply_inverse_mass_matrix(this->dg->right_hand_side, stage_derivatives[istage]);
+    }
+    multirate_slow_solution = multirate_initial_solution;
+    for (unsigned int istage = 0; istage < n_stages; ++istage) {
+        multirate_slow_solution.add(dt*rk.b[istage], stage_derivatives[istage]);
+    }
+
+    // Substeps of the fast cells, whose neighbours are interpolated in time between the initial and slow solutions.
+    multirate_fast_solution = multirate_initial_solution;
+    for (unsigned int isubstep = 0; isubstep < n_substeps; ++isubstep) {
+        for (unsigned int istage = 0; istage < n_stages; ++istage) {
+            // The first stage derivative of the slow step is the one of the first substep.
+            if (isubstep == 0 && istage == 0) continue;
+
+            multirate_fast_stage = multirate_fast_solution;
+            double stage_time_fraction = 0.0;
+            for (unsigned int jstage = 0; jstage < istage; ++jstage) {
+                multirate_fast_stage.add(substep_dt*rk.a[istage][jstage], stage_derivatives[jstage]);
+                stage_time_fraction += rk.a[istage][jstage];
+            }
+            const double slow_weight = (isubstep + stage_time_fraction) / n_substeps;
 
-        this->rk_stage[3] = this->rk_stage[0];
-        this->rk_stage[3] *= 1.0/3.0;
-        this->rk_stage[3].add(2.0/3.0, this->rk_stage[2]);
-        this->rk_stage[3].add(2.0/3.0*dt, this->solution_update);
+            VectorType &stage_solution = this->dg->modify_solution();
+            stage_solution = multirate_initial_solution;
+            stage_solution.sadd(1.0-slow_weight, slow_weight, multirate_slow_solution);
+            set_fast_dofs (multirate_fast_stage, stage_solution);
+            stage_solution.update_ghost_values();
 
-        this->dg->solution = this->rk_stage[3];
-        pcout<< "done." << std::endl;
+            // Only the derivatives of the fast cells are complete and used.
+            this->dg->assemble_residual_of_cells (multirate_assembled_cells);
+            this->dg->apply_inverse_mass_matrix(this->dg->right_hand_side, stage_derivatives[istage]);
+        }
+        for (unsigned int istage = 0; istage < n_stages; ++istage) {
+            multirate_fast_solution.add(substep_dt*rk.b[istage], stage_derivatives[istage]);
+        }
     }
 
+    set_fast_dofs (multirate_fast_solution, multirate_slow_solution);
+    this->dg->set_solution(multirate_slow_solution);
+
+    // Average time derivative over the step.
+    multirate_work = multirate_slow_solution;
+    multirate_work -= multirate_initial_solution;
+    this->update_norm = multirate_work.l2_norm() / dt;
 }
 
 template <int dim, typename real>
@@ -361,9 +862,39 @@ void Explicit_ODESolver<dim,real>::allocate_ode_system ()
     this->solution_update.reinit(this->dg->right_hand_side);
     this->dg->evaluate_mass_matrices(do_inverse_mass_matrix);
 
-    this->rk_stage.resize(4);
-    for (int i=0; i<4; i++) {
-        this->rk_stage[i].reinit(this->dg->solution);
+    // The low-storage methods only need the solution_update.
+    if (runge_kutta_tableau.is_low_storage()) {
+        rk_initial_solution.reinit(0);
+    } else {
+        rk_initial_solution.reinit(this->dg->solution);
+    }
+
+    if (this->local_time_stepping_active) {
+        local_time_step_ratio.reinit(this->dg->right_hand_side);
+        local_time_step_residual.reinit(this->dg->right_hand_side);
+    } else {
+        local_time_step_ratio.reinit(0);
+        local_time_step_residual.reinit(0);
+    }
+
+    multirate_stage_derivatives.clear();
+    if (this->multirate_active) {
+        multirate_fast_dofs.reinit(this->dg->solution);
+        multirate_stage_derivatives.resize(runge_kutta_tableau.n_stages());
+        for (auto &stage_derivative : multirate_stage_derivatives) stage_derivative.reinit(this->dg->right_hand_side);
+        multirate_initial_solution.reinit(this->dg->solution);
+        multirate_slow_solution.reinit(this->dg->solution);
+        multirate_fast_solution.reinit(this->dg->solution);
+        multirate_fast_stage.reinit(this->dg->solution);
+        multirate_work.reinit(this->dg->solution);
+    } else {
+        multirate_fast_dofs.reinit(0);
+        multirate_assembled_cells.clear();
+        multirate_initial_solution.reinit(0);
+        multirate_slow_solution.reinit(0);
+        multirate_fast_solution.reinit(0);
+        multirate_fast_stage.reinit(0);
+        multirate_work.reinit(0);
     }
 }
 template <int dim, typename real>
@@ -372,6 +903,46 @@ void Implicit_ODESolver<dim,real>::allocate_ode_system ()
     const bool do_inverse_mass_matrix = false;
     this->solution_update.reinit(this->dg->right_hand_side);
     this->dg->evaluate_mass_matrices(do_inverse_mass_matrix);
+
+    // The degrees of freedom might have changed. Assemble and factorize at the next step.
+    linear_solver.set_external_preconditioner(nullptr);
+    linear_solver.set_cell_blocks(partition_into_cell_blocks(this->dg->dof_handler));
+    linear_solver.reset_statistics();
+    const Parameters::LinearSolverParam &linear_param = this->all_parameters->linear_solver_param;
+    if (linear_param.preconditioner_type == Parameters::LinearSolverParam::PreconditionerEnum::p_multigrid) {
+        linear_solver.set_external_preconditioner(std::make_shared<PMultigridPreconditioner<dim,real>>(this->dg, linear_param));
+    }
+    steps_since_jacobian_update = 0;
+    steps_since_preconditioner_update = 0;
+    reference_linear_iterations = 0;
+    previous_step_residual_norm = std::numeric_limits<double>::max();
+    linearization_update_requested = false;
+
+    last_step_timings = StepTimings();
+    total_step_timings = StepTimings();
+    n_jacobian_updates = 0;
+    n_preconditioner_updates = 0;
+
+    preconditioner_dg.reset();
+    if (this->all_parameters->ode_solver_param.jacobian_free_newton_krylov) {
+        matrix_free_jacobian = std::make_unique<MatrixFreeJacobian<dim,real>>(this->dg);
+        lagged_jacobian.clear();
+
+        const bool lax_friedrichs_preconditioner = this->all_parameters->ode_solver_param.jfnk_lax_friedrichs_preconditioner
+            && this->all_parameters->conv_num_flux_type != Parameters::AllParameters::ConvectiveNumericalFlux::lax_friedrichs;
+        if (lax_friedrichs_preconditioner) {
+            preconditioner_parameters = std::make_unique<Parameters::AllParameters>(*(this->all_parameters));
+            preconditioner_parameters->conv_num_flux_type = Parameters::AllParameters::ConvectiveNumericalFlux::lax_friedrichs;
+            preconditioner_dg = this->dg->create_discretization_copy(preconditioner_parameters.get());
+            auto cell = this->dg->dof_handler.begin_active();
+            for (auto copy_cell = preconditioner_dg->dof_handler.begin_active(); copy_cell != preconditioner_dg->dof_handler.end(); ++copy_cell, ++cell) {
+                if (!copy_cell->is_locally_owned()) continue;
+                copy_cell->set_active_fe_index(cell->active_fe_index());
+            }
+            preconditioner_dg->allocate_system();
+            preconditioner_dg_volume_nodes_version = 0;
+        }
+    }
 }
 
 //template <int dim, typename real>
@@ -1,12 +1,20 @@
 #ifndef __ODESOLVER_H__
 #define __ODESOLVER_H__
 
+#include <limits>
+
 #include <deal.II/base/conditional_ostream.h>
 
 #include <deal.II/lac/vector.h>
 
+#include <Ifpack_Preconditioner.h>
+
 #include "parameters/all_parameters.h"
 #include "dg/dg.h"
+#include "dg/matrix_free_jacobian.h"
+#include "dg/p_multigrid_preconditioner.h"
+#include "linear_solver/linear_solver.h"
+#include "ode_solver/runge_kutta_tableau.h"
 
 
 namespace PHiLiP {
@@ -44,11 +52,19 @@ public:
 
 
     /// Virtual function to advance solution to time+dt
+    /** Uses constant time steps of at most the initial_time_step, unless the adaptive_time_step
+     *  evaluates each one from the courant_number and the current solution.
+     *  The explicit solver advances the cells that are too small for the time step with substeps
+     *  if the multirate_time_step_ratio is larger than one.
+     */
     int advance_solution_time (double time_advance);
 
     /// Virtual function to allocate the ODE system
     virtual void allocate_ode_system () = 0;
 
+    /// Prints the work done by the solver since allocate_ode_system(). Nothing by default.
+    virtual void print_solver_statistics () const {};
+
     double residual_norm; ///< Current residual norm. Only makes sense for steady state
     double residual_norm_decrease; ///< Current residual norm normalized by initial residual. Only makes sense for steady state
 
@@ -62,16 +78,31 @@ protected:
     virtual void step_in_time(real dt) = 0;
 
     /// Evaluate stable time-step
-    /** Currently not used */
-    void compute_time_step();
+    /** Smallest cell_stable_time_step() over all the processors, multiplied by the \p courant_number.
+     *  Uses the max_dt_cell of the last right-hand side assembly, which should be at the current solution.
+     */
+    double evaluate_stable_time_step (const double courant_number) const;
 
-    /// Solution update given by the ODE solver
-    dealii::LinearAlgebra::distributed::Vector<double> solution_update;
+    /// Stable time step of a cell at a Courant number of 1.
+    /** Time for the maximum wave speed to cross the cell, divided by \f$ 2p+1 \f$ to account for the
+     *  resolution of its polynomial. Only valid for the locally owned cells.
+     */
+    double cell_stable_time_step (const typename dealii::DoFHandler<dim>::active_cell_iterator &cell) const;
+
+    /// Whether each cell is advanced with its own time step.
+    /** Only set for the steady_state() of the Explicit_ODESolver. The dt given to step_in_time()
+     *  is then the smallest one, see evaluate_stable_time_step().
+     */
+    bool local_time_stepping_active;
 
-    /// Stores the various RK stages.
-    /** Currently hard-coded to RK4.
+    /// Whether the fast cells are advanced with substeps of the time step.
+    /** Only set for the advance_solution_time() of the Explicit_ODESolver with a multirate_time_step_ratio
+     *  larger than one. The dt given to step_in_time() is then the time step of the slow cells.
      */
-    std::vector<dealii::LinearAlgebra::distributed::Vector<double>> rk_stage;
+    bool multirate_active;
+
+    /// Solution update given by the ODE solver
+    dealii::LinearAlgebra::distributed::Vector<double> solution_update;
 
     /// Smart pointer to DGBase
     std::shared_ptr<DGBase<dim,real>> dg;
@@ -116,12 +147,49 @@ public:
     Implicit_ODESolver(std::shared_ptr<DGBase<dim, real>> dg_input)
     :
     ODESolver<dim,real>::ODESolver(dg_input)
+    , n_jacobian_updates(0)
+    , n_preconditioner_updates(0)
+    , preconditioner_dg_volume_nodes_version(0)
+    , steps_since_jacobian_update(0)
+    , steps_since_preconditioner_update(0)
+    , reference_linear_iterations(0)
+    , previous_step_residual_norm(std::numeric_limits<double>::max())
+    , linearization_update_requested(false)
     {};
     ~Implicit_ODESolver() {}; ///< Destructor.
     /// Allocates ODE system based on given DGBase.
     /** Basically allocates solution vector and asks DGBase to evaluate the mass matrix.
+     *  Also discards the reused Jacobian and preconditioner since the degrees of freedom might have changed.
      */
     void allocate_ode_system ();
+
+    /// Prints the cumulative step timings and the number of Jacobian and preconditioner updates.
+    void print_solver_statistics () const;
+
+    /// Wall-clock times in seconds spent in the parts of an implicit step.
+    struct StepTimings
+    {
+        double assembly = 0.0;       ///< dRdW assembly, or residual evaluation of the Jacobian-free operator.
+        double mass_matrix = 0.0;    ///< Time-scaled mass matrix.
+        double preconditioner = 0.0; ///< Reordering and factorization of the preconditioner, or p-multigrid levels.
+        double linear_solve = 0.0;   ///< Linear solver.
+        double linesearch = 0.0;     ///< Linesearch, including its residual evaluations.
+        unsigned int linear_iterations = 0; ///< Number of linear iterations.
+    };
+    StepTimings last_step_timings; ///< Timings of the last step.
+    StepTimings total_step_timings; ///< Sum of the timings since allocate_ode_system().
+
+    unsigned int n_jacobian_updates; ///< Number of dRdW assemblies since allocate_ode_system().
+    unsigned int n_preconditioner_updates; ///< Number of factorizations or p-multigrid setups since allocate_ode_system().
+
+    /// Solves the linear system of every step, with the matrix or the Jacobian-free operator.
+    /** Keeps its reordering and symbolic factorization while the sparsity of the system_matrix does not change,
+     *  and its factorization for the chord steps and the preconditioner_update_frequency.
+     *  Holds the PMultigridPreconditioner of the p_multigrid preconditioner_type.
+     *  Its statistics are reset by allocate_ode_system().
+     */
+    LinearSolver linear_solver;
+
 protected:
     /// Advances the solution in time by \p dt.
     void step_in_time(real dt);
@@ -134,6 +202,60 @@ protected:
      */
     double linesearch ();
 
+    /// Advances the solution in time by \p dt with Jacobian-free Newton-Krylov.
+    /** GMRES applies the operator of the backward-Euler step through the MatrixFreeJacobian, whose products
+     *  are forward-mode directional derivatives of the residual, see DGBase::apply_dRdW().
+     *  Its preconditioner_type is built from the lagged_jacobian and the current time-scaled mass matrix,
+     *  unless the preconditioner_update_frequency keeps the factorization of a previous step.
+     */
+    void step_in_time_jacobian_free (real dt);
+
+    /// Matrix-free operator of the backward-Euler step.
+    std::unique_ptr<MatrixFreeJacobian<dim,real>> matrix_free_jacobian;
+    /// Negative of the dRdW assembled at the last preconditioner update.
+    dealii::TrilinosWrappers::SparseMatrix lagged_jacobian;
+    /// Parameters of the preconditioner_dg, with the Lax-Friedrichs convective flux.
+    std::unique_ptr<Parameters::AllParameters> preconditioner_parameters;
+    /// Copy of the DG whose dRdW gives the lagged_jacobian, see jfnk_lax_friedrichs_preconditioner.
+    /** Only created if the residual uses another convective flux. Otherwise, the lagged_jacobian is the dRdW of the DG. */
+    std::shared_ptr<DGBase<dim,real>> preconditioner_dg;
+    /// Version of the DG volume_nodes last copied into the preconditioner_dg.
+    unsigned int preconditioner_dg_volume_nodes_version;
+    /// Copies the solution and the volume_nodes of the DG into the preconditioner_dg.
+    void update_preconditioner_dg_state ();
+    /// Sum of the lagged_jacobian and of the time-scaled mass matrix of the last preconditioner update.
+    dealii::TrilinosWrappers::SparseMatrix preconditioner_matrix;
+    /// Number of steps taken since the system_matrix or the lagged_jacobian was assembled.
+    /** Zero until the first assembly following allocate_ode_system(). */
+    unsigned int steps_since_jacobian_update;
+
+    /// Whether the reuse of the Jacobian or of the preconditioner is enabled in the ODE solver parameters.
+    bool linearization_is_reused () const;
+
+    /// Whether the reused Jacobian and preconditioner should be updated at this step.
+    /** True when the residual did not decrease enough since the previous step, or when the previous
+     *  linear solve needed too many iterations. See the ODE solver parameters linearization_update_*.
+     */
+    bool linearization_update_is_requested ();
+
+    /// Reads the cost of the last linear_solver solve into the last_step_timings and counts its factorizations.
+    void record_linear_solve ();
+
+    /// Requests an update of the linearization if the linear iterations grew too much since the last factorization.
+    void monitor_linear_iterations (const unsigned int n_linear_iterations, const bool preconditioner_was_updated);
+
+    /// Adds the last_step_timings to the total_step_timings and prints them.
+    void record_step_timings ();
+
+    /// Number of steps taken since the linear_solver factorized its matrix.
+    unsigned int steps_since_preconditioner_update;
+    /// Number of linear iterations of the first solve following the last factorization.
+    unsigned int reference_linear_iterations;
+    /// Residual norm at the beginning of the previous step.
+    double previous_step_residual_norm;
+    /// Set when the last linear solve needed too many iterations.
+    bool linearization_update_requested;
+
     using ODESolver<dim,real>::pcout; ///< Parallel std::cout that only outputs on mpi_rank==0
 
 }; // end of Implicit_ODESolver class
@@ -151,17 +273,93 @@ public:
     /// Constructor.
     Explicit_ODESolver(std::shared_ptr<DGBase<dim, real>> dg_input)
     : ODESolver<dim,real>::ODESolver(dg_input) 
+    , runge_kutta_tableau(dg_input->all_parameters->ode_solver_param.runge_kutta_method)
     {};
     /// Destructor.
     ~Explicit_ODESolver() {};
     /// Allocates ODE system based on given DGBase.
-    /** Basically allocates rk-stages and solution vector and asks DGBase to evaluate the inverse mass matrix.
+    /** Basically allocates the Runge-Kutta registers and asks DGBase to evaluate the inverse mass matrix.
      */
     void allocate_ode_system ();
 
 protected:
-    void step_in_time(real dt); ///< Advances the solution in time by \p dt.
+    /// Advances the solution in time by \p dt with the Runge-Kutta method of the runge_kutta_tableau.
+    /** Expects the right-hand side to be assembled at the current solution.
+     *  Uses step_in_time_multirate() if the multirate_active.
+     */
+    void step_in_time(real dt);
     using ODESolver<dim,real>::pcout; ///< Parallel std::cout that only outputs on mpi_rank==0
+
+    /// Coefficients of the Runge-Kutta method.
+    const RungeKuttaTableau runge_kutta_tableau;
+
+    /// Ratio of the local time step of each degree of freedom to the dt of the step.
+    /** Only allocated if the local_time_stepping_active.
+     */
+    dealii::LinearAlgebra::distributed::Vector<double> local_time_step_ratio;
+    /// Right-hand side scaled by the local_time_step_ratio.
+    /** Only allocated if the local_time_stepping_active.
+     */
+    dealii::LinearAlgebra::distributed::Vector<double> local_time_step_residual;
+
+    /// Sets the local_time_step_ratio from the max_dt_cell of the last assembly.
+    void evaluate_local_time_step_ratio (const double dt);
+
+    /// Advances the slow cells by \p dt and the fast cells by multirate_time_step_ratio substeps.
+    /** Two-level multirate method, which takes the slow step first. The stages of the slow step are
+     *  assembled over all the cells. Within them, the fast cells are extrapolated from the initial solution
+     *  with their initial time derivative, since the slow step is not stable for them. The fast cells then take
+     *  the substeps of the same Runge-Kutta method, where their face neighbours are linearly interpolated
+     *  in time between the initial and the slow solution. The substeps only assemble the residual of
+     *  the multirate_assembled_cells, see DGBase::assemble_residual_of_cells().
+     *
+     *  The stage derivatives of the Butcher tableau are stored, also for the low-storage methods.
+     */
+    void step_in_time_multirate (const double dt);
+
+    /// Flags the fast cells, whose stable time step at the courant_number is smaller than \p dt.
+    /** Sets the multirate_fast_dofs of the locally owned cells and the multirate_assembled_cells,
+     *  which also contain the face neighbours of the fast cells, including the ghost ones.
+     */
+    void evaluate_multirate_cells (const double dt);
+
+    /// Sets the degrees of freedom of the fast cells of \p values to the ones of \p fast_values.
+    void set_fast_dofs (
+        const dealii::LinearAlgebra::distributed::Vector<double> &fast_values,
+        dealii::LinearAlgebra::distributed::Vector<double> &values);
+
+    /// One on the degrees of freedom of the fast cells and zero elsewhere, with the ghost values of the solution.
+    /** Only allocated if the multirate_active. */
+    dealii::LinearAlgebra::distributed::Vector<double> multirate_fast_dofs;
+    /// Fast cells and their face neighbours, indexed by active_cell_index.
+    std::vector<bool> multirate_assembled_cells;
+    /// Stage derivatives \f$ \mathbf{k}_i \f$ of the slow step, and then of the current fast substep.
+    std::vector<dealii::LinearAlgebra::distributed::Vector<double>> multirate_stage_derivatives;
+    /// Solution at the beginning of the multirate step.
+    dealii::LinearAlgebra::distributed::Vector<double> multirate_initial_solution;
+    /// Solution of the slow step, whose fast cells are discarded.
+    dealii::LinearAlgebra::distributed::Vector<double> multirate_slow_solution;
+    /// Solution of the fast cells, advanced by the substeps.
+    dealii::LinearAlgebra::distributed::Vector<double> multirate_fast_solution;
+    /// Stage solution of the fast cells within a substep.
+    dealii::LinearAlgebra::distributed::Vector<double> multirate_fast_stage;
+    /// Work vector of set_fast_dofs().
+    dealii::LinearAlgebra::distributed::Vector<double> multirate_work;
+
+    /// Solution at the beginning of the time step.
+    /** Only allocated for the methods that are not low storage. The accumulated next solution is stored in the solution_update.
+     */
+    dealii::LinearAlgebra::distributed::Vector<double> rk_initial_solution;
+
+    /// Sets \p register_vector to \f$ \alpha \f$ register_vector \f$ + \beta \mathbf{M}^{-1} \mathbf{R} \f$.
+    /** Adds the product with the inverse mass matrix in place, such that the stage derivative is never stored.
+     *  With local time stepping, the right-hand side is first scaled by the local_time_step_ratio. Since the
+     *  inverse mass matrix is block-diagonal, each cell is then advanced with its own time step.
+     */
+    void add_inverse_mass_residual (
+        dealii::LinearAlgebra::distributed::Vector<double> &register_vector,
+        const double register_scaling,
+        const double residual_scaling);
 }; // end of Explicit_ODESolver class
 
 /// Creates and assemble Explicit_ODESolver or Implicit_ODESolver as ODESolver based on input.
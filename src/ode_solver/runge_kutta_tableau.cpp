@@ -0,0 +1,128 @@
+#include <cmath>
+
+#include <deal.II/base/exceptions.h>
+
+#include "runge_kutta_tableau.h"
+
+namespace PHiLiP {
+namespace ODE {
+
+RungeKuttaTableau::RungeKuttaTableau (const Parameters::ODESolverParam::RungeKuttaMethodEnum method)
+{
+    using RKEnum = Parameters::ODESolverParam::RungeKuttaMethodEnum;
+    if (method == RKEnum::forward_euler) {
+        order = 1;
+        low_storage_A = { 0.0 };
+        low_storage_B = { 1.0 };
+    } else if (method == RKEnum::ssp_rk3) {
+        // Shu and Osher, J. Comput. Phys. 77 (1988)
+        order = 3;
+        a = { {},
+              { 1.0 },
+              { 0.25, 0.25 } };
+        b = { 1.0/6.0, 1.0/6.0, 2.0/3.0 };
+    } else if (method == RKEnum::rk4) {
+        order = 4;
+        a = { {},
+              { 0.5 },
+              { 0.0, 0.5 },
+              { 0.0, 0.0, 1.0 } };
+        b = { 1.0/6.0, 1.0/3.0, 1.0/3.0, 1.0/6.0 };
+    } else if (method == RKEnum::lsrk3_williamson) {
+        // Williamson, J. Comput. Phys. 35 (1980)
+        order = 3;
+        low_storage_A = { 0.0, -5.0/9.0, -153.0/128.0 };
+        low_storage_B = { 1.0/3.0, 15.0/16.0, 8.0/15.0 };
+    } else if (method == RKEnum::lsrk4_carpenter_kennedy) {
+        // Carpenter and Kennedy, NASA TM-109112 (1994), solution 3
+        order = 4;
+        low_storage_A = { 0.0,
+                          -567301805773.0/1357537059087.0,
+                          -2404267990393.0/2016746695238.0,
+                          -3550918686646.0/2091501179385.0,
+                          -1275806237668.0/842570457699.0 };
+        low_storage_B = { 1432997174477.0/9575080441755.0,
+                          5161836677717.0/13612068292357.0,
+                          1720146321549.0/2090206949498.0,
+                          3134564353537.0/4481467310338.0,
+                          2277821191437.0/14882151754819.0 };
+    } else {
+        Assert(false, dealii::ExcMessage("Unknown Runge-Kutta method."));
+    }
+
+    if (is_low_storage()) {
+        set_butcher_tableau_from_low_storage ();
+    } else {
+        set_initial_solution_weights ();
+    }
+}
+
+unsigned int RungeKuttaTableau::n_stages () const
+{
+    return b.size();
+}
+
+bool RungeKuttaTableau::is_low_storage () const
+{
+    return !low_storage_B.empty();
+}
+
+void RungeKuttaTableau::set_butcher_tableau_from_low_storage ()
+{
+    const unsigned int n = low_storage_B.size();
+    AssertDimension(low_storage_A.size(), n);
+    Assert(low_storage_A[0] == 0.0, dealii::ExcMessage("The first stage must not use the previous update."));
+
+    // The update of stage m is dt * sum_j update_weight[m][j] k_j.
+    std::vector<std::vector<double>> update_weight(n, std::vector<double>(n, 0.0));
+    for (unsigned int m = 0; m < n; ++m) {
+        for (unsigned int j = 0; j < m; ++j) {
+            update_weight[m][j] = low_storage_A[m] * update_weight[m-1][j];
+        }
+        update_weight[m][m] = 1.0;
+    }
+
+    // Each stage adds B_m times the update to the solution.
+    a.assign(n, std::vector<double>());
+    b.assign(n, 0.0);
+    for (unsigned int i = 0; i < n; ++i) {
+        a[i].assign(i, 0.0);
+        for (unsigned int j = 0; j < i; ++j) {
+            for (unsigned int m = j; m < i; ++m) {
+                a[i][j] += low_storage_B[m] * update_weight[m][j];
+            }
+        }
+    }
+    for (unsigned int j = 0; j < n; ++j) {
+        for (unsigned int m = j; m < n; ++m) {
+            b[j] += low_storage_B[m] * update_weight[m][j];
+        }
+    }
+}
+
+void RungeKuttaTableau::set_initial_solution_weights ()
+{
+    const unsigned int n = n_stages();
+    AssertDimension(a.size(), n);
+
+    // The first stage is the initial solution, such that it does not need to be combined with it.
+    initial_solution_weight.assign(n, 0.0);
+    for (unsigned int i = 1; i+1 < n; ++i) {
+        // Ratio of the coefficients of the next stage to the ones of the current stage.
+        double previous_stage_weight = 0.0;
+        for (unsigned int j = 0; j < i; ++j) {
+            if (a[i][j] != 0.0) {
+                previous_stage_weight = a[i+1][j] / a[i][j];
+                break;
+            }
+        }
+        for (unsigned int j = 0; j < i; ++j) {
+            Assert(std::abs(a[i+1][j] - previous_stage_weight * a[i][j]) < 1e-15,
+                   dealii::ExcMessage("The Butcher tableau cannot be evaluated without storing the stage derivatives."));
+        }
+        initial_solution_weight[i] = 1.0 - previous_stage_weight;
+    }
+}
+
+} // ODE namespace
+} // PHiLiP namespace
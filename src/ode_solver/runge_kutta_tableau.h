@@ -0,0 +1,62 @@
+#ifndef __RUNGE_KUTTA_TABLEAU_H__
+#define __RUNGE_KUTTA_TABLEAU_H__
+
+#include <vector>
+
+#include "parameters/parameters_ode_solver.h"
+
+namespace PHiLiP {
+namespace ODE {
+
+/// Coefficients of an explicit Runge-Kutta method.
+/** The Butcher tableau defines the stages and the next solution
+ *  \f[
+ *      \mathbf{u}^{(i)} = \mathbf{u}^n + \Delta t \sum_{j<i} a_{ij} \mathbf{k}_j, \quad
+ *      \mathbf{k}_i = \mathbf{M}^{-1} \mathbf{R}(\mathbf{u}^{(i)}), \quad
+ *      \mathbf{u}^{n+1} = \mathbf{u}^n + \Delta t \sum_{i} b_i \mathbf{k}_i.
+ *  \f]
+ *  The stage derivatives \f$\mathbf{k}_i\f$ are never stored. The low-storage methods use the
+ *  2N-storage form of Williamson, which only stores the solution and one update
+ *  \f[
+ *      \Delta \mathbf{u} \leftarrow A_i \Delta \mathbf{u} + \Delta t \mathbf{k}_i, \quad
+ *      \mathbf{u} \leftarrow \mathbf{u} + B_i \Delta \mathbf{u}.
+ *  \f]
+ *  The other methods form each stage from the initial solution and the previous stage
+ *  \f[
+ *      \mathbf{u}^{(i+1)} = \alpha_i \mathbf{u}^n + (1-\alpha_i) \mathbf{u}^{(i)} + \Delta t a_{i+1,i} \mathbf{k}_i
+ *  \f]
+ *  while accumulating the next solution, which stores the initial and accumulated solutions.
+ *  This requires \f$ a_{i+1,j} = (1-\alpha_i) a_{ij} \f$ for \f$ j<i \f$.
+ */
+class RungeKuttaTableau
+{
+public:
+    /// Constructor. Sets the coefficients of the given method.
+    RungeKuttaTableau (const Parameters::ODESolverParam::RungeKuttaMethodEnum method);
+
+    unsigned int n_stages () const; ///< Number of stages.
+    bool is_low_storage () const; ///< Whether the method is evaluated in its 2N-storage form.
+
+    unsigned int order; ///< Order of accuracy.
+
+    /// Strictly lower triangular Butcher coefficients \f$ a_{ij} \f$.
+    std::vector<std::vector<double>> a;
+    std::vector<double> b; ///< Butcher weights \f$ b_i \f$.
+
+    std::vector<double> low_storage_A; ///< Coefficients \f$ A_i \f$ of the 2N-storage form. Empty if not low storage.
+    std::vector<double> low_storage_B; ///< Coefficients \f$ B_i \f$ of the 2N-storage form. Empty if not low storage.
+
+    /// Weights \f$ \alpha_i \f$ of the initial solution in the stage \f$ i+1 \f$. Empty if low storage.
+    std::vector<double> initial_solution_weight;
+
+protected:
+    /// Sets the Butcher tableau equivalent to the 2N-storage coefficients.
+    void set_butcher_tableau_from_low_storage ();
+    /// Evaluates the initial_solution_weight and checks that the Butcher tableau can be evaluated in that form.
+    void set_initial_solution_weights ();
+};
+
+} // ODE namespace
+} // PHiLiP namespace
+
+#endif
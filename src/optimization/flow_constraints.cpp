@@ -1,3 +1,5 @@
+#include <chrono>
+
 #include "optimization/flow_constraints.hpp"
 #include "mesh/meshmover_linear_elasticity.hpp"
 
@@ -27,10 +29,25 @@ FlowConstraints<dim>
     , adjoint_jacobian_prec(nullptr)
 {
     flow_CFL_ = 0.0;
+    mesh_motion_time = 0.0;
     ffd_des_var.reinit(ffd_design_variables_indices_dim.size());
     ffd.get_design_variables(ffd_design_variables_indices_dim, ffd_des_var);
 
-    ffd.get_dXvdXp ( dg->high_order_grid, ffd_design_variables_indices_dim, dXvdXp);
+    // The same mesh mover deforms the grid and applies the mesh sensitivities.
+    auto &high_order_grid = dg->high_order_grid;
+    surface_node_displacements = ffd.get_surface_displacement(high_order_grid);
+    surface_node_displacements.update_ghost_values();
+    meshmover = std::make_unique<typename FreeFormDeformation<dim>::MeshMoverType>(
+        *(high_order_grid.triangulation),
+        high_order_grid.initial_mapping_fe_field,
+        high_order_grid.dof_handler_grid,
+        high_order_grid.surface_to_volume_indices,
+        surface_node_displacements);
+
+    dXvdXp = ffd.get_dXvdXp_operator ( high_order_grid, ffd_design_variables_indices_dim, *meshmover);
+    dRdXp = matrix_operator(dg->dRdXv) * dXvdXp;
+    d2RdWdXp = matrix_operator(dg->d2RdWdX) * dXvdXp;
+    d2RdXpdXp = dealii::transpose_operator(dXvdXp) * matrix_operator(dg->d2RdXdX) * dXvdXp;
 
     dealii::ParameterHandler parameter_handler;
     Parameters::LinearSolverParam::declare_parameters (parameter_handler);
@@ -45,6 +62,28 @@ FlowConstraints<dim>
     this->linear_solver_param.linear_solver_output = Parameters::OutputEnum::quiet;
     this->linear_solver_param.linear_solver_type = Parameters::LinearSolverParam::LinearSolverEnum::gmres;
 
+    // The transposed Jacobian has the same rows.
+    const std::vector<int> cell_blocks = partition_into_cell_blocks(dg->dof_handler);
+    jacobian_linear_solver.set_cell_blocks(cell_blocks);
+    adjoint_jacobian_linear_solver.set_cell_blocks(cell_blocks);
+}
+
+template<int dim>
+dealii::LinearOperator<dealii_Vector> FlowConstraints<dim>
+::matrix_operator (const dealii::TrilinosWrappers::SparseMatrix &matrix)
+{
+    dealii::LinearOperator<dealii_Vector> matrix_op;
+    matrix_op.vmult = [&matrix](dealii_Vector &dst, const dealii_Vector &src) { matrix.vmult(dst, src); };
+    matrix_op.vmult_add = [&matrix](dealii_Vector &dst, const dealii_Vector &src) { matrix.vmult_add(dst, src); };
+    matrix_op.Tvmult = [&matrix](dealii_Vector &dst, const dealii_Vector &src) { matrix.Tvmult(dst, src); };
+    matrix_op.Tvmult_add = [&matrix](dealii_Vector &dst, const dealii_Vector &src) { matrix.Tvmult_add(dst, src); };
+    matrix_op.reinit_range_vector = [&matrix](dealii_Vector &vector, const bool /*omit_zeroing_entries*/) {
+        vector.reinit(matrix.locally_owned_range_indices(), matrix.get_mpi_communicator());
+    };
+    matrix_op.reinit_domain_vector = [&matrix](dealii_Vector &vector, const bool /*omit_zeroing_entries*/) {
+        vector.reinit(matrix.locally_owned_domain_indices(), matrix.get_mpi_communicator());
+    };
+    return matrix_op;
 }
 
 template<int dim>
@@ -59,15 +98,14 @@ void FlowConstraints<dim>
 ::update_1( const ROL::Vector<double>& des_var_sim, bool flag, int iter )
 {
     (void) flag; (void) iter;
-    dg->solution = ROL_vector_to_dealii_vector_reference(des_var_sim);
-    dg->solution.update_ghost_values();
+    dg->set_solution(ROL_vector_to_dealii_vector_reference(des_var_sim));
 }
 
 template<int dim>
 void FlowConstraints<dim>
 ::update_2( const ROL::Vector<double>& des_var_ctl, bool flag, int iter )
 {
-    (void) flag; (void) iter;
+    (void) flag;
     ffd_des_var =  ROL_vector_to_dealii_vector_reference(des_var_ctl);
     auto current_ffd_des_var = ffd_des_var;
     ffd.get_design_variables( ffd_design_variables_indices_dim, current_ffd_des_var);
@@ -77,7 +115,13 @@ void FlowConstraints<dim>
     const double l2_norm = diff.l2_norm();
     if (l2_norm != 0.0) {
         ffd.set_design_variables( ffd_design_variables_indices_dim, ffd_des_var);
-        ffd.deform_mesh(dg->high_order_grid);
+
+        const auto start = std::chrono::steady_clock::now();
+        ffd.deform_mesh(dg->high_order_grid, *meshmover, surface_node_displacements);
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        mesh_motion_time += elapsed;
+        if(i_print) std::cout << "Design iteration " << iter << ": mesh motion took " << elapsed
+                              << " s, " << mesh_motion_time << " s in total." << std::endl;
 
         static int iupdate = 0;
         dg->output_results_vtk(iupdate);
@@ -191,7 +235,7 @@ void FlowConstraints<dim>
     auto input_vector_v = ROL_vector_to_dealii_vector_reference(input_vector);
     auto &output_vector_v = ROL_vector_to_dealii_vector_reference(output_vector);
 
-    solve_linear (dg->system_matrix, input_vector_v, output_vector_v, this->linear_solver_param);
+    jacobian_linear_solver.solve (dg->system_matrix, input_vector_v, output_vector_v, this->linear_solver_param);
     //solve_linear_2 ( this->dg->system_matrix, input_vector_v, output_vector_v, this->linear_solver_param);
     //try {
     //  solve_linear (dg->system_matrix, input_vector_v, output_vector_v, this->linear_solver_param);
@@ -286,7 +330,7 @@ int FlowConstraints<dim>
     const bool compute_dRdW=true; const bool compute_dRdX=false; const bool compute_d2R=false;
     dg->assemble_residual(compute_dRdW, compute_dRdX, compute_d2R, flow_CFL_);
 
-    Epetra_CrsMatrix * adjoint_jacobian = const_cast<Epetra_CrsMatrix *>(&(dg->system_matrix_transpose.trilinos_matrix()));
+    Epetra_CrsMatrix * adjoint_jacobian = const_cast<Epetra_CrsMatrix *>(&(dg->get_system_matrix_transpose().trilinos_matrix()));
 
     destroy_AdjointJacobianPreconditioner_1();
     Ifpack Factory;
@@ -379,11 +423,12 @@ void FlowConstraints<dim>
     auto input_vector_v = ROL_vector_to_dealii_vector_reference(input_vector);
     auto &output_vector_v = ROL_vector_to_dealii_vector_reference(output_vector);
 
+    // The domain and range of the transpose are the range and domain of the system_matrix.
     Epetra_Vector input_trilinos(View,
-                    dg->system_matrix_transpose.trilinos_matrix().DomainMap(),
+                    dg->system_matrix.trilinos_matrix().RangeMap(),
                     input_vector_v.begin());
     Epetra_Vector output_trilinos(View,
-                    dg->system_matrix_transpose.trilinos_matrix().RangeMap(),
+                    dg->system_matrix.trilinos_matrix().DomainMap(),
                     output_vector_v.begin());
     adjoint_jacobian_prec->ApplyInverse (input_trilinos, output_trilinos);
 
@@ -420,7 +465,7 @@ double& /*tol*/ )
     // system_matrix_transpose.reinit(*system_matrix_transpose_tril, copy_values);
     // delete system_matrix_transpose_tril;
 
-    solve_linear (dg->system_matrix_transpose, input_vector_v, output_vector_v, this->linear_solver_param);
+    adjoint_jacobian_linear_solver.solve (dg->get_system_matrix_transpose(), input_vector_v, output_vector_v, this->linear_solver_param);
 
     // dealii::TrilinosWrappers::SparseMatrix system_matrix_transpose;
     // Epetra_CrsMatrix *system_matrix_transpose_tril;
@@ -479,15 +524,12 @@ double& /*tol*/ )
     //    meshmover.apply_dXvdXvs(dXvsdXp_input, dXvdXp_input);
     //}
 
-    auto dXvdXp_input = dg->high_order_grid.volume_nodes;
-    dXvdXp.vmult(dXvdXp_input, input_vector_v);
-
     auto &output_vector_v = ROL_vector_to_dealii_vector_reference(output_vector);
 
     {
         const bool compute_dRdW=false; const bool compute_dRdX=true; const bool compute_d2R=false;
         dg->assemble_residual(compute_dRdW, compute_dRdX, compute_d2R, flow_CFL_);
-        dg->dRdXv.vmult(output_vector_v, dXvdXp_input);
+        dRdXp.vmult(output_vector_v, input_vector_v);
     }
 
     n_vmult += 7;
@@ -512,7 +554,7 @@ double& /*tol*/ )
 
     const auto &input_vector_v = ROL_vector_to_dealii_vector_reference(input_vector);
     auto &output_vector_v = ROL_vector_to_dealii_vector_reference(output_vector);
-    this->dg->system_matrix.Tvmult(output_vector_v, input_vector_v);
+    this->dg->system_matrix_transpose_vmult(output_vector_v, input_vector_v);
 
     n_vmult += 1;
     dRdW_mult += 1;
@@ -534,11 +576,11 @@ double& /*tol*/ )
 
     const auto &input_vector_v = ROL_vector_to_dealii_vector_reference(input_vector);
 
-    auto input_dRdXv = dg->high_order_grid.volume_nodes;
+    auto &output_vector_v = ROL_vector_to_dealii_vector_reference(output_vector);
     {
         const bool compute_dRdW=false; const bool compute_dRdX=true; const bool compute_d2R=false;
         dg->assemble_residual(compute_dRdW, compute_dRdX, compute_d2R, flow_CFL_);
-        dg->dRdXv.Tvmult(input_dRdXv, input_vector_v);
+        dRdXp.Tvmult(output_vector_v, input_vector_v);
     }
 
     // auto input_dRdXv_dXvdXvs = dg->high_order_grid.volume_nodes;
@@ -560,8 +602,6 @@ double& /*tol*/ )
     //     dXvsdXp.Tvmult(output_vector_v, input_dRdXv_dXvdXvs);
     // }
 
-    auto &output_vector_v = ROL_vector_to_dealii_vector_reference(output_vector);
-    dXvdXp.Tvmult(output_vector_v, input_dRdXv);
 
     n_vmult += 7;
     dRdX_mult += 1;
@@ -616,11 +656,11 @@ void FlowConstraints<dim>
 
     const auto &input_vector_v = ROL_vector_to_dealii_vector_reference(input_vector);
 
-    auto input_d2RdWdX = dg->high_order_grid.volume_nodes;
+    auto &output_vector_v = ROL_vector_to_dealii_vector_reference(output_vector);
     {
         const bool compute_dRdW=false; const bool compute_dRdX=false; const bool compute_d2R=true;
         dg->assemble_residual(compute_dRdW, compute_dRdX, compute_d2R, flow_CFL_);
-        dg->d2RdWdX.Tvmult(input_d2RdWdX, input_vector_v);
+        d2RdWdXp.Tvmult(output_vector_v, input_vector_v);
     }
 
     // auto input_d2RdWdX_dXvdXvs = dg->high_order_grid.volume_nodes;
@@ -642,8 +682,6 @@ void FlowConstraints<dim>
     //     dXvsdXp.Tvmult(output_vector_v, input_d2RdWdX_dXvdXvs);
     // }
 
-    auto &output_vector_v = ROL_vector_to_dealii_vector_reference(output_vector);
-    dXvdXp.Tvmult(output_vector_v, input_d2RdWdX);
 
     n_vmult += 7;
     d2R_mult += 1;
@@ -693,14 +731,11 @@ void FlowConstraints<dim>
     //     meshmover.apply_dXvdXvs(dXvsdXp_input, dXvdXp_input);
     // }
 
-    auto dXvdXp_input = dg->high_order_grid.volume_nodes;
-    dXvdXp.vmult(dXvdXp_input, input_vector_v);
-
     auto &output_vector_v = ROL_vector_to_dealii_vector_reference(output_vector);
     {
         const bool compute_dRdW=false; const bool compute_dRdX=false; const bool compute_d2R=true;
         dg->assemble_residual(compute_dRdW, compute_dRdX, compute_d2R, flow_CFL_);
-        dg->d2RdWdX.vmult(output_vector_v, dXvdXp_input);
+        d2RdWdXp.vmult(output_vector_v, input_vector_v);
     }
 
     n_vmult += 7;
@@ -753,14 +788,11 @@ void FlowConstraints<dim>
     //     meshmover.apply_dXvdXvs(dXvsdXp_input, dXvdXp_input);
     // }
 
-    auto dXvdXp_input = dg->high_order_grid.volume_nodes;
-    dXvdXp.vmult(dXvdXp_input, input_vector_v);
-
-    auto d2RdXdX_dXvdXp_input = dg->high_order_grid.volume_nodes;
+    auto &output_vector_v = ROL_vector_to_dealii_vector_reference(output_vector);
     {
         const bool compute_dRdW=false; const bool compute_dRdX=false; const bool compute_d2R=true;
         dg->assemble_residual(compute_dRdW, compute_dRdX, compute_d2R, flow_CFL_);
-        dg->d2RdXdX.vmult(d2RdXdX_dXvdXp_input, dXvdXp_input);
+        d2RdXpdXp.vmult(output_vector_v, input_vector_v);
     }
 
     //auto dXvdXvsT_d2RdXdX_dXvdXp_input = dg->high_order_grid.volume_nodes;
@@ -782,8 +814,6 @@ void FlowConstraints<dim>
     //    dXvsdXp.Tvmult(output_vector_v, dXvdXvsT_d2RdXdX_dXvdXp_input);
     //}
 
-    auto &output_vector_v = ROL_vector_to_dealii_vector_reference(output_vector);
-    dXvdXp.Tvmult(output_vector_v, d2RdXdX_dXvdXp_input);
 
     n_vmult += 8;
     d2R_mult += 1;
@@ -41,6 +41,13 @@ private:
     /// FFD used to parametrize the grid and used as design variables.
     FreeFormDeformation<dim> ffd;
 
+    /// Surface displacements of the FFD, referred to by the meshmover.
+    dealii_Vector surface_node_displacements;
+    /// Linear elasticity on the initial grid, shared by the update_2() deformations and dXvdXp.
+    /** Its matrix and preconditioner are reused, and each deformation starts from the previous displacements.
+     */
+    std::unique_ptr<typename FreeFormDeformation<dim>::MeshMoverType> meshmover;
+
     /// Linear solver parameters.
     /** Currently set such that the linear systems are fully solved
      */
@@ -62,8 +69,21 @@ protected:
     /// ID used when outputting the flow solution.
     int i_out = 1000;
 
-    /// Stores the mesh sensitivities.
-    dealii::TrilinosWrappers::SparseMatrix dXvdXp;
+    /// Mesh sensitivities dXv/dXs dXs/dXp, applied without forming dense matrices.
+    /** Each application is one linear elasticity solve, see FreeFormDeformation::get_dXvdXp_operator().
+     */
+    dealii::LinearOperator<dealii_Vector> dXvdXp;
+    /// Residual sensitivities dR/dXv dXv/dXp. DGBase::dRdXv must be assembled before each application.
+    dealii::LinearOperator<dealii_Vector> dRdXp;
+    /// Mixed second derivatives d2R/dWdXv dXv/dXp. DGBase::d2RdWdX must be assembled before each application.
+    dealii::LinearOperator<dealii_Vector> d2RdWdXp;
+    /// Second derivatives dXv/dXp^T d2R/dXvdXv dXv/dXp. DGBase::d2RdXdX must be assembled before each application.
+    dealii::LinearOperator<dealii_Vector> d2RdXpdXp;
+
+    /// Wraps a DGBase matrix into a LinearOperator that composes with dXvdXp.
+    /** The matrix is referred to, such that it can be re-assembled in place between applications.
+     */
+    static dealii::LinearOperator<dealii_Vector> matrix_operator (const dealii::TrilinosWrappers::SparseMatrix &matrix);
 
 public:
     /// Avoid -Werror=overloaded-virtual.
@@ -71,6 +91,15 @@ public:
 
     /// Regularization of the constraint by adding flow_CFL_ times the mass matrix.
     double flow_CFL_;
+
+    /// Wall-clock time in seconds spent deforming the mesh in update_2(), summed over the design iterations.
+    double mesh_motion_time;
+
+    /// Solves the linear systems of the flow Jacobian in applyInverseJacobian_1().
+    /** Its statistics are readable by the optimization drivers. */
+    LinearSolver jacobian_linear_solver;
+    /// Solves the linear systems of the transposed flow Jacobian in applyInverseAdjointJacobian_1().
+    LinearSolver adjoint_jacobian_linear_solver;
     /// Avoid -Werror=overloaded-virtual.
     using ROL::Constraint_SimOpt<double>::applyAdjointJacobian_1;
         //(
@@ -21,7 +21,7 @@ ROLObjectiveSimOpt<dim,nstate>::ROLObjectiveSimOpt(
     ffd_des_var.reinit(ffd_design_variables_indices_dim.size());
     ffd.get_design_variables(ffd_design_variables_indices_dim, ffd_des_var);
 
-    ffd.get_dXvdXp ( functional.dg->high_order_grid, ffd_design_variables_indices_dim, dXvdXp);
+    dXvdXp = ffd.get_dXvdXp_operator ( functional.dg->high_order_grid, ffd_design_variables_indices_dim);
 }
 
 template <int dim, int nstate>
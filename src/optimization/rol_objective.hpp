@@ -32,8 +32,10 @@ private:
     /// Design variables.
     dealii::LinearAlgebra::distributed::Vector<double> ffd_des_var;
 
-    /// Stored mesh sensitivity evaluated at initialization.
-    dealii::TrilinosWrappers::SparseMatrix dXvdXp;
+    /// Mesh sensitivity dXv/dXs dXs/dXp, applied without forming dense matrices.
+    /** Each application is one linear elasticity solve, see FreeFormDeformation::get_dXvdXp_operator().
+     */
+    dealii::LinearOperator<dealii::LinearAlgebra::distributed::Vector<double>> dXvdXp;
 
 public:
 
@@ -34,6 +34,33 @@ void AllParameters::declare_parameters (dealii::ParameterHandler &prm)
                       dealii::Patterns::Bool(),
                       "Use original form by defualt. Otherwise, split the fluxes.");
 
+    prm.declare_entry("use_sum_factorization", "false",
+                      dealii::Patterns::Bool(),
+                      "Use the FEValues loops by default. Otherwise, evaluate the strong form volume terms "
+                      "and their dRdW, and the interior face terms between cells of the same level, "
+                      "with sum-factorized tensor-product kernels and stored metric terms.");
+
+    prm.declare_entry("use_fixed_degree_kernels", "true",
+                      dealii::Patterns::Bool(),
+                      "Use the kernels compiled for polynomial degrees 1 to 4 by default. "
+                      "Otherwise, always use the generic loops.");
+
+    prm.declare_entry("use_static_fad", "true",
+                      dealii::Patterns::Bool(),
+                      "Use the statically sized Sacado AD types to assemble dRdW by default, "
+                      "for the strong form up to p=4 and the weak form flux Jacobians. "
+                      "Otherwise, always use the dynamically allocated one.");
+
+    prm.declare_entry("use_flux_jacobians", "true",
+                      dealii::Patterns::Bool(),
+                      "Assemble the weak form dRdW from the pointwise flux Jacobians by default. "
+                      "Otherwise, differentiate the whole cell and face residuals.");
+
+    prm.declare_entry("use_cell_inverse_mass_matrix", "false",
+                      dealii::Patterns::Bool(),
+                      "Store the inverse mass matrix as a global sparse matrix by default. "
+                      "Otherwise, apply the inverse mass matrix of each cell from its reference cell.");
+
     prm.declare_entry("use_periodic_bc", "false",
                       dealii::Patterns::Bool(),
                       "Use other boundary conditions by default. Otherwise use periodic (for 1d burgers only");
@@ -42,6 +69,11 @@ void AllParameters::declare_parameters (dealii::ParameterHandler &prm)
                       dealii::Patterns::Bool(),
                       "Persson's subscell shock capturing artificial dissipation.");
 
+    prm.declare_entry("assembly_threads", "1",
+                      dealii::Patterns::Integer(1,dealii::Patterns::Integer::max_int_value),
+                      "Number of threads per MPI process used to assemble the residual. "
+                      "1 uses the serial cell loop.");
+
     prm.declare_entry("test_type", "run_control",
                       dealii::Patterns::Selection(
                       " run_control | "
@@ -158,8 +190,14 @@ void AllParameters::parse_parameters (dealii::ParameterHandler &prm)
     use_weak_form = prm.get_bool("use_weak_form");
     use_collocated_nodes = prm.get_bool("use_collocated_nodes");
     use_split_form = prm.get_bool("use_split_form");
+    use_sum_factorization = prm.get_bool("use_sum_factorization");
+    use_fixed_degree_kernels = prm.get_bool("use_fixed_degree_kernels");
+    use_static_fad = prm.get_bool("use_static_fad");
+    use_flux_jacobians = prm.get_bool("use_flux_jacobians");
+    use_cell_inverse_mass_matrix = prm.get_bool("use_cell_inverse_mass_matrix");
     use_periodic_bc = prm.get_bool("use_periodic_bc");
     add_artificial_dissipation = prm.get_bool("add_artificial_dissipation");
+    assembly_threads = prm.get_integer("assembly_threads");
 
     const std::string conv_num_flux_string = prm.get("conv_num_flux");
     if (conv_num_flux_string == "lax_friedrichs") conv_num_flux_type = lax_friedrichs;
@@ -41,6 +41,43 @@ public:
     /// Flag to use split form.
     bool use_split_form;
 
+    /// Flag to evaluate the strong form volume and interior face terms with sum-factorized tensor-product kernels.
+    /** Only used by DGStrong for the residual, its dRdW, and the dRdW products. The face terms are only
+     *  sum-factorized for the residual and the dRdW products, between locally owned cells of the same level.
+     *  The metric terms are then read from a geometry store that is only re-evaluated when the grid moves.
+     *  Elements that are not tensor-product Lagrange bases with tensor-product quadratures use the FEValues loops.
+     */
+    bool use_sum_factorization;
+
+    /// Flag to use the weak form volume kernels compiled for polynomial degrees 1 to 4.
+    /** Their sizes are compile-time constants, and the convective fluxes of a batch of cells are
+     *  evaluated together with dealii::VectorizedArray. Other degrees, and the cells with artificial
+     *  dissipation, use the generic loops.
+     */
+    bool use_fixed_degree_kernels;
+
+    /// Flag to assemble dRdW with the statically sized AD types DegreeFadType.
+    /** Avoids the heap allocations of Sacado::Fad::DFad. The strong form volume, boundary, and face terms
+     *  use the smallest DegreeFadType holding their degrees of freedom, which covers the Euler equations
+     *  up to p=4 in each dimension. Larger cells and faces, and the dRdX and d2R assembly, use Sacado::Fad::DFad.
+     *  In the weak form, only the pointwise flux Jacobians use StaticFadType, i.e. with use_flux_jacobians;
+     *  the other weak form dRdW assemblies are unaffected by this flag.
+     */
+    bool use_static_fad;
+
+    /// Flag to assemble the weak form dRdW from the Jacobians of the fluxes at each quadrature point.
+    /** The AD variables are the solution and its gradient at the point instead of all the
+     *  degrees of freedom of the cell or face. Only applies when dRdW alone is assembled
+     *  without artificial dissipation.
+     */
+    bool use_flux_jacobians;
+
+    /// Flag to store the inverse mass matrix as dense cell blocks instead of a global sparse matrix.
+    /** Affine cells share the inverse mass matrix of their reference cell, scaled by their Jacobian
+     *  determinant, such that only the curved cells store their own block. See DGBase::apply_inverse_mass_matrix().
+     */
+    bool use_cell_inverse_mass_matrix;
+
     /// Flag to use periodic BC.
     /** Not fully tested.
      */
@@ -52,6 +89,12 @@ public:
      */
     bool add_artificial_dissipation;
 
+    /// Number of threads used by each MPI process to assemble the residual and its derivatives.
+    /** A value of 1 uses the serial cell loop. Larger values run the cell loop through
+     *  dealii::WorkStream. The driver sets the thread limit of deal.II from it.
+     */
+    unsigned int assembly_threads;
+
     /// Number of state variables. Will depend on PDE
     int nstate;
 
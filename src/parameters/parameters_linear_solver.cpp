@@ -32,6 +32,59 @@ void LinearSolverParam::declare_parameters (dealii::ParameterHandler &prm)
                               dealii::Patterns::Integer(),
                               "Number of iterations before restarting GMRES");
 
+            prm.declare_entry("preconditioner_type", "ilut",
+                              dealii::Patterns::Selection("ilut|block_jacobi|ilu0|block_gauss_seidel|p_multigrid|amg"),
+                              "Preconditioner of GMRES. The block preconditioners factorize the dense blocks "
+                              "of the degrees of freedom of each cell instead of dropping scalar entries. "
+                              "ilu0 keeps the fill of the cell blocks, but is the scalar incomplete LU without pivoting within the blocks. "
+                              "p_multigrid is only available to the implicit ODE solver, and is replaced by ilut with a warning otherwise. "
+                              "amg is the algebraic multigrid of Trilinos ML, see the amg_* options. "
+                              "Choices are <ilut|block_jacobi|ilu0|block_gauss_seidel|p_multigrid|amg>.");
+
+            // p-multigrid parameters
+            prm.declare_entry("p_multigrid_cycle", "v_cycle",
+                              dealii::Patterns::Selection("v_cycle|w_cycle"),
+                              "Multigrid cycle over the polynomial degrees. "
+                              "Choices are <v_cycle|w_cycle>.");
+            prm.declare_entry("p_multigrid_coarse_degree", "0",
+                              dealii::Patterns::Integer(0),
+                              "Polynomial degree of the coarsest level, which is solved with a direct solver.");
+            prm.declare_entry("p_multigrid_smoother", "block_gauss_seidel",
+                              dealii::Patterns::Selection("block_jacobi|block_gauss_seidel"),
+                              "Smoother of each polynomial degree. "
+                              "Choices are <block_jacobi|block_gauss_seidel>.");
+            prm.declare_entry("p_multigrid_smoothing_steps", "2",
+                              dealii::Patterns::Integer(1),
+                              "Number of pre- and post-smoothing steps on each polynomial degree.");
+            prm.declare_entry("p_multigrid_smoother_damping", "1.0",
+                              dealii::Patterns::Double(0.0, 2.0),
+                              "Damping of the smoothing steps.");
+
+            // Algebraic multigrid parameters
+            prm.declare_entry("amg_elliptic", "false",
+                              dealii::Patterns::Bool(),
+                              "Whether the operator is close to symmetric and elliptic, such as diffusion-dominated problems. "
+                              "Selects the smoothed aggregation of elliptic problems, which does not suit convection.");
+            prm.declare_entry("amg_higher_order_elements", "true",
+                              dealii::Patterns::Bool(),
+                              "Whether the degrees of freedom come from elements of degree higher than 1.");
+            prm.declare_entry("amg_w_cycle", "false",
+                              dealii::Patterns::Bool(),
+                              "Use a W-cycle instead of a V-cycle.");
+            prm.declare_entry("amg_n_cycles", "1",
+                              dealii::Patterns::Integer(1),
+                              "Number of multigrid cycles per application of the preconditioner.");
+            prm.declare_entry("amg_aggregation_threshold", "1e-4",
+                              dealii::Patterns::Double(0.0),
+                              "Entries smaller than this threshold relative to the diagonal do not couple the aggregates.");
+            prm.declare_entry("amg_smoother_sweeps", "2",
+                              dealii::Patterns::Integer(1),
+                              "Number of smoothing sweeps on each level.");
+            prm.declare_entry("amg_smoother_type", "symmetric Gauss-Seidel",
+                              dealii::Patterns::Selection("Chebyshev|Jacobi|Gauss-Seidel|symmetric Gauss-Seidel|ILU"),
+                              "Smoother of each level. "
+                              "Choices are <Chebyshev|Jacobi|Gauss-Seidel|symmetric Gauss-Seidel|ILU>.");
+
             // ILU with threshold parameters
             prm.declare_entry("ilut_fill", "1",
                               dealii::Patterns::Integer(),
@@ -73,6 +126,32 @@ void LinearSolverParam ::parse_parameters (dealii::ParameterHandler &prm)
                 restart_number  = prm.get_integer("restart_number");
                 linear_residual = prm.get_double("linear_residual_tolerance");
 
+                const std::string preconditioner_string = prm.get("preconditioner_type");
+                if (preconditioner_string == "ilut") preconditioner_type = PreconditionerEnum::ilut;
+                if (preconditioner_string == "block_jacobi") preconditioner_type = PreconditionerEnum::block_jacobi;
+                if (preconditioner_string == "ilu0") preconditioner_type = PreconditionerEnum::ilu0;
+                if (preconditioner_string == "block_gauss_seidel") preconditioner_type = PreconditionerEnum::block_gauss_seidel;
+                if (preconditioner_string == "p_multigrid") preconditioner_type = PreconditionerEnum::p_multigrid;
+                if (preconditioner_string == "amg") preconditioner_type = PreconditionerEnum::amg;
+
+                const std::string cycle_string = prm.get("p_multigrid_cycle");
+                if (cycle_string == "v_cycle") p_multigrid_cycle = MultigridCycleEnum::v_cycle;
+                if (cycle_string == "w_cycle") p_multigrid_cycle = MultigridCycleEnum::w_cycle;
+                p_multigrid_coarse_degree = prm.get_integer("p_multigrid_coarse_degree");
+                const std::string smoother_string = prm.get("p_multigrid_smoother");
+                if (smoother_string == "block_jacobi") p_multigrid_smoother = PreconditionerEnum::block_jacobi;
+                if (smoother_string == "block_gauss_seidel") p_multigrid_smoother = PreconditionerEnum::block_gauss_seidel;
+                p_multigrid_smoothing_steps = prm.get_integer("p_multigrid_smoothing_steps");
+                p_multigrid_smoother_damping = prm.get_double("p_multigrid_smoother_damping");
+
+                amg_elliptic = prm.get_bool("amg_elliptic");
+                amg_higher_order_elements = prm.get_bool("amg_higher_order_elements");
+                amg_w_cycle = prm.get_bool("amg_w_cycle");
+                amg_n_cycles = prm.get_integer("amg_n_cycles");
+                amg_aggregation_threshold = prm.get_double("amg_aggregation_threshold");
+                amg_smoother_sweeps = prm.get_integer("amg_smoother_sweeps");
+                amg_smoother_type = prm.get("amg_smoother_type");
+
                 ilut_fill = prm.get_integer("ilut_fill");
                 ilut_drop = prm.get_double("ilut_drop");
                 ilut_rtol = prm.get_double("ilut_rtol");
@@ -26,6 +26,46 @@ public:
     OutputEnum linear_solver_output; ///< quiet or verbose.
     LinearSolverEnum linear_solver_type; ///< direct or gmres.
 
+    /// Types of GMRES preconditioners available.
+    /** The block preconditioners use the dense blocks of the degrees of freedom of each cell.
+     *  The ilu0 is not a block preconditioner: its fill is the sparsity of the cell blocks, but the
+     *  diagonal blocks are eliminated entry by entry without pivoting instead of factorized with dense LU.
+     */
+    enum PreconditionerEnum {
+        ilut,              ///< Incomplete LU with threshold, see the ilut_* options.
+        block_jacobi,      ///< Inverse of the diagonal cell blocks.
+        ilu0,              ///< Incomplete LU of the scalar entries without fill-in beyond the cell blocks.
+        block_gauss_seidel, ///< Forward Gauss-Seidel sweep over the cell blocks.
+        p_multigrid,       ///< Multigrid cycle over the polynomial degrees. Needs the DGBase, see PMultigridPreconditioner.
+        amg                ///< Trilinos ML algebraic multigrid, see the amg_* options.
+    };
+    PreconditionerEnum preconditioner_type; ///< Preconditioner of GMRES.
+
+    /// Types of p-multigrid cycles.
+    enum MultigridCycleEnum {
+        v_cycle, ///< Visits each coarser level once per cycle.
+        w_cycle  ///< Visits each coarser level twice per cycle.
+    };
+    MultigridCycleEnum p_multigrid_cycle; ///< Cycle of the p_multigrid preconditioner.
+    /// Polynomial degree of the coarsest p_multigrid level, which is solved directly.
+    unsigned int p_multigrid_coarse_degree;
+    /// Smoother of the p_multigrid levels. Either block_jacobi or block_gauss_seidel.
+    PreconditionerEnum p_multigrid_smoother;
+    unsigned int p_multigrid_smoothing_steps; ///< Number of pre- and post-smoothing steps on each level.
+    double p_multigrid_smoother_damping; ///< Damping of the smoothing steps.
+
+    /// Whether the operator is close to symmetric and elliptic, such as a diffusion-dominated one.
+    /** Selects the smoothed aggregation of elliptic problems. Otherwise, the aggregates are not smoothed,
+     *  which is more robust for convection.
+     */
+    bool amg_elliptic;
+    bool amg_higher_order_elements; ///< Whether the degrees of freedom come from elements of degree higher than 1.
+    bool amg_w_cycle; ///< W-cycle instead of V-cycle.
+    unsigned int amg_n_cycles; ///< Number of cycles per application of the preconditioner.
+    double amg_aggregation_threshold; ///< Entries below this threshold do not couple the aggregates.
+    unsigned int amg_smoother_sweeps; ///< Number of smoothing sweeps on each level.
+    std::string amg_smoother_type; ///< ML smoother of each level.
+
     // GMRES options
     double ilut_drop; ///< Threshold to drop terms close to zero.
     //@{
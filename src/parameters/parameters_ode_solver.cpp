@@ -23,6 +23,12 @@ void ODESolverParam::declare_parameters (dealii::ParameterHandler &prm)
                           "Explicit or implicit solver"
                           "Choices are <explicit|implicit>.");
 
+        prm.declare_entry("runge_kutta_method", "forward_euler",
+                          dealii::Patterns::Selection("forward_euler|ssp_rk3|rk4|lsrk3_williamson|lsrk4_carpenter_kennedy"),
+                          "Runge-Kutta method of the explicit solver. "
+                          "The low-storage methods only store the solution and one update vector. "
+                          "Choices are <forward_euler|ssp_rk3|rk4|lsrk3_williamson|lsrk4_carpenter_kennedy>.");
+
         prm.declare_entry("nonlinear_max_iterations", "500000",
                           dealii::Patterns::Integer(0,dealii::Patterns::Integer::max_int_value),
                           "Maximum nonlinear solver iterations");
@@ -39,6 +45,54 @@ void ODESolverParam::declare_parameters (dealii::ParameterHandler &prm)
                           dealii::Patterns::Double(0,dealii::Patterns::Double::max_double_value),
                           "Scales initial time step by pow(time_step_factor_residual*(-log10(residual_norm_decrease)),time_step_factor_residual_exp).");
 
+        prm.declare_entry("adaptive_time_step", "false",
+                          dealii::Patterns::Bool(),
+                          "Evaluates the time-accurate time steps from the courant_number and the wave speeds "
+                          "of the current solution instead of using the initial_time_step.");
+        prm.declare_entry("courant_number", "0.1",
+                          dealii::Patterns::Double(1e-16,dealii::Patterns::Double::max_double_value),
+                          "Courant number of the adaptive and local time steps. The stable time step of a cell "
+                          "is its diameter over its maximum wave speed and over (2p+1).");
+        prm.declare_entry("local_time_stepping", "false",
+                          dealii::Patterns::Bool(),
+                          "Advances each cell with its own stable time step during the explicit steady-state iterations.");
+        prm.declare_entry("multirate_time_step_ratio", "1",
+                          dealii::Patterns::Integer(1,dealii::Patterns::Integer::max_int_value),
+                          "Number of substeps of the cells that are too small for the explicit time-accurate step. "
+                          "The other cells take a single step, which is multirate_time_step_ratio times the "
+                          "smallest stable one with the adaptive_time_step. A ratio of 1 uses a single time step.");
+
+        prm.declare_entry("jacobian_free_newton_krylov", "false",
+                          dealii::Patterns::Bool(),
+                          "Assemble dRdW at every implicit step by default. "
+                          "Otherwise, use Jacobian-free Newton-Krylov with a lagged dRdW preconditioner, "
+                          "whose Krylov products are forward-mode directional derivatives of the residual.");
+        prm.declare_entry("jfnk_preconditioner_update_frequency", "10",
+                          dealii::Patterns::Integer(1,dealii::Patterns::Integer::max_int_value),
+                          "Number of Jacobian-free Newton-Krylov steps between two assemblies "
+                          "of the dRdW used by the preconditioner.");
+        prm.declare_entry("jfnk_lax_friedrichs_preconditioner", "false",
+                          dealii::Patterns::Bool(),
+                          "Assembles the dRdW of the Jacobian-free Newton-Krylov preconditioner with the "
+                          "Lax-Friedrichs convective flux instead of the conv_num_flux of the residual.");
+
+        prm.declare_entry("jacobian_update_frequency", "1",
+                          dealii::Patterns::Integer(1,dealii::Patterns::Integer::max_int_value),
+                          "Number of implicit steps between two assemblies of dRdW and of the time-scaled mass matrix. "
+                          "In-between, chord steps reuse the last system matrix.");
+        prm.declare_entry("preconditioner_update_frequency", "1",
+                          dealii::Patterns::Integer(1,dealii::Patterns::Integer::max_int_value),
+                          "Number of implicit steps between two factorizations of the GMRES preconditioner, "
+                          "which is otherwise factorized with each new dRdW.");
+        prm.declare_entry("linearization_update_residual_ratio", "0.9",
+                          dealii::Patterns::Double(0,dealii::Patterns::Double::max_double_value),
+                          "Updates the reused Jacobian and preconditioner when the residual norm is "
+                          "larger than this ratio times the residual norm of the previous step.");
+        prm.declare_entry("linearization_update_linear_iterations_ratio", "2.0",
+                          dealii::Patterns::Double(1,dealii::Patterns::Double::max_double_value),
+                          "Updates the reused Jacobian and preconditioner when the number of linear iterations is "
+                          "larger than this ratio times the number of iterations following the last factorization.");
+
         prm.declare_entry("print_iteration_modulo", "1",
                           dealii::Patterns::Integer(0,dealii::Patterns::Integer::max_int_value),
                           "Print every print_iteration_modulo iterations of "
@@ -61,11 +115,30 @@ void ODESolverParam::parse_parameters (dealii::ParameterHandler &prm)
         if (solver_string == "explicit") ode_solver_type = ODESolverEnum::explicit_solver;
         if (solver_string == "implicit") ode_solver_type = ODESolverEnum::implicit_solver;
 
+        const std::string runge_kutta_string = prm.get("runge_kutta_method");
+        if (runge_kutta_string == "forward_euler")           runge_kutta_method = RungeKuttaMethodEnum::forward_euler;
+        if (runge_kutta_string == "ssp_rk3")                 runge_kutta_method = RungeKuttaMethodEnum::ssp_rk3;
+        if (runge_kutta_string == "rk4")                     runge_kutta_method = RungeKuttaMethodEnum::rk4;
+        if (runge_kutta_string == "lsrk3_williamson")        runge_kutta_method = RungeKuttaMethodEnum::lsrk3_williamson;
+        if (runge_kutta_string == "lsrk4_carpenter_kennedy") runge_kutta_method = RungeKuttaMethodEnum::lsrk4_carpenter_kennedy;
+
         nonlinear_steady_residual_tolerance  = prm.get_double("nonlinear_steady_residual_tolerance");
         nonlinear_max_iterations = prm.get_integer("nonlinear_max_iterations");
         initial_time_step  = prm.get_double("initial_time_step");
         time_step_factor_residual = prm.get_double("time_step_factor_residual");
         time_step_factor_residual_exp = prm.get_double("time_step_factor_residual_exp");
+        adaptive_time_step = prm.get_bool("adaptive_time_step");
+        courant_number = prm.get_double("courant_number");
+        local_time_stepping = prm.get_bool("local_time_stepping");
+        multirate_time_step_ratio = prm.get_integer("multirate_time_step_ratio");
+
+        jacobian_free_newton_krylov = prm.get_bool("jacobian_free_newton_krylov");
+        jfnk_preconditioner_update_frequency = prm.get_integer("jfnk_preconditioner_update_frequency");
+        jfnk_lax_friedrichs_preconditioner = prm.get_bool("jfnk_lax_friedrichs_preconditioner");
+        jacobian_update_frequency = prm.get_integer("jacobian_update_frequency");
+        preconditioner_update_frequency = prm.get_integer("preconditioner_update_frequency");
+        linearization_update_residual_ratio = prm.get_double("linearization_update_residual_ratio");
+        linearization_update_linear_iterations_ratio = prm.get_double("linearization_update_linear_iterations_ratio");
 
         print_iteration_modulo = prm.get_integer("print_iteration_modulo");
     }
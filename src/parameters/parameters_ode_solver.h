@@ -14,12 +14,21 @@ public:
     ODESolverParam (); ///< Constructor.
     /// Types of ODE solver
     enum ODESolverEnum {
-        explicit_solver, /// RK4
+        explicit_solver, /// Explicit Runge-Kutta selected by runge_kutta_method
         implicit_solver  /// Backward-Euler
     };
+    /// Explicit Runge-Kutta methods of the explicit_solver
+    enum RungeKuttaMethodEnum {
+        forward_euler, /// First order
+        ssp_rk3, /// Third-order strong stability preserving method of Shu and Osher
+        rk4, /// Classical fourth-order method
+        lsrk3_williamson, /// Third-order 3-stage low-storage method of Williamson
+        lsrk4_carpenter_kennedy /// Fourth-order 5-stage low-storage method of Carpenter and Kennedy
+    };
 
     OutputEnum ode_output; ///< verbose or quiet.
     ODESolverEnum ode_solver_type; ///< ODE solver type. Note that only implicit has been fully tested for now.
+    RungeKuttaMethodEnum runge_kutta_method; ///< Runge-Kutta method used by the explicit_solver.
 
     int output_solution_every_x_steps; ///< Outputs the solution every x steps to .vtk file
 
@@ -32,6 +41,52 @@ public:
     double time_step_factor_residual; ///< Multiplies initial time-step by time_step_factor_residual*(-log10(residual_norm_decrease))
     double time_step_factor_residual_exp; ///< Scales initial time step by pow(time_step_factor_residual*(-log10(residual_norm_decrease)),time_step_factor_residual_exp)
 
+    /// Evaluates the time steps of advance_solution_time() from the courant_number instead of the initial_time_step.
+    /** The time step is the smallest stable time step over all the cells, see ODESolver::evaluate_stable_time_step().
+     */
+    bool adaptive_time_step;
+    double courant_number; ///< Courant number of the adaptive and local time steps.
+    /// Advances each cell of the explicit steady_state iterations with its own stable time step.
+    /** Not time-accurate, such that it is not used by advance_solution_time(),
+     *  see multirate_time_step_ratio instead.
+     */
+    bool local_time_stepping;
+    /// Number of substeps of the fast cells in the explicit advance_solution_time().
+    /** With a ratio \f$ m > 1 \f$, the adaptive time step is \f$ m \f$ times the smallest stable one.
+     *  The cells whose stable time step is smaller than the step are advanced with \f$ m \f$ substeps
+     *  of the same Runge-Kutta method, and the other cells with a single step. Each substep only assembles
+     *  the residual of the fast cells and of their face neighbours. A ratio of 1 uses a single time step.
+     */
+    unsigned int multirate_time_step_ratio;
+
+    /// Solves the implicit steps with Jacobian-free Newton-Krylov.
+    /** The Krylov products are exact directional derivatives of the residual, evaluated by one forward-mode
+     *  pass through the residual assembly, see DGBase::apply_dRdW(). The dRdW is only assembled every
+     *  jfnk_preconditioner_update_frequency steps to build the preconditioner.
+     */
+    bool jacobian_free_newton_krylov;
+    unsigned int jfnk_preconditioner_update_frequency; ///< Number of steps between two assemblies of the preconditioner's dRdW.
+    /// Assembles the dRdW of the Jacobian-free Newton-Krylov preconditioner with the Lax-Friedrichs convective flux.
+    /** The more dissipative, lower-order flux gives a more diagonally dominant preconditioner than the Roe or
+     *  split-form flux of the residual. The Krylov products keep the residual's flux.
+     */
+    bool jfnk_lax_friedrichs_preconditioner;
+
+    /// Number of implicit steps between two assemblies of dRdW and of the time-scaled mass matrix.
+    /** In-between, the steps are chord steps that reuse the last system_matrix with the current residual.
+     *  Not used with jacobian_free_newton_krylov, whose operator is always current.
+     */
+    unsigned int jacobian_update_frequency;
+    /// Number of implicit steps between two factorizations of the GMRES preconditioner.
+    /** With a value of 1, the LinearSolver factorizes each new system or preconditioner matrix,
+     *  and keeps the factorization for the chord steps of the jacobian_update_frequency.
+     */
+    unsigned int preconditioner_update_frequency;
+    /// Updates the reused linearization when the residual norm is not reduced below this fraction of its previous value.
+    double linearization_update_residual_ratio;
+    /// Updates the reused linearization when the linear iterations exceed this multiple of the ones following the last factorization.
+    double linearization_update_linear_iterations_ratio;
+
     static void declare_parameters (dealii::ParameterHandler &prm); ///< Declares the possible variables and sets the defaults.
     void parse_parameters (dealii::ParameterHandler &prm); ///< Parses input file and sets the variables.
 };
@@ -2,6 +2,7 @@
 #include <deal.II/differentiation/ad/sacado_math.h>
 #include <deal.II/differentiation/ad/sacado_number_types.h>
 #include <deal.II/differentiation/ad/sacado_product_types.h>
+#include "ad_types.hpp"
 
 #include "burgers.h"
 
@@ -199,6 +200,11 @@ std::array<real,nstate> Burgers<dim,nstate,real>
 
 template class Burgers < PHILIP_DIM, PHILIP_DIM, double >;
 template class Burgers < PHILIP_DIM, PHILIP_DIM, Sacado::Fad::DFad<double>  >;
+template class Burgers < PHILIP_DIM, PHILIP_DIM, StaticFadType >;
+template class Burgers < PHILIP_DIM, PHILIP_DIM, DegreeFadType<2> >;
+template class Burgers < PHILIP_DIM, PHILIP_DIM, DegreeFadType<3> >;
+template class Burgers < PHILIP_DIM, PHILIP_DIM, DegreeFadType<4> >;
+template class Burgers < PHILIP_DIM, PHILIP_DIM, DirectionalFadType >;
 template class Burgers < PHILIP_DIM, PHILIP_DIM, Sacado::Fad::DFad<Sacado::Fad::DFad<double>>  >;
 template class Burgers < PHILIP_DIM, PHILIP_DIM, Sacado::Rad::ADvar<Sacado::Fad::DFad<double>>  >;
 
@@ -2,6 +2,7 @@
 #include <deal.II/differentiation/ad/sacado_math.h>
 #include <deal.II/differentiation/ad/sacado_number_types.h>
 #include <deal.II/differentiation/ad/sacado_product_types.h>
+#include "ad_types.hpp"
 
 #include "convection_diffusion.h"
 
@@ -197,6 +198,16 @@ template class ConvectionDiffusion < PHILIP_DIM, 1, double >;
 template class ConvectionDiffusion < PHILIP_DIM, 2, double >;
 template class ConvectionDiffusion < PHILIP_DIM, 1, Sacado::Fad::DFad<double>  >;
 template class ConvectionDiffusion < PHILIP_DIM, 2, Sacado::Fad::DFad<double>  >;
+template class ConvectionDiffusion < PHILIP_DIM, 1, StaticFadType >;
+template class ConvectionDiffusion < PHILIP_DIM, 2, StaticFadType >;
+template class ConvectionDiffusion < PHILIP_DIM, 1, DegreeFadType<2> >;
+template class ConvectionDiffusion < PHILIP_DIM, 2, DegreeFadType<2> >;
+template class ConvectionDiffusion < PHILIP_DIM, 1, DegreeFadType<3> >;
+template class ConvectionDiffusion < PHILIP_DIM, 2, DegreeFadType<3> >;
+template class ConvectionDiffusion < PHILIP_DIM, 1, DegreeFadType<4> >;
+template class ConvectionDiffusion < PHILIP_DIM, 2, DegreeFadType<4> >;
+template class ConvectionDiffusion < PHILIP_DIM, 1, DirectionalFadType >;
+template class ConvectionDiffusion < PHILIP_DIM, 2, DirectionalFadType >;
 template class ConvectionDiffusion < PHILIP_DIM, 1, Sacado::Fad::DFad<Sacado::Fad::DFad<double>>  >;
 template class ConvectionDiffusion < PHILIP_DIM, 2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>>  >;
 template class ConvectionDiffusion < PHILIP_DIM, 1, Sacado::Rad::ADvar<Sacado::Fad::DFad<double>>  >;
@@ -5,6 +5,7 @@
 #include <deal.II/differentiation/ad/sacado_math.h>
 #include <deal.II/differentiation/ad/sacado_number_types.h>
 #include <deal.II/differentiation/ad/sacado_product_types.h>
+#include "ad_types.hpp"
 
 #include "physics.h"
 #include "euler.h"
@@ -242,31 +243,24 @@ template <int dim, int nstate, typename real>
 inline real Euler<dim,nstate,real>
 ::compute_pressure ( const std::array<real,nstate> &conservative_soln ) const
 {
-    const real density = conservative_soln[0];
-    //std::cout << "density " << density << std::endl;
+    return compute_pressure_templated (conservative_soln);
+}
 
-    const real tot_energy  = conservative_soln[nstate-1];
-  //  std::cout << "tot_energy " << tot_energy << std::endl;
+template <int dim, int nstate, typename real>
+template <typename real2>
+real2 Euler<dim,nstate,real>
+::compute_pressure_templated ( const std::array<real2,nstate> &conservative_soln ) const
+{
+    const real2 density = conservative_soln[0];
+    const real2 tot_energy  = conservative_soln[nstate-1];
 
-    const dealii::Tensor<1,dim,real> vel = compute_velocities(conservative_soln);
-   // std::cout << "vel1 " << vel[0] << std::endl
-   //                      << vel[1] << std::endl
-//                         << vel[2] <<std::endl;
+    dealii::Tensor<1,dim,real2> vel;
+    for (int d=0; d<dim; ++d) { vel[d] = conservative_soln[1+d]/density; }
+    const real2 vel2 = vel*vel;
 
-    const real vel2 = compute_velocity_squared(vel);
-    //std::cout << "vel ^2 " << vel2 <<std::endl;
-    real pressure = gamm1*(tot_energy - 0.5*density*vel2);
-    //std::cout << "calculated pressure is" << pressure << std::endl;
-    if(pressure<0.0) {
-        //std::cout<<"Cannot compute pressure..."<<std::endl;
-        //std::cout<<"density "<<density<<std::endl;
-        //for(int d=0;d<dim;d++) std::cout<<"vel"<<d<<" "<<vel[d]<<std::endl;
-        //std::cout<<"energy "<<tot_energy<<std::endl;
-        pressure = 1e10;
-    }
-    //assert(pressure>0.0);
-    //if(pressure<1e-4) pressure = 0.01;
-    return pressure;
+    const real2 pressure = gamm1*(tot_energy - 0.5*density*vel2);
+    // Negative pressures are clipped
+    return compare_and_select<dealii::SIMDComparison::less_than> (pressure, make_constant<real2>(0.0), make_constant<real2>(1e10), pressure);
 }
 
 template <int dim, int nstate, typename real>
@@ -379,12 +373,21 @@ template <int dim, int nstate, typename real>
 std::array<dealii::Tensor<1,dim,real>,nstate> Euler<dim,nstate,real>
 ::convective_flux (const std::array<real,nstate> &conservative_soln) const
 {
-    std::array<dealii::Tensor<1,dim,real>,nstate> conv_flux;
-    const real density = conservative_soln[0];
-    const real pressure = compute_pressure (conservative_soln);
-    const dealii::Tensor<1,dim,real> vel = compute_velocities(conservative_soln);
-    const real specific_total_energy = conservative_soln[nstate-1]/conservative_soln[0];
-    const real specific_total_enthalpy = specific_total_energy + pressure/density;
+    return convective_flux_templated (conservative_soln);
+}
+
+template <int dim, int nstate, typename real>
+template <typename real2>
+std::array<dealii::Tensor<1,dim,real2>,nstate> Euler<dim,nstate,real>
+::convective_flux_templated (const std::array<real2,nstate> &conservative_soln) const
+{
+    std::array<dealii::Tensor<1,dim,real2>,nstate> conv_flux;
+    const real2 density = conservative_soln[0];
+    const real2 pressure = compute_pressure_templated (conservative_soln);
+    dealii::Tensor<1,dim,real2> vel;
+    for (int d=0; d<dim; ++d) { vel[d] = conservative_soln[1+d]/density; }
+    const real2 specific_total_energy = conservative_soln[nstate-1]/density;
+    const real2 specific_total_enthalpy = specific_total_energy + pressure/density;
 
     for (int flux_dim=0; flux_dim<dim; ++flux_dim) {
         // Density equation
@@ -492,18 +495,29 @@ template <int dim, int nstate, typename real>
 real Euler<dim,nstate,real>
 ::max_convective_eigenvalue (const std::array<real,nstate> &conservative_soln) const
 {
-    const dealii::Tensor<1,dim,real> vel = compute_velocities(conservative_soln);
+    return max_convective_eigenvalue_templated (conservative_soln);
+}
 
-    const real sound = compute_sound (conservative_soln);
+template <int dim, int nstate, typename real>
+template <typename real2>
+real2 Euler<dim,nstate,real>
+::max_convective_eigenvalue_templated (const std::array<real2,nstate> &conservative_soln) const
+{
+    const real2 density = conservative_soln[0];
+    dealii::Tensor<1,dim,real2> vel;
+    for (int d=0; d<dim; ++d) { vel[d] = conservative_soln[1+d]/density; }
+    const real2 vel2 = vel*vel;
 
-    real vel2 = compute_velocity_squared(vel);
+    // Same clipping of negative densities as compute_sound()
+    const real2 density_sound = compare_and_select<dealii::SIMDComparison::less_than> (density, make_constant<real2>(0.0), make_constant<real2>(1e10), density);
+    const real2 pressure = compute_pressure_templated (conservative_soln);
+    const real2 sound = std::sqrt(pressure*gam/density_sound);
 
-    const real max_eig = sqrt(vel2) + sound;
+    const real2 max_eig = std::sqrt(vel2) + sound;
 
     return max_eig;
 }
 
-
 template <int dim, int nstate, typename real>
 std::array<dealii::Tensor<1,dim,real>,nstate> Euler<dim,nstate,real>
 ::dissipative_flux (
@@ -870,9 +884,40 @@ dealii::UpdateFlags Euler<dim,nstate,real>
 
 template class Euler < PHILIP_DIM, PHILIP_DIM+2, double >;
 template class Euler < PHILIP_DIM, PHILIP_DIM+2, Sacado::Fad::DFad<double>  >;
+template class Euler < PHILIP_DIM, PHILIP_DIM+2, StaticFadType >;
+template class Euler < PHILIP_DIM, PHILIP_DIM+2, DegreeFadType<2> >;
+template class Euler < PHILIP_DIM, PHILIP_DIM+2, DegreeFadType<3> >;
+template class Euler < PHILIP_DIM, PHILIP_DIM+2, DegreeFadType<4> >;
+template class Euler < PHILIP_DIM, PHILIP_DIM+2, DirectionalFadType >;
 template class Euler < PHILIP_DIM, PHILIP_DIM+2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>>  >;
 template class Euler < PHILIP_DIM, PHILIP_DIM+2, Sacado::Rad::ADvar<Sacado::Fad::DFad<double>>  >;
 
+// Kernels templated on the scalar type that are used outside of this file.
+template std::array<dealii::Tensor<1,PHILIP_DIM,dealii::VectorizedArray<double>>,PHILIP_DIM+2> Euler < PHILIP_DIM, PHILIP_DIM+2, double >
+::convective_flux_templated (const std::array<dealii::VectorizedArray<double>,PHILIP_DIM+2> &) const;
+template dealii::VectorizedArray<double> Euler < PHILIP_DIM, PHILIP_DIM+2, double >
+::max_convective_eigenvalue_templated (const std::array<dealii::VectorizedArray<double>,PHILIP_DIM+2> &) const;
+template dealii::VectorizedArray<double> Euler < PHILIP_DIM, PHILIP_DIM+2, double >
+::compute_pressure_templated (const std::array<dealii::VectorizedArray<double>,PHILIP_DIM+2> &) const;
+template double Euler < PHILIP_DIM, PHILIP_DIM+2, double >
+::compute_pressure_templated (const std::array<double,PHILIP_DIM+2> &) const;
+template Sacado::Fad::DFad<double> Euler < PHILIP_DIM, PHILIP_DIM+2, Sacado::Fad::DFad<double> >
+::compute_pressure_templated (const std::array<Sacado::Fad::DFad<double>,PHILIP_DIM+2> &) const;
+template StaticFadType Euler < PHILIP_DIM, PHILIP_DIM+2, StaticFadType >
+::compute_pressure_templated (const std::array<StaticFadType,PHILIP_DIM+2> &) const;
+template DegreeFadType<2> Euler < PHILIP_DIM, PHILIP_DIM+2, DegreeFadType<2> >
+::compute_pressure_templated (const std::array<DegreeFadType<2>,PHILIP_DIM+2> &) const;
+template DegreeFadType<3> Euler < PHILIP_DIM, PHILIP_DIM+2, DegreeFadType<3> >
+::compute_pressure_templated (const std::array<DegreeFadType<3>,PHILIP_DIM+2> &) const;
+template DegreeFadType<4> Euler < PHILIP_DIM, PHILIP_DIM+2, DegreeFadType<4> >
+::compute_pressure_templated (const std::array<DegreeFadType<4>,PHILIP_DIM+2> &) const;
+template DirectionalFadType Euler < PHILIP_DIM, PHILIP_DIM+2, DirectionalFadType >
+::compute_pressure_templated (const std::array<DirectionalFadType,PHILIP_DIM+2> &) const;
+template Sacado::Fad::DFad<Sacado::Fad::DFad<double>> Euler < PHILIP_DIM, PHILIP_DIM+2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >
+::compute_pressure_templated (const std::array<Sacado::Fad::DFad<Sacado::Fad::DFad<double>>,PHILIP_DIM+2> &) const;
+template Sacado::Rad::ADvar<Sacado::Fad::DFad<double>> Euler < PHILIP_DIM, PHILIP_DIM+2, Sacado::Rad::ADvar<Sacado::Fad::DFad<double>> >
+::compute_pressure_templated (const std::array<Sacado::Rad::ADvar<Sacado::Fad::DFad<double>>,PHILIP_DIM+2> &) const;
+
 } // Physics namespace
 } // PHiLiP namespace
 
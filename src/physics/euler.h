@@ -141,6 +141,20 @@ public:
     /// Maximum convective eigenvalue used in Lax-Friedrichs
     real max_convective_eigenvalue (const std::array<real,nstate> &soln) const;
 
+    /// Convective flux templated on the scalar type, see convective_flux().
+    /** Also instantiated with dealii::VectorizedArray<double> for real=double, where each lane holds a different solution. */
+    template <typename real2>
+    std::array<dealii::Tensor<1,dim,real2>,nstate> convective_flux_templated (
+        const std::array<real2,nstate> &conservative_soln) const;
+
+    /// Maximum convective eigenvalue templated on the scalar type, see convective_flux_templated().
+    template <typename real2>
+    real2 max_convective_eigenvalue_templated (const std::array<real2,nstate> &conservative_soln) const;
+
+    /// Pressure templated on the scalar type, including the clipping of negative pressures, see convective_flux_templated().
+    template <typename real2>
+    real2 compute_pressure_templated (const std::array<real2,nstate> &conservative_soln) const;
+
     /// Dissipative flux: 0
     virtual std::array<dealii::Tensor<1,dim,real>,nstate> dissipative_flux (
         const std::array<real,nstate> &conservative_soln,
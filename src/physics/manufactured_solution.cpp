@@ -3,6 +3,7 @@
 #include <deal.II/base/function.templates.h> // Needed to instantiate dealii::Function<PHILIP_DIM,Sacado::Fad::DFad<double>>
 #include <deal.II/base/function_time.templates.h> // Needed to instantiate dealii::Function<PHILIP_DIM,Sacado::Fad::DFad<double>>
 
+#include "ad_types.hpp"
 #include "manufactured_solution.h"
 
 //#define ADDITIVE_SOLUTION
@@ -14,6 +15,16 @@
 
 template class dealii::FunctionTime<Sacado::Fad::DFad<double>>; // Needed by Function
 template class dealii::Function<PHILIP_DIM,Sacado::Fad::DFad<double>>;
+template class dealii::FunctionTime<PHiLiP::StaticFadType>;
+template class dealii::Function<PHILIP_DIM,PHiLiP::StaticFadType>;
+template class dealii::FunctionTime<PHiLiP::DegreeFadType<2>>;
+template class dealii::Function<PHILIP_DIM,PHiLiP::DegreeFadType<2>>;
+template class dealii::FunctionTime<PHiLiP::DegreeFadType<3>>;
+template class dealii::Function<PHILIP_DIM,PHiLiP::DegreeFadType<3>>;
+template class dealii::FunctionTime<PHiLiP::DegreeFadType<4>>;
+template class dealii::Function<PHILIP_DIM,PHiLiP::DegreeFadType<4>>;
+template class dealii::FunctionTime<PHiLiP::DirectionalFadType>;
+template class dealii::Function<PHILIP_DIM,PHiLiP::DirectionalFadType>;
 
 namespace PHiLiP {
 
@@ -27,6 +38,31 @@ bool isfinite(Sacado::Fad::DFad<double> value)
     return std::isfinite(static_cast<double>(value.val()));
 }
 
+bool isfinite(StaticFadType value)
+{
+    return std::isfinite(static_cast<double>(value.val()));
+}
+
+bool isfinite(DegreeFadType<2> value)
+{
+    return std::isfinite(static_cast<double>(value.val()));
+}
+
+bool isfinite(DegreeFadType<3> value)
+{
+    return std::isfinite(static_cast<double>(value.val()));
+}
+
+bool isfinite(DegreeFadType<4> value)
+{
+    return std::isfinite(static_cast<double>(value.val()));
+}
+
+bool isfinite(DirectionalFadType value)
+{
+    return std::isfinite(static_cast<double>(value.val()));
+}
+
 bool isfinite(Sacado::Fad::DFad<Sacado::Fad::DFad<double>> value)
 {
     return std::isfinite(static_cast<double>(value.val().val()));
@@ -573,6 +609,11 @@ inline std::vector<real> ManufacturedSolutionFunction<dim,real>
 
 template class ManufacturedSolutionFunction<PHILIP_DIM,double>;
 template class ManufacturedSolutionFunction<PHILIP_DIM,Sacado::Fad::DFad<double>>;
+template class ManufacturedSolutionFunction<PHILIP_DIM,StaticFadType>;
+template class ManufacturedSolutionFunction<PHILIP_DIM,DegreeFadType<2>>;
+template class ManufacturedSolutionFunction<PHILIP_DIM,DegreeFadType<3>>;
+template class ManufacturedSolutionFunction<PHILIP_DIM,DegreeFadType<4>>;
+template class ManufacturedSolutionFunction<PHILIP_DIM,DirectionalFadType>;
 template class ManufacturedSolutionFunction<PHILIP_DIM,Sacado::Fad::DFad<Sacado::Fad::DFad<double>>>;
 template class ManufacturedSolutionFunction<PHILIP_DIM,Sacado::Rad::ADvar<Sacado::Fad::DFad<double>>>;
 
@@ -5,6 +5,7 @@
 #include <deal.II/differentiation/ad/sacado_math.h>
 #include <deal.II/differentiation/ad/sacado_number_types.h>
 #include <deal.II/differentiation/ad/sacado_product_types.h>
+#include "ad_types.hpp"
 
 #include "physics.h"
 #include "mhd.h"
@@ -792,6 +793,11 @@ std::array<dealii::Tensor<1,dim,real>,nstate> MHD<dim,nstate,real>
 // Instantiate explicitly
 template class MHD < PHILIP_DIM, 8, double >;
 template class MHD < PHILIP_DIM, 8, Sacado::Fad::DFad<double>  >;
+template class MHD < PHILIP_DIM, 8, StaticFadType >;
+template class MHD < PHILIP_DIM, 8, DegreeFadType<2> >;
+template class MHD < PHILIP_DIM, 8, DegreeFadType<3> >;
+template class MHD < PHILIP_DIM, 8, DegreeFadType<4> >;
+template class MHD < PHILIP_DIM, 8, DirectionalFadType >;
 template class MHD < PHILIP_DIM, 8, Sacado::Fad::DFad<Sacado::Fad::DFad<double>>  >;
 template class MHD < PHILIP_DIM, 8, Sacado::Rad::ADvar<Sacado::Fad::DFad<double>>  >;
 
@@ -6,6 +6,7 @@
 #include <deal.II/differentiation/ad/sacado_math.h>
 #include <deal.II/differentiation/ad/sacado_number_types.h>
 #include <deal.II/differentiation/ad/sacado_product_types.h>
+#include "ad_types.hpp"
 
 #include "physics.h"
 
@@ -225,6 +226,36 @@ template class PhysicsBase < PHILIP_DIM, 3, Sacado::Fad::DFad<double> >;
 template class PhysicsBase < PHILIP_DIM, 4, Sacado::Fad::DFad<double> >;
 template class PhysicsBase < PHILIP_DIM, 5, Sacado::Fad::DFad<double> >;
 template class PhysicsBase < PHILIP_DIM, 8, Sacado::Fad::DFad<double> >;
+template class PhysicsBase < PHILIP_DIM, 1, StaticFadType >;
+template class PhysicsBase < PHILIP_DIM, 2, StaticFadType >;
+template class PhysicsBase < PHILIP_DIM, 3, StaticFadType >;
+template class PhysicsBase < PHILIP_DIM, 4, StaticFadType >;
+template class PhysicsBase < PHILIP_DIM, 5, StaticFadType >;
+template class PhysicsBase < PHILIP_DIM, 8, StaticFadType >;
+template class PhysicsBase < PHILIP_DIM, 1, DegreeFadType<2> >;
+template class PhysicsBase < PHILIP_DIM, 2, DegreeFadType<2> >;
+template class PhysicsBase < PHILIP_DIM, 3, DegreeFadType<2> >;
+template class PhysicsBase < PHILIP_DIM, 4, DegreeFadType<2> >;
+template class PhysicsBase < PHILIP_DIM, 5, DegreeFadType<2> >;
+template class PhysicsBase < PHILIP_DIM, 8, DegreeFadType<2> >;
+template class PhysicsBase < PHILIP_DIM, 1, DegreeFadType<3> >;
+template class PhysicsBase < PHILIP_DIM, 2, DegreeFadType<3> >;
+template class PhysicsBase < PHILIP_DIM, 3, DegreeFadType<3> >;
+template class PhysicsBase < PHILIP_DIM, 4, DegreeFadType<3> >;
+template class PhysicsBase < PHILIP_DIM, 5, DegreeFadType<3> >;
+template class PhysicsBase < PHILIP_DIM, 8, DegreeFadType<3> >;
+template class PhysicsBase < PHILIP_DIM, 1, DegreeFadType<4> >;
+template class PhysicsBase < PHILIP_DIM, 2, DegreeFadType<4> >;
+template class PhysicsBase < PHILIP_DIM, 3, DegreeFadType<4> >;
+template class PhysicsBase < PHILIP_DIM, 4, DegreeFadType<4> >;
+template class PhysicsBase < PHILIP_DIM, 5, DegreeFadType<4> >;
+template class PhysicsBase < PHILIP_DIM, 8, DegreeFadType<4> >;
+template class PhysicsBase < PHILIP_DIM, 1, DirectionalFadType >;
+template class PhysicsBase < PHILIP_DIM, 2, DirectionalFadType >;
+template class PhysicsBase < PHILIP_DIM, 3, DirectionalFadType >;
+template class PhysicsBase < PHILIP_DIM, 4, DirectionalFadType >;
+template class PhysicsBase < PHILIP_DIM, 5, DirectionalFadType >;
+template class PhysicsBase < PHILIP_DIM, 8, DirectionalFadType >;
 
 template class PhysicsBase < PHILIP_DIM, 1, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class PhysicsBase < PHILIP_DIM, 2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
@@ -1,7 +1,10 @@
 #ifndef __PHYSICS__
 #define __PHYSICS__
 
+#include <type_traits>
+
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 #include <deal.II/numerics/data_component_interpretation.h>
 #include <deal.II/fe/fe_update_flags.h>
 
@@ -12,6 +15,38 @@
 namespace PHiLiP {
 namespace Physics {
 
+/// Returns \p value as the scalar type \p real2, on all the lanes of a dealii::VectorizedArray<double>.
+template <typename real2>
+inline real2 make_constant (const double value)
+{
+    if constexpr (std::is_same<real2, dealii::VectorizedArray<double>>::value) {
+        return dealii::make_vectorized_array(value);
+    } else {
+        return real2(value);
+    }
+}
+
+/// Returns \p if_true where the comparison of \p left and \p right holds, and \p if_false elsewhere.
+/** Branch shared by the kernels templated on the scalar type. The scalar and AD types compare with an if-statement,
+ *  as the AD requires, and dealii::VectorizedArray<double> selects each lane through dealii::compare_and_apply_mask().
+ *  Only SIMDComparison::less_than and SIMDComparison::greater_than are used.
+ */
+template <dealii::SIMDComparison predicate, typename real2>
+inline real2 compare_and_select (const real2 &left, const real2 &right, const real2 &if_true, const real2 &if_false)
+{
+    static_assert(predicate == dealii::SIMDComparison::less_than || predicate == dealii::SIMDComparison::greater_than,
+                  "Only less_than and greater_than are implemented.");
+    if constexpr (std::is_same<real2, dealii::VectorizedArray<double>>::value) {
+        return dealii::compare_and_apply_mask<predicate> (left, right, if_true, if_false);
+    } else if constexpr (predicate == dealii::SIMDComparison::less_than) {
+        if (left < right) return if_true;
+        return if_false;
+    } else {
+        if (left > right) return if_true;
+        return if_false;
+    }
+}
+
 /// Base class from which Advection, Diffusion, ConvectionDiffusion, and Euler is derived.
 /**
  *  Main interface for all the convective and diffusive terms.
@@ -1,3 +1,4 @@
+#include "ad_types.hpp"
 #include "parameters/all_parameters.h"
 
 #include "physics_factory.h"
@@ -56,6 +57,36 @@ template class PhysicsFactory<PHILIP_DIM, 3, Sacado::Fad::DFad<double> >;
 template class PhysicsFactory<PHILIP_DIM, 4, Sacado::Fad::DFad<double> >;
 template class PhysicsFactory<PHILIP_DIM, 5, Sacado::Fad::DFad<double> >;
 template class PhysicsFactory<PHILIP_DIM, 8, Sacado::Fad::DFad<double> >;
+template class PhysicsFactory<PHILIP_DIM, 1, StaticFadType >;
+template class PhysicsFactory<PHILIP_DIM, 2, StaticFadType >;
+template class PhysicsFactory<PHILIP_DIM, 3, StaticFadType >;
+template class PhysicsFactory<PHILIP_DIM, 4, StaticFadType >;
+template class PhysicsFactory<PHILIP_DIM, 5, StaticFadType >;
+template class PhysicsFactory<PHILIP_DIM, 8, StaticFadType >;
+template class PhysicsFactory<PHILIP_DIM, 1, DegreeFadType<2> >;
+template class PhysicsFactory<PHILIP_DIM, 2, DegreeFadType<2> >;
+template class PhysicsFactory<PHILIP_DIM, 3, DegreeFadType<2> >;
+template class PhysicsFactory<PHILIP_DIM, 4, DegreeFadType<2> >;
+template class PhysicsFactory<PHILIP_DIM, 5, DegreeFadType<2> >;
+template class PhysicsFactory<PHILIP_DIM, 8, DegreeFadType<2> >;
+template class PhysicsFactory<PHILIP_DIM, 1, DegreeFadType<3> >;
+template class PhysicsFactory<PHILIP_DIM, 2, DegreeFadType<3> >;
+template class PhysicsFactory<PHILIP_DIM, 3, DegreeFadType<3> >;
+template class PhysicsFactory<PHILIP_DIM, 4, DegreeFadType<3> >;
+template class PhysicsFactory<PHILIP_DIM, 5, DegreeFadType<3> >;
+template class PhysicsFactory<PHILIP_DIM, 8, DegreeFadType<3> >;
+template class PhysicsFactory<PHILIP_DIM, 1, DegreeFadType<4> >;
+template class PhysicsFactory<PHILIP_DIM, 2, DegreeFadType<4> >;
+template class PhysicsFactory<PHILIP_DIM, 3, DegreeFadType<4> >;
+template class PhysicsFactory<PHILIP_DIM, 4, DegreeFadType<4> >;
+template class PhysicsFactory<PHILIP_DIM, 5, DegreeFadType<4> >;
+template class PhysicsFactory<PHILIP_DIM, 8, DegreeFadType<4> >;
+template class PhysicsFactory<PHILIP_DIM, 1, DirectionalFadType >;
+template class PhysicsFactory<PHILIP_DIM, 2, DirectionalFadType >;
+template class PhysicsFactory<PHILIP_DIM, 3, DirectionalFadType >;
+template class PhysicsFactory<PHILIP_DIM, 4, DirectionalFadType >;
+template class PhysicsFactory<PHILIP_DIM, 5, DirectionalFadType >;
+template class PhysicsFactory<PHILIP_DIM, 8, DirectionalFadType >;
 
 template class PhysicsFactory<PHILIP_DIM, 1, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
 template class PhysicsFactory<PHILIP_DIM, 2, Sacado::Fad::DFad<Sacado::Fad::DFad<double>> >;
@@ -261,7 +261,7 @@ int EulerBumpOptimization<dim,nstate>
 
         // Initialize coarse grid solution with free-stream
         dg->allocate_system ();
-        dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->solution);
+        dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->modify_solution());
         // Create ODE solver and ramp up the solution from p0
         std::shared_ptr<ODE::ODESolver<dim, double>> ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
         ode_solver->initialize_steady_polynomial_ramping (poly_degree);
@@ -288,7 +288,7 @@ int EulerBumpOptimization<dim,nstate>
         // Initialize flow solution with free-stream
         std::shared_ptr < DGBase<dim, double> > dg = DGFactory<dim,double>::create_discontinuous_galerkin(&param, poly_degree, grid);
         dg->allocate_system ();
-        dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->solution);
+        dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->modify_solution());
         // Create ODE solver and ramp up the solution from p0
         std::shared_ptr<ODE::ODESolver<dim, double>> ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
         ode_solver->initialize_steady_polynomial_ramping (poly_degree);
@@ -367,7 +367,7 @@ int EulerBumpOptimization<dim,nstate>
     // Initialize flow solution with free-stream
     std::shared_ptr < DGBase<dim, double> > dg = DGFactory<dim,double>::create_discontinuous_galerkin(&param, poly_degree, grid);
     dg->allocate_system ();
-    dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->solution);
+    dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->modify_solution());
     // Create ODE solver and ramp up the solution from p0
     std::shared_ptr<ODE::ODESolver<dim, double>> ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
     //param.ode_solver_param.nonlinear_steady_residual_tolerance = 1e-4;
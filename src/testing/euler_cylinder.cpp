@@ -169,7 +169,7 @@ int EulerCylinder<dim,nstate>
 
         dg->allocate_system ();
         // Initialize coarse grid solution with free-stream
-        dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->solution);
+        dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->modify_solution());
 
         // Create ODE solver and ramp up the solution from p0
         std::shared_ptr<ODE::ODESolver<dim, double>> ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
@@ -193,8 +193,8 @@ int EulerCylinder<dim,nstate>
                 //grid->execute_coarsening_and_refinement();
                 dg->high_order_grid.execute_coarsening_and_refinement();
                 dg->allocate_system ();
-                dg->solution.zero_out_ghosts();
-                solution_transfer.interpolate(dg->solution);
+                dg->modify_solution().zero_out_ghosts();
+                solution_transfer.interpolate(dg->modify_solution());
                 dg->solution.update_ghost_values();
             }
 
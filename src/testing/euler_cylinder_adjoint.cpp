@@ -235,7 +235,7 @@ int EulerCylinderAdjoint<dim,nstate>
 
         dg->allocate_system ();
         // Initialize coarse grid solution with free-stream
-        dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->solution);
+        dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->modify_solution());
 
         // Create ODE solver and ramp up the solution from p0
         std::shared_ptr<ODE::ODESolver<dim, double>> ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
@@ -268,8 +268,8 @@ int EulerCylinderAdjoint<dim,nstate>
                 grid->execute_coarsening_and_refinement();
                 dg->high_order_grid.execute_coarsening_and_refinement();
                 dg->allocate_system ();
-                dg->solution.zero_out_ghosts();
-                solution_transfer.interpolate(dg->solution);
+                dg->modify_solution().zero_out_ghosts();
+                solution_transfer.interpolate(dg->modify_solution());
                 dg->solution.update_ghost_values();
             }
 
@@ -359,7 +359,8 @@ int EulerCylinderAdjoint<dim,nstate>
             // evaluating the derivatives and the adjoint on the fine grid
             adjoint.convert_to_state(AdjointEnum::fine); // will do this automatically, but I prefer to repeat explicitly
             adjoint.fine_grid_adjoint();
-            estimated_error_per_cell = adjoint.dual_weighted_residual(); // performing the error indicator computation
+            adjoint.dual_weighted_residual(); // performing the error indicator computation
+            estimated_error_per_cell = adjoint.dual_weighted_residual_cell_data();
 
             // and outputing the fine properties
             adjoint.output_results_vtk(igrid);
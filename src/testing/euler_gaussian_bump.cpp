@@ -102,7 +102,7 @@ int EulerGaussianBump<dim,nstate>
 
         // // Initialize coarse grid solution with free-stream
         // dg->allocate_system ();
-        // dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->solution);
+        // dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->modify_solution());
 
         // // Create ODE solver and ramp up the solution from p0
         // std::shared_ptr<ODE::ODESolver<dim, double>> ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
@@ -120,7 +120,7 @@ int EulerGaussianBump<dim,nstate>
             //    dg->high_order_grid.execute_coarsening_and_refinement(true);
             //    dg->allocate_system ();
             //    dg->solution.zero_out_ghosts();
-            //    solution_transfer.interpolate(dg->solution);
+            //    solution_transfer.interpolate(dg->modify_solution());
             //    dg->solution.update_ghost_values();
             //}
 
@@ -142,7 +142,7 @@ int EulerGaussianBump<dim,nstate>
 
             // Initialize coarse grid solution with free-stream
             dg->allocate_system ();
-            dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->solution);
+            dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->modify_solution());
 
             const unsigned int n_global_active_cells = grid->n_global_active_cells();
             const unsigned int n_dofs = dg->dof_handler.n_dofs();
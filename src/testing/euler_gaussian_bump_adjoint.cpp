@@ -397,7 +397,7 @@ int EulerGaussianBumpAdjoint<dim,nstate>
 
         // Initialize coarse grid solution with free-stream
         dg->allocate_system ();
-        dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->solution);
+        dealii::VectorTools::interpolate(dg->dof_handler, initial_conditions, dg->modify_solution());
 
         // Create ODE solver and ramp up the solution from p0
         std::shared_ptr<ODE::ODESolver<dim, double>> ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
@@ -414,8 +414,8 @@ int EulerGaussianBumpAdjoint<dim,nstate>
                 grid.refine_global (1);
                 dg->high_order_grid.execute_coarsening_and_refinement();
                 dg->allocate_system ();
-                dg->solution.zero_out_ghosts();
-                solution_transfer.interpolate(dg->solution);
+                dg->modify_solution().zero_out_ghosts();
+                solution_transfer.interpolate(dg->modify_solution());
                 dg->solution.update_ghost_values();
             }
 
@@ -429,8 +429,8 @@ int EulerGaussianBumpAdjoint<dim,nstate>
             dg->set_all_cells_fe_degree(poly_degree);
             dg->allocate_system();
 
-            dg->solution.zero_out_ghosts();
-            solution_transfer.interpolate(dg->solution);
+            dg->modify_solution().zero_out_ghosts();
+            solution_transfer.interpolate(dg->modify_solution());
             dg->solution.update_ghost_values();
 
             // const unsigned int n_global_active_cells = grid.n_global_active_cells();
@@ -125,7 +125,7 @@ int EulerTaylorGreen<dim, nstate>::run_test() const
 //	dealii::deallog << result;
 
 	std::cout << "initial condition successfully implemented" << std::endl;
-	dealii::VectorTools::interpolate(dg->dof_handler,initial_condition,dg->solution);
+	dealii::VectorTools::interpolate(dg->dof_handler,initial_condition,dg->modify_solution());
 	std::cout << "initial condition interpolated to DG solution" << std::endl;
 	// Create ODE solver using the factory and providing the DG object
 
@@ -233,7 +233,7 @@ int EulerVortex<dim,nstate>
             dg->allocate_system ();
 
             // Initialize solution with vortex function at time t=0
-            dealii::VectorTools::interpolate(dg->dof_handler, initial_vortex_function, dg->solution);
+            dealii::VectorTools::interpolate(dg->dof_handler, initial_vortex_function, dg->modify_solution());
             // dealii::AffineConstraints<double> constraints;
             // constraints.close();
             // dealii::VectorTools::project (dg->dof_handler,
@@ -45,7 +45,7 @@ void GridStudy<dim,nstate>
     dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
     solution_no_ghost.reinit(dg.locally_owned_dofs, MPI_COMM_WORLD);
     dealii::VectorTools::interpolate(dg.dof_handler, *physics.manufactured_solution_function, solution_no_ghost);
-    dg.solution = solution_no_ghost;
+    dg.set_solution(solution_no_ghost);
 }
 template <int dim, int nstate>
 double GridStudy<dim,nstate>
@@ -318,7 +318,7 @@ void initialize_perturbed_solution(PHiLiP::DGBase<dim,double> &dg, const PHiLiP:
     dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
     solution_no_ghost.reinit(dg.locally_owned_dofs, MPI_COMM_WORLD);
     dealii::VectorTools::interpolate(dg.dof_handler, *physics.manufactured_solution_function, solution_no_ghost);
-    dg.solution = solution_no_ghost;
+    dg.set_solution(solution_no_ghost);
 }
 
 template<int dim, int nstate>
@@ -423,7 +423,7 @@ int OptimizationInverseManufactured<dim,nstate>
 		meshmover(high_order_grid, surface_node_displacements_vector);
 	VectorType volume_displacements = meshmover.get_volume_displacements();
 
-	high_order_grid.volume_nodes += volume_displacements;
+	high_order_grid.modify_volume_nodes() += volume_displacements;
 	high_order_grid.volume_nodes.update_ghost_values();
     high_order_grid.update_surface_nodes();
 	//{
@@ -493,8 +493,7 @@ int OptimizationInverseManufactured<dim,nstate>
 	//high_order_grid.volume_nodes.update_ghost_values();
     //high_order_grid.update_surface_nodes();
 	
-	high_order_grid.volume_nodes = initial_grid;
-	high_order_grid.volume_nodes.update_ghost_values();
+	high_order_grid.set_volume_nodes(initial_grid);
     high_order_grid.update_surface_nodes();
 	pcout << "Initial grid: " << std::endl;
 	dg->output_results_vtk(9998);
@@ -649,7 +648,7 @@ int OptimizationInverseManufactured<dim,nstate>
 		auto dRdW_T = transpose_trilinos_matrix(dg->system_matrix);
 
 		Parameters::LinearSolverParam linear_solver_param = all_parameters->linear_solver_param;
-		solve_linear (dRdW_T, inverse_target_functional.dIdw, dg->dual, linear_solver_param);
+		solve_linear (dRdW_T, inverse_target_functional.dIdw, dg->modify_dual(), linear_solver_param);
 
 		grad_lagrangian = dIdXs;
 		grad_lagrangian *= -1.0;
@@ -703,7 +702,7 @@ int OptimizationInverseManufactured<dim,nstate>
 			} else {
 
 				VectorType volume_displacements = meshmover.get_volume_displacements();
-				high_order_grid.volume_nodes += volume_displacements;
+				high_order_grid.modify_volume_nodes() += volume_displacements;
 				high_order_grid.volume_nodes.update_ghost_values();
 				high_order_grid.update_surface_nodes();
 
@@ -726,9 +725,8 @@ int OptimizationInverseManufactured<dim,nstate>
 				if (current_functional < old_func_plus) break;
 			}
 
-			dg->solution = old_solution;
-			high_order_grid.volume_nodes = old_volume_nodes;
-			high_order_grid.volume_nodes.update_ghost_values();
+			dg->set_solution(old_solution);
+			high_order_grid.set_volume_nodes(old_volume_nodes);
 			high_order_grid.update_surface_nodes();
 			step_length *= 0.5;
 		}
@@ -785,7 +783,7 @@ int OptimizationInverseManufactured<dim,nstate>
 		auto dRdW_T = transpose_trilinos_matrix(dg->system_matrix);
 
 		Parameters::LinearSolverParam linear_solver_param = all_parameters->linear_solver_param;
-		solve_linear (dRdW_T, inverse_target_functional.dIdw, dg->dual, linear_solver_param);
+		solve_linear (dRdW_T, inverse_target_functional.dIdw, dg->modify_dual(), linear_solver_param);
 
 		const auto old_grad_lagrangian = grad_lagrangian;
 		grad_lagrangian = dIdXs;
@@ -1070,8 +1068,7 @@ int OptimizationInverseManufactured<dim,nstate>
 
 	pcout << std::endl << std::endl << std::endl << std::endl;
 	// Make sure that if the volume_nodes are located at the target volume_nodes, then we recover our target functional
-	high_order_grid.volume_nodes = target_nodes;
-	high_order_grid.volume_nodes.update_ghost_values();
+	high_order_grid.set_volume_nodes(target_nodes);
     high_order_grid.update_surface_nodes();
 	// Solve on this new grid
 	ode_solver->steady_state();
@@ -188,7 +188,7 @@ void Shock1D<dim,nstate>
     dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
     solution_no_ghost.reinit(dg.locally_owned_dofs, MPI_COMM_WORLD);
     dealii::VectorTools::interpolate(dg.dof_handler, SineInitialCondition<dim> (1,0), solution_no_ghost);
-    dg.solution = solution_no_ghost;
+    dg.set_solution(solution_no_ghost);
 }
 
 template<int dim, int nstate>
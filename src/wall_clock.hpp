@@ -0,0 +1,16 @@
+#ifndef __WALL_CLOCK_H__
+#define __WALL_CLOCK_H__
+
+#include <chrono>
+
+namespace PHiLiP {
+
+/// Wall-clock time in seconds elapsed since \p start.
+inline double seconds_since (const std::chrono::steady_clock::time_point &start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // PHiLiP namespace
+
+#endif
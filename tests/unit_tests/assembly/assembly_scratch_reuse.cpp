@@ -0,0 +1,74 @@
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Checks that the FEValues used by assemble_residual() are only built when required.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.pde_type = Parameters::AllParameters::PartialDifferentialEquation::advection;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        MPI_COMM_WORLD,
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, 4);
+
+    const unsigned int poly_degree = 2;
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+    dg->modify_solution().add(1.0);
+
+    // Repeated assemblies, as done by the line search, reuse the same FEValues.
+    const unsigned int n_assemblies = 5;
+    for (unsigned int i = 0; i < n_assemblies; ++i) {
+        dg->assemble_residual ();
+    }
+    dg->assemble_residual (true);
+
+    // Moving the nodes does not require new FEValues.
+    dg->high_order_grid.modify_volume_nodes() *= 1.01;
+    dg->high_order_grid.volume_nodes.update_ghost_values();
+    dg->assemble_residual ();
+
+    int error = 0;
+    pcout << "Number of FEValues rebuilds after " << n_assemblies+2 << " assemblies: " << dg->n_assembly_scratch_rebuilds << std::endl;
+    if (dg->n_assembly_scratch_rebuilds != 1) error = 1;
+
+    // Re-allocating the system invalidates them.
+    dg->allocate_system ();
+    dg->assemble_residual ();
+    pcout << "Number of FEValues rebuilds after re-allocating the system: " << dg->n_assembly_scratch_rebuilds << std::endl;
+    if (dg->n_assembly_scratch_rebuilds != 2) error = 1;
+
+    return error;
+}
@@ -0,0 +1,114 @@
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Moves the high-order nodes with a smooth displacement, such that the cells are no longer affine.
+void move_nodes (PHiLiP::HighOrderGrid<PHILIP_DIM,double> &high_order_grid)
+{
+    dealii::LinearAlgebra::distributed::Vector<double> &volume_nodes = high_order_grid.modify_volume_nodes();
+    for (unsigned int i = 0; i < volume_nodes.size(); ++i) {
+        if (volume_nodes.locally_owned_elements().is_element(i)) {
+            const double x = volume_nodes[i];
+            volume_nodes[i] = x + 0.05*x*(1.0-x);
+        }
+    }
+    volume_nodes.update_ghost_values();
+}
+
+/// Returns 1 if the cell-wise inverse mass matrix does not match the global sparse one.
+int compare_inverse_mass_matrices (
+    PHiLiP::DGBase<PHILIP_DIM,double> &dg,
+    PHiLiP::Parameters::AllParameters &all_parameters,
+    const dealii::LinearAlgebra::distributed::Vector<double> &src,
+    const std::string &description)
+{
+    const int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+    const bool do_inverse_mass_matrix = true;
+
+    all_parameters.use_cell_inverse_mass_matrix = false;
+    dg.evaluate_mass_matrices (do_inverse_mass_matrix);
+    dealii::LinearAlgebra::distributed::Vector<double> reference_dst(src);
+    dg.apply_inverse_mass_matrix (src, reference_dst);
+
+    all_parameters.use_cell_inverse_mass_matrix = true;
+    dg.evaluate_mass_matrices (do_inverse_mass_matrix);
+    dealii::LinearAlgebra::distributed::Vector<double> dst(src);
+    dg.apply_inverse_mass_matrix (src, dst);
+    // Adding to the destination gives twice the product.
+    const bool add_to_dst = true;
+    dg.apply_inverse_mass_matrix (src, dst, add_to_dst);
+    dst *= 0.5;
+
+    dst -= reference_dst;
+    const double relative_difference = dst.l2_norm() / reference_dst.l2_norm();
+    pcout << description << ": relative difference " << relative_difference << std::endl;
+    if (relative_difference > 1e-12) {
+        pcout << "The cell-wise inverse mass matrix does not match the global one." << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/// Checks that the cell-wise inverse mass matrix matches the global sparse one on affine and curved cells.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = 1;
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.pde_type = Parameters::AllParameters::PartialDifferentialEquation::convection_diffusion;
+
+    int error = 0;
+    // Collocated nodes give a diagonal reference inverse mass matrix.
+    for (const bool use_collocated_nodes : {false, true}) {
+        all_parameters.use_collocated_nodes = use_collocated_nodes;
+
+#if PHILIP_DIM==1
+        std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+            typename dealii::Triangulation<dim>::MeshSmoothing(
+                dealii::Triangulation<dim>::smoothing_on_refinement |
+                dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+        std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+            MPI_COMM_WORLD,
+            typename dealii::Triangulation<dim>::MeshSmoothing(
+                dealii::Triangulation<dim>::smoothing_on_refinement |
+                dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+        dealii::GridGenerator::subdivided_hyper_cube(*grid, 4);
+
+        const unsigned int poly_degree = 2;
+        std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+        dg->allocate_system ();
+
+        std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+        dealii::LinearAlgebra::distributed::Vector<double> src;
+        src.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+        dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), src);
+
+        const std::string nodes = use_collocated_nodes ? "Collocated nodes" : "Gauss-Legendre nodes";
+        error += compare_inverse_mass_matrices (*dg, all_parameters, src, nodes + " on affine cells");
+        move_nodes (dg->high_order_grid);
+        error += compare_inverse_mass_matrices (*dg, all_parameters, src, nodes + " on curved cells");
+    }
+
+    return std::min(error, 1);
+}
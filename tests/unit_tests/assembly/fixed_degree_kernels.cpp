@@ -0,0 +1,137 @@
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+const double TOLERANCE = 1E-12;
+
+/// Moves the high-order nodes with a smooth displacement such that the cells are curved.
+void move_nodes (PHiLiP::HighOrderGrid<PHILIP_DIM,double> &high_order_grid)
+{
+    dealii::LinearAlgebra::distributed::Vector<double> &volume_nodes = high_order_grid.modify_volume_nodes();
+    for (unsigned int i = 0; i < volume_nodes.size(); ++i) {
+        if (volume_nodes.locally_owned_elements().is_element(i)) {
+            const double x = volume_nodes[i];
+            volume_nodes[i] = x + 0.05*x*(1.0-x);
+        }
+    }
+    volume_nodes.update_ghost_values();
+}
+
+/// Returns the weak form right-hand side evaluated with or without the fixed-degree volume kernels.
+template<int dim, int nstate>
+dealii::LinearAlgebra::distributed::Vector<double> evaluate_rhs (
+    const unsigned int poly_degree,
+    std::shared_ptr<Triangulation> grid,
+    PHiLiP::Parameters::AllParameters all_parameters,
+    const bool use_fixed_degree_kernels)
+{
+    using namespace PHiLiP;
+    all_parameters.use_fixed_degree_kernels = use_fixed_degree_kernels;
+
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+    move_nodes (dg->high_order_grid);
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg->set_solution(solution_no_ghost);
+
+    dg->assemble_residual ();
+    return dg->right_hand_side;
+}
+
+/// Compares the residuals for polynomial degrees 1 to 5, where 5 uses the generic loops in both cases.
+template<int dim, int nstate>
+int test (
+    std::shared_ptr<Triangulation> grid,
+    const PHiLiP::Parameters::AllParameters &all_parameters)
+{
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    int error = 0;
+    for (unsigned int poly_degree = 1; poly_degree <= 5; ++poly_degree) {
+        const dealii::LinearAlgebra::distributed::Vector<double> rhs_generic = evaluate_rhs<dim,nstate>(poly_degree, grid, all_parameters, false);
+        dealii::LinearAlgebra::distributed::Vector<double> rhs_fixed_degree = evaluate_rhs<dim,nstate>(poly_degree, grid, all_parameters, true);
+
+        const double rhs_norm = rhs_generic.l2_norm();
+        rhs_fixed_degree -= rhs_generic;
+        const double relative_difference = rhs_fixed_degree.l2_norm() / std::max(rhs_norm, 1.0);
+
+        pcout << "Poly degree " << poly_degree
+              << " source term " << all_parameters.manufactured_convergence_study_param.use_manufactured_source_term
+              << " rhs norm " << rhs_norm
+              << " relative difference " << relative_difference << std::endl;
+        if (relative_difference > TOLERANCE) {
+            pcout << "Fixed-degree residual differs from the generic residual." << std::endl;
+            error = 1;
+        }
+    }
+    return error;
+}
+
+/// Checks that the fixed-degree weak form volume kernels give the same residual as the generic loops.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.use_weak_form = true;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        MPI_COMM_WORLD,
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, 3);
+    for (auto &cell : grid->active_cell_iterators()) {
+        for (unsigned int face=0; face<dealii::GeometryInfo<dim>::faces_per_cell; ++face) {
+            if (cell->face(face)->at_boundary()) cell->face(face)->set_boundary_id (1000);
+        }
+    }
+
+    int error = 0;
+    for (const bool use_source_term : {false, true}) {
+        all_parameters.manufactured_convergence_study_param.use_manufactured_source_term = use_source_term;
+
+        all_parameters.pde_type = PDEType::advection;
+        error += test<dim,1> (grid, all_parameters);
+
+        all_parameters.pde_type = PDEType::convection_diffusion;
+        error += test<dim,1> (grid, all_parameters);
+
+        all_parameters.pde_type = PDEType::euler;
+        error += test<dim,dim+2> (grid, all_parameters);
+    }
+
+    return error;
+}
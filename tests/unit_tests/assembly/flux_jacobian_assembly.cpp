@@ -0,0 +1,161 @@
+#include <chrono>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+const double TOLERANCE = 1E-11;
+
+/// Relative Frobenius norm of the difference between two matrices with the same sparsity pattern.
+double relative_difference(
+    const dealii::TrilinosWrappers::SparseMatrix &matrix_a,
+    const dealii::TrilinosWrappers::SparseMatrix &matrix_b)
+{
+    dealii::TrilinosWrappers::SparseMatrix difference;
+    difference.copy_from(matrix_a);
+    difference.add(-1.0, matrix_b);
+    const double norm_a = matrix_a.frobenius_norm();
+    return (norm_a == 0.0) ? difference.frobenius_norm() : difference.frobenius_norm() / norm_a;
+}
+
+/// Assembles dRdW and returns the wall time in seconds.
+double time_dRdW (PHiLiP::DGBase<PHILIP_DIM,double> &dg, const unsigned int n_repetitions)
+{
+    MPI_Barrier(MPI_COMM_WORLD);
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < n_repetitions; ++i) {
+        // The write access bumps the solution version, otherwise the assembly is skipped since the solution did not change.
+        dg.modify_solution();
+        dg.assemble_residual (true);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count() / n_repetitions;
+}
+
+/// Compares dRdW assembled from the pointwise flux Jacobians and from the AD of the whole cell and face residuals.
+template<int dim, int nstate>
+int test (
+    const unsigned int poly_degree,
+    std::shared_ptr<Triangulation> grid,
+    PHiLiP::Parameters::AllParameters all_parameters)
+{
+    using namespace PHiLiP;
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    // The parameters are read by the DG at every assembly, such that the assembly mode can be switched in-between.
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg->set_solution(solution_no_ghost);
+
+    const unsigned int n_repetitions = (dim == 3) ? 2 : 5;
+
+    all_parameters.use_flux_jacobians = false;
+    const double time_residual_ad = time_dRdW (*dg, n_repetitions);
+    dealii::TrilinosWrappers::SparseMatrix dRdW_residual_ad;
+    dRdW_residual_ad.copy_from(dg->system_matrix);
+    dealii::LinearAlgebra::distributed::Vector<double> rhs_residual_ad = dg->right_hand_side;
+
+    all_parameters.use_flux_jacobians = true;
+    const double time_flux_ad = time_dRdW (*dg, n_repetitions);
+
+    const double dRdW_diff = relative_difference(dRdW_residual_ad, dg->system_matrix);
+    rhs_residual_ad -= dg->right_hand_side;
+    const double rhs_diff = rhs_residual_ad.l2_norm() / std::max(dg->right_hand_side.l2_norm(), 1.0);
+
+    const unsigned int n_dofs_cell = dg->fe_collection[poly_degree].dofs_per_cell;
+    pcout << "PDE " << all_parameters.pde_type
+          << " poly degree " << poly_degree
+          << " face independent variables: residual AD " << 2*n_dofs_cell
+          << " flux AD " << 2*nstate*(dim+1)
+          << " dRdW relative difference " << dRdW_diff
+          << " rhs relative difference " << rhs_diff
+          << std::endl
+          << "    dRdW assembly time with residual AD: " << time_residual_ad
+          << " with flux AD: " << time_flux_ad
+          << " speedup: " << time_residual_ad / time_flux_ad
+          << std::endl;
+
+    if (dRdW_diff > TOLERANCE || rhs_diff > TOLERANCE) {
+        pcout << "dRdW assembled from the flux Jacobians differs from the one assembled from the residual AD." << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/// Checks that the weak form dRdW is the same with and without the flux Jacobians and reports the assembly times.
+/** The convection-diffusion case differentiates the dissipative fluxes with respect to the solution gradient.
+ *  The Euler cases are the benchmark at increasing polynomial degrees.
+ */
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    // The flux Jacobians are only used by the weak form.
+    all_parameters.use_weak_form = true;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        MPI_COMM_WORLD,
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+    const unsigned int n_subdivisions = (dim == 3) ? 3 : 4;
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, n_subdivisions);
+    for (auto &cell : grid->active_cell_iterators()) {
+        for (unsigned int face=0; face<dealii::GeometryInfo<dim>::faces_per_cell; ++face) {
+            if (cell->face(face)->at_boundary()) cell->face(face)->set_boundary_id (1000);
+        }
+    }
+
+    const unsigned int max_poly_degree = (dim == 1) ? 6 : ((dim == 2) ? 4 : 3);
+
+    int error = 0;
+    if (dim < 3) {
+        all_parameters.pde_type = PDEType::advection;
+        error += test<dim,1> (2, grid, all_parameters);
+
+        all_parameters.pde_type = PDEType::convection_diffusion;
+        error += test<dim,1> (2, grid, all_parameters);
+    }
+
+    all_parameters.pde_type = PDEType::euler;
+    for (unsigned int poly_degree = 1; poly_degree <= max_poly_degree; ++poly_degree) {
+        error += test<dim,dim+2> (poly_degree, grid, all_parameters);
+    }
+
+    return error;
+}
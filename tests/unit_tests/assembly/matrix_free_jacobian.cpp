@@ -0,0 +1,159 @@
+#include <deal.II/base/tensor.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "dg/matrix_free_jacobian.h"
+#include "linear_solver/linear_solver.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Relative l2 norm of the difference between two vectors.
+double relative_difference(
+    const dealii::LinearAlgebra::distributed::Vector<double> &vector_a,
+    const dealii::LinearAlgebra::distributed::Vector<double> &vector_b)
+{
+    dealii::LinearAlgebra::distributed::Vector<double> difference(vector_a);
+    difference -= vector_b;
+    const double norm_a = vector_a.l2_norm();
+    return (norm_a == 0.0) ? difference.l2_norm() : difference.l2_norm() / norm_a;
+}
+
+/// Compares the matrix-free Jacobian with the assembled dRdW, and the resulting linear solves.
+template<int dim, int nstate>
+int test (
+    const unsigned int poly_degree,
+    std::shared_ptr<Triangulation> grid,
+    const PHiLiP::Parameters::AllParameters &all_parameters)
+{
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+    using namespace PHiLiP;
+
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+    pcout << "Poly degree " << poly_degree << " ncells " << grid->n_active_cells() << " ndofs: " << dg->dof_handler.n_dofs() << std::endl;
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg->set_solution(solution_no_ghost);
+
+    dg->assemble_residual (true);
+    const dealii::LinearAlgebra::distributed::Vector<double> residual = dg->right_hand_side;
+
+    MatrixFreeJacobian<dim,double> jacobian_operator(dg);
+
+    // Direction with entries of varying magnitude.
+    dealii::LinearAlgebra::distributed::Vector<double> direction(dg->right_hand_side);
+    for (unsigned int i = 0; i < direction.size(); ++i) {
+        if (dg->locally_owned_dofs.is_element(i)) direction[i] = std::sin(1.0+i);
+    }
+    direction.update_ghost_values();
+
+    dealii::LinearAlgebra::distributed::Vector<double> matrix_product(dg->right_hand_side);
+    dealii::LinearAlgebra::distributed::Vector<double> operator_product(dg->right_hand_side);
+    dg->system_matrix.vmult(matrix_product, direction);
+    jacobian_operator.vmult(operator_product, direction);
+
+    int error = 0;
+    const double product_diff = relative_difference(matrix_product, operator_product);
+    pcout << "Jacobian-vector product relative difference: " << product_diff << std::endl;
+    // The product is exact, up to the different summation order.
+    if (product_diff > 1e-12) error = 1;
+
+    // The DG state is left untouched by the products.
+    const double residual_diff = relative_difference(residual, dg->right_hand_side);
+    if (residual_diff != 0.0 || !dg->right_hand_side_is_current()) {
+        pcout << "The Jacobian-vector product modified the DG state." << std::endl;
+        error = 1;
+    }
+
+    // Linear solves with the matrix and with the operator preconditioned by the same matrix.
+    dealii::LinearAlgebra::distributed::Vector<double> matrix_solution(dg->right_hand_side);
+    dealii::LinearAlgebra::distributed::Vector<double> operator_solution(dg->right_hand_side);
+    matrix_solution = 0.0;
+    operator_solution = 0.0;
+    dealii::LinearAlgebra::distributed::Vector<double> rhs(residual);
+    solve_linear (dg->system_matrix, rhs, matrix_solution, all_parameters.linear_solver_param);
+    rhs = residual;
+    LinearSolver linear_solver;
+    linear_solver.solve (jacobian_operator, dg->system_matrix, rhs, operator_solution, all_parameters.linear_solver_param);
+
+    const double solution_diff = relative_difference(matrix_solution, operator_solution);
+    pcout << "Linear solution relative difference: " << solution_diff
+          << " using " << jacobian_operator.n_applications << " operator applications." << std::endl;
+    if (solution_diff > 1e-8) error = 1;
+
+    return error;
+}
+
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    int error = 0;
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.linear_solver_param.linear_solver_type = Parameters::LinearSolverParam::LinearSolverEnum::gmres;
+    all_parameters.linear_solver_param.linear_residual = 1e-12;
+
+    std::vector<PDEType> pde_type {
+        PDEType::convection_diffusion,
+        PDEType::euler
+    };
+
+    for (auto pde = pde_type.begin(); pde != pde_type.end() && error == 0; pde++) {
+        for (unsigned int poly_degree=1; poly_degree<4 && error == 0; ++poly_degree) {
+            all_parameters.pde_type = *pde;
+#if PHILIP_DIM==1
+            std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+                typename dealii::Triangulation<dim>::MeshSmoothing(
+                    dealii::Triangulation<dim>::smoothing_on_refinement |
+                    dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+            std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+                MPI_COMM_WORLD,
+                typename dealii::Triangulation<dim>::MeshSmoothing(
+                    dealii::Triangulation<dim>::smoothing_on_refinement |
+                    dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+            dealii::GridGenerator::subdivided_hyper_cube(*grid, 4);
+            const double random_factor = 0.2;
+            const bool keep_boundary = false;
+            dealii::GridTools::distort_random (random_factor, *grid, keep_boundary);
+            for (auto &cell : grid->active_cell_iterators()) {
+                for (unsigned int face=0; face<dealii::GeometryInfo<dim>::faces_per_cell; ++face) {
+                    if (cell->face(face)->at_boundary()) cell->face(face)->set_boundary_id (1000);
+                }
+            }
+
+            if (*pde==PDEType::euler) {
+                error = test<dim,dim+2>(poly_degree, grid, all_parameters);
+            } else {
+                error = test<dim,1>(poly_degree, grid, all_parameters);
+            }
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,149 @@
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Returns 1 and prints a message if the number of assemblies is not the expected one.
+int check_assemblies (
+    const PHiLiP::DGBase<PHILIP_DIM,double> &dg,
+    const unsigned int expected_assemblies,
+    const std::string &description)
+{
+    const int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+    pcout << description << ": " << dg.n_residual_assemblies << " assemblies." << std::endl;
+    if (dg.n_residual_assemblies != expected_assemblies) {
+        pcout << "Expected " << expected_assemblies << " assemblies." << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/// Checks that assemble_residual() is skipped at an unchanged state and re-assembles once it is modified.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = 1;
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.pde_type = PDEType::convection_diffusion;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        MPI_COMM_WORLD,
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, 4);
+
+    const unsigned int poly_degree = 2;
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg->set_solution(solution_no_ghost);
+
+    int error = 0;
+
+    // The right-hand side is only assembled once at the same state.
+    dg->assemble_residual ();
+    dg->assemble_residual ();
+    error += check_assemblies (*dg, 1, "Right-hand side twice at the same state");
+    const dealii::LinearAlgebra::distributed::Vector<double> reference_rhs = dg->right_hand_side;
+
+    // dRdW is assembled along with the right-hand side, which is then current.
+    dg->assemble_residual (true);
+    dg->assemble_residual (true);
+    dg->assemble_residual ();
+    error += check_assemblies (*dg, 2, "dRdW twice and right-hand side at the same state");
+    if (!dg->right_hand_side_is_current()) error = 1;
+
+    // A system_matrix modified in place, as by the implicit steps, is re-assembled at the same state.
+    dealii::TrilinosWrappers::SparseMatrix reference_dRdW;
+    reference_dRdW.copy_from(dg->system_matrix);
+    dg->system_matrix *= -1.0;
+    dg->mark_system_matrix_modified();
+    dg->time_scaled_mass_matrices(1.0);
+    dg->add_time_scaled_mass_matrices();
+    dg->assemble_residual (true);
+    error += check_assemblies (*dg, 3, "dRdW after modifying the system_matrix in place");
+    reference_dRdW.add(-1.0, dg->system_matrix);
+    const double dRdW_difference = reference_dRdW.frobenius_norm() / dg->system_matrix.frobenius_norm();
+    pcout << "Relative difference of the re-assembled dRdW: " << dRdW_difference << std::endl;
+    if (dRdW_difference > 1e-12) error = 1;
+
+    // A different time-scaled mass matrix re-assembles dRdW.
+    dg->assemble_residual (true, false, false, 0.5);
+    error += check_assemblies (*dg, 4, "dRdW with a time-scaled mass matrix");
+
+    // Modifying the solution invalidates everything.
+    dg->modify_solution() *= 1.1;
+    if (dg->right_hand_side_is_current()) error = 1;
+    dg->assemble_residual ();
+    error += check_assemblies (*dg, 5, "Right-hand side after modifying the solution");
+
+    // Moving the nodes invalidates everything.
+    dg->high_order_grid.modify_volume_nodes() *= 1.01;
+    dg->high_order_grid.volume_nodes.update_ghost_values();
+    dg->assemble_residual ();
+    error += check_assemblies (*dg, 6, "Right-hand side after moving the nodes");
+
+    // Only the Hessians depend on the dual.
+    dg->assemble_residual (false, false, true);
+    dealii::LinearAlgebra::distributed::Vector<double> dual (dg->dual);
+    dual.add(1.0);
+    dg->set_dual (dual);
+    dg->assemble_residual ();
+    error += check_assemblies (*dg, 7, "Hessians and right-hand side after modifying the dual");
+    dg->assemble_residual (false, false, true);
+    error += check_assemblies (*dg, 8, "Hessians after modifying the dual");
+
+    // Restoring the original state gives back the same right-hand side.
+    dg->high_order_grid.modify_volume_nodes() /= 1.01;
+    dg->high_order_grid.volume_nodes.update_ghost_values();
+    dg->set_solution(solution_no_ghost);
+    dg->assemble_residual ();
+    dealii::LinearAlgebra::distributed::Vector<double> rhs_difference = dg->right_hand_side;
+    rhs_difference -= reference_rhs;
+    const double relative_difference = rhs_difference.l2_norm() / reference_rhs.l2_norm();
+    pcout << "Relative difference of the re-assembled right-hand side: " << relative_difference << std::endl;
+    if (relative_difference > 1e-12) error = 1;
+
+    // Re-allocating the system invalidates everything.
+    dg->allocate_system ();
+    dg->set_solution(solution_no_ghost);
+    dg->assemble_residual ();
+    error += check_assemblies (*dg, 10, "Right-hand side after re-allocating the system");
+
+    if (error) pcout << "The assemblies are not keyed on the state." << std::endl;
+    return error;
+}
@@ -0,0 +1,168 @@
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+using ODEEnum  = PHiLiP::Parameters::ODESolverParam::ODESolverEnum;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+const double TOLERANCE = 1E-11;
+
+/// Relative Frobenius norm of the difference between two matrices with the same sparsity pattern.
+double relative_difference(
+    const dealii::TrilinosWrappers::SparseMatrix &matrix_a,
+    const dealii::TrilinosWrappers::SparseMatrix &matrix_b)
+{
+    dealii::TrilinosWrappers::SparseMatrix difference;
+    difference.copy_from(matrix_a);
+    difference.add(-1.0, matrix_b);
+    const double norm_a = matrix_a.frobenius_norm();
+    return (norm_a == 0.0) ? difference.frobenius_norm() : difference.frobenius_norm() / norm_a;
+}
+
+/// Assembles the residual and dRdW.
+void assemble_dRdW (PHiLiP::DGBase<PHILIP_DIM,double> &dg)
+{
+    // The write access bumps the solution version, otherwise the assembly is skipped since the solution did not change.
+    dg.modify_solution();
+    dg.assemble_residual (true);
+}
+
+/// Smallest DegreeFadType degree holding \p n_indep derivatives, or 0 if the assembly falls back to DFad.
+unsigned int static_fad_degree (const unsigned int n_indep)
+{
+    for (unsigned int p = 1; p <= PHiLiP::max_static_fad_degree; ++p) {
+        if (n_indep <= PHiLiP::static_fad_derivatives(p)) return p;
+    }
+    return 0;
+}
+
+/// Compares dRdW assembled with the statically sized AD types and with the dynamically allocated ones.
+template<int dim, int nstate>
+int test (
+    const unsigned int poly_degree,
+    std::shared_ptr<Triangulation> grid,
+    PHiLiP::Parameters::AllParameters all_parameters)
+{
+    using namespace PHiLiP;
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    // The parameters are read by the DG at every assembly, such that the AD type can be switched in-between.
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg->set_solution(solution_no_ghost);
+
+    all_parameters.use_static_fad = false;
+    assemble_dRdW (*dg);
+    dealii::TrilinosWrappers::SparseMatrix dRdW_dynamic;
+    dRdW_dynamic.copy_from(dg->system_matrix);
+    dealii::LinearAlgebra::distributed::Vector<double> rhs_dynamic = dg->right_hand_side;
+
+    all_parameters.use_static_fad = true;
+    assemble_dRdW (*dg);
+
+    const double dRdW_diff = relative_difference(dRdW_dynamic, dg->system_matrix);
+    rhs_dynamic -= dg->right_hand_side;
+    const double rhs_diff = rhs_dynamic.l2_norm() / std::max(dg->right_hand_side.l2_norm(), 1.0);
+
+    // The weak form differentiates the solution and its gradient at the face quadrature points.
+    const unsigned int n_face_indep = all_parameters.use_weak_form
+                                      ? 2*nstate*(dim+1)
+                                      : 2*dg->fe_collection[poly_degree].dofs_per_cell;
+    pcout << "PDE " << all_parameters.pde_type
+          << " weak form " << all_parameters.use_weak_form
+          << " poly degree " << poly_degree
+          << " face independent variables " << n_face_indep
+          << " (DegreeFadType<" << static_fad_degree(n_face_indep) << ">, 0 is the DFad fallback)"
+          << " dRdW relative difference " << dRdW_diff
+          << " rhs relative difference " << rhs_diff
+          << std::endl;
+
+    if (dRdW_diff > TOLERANCE || rhs_diff > TOLERANCE) {
+        pcout << "dRdW assembled with DegreeFadType differs from the one assembled with DFad." << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/// Checks that dRdW is the same with and without the statically sized AD types.
+/** In the strong form, the Euler cases go through each DegreeFadType up to max_static_fad_degree.
+ *  In 1D and 2D, the next degree exceeds static_fad_derivatives(max_static_fad_degree) on the faces,
+ *  which exercises the DFad fallback. The weak form only uses StaticFadType for the flux Jacobians.
+ *  The assembly times are compared by the static_fad_timing benchmark.
+ */
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    // DGStrong only assembles dRdW for the implicit solver.
+    all_parameters.ode_solver_param.ode_solver_type = ODEEnum::implicit_solver;
+    // DGWeak only uses StaticFadType for the pointwise flux Jacobians.
+    all_parameters.use_flux_jacobians = true;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        MPI_COMM_WORLD,
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+    const unsigned int n_subdivisions = (dim == 3) ? 2 : 4;
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, n_subdivisions);
+    for (auto &cell : grid->active_cell_iterators()) {
+        for (unsigned int face=0; face<dealii::GeometryInfo<dim>::faces_per_cell; ++face) {
+            if (cell->face(face)->at_boundary()) cell->face(face)->set_boundary_id (1000);
+        }
+    }
+
+    const unsigned int max_poly_degree = (dim == 3) ? max_static_fad_degree : max_static_fad_degree+1;
+
+    int error = 0;
+    for (const bool use_weak_form : {true, false}) {
+        all_parameters.use_weak_form = use_weak_form;
+
+        if (dim < 3) {
+            all_parameters.pde_type = PDEType::advection;
+            error += test<dim,1> (2, grid, all_parameters);
+
+            all_parameters.pde_type = PDEType::convection_diffusion;
+            error += test<dim,1> (2, grid, all_parameters);
+        }
+
+        all_parameters.pde_type = PDEType::euler;
+        for (unsigned int poly_degree = 1; poly_degree <= max_poly_degree; ++poly_degree) {
+            error += test<dim,dim+2> (poly_degree, grid, all_parameters);
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,101 @@
+#include <chrono>
+#include <iomanip>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+using ODEEnum  = PHiLiP::Parameters::ODESolverParam::ODESolverEnum;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Seconds per residual and dRdW assembly.
+double time_dRdW (PHiLiP::DGBase<PHILIP_DIM,double> &dg, const unsigned int n_repetitions)
+{
+    MPI_Barrier(MPI_COMM_WORLD);
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < n_repetitions; ++i) {
+        // The write access bumps the solution version, otherwise the assembly is skipped since the solution did not change.
+        dg.modify_solution();
+        dg.assemble_residual (true);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / n_repetitions;
+}
+
+/// Benchmark of the strong form Euler dRdW assembly with the DegreeFadType against Sacado::Fad::DFad.
+/** Reports the time per assembly before, i.e. use_static_fad off, and after, for p=1 to max_static_fad_degree+1.
+ *  The correctness of the assembly is checked by the static_fad_jacobian test, such that this benchmark
+ *  is not added to the tests and always returns 0.
+ */
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = dim+2;
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    // DGStrong only assembles dRdW for the implicit solver.
+    all_parameters.ode_solver_param.ode_solver_type = ODEEnum::implicit_solver;
+    all_parameters.use_weak_form = false;
+    all_parameters.pde_type = PDEType::euler;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>();
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(MPI_COMM_WORLD);
+#endif
+    const unsigned int n_subdivisions = (dim == 3) ? 4 : 8;
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, n_subdivisions);
+    for (auto &cell : grid->active_cell_iterators()) {
+        for (unsigned int face=0; face<dealii::GeometryInfo<dim>::faces_per_cell; ++face) {
+            if (cell->face(face)->at_boundary()) cell->face(face)->set_boundary_id (1000);
+        }
+    }
+
+    for (unsigned int poly_degree = 1; poly_degree <= max_static_fad_degree+1; ++poly_degree) {
+        // The parameters are read by the DG at every assembly, such that the AD type can be switched in-between.
+        std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+        dg->allocate_system ();
+
+        std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+        dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+        solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+        dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+        dg->set_solution(solution_no_ghost);
+
+        const unsigned int n_repetitions = std::max(1u, 16u / (poly_degree*poly_degree));
+
+        all_parameters.use_static_fad = false;
+        const double time_dynamic = time_dRdW (*dg, n_repetitions);
+        all_parameters.use_static_fad = true;
+        const double time_static = time_dRdW (*dg, n_repetitions);
+
+        pcout << "dim " << dim << " p " << poly_degree
+              << " face independent variables " << std::setw(6) << 2*dg->fe_collection[poly_degree].dofs_per_cell
+              << " dRdW DFad " << std::setw(12) << time_dynamic*1e3 << " ms"
+              << " DegreeFadType " << std::setw(12) << time_static*1e3 << " ms"
+              << " speedup " << std::setw(8) << time_dynamic / time_static
+              << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include <Epetra_RowMatrixTransposer.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+const double TOLERANCE = 1E-12;
+
+/// Relative difference between the products of the DG transpose and of the Epetra_RowMatrixTransposer one.
+double transpose_difference (PHiLiP::DGBase<PHILIP_DIM,double> &dg)
+{
+    dealii::TrilinosWrappers::SparseMatrix reference_transpose;
+    {
+        Epetra_CrsMatrix *transpose_CrsMatrix;
+        Epetra_RowMatrixTransposer epmt(const_cast<Epetra_CrsMatrix *>(&dg.system_matrix.trilinos_matrix()));
+        epmt.CreateTranspose(false, transpose_CrsMatrix);
+        reference_transpose.reinit(*transpose_CrsMatrix);
+        delete transpose_CrsMatrix;
+    }
+
+    // Apply both transposes to the same vector since their sparsity patterns can be stored differently.
+    dealii::LinearAlgebra::distributed::Vector<double> input, output, reference_output;
+    input.reinit(dg.locally_owned_dofs, MPI_COMM_WORLD);
+    output.reinit(input);
+    reference_output.reinit(input);
+    for (unsigned int i = 0; i < input.local_size(); ++i) {
+        input.local_element(i) = std::sin(1.0 + input.get_partitioner()->local_to_global(i));
+    }
+    dg.get_system_matrix_transpose().vmult(output, input);
+    reference_transpose.vmult(reference_output, input);
+    output -= reference_output;
+    return output.l2_norm() / reference_output.l2_norm();
+}
+
+/// Checks that the system_matrix_transpose is only formed on request and that its in-place update is exact.
+/** Also checks the transposed product of the system_matrix which does not form the transpose. */
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = 1;
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    // Non-symmetric Jacobian.
+    all_parameters.pde_type = PDEType::convection_diffusion;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        MPI_COMM_WORLD,
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, 4);
+
+    const unsigned int poly_degree = 2;
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg->set_solution(solution_no_ghost);
+
+    int error = 0;
+
+    // Assembling dRdW does not form the transpose.
+    dg->assemble_residual (true);
+    if (dg->n_transpose_rebuilds != 0 || dg->n_transpose_updates != 0) {
+        pcout << "The transpose has been formed during the assembly." << std::endl;
+        error = 1;
+    }
+
+    // The first request builds the transpose.
+    const double first_difference = transpose_difference (*dg);
+    pcout << "Relative difference of the built transpose: " << first_difference << std::endl;
+    if (first_difference > TOLERANCE || dg->n_transpose_rebuilds != 1) error = 1;
+
+    // A second request without assembly reuses it.
+    dg->get_system_matrix_transpose();
+    if (dg->n_transpose_rebuilds != 1 || dg->n_transpose_updates != 0) {
+        pcout << "The transpose has been formed although the system_matrix did not change." << std::endl;
+        error = 1;
+    }
+
+    // New values with the same sparsity pattern are permuted in place.
+    dg->assemble_residual (true);
+    dg->system_matrix *= 2.0;
+    dg->mark_system_matrix_modified();
+    const double updated_difference = transpose_difference (*dg);
+    pcout << "Relative difference of the updated transpose: " << updated_difference << std::endl;
+    if (updated_difference > TOLERANCE || dg->n_transpose_rebuilds != 1 || dg->n_transpose_updates != 1) error = 1;
+
+    // The transposed product does not need the transpose.
+    dealii::LinearAlgebra::distributed::Vector<double> output, reference_output;
+    output.reinit(solution_no_ghost);
+    reference_output.reinit(solution_no_ghost);
+    const dealii::LinearAlgebra::distributed::Vector<double> &input = solution_no_ghost;
+    dg->system_matrix_transpose_vmult(output, input);
+    dg->get_system_matrix_transpose().vmult(reference_output, input);
+    output -= reference_output;
+    const double vmult_difference = output.l2_norm() / reference_output.l2_norm();
+    pcout << "Relative difference of the transposed product: " << vmult_difference << std::endl;
+    if (vmult_difference > TOLERANCE) error = 1;
+
+    if (error) pcout << "The system_matrix_transpose is not consistent with the system_matrix." << std::endl;
+    return error;
+}
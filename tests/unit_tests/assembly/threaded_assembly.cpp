@@ -0,0 +1,187 @@
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Relative Frobenius norm of the difference between two matrices with the same sparsity pattern.
+double relative_difference(
+    const dealii::TrilinosWrappers::SparseMatrix &matrix_a,
+    const dealii::TrilinosWrappers::SparseMatrix &matrix_b)
+{
+    dealii::TrilinosWrappers::SparseMatrix difference;
+    difference.copy_from(matrix_a);
+    difference.add(-1.0, matrix_b);
+    const double norm_a = matrix_a.frobenius_norm();
+    return (norm_a == 0.0) ? difference.frobenius_norm() : difference.frobenius_norm() / norm_a;
+}
+
+/// Relative l2 norm of the difference between two vectors.
+double relative_difference(
+    const dealii::LinearAlgebra::distributed::Vector<double> &vector_a,
+    const dealii::LinearAlgebra::distributed::Vector<double> &vector_b)
+{
+    dealii::LinearAlgebra::distributed::Vector<double> difference(vector_a);
+    difference -= vector_b;
+    const double norm_a = vector_a.l2_norm();
+    return (norm_a == 0.0) ? difference.l2_norm() : difference.l2_norm() / norm_a;
+}
+
+/// Assembles the residual and its derivatives with the serial and the threaded cell loops and compares them.
+template<int dim, int nstate>
+int test (
+    const unsigned int poly_degree,
+    std::shared_ptr<Triangulation> grid,
+    const PHiLiP::Parameters::AllParameters &serial_parameters,
+    const PHiLiP::Parameters::AllParameters &threaded_parameters)
+{
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+    using namespace PHiLiP;
+
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg_serial = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&serial_parameters, poly_degree, grid);
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg_threaded = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&threaded_parameters, poly_degree, grid);
+    dg_serial->allocate_system ();
+    dg_threaded->allocate_system ();
+    pcout << "Poly degree " << poly_degree << " ncells " << grid->n_active_cells() << " ndofs: " << dg_serial->dof_handler.n_dofs() << std::endl;
+
+    // Initialize solution with something
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&serial_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg_serial->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg_serial->high_order_grid.mapping_fe_field), dg_serial->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg_serial->set_solution(solution_no_ghost);
+    dg_threaded->set_solution(solution_no_ghost);
+
+    const double tolerance = 1e-12;
+    int error = 0;
+
+    dg_serial->assemble_residual();
+    dg_threaded->assemble_residual();
+    const double rhs_diff = relative_difference(dg_serial->right_hand_side, dg_threaded->right_hand_side);
+    pcout << "Residual relative difference: " << rhs_diff << std::endl;
+    if (rhs_diff > tolerance) error = 1;
+
+    dg_serial->assemble_residual(true, false, false);
+    dg_threaded->assemble_residual(true, false, false);
+    const double dRdW_diff = relative_difference(dg_serial->system_matrix, dg_threaded->system_matrix);
+    pcout << "dRdW relative difference: " << dRdW_diff << std::endl;
+    if (dRdW_diff > tolerance) error = 1;
+
+    dg_serial->assemble_residual(false, true, false);
+    dg_threaded->assemble_residual(false, true, false);
+    const double dRdX_diff = relative_difference(dg_serial->dRdXv, dg_threaded->dRdXv);
+    pcout << "dRdX relative difference: " << dRdX_diff << std::endl;
+    if (dRdX_diff > tolerance) error = 1;
+
+    dealii::LinearAlgebra::distributed::Vector<double> dummy_dual(dg_serial->right_hand_side);
+    dg_serial->set_dual(dummy_dual);
+    dg_threaded->set_dual(dummy_dual);
+    dg_serial->assemble_residual(false, false, true);
+    dg_threaded->assemble_residual(false, false, true);
+    const double d2RdWdW_diff = relative_difference(dg_serial->d2RdWdW, dg_threaded->d2RdWdW);
+    const double d2RdWdX_diff = relative_difference(dg_serial->d2RdWdX, dg_threaded->d2RdWdX);
+    const double d2RdXdX_diff = relative_difference(dg_serial->d2RdXdX, dg_threaded->d2RdXdX);
+    pcout << "d2RdWdW relative difference: " << d2RdWdW_diff
+          << " d2RdWdX relative difference: " << d2RdWdX_diff
+          << " d2RdXdX relative difference: " << d2RdXdX_diff
+          << std::endl;
+    if (d2RdWdW_diff > tolerance) error = 1;
+    if (d2RdWdX_diff > tolerance) error = 1;
+    if (d2RdXdX_diff > tolerance) error = 1;
+
+    return error;
+}
+
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, dealii::numbers::invalid_unsigned_int);
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    int error = 0;
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+
+    Parameters::AllParameters serial_parameters;
+    serial_parameters.parse_parameters (parameter_handler);
+    serial_parameters.assembly_threads = 1;
+
+    Parameters::AllParameters threaded_parameters;
+    threaded_parameters.parse_parameters (parameter_handler);
+    threaded_parameters.assembly_threads = 4;
+    // As in the driver, the thread limit is set from the parameters.
+    dealii::MultithreadInfo::set_thread_limit(threaded_parameters.assembly_threads);
+
+    std::vector<PDEType> pde_type {
+        PDEType::diffusion,
+        PDEType::advection,
+        PDEType::euler
+    };
+    std::vector<std::string> pde_name {
+        " PDEType::diffusion "
+        , " PDEType::advection "
+        , " PDEType::euler "
+    };
+
+    int ipde = -1;
+    for (auto pde = pde_type.begin(); pde != pde_type.end() && error == 0; pde++) {
+        ipde++;
+        for (unsigned int poly_degree=1; poly_degree<3 && error == 0; ++poly_degree) {
+            pcout << "Using " << pde_name[ipde] << std::endl;
+            serial_parameters.pde_type = *pde;
+            threaded_parameters.pde_type = *pde;
+#if PHILIP_DIM==1
+            std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+                typename dealii::Triangulation<dim>::MeshSmoothing(
+                    dealii::Triangulation<dim>::smoothing_on_refinement |
+                    dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+            std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+                MPI_COMM_WORLD,
+                typename dealii::Triangulation<dim>::MeshSmoothing(
+                    dealii::Triangulation<dim>::smoothing_on_refinement |
+                    dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+            dealii::GridGenerator::subdivided_hyper_cube(*grid, 4);
+            // Refine a corner to obtain hanging faces.
+            for (auto cell = grid->begin_active(); cell != grid->end(); ++cell) {
+                if (cell->is_locally_owned() && cell->center()[0] < 0.3) cell->set_refine_flag();
+            }
+            grid->execute_coarsening_and_refinement();
+            const double random_factor = 0.2;
+            const bool keep_boundary = false;
+            dealii::GridTools::distort_random (random_factor, *grid, keep_boundary);
+            for (auto &cell : grid->active_cell_iterators()) {
+                for (unsigned int face=0; face<dealii::GeometryInfo<dim>::faces_per_cell; ++face) {
+                    if (cell->face(face)->at_boundary()) cell->face(face)->set_boundary_id (1000);
+                }
+            }
+
+            if (*pde==PDEType::euler) {
+                error = test<dim,dim+2>(poly_degree, grid, serial_parameters, threaded_parameters);
+            } else {
+                error = test<dim,1>(poly_degree, grid, serial_parameters, threaded_parameters);
+            }
+        }
+    }
+
+    return error;
+}
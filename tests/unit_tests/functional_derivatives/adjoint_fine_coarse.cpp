@@ -0,0 +1,222 @@
+#include <deal.II/base/conditional_ostream.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include <Sacado.hpp>
+
+#include "physics/physics_factory.h"
+#include "parameters/all_parameters.h"
+#include "dg/dg.h"
+#include "functional/functional.h"
+#include "functional/adjoint.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Integral of the solution over the domain.
+template <int dim, int nstate, typename real>
+class SolutionIntegral : public PHiLiP::Functional<dim, nstate, real>
+{
+    using FadType = Sacado::Fad::DFad<real>; ///< Sacado AD type for first derivatives.
+    using FadFadType = Sacado::Fad::DFad<FadType>; ///< Sacado AD type that allows 2nd derivatives.
+public:
+    /// Constructor
+    SolutionIntegral(std::shared_ptr<PHiLiP::DGBase<dim,real>> dg_input)
+    : PHiLiP::Functional<dim,nstate,real>(dg_input,true,false)
+    {}
+
+    /// Templated integrand.
+    template <typename real2>
+    real2 evaluate_volume_integrand(
+        const PHiLiP::Physics::PhysicsBase<dim,nstate,real2> &/*physics*/,
+        const dealii::Point<dim,real2> &/*phys_coord*/,
+        const std::array<real2,nstate> &soln_at_q,
+        const std::array<dealii::Tensor<1,dim,real2>,nstate> &/*soln_grad_at_q*/) const
+    {
+        real2 integrand = 0;
+        for (int istate=0; istate<nstate; ++istate) integrand += soln_at_q[istate];
+        return integrand;
+    }
+
+    /// non-template functions to override the template classes
+    real evaluate_volume_integrand(
+        const PHiLiP::Physics::PhysicsBase<dim,nstate,real> &physics,
+        const dealii::Point<dim,real> &phys_coord,
+        const std::array<real,nstate> &soln_at_q,
+        const std::array<dealii::Tensor<1,dim,real>,nstate> &soln_grad_at_q) const override
+    {
+        return evaluate_volume_integrand<>(physics, phys_coord, soln_at_q, soln_grad_at_q);
+    }
+    /// non-template functions to override the template classes
+    FadFadType evaluate_volume_integrand(
+        const PHiLiP::Physics::PhysicsBase<dim,nstate,FadFadType> &physics,
+        const dealii::Point<dim,FadFadType> &phys_coord,
+        const std::array<FadFadType,nstate> &soln_at_q,
+        const std::array<dealii::Tensor<1,dim,FadFadType>,nstate> &soln_grad_at_q) const override
+    {
+        return evaluate_volume_integrand<>(physics, phys_coord, soln_at_q, soln_grad_at_q);
+    }
+};
+
+/// Checks that the coarse adjoint is unchanged when solved twice at the same state,
+/// that the Adjoint switches between the coarse and fine degrees without losing the solution nor
+/// re-creating the fine DG, that the fine adjoint solves the adjoint problem of an independently
+/// assembled fine DG, and that the distributed dual weighted residual sums to the one of the
+/// degrees of freedom, also after the solution is modified.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = 1;
+    using FadType = Sacado::Fad::DFad<double>;
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.pde_type = PDEType::convection_diffusion;
+    all_parameters.linear_solver_param.linear_solver_output = Parameters::OutputEnum::quiet;
+    all_parameters.linear_solver_param.linear_residual = 1e-13;
+
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+#if PHILIP_DIM!=1
+        MPI_COMM_WORLD,
+#endif
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, 8);
+
+    const unsigned int poly_degree = 1;
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, poly_degree+1, grid);
+    dg->allocate_system ();
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,FadType>> physics_fad = Physics::PhysicsFactory<dim, nstate, FadType>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg->set_solution(solution_no_ghost);
+    const dealii::LinearAlgebra::distributed::Vector<double> coarse_solution = dg->solution;
+
+    SolutionIntegral<dim,nstate,double> functional(dg);
+    const double coarse_value = functional.evaluate_functional();
+
+    int error = 0;
+
+    Adjoint<dim, nstate, double> adjoint(*dg, functional, *physics_fad);
+    const dealii::LinearAlgebra::distributed::Vector<double> first_coarse_adjoint = adjoint.coarse_grid_adjoint();
+
+    // The system_matrix negated by the first solve is re-assembled at the same state, not negated back.
+    dealii::LinearAlgebra::distributed::Vector<double> second_coarse_adjoint = adjoint.coarse_grid_adjoint();
+    second_coarse_adjoint -= first_coarse_adjoint;
+    const double repeated_difference = second_coarse_adjoint.l2_norm() / first_coarse_adjoint.l2_norm();
+    pcout << "Relative difference between two coarse adjoints at the same state: " << repeated_difference << std::endl;
+    if (repeated_difference > 1e-8) {
+        pcout << "The coarse adjoint changed although the state did not." << std::endl;
+        error = 1;
+    }
+
+    // Independent fine DG on the same grid, whose degrees of freedom are numbered as the ones of the Adjoint fine DG.
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > reference_fine_dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree+1, poly_degree+1, dg->high_order_grid.max_degree, grid);
+    reference_fine_dg->allocate_system ();
+
+    const DGBase<PHILIP_DIM, double> *first_fine_dg = nullptr;
+
+    // The fine space contains the coarse one, such that the prolongated solution has the same integral.
+    for (int icycle = 0; icycle < 2; ++icycle) {
+        adjoint.convert_to_state(AdjointEnum::fine);
+        const double fine_value = functional.evaluate_functional();
+        pcout << "Coarse integral: " << coarse_value << " fine integral: " << fine_value << std::endl;
+        if (std::abs(fine_value - coarse_value) > 1e-12 * std::max(1.0, std::abs(coarse_value))) {
+            pcout << "The prolongated solution does not match the coarse solution." << std::endl;
+            error = 1;
+        }
+
+        // The fine DG and its system are allocated once.
+        if (icycle == 0) first_fine_dg = adjoint.fine_dg.get();
+        if (adjoint.fine_dg.get() != first_fine_dg || functional.dg != adjoint.fine_dg) {
+            pcout << "The fine DG was re-created, or is not evaluated by the functional." << std::endl;
+            error = 1;
+        }
+
+        // Warm-started from the prolongated coarse adjoint, then from the previous fine adjoint.
+        const dealii::LinearAlgebra::distributed::Vector<double> adjoint_warm = adjoint.fine_grid_adjoint();
+
+        // The adjoint satisfies -dRdW^T adjoint = dIdW with the independently assembled dRdW.
+        if (reference_fine_dg->solution.size() != adjoint.fine_dg->solution.size()) {
+            pcout << "The reference fine DG does not have the degrees of freedom of the Adjoint fine DG." << std::endl;
+            return 1;
+        }
+        reference_fine_dg->set_solution(adjoint.fine_dg->solution);
+        reference_fine_dg->assemble_residual(true);
+        dealii::LinearAlgebra::distributed::Vector<double> adjoint_product(adjoint.dIdw_fine);
+        reference_fine_dg->system_matrix.Tvmult(adjoint_product, adjoint_warm);
+        adjoint_product *= -1.0;
+        adjoint_product -= adjoint.dIdw_fine;
+        const double adjoint_difference = adjoint_product.l2_norm() / adjoint.dIdw_fine.l2_norm();
+        pcout << "Relative adjoint residual with the reference fine dRdW: " << adjoint_difference << std::endl;
+        if (adjoint_difference > 1e-8) {
+            pcout << "The fine adjoint does not solve the adjoint problem of the reference fine DG." << std::endl;
+            error = 1;
+        }
+
+        // One indicator per cell, which sums to the dual weighted residual of all the degrees of freedom.
+        const dealii::LinearAlgebra::distributed::Vector<double> dual_weighted_residual = adjoint.dual_weighted_residual();
+        double local_dof_sum = 0.0;
+        for (const auto idof : adjoint.fine_dg->locally_owned_dofs) {
+            local_dof_sum += std::abs(adjoint.fine_dg->right_hand_side[idof] * adjoint.adjoint_fine[idof]);
+        }
+        const double dof_sum = dealii::Utilities::MPI::sum(local_dof_sum, MPI_COMM_WORLD);
+        const double cell_sum = dual_weighted_residual.l1_norm();
+        pcout << "Dual weighted residual over the cells: " << cell_sum << " over the degrees of freedom: " << dof_sum << std::endl;
+        if (dual_weighted_residual.size() != grid->n_global_active_cells()
+            || std::abs(cell_sum - dof_sum) > 1e-12 * std::max(1.0, dof_sum)) {
+            pcout << "The dual weighted residual does not have one entry per cell, or does not sum to the one of the degrees of freedom." << std::endl;
+            error = 1;
+        }
+
+        adjoint.convert_to_state(AdjointEnum::coarse);
+        dealii::LinearAlgebra::distributed::Vector<double> solution_difference = dg->solution;
+        solution_difference -= coarse_solution;
+        const double solution_difference_norm = solution_difference.l2_norm();
+        if (solution_difference_norm > 1e-14 * coarse_solution.l2_norm() || functional.dg != dg) {
+            pcout << "The coarse solution is not recovered: difference " << solution_difference_norm << std::endl;
+            error = 1;
+        }
+    }
+
+    // The dual weighted residual follows the primal solution modified in the fine state.
+    adjoint.convert_to_state(AdjointEnum::fine);
+    const dealii::LinearAlgebra::distributed::Vector<double> unperturbed_dual_weighted_residual = adjoint.dual_weighted_residual();
+    dealii::LinearAlgebra::distributed::Vector<double> perturbed_solution = dg->solution;
+    perturbed_solution *= 1.1;
+    dg->set_solution(perturbed_solution);
+    const dealii::LinearAlgebra::distributed::Vector<double> perturbed_dual_weighted_residual = adjoint.dual_weighted_residual();
+    adjoint.fine_dg->assemble_residual();
+    double local_perturbed_sum = 0.0;
+    for (const auto idof : adjoint.fine_dg->locally_owned_dofs) {
+        local_perturbed_sum += std::abs(adjoint.fine_dg->right_hand_side[idof] * adjoint.adjoint_fine[idof]);
+    }
+    const double perturbed_sum = dealii::Utilities::MPI::sum(local_perturbed_sum, MPI_COMM_WORLD);
+    pcout << "Dual weighted residual of the perturbed solution: " << perturbed_dual_weighted_residual.l1_norm()
+          << " over the degrees of freedom: " << perturbed_sum
+          << " before the perturbation: " << unperturbed_dual_weighted_residual.l1_norm() << std::endl;
+    if (std::abs(perturbed_dual_weighted_residual.l1_norm() - perturbed_sum) > 1e-12 * std::max(1.0, perturbed_sum)) {
+        pcout << "The dual weighted residual was not updated with the solution." << std::endl;
+        error = 1;
+    }
+
+    return error;
+}
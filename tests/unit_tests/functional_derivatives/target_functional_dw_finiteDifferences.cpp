@@ -51,7 +51,7 @@ void initialize_perturbed_solution(PHiLiP::DGBase<dim,double> &dg, const PHiLiP:
     dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
     solution_no_ghost.reinit(dg.locally_owned_dofs, MPI_COMM_WORLD);
     dealii::VectorTools::interpolate(dg.dof_handler, *physics.manufactured_solution_function, solution_no_ghost);
-    dg.solution = solution_no_ghost;
+    dg.set_solution(solution_no_ghost);
 }
 
 int main(int argc, char *argv[])
@@ -134,7 +134,7 @@ int main(int argc, char *argv[])
 	// evaluating the derivative (using SACADO)
 	pcout << std::endl << "Starting AD... " << std::endl;
 	L2_Norm_Functional<dim,nstate,double> l2norm(dg,true,false);
-    dg->solution.add(1.0);
+    dg->modify_solution().add(1.0);
 	double l2error_mpi_sum2 = std::sqrt(l2norm.evaluate_functional(true,true));
 
 	dealii::LinearAlgebra::distributed::Vector<double> dIdw = l2norm.dIdw;
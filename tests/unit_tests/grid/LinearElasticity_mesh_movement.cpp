@@ -194,6 +194,27 @@ int main (int argc, char * argv[])
                 meshmover(high_order_grid, surface_node_displacements_vector);
             VectorType volume_displacements = meshmover.get_volume_displacements();
 
+            // Moving the boundary in two increments with the same mesh mover should give the same displacements.
+            // Asking again without changing the boundary returns them without solving.
+            {
+                VectorType incremental_surface_displacements = surface_node_displacements_vector;
+                incremental_surface_displacements *= 0.5;
+                incremental_surface_displacements.update_ghost_values();
+                MeshMover::LinearElasticity<dim, double, VectorType , dealii::DoFHandler<dim>>
+                    incremental_meshmover(high_order_grid, incremental_surface_displacements);
+                incremental_meshmover.get_volume_displacements();
+
+                incremental_surface_displacements = surface_node_displacements_vector;
+                incremental_surface_displacements.update_ghost_values();
+                incremental_meshmover.get_volume_displacements();
+                VectorType incremental_volume_displacements = incremental_meshmover.get_volume_displacements();
+
+                incremental_volume_displacements -= volume_displacements;
+                const double incremental_error = incremental_volume_displacements.l2_norm() / volume_displacements.l2_norm();
+                pcout << "Incremental mesh movement relative error: " << incremental_error << std::endl;
+                if (incremental_error > 1e-8) return 1;
+            }
+
             dealii::IndexSet locally_owned_dofs = high_order_grid.dof_handler_grid.locally_owned_dofs();
             dealii::IndexSet locally_relevant_dofs;
             dealii::DoFTools::extract_locally_relevant_dofs(high_order_grid.dof_handler_grid, locally_relevant_dofs);
@@ -221,7 +242,7 @@ int main (int argc, char * argv[])
             // As a result, we do not have access to the volume displacements that would typically
             // be ghost elements. We therefore have to update the actual volume_nodes after having 
             // moved them using the locally owned volume displacements.
-            high_order_grid.volume_nodes += volume_displacements;
+            high_order_grid.modify_volume_nodes() += volume_displacements;
             high_order_grid.volume_nodes.update_ghost_values();
 
             high_order_grid.output_results_vtk(high_order_grid.nth_refinement++);
@@ -110,6 +110,32 @@ int main (int argc, char * argv[])
                 ffd.get_dXvdXp(high_order_grid, ffd_design_variables_indices_dim, dXvdXp);
                 ffd.get_dXvdXp_FD(high_order_grid, ffd_design_variables_indices_dim, dXvdXp_FD, EPS);
 
+                // The operator chain should apply the same sensitivities without forming the matrix.
+                {
+                    const auto dXvdXp_operator = ffd.get_dXvdXp_operator(high_order_grid, ffd_design_variables_indices_dim);
+                    dealii::LinearAlgebra::distributed::Vector<double> design_direction, volume_direction, volume_direction_matrix;
+                    dXvdXp_operator.reinit_domain_vector(design_direction, false);
+                    dXvdXp_operator.reinit_range_vector(volume_direction, false);
+                    volume_direction_matrix.reinit(volume_direction);
+                    design_direction = 1.0;
+                    volume_direction = 1.0;
+
+                    dXvdXp_operator.vmult(volume_direction, design_direction);
+                    dXvdXp.vmult(volume_direction_matrix, design_direction);
+                    volume_direction_matrix -= volume_direction;
+                    const double vmult_error = volume_direction_matrix.l2_norm() / volume_direction.l2_norm();
+
+                    volume_direction = 1.0;
+                    dealii::LinearAlgebra::distributed::Vector<double> design_product(design_direction);
+                    dXvdXp_operator.Tvmult(design_direction, volume_direction);
+                    dXvdXp.Tvmult(design_product, volume_direction);
+                    design_product -= design_direction;
+                    const double Tvmult_error = design_product.l2_norm() / design_direction.l2_norm();
+
+                    pcout << " dXvdXp operator vmult error: " << vmult_error << " Tvmult error: " << Tvmult_error << std::endl;
+                    if (vmult_error > 1e-10 || Tvmult_error > 1e-10) fail_bool = true;
+                }
+
                 const double dXvdXp_frob_norm = dXvdXp.frobenius_norm();
 
                 dXvdXp.add(-1.0, dXvdXp_FD);
@@ -167,9 +167,7 @@ int main (int argc, char * argv[])
             // Perform a mesh deformation
             // This basically translates all the volume_nodes by 1.0 in every direction
             // This translation should not affect the volume estimate
-            for (auto dof = high_order_grid.volume_nodes.begin(); dof != high_order_grid.volume_nodes.end(); ++dof) {
-                *dof += 1.0;
-            }
+            high_order_grid.modify_volume_nodes().add(1.0);
             high_order_grid.volume_nodes.update_ghost_values();
             
             // This grid transformation is not necessary, it is simply to prove a point that once we use MappingFEField,
@@ -0,0 +1,128 @@
+#include <map>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "linear_solver/linear_solver.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+using PreconditionerEnum = PHiLiP::Parameters::LinearSolverParam::PreconditionerEnum;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Checks that the cell blocks of the DoFHandler and of the dRdW sparsity pattern agree, and that GMRES
+/// converges to the direct solution with each of the block preconditioners and the algebraic multigrid.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = 1;
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.pde_type = PDEType::convection_diffusion;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        MPI_COMM_WORLD,
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, 8);
+
+    const unsigned int poly_degree = 2;
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg->set_solution(solution_no_ghost);
+    dg->assemble_residual (true);
+
+    int error = 0;
+
+    // One block per locally owned cell.
+    const std::vector<int> row_blocks = partition_into_cell_blocks (dg->system_matrix);
+    const int n_blocks = row_blocks.empty() ? 0 : *std::max_element(row_blocks.begin(), row_blocks.end()) + 1;
+    const int n_cells = dg->triangulation->n_locally_owned_active_cells();
+    pcout << "Number of cell blocks: " << n_blocks << " for " << n_cells << " cells." << std::endl;
+    if (n_blocks != n_cells) {
+        std::cout << "Processor " << mpi_rank << " found " << n_blocks << " blocks instead of " << n_cells << std::endl;
+        error = 1;
+    }
+
+    // Same blocks from the DoFHandler, possibly numbered differently.
+    const std::vector<int> dof_blocks = partition_into_cell_blocks (dg->dof_handler);
+    std::map<int,int> dof_to_row_block;
+    bool same_blocks = (dof_blocks.size() == row_blocks.size());
+    for (unsigned int row = 0; same_blocks && row < row_blocks.size(); ++row) {
+        const auto inserted = dof_to_row_block.emplace(dof_blocks[row], row_blocks[row]);
+        same_blocks = (inserted.first->second == row_blocks[row]);
+    }
+    same_blocks = same_blocks && (static_cast<int>(dof_to_row_block.size()) == n_blocks);
+    if (!same_blocks) {
+        std::cout << "Processor " << mpi_rank << " found different blocks from the DoFHandler and from the sparsity pattern." << std::endl;
+        error = 1;
+    }
+
+    Parameters::LinearSolverParam linear_param = all_parameters.linear_solver_param;
+    linear_param.linear_solver_output = Parameters::OutputEnum::quiet;
+    linear_param.linear_residual = 1e-12;
+    linear_param.max_iterations = 2000;
+    linear_param.restart_number = 200;
+
+    dealii::LinearAlgebra::distributed::Vector<double> right_hand_side = dg->right_hand_side;
+    dealii::LinearAlgebra::distributed::Vector<double> direct_solution(right_hand_side);
+    linear_param.linear_solver_type = Parameters::LinearSolverParam::LinearSolverEnum::direct;
+    direct_solution = 0.0;
+    solve_linear (dg->system_matrix, right_hand_side, direct_solution, linear_param);
+
+    const std::vector<std::pair<PreconditionerEnum,std::string>> preconditioners {
+        {PreconditionerEnum::ilut, "ilut"},
+        {PreconditionerEnum::block_jacobi, "block_jacobi"},
+        {PreconditionerEnum::ilu0, "ilu0"},
+        {PreconditionerEnum::block_gauss_seidel, "block_gauss_seidel"},
+        {PreconditionerEnum::amg, "amg"}
+    };
+    linear_param.linear_solver_type = Parameters::LinearSolverParam::LinearSolverEnum::gmres;
+    for (const auto &preconditioner : preconditioners) {
+        linear_param.preconditioner_type = preconditioner.first;
+        dealii::LinearAlgebra::distributed::Vector<double> solution(right_hand_side);
+        solution = 0.0;
+        const unsigned int n_iterations = solve_linear (dg->system_matrix, right_hand_side, solution, linear_param).first;
+
+        solution -= direct_solution;
+        const double relative_difference = solution.l2_norm() / direct_solution.l2_norm();
+        pcout << preconditioner.second << ": " << n_iterations << " iterations, relative difference with the direct solution "
+              << relative_difference << std::endl;
+        if (relative_difference > 1e-8 || n_iterations >= static_cast<unsigned int>(linear_param.max_iterations)) {
+            pcout << preconditioner.second << " did not converge to the direct solution." << std::endl;
+            error = 1;
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,142 @@
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "linear_solver/linear_solver.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+using PreconditionerEnum = PHiLiP::Parameters::LinearSolverParam::PreconditionerEnum;
+using LinearSolverEnum = PHiLiP::Parameters::LinearSolverParam::LinearSolverEnum;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Checks that the LinearSolver only sets up again when the matrix or the parameters change,
+/// that the reused setup still solves the current matrix values, and that a kept factorization is not recomputed.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = 1;
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.pde_type = PDEType::convection_diffusion;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        MPI_COMM_WORLD,
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, 8);
+
+    const unsigned int poly_degree = 2;
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg->set_solution(solution_no_ghost);
+    dg->assemble_residual (true);
+
+    Parameters::LinearSolverParam linear_param = all_parameters.linear_solver_param;
+    linear_param.linear_solver_output = Parameters::OutputEnum::quiet;
+    linear_param.linear_residual = 1e-12;
+    linear_param.max_iterations = 2000;
+    linear_param.restart_number = 200;
+
+    dealii::LinearAlgebra::distributed::Vector<double> right_hand_side = dg->right_hand_side;
+    dealii::LinearAlgebra::distributed::Vector<double> direct_solution(right_hand_side);
+    linear_param.linear_solver_type = LinearSolverEnum::direct;
+    direct_solution = 0.0;
+    solve_linear (dg->system_matrix, right_hand_side, direct_solution, linear_param);
+
+    int error = 0;
+    const std::vector<std::pair<PreconditionerEnum,std::string>> preconditioners {
+        {PreconditionerEnum::ilut, "ilut"},
+        {PreconditionerEnum::block_jacobi, "block_jacobi"},
+        {PreconditionerEnum::ilu0, "ilu0"},
+        {PreconditionerEnum::amg, "amg"}
+    };
+    LinearSolver linear_solver;
+    for (const LinearSolverEnum solver_type : {LinearSolverEnum::gmres, LinearSolverEnum::direct}) {
+        linear_param.linear_solver_type = solver_type;
+        for (const auto &preconditioner : preconditioners) {
+            if (solver_type == LinearSolverEnum::direct && preconditioner.first != PreconditionerEnum::ilut) continue;
+            const std::string name = (solver_type == LinearSolverEnum::direct) ? "direct" : preconditioner.second;
+            linear_param.preconditioner_type = preconditioner.first;
+            linear_solver.reset_statistics();
+
+            // The second solve has twice the matrix values and should reuse the setup.
+            for (const double scaling : {1.0, 2.0}) {
+                dg->system_matrix *= scaling;
+                dg->mark_system_matrix_modified();
+                dealii::LinearAlgebra::distributed::Vector<double> solution(right_hand_side);
+                solution = 0.0;
+                linear_solver.solve (dg->system_matrix, right_hand_side, solution, linear_param);
+
+                solution *= scaling;
+                solution -= direct_solution;
+                const double relative_difference = solution.l2_norm() / direct_solution.l2_norm();
+                const LinearSolver::Statistics &statistics = linear_solver.last_statistics();
+                pcout << name << " with scaling " << scaling << ": " << statistics.iterations << " iterations,"
+                      << " setup " << statistics.setup_time << " s, factorization " << statistics.factorization_time << " s,"
+                      << " iterations " << statistics.iteration_time << " s, residual " << statistics.residual
+                      << ", relative difference with the direct solution " << relative_difference << std::endl;
+                if (relative_difference > 1e-8) {
+                    pcout << name << " did not converge to the direct solution." << std::endl;
+                    error = 1;
+                }
+            }
+
+            // Unchanged matrix values, whose factorization is kept.
+            {
+                dealii::LinearAlgebra::distributed::Vector<double> solution(right_hand_side);
+                solution = 0.0;
+                const bool factorize_matrix = false;
+                linear_solver.solve (dg->system_matrix, right_hand_side, solution, linear_param, std::vector<std::vector<bool>>(), factorize_matrix);
+
+                solution *= 2.0;
+                solution -= direct_solution;
+                const double relative_difference = solution.l2_norm() / direct_solution.l2_norm();
+                if (relative_difference > 1e-8) {
+                    pcout << name << " with the kept factorization did not converge to the direct solution." << std::endl;
+                    error = 1;
+                }
+            }
+            dg->system_matrix *= 0.5;
+            dg->mark_system_matrix_modified();
+
+            const LinearSolver::Statistics &total = linear_solver.total_statistics();
+            if (total.n_solves != 3 || total.n_setups != 1 || total.n_factorizations != 2) {
+                pcout << name << " set up " << total.n_setups << " times and factorized " << total.n_factorizations
+                      << " times for " << total.n_solves << " solves instead of 1, 2, and 3." << std::endl;
+                error = 1;
+            }
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,118 @@
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "dg/p_multigrid_preconditioner.h"
+#include "linear_solver/linear_solver.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+using CycleEnum = PHiLiP::Parameters::LinearSolverParam::MultigridCycleEnum;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Checks that GMRES preconditioned by the p-multigrid converges to the direct solution,
+/// in a number of iterations that does not grow with the polynomial degree.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = 1;
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.pde_type = PDEType::convection_diffusion;
+
+    Parameters::LinearSolverParam linear_param = all_parameters.linear_solver_param;
+    linear_param.linear_solver_output = Parameters::OutputEnum::quiet;
+    linear_param.linear_residual = 1e-12;
+    linear_param.max_iterations = 2000;
+    linear_param.restart_number = 200;
+    linear_param.preconditioner_type = Parameters::LinearSolverParam::PreconditionerEnum::p_multigrid;
+
+    int error = 0;
+    const unsigned int max_poly_degree = 5;
+    for (const CycleEnum cycle : {CycleEnum::v_cycle, CycleEnum::w_cycle}) {
+        linear_param.p_multigrid_cycle = cycle;
+        const std::string cycle_name = (cycle == CycleEnum::v_cycle) ? "V-cycle" : "W-cycle";
+
+        std::vector<unsigned int> n_iterations(max_poly_degree+1, 0);
+        for (unsigned int poly_degree = 1; poly_degree <= max_poly_degree; ++poly_degree) {
+#if PHILIP_DIM==1
+            std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+                typename dealii::Triangulation<dim>::MeshSmoothing(
+                    dealii::Triangulation<dim>::smoothing_on_refinement |
+                    dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+            std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+                MPI_COMM_WORLD,
+                typename dealii::Triangulation<dim>::MeshSmoothing(
+                    dealii::Triangulation<dim>::smoothing_on_refinement |
+                    dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+            dealii::GridGenerator::subdivided_hyper_cube(*grid, 8);
+
+            std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+            dg->allocate_system ();
+
+            std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+            dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+            solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+            dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+            dg->set_solution(solution_no_ghost);
+            dg->assemble_residual (true);
+
+            dealii::LinearAlgebra::distributed::Vector<double> right_hand_side = dg->right_hand_side;
+            dealii::LinearAlgebra::distributed::Vector<double> direct_solution(right_hand_side);
+            Parameters::LinearSolverParam direct_param = linear_param;
+            direct_param.linear_solver_type = Parameters::LinearSolverParam::LinearSolverEnum::direct;
+            direct_solution = 0.0;
+            solve_linear (dg->system_matrix, right_hand_side, direct_solution, direct_param);
+
+            std::shared_ptr<PMultigridPreconditioner<dim,double>> p_multigrid = std::make_shared<PMultigridPreconditioner<dim,double>>(dg, linear_param);
+            LinearSolver linear_solver;
+            linear_solver.set_external_preconditioner(p_multigrid);
+
+            dealii::LinearAlgebra::distributed::Vector<double> solution(right_hand_side);
+            solution = 0.0;
+            n_iterations[poly_degree] = linear_solver.solve (dg->system_matrix, right_hand_side, solution, linear_param).first;
+            if (p_multigrid->n_levels() != poly_degree+1) {
+                pcout << "Expected " << poly_degree+1 << " levels instead of " << p_multigrid->n_levels() << std::endl;
+                error = 1;
+            }
+
+            solution -= direct_solution;
+            const double relative_difference = solution.l2_norm() / direct_solution.l2_norm();
+            pcout << cycle_name << " at p=" << poly_degree << ": " << n_iterations[poly_degree]
+                  << " iterations, relative difference with the direct solution " << relative_difference << std::endl;
+            if (relative_difference > 1e-8) {
+                pcout << "The p-multigrid did not converge to the direct solution." << std::endl;
+                error = 1;
+            }
+        }
+
+        // The number of iterations should stay roughly constant.
+        for (unsigned int poly_degree = 2; poly_degree <= max_poly_degree; ++poly_degree) {
+            if (n_iterations[poly_degree] > 2*n_iterations[1] + 5) {
+                pcout << cycle_name << " iterations grew from " << n_iterations[1] << " at p=1 to "
+                      << n_iterations[poly_degree] << " at p=" << poly_degree << std::endl;
+                error = 1;
+            }
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,192 @@
+#include <chrono>
+#include <random>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include "parameters/all_parameters.h"
+#include "parameters/parameters.h"
+#include "numerical_flux/numerical_flux.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+using ConvType = PHiLiP::Parameters::AllParameters::ConvectiveNumericalFlux;
+
+using VectorizedDouble = dealii::VectorizedArray<double>;
+
+#define TOLERANCE 1E-11
+
+/// Returns 1 if the relative difference between the scalar and vectorized value is too large.
+int compare_value (const double scalar_value, const double vectorized_value, const std::string &name)
+{
+    const double diff = std::abs(scalar_value - vectorized_value) / std::max(1.0, std::abs(scalar_value));
+    if (diff > TOLERANCE) {
+        std::cout << name << " differs. Scalar = " << scalar_value
+                  << " Vectorized = " << vectorized_value
+                  << " Relative difference = " << diff << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/// Random conservative state. Roughly one lane in eight has a negative pressure.
+template<int dim, int nstate>
+std::array<double,nstate> random_state (std::mt19937 &generator)
+{
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    std::array<double,nstate> soln;
+    const double density = 1.0 + 0.5*distribution(generator);
+    double vel2 = 0.0;
+    soln[0] = density;
+    for (int d=0; d<dim; d++) {
+        const double vel = 0.5*distribution(generator);
+        soln[1+d] = density*vel;
+        vel2 += vel*vel;
+    }
+    const double kinetic_energy = 0.5*density*vel2;
+    const bool negative_pressure = (distribution(generator) > 0.75);
+    soln[nstate-1] = negative_pressure ? 0.5*kinetic_energy : kinetic_energy + 2.5*(1.0 + 0.2*distribution(generator));
+    return soln;
+}
+
+/// Numerical flux of VectorizedDouble::size() interface points through the kernels templated on the scalar type.
+template<int dim, int nstate>
+std::array<VectorizedDouble,nstate> evaluate_flux_batch (
+    const PHiLiP::Physics::Euler<dim,nstate,double> &euler_physics,
+    const PHiLiP::NumericalFlux::NumericalFluxConvective<dim, nstate, double> &conv_num_flux,
+    const std::array<VectorizedDouble,nstate> &soln_int,
+    const std::array<VectorizedDouble,nstate> &soln_ext,
+    const dealii::Tensor<1,dim,VectorizedDouble> &normal)
+{
+    using namespace PHiLiP;
+    const auto *roe = dynamic_cast<const NumericalFlux::Roe<dim,nstate,double>*>(&conv_num_flux);
+    if (roe) return roe->evaluate_flux_templated (soln_int, soln_ext, normal);
+    return NumericalFlux::LaxFriedrichs<dim,nstate,double>::evaluate_flux_from_physical_fluxes (
+        soln_int, soln_ext,
+        euler_physics.convective_flux_templated (soln_int),
+        euler_physics.convective_flux_templated (soln_ext),
+        euler_physics.max_convective_eigenvalue_templated (soln_int),
+        euler_physics.max_convective_eigenvalue_templated (soln_ext),
+        normal);
+}
+
+template<int dim, int nstate>
+int test_vectorized_convective_flux (const PHiLiP::Parameters::AllParameters *const all_parameters)
+{
+    using namespace PHiLiP;
+    constexpr unsigned int n_lanes = VectorizedDouble::size();
+
+    std::shared_ptr <Physics::PhysicsBase<dim, nstate, double>> pde_physics = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(all_parameters);
+    const Physics::Euler<dim,nstate,double> &euler_physics = dynamic_cast<const Physics::Euler<dim,nstate,double>&>(*pde_physics);
+
+    NumericalFlux::NumericalFluxConvective<dim, nstate, double> *conv_num_flux =
+        NumericalFlux::NumericalFluxFactory<dim, nstate, double>
+        ::create_convective_numerical_flux (all_parameters->conv_num_flux_type, pde_physics);
+
+    const unsigned int n_batches = 20000;
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    std::vector<std::array<double,nstate>> soln_int(n_batches*n_lanes), soln_ext(n_batches*n_lanes);
+    std::vector<dealii::Tensor<1,dim,double>> normals(n_batches*n_lanes);
+    for (unsigned int i=0; i<n_batches*n_lanes; ++i) {
+        soln_int[i] = random_state<dim,nstate>(generator);
+        soln_ext[i] = random_state<dim,nstate>(generator);
+        for (int d=0; d<dim; d++) normals[i][d] = distribution(generator);
+        normals[i] /= normals[i].norm();
+    }
+
+    std::vector<std::array<VectorizedDouble,nstate>> soln_int_batch(n_batches), soln_ext_batch(n_batches);
+    std::vector<dealii::Tensor<1,dim,VectorizedDouble>> normal_batch(n_batches);
+    for (unsigned int ibatch=0; ibatch<n_batches; ++ibatch) {
+        for (unsigned int lane=0; lane<n_lanes; ++lane) {
+            const unsigned int i = ibatch*n_lanes + lane;
+            for (int s=0; s<nstate; s++) {
+                soln_int_batch[ibatch][s][lane] = soln_int[i][s];
+                soln_ext_batch[ibatch][s][lane] = soln_ext[i][s];
+            }
+            for (int d=0; d<dim; d++) normal_batch[ibatch][d][lane] = normals[i][d];
+        }
+    }
+
+    // Equivalence with the scalar evaluation
+    int n_failures = 0;
+    for (unsigned int ibatch=0; ibatch<n_batches; ++ibatch) {
+        const std::array<dealii::Tensor<1,dim,VectorizedDouble>,nstate> conv_flux_batch = euler_physics.convective_flux_templated (soln_int_batch[ibatch]);
+        const VectorizedDouble max_eig_batch = euler_physics.max_convective_eigenvalue_templated (soln_int_batch[ibatch]);
+        const std::array<VectorizedDouble,nstate> num_flux_batch = evaluate_flux_batch (euler_physics, *conv_num_flux, soln_int_batch[ibatch], soln_ext_batch[ibatch], normal_batch[ibatch]);
+        for (unsigned int lane=0; lane<n_lanes; ++lane) {
+            const unsigned int i = ibatch*n_lanes + lane;
+            const std::array<dealii::Tensor<1,dim,double>,nstate> conv_flux = pde_physics->convective_flux (soln_int[i]);
+            const double max_eig = pde_physics->max_convective_eigenvalue (soln_int[i]);
+            const std::array<double,nstate> num_flux = conv_num_flux->evaluate_flux (soln_int[i], soln_ext[i], normals[i]);
+            for (int s=0; s<nstate; s++) {
+                for (int d=0; d<dim; d++) {
+                    n_failures += compare_value (conv_flux[s][d], conv_flux_batch[s][d][lane], "Convective flux");
+                }
+                n_failures += compare_value (num_flux[s], num_flux_batch[s][lane], "Numerical flux");
+            }
+            n_failures += compare_value (max_eig, max_eig_batch[lane], "Maximum eigenvalue");
+        }
+    }
+
+    // Timings
+    double checksum = 0.0;
+    const auto start_scalar = std::chrono::steady_clock::now();
+    for (unsigned int i=0; i<n_batches*n_lanes; ++i) {
+        checksum += conv_num_flux->evaluate_flux (soln_int[i], soln_ext[i], normals[i])[0];
+    }
+    const auto end_scalar = std::chrono::steady_clock::now();
+    for (unsigned int ibatch=0; ibatch<n_batches; ++ibatch) {
+        checksum += evaluate_flux_batch (euler_physics, *conv_num_flux, soln_int_batch[ibatch], soln_ext_batch[ibatch], normal_batch[ibatch])[0][0];
+    }
+    const auto end_vectorized = std::chrono::steady_clock::now();
+
+    const double time_scalar = std::chrono::duration<double>(end_scalar - start_scalar).count();
+    const double time_vectorized = std::chrono::duration<double>(end_vectorized - end_scalar).count();
+    std::cout << "PDE " << all_parameters->pde_type
+              << " numerical flux " << all_parameters->conv_num_flux_type
+              << " with " << n_lanes << " lanes. "
+              << " Scalar time: " << time_scalar
+              << " Vectorized time: " << time_vectorized
+              << " Speedup: " << time_scalar / time_vectorized
+              << " (checksum " << checksum << ")"
+              << std::endl;
+
+    delete conv_num_flux;
+
+    if (n_failures > 0) {
+        std::cout << n_failures << " values differ between the scalar and vectorized evaluations." << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    std::cout << std::setprecision(std::numeric_limits<double>::digits10 + 1);
+    std::cout << std::scientific;
+
+    std::vector<ConvType> conv_type {
+        ConvType::lax_friedrichs,
+        ConvType::roe
+    };
+
+    int success = 0;
+
+    dealii::ParameterHandler parameter_handler;
+    PHiLiP::Parameters::AllParameters::declare_parameters (parameter_handler);
+    PHiLiP::Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+
+    // Only Euler has kernels templated on the scalar type, the other physics loop over the lanes.
+    all_parameters.pde_type = PDEType::euler;
+
+    for (auto conv = conv_type.begin(); conv != conv_type.end() && success == 0; conv++) {
+        all_parameters.conv_num_flux_type = *conv;
+        success = test_vectorized_convective_flux<PHILIP_DIM,PHILIP_DIM+2> (&all_parameters);
+    }
+    return success;
+}
@@ -0,0 +1,201 @@
+#include <cmath>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "ode_solver/ode_solver.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+using ODEEnum  = PHiLiP::Parameters::ODESolverParam::ODESolverEnum;
+using RKEnum   = PHiLiP::Parameters::ODESolverParam::RungeKuttaMethodEnum;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Smallest stable time step over all the cells, from the max_dt_cell of the last assembly.
+double smallest_stable_time_step (const PHiLiP::DGBase<PHILIP_DIM,double> &dg, const unsigned int poly_degree)
+{
+    double min_dt = std::numeric_limits<double>::max();
+    for (auto cell = dg.dof_handler.begin_active(); cell!=dg.dof_handler.end(); ++cell) {
+        if (!cell->is_locally_owned()) continue;
+        min_dt = std::min(min_dt, dg.max_dt_cell[cell->active_cell_index()] / (2.0*poly_degree+1.0));
+    }
+    return dealii::Utilities::MPI::min(min_dt, MPI_COMM_WORLD);
+}
+
+/// Creates a grid whose cells grow geometrically by \p growth_ratio in every direction.
+std::shared_ptr<Triangulation> create_graded_grid (const unsigned int n_cells, const double growth_ratio)
+{
+    const int dim = PHILIP_DIM;
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        MPI_COMM_WORLD,
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+    std::vector<double> step_sizes(n_cells);
+    double length = 0.0;
+    for (unsigned int i = 0; i < n_cells; ++i) {
+        step_sizes[i] = std::pow(growth_ratio, i);
+        length += step_sizes[i];
+    }
+    for (auto &step_size : step_sizes) step_size /= length;
+
+    const std::vector<std::vector<double>> all_step_sizes(dim, step_sizes);
+    dealii::Point<dim> p1, p2;
+    for (int d = 0; d < dim; ++d) p2[d] = 1.0;
+    dealii::GridGenerator::subdivided_hyper_rectangle(*grid, all_step_sizes, p1, p2);
+    return grid;
+}
+
+/// Checks the adaptive time steps of advance_solution_time() and the local time steps of steady_state().
+/** The adaptive time steps should be the stable time step at the courant_number and end exactly at the
+ *  final time. The multirate steps should be multirate_time_step_ratio times larger and give the same
+ *  solution up to the time integration error. The local time steps should converge to the same steady
+ *  state as the global time steps, in fewer iterations on a graded grid.
+ */
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = 1;
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.pde_type = PDEType::advection;
+    all_parameters.manufactured_convergence_study_param.use_manufactured_source_term = true;
+    all_parameters.ode_solver_param.ode_solver_type = ODEEnum::explicit_solver;
+    all_parameters.ode_solver_param.runge_kutta_method = RKEnum::ssp_rk3;
+    all_parameters.ode_solver_param.ode_output = Parameters::OutputEnum::quiet;
+    all_parameters.ode_solver_param.print_iteration_modulo = 1000000;
+    all_parameters.ode_solver_param.courant_number = 0.2;
+    all_parameters.ode_solver_param.time_step_factor_residual = 0.0;
+    all_parameters.ode_solver_param.nonlinear_steady_residual_tolerance = 1e-8;
+    all_parameters.ode_solver_param.nonlinear_max_iterations = 100000;
+
+    const unsigned int poly_degree = 1;
+    std::shared_ptr<Triangulation> grid = create_graded_grid (8, 1.5);
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> initial_solution;
+    initial_solution.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), initial_solution);
+    initial_solution *= 0.5;
+
+    int error = 0;
+
+    // The wave speeds of the linear advection do not depend on the solution, such that all the adaptive time steps are the same.
+    dg->set_solution(initial_solution);
+    dg->assemble_residual ();
+    const double stable_time_step = all_parameters.ode_solver_param.courant_number * smallest_stable_time_step (*dg, poly_degree);
+    pcout << "Stable time step: " << stable_time_step << std::endl;
+
+    const double final_time = 10.5 * stable_time_step;
+    all_parameters.ode_solver_param.adaptive_time_step = true;
+    {
+        std::shared_ptr<ODE::ODESolver<dim, double>> ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
+        ode_solver->advance_solution_time(final_time);
+
+        pcout << "Adaptive time steps: " << ode_solver->current_iteration << " reaching time " << ode_solver->current_time << std::endl;
+        if (ode_solver->current_iteration != 11) {
+            pcout << "Expected 11 adaptive time steps." << std::endl;
+            error = 1;
+        }
+        if (std::abs(ode_solver->current_time - final_time) > 1e-12 * final_time) {
+            pcout << "The adaptive time steps do not end at the final time " << final_time << std::endl;
+            error = 1;
+        }
+    }
+    const dealii::LinearAlgebra::distributed::Vector<double> adaptive_solution = dg->solution;
+
+    // The smallest cells of the graded grid take 4 substeps of the multirate steps.
+    all_parameters.ode_solver_param.multirate_time_step_ratio = 4;
+    dg->set_solution(initial_solution);
+    {
+        std::shared_ptr<ODE::ODESolver<dim, double>> ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
+        ode_solver->advance_solution_time(final_time);
+
+        pcout << "Multirate time steps: " << ode_solver->current_iteration << " reaching time " << ode_solver->current_time << std::endl;
+        if (ode_solver->current_iteration != 3) {
+            pcout << "Expected 3 multirate time steps." << std::endl;
+            error = 1;
+        }
+        if (std::abs(ode_solver->current_time - final_time) > 1e-12 * final_time) {
+            pcout << "The multirate time steps do not end at the final time " << final_time << std::endl;
+            error = 1;
+        }
+    }
+    all_parameters.ode_solver_param.multirate_time_step_ratio = 1;
+    all_parameters.ode_solver_param.adaptive_time_step = false;
+    {
+        // Relative to the change of the solution over the time advanced.
+        dealii::LinearAlgebra::distributed::Vector<double> change = adaptive_solution;
+        change -= initial_solution;
+        dealii::LinearAlgebra::distributed::Vector<double> difference = dg->solution;
+        difference -= adaptive_solution;
+        const double relative_difference = difference.l2_norm() / change.l2_norm();
+        pcout << "Relative difference of the multirate and adaptive time steps: " << relative_difference << std::endl;
+        if (relative_difference > 5e-2) {
+            pcout << "The multirate time steps differ from the adaptive ones by more than the time integration error." << std::endl;
+            error = 1;
+        }
+    }
+
+    // Steady state with the smallest stable time step in every cell.
+    all_parameters.ode_solver_param.initial_time_step = stable_time_step;
+    dg->set_solution(initial_solution);
+    std::shared_ptr<ODE::ODESolver<dim, double>> global_ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
+    global_ode_solver->steady_state();
+    const dealii::LinearAlgebra::distributed::Vector<double> global_steady_solution = dg->solution;
+
+    // Steady state with the stable time step of each cell.
+    all_parameters.ode_solver_param.local_time_stepping = true;
+    dg->set_solution(initial_solution);
+    std::shared_ptr<ODE::ODESolver<dim, double>> local_ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
+    local_ode_solver->steady_state();
+
+    pcout << "Steady-state iterations with global time steps: " << global_ode_solver->current_iteration
+          << " with local time steps: " << local_ode_solver->current_iteration << std::endl;
+    const double tolerance = all_parameters.ode_solver_param.nonlinear_steady_residual_tolerance;
+    if (local_ode_solver->residual_norm > tolerance && local_ode_solver->residual_norm_decrease > tolerance) {
+        pcout << "The local time steps did not converge." << std::endl;
+        error = 1;
+    }
+    if (local_ode_solver->current_iteration >= global_ode_solver->current_iteration) {
+        pcout << "The local time steps should converge in fewer iterations than the global time steps." << std::endl;
+        error = 1;
+    }
+
+    dealii::LinearAlgebra::distributed::Vector<double> difference = dg->solution;
+    difference -= global_steady_solution;
+    const double relative_difference = difference.l2_norm() / global_steady_solution.l2_norm();
+    pcout << "Relative difference of the steady states: " << relative_difference << std::endl;
+    if (relative_difference > 1e-6) {
+        pcout << "The local time steps converged to a different steady state." << std::endl;
+        error = 1;
+    }
+
+    return error;
+}
@@ -0,0 +1,182 @@
+#include <cmath>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "ode_solver/ode_solver.h"
+#include "ode_solver/runge_kutta_tableau.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+using ODEEnum  = PHiLiP::Parameters::ODESolverParam::ODESolverEnum;
+using RKEnum   = PHiLiP::Parameters::ODESolverParam::RungeKuttaMethodEnum;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Returns 1 if the Butcher tableau does not satisfy the order conditions up to its order.
+int check_order_conditions (const PHiLiP::ODE::RungeKuttaTableau &rk, const std::string &name)
+{
+    const unsigned int n = rk.n_stages();
+    std::vector<double> c(n, 0.0);
+    for (unsigned int i = 0; i < n; ++i) {
+        for (unsigned int j = 0; j < i; ++j) c[i] += rk.a[i][j];
+    }
+    // sum_j a_ij c_j and sum_j a_ij c_j^2
+    std::vector<double> ac(n, 0.0), ac2(n, 0.0);
+    for (unsigned int i = 0; i < n; ++i) {
+        for (unsigned int j = 0; j < i; ++j) {
+            ac[i] += rk.a[i][j] * c[j];
+            ac2[i] += rk.a[i][j] * c[j] * c[j];
+        }
+    }
+
+    std::vector<std::pair<double,double>> conditions;
+    double sum_b = 0.0, sum_bc = 0.0, sum_bc2 = 0.0, sum_bac = 0.0;
+    double sum_bc3 = 0.0, sum_bcac = 0.0, sum_bac2 = 0.0, sum_baac = 0.0;
+    for (unsigned int i = 0; i < n; ++i) {
+        sum_b += rk.b[i];
+        sum_bc += rk.b[i] * c[i];
+        sum_bc2 += rk.b[i] * c[i] * c[i];
+        sum_bac += rk.b[i] * ac[i];
+        sum_bc3 += rk.b[i] * c[i] * c[i] * c[i];
+        sum_bcac += rk.b[i] * c[i] * ac[i];
+        sum_bac2 += rk.b[i] * ac2[i];
+        for (unsigned int j = 0; j < i; ++j) sum_baac += rk.b[i] * rk.a[i][j] * ac[j];
+    }
+    conditions.push_back({sum_b, 1.0});
+    if (rk.order >= 2) conditions.push_back({sum_bc, 1.0/2.0});
+    if (rk.order >= 3) {
+        conditions.push_back({sum_bc2, 1.0/3.0});
+        conditions.push_back({sum_bac, 1.0/6.0});
+    }
+    if (rk.order >= 4) {
+        conditions.push_back({sum_bc3, 1.0/4.0});
+        conditions.push_back({sum_bcac, 1.0/8.0});
+        conditions.push_back({sum_bac2, 1.0/12.0});
+        conditions.push_back({sum_baac, 1.0/24.0});
+    }
+
+    int error = 0;
+    for (const auto &condition : conditions) {
+        if (std::abs(condition.first - condition.second) > 1e-10) {
+            std::cout << name << " does not satisfy an order condition: " << condition.first << " instead of " << condition.second << std::endl;
+            error = 1;
+        }
+    }
+    return error;
+}
+
+/// Advances the solution from \p initial_solution by \p final_time and returns the final solution.
+dealii::LinearAlgebra::distributed::Vector<double> advance (
+    std::shared_ptr<PHiLiP::DGBase<PHILIP_DIM,double>> dg,
+    PHiLiP::Parameters::AllParameters &all_parameters,
+    const dealii::LinearAlgebra::distributed::Vector<double> &initial_solution,
+    const RKEnum method,
+    const double time_step,
+    const double final_time)
+{
+    all_parameters.ode_solver_param.runge_kutta_method = method;
+    all_parameters.ode_solver_param.initial_time_step = time_step;
+    dg->set_solution(initial_solution);
+
+    std::shared_ptr<PHiLiP::ODE::ODESolver<PHILIP_DIM, double>> ode_solver = PHiLiP::ODE::ODESolverFactory<PHILIP_DIM, double>::create_ODESolver(dg);
+    ode_solver->advance_solution_time(final_time);
+    return dg->solution;
+}
+
+/// Checks the Runge-Kutta tableaux and the temporal order of accuracy of the explicit ODE solver.
+/** The semi-discrete DG advection is integrated with two time steps and compared to a
+ *  solution obtained with a much smaller time step, such that the spatial error cancels.
+ */
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = 1;
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    const std::vector<std::pair<RKEnum,std::string>> methods {
+        {RKEnum::forward_euler, "forward_euler"},
+        {RKEnum::ssp_rk3, "ssp_rk3"},
+        {RKEnum::rk4, "rk4"},
+        {RKEnum::lsrk3_williamson, "lsrk3_williamson"},
+        {RKEnum::lsrk4_carpenter_kennedy, "lsrk4_carpenter_kennedy"}
+    };
+
+    int error = 0;
+    for (const auto &method : methods) {
+        const ODE::RungeKuttaTableau rk(method.first);
+        if (mpi_rank == 0) error += check_order_conditions (rk, method.second);
+    }
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.pde_type = PDEType::advection;
+    all_parameters.ode_solver_param.ode_solver_type = ODEEnum::explicit_solver;
+    all_parameters.ode_solver_param.ode_output = Parameters::OutputEnum::quiet;
+    // Only output the initial solution.
+    all_parameters.ode_solver_param.print_iteration_modulo = 1000000;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        MPI_COMM_WORLD,
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, 8);
+
+    const unsigned int poly_degree = 2;
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> initial_solution;
+    initial_solution.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), initial_solution);
+
+    // Powers of two such that the number of time steps is exact.
+    const double final_time = 1.0/32.0;
+    const double time_step = 1.0/256.0;
+    const dealii::LinearAlgebra::distributed::Vector<double> reference_solution
+        = advance (dg, all_parameters, initial_solution, RKEnum::rk4, time_step/64.0, final_time);
+
+    for (const auto &method : methods) {
+        const ODE::RungeKuttaTableau rk(method.first);
+        double errors[2];
+        for (unsigned int refinement = 0; refinement < 2; ++refinement) {
+            const double dt = time_step / (1u << refinement);
+            dealii::LinearAlgebra::distributed::Vector<double> difference
+                = advance (dg, all_parameters, initial_solution, method.first, dt, final_time);
+            difference -= reference_solution;
+            errors[refinement] = difference.l2_norm();
+        }
+        const double observed_order = std::log2(errors[0] / errors[1]);
+        pcout << method.second << " errors " << errors[0] << " " << errors[1]
+              << " observed order " << observed_order << " expected " << rk.order << std::endl;
+        if (observed_order < rk.order - 0.3) {
+            pcout << method.second << " does not converge at its order of accuracy." << std::endl;
+            error = 1;
+        }
+    }
+
+    return error;
+}
@@ -0,0 +1,111 @@
+#include <cmath>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "ode_solver/ode_solver.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+using ODEEnum  = PHiLiP::Parameters::ODESolverParam::ODESolverEnum;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+/// Checks that the Jacobian-free Newton-Krylov steps converge like the assembled Newton steps.
+/** The Jacobian-vector products are exact, such that both converge to the same steady state
+ *  in the same number of iterations when the linear systems are solved tightly.
+ */
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = dim+2;
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.pde_type = PDEType::euler;
+    all_parameters.manufactured_convergence_study_param.use_manufactured_source_term = true;
+    all_parameters.ode_solver_param.ode_solver_type = ODEEnum::implicit_solver;
+    all_parameters.ode_solver_param.ode_output = Parameters::OutputEnum::quiet;
+    all_parameters.ode_solver_param.print_iteration_modulo = 1000000;
+    all_parameters.ode_solver_param.initial_time_step = 1000.0;
+    all_parameters.ode_solver_param.time_step_factor_residual = 20.0;
+    all_parameters.ode_solver_param.time_step_factor_residual_exp = 2.0;
+    all_parameters.ode_solver_param.nonlinear_steady_residual_tolerance = 1e-10;
+    all_parameters.ode_solver_param.nonlinear_max_iterations = 50;
+    all_parameters.ode_solver_param.jfnk_preconditioner_update_frequency = 1;
+    all_parameters.linear_solver_param.linear_solver_type = Parameters::LinearSolverParam::LinearSolverEnum::gmres;
+    all_parameters.linear_solver_param.linear_solver_output = Parameters::OutputEnum::quiet;
+    all_parameters.linear_solver_param.linear_residual = 1e-12;
+
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+#if PHILIP_DIM!=1
+        MPI_COMM_WORLD,
+#endif
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, 4);
+
+    const unsigned int poly_degree = 2;
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> initial_solution;
+    initial_solution.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), initial_solution);
+    initial_solution *= 0.95;
+
+    int error = 0;
+
+    // Steady state with the assembled dRdW.
+    all_parameters.ode_solver_param.jacobian_free_newton_krylov = false;
+    dg->set_solution(initial_solution);
+    std::shared_ptr<ODE::ODESolver<dim, double>> assembled_ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
+    assembled_ode_solver->steady_state();
+    const dealii::LinearAlgebra::distributed::Vector<double> assembled_steady_solution = dg->solution;
+
+    // Steady state with the Jacobian-free operator.
+    all_parameters.ode_solver_param.jacobian_free_newton_krylov = true;
+    dg->set_solution(initial_solution);
+    std::shared_ptr<ODE::ODESolver<dim, double>> jfnk_ode_solver = ODE::ODESolverFactory<dim, double>::create_ODESolver(dg);
+    jfnk_ode_solver->steady_state();
+
+    pcout << "Newton iterations with the assembled dRdW: " << assembled_ode_solver->current_iteration
+          << " with the Jacobian-free operator: " << jfnk_ode_solver->current_iteration << std::endl;
+    const double tolerance = all_parameters.ode_solver_param.nonlinear_steady_residual_tolerance;
+    if (jfnk_ode_solver->residual_norm > tolerance) {
+        pcout << "The Jacobian-free Newton-Krylov steps did not converge: residual " << jfnk_ode_solver->residual_norm << std::endl;
+        error = 1;
+    }
+    if (jfnk_ode_solver->current_iteration > assembled_ode_solver->current_iteration + 1) {
+        pcout << "The Jacobian-free Newton-Krylov steps should converge like the assembled Newton steps." << std::endl;
+        error = 1;
+    }
+
+    dealii::LinearAlgebra::distributed::Vector<double> difference = dg->solution;
+    difference -= assembled_steady_solution;
+    const double relative_difference = difference.l2_norm() / assembled_steady_solution.l2_norm();
+    pcout << "Relative difference of the steady states: " << relative_difference << std::endl;
+    if (relative_difference > 1e-8) {
+        pcout << "The Jacobian-free Newton-Krylov steps converged to a different steady state." << std::endl;
+        error = 1;
+    }
+
+    return error;
+}
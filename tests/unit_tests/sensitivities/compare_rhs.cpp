@@ -67,7 +67,7 @@ int test (
     dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
     solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
     dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
-    dg->solution = solution_no_ghost;
+    dg->set_solution(solution_no_ghost);
 
     bool compute_dRdW, compute_dRdX, compute_d2R;
 
@@ -105,7 +105,7 @@ int test (
     solutionVector solution_no_ghost;
     solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
     dealii::VectorTools::interpolate(dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
-    dg->solution = solution_no_ghost;
+    dg->set_solution(solution_no_ghost);
     for (auto it = dg->solution.begin(); it != dg->solution.end(); ++it) {
         // Interpolating the exact manufactured solution caused some problems at the boundary conditions.
         // The manufactured solution is exactly equal to the manufactured_solution_function at the boundary,
@@ -121,9 +121,7 @@ int test (
     ode_solver->steady_state();
 
     // Set dual to 1.0 so that every 2nd derivative of the residual is accounted for.
-    for (auto it = dg->dual.begin(); it != dg->dual.end(); ++it) {
-        (*it) = 1.0;
-    }
+    dg->modify_dual() = 1.0;
     dg->dual.update_ghost_values();
 
 
@@ -176,23 +174,23 @@ int test (
                     int ij = (i+2)*5 + (j+2);
 
                     if (iw_relevant) {
-                        dg->solution[iw] = old_iw+i*EPS;
+                        dg->modify_solution()[iw] = old_iw+i*EPS;
                     }
                     if (jw_relevant) {
                         if (iw == jw) {
-                            dg->solution[jw] += j*EPS;
+                            dg->modify_solution()[jw] += j*EPS;
                         } else {
-                            dg->solution[jw] = old_jw+j*EPS;
+                            dg->modify_solution()[jw] = old_jw+j*EPS;
                         }
                     }
                     dg->assemble_residual(false, false, false);
                     perturbed_dual_dot_residual[ij] = dg->right_hand_side * dg->dual;
 
                     if (iw_relevant) {
-                        dg->solution[iw] = old_iw;
+                        dg->modify_solution()[iw] = old_iw;
                     }
                     if (jw_relevant) {
-                        dg->solution[jw] = old_jw;
+                        dg->modify_solution()[jw] = old_jw;
                     }
                 }
             }
@@ -254,10 +252,10 @@ int test (
 
             // Reset node
             if (iw_relevant) {
-                dg->solution[iw] = old_iw;
+                dg->modify_solution()[iw] = old_iw;
             }
             if (jw_relevant) {
-                dg->solution[jw] = old_jw;
+                dg->modify_solution()[jw] = old_jw;
             }
 
             // Set
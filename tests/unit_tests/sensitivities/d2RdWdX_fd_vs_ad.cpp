@@ -73,7 +73,7 @@ int test (
     solutionVector solution_no_ghost;
     solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
     dealii::VectorTools::interpolate(dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
-    dg->solution = solution_no_ghost;
+    dg->set_solution(solution_no_ghost);
     for (auto it = dg->solution.begin(); it != dg->solution.end(); ++it) {
         // Interpolating the exact manufactured solution caused some problems at the boundary conditions.
         // The manufactured solution is exactly equal to the manufactured_solution_function at the boundary,
@@ -89,9 +89,7 @@ int test (
     ode_solver->steady_state();
 
     // Set dual to 1.0 so that every 2nd derivative of the residual is accounted for.
-    for (auto it = dg->dual.begin(); it != dg->dual.end(); ++it) {
-        (*it) = 1.0;
-    }
+    dg->modify_dual() = 1.0;
     dg->dual.update_ghost_values();
 
 
@@ -144,19 +142,19 @@ int test (
                     int ij = (i+2)*5 + (j+2);
 
                     if (iw_relevant) {
-                        dg->solution[iw] = old_iw+i*EPS;
+                        dg->modify_solution()[iw] = old_iw+i*EPS;
                     }
                     if (jnode_relevant) {
-                        dg->high_order_grid.volume_nodes[jnode] = old_jnode+j*EPS;
+                        dg->high_order_grid.modify_volume_nodes()[jnode] = old_jnode+j*EPS;
                     }
                     dg->assemble_residual(false, false, false);
                     perturbed_dual_dot_residual[ij] = dg->right_hand_side * dg->dual;
 
                     if (iw_relevant) {
-                        dg->solution[iw] = old_iw;
+                        dg->modify_solution()[iw] = old_iw;
                     }
                     if (jnode_relevant) {
-                        dg->high_order_grid.volume_nodes[jnode] = old_jnode;
+                        dg->high_order_grid.modify_volume_nodes()[jnode] = old_jnode;
                     }
                 }
             }
@@ -218,10 +216,10 @@ int test (
 
             // Reset node
             if (iw_relevant) {
-                dg->solution[iw] = old_iw;
+                dg->modify_solution()[iw] = old_iw;
             }
             if (jnode_relevant) {
-                dg->high_order_grid.volume_nodes[jnode] = old_jnode;
+                dg->high_order_grid.modify_volume_nodes()[jnode] = old_jnode;
             }
 
             // Set
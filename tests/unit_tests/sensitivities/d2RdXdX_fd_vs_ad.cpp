@@ -104,20 +104,16 @@ int test (
     solutionVector solution_no_ghost;
     solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
     dealii::VectorTools::interpolate(dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
-    dg->solution = solution_no_ghost;
-    for (auto it = dg->solution.begin(); it != dg->solution.end(); ++it) {
-        // Interpolating the exact manufactured solution caused some problems at the boundary conditions.
-        // The manufactured solution is exactly equal to the manufactured_solution_function at the boundary,
-        // therefore, the finite difference will change whether the flow is incoming or outgoing.
-        // As a result, we would be differentiating at a non-differentiable point.
-        // Hence, we fix this issue by taking the second derivative at a non-exact solution.
-        (*it) += 1.0;
-    }
+    dg->set_solution(solution_no_ghost);
+    // Interpolating the exact manufactured solution caused some problems at the boundary conditions.
+    // The manufactured solution is exactly equal to the manufactured_solution_function at the boundary,
+    // therefore, the finite difference will change whether the flow is incoming or outgoing.
+    // As a result, we would be differentiating at a non-differentiable point.
+    // Hence, we fix this issue by taking the second derivative at a non-exact solution.
+    dg->modify_solution().add(1.0);
     dg->solution.update_ghost_values();
     // Set dual to 1.0 so that every 2nd derivative of the residual is accounted for.
-    for (auto it = dg->dual.begin(); it != dg->dual.end(); ++it) {
-        (*it) = 1.0;
-    }
+    dg->modify_dual() = 1.0;
     dg->dual.update_ghost_values();
 
 
@@ -177,23 +173,23 @@ int test (
                     int ij = (i+2)*5 + (j+2);
 
                     if (inode_relevant) {
-                        high_order_grid.volume_nodes(inode) = old_inode+i*EPS;
+                        high_order_grid.modify_volume_nodes()(inode) = old_inode+i*EPS;
                     }
                     if (jnode_relevant) {
                         if (inode == jnode) {
-                            high_order_grid.volume_nodes(jnode) += j*EPS;
+                            high_order_grid.modify_volume_nodes()(jnode) += j*EPS;
                         } else {
-                            high_order_grid.volume_nodes(jnode) = old_jnode+j*EPS;
+                            high_order_grid.modify_volume_nodes()(jnode) = old_jnode+j*EPS;
                         }
                     }
                     dg->assemble_residual(false, false, false);
                     perturbed_dual_dot_residual[ij] = dg->right_hand_side * dg->dual;
 
                     if (inode_relevant) {
-                        high_order_grid.volume_nodes(inode) = old_inode;
+                        high_order_grid.modify_volume_nodes()(inode) = old_inode;
                     }
                     if (jnode_relevant) {
-                        high_order_grid.volume_nodes(jnode) = old_jnode;
+                        high_order_grid.modify_volume_nodes()(jnode) = old_jnode;
                     }
                 }
             }
@@ -255,10 +251,10 @@ int test (
 
             // Reset node
             if (inode_relevant) {
-                high_order_grid.volume_nodes(inode) = old_inode;
+                high_order_grid.modify_volume_nodes()(inode) = old_inode;
             }
             if (jnode_relevant) {
-                high_order_grid.volume_nodes(jnode) = old_jnode;
+                high_order_grid.modify_volume_nodes()(jnode) = old_jnode;
             }
 
             // Set
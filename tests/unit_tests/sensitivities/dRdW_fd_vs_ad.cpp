@@ -70,15 +70,13 @@ int test (
     solutionVector solution_no_ghost;
     solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
     dealii::VectorTools::interpolate(dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
-    dg->solution = solution_no_ghost;
-    for (auto it = dg->solution.begin(); it != dg->solution.end(); ++it) {
-        // Interpolating the exact manufactured solution caused some problems at the boundary conditions.
-        // The manufactured solution is exactly equal to the manufactured_solution_function at the boundary,
-        // therefore, the finite difference will change whether the flow is incoming or outgoing.
-        // As a result, we would be differentiating at a non-differentiable point.
-        // Hence, we fix this issue by taking the second derivative at a non-exact solution.
-        (*it) += 1.0;
-    }
+    dg->set_solution(solution_no_ghost);
+    // Interpolating the exact manufactured solution caused some problems at the boundary conditions.
+    // The manufactured solution is exactly equal to the manufactured_solution_function at the boundary,
+    // therefore, the finite difference will change whether the flow is incoming or outgoing.
+    // As a result, we would be differentiating at a non-differentiable point.
+    // Hence, we fix this issue by taking the second derivative at a non-exact solution.
+    dg->modify_solution().add(1.0);
     dg->solution.update_ghost_values();
 
 
@@ -102,14 +100,14 @@ int test (
         // Positive perturbation
         if (dg->locally_owned_dofs.is_element(idof) ) {
             old_dof = dg->solution[idof];
-            dg->solution(idof) = old_dof+eps;
+            dg->modify_solution()(idof) = old_dof+eps;
         }
         dg->assemble_residual(false, false, false);
         solutionVector perturbed_residual_p = dg->right_hand_side;
 
         // Negative perturbation
         if (dg->locally_owned_dofs.is_element(idof) ) {
-            dg->solution(idof) = old_dof-eps;
+            dg->modify_solution()(idof) = old_dof-eps;
         }
         dg->assemble_residual(false, false, false);
         solutionVector perturbed_residual_m = dg->right_hand_side;
@@ -120,7 +118,7 @@ int test (
 
         // Reset node
         if (dg->locally_owned_dofs.is_element(idof) ) {
-            dg->solution(idof) = old_dof;
+            dg->modify_solution()(idof) = old_dof;
         }
 
         // Set
@@ -72,15 +72,13 @@ int test (
     solutionVector solution_no_ghost;
     solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
     dealii::VectorTools::interpolate(dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
-    dg->solution = solution_no_ghost;
-    for (auto it = dg->solution.begin(); it != dg->solution.end(); ++it) {
-        // Interpolating the exact manufactured solution caused some problems at the boundary conditions.
-        // The manufactured solution is exactly equal to the manufactured_solution_function at the boundary,
-        // therefore, the finite difference will change whether the flow is incoming or outgoing.
-        // As a result, we would be differentiating at a non-differentiable point.
-        // Hence, we fix this issue by taking the second derivative at a non-exact solution.
-        (*it) += 1.0;
-    }
+    dg->set_solution(solution_no_ghost);
+    // Interpolating the exact manufactured solution caused some problems at the boundary conditions.
+    // The manufactured solution is exactly equal to the manufactured_solution_function at the boundary,
+    // therefore, the finite difference will change whether the flow is incoming or outgoing.
+    // As a result, we would be differentiating at a non-differentiable point.
+    // Hence, we fix this issue by taking the second derivative at a non-exact solution.
+    dg->modify_solution().add(1.0);
     dg->solution.update_ghost_values();
 
 
@@ -112,7 +110,7 @@ int test (
         // Positive perturbation
         if (high_order_grid.locally_relevant_dofs_grid.is_element(inode) ) {
             old_node = high_order_grid.volume_nodes[inode];
-            high_order_grid.volume_nodes(inode) = old_node+EPS;
+            high_order_grid.modify_volume_nodes()(inode) = old_node+EPS;
         }
         //hanging_node_constraints.distribute(high_order_grid.volume_nodes);
         //high_order_grid.volume_nodes.update_ghost_values();
@@ -127,7 +125,7 @@ int test (
 
         // Negative perturbation
         if (high_order_grid.locally_relevant_dofs_grid.is_element(inode) ) {
-            high_order_grid.volume_nodes(inode) = old_node-EPS;
+            high_order_grid.modify_volume_nodes()(inode) = old_node-EPS;
         }
         //hanging_node_constraints.distribute(high_order_grid.volume_nodes);
         //high_order_grid.volume_nodes.update_ghost_values();
@@ -151,7 +149,7 @@ int test (
 
         // Reset node
         if (high_order_grid.locally_relevant_dofs_grid.is_element(inode) ) {
-            high_order_grid.volume_nodes(inode) = old_node;
+            high_order_grid.modify_volume_nodes()(inode) = old_node;
         }
 
         // Set
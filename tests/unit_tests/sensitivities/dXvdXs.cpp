@@ -220,7 +220,22 @@ int main (int argc, char * argv[])
             VectorType volume_displacements = meshmover.get_volume_displacements();
 
             // Analytical dXvdXs
+            meshmover.factorize_for_multiple_rhs = true;
             meshmover.evaluate_dXvdXs();
+            // The shared factorization and GMRES with a shared preconditioner should give the same columns.
+            {
+                const std::vector<VectorType> dXvdXs_factorized = meshmover.dXvdXs;
+                meshmover.factorize_for_multiple_rhs = false;
+                meshmover.evaluate_dXvdXs();
+                for (unsigned int isurface = 0; isurface < dXvdXs_factorized.size(); ++isurface) {
+                    VectorType difference = dXvdXs_factorized[isurface];
+                    difference.add(-1.0, meshmover.dXvdXs[isurface]);
+                    if (difference.l2_norm() > 1e-10 * std::max(1.0, dXvdXs_factorized[isurface].l2_norm())) {
+                        pcout << "Factorized and GMRES dXvdXs differ by " << difference.l2_norm() << " for surface node " << isurface << std::endl;
+                        std::abort();
+                    }
+                }
+            }
             // Start finite difference
             std::vector<VectorType> dXvdXs_FD;
             const auto &part = surface_node_displacements_vector.get_partitioner();
@@ -243,10 +258,10 @@ int main (int argc, char * argv[])
 
                 VectorType volume_displacements_p = meshmover_p.get_volume_displacements();
 
-                high_order_grid.volume_nodes += volume_displacements_p;
+                high_order_grid.modify_volume_nodes() += volume_displacements_p;
                 high_order_grid.volume_nodes.update_ghost_values();
                 high_order_grid.output_results_vtk(high_order_grid.nth_refinement++);
-                high_order_grid.volume_nodes -= volume_displacements_p;
+                high_order_grid.modify_volume_nodes() -= volume_displacements_p;
                 high_order_grid.volume_nodes.update_ghost_values();
                 high_order_grid.output_results_vtk(high_order_grid.nth_refinement++);
 
@@ -0,0 +1,182 @@
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+const double TOLERANCE = 1E-12;
+
+/// Moves the high-order nodes with a smooth displacement such that the cells are curved.
+void move_nodes (PHiLiP::HighOrderGrid<PHILIP_DIM,double> &high_order_grid)
+{
+    dealii::LinearAlgebra::distributed::Vector<double> &volume_nodes = high_order_grid.modify_volume_nodes();
+    for (unsigned int i = 0; i < volume_nodes.size(); ++i) {
+        if (volume_nodes.locally_owned_elements().is_element(i)) {
+            const double x = volume_nodes[i];
+            volume_nodes[i] = x + 0.05*x*(1.0-x);
+        }
+    }
+    volume_nodes.update_ghost_values();
+}
+
+/// Residual and dRdW products evaluated with or without the sum-factorized volume and face terms.
+struct Evaluation
+{
+    dealii::LinearAlgebra::distributed::Vector<double> rhs; ///< Residual.
+    dealii::LinearAlgebra::distributed::Vector<double> matrix_product; ///< Product of the assembled dRdW with the direction.
+    dealii::LinearAlgebra::distributed::Vector<double> directional_product; ///< Product from DGBase::apply_dRdW().
+    unsigned int n_geometry_store_rebuilds; ///< Evaluations of the stored metric terms for the three assemblies.
+};
+
+/// Returns the strong form residual and dRdW products evaluated with or without the sum-factorized volume terms.
+template<int dim, int nstate>
+Evaluation evaluate (
+    const unsigned int poly_degree,
+    std::shared_ptr<Triangulation> grid,
+    PHiLiP::Parameters::AllParameters all_parameters,
+    const bool use_sum_factorization)
+{
+    using namespace PHiLiP;
+    all_parameters.use_sum_factorization = use_sum_factorization;
+    // The dRdW is only assembled for the implicit solver.
+    all_parameters.ode_solver_param.ode_solver_type = Parameters::ODESolverParam::ODESolverEnum::implicit_solver;
+
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+    move_nodes (dg->high_order_grid);
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg->set_solution(solution_no_ghost);
+
+    Evaluation evaluation;
+    dg->assemble_residual ();
+    evaluation.rhs = dg->right_hand_side;
+
+    dealii::LinearAlgebra::distributed::Vector<double> direction = dg->solution;
+    direction.add(1.0);
+    direction.update_ghost_values();
+
+    const bool compute_dRdW = true;
+    dg->assemble_residual (compute_dRdW);
+    evaluation.matrix_product.reinit(dg->right_hand_side);
+    dg->system_matrix.vmult(evaluation.matrix_product, direction);
+
+    evaluation.directional_product.reinit(dg->right_hand_side);
+    dg->apply_dRdW(direction, evaluation.directional_product);
+
+    evaluation.n_geometry_store_rebuilds = dg->n_geometry_store_rebuilds;
+    return evaluation;
+}
+
+/// Relative difference between \p result and \p reference.
+double relative_difference (
+    dealii::LinearAlgebra::distributed::Vector<double> result,
+    const dealii::LinearAlgebra::distributed::Vector<double> &reference)
+{
+    result -= reference;
+    return result.l2_norm() / std::max(reference.l2_norm(), 1.0);
+}
+
+/// Compares the residuals and dRdW products for polynomial degrees 1 to 4.
+template<int dim, int nstate>
+int test (
+    std::shared_ptr<Triangulation> grid,
+    const PHiLiP::Parameters::AllParameters &all_parameters)
+{
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    int error = 0;
+    for (unsigned int poly_degree = 1; poly_degree <= 4; ++poly_degree) {
+        const Evaluation fe_values = evaluate<dim,nstate>(poly_degree, grid, all_parameters, false);
+        const Evaluation sum_factorization = evaluate<dim,nstate>(poly_degree, grid, all_parameters, true);
+
+        // The FEValues dRdW does not differentiate the split form, compare with its apply_dRdW() instead.
+        const double rhs_difference = relative_difference(sum_factorization.rhs, fe_values.rhs);
+        const double matrix_difference = relative_difference(sum_factorization.matrix_product, fe_values.directional_product);
+        const double directional_difference = relative_difference(sum_factorization.directional_product, fe_values.directional_product);
+
+        pcout << "Poly degree " << poly_degree
+              << " split form " << all_parameters.use_split_form
+              << " rhs norm " << fe_values.rhs.l2_norm()
+              << " relative differences of the rhs " << rhs_difference
+              << " of the dRdW product " << matrix_difference
+              << " of the apply_dRdW product " << directional_difference << std::endl;
+        if (rhs_difference > TOLERANCE || matrix_difference > TOLERANCE || directional_difference > TOLERANCE) {
+            pcout << "Sum-factorized residual or dRdW differs from the FEValues one." << std::endl;
+            error = 1;
+        }
+        // The grid does not move between the three assemblies.
+        if (fe_values.n_geometry_store_rebuilds != 0 || sum_factorization.n_geometry_store_rebuilds != 1) {
+            pcout << "The metric terms were evaluated " << sum_factorization.n_geometry_store_rebuilds
+                  << " times instead of once." << std::endl;
+            error = 1;
+        }
+    }
+    return error;
+}
+
+/// Checks that the sum-factorized strong form volume and interior face terms give the same residual and dRdW as the FEValues ones.
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.use_weak_form = false;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(
+        MPI_COMM_WORLD,
+        typename dealii::Triangulation<dim>::MeshSmoothing(
+            dealii::Triangulation<dim>::smoothing_on_refinement |
+            dealii::Triangulation<dim>::smoothing_on_coarsening));
+#endif
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, 3);
+    for (auto &cell : grid->active_cell_iterators()) {
+        for (unsigned int face=0; face<dealii::GeometryInfo<dim>::faces_per_cell; ++face) {
+            if (cell->face(face)->at_boundary()) cell->face(face)->set_boundary_id (1000);
+        }
+    }
+
+    int error = 0;
+    for (const bool use_split_form : {false, true}) {
+        all_parameters.use_split_form = use_split_form;
+
+        all_parameters.pde_type = PDEType::advection;
+        error += test<dim,1> (grid, all_parameters);
+
+        all_parameters.pde_type = PDEType::convection_diffusion;
+        error += test<dim,1> (grid, all_parameters);
+
+        all_parameters.pde_type = PDEType::euler;
+        error += test<dim,dim+2> (grid, all_parameters);
+    }
+
+    return error;
+}
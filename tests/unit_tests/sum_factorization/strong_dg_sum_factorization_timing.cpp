@@ -0,0 +1,150 @@
+#include <chrono>
+#include <iomanip>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "dg/dg.h"
+#include "parameters/parameters.h"
+#include "physics/physics_factory.h"
+
+using PDEType  = PHiLiP::Parameters::AllParameters::PartialDifferentialEquation;
+
+#if PHILIP_DIM==1
+    using Triangulation = dealii::Triangulation<PHILIP_DIM>;
+#else
+    using Triangulation = dealii::parallel::distributed::Triangulation<PHILIP_DIM>;
+#endif
+
+const double TOLERANCE = 1E-12;
+
+/// Residual, apply_dRdW() product, and the time per assembly after the metric terms are evaluated.
+struct Timing
+{
+    dealii::LinearAlgebra::distributed::Vector<double> rhs; ///< Residual.
+    dealii::LinearAlgebra::distributed::Vector<double> directional_product; ///< Product from DGBase::apply_dRdW().
+    double residual_time; ///< Seconds per DGBase::assemble_residual().
+    double directional_time; ///< Seconds per DGBase::apply_dRdW().
+};
+
+/// Times the strong form residual and apply_dRdW() with the FEValues or the sum-factorized volume and face terms.
+template<int dim, int nstate>
+Timing time_assembly (
+    const unsigned int poly_degree,
+    std::shared_ptr<Triangulation> grid,
+    PHiLiP::Parameters::AllParameters all_parameters,
+    const bool use_sum_factorization)
+{
+    using namespace PHiLiP;
+    all_parameters.use_sum_factorization = use_sum_factorization;
+
+    std::shared_ptr < DGBase<PHILIP_DIM, double> > dg = DGFactory<PHILIP_DIM,double>::create_discontinuous_galerkin(&all_parameters, poly_degree, grid);
+    dg->allocate_system ();
+
+    std::shared_ptr <Physics::PhysicsBase<dim,nstate,double>> physics_double = Physics::PhysicsFactory<dim, nstate, double>::create_Physics(&all_parameters);
+    dealii::LinearAlgebra::distributed::Vector<double> solution_no_ghost;
+    solution_no_ghost.reinit(dg->locally_owned_dofs, MPI_COMM_WORLD);
+    dealii::VectorTools::interpolate(*(dg->high_order_grid.mapping_fe_field), dg->dof_handler, *(physics_double->manufactured_solution_function), solution_no_ghost);
+    dg->set_solution(solution_no_ghost);
+
+    dealii::LinearAlgebra::distributed::Vector<double> direction = dg->solution;
+    direction.add(1.0);
+    direction.update_ghost_values();
+
+    Timing timing;
+    // The first assembly evaluates the metric terms of the geometry store, which is not timed.
+    dg->assemble_residual ();
+    timing.rhs = dg->right_hand_side;
+    timing.directional_product.reinit(dg->right_hand_side);
+
+    const unsigned int n_repetitions = std::max(2u, 64u / (poly_degree*poly_degree));
+    const auto residual_start = std::chrono::steady_clock::now();
+    for (unsigned int irep = 0; irep < n_repetitions; ++irep) {
+        dg->assemble_residual ();
+    }
+    const std::chrono::duration<double> residual_time = std::chrono::steady_clock::now() - residual_start;
+    timing.residual_time = residual_time.count() / n_repetitions;
+
+    const auto directional_start = std::chrono::steady_clock::now();
+    for (unsigned int irep = 0; irep < n_repetitions; ++irep) {
+        dg->apply_dRdW(direction, timing.directional_product);
+    }
+    const std::chrono::duration<double> directional_time = std::chrono::steady_clock::now() - directional_start;
+    timing.directional_time = directional_time.count() / n_repetitions;
+
+    return timing;
+}
+
+/// Relative difference between \p result and \p reference.
+double relative_difference (
+    dealii::LinearAlgebra::distributed::Vector<double> result,
+    const dealii::LinearAlgebra::distributed::Vector<double> &reference)
+{
+    result -= reference;
+    return result.l2_norm() / std::max(reference.l2_norm(), 1.0);
+}
+
+/// Benchmark of the DGStrong assembly with the FEValues volume and face terms against the sum-factorized ones.
+/** Both paths go through DGBase::assemble_residual() and DGBase::apply_dRdW() on the same grid,
+ *  such that the timings include the FEValues reinitializations that the geometry store avoids.
+ *  The boundary faces use FEFaceValues in both. Only the agreement of the results is checked,
+ *  the timings are reported for p=1 to 8.
+ */
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    int mpi_rank = dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+    dealii::ConditionalOStream pcout(std::cout, mpi_rank==0);
+
+    using namespace PHiLiP;
+    const int dim = PHILIP_DIM;
+    const int nstate = dim+2;
+
+    dealii::ParameterHandler parameter_handler;
+    Parameters::AllParameters::declare_parameters (parameter_handler);
+    Parameters::AllParameters all_parameters;
+    all_parameters.parse_parameters (parameter_handler);
+    all_parameters.use_weak_form = false;
+    all_parameters.pde_type = PDEType::euler;
+
+#if PHILIP_DIM==1
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>();
+#else
+    std::shared_ptr<Triangulation> grid = std::make_shared<Triangulation>(MPI_COMM_WORLD);
+#endif
+    // Enough cells for the interior faces to outnumber the boundary ones.
+    const unsigned int n_subdivisions = (dim == 3) ? 3 : 8;
+    dealii::GridGenerator::subdivided_hyper_cube(*grid, n_subdivisions);
+    for (auto &cell : grid->active_cell_iterators()) {
+        for (unsigned int face=0; face<dealii::GeometryInfo<dim>::faces_per_cell; ++face) {
+            if (cell->face(face)->at_boundary()) cell->face(face)->set_boundary_id (1000);
+        }
+    }
+
+    int error = 0;
+    for (unsigned int poly_degree = 1; poly_degree <= 8; ++poly_degree) {
+        const Timing fe_values = time_assembly<dim,nstate>(poly_degree, grid, all_parameters, false);
+        const Timing sum_factorization = time_assembly<dim,nstate>(poly_degree, grid, all_parameters, true);
+
+        const double rhs_difference = relative_difference(sum_factorization.rhs, fe_values.rhs);
+        const double directional_difference = relative_difference(sum_factorization.directional_product, fe_values.directional_product);
+
+        pcout << "dim " << dim << " p " << poly_degree
+              << " residual FEValues " << std::setw(12) << fe_values.residual_time*1e3 << " ms"
+              << " sum-factorized " << std::setw(12) << sum_factorization.residual_time*1e3 << " ms"
+              << " speedup " << std::setw(8) << fe_values.residual_time / sum_factorization.residual_time
+              << " | apply_dRdW FEValues " << std::setw(12) << fe_values.directional_time*1e3 << " ms"
+              << " sum-factorized " << std::setw(12) << sum_factorization.directional_time*1e3 << " ms"
+              << " speedup " << std::setw(8) << fe_values.directional_time / sum_factorization.directional_time
+              << std::endl;
+        if (rhs_difference > TOLERANCE || directional_difference > TOLERANCE) {
+            pcout << "Sum-factorized residual or apply_dRdW differs from the FEValues one by "
+                  << rhs_difference << " and " << directional_difference << std::endl;
+            error = 1;
+        }
+    }
+
+    return error;
+}
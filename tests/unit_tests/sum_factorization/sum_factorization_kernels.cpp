@@ -0,0 +1,288 @@
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <random>
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/qprojector.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_system.h>
+
+#include "dg/sum_factorization.h"
+
+const double TOLERANCE = 1E-11;
+
+/// Microbenchmark of the sum-factorized kernels against the dense basis matrices.
+/** For a single state, the dense path applies the n_quad x n_dofs matrices of the basis values
+ *  and reference gradients as done by the FEValues loops of DGStrong.
+ *  Both paths interpolate, differentiate along every direction, and integrate back.
+ */
+template <int dim, int n_1d>
+int benchmark (dealii::ConditionalOStream &pcout)
+{
+    using namespace PHiLiP;
+    const unsigned int poly_degree = n_1d - 1;
+    const unsigned int n_repetitions = std::max(10, 2000000 / SumFactorization::pow(n_1d, 2*dim));
+
+    const dealii::FE_DGQ<dim> fe_dg(poly_degree);
+    const dealii::FESystem<dim,dim> fe_system(fe_dg, 1);
+    const dealii::QGauss<1> oned_quadrature(n_1d);
+    const dealii::QGauss<dim> volume_quadrature(n_1d);
+
+    SumFactorization::TensorProductBasis<dim> basis;
+    if (!basis.reinit(fe_system, oned_quadrature, volume_quadrature)) {
+        pcout << "FE_DGQ with a QGauss quadrature should be a tensor product." << std::endl;
+        return 1;
+    }
+
+    const unsigned int n_dofs = fe_system.dofs_per_cell;
+    const unsigned int n_quad = volume_quadrature.size();
+
+    // Dense basis matrices
+    std::vector<double> dense_values(n_quad*n_dofs);
+    std::vector<double> dense_gradients(dim*n_quad*n_dofs);
+    for (unsigned int iquad = 0; iquad < n_quad; ++iquad) {
+        for (unsigned int idof = 0; idof < n_dofs; ++idof) {
+            dense_values[iquad*n_dofs + idof] = fe_system.shape_value(idof, volume_quadrature.point(iquad));
+            const dealii::Tensor<1,dim> gradient = fe_system.shape_grad(idof, volume_quadrature.point(iquad));
+            for (int d = 0; d < dim; ++d) {
+                dense_gradients[(d*n_quad + iquad)*n_dofs + idof] = gradient[d];
+            }
+        }
+    }
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    std::vector<double> dofs(n_dofs);
+    for (auto &value : dofs) value = distribution(generator);
+    // The FESystem of a single FE_DGQ keeps the lexicographic numbering.
+    for (unsigned int idof = 0; idof < n_dofs; ++idof) {
+        if (basis.dof_lexicographic_index[idof] != idof) {
+            pcout << "Unexpected numbering of the degrees of freedom." << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<double> values_at_q(n_quad), gradient_at_q(dim*n_quad);
+
+    // Dense path
+    std::vector<double> dense_result(n_dofs);
+    const auto dense_start = std::chrono::steady_clock::now();
+    for (unsigned int irep = 0; irep < n_repetitions; ++irep) {
+        for (unsigned int iquad = 0; iquad < n_quad; ++iquad) {
+            double value = 0.0;
+            for (unsigned int idof = 0; idof < n_dofs; ++idof) value += dense_values[iquad*n_dofs + idof] * dofs[idof];
+            values_at_q[iquad] = value;
+            for (int d = 0; d < dim; ++d) {
+                double gradient = 0.0;
+                for (unsigned int idof = 0; idof < n_dofs; ++idof) gradient += dense_gradients[(d*n_quad + iquad)*n_dofs + idof] * dofs[idof];
+                gradient_at_q[d*n_quad + iquad] = gradient;
+            }
+        }
+        for (unsigned int idof = 0; idof < n_dofs; ++idof) {
+            double integral = 0.0;
+            for (unsigned int iquad = 0; iquad < n_quad; ++iquad) {
+                integral += dense_values[iquad*n_dofs + idof] * values_at_q[iquad];
+                for (int d = 0; d < dim; ++d) {
+                    integral += dense_gradients[(d*n_quad + iquad)*n_dofs + idof] * gradient_at_q[d*n_quad + iquad];
+                }
+            }
+            dense_result[idof] = integral;
+        }
+    }
+    const std::chrono::duration<double> dense_time = std::chrono::steady_clock::now() - dense_start;
+
+    // Sum-factorized path
+    SumFactorization::TensorProductEvaluator<dim, n_1d, n_1d> evaluator(basis);
+    std::vector<double> sum_factorization_result(n_dofs);
+    const auto sum_factorization_start = std::chrono::steady_clock::now();
+    for (unsigned int irep = 0; irep < n_repetitions; ++irep) {
+        evaluator.values(dofs.data(), values_at_q.data());
+        for (int d = 0; d < dim; ++d) {
+            evaluator.gradient(d, dofs.data(), &gradient_at_q[d*n_quad]);
+        }
+        std::fill(sum_factorization_result.begin(), sum_factorization_result.end(), 0.0);
+        evaluator.integrate_values(values_at_q.data(), sum_factorization_result.data());
+        for (int d = 0; d < dim; ++d) {
+            evaluator.integrate_gradient(d, &gradient_at_q[d*n_quad], sum_factorization_result.data());
+        }
+    }
+    const std::chrono::duration<double> sum_factorization_time = std::chrono::steady_clock::now() - sum_factorization_start;
+
+    double max_difference = 0.0, max_value = 1.0;
+    for (unsigned int idof = 0; idof < n_dofs; ++idof) {
+        max_difference = std::max(max_difference, std::abs(dense_result[idof] - sum_factorization_result[idof]));
+        max_value = std::max(max_value, std::abs(dense_result[idof]));
+    }
+    const double relative_difference = max_difference / max_value;
+
+    pcout << "dim " << dim << " p " << poly_degree
+          << " dense " << std::setw(12) << dense_time.count() / n_repetitions * 1e6 << " us"
+          << " sum-factorized " << std::setw(12) << sum_factorization_time.count() / n_repetitions * 1e6 << " us"
+          << " speedup " << std::setw(8) << dense_time.count() / sum_factorization_time.count()
+          << " relative difference " << relative_difference << std::endl;
+
+    if (relative_difference > TOLERANCE) {
+        pcout << "Sum-factorized kernels differ from the dense basis matrices." << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/// Microbenchmark of the sum-factorized face kernels against the dense basis matrices on each face.
+/** The dense path evaluates the basis values and reference gradients at the face points projected
+ *  on the cell, as done by the FEFaceValues loops of DGStrong.
+ */
+template <int dim, int n_1d>
+int benchmark_faces (dealii::ConditionalOStream &pcout)
+{
+    using namespace PHiLiP;
+    const unsigned int poly_degree = n_1d - 1;
+    const unsigned int n_repetitions = std::max(10, 2000000 / SumFactorization::pow(n_1d, 2*dim-1));
+
+    const dealii::FE_DGQ<dim> fe_dg(poly_degree);
+    const dealii::FESystem<dim,dim> fe_system(fe_dg, 1);
+    const dealii::QGauss<1> oned_quadrature(n_1d);
+    const dealii::QGauss<dim> volume_quadrature(n_1d);
+    const dealii::QGauss<dim-1> face_quadrature(n_1d);
+
+    SumFactorization::TensorProductBasis<dim> basis;
+    if (!basis.reinit(fe_system, oned_quadrature, volume_quadrature) || !basis.reinit_faces(oned_quadrature, face_quadrature)) {
+        pcout << "FE_DGQ with QGauss quadratures should have tensor-product faces." << std::endl;
+        return 1;
+    }
+
+    const unsigned int n_dofs = fe_system.dofs_per_cell;
+    const unsigned int n_face_quad = face_quadrature.size();
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    std::vector<double> dofs(n_dofs);
+    for (auto &value : dofs) value = distribution(generator);
+
+    int error = 0;
+    std::chrono::duration<double> dense_time(0.0), sum_factorization_time(0.0);
+    for (unsigned int iface = 0; iface < dealii::GeometryInfo<dim>::faces_per_cell; ++iface) {
+        const dealii::Quadrature<dim> face_quadrature_on_cell
+            = dealii::QProjector<dim>::project_to_face(dealii::ReferenceCell::get_hypercube(dim), face_quadrature, iface);
+
+        // Dense basis matrices on the face
+        std::vector<double> dense_values(n_face_quad*n_dofs);
+        std::vector<double> dense_gradients(dim*n_face_quad*n_dofs);
+        for (unsigned int iquad = 0; iquad < n_face_quad; ++iquad) {
+            for (unsigned int idof = 0; idof < n_dofs; ++idof) {
+                dense_values[iquad*n_dofs + idof] = fe_system.shape_value(idof, face_quadrature_on_cell.point(iquad));
+                const dealii::Tensor<1,dim> gradient = fe_system.shape_grad(idof, face_quadrature_on_cell.point(iquad));
+                for (int d = 0; d < dim; ++d) {
+                    dense_gradients[(d*n_face_quad + iquad)*n_dofs + idof] = gradient[d];
+                }
+            }
+        }
+
+        std::vector<double> values_at_q(n_face_quad), gradient_at_q(dim*n_face_quad);
+
+        // Dense path
+        std::vector<double> dense_at_q((dim+1)*n_face_quad);
+        std::vector<double> dense_result(n_dofs);
+        const auto dense_start = std::chrono::steady_clock::now();
+        for (unsigned int irep = 0; irep < n_repetitions; ++irep) {
+            for (unsigned int iquad = 0; iquad < n_face_quad; ++iquad) {
+                double value = 0.0;
+                for (unsigned int idof = 0; idof < n_dofs; ++idof) value += dense_values[iquad*n_dofs + idof] * dofs[idof];
+                values_at_q[iquad] = value;
+                for (int d = 0; d < dim; ++d) {
+                    double gradient = 0.0;
+                    for (unsigned int idof = 0; idof < n_dofs; ++idof) gradient += dense_gradients[(d*n_face_quad + iquad)*n_dofs + idof] * dofs[idof];
+                    gradient_at_q[d*n_face_quad + iquad] = gradient;
+                }
+            }
+            for (unsigned int idof = 0; idof < n_dofs; ++idof) {
+                double integral = 0.0;
+                for (unsigned int iquad = 0; iquad < n_face_quad; ++iquad) {
+                    integral += dense_values[iquad*n_dofs + idof] * values_at_q[iquad];
+                    for (int d = 0; d < dim; ++d) {
+                        integral += dense_gradients[(d*n_face_quad + iquad)*n_dofs + idof] * gradient_at_q[d*n_face_quad + iquad];
+                    }
+                }
+                dense_result[idof] = integral;
+            }
+        }
+        dense_time += std::chrono::steady_clock::now() - dense_start;
+        for (unsigned int iquad = 0; iquad < n_face_quad; ++iquad) {
+            dense_at_q[iquad] = values_at_q[iquad];
+            for (int d = 0; d < dim; ++d) dense_at_q[(d+1)*n_face_quad + iquad] = gradient_at_q[d*n_face_quad + iquad];
+        }
+
+        // Sum-factorized path, whose face points are in the lexicographic order of the tangential directions.
+        SumFactorization::TensorProductEvaluator<dim, n_1d, n_1d> evaluator(basis);
+        std::vector<double> sum_factorization_result(n_dofs);
+        const auto sum_factorization_start = std::chrono::steady_clock::now();
+        for (unsigned int irep = 0; irep < n_repetitions; ++irep) {
+            evaluator.face_values(iface, dofs.data(), values_at_q.data());
+            for (int d = 0; d < dim; ++d) {
+                evaluator.face_gradient(iface, d, dofs.data(), &gradient_at_q[d*n_face_quad]);
+            }
+            std::fill(sum_factorization_result.begin(), sum_factorization_result.end(), 0.0);
+            evaluator.integrate_face_values(iface, values_at_q.data(), sum_factorization_result.data());
+            for (int d = 0; d < dim; ++d) {
+                evaluator.integrate_face_gradient(iface, d, &gradient_at_q[d*n_face_quad], sum_factorization_result.data());
+            }
+        }
+        sum_factorization_time += std::chrono::steady_clock::now() - sum_factorization_start;
+
+        double max_difference = 0.0, max_value = 1.0;
+        for (unsigned int iquad = 0; iquad < n_face_quad; ++iquad) {
+            const unsigned int iface_quad = basis.face_lexicographic_index[iface][iquad];
+            max_difference = std::max(max_difference, std::abs(dense_at_q[iquad] - values_at_q[iface_quad]));
+            for (int d = 0; d < dim; ++d) {
+                max_difference = std::max(max_difference, std::abs(dense_at_q[(d+1)*n_face_quad + iquad] - gradient_at_q[d*n_face_quad + iface_quad]));
+            }
+        }
+        for (unsigned int idof = 0; idof < n_dofs; ++idof) {
+            max_difference = std::max(max_difference, std::abs(dense_result[idof] - sum_factorization_result[idof]));
+            max_value = std::max(max_value, std::abs(dense_result[idof]));
+        }
+        const double relative_difference = max_difference / max_value;
+        if (relative_difference > TOLERANCE) {
+            pcout << "Sum-factorized face kernels differ from the dense basis matrices on face " << iface
+                  << " relative difference " << relative_difference << std::endl;
+            error = 1;
+        }
+    }
+
+    pcout << "dim " << dim << " p " << poly_degree
+          << " faces dense " << std::setw(12) << dense_time.count() / n_repetitions * 1e6 << " us"
+          << " sum-factorized " << std::setw(12) << sum_factorization_time.count() / n_repetitions * 1e6 << " us"
+          << " speedup " << std::setw(8) << dense_time.count() / sum_factorization_time.count() << std::endl;
+    return error;
+}
+
+int main (int argc, char * argv[])
+{
+    dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+    dealii::ConditionalOStream pcout(std::cout, dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0);
+
+    const int dim = PHILIP_DIM;
+    int error = 0;
+    error += benchmark<dim,2> (pcout);
+    error += benchmark<dim,3> (pcout);
+    error += benchmark<dim,4> (pcout);
+    error += benchmark<dim,5> (pcout);
+    error += benchmark<dim,6> (pcout);
+    error += benchmark<dim,7> (pcout);
+    error += benchmark<dim,8> (pcout);
+    error += benchmark<dim,9> (pcout);
+
+    error += benchmark_faces<dim,2> (pcout);
+    error += benchmark_faces<dim,3> (pcout);
+    error += benchmark_faces<dim,4> (pcout);
+    error += benchmark_faces<dim,5> (pcout);
+    error += benchmark_faces<dim,6> (pcout);
+    error += benchmark_faces<dim,7> (pcout);
+    error += benchmark_faces<dim,8> (pcout);
+    error += benchmark_faces<dim,9> (pcout);
+    return error;
+}